@@ -0,0 +1,106 @@
+/*
+	throughput and accuracy benchmark of fa_fir_filter
+
+	usage: fir_benchmark [seconds_of_audio]
+
+	for typical filter lengths and frame sizes it filters white noise at
+	16 kHz frame by frame, prints speed in samples per second and in x
+	realtime, and the max difference against direct convolution of the
+	whole signal (including the flushed tail).
+*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+
+#include "fa_fir.h"
+
+namespace {
+
+const int kRate = 16000;
+const int kFilterLens[] = { 31, 63, 127, 255, 511 };
+const int kFilterLensCount = sizeof(kFilterLens) / sizeof(kFilterLens[0]);
+// 10 ms frame of recorder and 1024 samples block of file processing
+const int kFrameLens[] = { 160, 1024 };
+const int kFrameLensCount = sizeof(kFrameLens) / sizeof(kFrameLens[0]);
+
+double Now() {
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// y[n] = sum(h[k]*x[n-k]), output has x.size()+h_len-1 samples
+std::vector<float> Reference(const std::vector<float>& x, const float* h, int h_len) {
+	std::vector<float> y(x.size() + h_len - 1);
+	for (size_t n = 0; n < y.size(); ++n) {
+		double sum = 0;
+		for (int k = 0; k < h_len; ++k) {
+			if (n >= (size_t)k && n - k < x.size())
+				sum += (double)h[k] * x[n - k];
+		}
+		y[n] = (float)sum;
+	}
+	return y;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	const double seconds = argc > 1 ? atof(argv[1]) : 10.;
+	const int samples = (int)(seconds * kRate);
+	const int check_samples = kRate / 2;
+	bool ok = true;
+
+	std::vector<float> x(samples);
+	srand(1);
+	for (int i = 0; i < samples; ++i)
+		x[i] = (float)(rand() % 65536 - 32768);
+
+	printf("%6s %6s %14s %12s %12s\n", "taps", "frame", "samples/s", "x realtime", "max diff");
+	for (int f = 0; f < kFrameLensCount; ++f) {
+		const int frame_len = kFrameLens[f];
+		for (int l = 0; l < kFilterLensCount; ++l) {
+			const int flt_len = kFilterLens[l];
+			std::vector<float> y(samples + flt_len);
+
+			uintptr_t flt = fa_fir_filter_lpf_init(frame_len, flt_len, 0.45f, KAISER);
+			const double start = Now();
+			int out = 0;
+			for (int i = 0; i + frame_len <= samples; i += frame_len)
+				out += fa_fir_filter(flt, &x[i], &y[out], frame_len);
+			const double elapsed = Now() - start;
+			fa_fir_filter_uninit(flt);
+
+			// accuracy on a short part, with odd last frame and flush
+			std::vector<float> part(x.begin(), x.begin() + check_samples);
+			float* h = NULL;
+			const int h_len = fa_fir_lpf_cof(&h, flt_len, 0.45f, KAISER);
+			std::vector<float> ref = Reference(part, h, h_len);
+			free(h);
+
+			std::vector<float> got(ref.size() + frame_len);
+			flt = fa_fir_filter_lpf_init(frame_len, flt_len, 0.45f, KAISER);
+			int got_len = 0;
+			for (int i = 0; i < check_samples; i += frame_len) {
+				int len = check_samples - i < frame_len ? check_samples - i : frame_len;
+				got_len += fa_fir_filter(flt, &part[i], &got[got_len], len);
+			}
+			got_len += fa_fir_filter_flush(flt, &got[got_len]);
+			fa_fir_filter_uninit(flt);
+
+			double max_diff = got_len == (int)ref.size() ? 0 : 1e9;
+			for (size_t i = 0; i < ref.size() && i < (size_t)got_len; ++i)
+				max_diff = fabs(got[i] - ref[i]) > max_diff ? fabs(got[i] - ref[i]) : max_diff;
+			// relative to 16 bit full scale
+			if (max_diff > 0.5)
+				ok = false;
+
+			printf("%6d %6d %14.0f %12.0f %12.6f\n", h_len, frame_len,
+			       out / elapsed, out / elapsed / kRate, max_diff);
+		}
+	}
+	printf("output %s\n", ok ? "OK" : "MISMATCH");
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+/*
+	throughput and quality benchmark of fa_resampler
+
+	usage: resample_benchmark [seconds_of_audio] [streams]
+
+	for every pair of 8/16/44.1/48 kHz rates it converts a sweep of given
+	length chunk by chunk and prints speed in x realtime, level of passband
+	tone and level of tone above the output nyquist (aliasing), then runs
+	the same conversion in several threads at once and checks that every
+	stream produced the same output.
+*/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <vector>
+
+#include "resample.h"
+
+namespace {
+
+const int kRates[] = { 8000, 16000, 44100, 48000 };
+const int kRatesCount = sizeof(kRates) / sizeof(kRates[0]);
+// 20 ms chunks as produced by recorder
+const int kChunkMs = 20;
+
+std::vector<unsigned char> Tone(int rate, double freq, int samples) {
+	std::vector<unsigned char> pcm(samples * 2);
+	for (int i = 0; i < samples; ++i) {
+		short s = (short)(16000 * sin(2 * M_PI * freq * i / rate));
+		pcm[2 * i] = (unsigned char)(s & 0xff);
+		pcm[2 * i + 1] = (unsigned char)((s >> 8) & 0xff);
+	}
+	return pcm;
+}
+
+std::vector<unsigned char> Convert(int in_rate, int out_rate,
+                                   const std::vector<unsigned char>& in) {
+	fa_resampler_t *resampler = fa_resampler_init(in_rate, out_rate, 2, KAISER);
+	const int chunk = in_rate * kChunkMs / 1000 * 2;
+	std::vector<unsigned char> out(fa_resampler_out_size(resampler, (int)in.size()) +
+	                               fa_resampler_out_size(resampler, chunk));
+	int out_size = 0;
+	for (size_t offset = 0; offset < in.size(); offset += chunk) {
+		int size = (int)(in.size() - offset) < chunk ? (int)(in.size() - offset) : chunk;
+		out_size += fa_resampler_process(resampler, &in[offset], size, &out[out_size]);
+	}
+	fa_resampler_uninit(resampler);
+	out.resize(out_size);
+	return out;
+}
+
+// RMS level in dB relative to the full level of the test tone
+double Level(const std::vector<unsigned char>& pcm) {
+	const size_t samples = pcm.size() / 2;
+	double sum = 0;
+	// skip filter start
+	for (size_t i = samples / 4; i < samples; ++i) {
+		short s = (short)(pcm[2 * i] | (pcm[2 * i + 1] << 8));
+		sum += (double)s * s;
+	}
+	double rms = sqrt(sum / (samples - samples / 4));
+	return 20 * log10(rms / (16000 / sqrt(2.)) + 1e-12);
+}
+
+double Now() {
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+struct Stream {
+	int in_rate;
+	int out_rate;
+	const std::vector<unsigned char>* in;
+	std::vector<unsigned char> out;
+};
+
+void* StreamThread(void* arg) {
+	Stream* stream = static_cast<Stream*>(arg);
+	stream->out = Convert(stream->in_rate, stream->out_rate, *stream->in);
+	return NULL;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	const int seconds = argc > 1 ? atoi(argv[1]) : 10;
+	const int streams = argc > 2 ? atoi(argv[2]) : 4;
+	bool ok = true;
+
+	printf("%-16s %10s %10s %10s %10s\n", "conversion", "x realtime",
+	       "taps", "pass, dB", "alias, dB");
+	for (int i = 0; i < kRatesCount; ++i) {
+		for (int o = 0; o < kRatesCount; ++o) {
+			if (i == o)
+				continue;
+			const int in_rate = kRates[i];
+			const int out_rate = kRates[o];
+			const int low_rate = in_rate < out_rate ? in_rate : out_rate;
+
+			std::vector<unsigned char> in = Tone(in_rate, 0.3 * low_rate,
+			                                     in_rate * seconds);
+			double start = Now();
+			std::vector<unsigned char> out = Convert(in_rate, out_rate, in);
+			double elapsed = Now() - start;
+			double pass = Level(out);
+
+			// the tone between output nyquist and input nyquist must vanish
+			double alias = -999;
+			if (out_rate < in_rate) {
+				double freq = 0.5 * (0.55 * out_rate + 0.5 * in_rate);
+				alias = Level(Convert(in_rate, out_rate, Tone(in_rate, freq, in_rate)));
+			}
+
+			fa_resampler_t *resampler = fa_resampler_init(in_rate, out_rate, 2, KAISER);
+			// delay is half of taps, 2 bytes per sample
+			int taps = fa_resampler_delay(resampler);
+			fa_resampler_uninit(resampler);
+
+			char name[32];
+			snprintf(name, sizeof(name), "%d->%d", in_rate, out_rate);
+			printf("%-16s %10.0f %10d %10.2f %10.1f\n", name,
+			       seconds / elapsed, taps, pass, alias);
+			if (fabs(pass) > 0.1 || alias > -60)
+				ok = false;
+		}
+	}
+
+	// independent streams in parallel must give the same result as one stream
+	std::vector<unsigned char> in = Tone(48000, 1000, 48000 * seconds);
+	std::vector<unsigned char> expected = Convert(48000, 16000, in);
+	std::vector<Stream> pool(streams);
+	std::vector<pthread_t> threads(streams);
+	double start = Now();
+	for (int s = 0; s < streams; ++s) {
+		pool[s].in_rate = 48000;
+		pool[s].out_rate = 16000;
+		pool[s].in = &in;
+		pthread_create(&threads[s], NULL, &StreamThread, &pool[s]);
+	}
+	for (int s = 0; s < streams; ++s) {
+		pthread_join(threads[s], NULL);
+		if (pool[s].out != expected)
+			ok = false;
+	}
+	printf("%d parallel 48000->16000 streams: %.0f x realtime each\n",
+	       streams, seconds / (Now() - start));
+
+	printf("%s\n", ok ? "OK" : "FAILED");
+	return ok ? 0 : 1;
+}
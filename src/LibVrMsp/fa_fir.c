@@ -35,19 +35,41 @@
 #include <assert.h>
 #include "fa_fir.h"
 
+#if defined(__AVX__)
+#define FA_FIR_AVX
+#include <immintrin.h>
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define FA_FIR_SSE
+#include <xmmintrin.h>
+#endif
+
 #undef  EPS
 #define EPS		1E-16
 
+/* taps are padded to the vector width, and outputs are computed by blocks */
+#define FA_FIR_ALIGN	8
+#define FA_FIR_BLOCK	4
+
 typedef struct _fa_fir_filter_t {
 	float   fc;           //normalized, for lowpass and highpass
 	float   fc1,fc2;      //normalized, for bandpass and bandstop
 
 	int     flt_len;
     int     frame_len;
-    int     buf_len;
-   
+    int     taps;         //flt_len padded to FA_FIR_ALIGN
+
 	float   *h;
+	void    *hr_mem;
+	float   *hr;          //h reversed in time, zero padded in front, aligned
+
+	/*
+	 * history is a mirrored ring: every sample is stored at pos and pos+ring_len,
+	 * so the last taps+FA_FIR_BLOCK-1 samples are always contiguous and no data
+	 * is moved between frames
+	 */
 	float   *buf;
+	int     ring_len;
+	int     pos;
 }fa_fir_filter_t;
 
 
@@ -436,111 +458,216 @@ float fa_conv(const float *x, const float h[], int h_len)
     /* x->x[n], so xp->x[0]  */
     y = 0.0;
     xp = x - (h_len-1);
-        
-    for (i = 0, j = h_len-1; i < h_len; i++, j--)
-        y += h[i] * xp[j]; // y[n] += h[i]*xp[n-i]
+
+    /* y[n] += h[i]*xp[n-i], 4 independent sums to hide the add latency */
+    {
+        float y0 = 0.f, y1 = 0.f, y2 = 0.f, y3 = 0.f;
+
+        for (i = 0, j = h_len-1; i + 4 <= h_len; i += 4, j -= 4) {
+            y0 += h[i]   * xp[j];
+            y1 += h[i+1] * xp[j-1];
+            y2 += h[i+2] * xp[j-2];
+            y3 += h[i+3] * xp[j-3];
+        }
+        for (; i < h_len; i++, j--)
+            y0 += h[i] * xp[j];
+
+        y = (y0 + y1) + (y2 + y3);
+    }
 
     return y;
 }
 
 
-/*  |---------------------process buf len------------------------|
- *                   px ---> moving from x0 to xn, generats n outputs
- *                    |
- *                   x0 x1 x2 x3        ...                    xn
- *  |----old data---|  |---------------frame_len-1---------------|
- *  |-----flt_len------|
- *   hm  ...  h2 h1  h0 ---> moving sync with px
- *                  |--|(the first sample of the frame)
+/*
+ * y = sum(hr[i]*x[i]) for one output, n is multiple of FA_FIR_ALIGN, hr is aligned
+ */
+static float fir_dot(const float *hr, const float *x, int n)
+{
+    int i;
+#if defined(FA_FIR_AVX)
+    __m256 acc = _mm256_setzero_ps();
+    __m128 sum;
+
+    for (i = 0; i < n; i += 8)
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_load_ps(hr + i), _mm256_loadu_ps(x + i)));
+    sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+#elif defined(FA_FIR_SSE)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+
+    for (i = 0; i < n; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load_ps(hr + i), _mm_loadu_ps(x + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load_ps(hr + i + 4), _mm_loadu_ps(x + i + 4)));
+    }
+    acc0 = _mm_add_ps(acc0, acc1);
+    acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+    acc0 = _mm_add_ss(acc0, _mm_shuffle_ps(acc0, acc0, 1));
+    return _mm_cvtss_f32(acc0);
+#else
+    float y0 = 0.f, y1 = 0.f, y2 = 0.f, y3 = 0.f;
+
+    for (i = 0; i < n; i += 4) {
+        y0 += hr[i]   * x[i];
+        y1 += hr[i+1] * x[i+1];
+        y2 += hr[i+2] * x[i+2];
+        y3 += hr[i+3] * x[i+3];
+    }
+    return (y0 + y1) + (y2 + y3);
+#endif
+}
+
+/*
+ * FA_FIR_BLOCK consecutive outputs, y[k] = sum(hr[i]*x[k+i]),
+ * every coefficient is loaded once for the whole block
+ */
+static void fir_dot_block(const float *hr, const float *x, int n, float *y)
+{
+    int i;
+#if defined(FA_FIR_AVX)
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps();
+    __m256 acc3 = _mm256_setzero_ps();
+    __m256 h;
+    __m128 s0, s1, s2, s3;
+
+    for (i = 0; i < n; i += 8) {
+        h    = _mm256_load_ps(hr + i);
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(h, _mm256_loadu_ps(x + i)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(h, _mm256_loadu_ps(x + i + 1)));
+        acc2 = _mm256_add_ps(acc2, _mm256_mul_ps(h, _mm256_loadu_ps(x + i + 2)));
+        acc3 = _mm256_add_ps(acc3, _mm256_mul_ps(h, _mm256_loadu_ps(x + i + 3)));
+    }
+    s0 = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+    s1 = _mm_add_ps(_mm256_castps256_ps128(acc1), _mm256_extractf128_ps(acc1, 1));
+    s2 = _mm_add_ps(_mm256_castps256_ps128(acc2), _mm256_extractf128_ps(acc2, 1));
+    s3 = _mm_add_ps(_mm256_castps256_ps128(acc3), _mm256_extractf128_ps(acc3, 1));
+    _MM_TRANSPOSE4_PS(s0, s1, s2, s3);
+    _mm_storeu_ps(y, _mm_add_ps(_mm_add_ps(s0, s1), _mm_add_ps(s2, s3)));
+#elif defined(FA_FIR_SSE)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    __m128 acc2 = _mm_setzero_ps();
+    __m128 acc3 = _mm_setzero_ps();
+    __m128 h;
+
+    for (i = 0; i < n; i += 4) {
+        h    = _mm_load_ps(hr + i);
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(h, _mm_loadu_ps(x + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(h, _mm_loadu_ps(x + i + 1)));
+        acc2 = _mm_add_ps(acc2, _mm_mul_ps(h, _mm_loadu_ps(x + i + 2)));
+        acc3 = _mm_add_ps(acc3, _mm_mul_ps(h, _mm_loadu_ps(x + i + 3)));
+    }
+    _MM_TRANSPOSE4_PS(acc0, acc1, acc2, acc3);
+    _mm_storeu_ps(y, _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3)));
+#else
+    float y0 = 0.f, y1 = 0.f, y2 = 0.f, y3 = 0.f;
+    float h;
+
+    for (i = 0; i < n; i++) {
+        h   = hr[i];
+        y0 += h * x[i];
+        y1 += h * x[i+1];
+        y2 += h * x[i+2];
+        y3 += h * x[i+3];
+    }
+    y[0] = y0;
+    y[1] = y1;
+    y[2] = y2;
+    y[3] = y3;
+#endif
+}
+
+/*
+ *  hr is h reversed, so the window of the output n is x(n-taps+1) ... x(n)
+ *  and the convolution is plain dot product of two contiguous arrays:
+ *
+ *   x(n-taps+1)    ...    x(n-1)   x(n)
+ *   h(taps-1)      ...    h(1)     h(0)
  *
- *   so the h0 align to x(n)     [n from 0 to n]
- *          h1 align to x(n-1)              
  *   y[n] = h[0]*x[n] + h[1]*x[n-1] + ... + h[flt_len-1]*x[n - flt_len+1]
  */
-uintptr_t fa_fir_filter_lpf_init(int frame_len, 
-                                 int flt_len, float fc, win_t win_type)
-{   
+static fa_fir_filter_t *fir_filter_alloc(float fc, float fc1, float fc2)
+{
     fa_fir_filter_t *flt = NULL;
 
     flt = (fa_fir_filter_t *)malloc(sizeof(fa_fir_filter_t));
+    memset(flt, 0, sizeof(fa_fir_filter_t));
 
 	flt->fc = fc;
-    flt->fc1 = 0;
-    flt->fc2 = 0;
+    flt->fc1 = fc1;
+    flt->fc2 = fc2;
+
+    return flt;
+}
+
+static uintptr_t fir_filter_setup(fa_fir_filter_t *flt, int frame_len)
+{
+    int i;
+    int pad;
 
-    flt->flt_len = fa_fir_lpf_cof(&(flt->h), flt_len, fc, win_type);
     flt->frame_len = frame_len;
-    
-    flt->buf_len = flt->flt_len + flt->frame_len -1;    //align at the x[0]
-	flt->buf = (float *)malloc(sizeof(float)*flt->buf_len);
-	memset(flt->buf,0,sizeof(float)*flt->buf_len);		//very important in the first time of convolution
+    flt->taps = (flt->flt_len + FA_FIR_ALIGN - 1) / FA_FIR_ALIGN * FA_FIR_ALIGN;
+
+    flt->hr_mem = malloc(sizeof(float)*flt->taps + 32);
+    flt->hr = (float *)(((size_t)flt->hr_mem + 31) & ~(size_t)31);
+    pad = flt->taps - flt->flt_len;
+    for (i = 0; i < pad; i++)
+        flt->hr[i] = 0;
+    for (i = 0; i < flt->flt_len; i++)
+        flt->hr[pad + i] = flt->h[flt->flt_len - 1 - i];
+
+    /* the whole frame is stored before filtering, so it must fit with the history */
+    flt->ring_len = flt->taps + flt->frame_len + FA_FIR_BLOCK;
+	flt->buf = (float *)malloc(sizeof(float)*2*flt->ring_len);
+	memset(flt->buf,0,sizeof(float)*2*flt->ring_len);		//very important in the first time of convolution
+    flt->pos = 0;
 
     return (uintptr_t)flt;
 }
 
-uintptr_t fa_fir_filter_hpf_init(int frame_len, 
+uintptr_t fa_fir_filter_lpf_init(int frame_len, 
                                  int flt_len, float fc, win_t win_type)
 {   
-    fa_fir_filter_t *flt = NULL;
+    fa_fir_filter_t *flt = fir_filter_alloc(fc, 0, 0);
 
-    flt = (fa_fir_filter_t *)malloc(sizeof(fa_fir_filter_t));
+    flt->flt_len = fa_fir_lpf_cof(&(flt->h), flt_len, fc, win_type);
 
-	flt->fc = fc;
-    flt->fc1 = 0;
-    flt->fc2 = 0;
+    return fir_filter_setup(flt, frame_len);
+}
 
-    flt->flt_len = fa_fir_hpf_cof(&(flt->h), flt_len, fc, win_type);
-    flt->frame_len = frame_len;
-    
-    flt->buf_len = flt->flt_len + flt->frame_len -1;
-	flt->buf = (float *)malloc(sizeof(float)*flt->buf_len);
-	memset(flt->buf,0,sizeof(float)*flt->buf_len);		//very important in the first time of convolution
+uintptr_t fa_fir_filter_hpf_init(int frame_len, 
+                                 int flt_len, float fc, win_t win_type)
+{   
+    fa_fir_filter_t *flt = fir_filter_alloc(fc, 0, 0);
 
-    return (uintptr_t)flt;
+    flt->flt_len = fa_fir_hpf_cof(&(flt->h), flt_len, fc, win_type);
 
+    return fir_filter_setup(flt, frame_len);
 }
 
 uintptr_t fa_fir_filter_bandpass_init(int frame_len, 
                                       int flt_len, float fc1, float fc2, win_t win_type)
 {   
-    fa_fir_filter_t *flt = NULL;
-
-    flt = (fa_fir_filter_t *)malloc(sizeof(fa_fir_filter_t));
-
-	flt->fc = 0;
-    flt->fc1 = fc1;
-    flt->fc2 = fc2;
+    fa_fir_filter_t *flt = fir_filter_alloc(0, fc1, fc2);
 
     flt->flt_len = fa_fir_bandpass_cof(&(flt->h), flt_len, fc1, fc2, win_type);
-    flt->frame_len = frame_len;
-    
-    flt->buf_len = flt->flt_len + flt->frame_len -1;
-	flt->buf = (float *)malloc(sizeof(float)*flt->buf_len);
-	memset(flt->buf,0,sizeof(float)*flt->buf_len);		//very important in the first time of convolution
 
-    return (uintptr_t)flt;
+    return fir_filter_setup(flt, frame_len);
 }
 
 uintptr_t fa_fir_filter_bandstop_init(int frame_len, 
                                       int flt_len, float fc1, float fc2, win_t win_type)
 {   
-    fa_fir_filter_t *flt = NULL;
-
-    flt = (fa_fir_filter_t *)malloc(sizeof(fa_fir_filter_t));
-
-	flt->fc = 0;
-    flt->fc1 = fc1;
-    flt->fc2 = fc2;
+    fa_fir_filter_t *flt = fir_filter_alloc(0, fc1, fc2);
 
     flt->flt_len = fa_fir_bandstop_cof(&(flt->h), flt_len, fc1, fc2, win_type);
-    flt->frame_len = frame_len;
-    
-    flt->buf_len = flt->flt_len + flt->frame_len -1;
-	flt->buf = (float *)malloc(sizeof(float)*flt->buf_len);
-	memset(flt->buf,0,sizeof(float)*flt->buf_len);		//very important in the first time of convolution
-
-    return (uintptr_t)flt;
 
+    return fir_filter_setup(flt, frame_len);
 }
 
 void fa_fir_filter_uninit(uintptr_t handle)
@@ -549,6 +676,8 @@ void fa_fir_filter_uninit(uintptr_t handle)
 
 	free(flt->h);
     flt->h = NULL;
+	free(flt->hr_mem);
+    flt->hr_mem = NULL;
 	free(flt->buf);
     flt->buf = NULL;
 
@@ -556,45 +685,52 @@ void fa_fir_filter_uninit(uintptr_t handle)
     flt = NULL;
 }
 
+static void fir_filter_run(fa_fir_filter_t *flt, const float *buf_in, float *buf_out, int frame_len)
+{
+	int i;
+    int   taps     = flt->taps;
+    int   ring_len = flt->ring_len;
+    int   pos      = flt->pos;
+	float *buf     = flt->buf;
+    int   xp;
+
+    /*append the new samples to both halves of the ring*/
+    for (i = 0; i < frame_len; i++) {
+        buf[flt->pos]            = buf_in[i];
+        buf[flt->pos + ring_len] = buf_in[i];
+        if (++flt->pos == ring_len)
+            flt->pos = 0;
+    }
 
+    /*
+     * window of the first output ends at pos, take it from the half where
+     * the history before it is contiguous, the mirror continues after it
+     */
+    xp = (pos >= taps - 1 ? pos : pos + ring_len) - (taps - 1);
+	for (i = 0; i < frame_len; ) {
+        if (xp + taps + FA_FIR_BLOCK - 1 > 2*ring_len)
+            xp -= ring_len;
+        if (i + FA_FIR_BLOCK <= frame_len) {
+            fir_dot_block(flt->hr, buf + xp, taps, buf_out + i);
+            xp += FA_FIR_BLOCK;
+            i  += FA_FIR_BLOCK;
+        } else {
+            buf_out[i] = fir_dot(flt->hr, buf + xp, taps);
+            xp++;
+            i++;
+        }
+	}
+}
 
 int fa_fir_filter(uintptr_t handle, float *buf_in, float *buf_out, int frame_len)
 {
-	int i;
     fa_fir_filter_t *flt = (fa_fir_filter_t *)handle;
-	
-	int   flt_len = flt->flt_len;
-    int   buf_len = flt->buf_len;
-	float *buf    = flt->buf;
-	float *h      = flt->h;
-    float *xp;
-    int   offset;
 
     assert(frame_len <= flt->frame_len);
 
-    /*move the old datas (flt_len-1) to the buf[0]*/
-    offset = buf_len - flt_len + 1;
-    for (i = 0; i < flt_len-1; i++) 
-        buf[i] = buf[offset+i];
-    for (i = 0; i < frame_len; i++)
-        buf[flt_len-1+i] = buf_in[i];
-
-    /*set the xp point to the first sample*/
-    xp = &(buf[flt_len -1]);
-	for (i = 0 ; i < frame_len ; ++i){
-        /*
-         *  x[0] x[1] x[2] ... x[n-1] x[n]
-         *                 ... z(-1)  z(0)  z-transform
-         *  old  <-----------------   new
-         *  use conv, input x(n) address, h(0) address
-         *  compute y += h(k)*x(n-k)  (k=0,1.. h_len-1)
-         */
-        buf_out[i] = fa_conv(xp, h, flt_len);
-        xp++;
-	}
+    fir_filter_run(flt, buf_in, buf_out, frame_len);
 
     return frame_len;
-
 }
 
 /*
@@ -603,38 +739,20 @@ int fa_fir_filter(uintptr_t handle, float *buf_in, float *buf_out, int frame_len
  */
 int fa_fir_filter_flush(uintptr_t handle, float *buf_out)
 {
-	int i;
     fa_fir_filter_t *flt = (fa_fir_filter_t *)handle;
-	
-	int   flt_len = flt->flt_len;
-    int   buf_len = flt->buf_len;
-	float *buf    = flt->buf;
-	float *h      = flt->h;
-    float *xp;
-    int   offset;
-    int   frame_len = flt->frame_len;
-
-
-    /*move the old datas (flt_len-1) to the buf[0]*/
-    offset = buf_len - flt_len + 1;
-    for (i = 0; i < flt_len-1; i++) 
-        buf[i] = buf[offset+i];
-    for (i = 0; i < frame_len; i++)
-        buf[flt_len-1+i] = 0;
-
-    xp = &(buf[flt_len -1]);
-	for (i = 0 ; i < flt_len-1 ; ++i){
-        /*
-         *  x[0] x[1] x[2] ... x[n-1] x[n]
-         *                 ... z(-1)  z(0)  z-transform
-         *  old  <-----------------   new
-         *  use conv, input x(n) address, h(0) address
-         *  compute y += h(k)*x(n-k)  (k=0,1.. h_len-1)
-         */
-        buf_out[i] = fa_conv(xp, h, flt_len);
-        xp++;
-	}
+    float zeros[FA_FIR_ALIGN * 8];
+    int   left = flt->flt_len - 1;
+    int   len;
+
+    memset(zeros, 0, sizeof(zeros));
+    while (left > 0) {
+        len = left < (int)(sizeof(zeros)/sizeof(zeros[0])) ? left : (int)(sizeof(zeros)/sizeof(zeros[0]));
+        if (len > flt->frame_len)
+            len = flt->frame_len;
+        fir_filter_run(flt, zeros, buf_out, len);
+        buf_out += len;
+        left    -= len;
+    }
 
-    return flt_len-1;
+    return flt->flt_len-1;
 }
-
@@ -38,8 +38,8 @@ extern "C"
 #endif  
 
 
-#ifdef OS_MAC
-typedef unsigned long uintptr_t;
+#if defined(OS_MAC) || defined(OS_POSIX)
+#include <stdint.h>
 #else
 typedef unsigned uintptr_t;
 #endif
@@ -5,6 +5,7 @@
 #include <stdio.h>
 #include <string>
 #include <stdlib.h>
+#include <string.h>
 #include "asr.h"
 
 #ifndef  ASR_HAS_VR
@@ -17,6 +18,7 @@
 #include <pthread.h>
 #include "msp_type.h"
 #include <vector>
+#include <algorithm>
 
 #ifdef OS_WIN32
 #include <Windows.h> 
@@ -119,32 +121,62 @@ void msp_passthru_stop()
 }
 
 
+// conversion state lives in every soxr_wav_ratio_convert call, nothing is kept
 void   soxr_wav_convert_init(int in_rate, int out_rate, int bits)
 {
-	//fa_wavfmt_t  fmt = fa_wavfmt_setheader(in_rate, bits);
-	int soxr_convert_byte = (bits + 8 - 1) / 8;
-	fa_resample_filter_init(out_rate, in_rate, soxr_convert_byte);
 }
 
 void soxr_wav_convert_destroy()
 {
 }
 
+/*
+	every call converts ibuf as whole mono stream with a resampler of its own
+	obuf must hold ilen*out_rate/in_rate plus the filter tail and two samples,
+	the tail is 30 samples, times out_rate/in_rate when upsampling
+*/
 int soxr_wav_ratio_convert(int in_rate, int out_rate, int bits, char *ibuf, int ilen, char *obuf, int*  olen)
 {
-	int ret = 0;
-	fa_resample_set(ilen, out_rate, in_rate);
-	int in_len_bytes = ilen;
-	printf("in_len=%d\n", in_len_bytes);
-
-	//resample
-	int out_len = 0;
-	if (-1 == fa_resample( (unsigned char*)ibuf, in_len_bytes, (unsigned char*)obuf, &out_len))
+	fa_resampler_t *resampler = fa_resampler_init(in_rate, out_rate, (bits + 8 - 1) / 8, KAISER);
+	if (resampler == NULL)
 		return -1;
-	*olen = out_len;
-	return ret;
+	*olen = fa_resampler_process(resampler, (unsigned char*)ibuf, ilen, (unsigned char*)obuf);
+	*olen += fa_resampler_flush(resampler, (unsigned char*)obuf + *olen);
+	fa_resampler_uninit(resampler);
+	return 0;
 }
 
+/*
+	resampler takes mono stream, so interleaved channels are converted one by one
+	ibuf == NULL flushes the filters, return size of interleaved output
+*/
+static int soxr_convert_channels(std::vector<fa_resampler_t*> &resamplers, int sample_size,
+	const char *ibuf, int ilen, std::vector<char> &chan_in, std::vector<char> &chan_out, char *obuf)
+{
+	const int channels = resamplers.size();
+	const int frame_size = sample_size * channels;
+	const int frames = ilen / frame_size;
+	int olen = 0;
+	for (int c = 0; c < channels; c++)
+	{
+		int chan_len;
+		if (ibuf == NULL)
+		{
+			chan_len = fa_resampler_flush(resamplers[c], (unsigned char*)&chan_out[0]);
+		}
+		else
+		{
+			for (int i = 0; i < frames; i++)
+				memcpy(&chan_in[i * sample_size], ibuf + i * frame_size + c * sample_size, sample_size);
+			chan_len = fa_resampler_process(resamplers[c], (unsigned char*)&chan_in[0],
+				frames * sample_size, (unsigned char*)&chan_out[0]);
+		}
+		for (int i = 0; i < chan_len / sample_size; i++)
+			memcpy(obuf + i * frame_size + c * sample_size, &chan_out[i * sample_size], sample_size);
+		olen = chan_len / sample_size * frame_size;
+	}
+	return olen;
+}
 
 int soxr_convert_file(char *input, char *output, int out_rate)
 {
@@ -156,46 +188,67 @@ int soxr_convert_file(char *input, char *output, int out_rate)
 	FILE* pfout = fopen(output, "w+b");
 	if (pfout == NULL)
 	{
+		fclose(pfin);
 		return -1;
 	}
 	wave_pcm_hdr   pcm_hdr;
 
 	fread(&pcm_hdr, 1, sizeof(wave_pcm_hdr), pfin);
 	int in_rate = pcm_hdr.samples_per_sec;
-	int read_len = in_rate*pcm_hdr.block_align / 50;
+	int channels = pcm_hdr.channels > 0 ? pcm_hdr.channels : 1;
+	int sample_size = pcm_hdr.bits_per_sample / 8;
+	int read_len = in_rate*sample_size*channels / 50;
+	// the file has resamplers of its own, so it may be converted while passthru runs
+	std::vector<fa_resampler_t*> resamplers(channels, (fa_resampler_t*)NULL);
+	bool init_ok = read_len > 0;
+	for (int c = 0; c < channels && init_ok; c++)
+	{
+		resamplers[c] = fa_resampler_init(in_rate, out_rate, sample_size, KAISER);
+		init_ok = resamplers[c] != NULL;
+	}
+	if (!init_ok)
+	{
+		for (int c = 0; c < channels; c++)
+			fa_resampler_uninit(resamplers[c]);
+		fclose(pfin);
+		fclose(pfout);
+		return -1;
+	}
 	pcm_hdr.samples_per_sec = out_rate;
 	pcm_hdr.avg_bytes_per_sec = out_rate*pcm_hdr.block_align;
 	fwrite(&pcm_hdr, 1, sizeof(wave_pcm_hdr), pfout);
-	soxr_wav_convert_init(in_rate, out_rate, pcm_hdr.bits_per_sample);
 
 	fseek(pfin, 44, SEEK_SET);
 	fseek(pfout, 44, SEEK_SET);
 	int total_size = 0;
-	int ret = 0;
+	std::vector<char> buf(read_len);
+	std::vector<char> chan_in(read_len / channels);
+	std::vector<char> chan_out(std::max(fa_resampler_out_size(resamplers[0], chan_in.size()),
+		fa_resampler_out_size(resamplers[0], fa_resampler_delay(resamplers[0]))));
+	std::vector<char> obuf(chan_out.size() * channels);
 	while (!feof(pfin))
 	{
-		char buf[3000] = { 0 };
-		char obuf[3000] = { 0 };
-		int olen = 0;
-		//fgets(buf,(pcm_hdr.avg_bytes_per_sec/50),pfin);
-		int ilen = fread(buf, 1, read_len, pfin);
+		int ilen = fread(&buf[0], 1, read_len, pfin);
 		if (ilen <= 0){
-			ret = -1;
 			break;
 		}
-		ret = soxr_wav_ratio_convert(in_rate, out_rate, pcm_hdr.bits_per_sample, buf, ilen, obuf, &olen);
-		if (-1 == ret)
-			break;
-		fwrite(obuf, 1, olen, pfout);
+		int olen = soxr_convert_channels(resamplers, sample_size, &buf[0], ilen, chan_in, chan_out, &obuf[0]);
+		fwrite(&obuf[0], 1, olen, pfout);
 		total_size += olen;
 	}
+	int olen = soxr_convert_channels(resamplers, sample_size, NULL, 0, chan_in, chan_out, &obuf[0]);
+	fwrite(&obuf[0], 1, olen, pfout);
+	total_size += olen;
+	for (int c = 0; c < channels; c++)
+		fa_resampler_uninit(resamplers[c]);
+
 	pcm_hdr.data_size = total_size;
 	pcm_hdr.size_8 = pcm_hdr.data_size + 44;
 	fseek(pfout, 0, SEEK_SET);
 	fwrite(&pcm_hdr, 1, sizeof(pcm_hdr), pfout);
 	fclose(pfin);
 	fclose(pfout);
-	return ret;
+	return 0;
 }
 
 
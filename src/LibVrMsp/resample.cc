@@ -8,224 +8,297 @@
 #include <assert.h>
 #include <memory.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FA_RESAMPLE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define FA_RESAMPLE_NEON
+#include <arm_neon.h>
+#endif
+
 #define MAXV(a, b)	(((a) > (b)) ? (a) : (b))
 #define MINV(a, b)	(((a) < (b)) ? (a) : (b))
 
+/* input samples converted at once, the history of the filter is kept before them */
+#define FA_RESAMPLE_BLOCK       1024
+/* stopband attenuation of prototype filter, matches fixed beta of fa_kaiser */
+#define FA_RESAMPLE_ATTEN       90.
+/* transition band relative to the cutoff, passband is about 0.9 of lower nyquist */
+#define FA_RESAMPLE_TRANS       0.2
+/* taps of every phase are padded to vector width */
+#define FA_RESAMPLE_ALIGN       4
 
-typedef struct _fa_resample_filter_t {
+struct _fa_resampler_t {
 	int L;                  /* interp factor */
 	int M;                  /* decimate factor */
-	float fc;               /* cutoff freqency, normalized */
-
-	
-	float gain;
+	int K;                  /* taps per phase */
 
 	int bytes_per_sample;
-	int num_in;             /* number of sample in */
-	int num_out;            /* number of sample out */
-	int out_index;
-	int bytes_in;
-	int bytes_out;
 
-}fa_resample_filter_t;
+	void  *coef_mem;
+	float *coef;            /* L phases of K taps, taps are reversed in time */
 
-static  fa_resample_filter_t    resample_resflt;
+	float *buf;             /* K-1 samples of history followed by new block */
+	int   buf_len;
+	int   filled;           /* valid samples in buf */
+	int   pos;              /* newest input sample of next output */
+	int   phase;            /* phase of next output, 0..L-1 */
+};
 
-void fa_resample_filter_init(int L, int M, int bytes_per_sample)
+static int gcd(int a, int b)
 {
-	//fa_resample_filter_t *resflt = NULL;
-	int lm_gcd;
-	float ratio;
-
-	//resflt = (fa_resample_filter_t *)malloc(sizeof(fa_resample_filter_t));
-	//lm_gcd = gcd(L, M);
-	L = L / 50;
-	M = M / 50;
-	ratio = ((float)L) / M;
-	if ((ratio      > FA_RATIO_MAX) ||
-		((1. / ratio) > FA_RATIO_MAX))
-		return ;
-	//resample set
-	resample_resflt.L = L;
-	resample_resflt.M = M;
-	resample_resflt.fc = MINV(1. / L, 1. / M);
-	resample_resflt.gain = 1.0;
-
-	resample_resflt.bytes_per_sample = bytes_per_sample;       /*default we set to 2 bytes per sample */
-	resample_resflt.out_index = 0;
-
-	//timevary_filter_init(&(resample_resflt.tvflt), L, M, resample_resflt.fc, L, win_type);
-
-	//return (uintptr_t)resflt;
+	while (b) {
+		int t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
 }
 
-
-void fa_resample_set(int ilen, int L, int M)
+/*
+ * y = sum(a[i]*b[i]), n is multiple of FA_RESAMPLE_ALIGN, a is 16 bytes aligned
+ */
+static float dot_product(const float *a, const float *b, int n)
 {
-	/*fa_resample_filter_t *resflt = (fa_resample_filter_t *)handle;
-	if (resflt == NULL)
-		return;*/
-	resample_resflt.num_in = ilen / resample_resflt.bytes_per_sample;
-	resample_resflt.num_out = (resample_resflt.num_in*L) / M;
-	resample_resflt.bytes_in =  ilen;
-	resample_resflt.bytes_out = resample_resflt.bytes_per_sample * resample_resflt.num_out;
-
-	//resample_resflt.buf = NULL;
-	//resample_resflt.buf_len = (resample_resflt.tvflt.k + resample_resflt.num_in) * resample_resflt.bytes_per_sample;
-	//resample_resflt.buf = (unsigned char *)malloc(resample_resflt.buf_len * sizeof(char));
-	//memset(resample_resflt.buf, 0, sizeof(char)*resample_resflt.buf_len);
-}
-
-
-
-int fa_resample( unsigned char *sample_in, int sample_in_size,
-	unsigned char *sample_out, int *sample_out_size)
-{
-	if (resample_resflt.bytes_per_sample == 2)
-		return fa_resample_16bit(sample_in, sample_in_size, sample_out, sample_out_size);
-	else
-		return fa_resample_8bit(sample_in, sample_in_size, sample_out, sample_out_size);
+	int i;
+#if defined(FA_RESAMPLE_SSE2)
+	__m128 acc0 = _mm_setzero_ps();
+	__m128 acc1 = _mm_setzero_ps();
+	float  sum[4];
+
+	for (i = 0; i + 8 <= n; i += 8) {
+		acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load_ps(a + i), _mm_loadu_ps(b + i)));
+		acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_load_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+	}
+	if (i < n)
+		acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_load_ps(a + i), _mm_loadu_ps(b + i)));
+	acc0 = _mm_add_ps(acc0, acc1);
+	_mm_storeu_ps(sum, acc0);
+	return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+#elif defined(FA_RESAMPLE_NEON)
+	float32x4_t acc0 = vdupq_n_f32(0.f);
+	float32x4_t acc1 = vdupq_n_f32(0.f);
+	float32x2_t sum;
+
+	for (i = 0; i + 8 <= n; i += 8) {
+		acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+		acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+	}
+	if (i < n)
+		acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+	acc0 = vaddq_f32(acc0, acc1);
+	sum = vadd_f32(vget_low_f32(acc0), vget_high_f32(acc0));
+	return vget_lane_f32(vpadd_f32(sum, sum), 0);
+#else
+	float y0 = 0.f, y1 = 0.f, y2 = 0.f, y3 = 0.f;
+
+	for (i = 0; i < n; i += 4) {
+		y0 += a[i]     * b[i];
+		y1 += a[i + 1] * b[i + 1];
+		y2 += a[i + 2] * b[i + 2];
+		y3 += a[i + 3] * b[i + 3];
+	}
+	return (y0 + y1) + (y2 + y3);
+#endif
 }
 
-int fa_resample_16bit( unsigned char *sample_in, int sample_in_size,
-	unsigned char *sample_out, int *sample_out_size)
+fa_resampler_t *fa_resampler_init(int in_rate, int out_rate,
+	int bytes_per_sample, win_t win_type)
 {
-
-	int i;
-	int l, k;
-	int offset;
-
-	//short
-	short *pbuf;
-	short *psample_in;
-	short *psample_out;
-	short *x;
-	short *xp;
-
-	int L, M, Q;
-	float gain = resample_resflt.gain;
-
-	if (sample_in_size != resample_resflt.bytes_in)
-		return -1;
-
-	L = resample_resflt.L;
-	M = resample_resflt.M;
-	//Q = resample_resflt.tvflt.k;
-
-	//pbuf = (short *)resample_resflt.buf;
-	psample_in = (short *)sample_in;
-	psample_out = (short *)sample_out;
-
-
-	/*move the old datas (flt_len-1) to the buf[0]*/
-	//offset = resample_resflt.bytes_in / resample_resflt.bytes_per_sample/* - Q*/;
-
-	/*for (i = 0; i < Q; i++)
-	{
-		pbuf[i] = pbuf[offset + i];
+	fa_resampler_t *resampler;
+	float *h = NULL;
+	float fc, ftrans;
+	int   lm_gcd, N, p, i;
+
+	if (in_rate <= 0 || out_rate <= 0)
+		return NULL;
+	if (bytes_per_sample != 1 && bytes_per_sample != 2)
+		return NULL;
+	if (out_rate > in_rate * FA_RATIO_MAX || in_rate > out_rate * FA_RATIO_MAX)
+		return NULL;
+
+	resampler = (fa_resampler_t *)malloc(sizeof(fa_resampler_t));
+	if (resampler == NULL)
+		return NULL;
+	memset(resampler, 0, sizeof(fa_resampler_t));
+
+	lm_gcd = gcd(in_rate, out_rate);
+	resampler->L = out_rate / lm_gcd;
+	resampler->M = in_rate / lm_gcd;
+	resampler->bytes_per_sample = bytes_per_sample;
+
+	/*
+	 * prototype lowpass works at in_rate*L, its cutoff is the nyquist of
+	 * the lower rate minus half of the transition band, so images of
+	 * upsampling and aliases of decimation are both in the stopband
+	 */
+	fc     = 1.f / MAXV(resampler->L, resampler->M);
+	ftrans = (float)FA_RESAMPLE_TRANS * fc;
+	N = fa_kaiser_cof_num(ftrans, (float)FA_RESAMPLE_ATTEN);
+	resampler->K = (N + resampler->L - 1) / resampler->L;
+	resampler->K = (resampler->K + FA_RESAMPLE_ALIGN - 1) / FA_RESAMPLE_ALIGN * FA_RESAMPLE_ALIGN;
+	N = resampler->K * resampler->L;
+
+	fa_fir_lpf_cof(&h, N, fc - ftrans / 2, win_type);
+	if (h == NULL) {
+		free(resampler);
+		return NULL;
 	}
 
-	for (i = 0; i < resample_resflt.num_in; i++)
-	{
-		pbuf[Q + i] = psample_in[i];
-	}*/
-
-
-	/*set the xp point to the first sample*/
-	x =psample_in /*&pbuf[Q]*/;
-	*sample_out_size = 0;
-
-	for (i = 0; i < resample_resflt.num_out; i++) {
-		float y = 0.0;
-
-		xp = x + (i*M) / L;
-		l = resample_resflt.out_index%L;
-		resample_resflt.out_index++;
-
-		//for (k = 0 ; k < Q; k++) {
-		//	y += xp[-k] * resample_resflt.tvflt.g[l][k]; /* decimate by M */
-		//      }
-		y = *xp;
-
-		y *= gain;
-
-		if (y > 32767)
-			y = 32767;
-		if (y < -32768)
-			y = -32768;
-
-		psample_out[i] = (short)y;
-
+	/* the phases are split from the prototype, gain L restores the level */
+	resampler->coef_mem = malloc(sizeof(float) * N + 16);
+	if (resampler->coef_mem == NULL) {
+		free(h);
+		free(resampler);
+		return NULL;
+	}
+	resampler->coef = (float *)(((size_t)resampler->coef_mem + 15) & ~(size_t)15);
+	for (p = 0; p < resampler->L; p++) {
+		float *coef = resampler->coef + p * resampler->K;
+		for (i = 0; i < resampler->K; i++)
+			coef[i] = resampler->L * h[p + (resampler->K - 1 - i) * resampler->L];
 	}
+	free(h);
 
-	*sample_out_size = resample_resflt.bytes_out;
+	resampler->buf_len = resampler->K - 1 + FA_RESAMPLE_BLOCK;
+	resampler->buf = (float *)malloc(sizeof(float) * resampler->buf_len);
+	if (resampler->buf == NULL) {
+		fa_resampler_uninit(resampler);
+		return NULL;
+	}
 
-	return 0;
+	fa_resampler_reset(resampler);
 
+	return resampler;
 }
 
-int fa_resample_8bit(unsigned char *sample_in, int sample_in_size,
-	unsigned char *sample_out, int *sample_out_size)
+void fa_resampler_uninit(fa_resampler_t *resampler)
 {
-	int i;
-	int l, k;
-	int offset;
+	if (resampler == NULL)
+		return;
 
-	//pthr
-	char *pbuf;
-	char *psample_in;
-	char *psample_out;
-	char *x;
-	char *xp;
-
-	int L, M, Q;
-	float gain = resample_resflt.gain;
+	free(resampler->coef_mem);
+	free(resampler->buf);
+	free(resampler);
+}
 
-	if (sample_in_size != resample_resflt.bytes_in)
-		return -1;
+void fa_resampler_reset(fa_resampler_t *resampler)
+{
+	/* history is silence, the first output is aligned to the first input */
+	memset(resampler->buf, 0, sizeof(float) * resampler->buf_len);
+	resampler->filled = resampler->K - 1;
+	resampler->pos    = resampler->K - 1;
+	resampler->phase  = 0;
+}
 
-	L = resample_resflt.L;
-	M = resample_resflt.M;
-	//Q = resample_resflt.tvflt.k;
+int fa_resampler_out_size(const fa_resampler_t *resampler, int sample_in_size)
+{
+	long long num_in = sample_in_size / resampler->bytes_per_sample;
+	long long num_out = (num_in * resampler->L + resampler->M - 1) / resampler->M + 1;
 
-	//pbuf = (char *)resample_resflt.buf;
-	psample_in = (char *)sample_in;
-	psample_out = (char *)sample_out;
+	return (int)num_out * resampler->bytes_per_sample;
+}
 
+int fa_resampler_delay(const fa_resampler_t *resampler)
+{
+	return (resampler->K / 2) * resampler->bytes_per_sample;
+}
 
-	/*move the old datas (flt_len-1) to the buf[0]*/
-	
+static void load_block(fa_resampler_t *resampler, const unsigned char *sample_in, int num)
+{
+	float *x = resampler->buf + resampler->filled;
+	int i;
 
+	if (resampler->bytes_per_sample == 2) {
+		for (i = 0; i < num; i++)
+			x[i] = (short)(sample_in[2*i] | (sample_in[2*i + 1] << 8));
+	} else {
+		for (i = 0; i < num; i++)
+			x[i] = (float)sample_in[i] - 128.f;
+	}
+	resampler->filled += num;
+}
 
-	/*set the xp point to the first sample*/
-	x = psample_in;
-	*sample_out_size = 0;
+static int filter_block(fa_resampler_t *resampler, unsigned char *sample_out)
+{
+	const int L = resampler->L;
+	const int M = resampler->M;
+	const int K = resampler->K;
+	int num_out = 0;
+	int keep_from;
+
+	while (resampler->pos < resampler->filled) {
+		float y = dot_product(resampler->coef + resampler->phase * K,
+		                      resampler->buf + resampler->pos - (K - 1), K);
+
+		if (resampler->bytes_per_sample == 2) {
+			int v;
+			if (y > 32767.f)
+				y = 32767.f;
+			if (y < -32768.f)
+				y = -32768.f;
+			v = (int)(y < 0 ? y - 0.5f : y + 0.5f);
+			sample_out[2*num_out]     = (unsigned char)(v & 0xff);
+			sample_out[2*num_out + 1] = (unsigned char)((v >> 8) & 0xff);
+		} else {
+			y += 128.f;
+			if (y > 255.f)
+				y = 255.f;
+			if (y < 0.f)
+				y = 0.f;
+			sample_out[num_out] = (unsigned char)(y + 0.5f);
+		}
+		num_out++;
+
+		resampler->phase += M;
+		resampler->pos   += resampler->phase / L;
+		resampler->phase %= L;
+	}
 
-	for (i = 0; i < resample_resflt.num_out; i++) {
-		float y = 0.0;
+	/* keep history of the next output, pos may already be after the block */
+	keep_from = MINV(resampler->pos - (K - 1), resampler->filled);
+	if (keep_from > 0) {
+		memmove(resampler->buf, resampler->buf + keep_from,
+		        sizeof(float) * (resampler->filled - keep_from));
+		resampler->filled -= keep_from;
+		resampler->pos    -= keep_from;
+	}
 
-		xp = x + (i*M) / L;
-		l = resample_resflt.out_index%L;
-		resample_resflt.out_index++;
+	return num_out * resampler->bytes_per_sample;
+}
 
-		//for (k = 0; k < Q; k++) {
-		//	y += xp[-k] * resample_resflt.tvflt.g[l][k]; /* decimate by M */
-		//}
-		y = *xp;
-		y *= gain;
+int fa_resampler_process(fa_resampler_t *resampler,
+	const unsigned char *sample_in, int sample_in_size,
+	unsigned char *sample_out)
+{
+	int num_in = sample_in_size / resampler->bytes_per_sample;
+	int out_size = 0;
 
-		if (y > 127)
-			y = 127;
-		if (y < -128)
-			y = -128;
+	while (num_in > 0) {
+		int num = MINV(num_in, resampler->buf_len - resampler->filled);
 
-		psample_out[i] = (char)y;
+		load_block(resampler, sample_in, num);
+		sample_in += num * resampler->bytes_per_sample;
+		num_in    -= num;
 
+		out_size += filter_block(resampler, sample_out + out_size);
 	}
 
-	*sample_out_size = resample_resflt.bytes_out;
+	return out_size;
+}
 
-	return 0;
+int fa_resampler_flush(fa_resampler_t *resampler, unsigned char *sample_out)
+{
+	unsigned char silence[2 * 64];
+	int left = fa_resampler_delay(resampler);
+	int out_size = 0;
+
+	memset(silence, resampler->bytes_per_sample == 1 ? 128 : 0, sizeof(silence));
+	while (left > 0) {
+		int size = MINV(left, (int)sizeof(silence));
+		out_size += fa_resampler_process(resampler, silence, size, sample_out + out_size);
+		left -= size;
+	}
 
+	return out_size;
 }
-
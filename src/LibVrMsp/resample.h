@@ -3,21 +3,55 @@
 
 #include "fa_fir.h"
 
-//typedef unsigned uintptr_t;
+#define FA_RATIO_MAX            16
 
-#define FA_DEFAULT_FRAMELEN     1024            /* default num of sample in */
-#define FA_FRAMELEN_MAX         (160*147+8192)  /* 8192 no meaning, I just set here to safe regarding */
+/*
+	polyphase resampler of mono pcm stream, 8 bit samples are unsigned and
+	16 bit samples are signed as in wav files.
+	every stream has its own handle, so several streams can be converted
+	concurrently, and chunks of any length can be passed to process.
+*/
+typedef struct _fa_resampler_t fa_resampler_t;
 
-#define FA_RATIO_MAX            16
+/*
+	in_rate, out_rate: sample rate in Hz, the ratio is limited by FA_RATIO_MAX
+	bytes_per_sample : 1 or 2
+	win_type         : window of prototype lowpass filter (see fa_fir.h)
+	return NULL if parameters are not supported or memory is exhausted
+*/
+fa_resampler_t *fa_resampler_init(int in_rate, int out_rate,
+	int bytes_per_sample, win_t win_type);
+
+void fa_resampler_uninit(fa_resampler_t *resampler);
+
+/*
+	drop buffered history, next sample is treated as start of new stream
+*/
+void fa_resampler_reset(fa_resampler_t *resampler);
+
+/*
+	max size in bytes of output produced by process for sample_in_size bytes
+*/
+int fa_resampler_out_size(const fa_resampler_t *resampler, int sample_in_size);
+
+/*
+	convert chunk of input, trailing bytes of incomplete sample are ignored
+	sample_out must hold fa_resampler_out_size(sample_in_size) bytes
+	return size of output in bytes
+*/
+int fa_resampler_process(fa_resampler_t *resampler,
+	const unsigned char *sample_in, int sample_in_size,
+	unsigned char *sample_out);
 
-int fa_resample( unsigned char *sample_in, int sample_in_size,
-	unsigned char *sample_out, int *sample_out_size);
+/*
+	push out samples delayed by the filter at the end of stream
+	sample_out must hold fa_resampler_out_size(fa_resampler_delay()) bytes
+*/
+int fa_resampler_flush(fa_resampler_t *resampler, unsigned char *sample_out);
 
-void fa_resample_filter_init(int L, int M, int bytes_per_sample);
-void fa_resample_set(int ilen, int L, int M);
-int fa_resample_8bit(unsigned char *sample_in, int sample_in_size,
-	unsigned char *sample_out, int *sample_out_size);
-int fa_resample_16bit(unsigned char *sample_in, int sample_in_size,
-	unsigned char *sample_out, int *sample_out_size);
+/*
+	filter delay in bytes of input
+*/
+int fa_resampler_delay(const fa_resampler_t *resampler);
 
-#endif
\ No newline at end of file
+#endif
@@ -35,9 +35,12 @@
 #include <global_first.h>
 #endif
 #include "./life_cycle.h"
+#include "./startup_sequence.h"
 #include "utils/signals.h"
 #include "config_profile/profile.h"
 #include "resumption/last_state.h"
+#include "application_manager/policies/policy_handler.h"
+#include "utils/async_file_io.h"
 #ifdef SP_C9_PRIMA1
 #include "utils/file_system.h"
 #endif
@@ -90,32 +93,107 @@ LifeCycle::LifeCycle()
 
 bool LifeCycle::StartComponents() {
   LOG4CXX_INFO(logger_, "LifeCycle::StartComponents()");
+  typedef StartupSequence::PhaseId PhaseId;
+
+  // Singleton guards its creation with function-local static lock, which
+  // isn't initialized thread-safe by every compiler (MSVC for WinCE is
+  // one), so singletons used by several phases are created before phases
+  // run in parallel. Policy handler is used by PolicyTable phase and by
+  // constructor of Application Manager.
+  policy::PolicyHandler::instance();
+
+  StartupSequence sequence;
+
+  const PhaseId transport_manager = sequence.AddPhase(
+    "TransportManager", this, &LifeCycle::CreateTransportManager);
+  const PhaseId protocol_handler = sequence.AddPhase(
+    "ProtocolHandler", this, &LifeCycle::CreateProtocolHandler);
+  sequence.AddDependency(protocol_handler, transport_manager);
+  const PhaseId connection_handler = sequence.AddPhase(
+    "ConnectionHandler", this, &LifeCycle::CreateConnectionHandler);
+  const PhaseId hmi_handler = sequence.AddPhase(
+    "HMIMessageHandler", this, &LifeCycle::CreateHMIMessageHandler);
+  const PhaseId media_manager = sequence.AddPhase(
+    "MediaManager", this, &LifeCycle::CreateMediaManager);
+  // Policy DB is loaded while Application Manager parses HMI capabilities,
+  // Application Manager picks the loaded table up at the end of its creation
+  const PhaseId policy_table = sequence.AddPhase(
+    "PolicyTable", this, &LifeCycle::LoadPolicyTable);
+  const PhaseId app_manager = sequence.AddPhase(
+    "ApplicationManager", this, &LifeCycle::CreateApplicationManager);
+  sequence.AddDependency(app_manager, media_manager);
+
+  const PhaseId connect = sequence.AddPhase(
+    "ConnectComponents", this, &LifeCycle::ConnectComponents);
+  sequence.AddDependency(connect, protocol_handler);
+  sequence.AddDependency(connect, connection_handler);
+  sequence.AddDependency(connect, hmi_handler);
+  sequence.AddDependency(connect, policy_table);
+  sequence.AddDependency(connect, app_manager);
+
+  // It's important to initialise TM after setting up listener chain
+  // [TM -> CH -> AM], otherwise some events from TM could arrive at nowhere
+  const PhaseId start_transport_manager = sequence.AddPhase(
+    "TransportAdapters", this, &LifeCycle::StartTransportManager);
+  sequence.AddDependency(start_transport_manager, connect);
+#ifdef TIME_TESTER
+  // it is important to initialise TimeTester before TM to listen TM Adapters
+  const PhaseId time_tester = sequence.AddPhase(
+    "TimeTester", this, &LifeCycle::CreateTimeTester);
+  sequence.AddDependency(time_tester, connect);
+  sequence.AddDependency(start_transport_manager, time_tester);
+#endif  // TIME_TESTER
+
+  return sequence.Run();
+}
+
+bool LifeCycle::CreateTransportManager() {
   transport_manager_ =
     transport_manager::TransportManagerDefault::instance();
-  DCHECK(transport_manager_ != NULL);
+  return transport_manager_ != NULL;
+}
 
+bool LifeCycle::CreateProtocolHandler() {
   protocol_handler_ =
     new protocol_handler::ProtocolHandlerImpl(transport_manager_);
-  DCHECK(protocol_handler_ != NULL);
+  return protocol_handler_ != NULL;
+}
 
+bool LifeCycle::CreateConnectionHandler() {
   connection_handler_ =
     connection_handler::ConnectionHandlerImpl::instance();
-  DCHECK(connection_handler_ != NULL);
+  return connection_handler_ != NULL;
+}
 
-  app_manager_ =
-    application_manager::ApplicationManagerImpl::instance();
-  DCHECK(app_manager_ != NULL);
+bool LifeCycle::CreateHMIMessageHandler() {
   hmi_handler_ =
     hmi_message_handler::HMIMessageHandlerImpl::instance();
-  DCHECK(hmi_handler_ != NULL)
+  return hmi_handler_ != NULL;
+}
+
+bool LifeCycle::CreateMediaManager() {
+  media_manager_ = media_manager::MediaManagerImpl::instance();
+  return media_manager_ != NULL;
+}
 
+bool LifeCycle::LoadPolicyTable() {
+  // Working without policy is not a startup failure
+  policy::PolicyHandler::instance()->LoadPolicyTable();
+  return true;
+}
+
+bool LifeCycle::CreateApplicationManager() {
+  app_manager_ =
+    application_manager::ApplicationManagerImpl::instance();
+  return app_manager_ != NULL;
+}
+
+bool LifeCycle::ConnectComponents() {
   transport_manager_->AddEventListener(protocol_handler_);
   transport_manager_->AddEventListener(connection_handler_);
 
   hmi_handler_->set_message_observer(app_manager_);
 
-  media_manager_ = media_manager::MediaManagerImpl::instance();
-
   connection_handler_->SetProtocolHandler(protocol_handler_);
   protocol_handler_->set_session_observer(connection_handler_);
   protocol_handler_->AddProtocolObserver(media_manager_);
@@ -125,19 +203,24 @@ bool LifeCycle::StartComponents() {
   connection_handler_->set_transport_manager(transport_manager_);
   connection_handler_->set_connection_handler_observer(app_manager_);
 
-  // it is important to initialise TimeTester before TM to listen TM Adapters
+  app_manager_->set_protocol_handler(protocol_handler_);
+  app_manager_->set_connection_handler(connection_handler_);
+  app_manager_->set_hmi_message_handler(hmi_handler_);
+  return true;
+}
+
 #ifdef TIME_TESTER
+bool LifeCycle::CreateTimeTester() {
   time_tester_ = new time_tester::TimeManager();
-  time_tester_->Init(protocol_handler_);
-#endif //TIME_TESTER
-  // It's important to initialise TM after setting up listener chain
-  // [TM -> CH -> AM], otherwise some events from TM could arrive at nowhere
+  time_tester_->Init();
+  return true;
+}
+#endif  // TIME_TESTER
+
+bool LifeCycle::StartTransportManager() {
   transport_manager_->Init();
   //start transport manager
   transport_manager_->Visibility(true);
-  app_manager_->set_protocol_handler(protocol_handler_);
-  app_manager_->set_connection_handler(connection_handler_);
-  app_manager_->set_hmi_message_handler(hmi_handler_);
   return true;
 }
 
@@ -291,6 +374,10 @@ void LifeCycle::StopComponents() {
   media_manager_->SetProtocolHandler(NULL);
   media_manager::MediaManagerImpl::destroy();
 
+  // Completions of queued writes are passed to Application Manager
+  LOG4CXX_INFO(logger_, "Destroying Async File IO");
+  file_system::AsyncFileIO::destroy();
+
   LOG4CXX_INFO(logger_, "Destroying Application Manager.");
   application_manager::ApplicationManagerImpl::destroy();
 
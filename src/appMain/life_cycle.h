@@ -65,6 +65,11 @@
 namespace main_namespace {
 class LifeCycle : public utils::Singleton<LifeCycle> {
   public:
+    /**
+    * Creates and connects components, independent ones
+    * are created in parallel, see StartupSequence
+    * @return true if success otherwise false.
+    */
     bool StartComponents();
 
     /**
@@ -77,6 +82,21 @@ class LifeCycle : public utils::Singleton<LifeCycle> {
 
   private:
     LifeCycle();
+
+    // Startup phases run by StartComponents
+    bool CreateTransportManager();
+    bool CreateProtocolHandler();
+    bool CreateConnectionHandler();
+    bool CreateHMIMessageHandler();
+    bool CreateMediaManager();
+    bool LoadPolicyTable();
+    bool CreateApplicationManager();
+    bool ConnectComponents();
+#ifdef TIME_TESTER
+    bool CreateTimeTester();
+#endif  // TIME_TESTER
+    bool StartTransportManager();
+
     transport_manager::TransportManager* transport_manager_;
     protocol_handler::ProtocolHandlerImpl* protocol_handler_;
     connection_handler::ConnectionHandlerImpl* connection_handler_;
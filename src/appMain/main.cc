@@ -36,11 +36,13 @@
 #endif
 #ifndef OS_WINCE
 #include <sys/stat.h>
+#include <fcntl.h>
 #endif
 
 #ifdef OS_WIN32
 #include <stdint.h>
 #else
+#include <errno.h>
 #include <unistd.h>
 #endif
 #include <cstdio>
@@ -59,6 +61,7 @@
 
 #include "utils/signals.h"
 #include "utils/system.h"
+#include "utils/latency_statistics.h"
 #include "config_profile/profile.h"
 
 #if defined(EXTENDED_MEDIA_MODE)
@@ -90,6 +93,59 @@ const std::string kBrowserName = "chromium-browser";
 const std::string kBrowserParams = "--auth-schemes=basic,digest,ntlm";
 const std::string kLocalHostAddress = "127.0.0.1";
 const std::string kApplicationVersion = "SDL_RB_B3.5";
+const char kLatencyStatisticsFile[] = "latency_statistics.json";
+
+/**
+ * Write latency statistics to file.
+ */
+void DumpLatencyStatistics() {
+  const std::string snapshot =
+    utils::LatencyStatistics::instance()->Snapshot();
+  std::ofstream file(kLatencyStatisticsFile,
+                     std::ios_base::out | std::ios_base::trunc);
+  file << snapshot;
+}
+
+#if !defined(OS_WIN32) && !defined(BUILD_TARGET_LIB)
+// Dump signal handler only writes to this pipe, statistics are
+// formatted and written by main thread which reads it
+int dump_pipe[2] = {-1, -1};
+
+void RequestLatencyStatisticsDump(int32_t) {
+  const int saved_errno = errno;
+  const char request = 'd';
+  // Request is dropped if pipe is full, dump is pending anyway
+  const ssize_t result = write(dump_pipe[1], &request, sizeof(request));
+  (void)result;
+  errno = saved_errno;
+}
+
+bool SubscribeToDumpRequests() {
+  if (0 != pipe(dump_pipe)) {
+    return false;
+  }
+  fcntl(dump_pipe[1], F_SETFL, fcntl(dump_pipe[1], F_GETFL) | O_NONBLOCK);
+  return utils::SubscribeToDumpSignal(&RequestLatencyStatisticsDump);
+}
+
+/**
+ * Serve dump requests until process is terminated by signal.
+ */
+void WaitForDumpRequests() {
+  while (true) {
+    char request;
+    const ssize_t result = read(dump_pipe[0], &request, sizeof(request));
+    if (sizeof(request) == result) {
+      DumpLatencyStatistics();
+    } else if (-1 == result && EINTR == errno) {
+      continue;
+    } else {
+      // No pipe, only termination is expected
+      pause();
+    }
+  }
+}
+#endif
 
 #ifdef WEB_HMI
 /**
@@ -236,7 +292,11 @@ NsSmartDeviceLink::NsJSONHandler::strings::kMessage = "message";
   }
 #endif  // __QNX__
 	
-  main_namespace::LifeCycle::instance()->StartComponents();
+  if (!main_namespace::LifeCycle::instance()->StartComponents()) {
+    LOG4CXX_FATAL(logger, "Failed to start components");
+    DEINIT_LOGGER();
+    exit(EXIT_FAILURE);
+  }
 
   // --------------------------------------------------------------------------
   // Third-Party components initialization.
@@ -268,6 +328,12 @@ NsSmartDeviceLink::NsJSONHandler::strings::kMessage = "message";
 
   utils::SubscribeToTerminateSignal(
     &main_namespace::LifeCycle::StopComponentsOnSignal);
+  utils::LatencyStatistics::instance();
+#if !defined(OS_WIN32) && !defined(BUILD_TARGET_LIB)
+  if (!SubscribeToDumpRequests()) {
+    LOG4CXX_WARN(logger, "Latency statistics dump signal is not available");
+  }
+#endif
 #ifdef  MODIFY_FUNCTION_SIGN
   msp_mem_init(MSP_MEM_SERVER);
   msp_vr_init(NULL, NULL);
@@ -283,7 +349,7 @@ while (true) {
 	Sleep(100500 * 1000);
 }
 #else
-	pause();
+	WaitForDumpRequests();
 #endif
 #endif
 
@@ -0,0 +1,219 @@
+/**
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef MODIFY_FUNCTION_SIGN
+#include <global_first.h>
+#endif
+#include "./startup_sequence.h"
+
+#include <algorithm>
+
+#include "utils/logger.h"
+#include "utils/threads/thread.h"
+#include "utils/threads/thread_delegate.h"
+
+namespace main_namespace {
+CREATE_LOGGERPTR_GLOBAL(logger_, "appMain")
+
+namespace {
+
+struct StartTimeLess {
+  explicit StartTimeLess(const std::vector<TimevalStruct>& start_times)
+    : start_times_(start_times) {
+  }
+  bool operator()(size_t lhs, size_t rhs) const {
+    return date_time::DateTime::calculateTimeDiff(start_times_[rhs],
+                                                  start_times_[lhs]) > 0;
+  }
+  const std::vector<TimevalStruct>& start_times_;
+};
+
+}  // namespace
+
+class StartupSequence::PhaseDelegate : public threads::ThreadDelegate {
+ public:
+  PhaseDelegate(StartupSequence* sequence, PhaseId id)
+    : sequence_(sequence),
+      id_(id) {
+  }
+
+  virtual void threadMain() {
+    sequence_->RunPhase(id_);
+  }
+
+  virtual bool exitThreadMain() {
+    // Phase can't be interrupted, let it finish
+    return true;
+  }
+
+ private:
+  StartupSequence* sequence_;
+  PhaseId id_;
+};
+
+StartupSequence::StartupSequence()
+  : running_phases_(0),
+    failed_(false) {
+}
+
+StartupSequence::~StartupSequence() {
+  for (std::vector<Phase>::iterator it = phases_.begin();
+       phases_.end() != it; ++it) {
+    delete it->thread;
+    delete it->procedure;
+  }
+}
+
+StartupSequence::PhaseId StartupSequence::AddPhase(const std::string& name,
+                                                   Procedure* procedure) {
+  Phase phase;
+  phase.name = name;
+  phase.procedure = procedure;
+  phase.state = kWaiting;
+  phase.thread = NULL;
+  phases_.push_back(phase);
+  return phases_.size() - 1;
+}
+
+void StartupSequence::AddDependency(PhaseId phase, PhaseId depends_on) {
+  DCHECK(phase < phases_.size() && depends_on < phases_.size());
+  phases_[phase].dependencies.push_back(depends_on);
+}
+
+bool StartupSequence::Run() {
+  start_time_ = date_time::DateTime::getCurrentTime();
+  {
+    sync_primitives::AutoLock lock(lock_);
+    while (true) {
+      if (!failed_) {
+        StartReadyPhases();
+      }
+      if (0 == running_phases_) {
+        break;
+      }
+      phase_finished_.Wait(lock);
+    }
+  }
+
+  for (std::vector<Phase>::iterator it = phases_.begin();
+       phases_.end() != it; ++it) {
+    if (it->thread) {
+      it->thread->join();
+    }
+    if (!failed_ && kWaiting == it->state) {
+      LOG4CXX_ERROR(logger_, "Startup phase " << it->name
+                    << " has unresolvable dependencies");
+      failed_ = true;
+    }
+  }
+  LogTimeline();
+  return !failed_;
+}
+
+bool StartupSequence::IsReady(const Phase& phase) const {
+  for (std::vector<PhaseId>::const_iterator it = phase.dependencies.begin();
+       phase.dependencies.end() != it; ++it) {
+    if (kSucceeded != phases_[*it].state) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void StartupSequence::StartReadyPhases() {
+  for (PhaseId id = 0; id < phases_.size(); ++id) {
+    Phase& phase = phases_[id];
+    if (kWaiting != phase.state || !IsReady(phase)) {
+      continue;
+    }
+    phase.state = kRunning;
+    phase.thread = new threads::Thread(("Startup " + phase.name).c_str(),
+                                       new PhaseDelegate(this, id));
+    if (!phase.thread->start()) {
+      LOG4CXX_ERROR(logger_, "Failed to start thread for startup phase "
+                    << phase.name);
+      delete phase.thread;
+      phase.thread = NULL;
+      phase.start_time = phase.end_time = date_time::DateTime::getCurrentTime();
+      phase.state = kFailed;
+      failed_ = true;
+      break;
+    }
+    ++running_phases_;
+  }
+}
+
+void StartupSequence::RunPhase(PhaseId id) {
+  Phase& phase = phases_[id];
+  phase.start_time = date_time::DateTime::getCurrentTime();
+  const bool succeeded = phase.procedure->Run();
+  phase.end_time = date_time::DateTime::getCurrentTime();
+
+  sync_primitives::AutoLock lock(lock_);
+  if (succeeded) {
+    phase.state = kSucceeded;
+  } else {
+    LOG4CXX_ERROR(logger_, "Startup phase " << phase.name << " failed");
+    phase.state = kFailed;
+    failed_ = true;
+  }
+  --running_phases_;
+  phase_finished_.NotifyOne();
+}
+
+void StartupSequence::LogTimeline() const {
+  std::vector<TimevalStruct> start_times;
+  std::vector<size_t> started;
+  for (PhaseId id = 0; id < phases_.size(); ++id) {
+    start_times.push_back(phases_[id].start_time);
+    if (kSucceeded == phases_[id].state || kFailed == phases_[id].state) {
+      started.push_back(id);
+    }
+  }
+  std::sort(started.begin(), started.end(), StartTimeLess(start_times));
+
+  for (std::vector<size_t>::const_iterator it = started.begin();
+       started.end() != it; ++it) {
+    const Phase& phase = phases_[*it];
+    LOG4CXX_INFO(logger_, "Boot timeline: " << phase.name
+                 << " start " << date_time::DateTime::calculateTimeDiff(
+                     phase.start_time, start_time_)
+                 << " ms, end " << date_time::DateTime::calculateTimeDiff(
+                     phase.end_time, start_time_)
+                 << " ms" << (kFailed == phase.state ? ", failed" : ""));
+  }
+  LOG4CXX_INFO(logger_, "Boot timeline: total "
+               << date_time::DateTime::calculateTimeSpan(start_time_)
+               << " ms");
+}
+
+}  // namespace main_namespace
@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_APPMAIN_STARTUP_SEQUENCE_H_
+#define SRC_APPMAIN_STARTUP_SEQUENCE_H_
+
+#include <string>
+#include <vector>
+
+#include "utils/conditional_variable.h"
+#include "utils/date_time.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace threads {
+class Thread;
+}
+
+namespace main_namespace {
+
+/*
+ * @brief StartupSequence runs startup phases in dependency order.
+ * Phase is started on its own thread as soon as all phases it depends
+ * on are finished, so independent phases run in parallel. If some phase
+ * fails, no more phases are started. Start and end of every phase are
+ * recorded and logged as boot timeline.
+ */
+class StartupSequence {
+ public:
+  typedef size_t PhaseId;
+
+  class Procedure {
+   public:
+    virtual ~Procedure() {
+    }
+    // Returns false if startup has to be aborted
+    virtual bool Run() = 0;
+  };
+
+  /*
+   * @brief Procedure calling method of object
+   */
+  template<typename T>
+  class MethodProcedure : public Procedure {
+   public:
+    typedef bool (T::*Method)();
+    MethodProcedure(T* object, Method method)
+      : object_(object),
+        method_(method) {
+    }
+    virtual bool Run() {
+      return (object_->*method_)();
+    }
+   private:
+    T* object_;
+    Method method_;
+  };
+
+  StartupSequence();
+  ~StartupSequence();
+
+  /*
+   * @brief Adds phase to sequence
+   *
+   * @param name Phase name used for thread name and timeline
+   * @param procedure Phase body, sequence takes ownership
+   * @return id to refer the phase in AddDependency
+   */
+  PhaseId AddPhase(const std::string& name, Procedure* procedure);
+
+  template<typename T>
+  PhaseId AddPhase(const std::string& name, T* object, bool (T::*method)()) {
+    return AddPhase(name, new MethodProcedure<T>(object, method));
+  }
+
+  /*
+   * @brief Makes phase wait until other phase is finished
+   */
+  void AddDependency(PhaseId phase, PhaseId depends_on);
+
+  /*
+   * @brief Runs all phases and waits for them to finish
+   *
+   * @return true if every phase succeeded
+   */
+  bool Run();
+
+ private:
+  class PhaseDelegate;
+
+  enum PhaseState {
+    kWaiting,
+    kRunning,
+    kSucceeded,
+    kFailed
+  };
+
+  struct Phase {
+    std::string name;
+    Procedure* procedure;
+    std::vector<PhaseId> dependencies;
+    PhaseState state;
+    threads::Thread* thread;
+    TimevalStruct start_time;
+    TimevalStruct end_time;
+  };
+
+  /*
+   * @brief Checks if all dependencies of phase have succeeded
+   */
+  bool IsReady(const Phase& phase) const;
+
+  /*
+   * @brief Starts all ready phases, lock_ has to be taken
+   */
+  void StartReadyPhases();
+
+  /*
+   * @brief Runs phase body, called on phase thread
+   */
+  void RunPhase(PhaseId id);
+
+  void LogTimeline() const;
+
+  std::vector<Phase> phases_;
+  size_t running_phases_;
+  bool failed_;
+  TimevalStruct start_time_;
+  sync_primitives::Lock lock_;
+  sync_primitives::ConditionalVariable phase_finished_;
+
+  DISALLOW_COPY_AND_ASSIGN(StartupSequence);
+};
+
+}  // namespace main_namespace
+
+#endif  // SRC_APPMAIN_STARTUP_SEQUENCE_H_
@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_APP_STORAGE_LEDGER_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_APP_STORAGE_LEDGER_H_
+
+#include <stdint.h>
+#include <map>
+#include <string>
+
+#include "utils/date_time.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace application_manager {
+
+/*
+ * @brief AppStorageLedger keeps track of disk space used by applications
+ * in their storage folders. Folder is scanned once, when its usage is
+ * requested first time, afterwards usage is updated incrementally by
+ * PutFile, DeleteFile and application files cleanup, so quota checks
+ * do not walk the file system. Growth of files by writes which are
+ * queued but not done yet is counted separately.
+ */
+class AppStorageLedger {
+ public:
+  /*
+   * @brief Usage in bytes of application folders known to the ledger
+   */
+  typedef std::map<std::string, uint64_t> UsageMap;
+
+  AppStorageLedger();
+  ~AppStorageLedger();
+
+  /*
+   * @brief Returns amount of bytes used by application folder.
+   * Folder is scanned if it is not known yet or if reconciliation
+   * period (AppStorageReconcilePeriod) has expired.
+   *
+   * @param folder_name Name of application folder in storage folder
+   */
+  uint64_t Usage(const std::string& folder_name);
+
+  /*
+   * @brief Updates usage of application folder after file was changed
+   *
+   * @param folder_name Name of application folder in storage folder
+   * @param old_size Size of the file before change, 0 for new file
+   * @param new_size Size of the file after change, 0 for removed file
+   */
+  void OnFileChanged(const std::string& folder_name,
+                     uint64_t old_size,
+                     uint64_t new_size);
+
+  /*
+   * @brief Counts growth of the file by a write which is queued, so it is
+   * seen by quota checks before data reaches the disk
+   *
+   * @param folder_name Name of application folder in storage folder
+   * @param old_size Size of the file before write, 0 for new file
+   * @param new_size Size of the file after write
+   */
+  void OnWriteQueued(const std::string& folder_name,
+                     uint64_t old_size,
+                     uint64_t new_size);
+
+  /*
+   * @brief Drops write counted by OnWriteQueued, and updates usage of
+   * application folder if write succeeded
+   *
+   * @param success true if all data is written
+   */
+  void OnWriteDone(const std::string& folder_name,
+                   uint64_t old_size,
+                   uint64_t new_size,
+                   bool success);
+
+  /*
+   * @brief Returns growth of application folder by writes which are queued
+   * but not done yet
+   *
+   * @param folder_name Name of application folder in storage folder
+   */
+  uint64_t QueuedUsage(const std::string& folder_name) const;
+
+  /*
+   * @brief Recalculates usage of application folder from disk
+   *
+   * @param folder_name Name of application folder in storage folder
+   */
+  void Reconcile(const std::string& folder_name);
+
+  /*
+   * @brief Returns usage of all known application folders, for diagnostics
+   */
+  UsageMap Snapshot() const;
+
+ private:
+  struct Entry {
+    uint64_t usage;
+    TimevalStruct scan_time;
+  };
+  typedef std::map<std::string, Entry> Entries;
+
+  /*
+   * @brief Walks application folder on disk and stores its size
+   */
+  uint64_t Scan(const std::string& folder_name);
+
+  Entries entries_;
+  // Growth of folders by queued writes, not included in entries_
+  std::map<std::string, uint64_t> queued_;
+  mutable sync_primitives::Lock entries_lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(AppStorageLedger);
+};
+
+}  // namespace application_manager
+
+#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_APP_STORAGE_LEDGER_H_
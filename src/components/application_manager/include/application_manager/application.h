@@ -39,6 +39,9 @@
 #include "interfaces/MOBILE_API.h"
 #include "connection_handler/device.h"
 #include "application_manager/message.h"
+#include "application_manager/vehicle_info_data.h"
+#include "application_manager/sorted_id_map.h"
+#include "application_manager/enum_bitset.h"
 #include <set>
 
 namespace NsSmartDeviceLink {
@@ -119,22 +122,45 @@ class InitialApplicationData {
 /*
  * @brief Typedef for supported commands in application menu
  */
-typedef std::map<uint32_t, smart_objects::SmartObject*> CommandsMap;
+typedef SortedIdMap<smart_objects::SmartObject*> CommandsMap;
 
 /*
  * @brief Typedef for supported sub menu in application menu
  */
-typedef std::map<uint32_t, smart_objects::SmartObject*> SubMenuMap;
+typedef SortedIdMap<smart_objects::SmartObject*> SubMenuMap;
 
 /*
  * @brief Typedef for interaction choice set
  */
-typedef std::map<uint32_t, smart_objects::SmartObject*> ChoiceSetMap;
+typedef SortedIdMap<smart_objects::SmartObject*> ChoiceSetMap;
 
 /*
  * @brief Typedef for perform interaction choice set
  */
-typedef std::map<uint32_t, smart_objects::SmartObject*> PerformChoiceSetMap;
+typedef SortedIdMap<smart_objects::SmartObject*> PerformChoiceSetMap;
+
+/*
+ * @brief Typedef for buttons application is subscribed to
+ */
+typedef EnumBitset<mobile_apis::ButtonName::eType,
+                   mobile_apis::ButtonName::SEARCH + 1> ButtonSubscriptions;
+
+/*
+ * @brief Typedef for vehicle data types application is subscribed to
+ */
+typedef EnumBitset<uint32_t, STEERINGWHEEL + 1> VehicleInfoSubscriptions;
+
+/*
+ * @brief Parts of application data saved for resumption,
+ * each of them has own version changed on modification
+ */
+enum ResumptionDataPart {
+  kCommandsData = 0,
+  kSubMenusData,
+  kChoiceSetsData,
+  kFilesData,
+  kResumptionDataPartsCount
+};
 
 class DynamicApplicationData {
   public:
@@ -147,8 +173,8 @@ class DynamicApplicationData {
     virtual const mobile_api::TBTState::eType& tbt_state() const = 0;
     virtual const smart_objects::SmartObject* show_command() const = 0;
     virtual const smart_objects::SmartObject* tbt_show_command() const = 0;
-    virtual const std::set<mobile_apis::ButtonName::eType>& SubscribedButtons() const = 0;
-    virtual const std::set<uint32_t>& SubscribesIVI() const = 0;
+    virtual const ButtonSubscriptions& SubscribedButtons() const = 0;
+    virtual const VehicleInfoSubscriptions& SubscribesIVI() const = 0;
     virtual const smart_objects::SmartObject* keyboard_props() const = 0;
     virtual const smart_objects::SmartObject* menu_title() const = 0;
     virtual const smart_objects::SmartObject* menu_icon() const = 0;
@@ -212,6 +238,25 @@ class DynamicApplicationData {
      */
     virtual bool IsSubMenuNameAlreadyExist(const std::string& name) = 0;
 
+    /*
+     * @brief Returns true if command with such menu name already exist
+     */
+    virtual bool IsCommandMenuNameAlreadyExist(
+      const std::string& name) const = 0;
+
+    /*
+     * @brief Returns true if command with such VR synonym already exist,
+     * synonyms are compared ignoring case
+     */
+    virtual bool IsCommandVRSynonymAlreadyExist(
+      const std::string& vr_synonym) const = 0;
+
+    /*
+     * @brief Returns true if choice with such ID already exist
+     * in any of application choice sets
+     */
+    virtual bool IsChoiceIdAlreadyExist(int32_t choice_id) const = 0;
+
     /*
      * @brief Adds a interaction choice set to the application
      *
@@ -286,6 +331,12 @@ class DynamicApplicationData {
      */
     virtual const ChoiceSetMap& choice_set_map() const = 0;
 
+    /*
+     * @brief Retrieve version of application data part, it is changed
+     * each time the part is modified
+     */
+    virtual uint32_t data_version(ResumptionDataPart part) const = 0;
+
     /*
      * @brief Sets perform interaction state
      *
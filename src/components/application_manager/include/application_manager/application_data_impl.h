@@ -33,9 +33,11 @@
 #ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_APPLICATION_DATA_IMPL_H_
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_APPLICATION_DATA_IMPL_H_
 
+#include <map>
 #include <string>
 #include "smart_objects/smart_object.h"
 #include "application_manager/application.h"
+#include "application_manager/name_index.h"
 #include "interfaces/MOBILE_API.h"
 
 namespace application_manager {
@@ -137,6 +139,21 @@ class DynamicApplicationDataImpl : public virtual Application {
      */
     bool IsSubMenuNameAlreadyExist(const std::string& name);
 
+    /*
+     * @brief Returns true if command with such menu name already exist
+     */
+    bool IsCommandMenuNameAlreadyExist(const std::string& name) const;
+
+    /*
+     * @brief Returns true if command with such VR synonym already exist
+     */
+    bool IsCommandVRSynonymAlreadyExist(const std::string& vr_synonym) const;
+
+    /*
+     * @brief Returns true if choice with such ID already exist
+     */
+    bool IsChoiceIdAlreadyExist(int32_t choice_id) const;
+
     /*
      * @brief Adds a interaction choice set to the application
      *
@@ -208,6 +225,11 @@ class DynamicApplicationDataImpl : public virtual Application {
      */
     inline const ChoiceSetMap& choice_set_map() const;
 
+    /*
+     * @brief Retrieve version of application data part
+     */
+    inline uint32_t data_version(ResumptionDataPart part) const;
+
     /*
      * @brief Sets perform interaction state
      *
@@ -286,7 +308,29 @@ class DynamicApplicationDataImpl : public virtual Application {
     uint32_t is_perform_interaction_active_;
     uint32_t perform_interaction_ui_corrid_;
     bool is_reset_global_properties_active_;
+
+    /*
+     * @brief Change version of application data part on its modification
+     */
+    void ChangeDataVersion(ResumptionDataPart part);
   private:
+    /*
+     * @brief Indexes below mirror commands_, sub_menu_ and choice_set_map_
+     * so that duplicate checks of incoming requests don't walk
+     * all stored items. They are updated on every add and remove.
+     */
+    void IndexCommand(const smart_objects::SmartObject& command);
+    void UnindexCommand(const smart_objects::SmartObject& command);
+    void IndexChoiceSet(const smart_objects::SmartObject& choice_set);
+    void UnindexChoiceSet(const smart_objects::SmartObject& choice_set);
+
+    NameIndex command_menu_names_;
+    NameIndex command_vr_synonyms_;
+    NameIndex sub_menu_names_;
+    // Choice ID to number of choices with such ID
+    std::map<int32_t, uint32_t> choice_ids_;
+    uint32_t data_versions_[kResumptionDataPartsCount];
+
     DISALLOW_COPY_AND_ASSIGN(DynamicApplicationDataImpl);
 };
 
@@ -302,6 +346,11 @@ const ChoiceSetMap& DynamicApplicationDataImpl::choice_set_map() const {
   return choice_set_map_;
 }
 
+uint32_t DynamicApplicationDataImpl::data_version(
+    ResumptionDataPart part) const {
+  return data_versions_[part];
+}
+
 uint32_t DynamicApplicationDataImpl::is_perform_interaction_active() const {
   return is_perform_interaction_active_;
 }
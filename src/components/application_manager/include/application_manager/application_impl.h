@@ -130,8 +130,8 @@ class ApplicationImpl : public virtual InitialApplicationDataImpl,
   bool IsSubscribedToIVI(uint32_t vehicle_info_type_);
   bool UnsubscribeFromIVI(uint32_t vehicle_info_type_);
 
-  virtual const std::set<mobile_apis::ButtonName::eType>& SubscribedButtons() const;
-  virtual const  std::set<uint32_t>& SubscribesIVI() const;
+  virtual const ButtonSubscriptions& SubscribedButtons() const;
+  virtual const VehicleInfoSubscriptions& SubscribesIVI() const;
 
   virtual uint32_t nextHash();
   virtual uint32_t curHash() const;
@@ -177,8 +177,8 @@ class ApplicationImpl : public virtual InitialApplicationDataImpl,
 
   ProtocolVersion                          protocol_version_;
   AppFilesMap                              app_files_;
-  std::set<mobile_apis::ButtonName::eType> subscribed_buttons_;
-  std::set<uint32_t>                       subscribed_vehicle_info_;
+  ButtonSubscriptions                      subscribed_buttons_;
+  VehicleInfoSubscriptions                 subscribed_vehicle_info_;
   UsageStatistics                          usage_report_;
 
   DISALLOW_COPY_AND_ASSIGN(ApplicationImpl);
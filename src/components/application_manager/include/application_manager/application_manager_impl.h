@@ -44,8 +44,10 @@
 #include <set>
 #include "application_manager/hmi_command_factory.h"
 #include "application_manager/application_manager.h"
+#include "application_manager/app_storage_ledger.h"
 #include "application_manager/hmi_capabilities.h"
 #include "application_manager/message.h"
+#include "application_manager/registration_validator.h"
 #include "application_manager/request_controller.h"
 #include "application_manager/resume_ctrl.h"
 #include "application_manager/vehicle_info_data.h"
@@ -65,9 +67,6 @@
 
 #include "interfaces/v4_protocol_v1_2_no_extra.h"
 #include "interfaces/v4_protocol_v1_2_no_extra_schema.h"
-#ifdef TIME_TESTER
-#include "time_metric_observer.h"
-#endif  // TIME_TESTER
 #include "protocol_handler/service_type.h"
 
 #include "utils/macro.h"
@@ -78,6 +77,7 @@
 #include "utils/threads/message_loop_thread.h"
 #include "utils/lock.h"
 #include "utils/singleton.h"
+#include "application_manager/strand_executor.h"
 
 namespace policy {
 class PolicyManager;
@@ -169,10 +169,12 @@ struct MessageToHmi: public utils::SharedPtr<Message> {
 };
 
 // Short type names for prioritized message queues
-typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageFromMobile> > FromMobileQueue;
 typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageToMobile> > ToMobileQueue;
-typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageFromHmi> > FromHmiQueue;
 typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageToHmi> > ToHmiQueue;
+
+// Incoming messages of HMI are run on this strand, mobile messages are run
+// on strand of their application connection key
+const StrandExecutor::StrandId kHmiStrand = 0xFFFFFFFF;
 }
 
 #ifdef MODIFY_FUNCTION_SIGN
@@ -196,8 +198,7 @@ class ApplicationManagerImpl : public ApplicationManager,
   public hmi_message_handler::HMIMessageObserver,
   public protocol_handler::ProtocolObserver,
   public connection_handler::ConnectionHandlerObserver,
-    public impl::FromMobileQueue::Handler, public impl::ToMobileQueue::Handler,
-    public impl::FromHmiQueue::Handler, public impl::ToHmiQueue::Handler,
+    public impl::ToMobileQueue::Handler, public impl::ToHmiQueue::Handler,
   public utils::Singleton<ApplicationManagerImpl> {
     friend class ResumeCtrl;
     friend class CommandImpl;
@@ -216,7 +217,12 @@ class ApplicationManagerImpl : public ApplicationManager,
     ApplicationSharedPtr application(int32_t app_id) const;
     ApplicationSharedPtr application_by_policy_id(
         const std::string& policy_app_id) const;
-    inline const std::set<ApplicationSharedPtr>& applications() const;
+    /**
+     * @brief Returns copy of registered applications list taken under
+     * list lock, so it can be iterated while applications register or
+     * unregister on other threads
+     */
+    std::set<ApplicationSharedPtr> applications() const;
     ApplicationSharedPtr active_application() const;
 #ifdef MODIFY_FUNCTION_SIGN
 		ApplicationSharedPtr audible_application() const;
@@ -239,17 +245,18 @@ class ApplicationManagerImpl : public ApplicationManager,
 
     HMICapabilities& hmi_capabilities();
 
-#ifdef TIME_TESTER
     /**
-     * @brief Setup observer for time metric.
+     * @brief Creates application and adds it to applications list.
+     * If validator is given, it is called with applications list locked
+     * right before insertion, so check and insertion are one atomic step.
+     * Negative response is sent to mobile if application is not registered.
      *
-     * @param observer - pointer to observer
+     * @param request_for_registration RegisterAppInterface request
+     * @param validator Checks request against registered applications
      */
-    void SetTimeMetricObserver(AMMetricObserver* observer);
-#endif  // TIME_TESTER
-
     ApplicationSharedPtr RegisterApplication(
-      const utils::SharedPtr<smart_objects::SmartObject>& request_for_registration);
+      const utils::SharedPtr<smart_objects::SmartObject>& request_for_registration,
+      RegistrationValidator* validator = NULL);
     /*
      * @brief Closes application by id
      *
@@ -328,6 +335,13 @@ class ApplicationManagerImpl : public ApplicationManager,
      */
     bool end_audio_pass_thru();
 
+    /*
+     * @brief Checks whether audio passthru process is started
+     *
+     * @return true if passthru is active
+     */
+    bool audio_pass_thru_active();
+
     /*
      * @brief Retrieves driver distraction state
      *
@@ -401,7 +415,7 @@ class ApplicationManagerImpl : public ApplicationManager,
     void StopAudioPassThru(int32_t application_key);
 
     void SendAudioPassThroughNotification(uint32_t session_key,
-                                          std::vector<uint8_t> binaryData);
+                                          const BinaryData& binary_data);
 
     std::string GetDeviceName(connection_handler::DeviceHandle handle);
 
@@ -600,18 +614,90 @@ class ApplicationManagerImpl : public ApplicationManager,
         const std::string& file_name,
         const uint32_t offset);
 
+    /*
+     * @brief Save binary data received from mobile to specified directory.
+     * Data is shared with incoming message and written to the file
+     * without intermediate copies.
+     *
+     * @param binary data
+     * @param path for saving data
+     * @param file_name File name
+     * @param offset for saving data to existing file with offset.
+     *        If offset is 0 - create new file ( overrite existing )
+     *
+     * @return SUCCESS if file was saved, other code otherwise
+     */
+    mobile_apis::Result::eType SaveBinary(
+        const BinaryData& binary_data,
+        const std::string& file_path,
+        const std::string& file_name,
+        const uint32_t offset);
+
+    /*
+     * @brief Returns size file will have once writes queued for it so far
+     * are done
+     */
+    uint32_t QueuedFileSize(const std::string& full_file_path);
+
+    /*
+     * @brief Queues binary data received from mobile to be written to
+     * specified directory without blocking the caller. Once data is written
+     * the file is recorded in the storage ledger and in the application,
+     * then CommandRequestImpl::on_file_written of the request is called on
+     * strand of application, unless request is already finished.
+     *
+     * @param binary data
+     * @param path for saving data
+     * @param file_name File name
+     * @param offset for saving data to existing file with offset.
+     *        If offset is 0 - create new file ( overrite existing )
+     * @param connection_key Connection key of application sent the request
+     * @param correlation_id Correlation ID of the request
+     * @param app_file File added to the application when its first part is
+     *        written, NULL if file is not an application file
+     * @param storage_folder Application folder the file is counted in by
+     *        the storage ledger, empty if file is out of application storage
+     *
+     * @return SUCCESS if write was queued, other code otherwise
+     */
+    mobile_apis::Result::eType SaveBinaryAsync(
+        const BinaryData& binary_data,
+        const std::string& file_path,
+        const std::string& file_name,
+        const uint32_t offset,
+        const uint32_t connection_key,
+        const uint32_t correlation_id,
+        const AppFile* app_file = NULL,
+        const std::string& storage_folder = std::string());
+
     /**
-     * @brief Get available app space
-     * @param name of app
+     * @brief Get available app space, queued writes are taken into account
+     * @param folder_name name of app storage folder
      * @return free app space.
      */
-    uint32_t GetAvailableSpaceForApp(const std::string& name);
+    uint32_t GetAvailableSpaceForApp(const std::string& folder_name);
+
+    /**
+      * Getter for storage_ledger
+      * @return Ledger of disk space used by applications
+      */
+    AppStorageLedger& storage_ledger() {
+      return storage_ledger_;
+    }
 
     /*
      * @brief returns true if HMI is cooperating
      */
     bool IsHMICooperating() const;
 
+    /*
+     * @brief Queues task to strand of HMI messages, so it runs in order with
+     * them off the caller thread. Thread-safe.
+     *
+     * @param task Task to run, manager takes ownership
+     */
+    void PostHmiTask(StrandExecutor::Task* task);
+
     /**
      * Function used only by HMI request/response/notification base classes
      * to change HMI app id to Mobile app id and vice versa.
@@ -625,6 +711,65 @@ class ApplicationManagerImpl : public ApplicationManager,
     hmi_apis::HMI_API& hmi_so_factory();
     mobile_apis::MOBILE_API& mobile_so_factory();
 
+    /*
+     * @brief Checks that |data_size| bytes may be written to the file at
+     * |offset| position, writes still queued for the file are respected
+     */
+    mobile_apis::Result::eType CheckBinaryData(
+        uint32_t data_size,
+        const std::string& file_path,
+        const std::string& full_file_path,
+        const uint32_t offset);
+
+    /*
+     * @brief Writes |data_size| bytes to the file at |offset| position,
+     * common part of SaveBinary
+     */
+    mobile_apis::Result::eType SaveBinaryData(
+        const uint8_t* data,
+        uint32_t data_size,
+        const std::string& file_path,
+        const std::string& file_name,
+        const uint32_t offset);
+
+    /*
+     * @brief How file queued by SaveBinaryAsync is recorded once written
+     */
+    struct FileWrite {
+      FileWrite()
+        : connection_key(0),
+          correlation_id(0),
+          add_file(false),
+          old_size(0),
+          new_size(0) {
+      }
+      uint32_t connection_key;
+      uint32_t correlation_id;
+      // File is added to application, first part of application file
+      // is written
+      bool add_file;
+      AppFile file;
+      // Folder the size change is counted in, empty if none
+      std::string storage_folder;
+      uint32_t old_size;
+      uint32_t new_size;
+    };
+
+    /*
+     * @brief Completion of SaveBinaryAsync, posts FileWrittenTask
+     */
+    class FileWriteCompletion;
+
+    /*
+     * @brief Task of incoming_messages_ executor which records written
+     * file and passes result of asynchronous write to the request
+     */
+    class FileWrittenTask;
+
+    // CALLED ON incoming_messages_ worker, on strand of application!
+    void OnFileWritten(const FileWrite& write, const std::string& file_name,
+                       bool success);
+
     void CreateHMIMatrix(HMIMatrix* matrix);
     void CreatePoliciesManager();
 
@@ -659,19 +804,21 @@ class ApplicationManagerImpl : public ApplicationManager,
     void ProcessMessageFromMobile(const utils::SharedPtr<Message>& message);
     void ProcessMessageFromHMI(const utils::SharedPtr<Message>& message);
 
-    // threads::MessageLoopThread<*>::Handler implementations
     /*
-     * @brief Handles for threads pumping different types
-     * of messages. Beware, each is called on different thread!
+     * @brief Task of incoming_messages_ executor which passes message
+     * to Handle()
      */
-    // CALLED ON messages_from_mobile_ thread!
-    virtual void Handle(const impl::MessageFromMobile& message) OVERRIDE;
+    template <class M>
+    class IncomingMessageTask;
+
+    // CALLED ON incoming_messages_ worker, on strand of application!
+    void Handle(const impl::MessageFromMobile& message);
 
     // CALLED ON messages_to_mobile_ thread!
     virtual void Handle(const impl::MessageToMobile& message) OVERRIDE;
 
-    // CALLED ON messages_from_hmi_ thread!
-    virtual void Handle(const impl::MessageFromHmi& message) OVERRIDE;
+    // CALLED ON incoming_messages_ worker, on HMI strand!
+    void Handle(const impl::MessageFromHmi& message);
 
     // CALLED ON messages_to_hmi_ thread!
     virtual void Handle(const impl::MessageToHmi& message) OVERRIDE;    
@@ -686,6 +833,11 @@ class ApplicationManagerImpl : public ApplicationManager,
      */
     ResumeCtrl resume_ctrl_;
 
+    /**
+     * @brief Keeps disk space used by applications storage folders
+     */
+    AppStorageLedger storage_ledger_;
+
 
 
     /**
@@ -700,11 +852,13 @@ class ApplicationManagerImpl : public ApplicationManager,
      * @brief Set of HMI notifications with timeout.
      */
     std::list<CommandSharedPtr> notification_list_;
+    sync_primitives::Lock notification_list_lock_;
 
     /**
      * @brief Map of correlation id  and associated application id.
      */
     std::map<const int32_t, const uint32_t> appID_list_;
+    sync_primitives::Lock appID_list_lock_;
 
     bool audio_pass_thru_active_;
     sync_primitives::Lock audio_pass_thru_lock_;
@@ -723,26 +877,27 @@ class ApplicationManagerImpl : public ApplicationManager,
 
     hmi_apis::HMI_API*                      hmi_so_factory_;
     mobile_apis::MOBILE_API*                mobile_so_factory_;
+    // Guards lazy creation of factories, commands run on several threads
+    sync_primitives::Lock                   so_factories_lock_;
 
-#ifdef TIME_TESTER
-    AMMetricObserver* metric_observer_;
-#endif  // TIME_TESTER
     static uint32_t corelation_id_;
     static const uint32_t max_corelation_id_;
+    sync_primitives::Lock corelation_id_lock_;
 
     // The reason of HU shutdown
     mobile_api::AppInterfaceUnregisteredReason::eType unregister_reason_;
 
     // Construct message threads when everything is already created
 
-    // Thread that pumps messages coming from mobile side.
-    impl::FromMobileQueue messages_from_mobile_;
     // Thread that pumps messages being passed to mobile side.
     impl::ToMobileQueue messages_to_mobile_;
-    // Thread that pumps messages coming from HMI.
-    impl::FromHmiQueue messages_from_hmi_;
     // Thread that pumps messages being passed to HMI.
     impl::ToHmiQueue messages_to_hmi_;
+    // Workers which run messages coming from mobile side and HMI. Messages
+    // of one application are run in order, different applications and HMI
+    // are served in parallel. Declared last to be stopped first, running
+    // commands send messages to mobile and HMI.
+    StrandExecutor incoming_messages_;
 
 #ifdef MODIFY_FUNCTION_SIGN
 		std::vector<unsigned char> audio_pass_thru_data_;
@@ -751,6 +906,7 @@ class ApplicationManagerImpl : public ApplicationManager,
 		bool is_save_;		// is save audio_pass_thru_data to file
 		std::string save_path_;		// save file path
 		std::string read_path_;		// read file path
+		int32_t audio_pass_thru_app_key_;	// app receiving recorded audio
 		threads::Thread* audio_pass_thru_read_file_thread_;
 #endif
     DISALLOW_COPY_AND_ASSIGN(ApplicationManagerImpl);
@@ -795,10 +951,6 @@ class ApplicationManagerImpl : public ApplicationManager,
 #endif
 };
 
-const std::set<ApplicationSharedPtr>& ApplicationManagerImpl::applications() const {
-  return application_list_;
-}
-
 bool ApplicationManagerImpl::vr_session_started() const {
   return is_vr_session_strated_;
 }
@@ -81,6 +81,17 @@ class CommandRequestImpl : public CommandImpl,
    */
   virtual void on_event(const event_engine::Event& event);
 
+  /**
+   * @brief Called on strand of application when file queued by
+   * ApplicationManagerImpl::SaveBinaryAsync for this request is written
+   * and recorded
+   *
+   * @param file_name Path to written file
+   * @param result SUCCESS if all data is written and file is recorded
+   */
+  virtual void on_file_written(const std::string& file_name,
+                               mobile_apis::Result::eType result);
+
   /**
    * @brief Retrieves request default timeout.
    * If request has a custom timeout, request_timeout_ should be reassign to it
@@ -64,12 +64,23 @@ class PutFileRequest : public CommandRequestImpl {
    **/
   virtual void Run();
 
+  /**
+   * @brief Completes request once received data is written to the file
+   *
+   * @param file_name Path to written file
+   * @param result SUCCESS if all data is written and file is recorded
+   */
+  virtual void on_file_written(const std::string& file_name,
+                               mobile_apis::Result::eType result);
+
  private:
     uint32_t                     offset_;
     std::string                  sync_file_name_;
     uint32_t                     length_;
     mobile_apis::FileType::eType file_type_;
     bool                         is_persistent_file_;
+    bool                         is_system_file_;
+    smart_objects::SmartObject   response_params_;
 
     void SendOnPutFileNotification();
   DISALLOW_COPY_AND_ASSIGN(PutFileRequest);
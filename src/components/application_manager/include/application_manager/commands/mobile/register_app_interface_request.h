@@ -36,6 +36,7 @@
 
 #include <string.h>
 #include "application_manager/commands/command_request_impl.h"
+#include "application_manager/registration_validator.h"
 #include "utils/macro.h"
 
 namespace policy {
@@ -51,7 +52,8 @@ namespace commands {
 /**
  * @brief Register app interface request  command class
  **/
-class RegisterAppInterfaceRequest : public CommandRequestImpl {
+class RegisterAppInterfaceRequest : public CommandRequestImpl,
+  public RegistrationValidator {
  public:
   /**
    * \brief RegisterAppInterfaceRequest class constructor
@@ -90,13 +92,21 @@ class RegisterAppInterfaceRequest : public CommandRequestImpl {
   void SendRegisterAppInterfaceResponseToMobile(
       mobile_apis::Result::eType result = mobile_apis::Result::SUCCESS);
 
+  /**
+   * @brief Repeats checks against registered applications right before
+   * application is added to the list
+   */
+  virtual mobile_apis::Result::eType Validate(
+      const std::set<ApplicationSharedPtr>& applications) const;
+
  private:
   /*
    * @brief Check new ID along with known mobile application ID
    *
    * return TRUE if ID is known already, otherwise - FALSE
    */
-  bool IsApplicationWithSameAppIdRegistered();
+  bool IsApplicationWithSameAppIdRegistered(
+      const std::set<ApplicationSharedPtr>& applications) const;
 
   /*
    * @brief Check for some request param. names restrictions, e.g. for
@@ -122,7 +132,8 @@ class RegisterAppInterfaceRequest : public CommandRequestImpl {
    * return SUCCESS if there is no coincidence of app.name/TTS/VR synonyms,
    * otherwise appropriate error code returns
   */
-  mobile_apis::Result::eType CheckCoincidence();
+  mobile_apis::Result::eType CheckCoincidence(
+      const std::set<ApplicationSharedPtr>& applications) const;
 
   /*
    * @brief Predicate for using with CheckCoincidence method to compare with TTS SO
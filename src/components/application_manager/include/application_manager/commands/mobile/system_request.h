@@ -68,7 +68,28 @@ class SystemRequest : public CommandRequestImpl {
    * @param event The received event
    */
   virtual void on_event(const event_engine::Event& event);
+
+  /**
+   * @brief Sends request to HMI once received data is written to the file
+   *
+   * @param file_name Path to written file
+   * @param success true if all data is written
+   */
+  virtual void on_file_written(const std::string& file_name,
+                               mobile_apis::Result::eType result);
+
  private:
+  /**
+   * @brief Notifies HMI that system file is ready
+   *
+   * @param file_name Name of file in system files folder
+   * @param full_file_path Path to the file
+   */
+  void SendSystemRequestToHMI(const std::string& file_name,
+                              const std::string& full_file_path);
+
+  std::string file_name_;
+
   DISALLOW_COPY_AND_ASSIGN(SystemRequest);
 };
 
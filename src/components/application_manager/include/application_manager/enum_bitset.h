@@ -0,0 +1,184 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_ENUM_BITSET_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_ENUM_BITSET_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace application_manager {
+
+/*
+ * @brief EnumBitset is set of values of small closed enum stored
+ * as fixed-size bitset. Values outside of [0, kSize) are never members.
+ * Iteration yields values in ascending order like std::set does.
+ */
+template <typename T, size_t kSize>
+class EnumBitset {
+ public:
+  class const_iterator {
+   public:
+    const_iterator()
+      : set_(NULL), index_(kSize) {
+    }
+    T operator*() const {
+      return static_cast<T>(index_);
+    }
+    const_iterator& operator++() {
+      index_ = set_->NextIndex(index_ + 1);
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator prev = *this;
+      ++(*this);
+      return prev;
+    }
+    bool operator==(const const_iterator& other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return index_ != other.index_;
+    }
+   private:
+    friend class EnumBitset;
+    const_iterator(const EnumBitset* set, size_t index)
+      : set_(set), index_(index) {
+    }
+    const EnumBitset* set_;
+    size_t index_;
+  };
+  typedef const_iterator iterator;
+
+  EnumBitset() {
+    clear();
+  }
+
+  /*
+   * @brief Adds value, returns false if it is already member
+   * or out of range
+   */
+  bool insert(T value) {
+    if (!InRange(value) || Test(value)) {
+      return false;
+    }
+    words_[Word(value)] |= Mask(value);
+    return true;
+  }
+
+  /*
+   * @brief Removes value, returns false if it was not member
+   */
+  bool erase(T value) {
+    if (!InRange(value) || !Test(value)) {
+      return false;
+    }
+    words_[Word(value)] &= ~Mask(value);
+    return true;
+  }
+
+  bool contains(T value) const {
+    return InRange(value) && Test(value);
+  }
+
+  void clear() {
+    for (size_t i = 0; i < kWords; ++i) {
+      words_[i] = 0;
+    }
+  }
+
+  bool empty() const {
+    for (size_t i = 0; i < kWords; ++i) {
+      if (words_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  size_t size() const {
+    size_t count = 0;
+    for (size_t i = 0; i < kWords; ++i) {
+      for (uint32_t word = words_[i]; word; word &= word - 1) {
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  const_iterator begin() const {
+    return const_iterator(this, NextIndex(0));
+  }
+  const_iterator end() const {
+    return const_iterator(this, kSize);
+  }
+
+ private:
+  enum {
+    kWordBits = 32,
+    kWords = (kSize + kWordBits - 1) / kWordBits
+  };
+
+  static bool InRange(T value) {
+    return static_cast<int64_t>(value) >= 0 &&
+           static_cast<int64_t>(value) < static_cast<int64_t>(kSize);
+  }
+  static size_t Word(T value) {
+    return static_cast<size_t>(value) / kWordBits;
+  }
+  static uint32_t Mask(T value) {
+    return 1u << (static_cast<size_t>(value) % kWordBits);
+  }
+  bool Test(T value) const {
+    return 0 != (words_[Word(value)] & Mask(value));
+  }
+  size_t NextIndex(size_t index) const {
+    for (; index < kSize; ++index) {
+      const uint32_t word = words_[index / kWordBits] >> (index % kWordBits);
+      if (0 == word) {
+        // Skip the rest of empty word
+        index = (index / kWordBits + 1) * kWordBits - 1;
+        continue;
+      }
+      if (word & 1u) {
+        return index;
+      }
+    }
+    return kSize;
+  }
+
+  uint32_t words_[kWords];
+};
+
+}  // namespace application_manager
+
+#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_ENUM_BITSET_H_
@@ -33,8 +33,8 @@
 #ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_EVENT_DISPATCHER_H_
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_EVENT_DISPATCHER_H_
 
-#include <list>
-#include <map>
+#include <stdint.h>
+#include <vector>
 
 #include "utils/lock.h"
 #include "utils/singleton.h"
@@ -48,9 +48,15 @@ class EventObserver;
 
 class EventDispatcher : public utils::Singleton<EventDispatcher> {
  public:
+  // Node of subscription lists, see event_dispatcher.cc
+  struct Subscription;
 
   /*
-   * @brief Delivers the event to all subscribers
+   * @brief Delivers the event to all subscribers. Responses are delivered
+   * to observers of their correlation ID, notifications to observers
+   * subscribed without correlation ID. Observers may subscribe and
+   * unsubscribe from within on_event, observers subscribed after
+   * delivery started don't get the event.
    *
    * @param event Received event
    */
@@ -76,6 +82,17 @@ class EventDispatcher : public utils::Singleton<EventDispatcher> {
   void remove_observer(const Event::EventID& event_id,
                        EventObserver* const observer);
 
+  /*
+   * @brief Unsubscribes the observer from event with specific correlation ID
+   *
+   * @param event_id            The event ID to unsubscribe from
+   * @param hmi_correlation_id  The event HMI correlation ID
+   * @param observer            The observer to be unsubscribed
+   */
+  void remove_observer(const Event::EventID& event_id,
+                       int32_t hmi_correlation_id,
+                       EventObserver* const observer);
+
   /*
    * @brief Unsubscribes the observer from all events
    *
@@ -101,14 +118,47 @@ class EventDispatcher : public utils::Singleton<EventDispatcher> {
 
   FRIEND_BASE_SINGLETON_CLASS(EventDispatcher);
 
-  // Data types section
-  typedef std::list<EventObserver*>                   ObserverList;
-  typedef std::map<int32_t, ObserverList>                 ObserversMap;
-  typedef std::map<Event::EventID, ObserversMap>      EventObserverMap;
+  struct Bucket {
+    Subscription* head;
+    Subscription* tail;
+  };
+  typedef std::vector<Bucket> Buckets;
+
+  Bucket& bucket(const Event::EventID& event_id, int32_t hmi_correlation_id);
+
+  static void AppendToBucket(Bucket* target, Subscription* node);
+
+  /*
+   * @brief Finds first alive subscription for the key starting from node,
+   * skips subscriptions made after serial
+   */
+  static Subscription* FindSubscription(Subscription* node,
+                                        const Event::EventID& event_id,
+                                        int32_t hmi_correlation_id,
+                                        uint32_t serial);
+
+  /*
+   * @brief Detaches subscription from its observer. Node is freed at once
+   * unless some delivery stands on it, then the last one frees it.
+   */
+  void Unsubscribe(Subscription* subscription);
+
+  void Free(Subscription* subscription);
+
+  /*
+   * @brief Grows hash table when it is too loaded, nodes can't be moved
+   * between buckets while some delivery is in progress
+   */
+  void Rehash();
 
   // Members section
   sync_primitives::Lock                               state_lock_;
-  EventObserverMap                                    observers_;
+  // Subscriptions hashed by event ID and correlation ID, each bucket keeps
+  // subscriptions in subscribe order
+  Buckets                                             buckets_;
+  size_t                                              subscriptions_count_;
+  uint32_t                                            last_serial_;
+  uint32_t                                            deliveries_count_;
 };
 
 }
@@ -93,6 +93,15 @@ class EventObserver
    */
   void unsubscribe_from_event(const Event::EventID& event_id);
 
+  /*
+   * @brief Unsubscribes the observer from event with specific correlation ID
+   *
+   * @param event_id            The event ID to unsubscribe from
+   * @param hmi_correlation_id  The event HMI correlation ID
+   */
+  void unsubscribe_from_event(const Event::EventID& event_id,
+                              int32_t hmi_correlation_id);
+
   /*
    * @brief Unsubscribes the observer from all events
    *
@@ -102,6 +111,8 @@ class EventObserver
  private:
 
   ObserverID id_;
+  // Own subscriptions, linked and used by EventDispatcher only
+  EventDispatcher::Subscription* subscriptions_;
 
   DISALLOW_COPY_AND_ASSIGN(EventObserver);
 };
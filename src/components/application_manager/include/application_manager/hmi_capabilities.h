@@ -411,7 +411,41 @@ private:
   void convert_json_languages_to_obj(Json::Value& json_languages,
                                      smart_objects::SmartObject& languages);
 
+  /*
+   * @brief Restores capabilities converted from file on previous start
+   *
+   * @param source content of hmi_capabilities.json, cache is used only
+   * if it was made from the same content
+   *
+   * @return TRUE if capabilities were restored from cache
+   */
+  bool load_capabilities_from_cache(const std::string& source);
+
+  /*
+   * @brief Saves capabilities just converted from file, so file is not
+   * parsed and converted again on next start
+   *
+   * @param source content of hmi_capabilities.json
+   */
+  void save_capabilities_to_cache(const std::string& source) const;
+
  private:
+  struct CachedCapability {
+    const char* name;
+    smart_objects::SmartObject* HMICapabilities::* field;
+  };
+
+  /*
+   * @brief Capabilities kept in cache along with active languages
+   */
+  static const CachedCapability* cached_capabilities(size_t* count);
+
+  /*
+   * @brief Replaces capability with copy of value unless they are equal
+   */
+  void replace_capability(smart_objects::SmartObject** capability,
+                          const smart_objects::SmartObject& value);
+
   bool                             is_vr_cooperating_;
   bool                             is_tts_cooperating_;
   bool                             is_ui_cooperating_;
@@ -37,6 +37,7 @@
 #include <vector>
 
 #include "utils/shared_ptr.h"
+#include "utils/shared_buffer.h"
 #include "protocol_handler/message_priority.h"
 #include "smart_objects/smart_object.h"
 #include "protocol_handler/rpc_type.h"
@@ -45,7 +46,9 @@ namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
 
 namespace application_manager {
 
-typedef std::vector<uint8_t> BinaryData;
+// Binary payload is shared between message copies and smart objects
+// created from it, so it is never duplicated on its way to the commands
+typedef utils::SharedBuffer BinaryData;
 
 // Message type is a general type used by both mobile and HMI messages
 enum MessageType {
@@ -84,7 +87,7 @@ class Message {
   ProtocolVersion protocol_version() const;
 
   const std::string& json_message() const;
-  const BinaryData* binary_data() const;
+  const BinaryData& binary_data() const;
   bool has_binary_data() const;
   const smart_objects::SmartObject& smart_object() const;
 
@@ -93,7 +96,7 @@ class Message {
   void set_correlation_id(int32_t id);
   void set_connection_key(int32_t key);
   void set_message_type(MessageType type);
-  void set_binary_data(BinaryData* data);
+  void set_binary_data(const BinaryData& data);
   void set_json_message(const std::string& json_message);
   void set_protocol_version(ProtocolVersion version);
   void set_smart_object(const smart_objects::SmartObject& object);
@@ -114,8 +117,7 @@ class Message {
   std::string json_message_;
   smart_objects::SmartObject smart_object_;
 
-  // TODO(akandul): replace with shared_ptr
-  BinaryData* binary_data_;
+  BinaryData binary_data_;
 };
 }  // namespace application_manager
 
@@ -1,5 +1,5 @@
-/*
- * Copyright (c) 2014, Ford Motor Company
+/**
+ * Copyright (c) 2013, Ford Motor Company
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -30,27 +30,57 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_APPLICATION_MANAGER_MECTRIC_WRAPPER_H_
-#define SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_APPLICATION_MANAGER_MECTRIC_WRAPPER_H_
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_NAME_INDEX_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_NAME_INDEX_H_
 
+#include <stdint.h>
 #include <string>
+#include <vector>
 
-#include "metric_wrapper.h"
-#include "application_manager_observer.h"
+namespace application_manager {
 
+/*
+ * @brief NameIndex is hash set of names used for duplicate checks of
+ * menu names and VR synonyms. Every name is counted, so it stays in index
+ * until all its owners are removed. Case insensitive index compares names
+ * the way strcasecmp does.
+ */
+class NameIndex {
+ public:
+  enum CaseMode {
+    kCaseSensitive,
+    kCaseInsensitive
+  };
 
-namespace time_tester {
+  explicit NameIndex(CaseMode case_mode);
 
-class ApplicationManagerObserver;
+  void Add(const std::string& name);
+  void Remove(const std::string& name);
+  bool Contains(const std::string& name) const;
+  void Clear();
 
-class ApplicationManagerMetricWrapper: public MetricWrapper {
+  size_t size() const {
+    return size_;
+  }
 
-  public:
-    utils::SharedPtr<application_manager::AMMetricObserver::MessageMetric> message_metric;
+ private:
+  struct Entry {
+    std::string key;
+    uint32_t hash;
+    uint32_t count;
+  };
+  typedef std::vector<Entry> Bucket;
 
-  protected:
-    virtual Json::Value GetJsonMetric();
+  std::string Key(const std::string& name) const;
+  static uint32_t Hash(const std::string& key);
+  void Grow();
+
+  CaseMode case_mode_;
+  std::vector<Bucket> buckets_;
+  // Number of distinct names
+  size_t size_;
 };
 
-}
-#endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_APPLICATION_MANAGER_MECTRIC_WRAPPER_H_
+}  // namespace application_manager
+
+#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_NAME_INDEX_H_
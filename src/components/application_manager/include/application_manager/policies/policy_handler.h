@@ -63,6 +63,12 @@ class PolicyHandler : public utils::Singleton<PolicyHandler>,
     return policy_manager_;
   }
   bool InitPolicyTable();
+  /**
+   * @brief Loads policy library and inits policy table only once,
+   * concurrent callers wait until loading is finished
+   * @return loaded policy manager or NULL
+   */
+  PolicyManager* LoadPolicyTable();
   bool ResetPolicyTable();
   bool ClearUserConsent();
   bool SendMessageToSDK(const BinaryMessage& pt_string);
@@ -275,9 +281,11 @@ class PolicyHandler : public utils::Singleton<PolicyHandler>,
   AppIds last_used_app_ids_;
   threads::Thread retry_sequence_;
   sync_primitives::Lock retry_sequence_lock_;
+  sync_primitives::Lock load_lock_;
   PTExchangeHandler* exchange_handler_;
   utils::SharedPtr<PolicyEventObserver> event_observer_;
   bool on_ignition_check_done_;
+  bool policy_table_loaded_;
 
   /**
    * @brief Contains device handles, which were sent for user consent to HMI
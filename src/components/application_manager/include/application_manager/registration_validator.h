@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2014, Ford Motor Company
+ * Copyright (c) 2013, Ford Motor Company
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -30,30 +30,35 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_TIME_METRIC_OBSERVER_H_
-#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_TIME_METRIC_OBSERVER_H_
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_REGISTRATION_VALIDATOR_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_REGISTRATION_VALIDATOR_H_
 
+#include <set>
 
-#include "smart_objects/smart_object.h"
-#include "application_manager/smart_object_keys.h"
-#include "json/json.h"
-#include "utils/shared_ptr.h"
-#include "utils/date_time.h"
+#include "application_manager/application.h"
+#include "interfaces/MOBILE_API.h"
 
-namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
 namespace application_manager {
 
-class AMMetricObserver {
- public:
-  struct MessageMetric {
-    TimevalStruct begin;
-    TimevalStruct end;
-    utils::SharedPtr<smart_objects::SmartObject> message;
-  };
-  typedef utils::SharedPtr<MessageMetric> MessageMetricSharedPtr;
-
-  virtual void OnMessage(MessageMetricSharedPtr) = 0;
-  virtual ~AMMetricObserver(){}
+/**
+ * @brief Checks registration request against already registered
+ * applications. Is called by ApplicationManagerImpl::RegisterApplication
+ * with applications list locked, so it must not call back into
+ * ApplicationManagerImpl.
+ */
+class RegistrationValidator {
+  public:
+    virtual ~RegistrationValidator() {
+    }
+
+    /**
+     * @return SUCCESS if application may be registered, otherwise
+     * result code of negative response
+     */
+    virtual mobile_apis::Result::eType Validate(
+        const std::set<ApplicationSharedPtr>& applications) const = 0;
 };
-}  // application_manager
-#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_USAGE_STATISTICS_H_
+
+}  // namespace application_manager
+
+#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_REGISTRATION_VALIDATOR_H_
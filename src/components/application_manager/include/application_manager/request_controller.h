@@ -33,11 +33,14 @@
 #ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_REQUEST_CONTROLLER_H_
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_REQUEST_CONTROLLER_H_
 
-#include <list>
+#include <map>
+#include <utility>
+#include "utils/conditional_variable.h"
+#include "utils/date_time.h"
 #include "utils/lock.h"
+#include "utils/threads/thread.h"
+#include "utils/threads/thread_delegate.h"
 #include "interfaces/MOBILE_API.h"
-#include "request_watchdog/request_watchdog.h"
-#include "request_watchdog/watchdog_subscriber.h"
 #include "application_manager/commands/command.h"
 
 namespace application_manager {
@@ -47,8 +50,12 @@ namespace request_controller {
 /*
  * @brief RequestController class is used to control currently active mobile
  * requests.
+ * Requests are registered by connection key and correlation ID, requests of
+ * every application are also linked in arrival order for per application
+ * limits, and requests with timeout are ordered by deadline. Expired
+ * requests are handled on controller's own timer thread.
  */
-class RequestController: public request_watchdog::WatchdogSubscriber  {
+class RequestController {
  public:
 
   // Data types
@@ -98,10 +105,12 @@ class RequestController: public request_watchdog::WatchdogSubscriber  {
   /*
    * @brief Removes request from queue
    *
+   * @param connection_key Connection key of application
    * @param mobile_corellation_id Active mobile request correlation ID
    *
    */
-  void terminateRequest(const uint32_t& mobile_correlation_id);
+  void terminateRequest(const uint32_t& connection_key,
+                        const uint32_t& mobile_correlation_id);
 
   /*
    * @brief Removes all requests from queue for specified application
@@ -111,6 +120,17 @@ class RequestController: public request_watchdog::WatchdogSubscriber  {
    */
   void terminateAppRequests(const uint32_t& app_id);
 
+  /*
+   * @brief Finds active request
+   *
+   * @param connection_key Connection key of application
+   * @param mobile_correlation_id Correlation ID of the mobile request
+   *
+   * @return Request or empty pointer if request is already removed
+   */
+  Request findRequest(const uint32_t& connection_key,
+                      const uint32_t& mobile_correlation_id);
+
   /**
    * @ Updates request timeout
    *
@@ -122,21 +142,75 @@ class RequestController: public request_watchdog::WatchdogSubscriber  {
                             const uint32_t& mobile_correlation_id,
                             const uint32_t& new_timeout);
 
+ protected:
+
+ private:
+  class TimerDelegate : public threads::ThreadDelegate {
+   public:
+    explicit TimerDelegate(RequestController* controller);
+    virtual void threadMain();
+    virtual bool exitThreadMain();
+   private:
+    RequestController* controller_;
+  };
+
+  // Connection key and correlation ID
+  typedef std::pair<uint32_t, uint32_t> RequestKey;
+  struct RequestInfo;
+  typedef std::map<RequestKey, RequestInfo*> Requests;
+  // Deadlines in milliseconds
+  typedef std::multimap<int64_t, RequestInfo*> Deadlines;
+
+  struct RequestInfo {
+    Request request;
+    RequestKey key;
+    mobile_apis::HMILevel::eType hmi_level;
+    TimevalStruct start_time;
+    bool has_deadline;
+    Deadlines::iterator deadline;
+    // Neighbours in arrival order among requests of same application
+    RequestInfo* app_prev;
+    RequestInfo* app_next;
+  };
+
+  struct AppRequests {
+    RequestInfo* first;
+    RequestInfo* last;
+  };
+  typedef std::map<uint32_t, AppRequests> AppsRequests;
+
   /*
-   * @brief Notify subscriber that expired entry should be removed
-   * using Watchdog::removeRequest(int32_t connection_key, int32_t correlation_id)
-   *
-   * @param RequestInfo Request related information
+   * @brief Checks amount of application requests started during time scale,
+   * if hmi_level is not INVALID_ENUM only requests in this level are counted
    */
-  void onTimeoutExpired(const request_watchdog::RequestInfo& info);
+  bool checkTimeScaleMaxRequest(const uint32_t& connection_key,
+                                const mobile_apis::HMILevel::eType hmi_level,
+                                const uint32_t& app_time_scale,
+                                const uint32_t& max_request_per_time_scale);
 
- protected:
+  /*
+   * @brief Calls onTimeOut of expired requests until controller is stopped.
+   * Called on timer thread.
+   */
+  void TimerLoop();
 
- private:
+  void Stop();
+
+  void setDeadline(RequestInfo* info, const uint32_t& timeout);
+  void clearDeadline(RequestInfo* info);
+
+  /*
+   * @brief Unlinks request from all indices and frees it
+   */
+  void removeRequest(Requests::iterator it);
 
-  std::list<Request>                          request_list_;
+  Requests                                    requests_;
+  AppsRequests                                apps_requests_;
+  Deadlines                                   deadlines_;
   sync_primitives::Lock                       request_list_lock_;
-  request_watchdog::Watchdog*                 watchdog_;
+  sync_primitives::ConditionalVariable        deadlines_changed_;
+  bool                                        stopped_;
+  threads::Thread                             timer_;
 
   DISALLOW_COPY_AND_ASSIGN(RequestController);
 };
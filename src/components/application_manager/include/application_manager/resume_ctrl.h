@@ -39,7 +39,9 @@
 #else
 #include <stdint.h>
 #endif
+#include <ctime>
 #include <vector>
+#include <deque>
 #include <map>
 #include <set>
 #include <list>
@@ -53,6 +55,7 @@
 #include "application_manager/event_engine/event_observer.h"
 #include "smart_objects/smart_object.h"
 #include "application_manager/application.h"
+#include "utils/lock.h"
 #include "utils/timer_thread.h"
 
 namespace application_manager {
@@ -71,6 +74,11 @@ class ResumeCtrl: public event_engine::EventObserver {
    */
     explicit ResumeCtrl(ApplicationManagerImpl* app_mngr);
 
+    /**
+     * @brief Destructor
+     */
+    ~ResumeCtrl();
+
     /**
      * @brief Event, that raised if application get resumption response from HMI
      * @param event : event object, that contains smart_object with HMI message
@@ -88,6 +96,14 @@ class ResumeCtrl: public event_engine::EventObserver {
      */
     void SaveApplication(ApplicationConstSharedPtr application);
 
+    /**
+     * @brief Save application after request changed its commands, sub menus,
+     * choice sets, files, subscriptions or global properties, so the change
+     * is kept even if SDL is not shut down properly
+     * @param application is application witch data was changed
+     */
+    void OnApplicationDataChanged(ApplicationConstSharedPtr application);
+
     /**
      * @brief Set application HMI Level as saved
      * @param application is application witch HMI Level is need to restore
@@ -175,12 +191,25 @@ class ResumeCtrl: public event_engine::EventObserver {
      */
     uint32_t GetHMIApplicationID(const std::string& mobile_app_id);
 
+    /**
+     * @brief Drop restoration requests of application which were not
+     * sent to HMI yet, e.g. when application is unregistered
+     * @param app_id application id
+     */
+    void StopRestoration(uint32_t app_id);
+
     /**
      * @brief Timer callback function
      *
      */
     void onTimer();
 
+    /**
+     * @brief Restoration timer callback, expires HMI requests
+     * which are not answered in time
+     */
+    void onRestorationTimer();
+
   private:
 
     typedef std::pair<uint32_t, uint32_t> application_timestamp;
@@ -194,6 +223,36 @@ class ResumeCtrl: public event_engine::EventObserver {
       ApplicationSharedPtr app;
     };
 
+    typedef std::vector<smart_objects::SmartObject*> RequestList;
+
+    /**
+     * @brief HMI requests restoring data of single application
+     */
+    struct RestorationBatch {
+      RestorationBatch() : in_flight(0), total(0), failed(0) {}
+      std::deque<smart_objects::SmartObject*> queued;
+      uint32_t in_flight;
+      uint32_t total;
+      uint32_t failed;
+    };
+
+    /**
+     * @brief HMI request sent during restoration, waiting for response
+     */
+    struct RestorationRequest {
+      uint32_t app_id;
+      hmi_apis::FunctionID::eType function_id;
+      time_t sent_time;
+    };
+
+    /**
+     * @brief Versions of application data parts last written to saved state
+     */
+    struct SavedDataVersions {
+      uint32_t app_id;
+      uint32_t versions[kResumptionDataPartsCount];
+    };
+
     struct TimeStampComparator {
         bool operator() (const application_timestamp& lhs,
                          const application_timestamp& rhs) const{
@@ -212,9 +271,11 @@ class ResumeCtrl: public event_engine::EventObserver {
     bool IsDeviceMacAddressEqual(ApplicationSharedPtr application,
                                  const std::string& saved_device_mac);
 
-    Json::Value& GetSavedApplications();
-
-    void SetSavedApplication(Json::Value& apps_json);
+    /**
+     * @brief Copy of saved applications, last state is changed
+     * concurrently so it is never iterated in place
+     */
+    Json::Value GetSavedApplications();
 
     Json::Value GetApplicationCommands(
         ApplicationConstSharedPtr application);
@@ -231,16 +292,45 @@ class ResumeCtrl: public event_engine::EventObserver {
     Json::Value GetApplicationShow(
         ApplicationConstSharedPtr application);
 
+    /**
+     * @brief Convert application data part to saved representation
+     */
+    Json::Value GetApplicationDataPart(ApplicationConstSharedPtr application,
+                                       ResumptionDataPart part);
+
     Json::Value JsonFromSO(
         const NsSmartDeviceLink::NsSmartObjects::SmartObject *so);
 
-    void SendHMIRequest(const hmi_apis::FunctionID::eType& function_id,
-                        const smart_objects::SmartObject* msg_params = NULL,
-                        bool use_events = false);
+    smart_objects::SmartObject* CreateHMIRequest(
+        const hmi_apis::FunctionID::eType& function_id,
+        const smart_objects::SmartObject& msg_params);
 
-    bool ProcessHMIRequest(
-        NsSmartDeviceLink::NsSmartObjects::SmartObject* request = NULL,
-        bool use_events = false);
+    /**
+     * @brief Queue HMI requests restoring application data. Requests are
+     * sent in order, keeping limited number of them waiting for response
+     * @param app_id application id
+     * @param requests requests to be sent, ownership is taken
+     */
+    void StartRestoration(uint32_t app_id, const RequestList& requests);
+
+    /**
+     * @brief Send queued restoration requests while window is not full
+     */
+    void SendRestorationRequests();
+
+    /**
+     * @brief Account response (or its absence) to restoration request
+     * @param correlation_id HMI correlation id of request
+     * @param success true if HMI processed request successfully
+     */
+    void OnRestorationResponse(int32_t correlation_id, bool success);
+
+    /**
+     * @brief Called once all restoration requests of application
+     * are answered or expired, sends OnHashChange to mobile
+     */
+    void OnRestorationCompleted(uint32_t app_id, uint32_t total,
+                                uint32_t failed);
 
     /**
      * @brief Time step to check resumption TIME_OUT
@@ -260,6 +350,19 @@ class ResumeCtrl: public event_engine::EventObserver {
     std::multiset<application_timestamp, TimeStampComparator> waiting_for_timer_;
     mutable sync_primitives::Lock   queue_lock_;
     timer::TimerThread<ResumeCtrl>  timer_;
+
+    std::map<uint32_t, RestorationBatch>      restoration_batches_;
+    std::map<int32_t, RestorationRequest>     restoration_requests_;
+    sync_primitives::Lock                     restoration_lock_;
+
+    /**
+     * @brief Data versions of saved applications keyed by mobile app id,
+     * lets SaveApplication rewrite only modified parts
+     */
+    std::map<std::string, SavedDataVersions> saved_versions_;
+    sync_primitives::Lock                     saved_versions_lock_;
+    timer::TimerThread<ResumeCtrl>            restoration_timer_;
+    bool                                      restoration_timer_started_;
     ApplicationManagerImpl*         app_mngr_;
 };
 
@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_SORTED_ID_MAP_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_SORTED_ID_MAP_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace application_manager {
+
+/*
+ * @brief SortedIdMap keeps values ordered by ID in one contiguous vector.
+ * It offers subset of std::map interface used for application data,
+ * so lookups are binary searches and iteration is linear walk
+ * over memory. Any insertion or erase invalidates iterators.
+ */
+template <typename T>
+class SortedIdMap {
+ public:
+  typedef uint32_t key_type;
+  typedef T mapped_type;
+  typedef std::pair<key_type, mapped_type> value_type;
+  typedef typename std::vector<value_type>::iterator iterator;
+  typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+  iterator begin() {
+    return items_.begin();
+  }
+  iterator end() {
+    return items_.end();
+  }
+  const_iterator begin() const {
+    return items_.begin();
+  }
+  const_iterator end() const {
+    return items_.end();
+  }
+  size_t size() const {
+    return items_.size();
+  }
+  bool empty() const {
+    return items_.empty();
+  }
+  void clear() {
+    items_.clear();
+  }
+
+  iterator lower_bound(key_type key) {
+    return std::lower_bound(items_.begin(), items_.end(), key, KeyLess());
+  }
+  const_iterator lower_bound(key_type key) const {
+    return std::lower_bound(items_.begin(), items_.end(), key, KeyLess());
+  }
+
+  iterator find(key_type key) {
+    iterator it = lower_bound(key);
+    return (items_.end() != it && key == it->first) ? it : items_.end();
+  }
+  const_iterator find(key_type key) const {
+    const_iterator it = lower_bound(key);
+    return (items_.end() != it && key == it->first) ? it : items_.end();
+  }
+
+  /*
+   * @brief Returns value with the specified ID, value initialized
+   * one is inserted if there is no such ID
+   */
+  mapped_type& operator[](key_type key) {
+    iterator it = lower_bound(key);
+    if (items_.end() == it || key != it->first) {
+      it = items_.insert(it, value_type(key, mapped_type()));
+    }
+    return it->second;
+  }
+
+  void erase(iterator it) {
+    items_.erase(it);
+  }
+  size_t erase(key_type key) {
+    iterator it = find(key);
+    if (items_.end() == it) {
+      return 0;
+    }
+    items_.erase(it);
+    return 1;
+  }
+
+ private:
+  // Debug builds with checked iterators also call predicate with swapped
+  // arguments and with two items to validate ordering
+  struct KeyLess {
+    bool operator()(const value_type& item, key_type key) const {
+      return item.first < key;
+    }
+    bool operator()(key_type key, const value_type& item) const {
+      return key < item.first;
+    }
+    bool operator()(const value_type& left, const value_type& right) const {
+      return left.first < right.first;
+    }
+  };
+
+  std::vector<value_type> items_;
+};
+
+}  // namespace application_manager
+
+#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_SORTED_ID_MAP_H_
@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_STRAND_EXECUTOR_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_STRAND_EXECUTOR_H_
+
+#include <stdint.h>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "utils/conditional_variable.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace threads {
+class Thread;
+}
+
+namespace application_manager {
+
+/*
+ * @brief StrandExecutor runs tasks on fixed pool of worker threads.
+ * Every task is posted to a strand, tasks of one strand are run one
+ * after another in posting order, while tasks of different strands
+ * run in parallel. Ready strands are served in round robin order, one
+ * task at a time, so busy strand does not starve the others.
+ */
+class StrandExecutor {
+ public:
+  typedef uint32_t StrandId;
+
+  class Task {
+   public:
+    virtual ~Task() {
+    }
+    virtual void Run() = 0;
+  };
+
+  /*
+   * @brief Starts worker threads
+   *
+   * @param name Name of worker threads, index is appended
+   * @param workers_count Number of worker threads, at least one is started
+   */
+  StrandExecutor(const std::string& name, uint32_t workers_count);
+
+  /*
+   * @brief Runs all posted tasks and stops worker threads
+   */
+  ~StrandExecutor();
+
+  /*
+   * @brief Queues task to strand. Thread-safe.
+   *
+   * @param strand_id Strand to run task on
+   * @param task Task to run, executor takes ownership
+   */
+  void Post(StrandId strand_id, Task* task);
+
+  /*
+   * @brief Returns number of tasks which are posted but not finished yet
+   */
+  size_t PendingTasks() const;
+
+ private:
+  class Worker;
+
+  struct Strand {
+    // Front task is running while strand is not in ready_strands_
+    std::deque<Task*> tasks;
+  };
+  typedef std::map<StrandId, Strand> Strands;
+
+  /*
+   * @brief Runs tasks of ready strands until executor is stopped.
+   * Called on worker threads.
+   */
+  void WorkerLoop();
+
+  /*
+   * @brief Lets workers exit as soon as all queued tasks are run
+   */
+  void Stop();
+
+  Strands strands_;
+  // Strands which have tasks and none of them is running now
+  std::deque<StrandId> ready_strands_;
+  size_t pending_tasks_;
+  bool stopping_;
+  mutable sync_primitives::Lock lock_;
+  sync_primitives::ConditionalVariable strand_ready_;
+  std::vector<threads::Thread*> workers_;
+
+  DISALLOW_COPY_AND_ASSIGN(StrandExecutor);
+};
+
+}  // namespace application_manager
+
+#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_STRAND_EXECUTOR_H_
@@ -0,0 +1,163 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef MODIFY_FUNCTION_SIGN
+#include <global_first.h>
+#endif
+#include "application_manager/app_storage_ledger.h"
+#include "config_profile/profile.h"
+#include "utils/file_system.h"
+#include "utils/logger.h"
+
+namespace application_manager {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "ApplicationManager")
+
+AppStorageLedger::AppStorageLedger() {
+}
+
+AppStorageLedger::~AppStorageLedger() {
+}
+
+uint64_t AppStorageLedger::Usage(const std::string& folder_name) {
+  {
+    sync_primitives::AutoLock lock(entries_lock_);
+    Entries::const_iterator it = entries_.find(folder_name);
+    if (entries_.end() != it) {
+      const uint32_t period =
+          profile::Profile::instance()->app_storage_reconcile_period();
+      const int64_t elapsed =
+          date_time::DateTime::calculateTimeSpan(it->second.scan_time);
+      if (0 == period ||
+          elapsed < period * date_time::DateTime::MILLISECONDS_IN_SECOND) {
+        return it->second.usage;
+      }
+    }
+  }
+  return Scan(folder_name);
+}
+
+void AppStorageLedger::OnFileChanged(const std::string& folder_name,
+                                     uint64_t old_size,
+                                     uint64_t new_size) {
+  sync_primitives::AutoLock lock(entries_lock_);
+  Entries::iterator it = entries_.find(folder_name);
+  if (entries_.end() == it) {
+    // Folder will be scanned on first request
+    return;
+  }
+  uint64_t& usage = it->second.usage;
+  if (new_size >= old_size) {
+    usage += new_size - old_size;
+  } else {
+    const uint64_t released = old_size - new_size;
+    usage = usage > released ? usage - released : 0;
+  }
+  LOG4CXX_INFO(logger_, "Storage usage of " << folder_name << " is "
+               << usage);
+}
+
+void AppStorageLedger::OnWriteQueued(const std::string& folder_name,
+                                     uint64_t old_size,
+                                     uint64_t new_size) {
+  if (new_size <= old_size) {
+    // Released space is counted once it is really released
+    return;
+  }
+  sync_primitives::AutoLock lock(entries_lock_);
+  queued_[folder_name] += new_size - old_size;
+}
+
+void AppStorageLedger::OnWriteDone(const std::string& folder_name,
+                                   uint64_t old_size,
+                                   uint64_t new_size,
+                                   bool success) {
+  if (new_size > old_size) {
+    sync_primitives::AutoLock lock(entries_lock_);
+    std::map<std::string, uint64_t>::iterator it = queued_.find(folder_name);
+    if (queued_.end() != it) {
+      const uint64_t growth = new_size - old_size;
+      if (it->second > growth) {
+        it->second -= growth;
+      } else {
+        queued_.erase(it);
+      }
+    }
+  }
+  if (success) {
+    OnFileChanged(folder_name, old_size, new_size);
+  }
+}
+
+uint64_t AppStorageLedger::QueuedUsage(const std::string& folder_name) const {
+  sync_primitives::AutoLock lock(entries_lock_);
+  std::map<std::string, uint64_t>::const_iterator it =
+      queued_.find(folder_name);
+  return queued_.end() != it ? it->second : 0;
+}
+
+void AppStorageLedger::Reconcile(const std::string& folder_name) {
+  Scan(folder_name);
+}
+
+AppStorageLedger::UsageMap AppStorageLedger::Snapshot() const {
+  UsageMap snapshot;
+  sync_primitives::AutoLock lock(entries_lock_);
+  for (Entries::const_iterator it = entries_.begin();
+       entries_.end() != it; ++it) {
+    snapshot[it->first] = it->second.usage;
+  }
+  return snapshot;
+}
+
+uint64_t AppStorageLedger::Scan(const std::string& folder_name) {
+  std::string app_storage_path =
+      profile::Profile::instance()->app_storage_folder();
+  app_storage_path += "/";
+  app_storage_path += folder_name;
+
+  Entry entry;
+  entry.usage = 0;
+  if (file_system::DirectoryExists(app_storage_path)) {
+    entry.usage = file_system::DirectorySize(app_storage_path);
+  }
+  entry.scan_time = date_time::DateTime::getCurrentTime();
+
+  LOG4CXX_INFO(logger_, "Scanned storage of " << folder_name << ": "
+               << entry.usage << " bytes");
+
+  sync_primitives::AutoLock lock(entries_lock_);
+  entries_[folder_name] = entry;
+  return entry.usage;
+}
+
+}  // namespace application_manager
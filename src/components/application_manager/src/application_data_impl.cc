@@ -33,6 +33,8 @@
 #ifdef MODIFY_FUNCTION_SIGN
 #include <global_first.h>
 #endif
+#include <algorithm>
+
 #include "application_manager/application_data_impl.h"
 #include "application_manager/smart_object_keys.h"
 
@@ -180,7 +182,12 @@ DynamicApplicationDataImpl::DynamicApplicationDataImpl()
       is_perform_interaction_active_(false),
       perform_interaction_ui_corrid_(0),
       is_reset_global_properties_active_(false),
-      perform_interaction_mode_(-1) {
+      perform_interaction_mode_(-1),
+      command_menu_names_(NameIndex::kCaseSensitive),
+      command_vr_synonyms_(NameIndex::kCaseInsensitive),
+      sub_menu_names_(NameIndex::kCaseSensitive),
+      choice_ids_() {
+  std::fill(data_versions_, data_versions_ + kResumptionDataPartsCount, 0);
 }
 
 DynamicApplicationDataImpl::~DynamicApplicationDataImpl() {
@@ -226,6 +233,12 @@ DynamicApplicationDataImpl::~DynamicApplicationDataImpl() {
   }
   sub_menu_.clear();
 
+  for (ChoiceSetMap::iterator choice_set_it = choice_set_map_.begin();
+      choice_set_map_.end() != choice_set_it; ++choice_set_it) {
+    delete choice_set_it->second;
+  }
+  choice_set_map_.clear();
+
   PerformChoiceSetMap::iterator it = performinteraction_choice_set_map_.begin();
   for (; performinteraction_choice_set_map_.end() != it; ++it) {
     delete it->second;
@@ -374,15 +387,20 @@ void DynamicApplicationDataImpl::set_menu_icon(
 
 void DynamicApplicationDataImpl::AddCommand(
   uint32_t cmd_id, const smart_objects::SmartObject& command) {
+  RemoveCommand(cmd_id);
   commands_[cmd_id] = new smart_objects::SmartObject(command);
+  IndexCommand(command);
+  ChangeDataVersion(kCommandsData);
 }
 
 void DynamicApplicationDataImpl::RemoveCommand(uint32_t cmd_id) {
   CommandsMap::iterator it = commands_.find(cmd_id);
 
   if (commands_.end() != it) {
+    UnindexCommand(*it->second);
     delete it->second;
     commands_.erase(it);
+    ChangeDataVersion(kCommandsData);
   }
 }
 
@@ -399,15 +417,20 @@ smart_objects::SmartObject* DynamicApplicationDataImpl::FindCommand(
 // TODO(VS): Create common functions for processing collections
 void DynamicApplicationDataImpl::AddSubMenu(
   uint32_t menu_id, const smart_objects::SmartObject& menu) {
+  RemoveSubMenu(menu_id);
   sub_menu_[menu_id] = new smart_objects::SmartObject(menu);
+  sub_menu_names_.Add(menu[strings::menu_name].asString());
+  ChangeDataVersion(kSubMenusData);
 }
 
 void DynamicApplicationDataImpl::RemoveSubMenu(uint32_t menu_id) {
   SubMenuMap::iterator it = sub_menu_.find(menu_id);
 
   if (sub_menu_.end() != it) {
+    sub_menu_names_.Remove((*it->second)[strings::menu_name].asString());
     delete it->second;
-    sub_menu_.erase(menu_id);
+    sub_menu_.erase(it);
+    ChangeDataVersion(kSubMenusData);
   }
 }
 
@@ -423,28 +446,40 @@ smart_objects::SmartObject* DynamicApplicationDataImpl::FindSubMenu(
 
 bool DynamicApplicationDataImpl::IsSubMenuNameAlreadyExist(
     const std::string& name) {
-  for (SubMenuMap::iterator it = sub_menu_.begin();
-       sub_menu_.end() != it;
-       ++it) {
-    smart_objects::SmartObject* menu = it->second;
-    if ((*menu)[strings::menu_name] == name) {
-      return true;
-    }
-  }
-  return false;
+  return sub_menu_names_.Contains(name);
+}
+
+bool DynamicApplicationDataImpl::IsCommandMenuNameAlreadyExist(
+    const std::string& name) const {
+  return command_menu_names_.Contains(name);
+}
+
+bool DynamicApplicationDataImpl::IsCommandVRSynonymAlreadyExist(
+    const std::string& vr_synonym) const {
+  return command_vr_synonyms_.Contains(vr_synonym);
+}
+
+bool DynamicApplicationDataImpl::IsChoiceIdAlreadyExist(
+    int32_t choice_id) const {
+  return choice_ids_.end() != choice_ids_.find(choice_id);
 }
 
 void DynamicApplicationDataImpl::AddChoiceSet(
   uint32_t choice_set_id, const smart_objects::SmartObject& choice_set) {
+  RemoveChoiceSet(choice_set_id);
   choice_set_map_[choice_set_id] = new smart_objects::SmartObject(choice_set);
+  IndexChoiceSet(choice_set);
+  ChangeDataVersion(kChoiceSetsData);
 }
 
 void DynamicApplicationDataImpl::RemoveChoiceSet(uint32_t choice_set_id) {
   ChoiceSetMap::iterator it = choice_set_map_.find(choice_set_id);
 
   if (choice_set_map_.end() != it) {
+    UnindexChoiceSet(*it->second);
     delete it->second;
-    choice_set_map_.erase(choice_set_id);
+    choice_set_map_.erase(it);
+    ChangeDataVersion(kChoiceSetsData);
   }
 }
 
@@ -458,6 +493,10 @@ smart_objects::SmartObject* DynamicApplicationDataImpl::FindChoiceSet(
   return NULL;
 }
 
+void DynamicApplicationDataImpl::ChangeDataVersion(ResumptionDataPart part) {
+  ++data_versions_[part];
+}
+
 void DynamicApplicationDataImpl::AddPerformInteractionChoiceSet(
   uint32_t choice_set_id, const smart_objects::SmartObject& vr_commands) {
   performinteraction_choice_set_map_[choice_set_id] =
@@ -504,4 +543,54 @@ void DynamicApplicationDataImpl::set_perform_interaction_mode(int32_t mode) {
   perform_interaction_mode_ = mode;
 }
 
+void DynamicApplicationDataImpl::IndexCommand(
+    const smart_objects::SmartObject& command) {
+  if (command.keyExists(strings::menu_params)) {
+    command_menu_names_.Add(
+        command[strings::menu_params][strings::menu_name].asString());
+  }
+  if (command.keyExists(strings::vr_commands)) {
+    const smart_objects::SmartObject& vr_commands =
+        command[strings::vr_commands];
+    for (size_t i = 0; i < vr_commands.length(); ++i) {
+      command_vr_synonyms_.Add(vr_commands[i].asString());
+    }
+  }
+}
+
+void DynamicApplicationDataImpl::UnindexCommand(
+    const smart_objects::SmartObject& command) {
+  if (command.keyExists(strings::menu_params)) {
+    command_menu_names_.Remove(
+        command[strings::menu_params][strings::menu_name].asString());
+  }
+  if (command.keyExists(strings::vr_commands)) {
+    const smart_objects::SmartObject& vr_commands =
+        command[strings::vr_commands];
+    for (size_t i = 0; i < vr_commands.length(); ++i) {
+      command_vr_synonyms_.Remove(vr_commands[i].asString());
+    }
+  }
+}
+
+void DynamicApplicationDataImpl::IndexChoiceSet(
+    const smart_objects::SmartObject& choice_set) {
+  const smart_objects::SmartObject& choices = choice_set[strings::choice_set];
+  for (size_t i = 0; i < choices.length(); ++i) {
+    ++choice_ids_[choices[i][strings::choice_id].asInt()];
+  }
+}
+
+void DynamicApplicationDataImpl::UnindexChoiceSet(
+    const smart_objects::SmartObject& choice_set) {
+  const smart_objects::SmartObject& choices = choice_set[strings::choice_set];
+  for (size_t i = 0; i < choices.length(); ++i) {
+    std::map<int32_t, uint32_t>::iterator it =
+        choice_ids_.find(choices[i][strings::choice_id].asInt());
+    if (choice_ids_.end() != it && 0 == --it->second) {
+      choice_ids_.erase(it);
+    }
+  }
+}
+
 }  // namespace application_manager
@@ -36,6 +36,7 @@
 #include <string>
 #include <stdlib.h>
 #include "application_manager/application_impl.h"
+#include "application_manager/application_manager_impl.h"
 #include "application_manager/message_helper.h"
 #include "config_profile/profile.h"
 #include "utils/file_system.h"
@@ -298,6 +299,7 @@ ProtocolVersion ApplicationImpl::protocol_version() const {
 bool ApplicationImpl::AddFile(AppFile& file) {
   if (app_files_.count(file.file_name) == 0) {
     app_files_[file.file_name] = file;
+    ChangeDataVersion(kFilesData);
     return true;
   }
   return false;
@@ -306,6 +308,7 @@ bool ApplicationImpl::AddFile(AppFile& file) {
 bool ApplicationImpl::UpdateFile(AppFile& file) {
   if (app_files_.count(file.file_name) != 0) {
     app_files_[file.file_name] = file;
+    ChangeDataVersion(kFilesData);
     return true;
   }
   return false;
@@ -315,6 +318,7 @@ bool ApplicationImpl::DeleteFile(const std::string& file_name) {
   AppFilesMap::iterator it = app_files_.find(file_name);
   if (it != app_files_.end()) {
     app_files_.erase(it);
+    ChangeDataVersion(kFilesData);
     return true;
   }
   return false;
@@ -332,48 +336,37 @@ const AppFile* ApplicationImpl::GetFile(const std::string& file_name) {
 }
 
 bool ApplicationImpl::SubscribeToButton(mobile_apis::ButtonName::eType btn_name) {
-  size_t old_size = subscribed_buttons_.size();
-  subscribed_buttons_.insert(btn_name);
-  return (subscribed_buttons_.size() == old_size + 1);
+  return subscribed_buttons_.insert(btn_name);
 }
 
 bool ApplicationImpl::IsSubscribedToButton(mobile_apis::ButtonName::eType btn_name) {
-  std::set<mobile_apis::ButtonName::eType>::iterator it = subscribed_buttons_.find(btn_name);
-  return (subscribed_buttons_.end() != it);
+  return subscribed_buttons_.contains(btn_name);
 }
 bool ApplicationImpl::UnsubscribeFromButton(mobile_apis::ButtonName::eType btn_name) {
-  size_t old_size = subscribed_buttons_.size();
-  subscribed_buttons_.erase(btn_name);
-  return (subscribed_buttons_.size() == old_size - 1);
+  return subscribed_buttons_.erase(btn_name);
 }
 
 bool ApplicationImpl::SubscribeToIVI(uint32_t vehicle_info_type_) {
-  size_t old_size = subscribed_vehicle_info_.size();
-  subscribed_vehicle_info_.insert(vehicle_info_type_);
-  return (subscribed_vehicle_info_.size() == old_size + 1);
+  return subscribed_vehicle_info_.insert(vehicle_info_type_);
 }
 
 bool ApplicationImpl::IsSubscribedToIVI(uint32_t vehicle_info_type_) {
-  std::set<uint32_t>::iterator it = subscribed_vehicle_info_.find(
-      vehicle_info_type_);
-  return (subscribed_vehicle_info_.end() != it);
+  return subscribed_vehicle_info_.contains(vehicle_info_type_);
 }
 
 bool ApplicationImpl::UnsubscribeFromIVI(uint32_t vehicle_info_type_) {
-  size_t old_size = subscribed_vehicle_info_.size();
-  subscribed_vehicle_info_.erase(vehicle_info_type_);
-  return (subscribed_vehicle_info_.size() == old_size - 1);
+  return subscribed_vehicle_info_.erase(vehicle_info_type_);
 }
 
 UsageStatistics& ApplicationImpl::usage_report() {
   return usage_report_;
 }
 
-const std::set<mobile_apis::ButtonName::eType>& ApplicationImpl::SubscribedButtons() const {
+const ButtonSubscriptions& ApplicationImpl::SubscribedButtons() const {
   return subscribed_buttons_;
 }
 
-const std::set<uint32_t>& ApplicationImpl::SubscribesIVI() const {
+const VehicleInfoSubscriptions& ApplicationImpl::SubscribesIVI() const {
   return subscribed_vehicle_info_;
 }
 
@@ -397,6 +390,7 @@ void ApplicationImpl::CleanupFiles() {
       profile::Profile::instance()->app_storage_folder();
   directory_name += "/" + folder_name();
 
+  uint64_t released_space = 0;
   if (file_system::DirectoryExists(directory_name)) {
     std::vector<std::string> files = file_system::ListFiles(
             directory_name);
@@ -410,13 +404,23 @@ void ApplicationImpl::CleanupFiles() {
       app_files_it = app_files_.find(file_name);
       if ((app_files_it == app_files_.end()) ||
           (!app_files_it->second.is_persistent)) {
-          file_system::DeleteFile(file_name);
+          const uint32_t file_size = file_system::FileSize(file_name);
+          if (file_system::DeleteFile(file_name)) {
+            released_space += file_size;
+          }
       }
     }
 
     file_system::RemoveDirectory(directory_name, false);
   }
   app_files_.clear();
+  ChangeDataVersion(kFilesData);
+
+  // Application can be destroyed on SDL shutdown after manager itself
+  if (released_space && ApplicationManagerImpl::exists()) {
+    ApplicationManagerImpl::instance()->storage_ledger().OnFileChanged(
+        folder_name(), released_space, 0);
+  }
 }
 
 }  // namespace application_manager
@@ -39,6 +39,7 @@
 #include "application_manager/application_manager_impl.h"
 #include "application_manager/mobile_command_factory.h"
 #include "application_manager/commands/command_impl.h"
+#include "application_manager/commands/command_request_impl.h"
 #include "application_manager/commands/command_notification_impl.h"
 #include "application_manager/message_helper.h"
 #include "application_manager/mobile_message_handler.h"
@@ -49,7 +50,9 @@
 #include "formatters/CFormatterJsonSDLRPCv1.hpp"
 #include "config_profile/profile.h"
 #include "utils/threads/thread.h"
+#include "utils/async_file_io.h"
 #include "utils/file_system.h"
+#include "utils/latency_statistics.h"
 #include "application_manager/application_impl.h"
 #include "usage_statistics/counter.h"
 #include <time.h>
@@ -66,9 +69,84 @@ CREATE_LOGGERPTR_GLOBAL(logger_, "ApplicationManager")
 uint32_t ApplicationManagerImpl::corelation_id_ = 0;
 const uint32_t ApplicationManagerImpl::max_corelation_id_ = UINT_MAX;
 
+template <class M>
+class ApplicationManagerImpl::IncomingMessageTask
+  : public StrandExecutor::Task {
+  public:
+    IncomingMessageTask(ApplicationManagerImpl* manager, const M& message)
+      : manager_(manager),
+        message_(message) {
+    }
+
+    virtual void Run() {
+      manager_->Handle(message_);
+    }
+
+  private:
+    ApplicationManagerImpl* manager_;
+    M message_;
+};
+
+class ApplicationManagerImpl::FileWrittenTask
+  : public StrandExecutor::Task {
+  public:
+    FileWrittenTask(ApplicationManagerImpl* manager, const FileWrite& write,
+                    const std::string& file_name, bool success)
+      : manager_(manager),
+        write_(write),
+        file_name_(file_name),
+        success_(success) {
+    }
+
+    virtual void Run() {
+      manager_->OnFileWritten(write_, file_name_, success_);
+    }
+
+  private:
+    ApplicationManagerImpl* manager_;
+    FileWrite write_;
+    std::string file_name_;
+    bool success_;
+};
+
+class ApplicationManagerImpl::FileWriteCompletion
+  : public file_system::AsyncFileIO::Completion {
+  public:
+    FileWriteCompletion(ApplicationManagerImpl* manager,
+                        const FileWrite& write)
+      : manager_(manager),
+        write_(write) {
+    }
+
+    // CALLED ON AsyncFileIO worker!
+    virtual void OnWriteCompleted(const std::string& file_name,
+                                  bool success) {
+      manager_->incoming_messages_.Post(
+        write_.connection_key,
+        new FileWrittenTask(manager_, write_, file_name, success));
+    }
+
+  private:
+    ApplicationManagerImpl* manager_;
+    FileWrite write_;
+};
+
 namespace formatters = NsSmartDeviceLink::NsJSONHandler::Formatters;
 namespace jhs = NsSmartDeviceLink::NsJSONHandler::strings;
 
+namespace {
+
+/**
+ * @brief Key of mobile request in latency statistics, correlation ids
+ * are unique per application only
+ */
+uint32_t MobileRequestKey(uint32_t connection_key, uint32_t correlation_id) {
+  const uint32_t key = connection_key * 0x9E3779B1u ^ correlation_id;
+  return key ? key : 1;
+}
+
+}  // namespace
+
 ApplicationManagerImpl::ApplicationManagerImpl()
   : audio_pass_thru_active_(false),
     is_distracting_driver_(false),
@@ -81,24 +159,22 @@ ApplicationManagerImpl::ApplicationManagerImpl()
     hmi_so_factory_(NULL),
     mobile_so_factory_(NULL),
     protocol_handler_(NULL),
-    messages_from_mobile_("application_manager::FromMobileThreadImpl", this),
     messages_to_mobile_("application_manager::ToMobileThreadImpl", this),
-    messages_from_hmi_("application_manager::FromHMHThreadImpl", this),
     messages_to_hmi_("application_manager::ToHMHThreadImpl", this),
+    incoming_messages_("application_manager::IncomingWorker",
+                       profile::Profile::instance()->app_command_threads()),
     request_ctrl_(),
     hmi_capabilities_(this),
     unregister_reason_(mobile_api::AppInterfaceUnregisteredReason::IGNITION_OFF),
     media_manager_(NULL),
     resume_ctrl_(this)
-#ifdef TIME_TESTER
-    , metric_observer_(NULL)
-#endif  // TIME_TESTER
 {
   LOG4CXX_INFO(logger_, "Creating ApplicationManager");
   media_manager_ = media_manager::MediaManagerImpl::instance();
   CreatePoliciesManager();
 #ifdef MODIFY_FUNCTION_SIGN
 	audio_pass_thru_read_file_thread_ = new threads::Thread("AudioPassThruReadFileThread", new AudioPassThruReadFileThread(this));
+	audio_pass_thru_app_key_ = 0;
 #endif
 }
 
@@ -160,6 +236,11 @@ bool ApplicationManagerImpl::Stop() {
   return true;
 }
 
+std::set<ApplicationSharedPtr> ApplicationManagerImpl::applications() const {
+  sync_primitives::AutoLock lock(applications_list_lock_);
+  return application_list_;
+}
+
 ApplicationSharedPtr ApplicationManagerImpl::application(int32_t app_id) const {
   sync_primitives::AutoLock lock(applications_list_lock_);
 
@@ -208,6 +289,7 @@ ApplicationSharedPtr ApplicationManagerImpl::application_by_policy_id(
 
 ApplicationSharedPtr ApplicationManagerImpl::active_application() const {
   // TODO(DK) : check driver distraction
+  sync_primitives::AutoLock lock(applications_list_lock_);
 #ifdef OS_WINCE
   for (std::set<ApplicationSharedPtr>::const_iterator it = application_list_.begin();
 #else
@@ -223,6 +305,7 @@ ApplicationSharedPtr ApplicationManagerImpl::active_application() const {
 }
 #ifdef MODIFY_FUNCTION_SIGN
 ApplicationSharedPtr ApplicationManagerImpl::audible_application() const {
+	sync_primitives::AutoLock lock(applications_list_lock_);
 #ifdef OS_WINCE
 	for (std::set<ApplicationSharedPtr>::const_iterator it = application_list_.begin();
 #else
@@ -241,6 +324,7 @@ ApplicationSharedPtr ApplicationManagerImpl::audible_application() const {
 std::vector<ApplicationSharedPtr> ApplicationManagerImpl::applications_by_button(
   uint32_t button) {
   std::vector<ApplicationSharedPtr> result;
+  sync_primitives::AutoLock lock(applications_list_lock_);
   for (std::set<ApplicationSharedPtr>::iterator it = application_list_.begin();
        application_list_.end() != it; ++it) {
     if ((*it)->IsSubscribedToButton(
@@ -264,6 +348,7 @@ VehicleDataType vehicle_info, int value) {
   }
 
   std::vector<utils::SharedPtr<application_manager::Application>> result;
+  sync_primitives::AutoLock lock(applications_list_lock_);
   for (std::set<utils::SharedPtr<application_manager::Application>>::iterator it = application_list_.begin();
        application_list_.end() != it; ++it) {
     if ((*it)->IsSubscribedToIVI(static_cast<uint32_t>(vehicle_info))) {
@@ -275,6 +360,7 @@ VehicleDataType vehicle_info, int value) {
 
 std::vector<ApplicationSharedPtr> ApplicationManagerImpl::applications_with_navi() {
   std::vector<ApplicationSharedPtr> result;
+  sync_primitives::AutoLock lock(applications_list_lock_);
   for (std::set<ApplicationSharedPtr>::iterator it = application_list_.begin();
        application_list_.end() != it;
        ++it) {
@@ -287,7 +373,7 @@ std::vector<ApplicationSharedPtr> ApplicationManagerImpl::applications_with_navi
 
 ApplicationSharedPtr ApplicationManagerImpl::RegisterApplication(
   const utils::SharedPtr<smart_objects::SmartObject>&
-  request_for_registration) {
+  request_for_registration, RegistrationValidator* validator) {
   smart_objects::SmartObject& message = *request_for_registration;
   uint32_t connection_key =
     message[strings::params][strings::connection_key].asInt();
@@ -418,16 +504,46 @@ ApplicationSharedPtr ApplicationManagerImpl::RegisterApplication(
       message[strings::params][strings::protocol_version].asInt());
   application->set_protocol_version(protocol_version);
 
+  // Names checked by validator of concurrent registration must be set
+  // before application is visible in the list
+  if (params.keyExists(strings::vr_synonyms)) {
+    application->set_vr_synonyms(params[strings::vr_synonyms]);
+  }
+  if (params.keyExists(strings::tts_name)) {
+    application->set_tts_name(params[strings::tts_name]);
+  }
+
+  mobile_apis::Result::eType validation_result = mobile_apis::Result::SUCCESS;
+  {
+    sync_primitives::AutoLock lock(applications_list_lock_);
+    if (validator) {
+      validation_result = validator->Validate(application_list_);
+    }
+    if (mobile_apis::Result::SUCCESS == validation_result) {
+      application_list_.insert(application);
+    }
+  }
+  if (mobile_apis::Result::SUCCESS != validation_result) {
+    LOG4CXX_ERROR(logger_, "Registration of " << mobile_app_id
+                  << " is rejected with result " << validation_result);
+    utils::SharedPtr<smart_objects::SmartObject> response(
+      MessageHelper::CreateNegativeResponse(
+        connection_key, mobile_apis::FunctionID::RegisterAppInterfaceID,
+        message[strings::params][strings::correlation_id].asUInt(),
+        validation_result));
+    ManageMobileCommand(response);
+    return ApplicationSharedPtr();
+  }
+
+  // Storage usage is calculated once here and then tracked incrementally
+  storage_ledger_.Usage(application->folder_name());
+
   if (ProtocolVersion::kV3 == protocol_version) {
     if (connection_handler_) {
       connection_handler_->StartSessionHeartBeat(connection_key);
     }
   }
 
-  sync_primitives::AutoLock lock(applications_list_lock_);
-
-  application_list_.insert(application);
-
   return application;
 }
 
@@ -494,6 +610,7 @@ mobile_apis::HMILevel::eType ApplicationManagerImpl::PutApplicationInLimited(
   bool is_new_app_media = app->is_media_application();
   mobile_api::HMILevel::eType result = mobile_api::HMILevel::HMI_LIMITED;
 
+  sync_primitives::AutoLock lock(applications_list_lock_);
   for (std::set<ApplicationSharedPtr>::iterator it = application_list_.begin();
        application_list_.end() != it;
        ++it) {
@@ -527,6 +644,7 @@ mobile_api::HMILevel::eType ApplicationManagerImpl::PutApplicationInFull(
   bool is_new_app_media = app->is_media_application();
   mobile_api::HMILevel::eType result = mobile_api::HMILevel::HMI_FULL;
 
+  sync_primitives::AutoLock lock(applications_list_lock_);
   std::set<ApplicationSharedPtr>::iterator it = application_list_.begin();
   for (; application_list_.end() != it; ++it) {
     ApplicationSharedPtr curr_app = *it;
@@ -560,6 +678,7 @@ mobile_api::HMILevel::eType ApplicationManagerImpl::PutApplicationInFull(
 
   if (result == mobile_api::HMILevel::HMI_FULL) {
     app->set_hmi_level(result);
+    sync_primitives::AutoUnlock unlock(lock);
     MessageHelper::SendActivateAppToHMI(app->app_id());
   }
   return result;
@@ -613,6 +732,7 @@ void ApplicationManagerImpl::OnHMIStartedCooperation() {
 }
 
 uint32_t ApplicationManagerImpl::GetNextHMICorrelationID() {
+  sync_primitives::AutoLock lock(corelation_id_lock_);
   if (corelation_id_ < max_corelation_id_) {
     corelation_id_++;
   } else {
@@ -642,6 +762,11 @@ bool ApplicationManagerImpl::end_audio_pass_thru() {
   }
 }
 
+bool ApplicationManagerImpl::audio_pass_thru_active() {
+  sync_primitives::AutoLock lock(audio_pass_thru_lock_);
+  return audio_pass_thru_active_;
+}
+
 void ApplicationManagerImpl::set_driver_distraction(bool is_distracting) {
   is_distracting_driver_ = is_distracting;
 }
@@ -682,13 +807,25 @@ void ApplicationManagerImpl::StartAudioPassThruThread(int32_t session_key,
 		//timer_.setUnitRate(1000);
 		//timer_.start(1);
 		clearAudioPassThruData();
+		audio_pass_thru_app_key_ = session_key;
+		if (0 == audio_pass_thru_app_key_ && audible_application()) {
+			audio_pass_thru_app_key_ = audible_application()->app_id();
+		}
+		if (is_send_) {
+			// Recorded samples are queued by onAudioPassThruDataSend and sent
+			// to mobile in chunks of configured duration
+			media_manager_->StartMicrophoneRecording(
+				audio_pass_thru_app_key_,
+				profile::Profile::instance()->recording_file_name(),
+				max_duration, sampling_rate, bits_per_sample);
+		}
 		msp_passthru_start(application_manager::ApplicationManagerImpl::instance()->onAudioPassThruDataSend);
 		LOG4CXX_INFO(logger_, "msp_passthru_start()");
 #else
     media_manager_->StartMicrophoneRecording(
       session_key,
       profile::Profile::instance()->recording_file_name(),
-      max_duration);
+      max_duration, sampling_rate, bits_per_sample);
 #endif
   }
 }
@@ -710,35 +847,22 @@ void ApplicationManagerImpl::StopAudioPassThruReadFileThread()
 #ifdef MODIFY_FUNCTION_SIGN
 void ApplicationManagerImpl::onAudioPassThruDataSend(char *data,int len)
 {
-	printf("passthru len=%d\n",  len);
-	std::vector<unsigned char> vecData(len);
-#ifdef OS_WINCE
-	memcpy(vecData._Myfirst, data, len);
-#else
-	memcpy(vecData.data(), data, len);
-#endif
 	application_manager::ApplicationManagerImpl *application_manager = application_manager::ApplicationManagerImpl::instance();
-	bool is_send = application_manager->is_send();
-	bool is_save = application_manager->is_save();
-	if (is_send){
-		application_manager::ApplicationSharedPtr audible_app = application_manager->audible_application();
-		if (audible_app){
-			int app_id = audible_app->app_id();
-			application_manager->SendAudioPassThroughNotification(app_id, vecData);
-		}else{
-			LOG4CXX_INFO(logger_, "audible_app is NULL");
-		}
+	const uint8_t* samples = reinterpret_cast<const uint8_t*>(data);
+	if (application_manager->is_send() && application_manager->media_manager_){
+		application_manager->media_manager_->OnMicrophoneData(
+			application_manager->audio_pass_thru_app_key_, samples, len);
 	}
-	if (is_save){
+	if (application_manager->is_save()){
+		std::vector<unsigned char> vecData(samples, samples + len);
 		application_manager->appendAudioPassThruData(vecData);
 	}
-	
 }
 #endif
 
 void ApplicationManagerImpl::SendAudioPassThroughNotification(
   uint32_t session_key,
-  std::vector<uint8_t> binaryData) {
+  const BinaryData& binary_data) {
   LOG4CXX_TRACE_ENTER(logger_);
 
   if (!audio_pass_thru_active_) {
@@ -768,7 +892,7 @@ void ApplicationManagerImpl::SendAudioPassThroughNotification(
   LOG4CXX_INFO_EXT(logger_, "Fill binary data");
   // binary data
   (*on_audio_pass)[strings::params][strings::binary_data] =
-    smart_objects::SmartObject(binaryData);
+    smart_objects::SmartObject(binary_data);
 
   LOG4CXX_INFO_EXT(logger_, "After fill binary data");
 
@@ -787,6 +911,10 @@ void ApplicationManagerImpl::StopAudioPassThru(int32_t application_key) {
 		LOG4CXX_INFO(logger_, "if (NULL != media_manager_)");
 #ifdef MODIFY_FUNCTION_SIGN
 	  msp_passthru_stop();
+		if (is_send_){
+			// Sends samples still queued after recording is stopped
+			media_manager_->StopMicrophoneRecording(audio_pass_thru_app_key_);
+		}
 		if (is_save_){
 			LOG4CXX_INFO(logger_, "if (is_save_)");
 			std::vector<uint8_t> data;
@@ -845,8 +973,12 @@ void ApplicationManagerImpl::OnMessageReceived(
   utils::SharedPtr<Message> outgoing_message = ConvertRawMsgToMessage(message);
 
   if (outgoing_message) {
-    messages_from_mobile_.PostMessage(
-      impl::MessageFromMobile(outgoing_message));
+    utils::LatencyStatistics::instance()->Record(
+      utils::LatencyStatistics::kProtocolHandling, message->creation_time());
+    incoming_messages_.Post(
+      outgoing_message->connection_key(),
+      new IncomingMessageTask<impl::MessageFromMobile>(
+        this, impl::MessageFromMobile(outgoing_message)));
   } else {
     LOG4CXX_WARN(logger_, "Incorrect message received");
   }
@@ -867,7 +999,10 @@ void ApplicationManagerImpl::OnMessageReceived(
     return;
   }
 
-  messages_from_hmi_.PostMessage(impl::MessageFromHmi(message));
+  incoming_messages_.Post(
+    impl::kHmiStrand,
+    new IncomingMessageTask<impl::MessageFromHmi>(
+      this, impl::MessageFromHmi(message)));
 }
 
 void ApplicationManagerImpl::OnErrorSending(
@@ -1254,8 +1389,17 @@ void ApplicationManagerImpl::SendMessageToMobile(
 
   smart_objects::SmartObject& msg_to_mobile = *message;
   if (msg_to_mobile[strings::params].keyExists(strings::correlation_id)) {
-    request_ctrl_.terminateRequest(
-      msg_to_mobile[strings::params][strings::correlation_id].asUInt());
+    const uint32_t connection_key =
+      msg_to_mobile[strings::params][strings::connection_key].asUInt();
+    const uint32_t correlation_id =
+      msg_to_mobile[strings::params][strings::correlation_id].asUInt();
+    request_ctrl_.terminateRequest(connection_key, correlation_id);
+    if (mobile_apis::messageType::response ==
+        msg_to_mobile[strings::params][strings::message_type].asInt()) {
+      utils::LatencyStatistics::instance()->Stop(
+        utils::LatencyStatistics::kMobileRequest,
+        MobileRequestKey(connection_key, correlation_id));
+    }
   }
 
   messages_to_mobile_.PostMessage(impl::MessageToMobile(message_to_send,
@@ -1308,6 +1452,9 @@ bool ApplicationManagerImpl::ManageMobileCommand(
   uint32_t protocol_type =
     (*message)[strings::params][strings::protocol_type].asUInt();
 
+  utils::LatencyStatistics* statistics = utils::LatencyStatistics::instance();
+  statistics->CountRpc(utils::LatencyStatistics::kMobileRpc, function_id);
+
   ApplicationSharedPtr app;
 
   if (((mobile_apis::FunctionID::RegisterAppInterfaceID != function_id) &&
@@ -1446,9 +1593,13 @@ bool ApplicationManagerImpl::ManageMobileCommand(
         LOG4CXX_ERROR_EXT(logger_, "Unable to perform request: Unknown case");
         return false;
       }
+      statistics->Start(utils::LatencyStatistics::kMobileRequest,
+                        MobileRequestKey(connection_key, correlation_id));
     }
 
+    const TimevalStruct run_start = date_time::DateTime::getCurrentTime();
     command->Run();
+    statistics->Record(utils::LatencyStatistics::kCommandRun, run_start);
   }
 
   return true;
@@ -1494,6 +1645,13 @@ void ApplicationManagerImpl::SendMessageToHMI(
   message_to_send->set_smart_object(*message);
 #endif  // HMI_DBUS_API
 
+  if (hmi_apis::messageType::request ==
+      (*message)[strings::params][strings::message_type].asInt()) {
+    utils::LatencyStatistics::instance()->Start(
+      utils::LatencyStatistics::kHMIRoundTrip,
+      (*message)[strings::params][strings::correlation_id].asUInt());
+  }
+
   messages_to_hmi_.PostMessage(impl::MessageToHmi(message_to_send));
 }
 
@@ -1518,8 +1676,28 @@ bool ApplicationManagerImpl::ManageHMICommand(
     return false;
   }
 
+  utils::LatencyStatistics* statistics = utils::LatencyStatistics::instance();
+  statistics->CountRpc(
+    utils::LatencyStatistics::kHMIRpc,
+    (*message)[strings::params][strings::function_id].asInt());
+  const int32_t message_type =
+    (*message)[strings::params][strings::message_type].asInt();
+  const bool is_response =
+    hmi_apis::messageType::response == message_type ||
+    hmi_apis::messageType::error_response == message_type;
+  if (is_response) {
+    statistics->Stop(
+      utils::LatencyStatistics::kHMIRoundTrip,
+      (*message)[strings::params][strings::correlation_id].asUInt());
+  }
+
   if (command->Init()) {
+    const TimevalStruct run_start = date_time::DateTime::getCurrentTime();
     command->Run();
+    if (is_response) {
+      statistics->Record(utils::LatencyStatistics::kHMIResponseHandling,
+                         run_start);
+    }
     if (command->CleanUp()) {
       return true;
     }
@@ -1588,11 +1766,8 @@ void ApplicationManagerImpl::CreateHMIMatrix(HMIMatrix* matrix) {
 
 void ApplicationManagerImpl::CreatePoliciesManager() {
   LOG4CXX_INFO(logger_, "CreatePoliciesManager");
-  policy_manager_ = policy::PolicyHandler::instance()->LoadPolicyLibrary();
-  if (policy_manager_) {
-    LOG4CXX_INFO(logger_, "Policy library is loaded, now initing PT");
-    policy::PolicyHandler::instance()->InitPolicyTable();
-  }
+  // Table may be already loaded or being loaded by startup sequence
+  policy_manager_ = policy::PolicyHandler::instance()->LoadPolicyTable();
 }
 
 bool ApplicationManagerImpl::CheckPolicies(smart_objects::SmartObject* message,
@@ -1651,9 +1826,9 @@ bool ApplicationManagerImpl::ConvertMessageToSO(
         message.connection_key();
       output[strings::params][strings::protocol_version] =
         message.protocol_version();
-      if (message.binary_data()) {
+      if (message.has_binary_data()) {
         output[strings::params][strings::binary_data] =
-          *(message.binary_data());
+          message.binary_data();
       }
       break;
     }
@@ -1811,16 +1986,9 @@ bool ApplicationManagerImpl::ConvertSOtoMessage(
   }
 
   if (message.getElement(jhs::S_PARAMS).keyExists(strings::binary_data)) {
-    application_manager::BinaryData* binaryData =
-      new application_manager::BinaryData(
+    output.set_binary_data(
       message.getElement(jhs::S_PARAMS).getElement(strings::binary_data)
-      .asBinary());
-
-    if (NULL == binaryData) {
-      LOG4CXX_ERROR(logger_, "Null pointer");
-      return false;
-    }
-    output.set_binary_data(binaryData);
+      .asBinaryBuffer());
   }
 
   LOG4CXX_INFO(logger_, "Successfully parsed smart object into message");
@@ -1866,10 +2034,6 @@ utils::SharedPtr<Message> ApplicationManagerImpl::ConvertRawMsgToMessage(
 void ApplicationManagerImpl::ProcessMessageFromMobile(
   const utils::SharedPtr<Message>& message) {
   LOG4CXX_INFO(logger_, "ApplicationManagerImpl::ProcessMessageFromMobile()");
-#ifdef TIME_TESTER
-  AMMetricObserver::MessageMetricSharedPtr metric(new AMMetricObserver::MessageMetric());
-  metric->begin = date_time::DateTime::getCurrentTime();
-#endif  // TIME_TESTER
   utils::SharedPtr<smart_objects::SmartObject> so_from_mobile(
     new smart_objects::SmartObject);
 
@@ -1882,19 +2046,10 @@ void ApplicationManagerImpl::ProcessMessageFromMobile(
     LOG4CXX_ERROR(logger_, "Cannot create smart object from message");
     return;
   }
-#ifdef TIME_TESTER
-  metric->message = so_from_mobile;
-#endif  // TIME_TESTER
 
   if (!ManageMobileCommand(so_from_mobile)) {
     LOG4CXX_ERROR(logger_, "Received command didn't run successfully");
   }
-#ifdef TIME_TESTER
-  metric->end = date_time::DateTime::getCurrentTime();
-  if (metric_observer_) {
-    metric_observer_->OnMessage(metric);
-  }
-#endif  // TIME_TESTER
 }
 
 void ApplicationManagerImpl::ProcessMessageFromHMI(
@@ -1926,6 +2081,7 @@ void ApplicationManagerImpl::ProcessMessageFromHMI(
 }
 
 hmi_apis::HMI_API& ApplicationManagerImpl::hmi_so_factory() {
+  sync_primitives::AutoLock lock(so_factories_lock_);
   if (!hmi_so_factory_) {
     hmi_so_factory_ = new hmi_apis::HMI_API;
     if (!hmi_so_factory_) {
@@ -1937,6 +2093,7 @@ hmi_apis::HMI_API& ApplicationManagerImpl::hmi_so_factory() {
 }
 
 mobile_apis::MOBILE_API& ApplicationManagerImpl::mobile_so_factory() {
+  sync_primitives::AutoLock lock(so_factories_lock_);
   if (!mobile_so_factory_) {
     mobile_so_factory_ = new mobile_apis::MOBILE_API;
     if (!mobile_so_factory_) {
@@ -1951,17 +2108,13 @@ HMICapabilities& ApplicationManagerImpl::hmi_capabilities() {
   return hmi_capabilities_;
 }
 
-#ifdef TIME_TESTER
-void ApplicationManagerImpl::SetTimeMetricObserver(AMMetricObserver* observer) {
-  metric_observer_ = observer;
-}
-#endif  // TIME_TESTER
-
 void ApplicationManagerImpl::addNotification(const CommandSharedPtr& ptr) {
+  sync_primitives::AutoLock lock(notification_list_lock_);
   notification_list_.push_back(ptr);
 }
 
 void ApplicationManagerImpl::removeNotification(const CommandSharedPtr& ptr) {
+  sync_primitives::AutoLock lock(notification_list_lock_);
   std::list<CommandSharedPtr>::iterator it = notification_list_.begin();
   for (; notification_list_.end() != it; ++it) {
     if (*it == ptr) {
@@ -2079,15 +2232,15 @@ VRStatus ApplicationManagerImpl::handleVRCommand(const int vrCommandId, const st
 		
 ApplicationSharedPtr ApplicationManagerImpl::fetchAppliation(const std::string& vrCommandName)
 {
-	const std::set<ApplicationSharedPtr>& apps = ApplicationManagerImpl::instance()
+	const std::set<ApplicationSharedPtr> apps = ApplicationManagerImpl::instance()
                                          ->applications();
 
 #ifdef OS_WINCE
-	for(std::set<ApplicationSharedPtr>::const_iterator it = ApplicationManagerImpl::instance()->applications().begin();
+	for(std::set<ApplicationSharedPtr>::const_iterator it = apps.begin();
 #else
-	for(std::set<ApplicationSharedPtr>::iterator it = ApplicationManagerImpl::instance()->applications().begin();
+	for(std::set<ApplicationSharedPtr>::iterator it = apps.begin();
 #endif
-      it != ApplicationManagerImpl::instance()->applications().end(); it++){
+      it != apps.end(); it++){
 		if ((*it)->vr_synonyms()) {
 			const smart_objects::SmartArray* vr_synonyms = (*it)->vr_synonyms()->asArray();
 			smart_objects::SmartArray::const_iterator it_array =
@@ -2110,6 +2263,7 @@ ApplicationSharedPtr ApplicationManagerImpl::fetchAppliation(const std::string&
 
 const uint32_t ApplicationManagerImpl::application_id
 (const int32_t correlation_id) {
+  sync_primitives::AutoLock lock(appID_list_lock_);
   // ykazakov: there is no erase for const iterator for QNX
   std::map<const int32_t, const uint32_t>::iterator it =
     appID_list_.find(correlation_id);
@@ -2124,6 +2278,7 @@ const uint32_t ApplicationManagerImpl::application_id
 
 void ApplicationManagerImpl::set_application_id(const int32_t correlation_id,
     const uint32_t app_id) {
+  sync_primitives::AutoLock lock(appID_list_lock_);
   appID_list_.insert(std::pair<const int32_t, const uint32_t>
                      (correlation_id, app_id));
 }
@@ -2155,15 +2310,19 @@ void ApplicationManagerImpl::UnregisterAllApplications() {
       unregister_reason_ ==
       mobile_api::AppInterfaceUnregisteredReason::IGNITION_OFF ? true : false;
 
-  std::set<ApplicationSharedPtr>::iterator it = application_list_.begin();
-  while (it != application_list_.end()) {
-    MessageHelper::SendOnAppInterfaceUnregisteredNotificationToMobile(
-      (*it)->app_id(), unregister_reason_);
+  std::set<ApplicationSharedPtr> apps = applications();
+  while (!apps.empty()) {
+    std::set<ApplicationSharedPtr>::iterator it = apps.begin();
+    for (; apps.end() != it; ++it) {
+      MessageHelper::SendOnAppInterfaceUnregisteredNotificationToMobile(
+        (*it)->app_id(), unregister_reason_);
 
-    UnregisterApplication((*it)->app_id(), mobile_apis::Result::INVALID_ENUM,
-                          is_ignition_off);
+      UnregisterApplication((*it)->app_id(), mobile_apis::Result::INVALID_ENUM,
+                            is_ignition_off);
 	PRINTMSG(1, (L"\n%s, line:%d\n", __FUNCTIONW__, __LINE__));
-    it = application_list_.begin();    
+    }
+    // Applications registered meanwhile are unregistered too
+    apps = applications();
   }
   if (is_ignition_off) {
    resume_controller().IgnitionOff();
@@ -2204,17 +2363,21 @@ void ApplicationManagerImpl::UnregisterApplication(
     LOG4CXX_INFO(logger_, "Application is already unregistered.");
     return;
   }
-#ifdef MODIFY_FUNCTION_SIGN
-	// do nothing
-#else
+  resume_ctrl_.StopRestoration(app_id);
+  // Data is saved by every request changing it, here it is either
+  // completed with HMI level or dropped if application is not resumed
   if (is_resuming) {
+#ifndef MODIFY_FUNCTION_SIGN
     resume_ctrl_.SaveApplication(app_to_remove);
-  }
 #endif
-  if (audio_pass_thru_active_) {
+  } else {
+    resume_ctrl_.RemoveApplicationFromSaved(app_to_remove);
+  }
+  if (audio_pass_thru_active()) {
     // May be better to put this code in MessageHelper?
-    end_audio_pass_thru();
+    // Recording is stopped first, its tail is sent while passthru is active
     StopAudioPassThru(app_id);
+    end_audio_pass_thru();
     MessageHelper::SendStopAudioPathThru();
   }
   MessageHelper::SendOnAppUnregNotificationToHMI(app_to_remove);
@@ -2292,8 +2455,9 @@ void ApplicationManagerImpl::Mute(VRTTSSessionChanging changing_state) {
     ? mobile_apis::AudioStreamingState::ATTENUATED
     : mobile_apis::AudioStreamingState::NOT_AUDIBLE;
 
-  std::set<ApplicationSharedPtr>::const_iterator it = application_list_.begin();
-  std::set<ApplicationSharedPtr>::const_iterator itEnd = application_list_.end();
+  const std::set<ApplicationSharedPtr> apps = applications();
+  std::set<ApplicationSharedPtr>::const_iterator it = apps.begin();
+  std::set<ApplicationSharedPtr>::const_iterator itEnd = apps.end();
   for (; it != itEnd; ++it) {
     if ((*it)->is_media_application()) {
       if (kTTSSessionChanging == changing_state) {
@@ -2308,8 +2472,9 @@ void ApplicationManagerImpl::Mute(VRTTSSessionChanging changing_state) {
 }
 
 void ApplicationManagerImpl::Unmute(VRTTSSessionChanging changing_state) {
-  std::set<ApplicationSharedPtr>::const_iterator it = application_list_.begin();
-  std::set<ApplicationSharedPtr>::const_iterator itEnd = application_list_.end();
+  const std::set<ApplicationSharedPtr> apps = applications();
+  std::set<ApplicationSharedPtr>::const_iterator it = apps.begin();
+  std::set<ApplicationSharedPtr>::const_iterator itEnd = apps.end();
   for (; it != itEnd; ++it) {
     if ((*it)->is_media_application()) {
       if (kTTSSessionChanging == changing_state) {
@@ -2329,82 +2494,212 @@ void ApplicationManagerImpl::Unmute(VRTTSSessionChanging changing_state) {
 mobile_apis::Result::eType ApplicationManagerImpl::SaveBinary(
   const std::vector<uint8_t>& binary_data, const std::string& file_path,
   const std::string& file_name, const uint32_t offset) {
+  return SaveBinaryData(binary_data.empty() ? NULL : &binary_data[0],
+                        binary_data.size(), file_path, file_name, offset);
+}
+
+mobile_apis::Result::eType ApplicationManagerImpl::SaveBinary(
+  const BinaryData& binary_data, const std::string& file_path,
+  const std::string& file_name, const uint32_t offset) {
+  return SaveBinaryData(binary_data.data(), binary_data.size(), file_path,
+                        file_name, offset);
+}
+
+mobile_apis::Result::eType ApplicationManagerImpl::SaveBinaryAsync(
+  const BinaryData& binary_data, const std::string& file_path,
+  const std::string& file_name, const uint32_t offset,
+  const uint32_t connection_key, const uint32_t correlation_id,
+  const AppFile* app_file, const std::string& storage_folder) {
   LOG4CXX_INFO(logger_,
-               "SaveBinaryWithOffset  binary_size = " << binary_data.size()
+               "SaveBinaryAsync  binary_size = " << binary_data.size()
                << " offset = " << offset);
 
-  if (binary_data.size() > file_system::GetAvailableDiskSpace(file_path)) {
+  const std::string full_file_path = file_path + "/" + file_name;
+  const mobile_apis::Result::eType result =
+    CheckBinaryData(binary_data.size(), file_path, full_file_path, offset);
+  if (mobile_apis::Result::SUCCESS != result) {
+    return result;
+  }
+
+  FileWrite write;
+  write.connection_key = connection_key;
+  write.correlation_id = correlation_id;
+  if (app_file && 0 == offset) {
+    write.add_file = true;
+    write.file = *app_file;
+  }
+  if (!storage_folder.empty()) {
+    // Earlier chunks of the file may still be queued for writing
+    write.storage_folder = storage_folder;
+    write.old_size = QueuedFileSize(full_file_path);
+    write.new_size = offset + binary_data.size();
+    storage_ledger_.OnWriteQueued(storage_folder, write.old_size,
+                                  write.new_size);
+  }
+
+  // if offset == 0: file is rewritten
+  file_system::AsyncFileIO::instance()->WriteAt(
+    full_file_path, binary_data, offset, file_system::AsyncFileIO::kNoSync,
+    file_system::AsyncFileIO::CompletionPtr(
+      new FileWriteCompletion(this, write)),
+    profile::Profile::instance()->preallocate_files());
+  return mobile_apis::Result::SUCCESS;
+}
+
+void ApplicationManagerImpl::OnFileWritten(const FileWrite& write,
+                                           const std::string& file_name,
+                                           bool success) {
+  mobile_apis::Result::eType result = mobile_apis::Result::SUCCESS;
+  if (!success) {
+    LOG4CXX_ERROR(logger_, "Can't write data to file " << file_name);
+    result = mobile_apis::Result::GENERIC_ERROR;
+  }
+
+  // File is on the storage whether request is still alive or not
+  if (!write.storage_folder.empty()) {
+    storage_ledger_.OnWriteDone(write.storage_folder, write.old_size,
+                                write.new_size, success);
+  }
+  if (success && write.add_file) {
+    AppFile file = write.file;
+    ApplicationSharedPtr app = application(write.connection_key);
+    if (!app) {
+      LOG4CXX_ERROR(logger_, "Application " << write.connection_key
+                    << " is not registered");
+      result = mobile_apis::Result::APPLICATION_NOT_REGISTERED;
+    } else if (app->AddFile(file)) {
+      /* if file added - increment it's count
+       ( may be application->AddFile have to incapsulate it? )
+        Any way now this method evals not only in "none"*/
+      app->increment_put_file_in_none_count();
+    } else {
+      LOG4CXX_INFO(logger_,
+                   "Couldn't add file to application (File already Exist"
+                   << " in application and was rewritten on FS)");
+      /* It can be first part of new big file, so we need to update
+         information about it's downloading status and persistence */
+      if (!app->UpdateFile(file)) {
+        LOG4CXX_INFO(logger_, "Couldn't update file");
+        result = mobile_apis::Result::INVALID_DATA;
+      }
+    }
+    if (app) {
+      resume_ctrl_.OnApplicationDataChanged(app);
+    }
+  }
+
+  // Reference keeps request alive even if it is terminated meanwhile
+  const request_controller::RequestController::Request request =
+    request_ctrl_.findRequest(write.connection_key, write.correlation_id);
+  if (!request) {
+    LOG4CXX_WARN(logger_, "Request " << write.correlation_id
+                 << " of application " << write.connection_key
+                 << " is finished before file is written");
+    return;
+  }
+  static_cast<commands::CommandRequestImpl*>(request.get())->on_file_written(
+    file_name, result);
+}
+
+uint32_t ApplicationManagerImpl::QueuedFileSize(
+  const std::string& full_file_path) {
+  // Previous part of file may be not written yet
+  uint32_t file_size = 0;
+  if (!file_system::AsyncFileIO::instance()->PendingFileSize(full_file_path,
+                                                             &file_size)) {
+    file_size = file_system::FileSize(full_file_path);
+  }
+  return file_size;
+}
+
+mobile_apis::Result::eType ApplicationManagerImpl::CheckBinaryData(
+  uint32_t data_size, const std::string& file_path,
+  const std::string& full_file_path, const uint32_t offset) {
+  if (data_size > file_system::GetAvailableDiskSpace(file_path)) {
     LOG4CXX_ERROR(logger_, "Out of free disc space.");
     return mobile_apis::Result::OUT_OF_MEMORY;
   }
 
-  const std::string full_file_path = file_path + "/" + file_name;
-  uint32_t file_size = file_system::FileSize(full_file_path);
-  std::ofstream* file_stream;
   if (offset != 0) {
-    if (file_size != offset) {
+    if (QueuedFileSize(full_file_path) != offset) {
       LOG4CXX_INFO(logger_,
                    "ApplicationManagerImpl::SaveBinaryWithOffset offset"
                    << " does'n match existing file size");
       return mobile_apis::Result::INVALID_DATA;
     }
-    file_stream = file_system::Open(full_file_path, std::ios_base::app);
   } else {
     LOG4CXX_INFO(
       logger_,
       "ApplicationManagerImpl::SaveBinaryWithOffset offset is 0, rewrite");
-    // if offset == 0: rewrite file
-    file_stream = file_system::Open(full_file_path, std::ios_base::out);
   }
-#ifdef OS_WINCE
-  if (!file_system::Write(file_stream, binary_data._Myfirst,
-                          binary_data.size())) {
-#else
-  if (!file_system::Write(file_stream, binary_data.data(),
-                          binary_data.size())) {
-#endif
-    file_system::Close(file_stream);
+  return mobile_apis::Result::SUCCESS;
+}
+
+mobile_apis::Result::eType ApplicationManagerImpl::SaveBinaryData(
+  const uint8_t* data, uint32_t data_size, const std::string& file_path,
+  const std::string& file_name, const uint32_t offset) {
+  LOG4CXX_INFO(logger_,
+               "SaveBinaryWithOffset  binary_size = " << data_size
+               << " offset = " << offset);
+
+  const std::string full_file_path = file_path + "/" + file_name;
+  const mobile_apis::Result::eType result =
+    CheckBinaryData(data_size, file_path, full_file_path, offset);
+  if (mobile_apis::Result::SUCCESS != result) {
+    return result;
+  }
+
+  // Queued writes of the same file must not be overtaken
+  file_system::AsyncFileIO::instance()->Flush(full_file_path);
+
+  // if offset == 0: file is rewritten
+  if (!file_system::WriteAt(full_file_path, data, data_size, offset,
+                            profile::Profile::instance()->preallocate_files())) {
+    LOG4CXX_ERROR(logger_, "Can't write data to file " << full_file_path);
     return mobile_apis::Result::GENERIC_ERROR;
   }
 
-  file_system::Close(file_stream);
   LOG4CXX_INFO(logger_, "Successfully write data to file");
   return mobile_apis::Result::SUCCESS;
 }
 
 uint32_t ApplicationManagerImpl::GetAvailableSpaceForApp(
-  const std::string& app_name) {
+  const std::string& folder_name) {
   const uint32_t app_quota = profile::Profile::instance()->app_dir_quota();
-  std::string app_storage_path =
-    profile::Profile::instance()->app_storage_folder();
-
-  app_storage_path += "/";
-  app_storage_path += app_name;
+  const uint64_t queued_space = storage_ledger_.QueuedUsage(folder_name);
+  const uint64_t used_space =
+    storage_ledger_.Usage(folder_name) + queued_space;
+  if (app_quota <= used_space) {
+    return 0;
+  }
+  const uint32_t current_app_quota =
+    app_quota - static_cast<uint32_t>(used_space);
 
+  // Quota may be bigger than what is really left on the disk
+  std::string storage_path = profile::Profile::instance()->app_storage_folder();
+  const std::string app_storage_path = storage_path + "/" + folder_name;
   if (file_system::DirectoryExists(app_storage_path)) {
-    uint32_t size_of_directory = file_system::DirectorySize(app_storage_path);
-    if (app_quota < size_of_directory) {
-      return 0;
-    }
-
-    uint32_t current_app_quota = app_quota - size_of_directory;
-    uint32_t available_disk_space =
-      file_system::GetAvailableDiskSpace(app_storage_path);
-
-    if (current_app_quota > available_disk_space) {
-      return available_disk_space;
-    } else {
-      return current_app_quota;
-    }
-  } else {
-    return app_quota;
+    storage_path = app_storage_path;
+  }
+  uint64_t available_disk_space =
+    file_system::GetAvailableDiskSpace(storage_path);
+  // Queued writes are not on the disk yet
+  available_disk_space = available_disk_space > queued_space ?
+                         available_disk_space - queued_space : 0;
+  if (current_app_quota > available_disk_space) {
+    return static_cast<uint32_t>(available_disk_space);
   }
+  return current_app_quota;
 }
 
 bool ApplicationManagerImpl::IsHMICooperating() const {
   return hmi_cooperating_;
 }
 
+void ApplicationManagerImpl::PostHmiTask(StrandExecutor::Task* task) {
+  incoming_messages_.Post(impl::kHmiStrand, task);
+}
+
 #ifdef MODIFY_FUNCTION_SIGN
 ApplicationManagerImpl::AudioPassThruReadFileThread::AudioPassThruReadFileThread(ApplicationManagerImpl* applicationManagerImpl)
 {
@@ -2442,7 +2737,7 @@ void ApplicationManagerImpl::AudioPassThruReadFileThread::threadMain()
 			std::vector<uint8_t> send_data(begin_iter, end_iter);
 			int app_id = applicationManagerImpl_->active_application()->app_id();
 			//LOG4CXX_INFO(logger_, "send data size is " << send_data.size());
-			applicationManagerImpl_->SendAudioPassThroughNotification(app_id, send_data);
+			applicationManagerImpl_->SendAudioPassThroughNotification(app_id, BinaryData::Adopt(&send_data));
 			begin_iter = end_iter;
 			end_iter = data.end() - begin_iter < bytes_per_interval ? data.end() : begin_iter + bytes_per_interval;
 #ifdef OS_WIN32
@@ -88,6 +88,10 @@ void CommandRequestImpl::onTimeOut() {
 void CommandRequestImpl::on_event(const event_engine::Event& event) {
 }
 
+void CommandRequestImpl::on_file_written(const std::string& file_name,
+                                         mobile_apis::Result::eType result) {
+}
+
 void CommandRequestImpl::SendResponse(
     const bool success, const mobile_apis::Result::eType& result_code,
     const char* info, const NsSmart::SmartObject* response_params) {
@@ -62,12 +62,14 @@ void OnSearchAppListNotification::Run() {
   message[strings::params][strings::message_type] =
     static_cast<int32_t>(application_manager::MessageType::kNotification);
   int index = 0;
+  const std::set<ApplicationSharedPtr> apps =
+    ApplicationManagerImpl::instance()->applications();
 #ifdef OS_WINCE
-  for(std::set<ApplicationSharedPtr>::const_iterator it = ApplicationManagerImpl::instance()->applications().begin();
+  for(std::set<ApplicationSharedPtr>::const_iterator it = apps.begin();
 #else
-  for(std::set<ApplicationSharedPtr>::iterator it = ApplicationManagerImpl::instance()->applications().begin();
+  for(std::set<ApplicationSharedPtr>::iterator it = apps.begin();
 #endif
-      it != ApplicationManagerImpl::instance()->applications().end(); it++){
+      it != apps.end(); it++){
     message[strings::msg_params][strings::applications][index][strings::app_name] =
       (*it)->name();
 
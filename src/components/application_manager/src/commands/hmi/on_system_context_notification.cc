@@ -54,7 +54,7 @@ void OnSystemContextNotification::Run() {
   LOG4CXX_INFO(logger_, "OnSystemContextNotification::Run");
 
   ApplicationManagerImpl* app_mgr = ApplicationManagerImpl::instance();
-  const std::set<ApplicationSharedPtr>& app_list = app_mgr->applications();
+  const std::set<ApplicationSharedPtr> app_list = app_mgr->applications();
   std::set<ApplicationSharedPtr>::const_iterator it = app_list.begin();
 
   mobile_api::SystemContext::eType system_context =
@@ -218,11 +218,11 @@ void OnVRStartRecordNotification::RegisterAppCmdId()
 
 void OnVRStartRecordNotification::RegisterAppListId()
 {
-	const std::set<ApplicationSharedPtr>& apps = ApplicationManagerImpl::instance()
+	const std::set<ApplicationSharedPtr> apps = ApplicationManagerImpl::instance()
 		->applications();
 
-	for (std::set<ApplicationSharedPtr>::const_iterator it = ApplicationManagerImpl::instance()->applications().begin();
-		it != ApplicationManagerImpl::instance()->applications().end(); it++){
+	for (std::set<ApplicationSharedPtr>::const_iterator it = apps.begin();
+		it != apps.end(); it++){
 		if ((*it)->vr_synonyms()) {
 			const smart_objects::SmartArray* vr_synonyms = (*it)->vr_synonyms()->asArray();
 			smart_objects::SmartArray::const_iterator it_array =
@@ -193,22 +193,12 @@ bool AddCommandRequest::CheckCommandName(ApplicationConstSharedPtr app) {
     return false;
   }
 
-  const CommandsMap& commands = app->commands_map();
-  CommandsMap::const_iterator i = commands.begin();
-
-  for (; commands.end() != i; ++i) {
-
-    if(!(*i->second).keyExists(strings::menu_params)) {
-      continue;
-    }
-
-    if ((*i->second)[strings::menu_params][strings::menu_name].asString()
-        == (*message_)[strings::msg_params][strings::menu_params]
-                                            [strings::menu_name].asString()) {
-      LOG4CXX_INFO(logger_, "AddCommandRequest::CheckCommandName received"
-                   " command name already exist");
-      return false;
-    }
+  if (app->IsCommandMenuNameAlreadyExist(
+      (*message_)[strings::msg_params][strings::menu_params]
+                                      [strings::menu_name].asString())) {
+    LOG4CXX_INFO(logger_, "AddCommandRequest::CheckCommandName received"
+                 " command name already exist");
+    return false;
   }
   return true;
 }
@@ -218,31 +208,14 @@ bool AddCommandRequest::CheckCommandVRSynonym(ApplicationConstSharedPtr app) {
     return false;
   }
 
-  const CommandsMap& commands = app->commands_map();
-  CommandsMap::const_iterator it = commands.begin();
-
-  for (; commands.end() != it; ++it) {
-
-    if(!(*it->second).keyExists(strings::vr_commands)) {
-      continue;
-    }
+  const smart_objects::SmartObject& vr_commands =
+      (*message_)[strings::msg_params][strings::vr_commands];
 
-    for (size_t i = 0; i < (*it->second)[strings::vr_commands].length(); ++i) {
-      for (size_t j = 0;
-          j < (*message_)[strings::msg_params][strings::vr_commands].length();
-          ++j) {
-        std::string vr_cmd_i =
-            (*it->second)[strings::vr_commands][i].asString();
-        std::string vr_cmd_j =
-            (*message_)[strings::msg_params]
-                        [strings::vr_commands][j].asString();
-
-        if (0 == strcasecmp(vr_cmd_i.c_str(), vr_cmd_j.c_str())) {
-          LOG4CXX_INFO(logger_, "AddCommandRequest::CheckCommandVRSynonym"
-                       " received command vr synonym already exist");
-          return false;
-        }
-      }
+  for (size_t i = 0; i < vr_commands.length(); ++i) {
+    if (app->IsCommandVRSynonymAlreadyExist(vr_commands[i].asString())) {
+      LOG4CXX_INFO(logger_, "AddCommandRequest::CheckCommandVRSynonym"
+                   " received command vr synonym already exist");
+      return false;
     }
   }
   return true;
@@ -377,6 +350,8 @@ void AddCommandRequest::on_event(const event_engine::Event& event) {
           ApplicationManagerImpl::instance()->application(connection_key());
       SendResponse(result, result_code, NULL, &(message[strings::msg_params]));
       application->UpdateHash();
+      ApplicationManagerImpl::instance()->resume_controller().
+          OnApplicationDataChanged(application);
     }
   }
 }
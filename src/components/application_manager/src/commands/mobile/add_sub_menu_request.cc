@@ -124,6 +124,8 @@ void AddSubMenuRequest::on_event(const event_engine::Event& event) {
        }
       SendResponse(result, result_code, NULL, &(message[strings::msg_params]));
       application->UpdateHash();
+      ApplicationManagerImpl::instance()->resume_controller().
+          OnApplicationDataChanged(application);
       break;
     }
     default: {
@@ -34,14 +34,13 @@
 #ifdef MODIFY_FUNCTION_SIGN
 #include <global_first.h>
 #endif
-#include <string.h>
+#include <set>
 #include <string>
-#include <algorithm>
-#include <vector>
 #include "application_manager/commands/mobile/create_interaction_choice_set_request.h"
 #include "application_manager/application_manager_impl.h"
 #include "application_manager/application_impl.h"
 #include "application_manager/message_helper.h"
+#include "application_manager/name_index.h"
 
 namespace application_manager {
 
@@ -113,6 +112,8 @@ void CreateInteractionChoiceSetRequest::Run() {
   SendVRAddCommandRequest(app);
   SendResponse(true, mobile_apis::Result::SUCCESS);
   app->UpdateHash();
+  ApplicationManagerImpl::instance()->resume_controller().
+      OnApplicationDataChanged(app);
 
 #ifdef MODIFY_FUNCTION_SIGN
 	smart_objects::SmartObject msg_params =
@@ -132,143 +133,53 @@ mobile_apis::Result::eType CreateInteractionChoiceSetRequest::CheckChoiceSet(
     ApplicationConstSharedPtr app) {
   LOG4CXX_INFO(logger_, "CreateInteractionChoiceSetRequest::CheckChoiceSet");
 
-  const smart_objects::SmartArray* new_choice_set_array =
-    (*message_)[strings::msg_params][strings::choice_set].asArray();
-
-  smart_objects::SmartArray::const_iterator it_array =
-      new_choice_set_array->begin();
-
-  smart_objects::SmartArray::const_iterator it_array_end =
-      new_choice_set_array->end();
-
-  // Self check of new choice set for params coincidence
-  for (; it_array != it_array_end; ++it_array) {
-    const smart_objects::SmartArray* vr_array =
-        (*it_array)[strings::vr_commands].asArray();
-
-    CoincidencePredicateChoiceID c((*it_array)[strings::choice_id].asInt());
-    if (1 != std::count_if(
-        new_choice_set_array->begin(),
-        new_choice_set_array->end(),
-        c)) {
+  const smart_objects::SmartObject& new_choice_set =
+      (*message_)[strings::msg_params][strings::choice_set];
 
+  // Choice IDs must be unique among incoming choices and
+  // all choices of already registered choice sets
+  std::set<int32_t> choice_ids;
+  for (size_t i = 0; i < new_choice_set.length(); ++i) {
+    const int32_t choice_id = new_choice_set[i][strings::choice_id].asInt();
+    if (!choice_ids.insert(choice_id).second) {
       LOG4CXX_ERROR(logger_, "Incoming choice set has duplicate IDs.");
       return mobile_apis::Result::INVALID_ID;
     }
-
-    // Check new choice set params along with already registered choice sets
-    const ChoiceSetMap& app_choice_set_map = app->choice_set_map();
-    ChoiceSetMap::const_iterator it = app_choice_set_map.begin();
-    ChoiceSetMap::const_iterator itEnd = app_choice_set_map.end();
-    for (; it != itEnd; ++it) {
-      const smart_objects::SmartObject* app_choice_set = it->second;
-      if (NULL != app_choice_set) {
-
-        const smart_objects::SmartArray* curr_choice_set =
-            (*app_choice_set)[strings::choice_set].asArray();
-
-        if (0 != std::count_if(
-            curr_choice_set->begin(),
-            curr_choice_set->end(),
-            c)) {
-          LOG4CXX_ERROR(logger_, "Incoming choice ID already exists.");
-          return mobile_apis::Result::INVALID_ID;
-        }
-      }
+    if (app->IsChoiceIdAlreadyExist(choice_id)) {
+      LOG4CXX_ERROR(logger_, "Incoming choice ID already exists.");
+      return mobile_apis::Result::INVALID_ID;
     }
+  }
 
-#ifdef OS_WIN32
-		std::string &it_menu_name = (*it_array)[strings::menu_name].asString();
-		CoincidencePredicateMenuName m(it_menu_name);
-#else
-    CoincidencePredicateMenuName m((*it_array)[strings::menu_name].asString());
-#endif
-    if (1 != std::count_if(
-        new_choice_set_array->begin(),
-        new_choice_set_array->end(),
-        m)) {
-
+  // Menu names are compared exactly, VR synonyms ignoring case,
+  // both inside one choice and across choices of the new set
+  NameIndex menu_names(NameIndex::kCaseSensitive);
+  NameIndex vr_synonyms(NameIndex::kCaseInsensitive);
+  for (size_t i = 0; i < new_choice_set.length(); ++i) {
+    const std::string menu_name =
+        new_choice_set[i][strings::menu_name].asString();
+    if (menu_names.Contains(menu_name)) {
       LOG4CXX_ERROR(logger_, "Incoming choice set has duplicate menu names.");
       return mobile_apis::Result::DUPLICATE_NAME;
     }
-
-    // Check coincidence inside the current choice
-
-    smart_objects::SmartArray::const_iterator it_vr = vr_array->begin();
-    smart_objects::SmartArray::const_iterator it_vr_end = vr_array->end();
-
-    for (; it_vr != it_vr_end; ++it_vr) {
-      CoincidencePredicateVRCommands v((*it_vr));
-      if (1 != std::count_if(vr_array->begin(), vr_array->end(), v)) {
-
-        LOG4CXX_ERROR(logger_,
-                      "Incoming choice set has duplicate VR command(s)");
-
-        return mobile_apis::Result::DUPLICATE_NAME;
-      }
-    }
-
-    // Check along with VR commands in other choices in the new set
-    smart_objects::SmartArray::const_iterator it_same_array =
-        new_choice_set_array->begin();
-
-    smart_objects::SmartArray::const_iterator it_same_array_end =
-        new_choice_set_array->end();
-
-    for (; it_same_array != it_same_array_end; ++it_same_array) {
-
-      // Skip check for itself
-      if ((*it_array)[strings::choice_id] ==
-          (*it_same_array)[strings::choice_id]) {
-
-        continue;
-      }
-
-      if (compareSynonyms((*it_array), (*it_same_array))) {
-
-        LOG4CXX_ERROR(logger_,
-                      "Incoming choice set has duplicate VR command(s).");
-
+    menu_names.Add(menu_name);
+
+    const smart_objects::SmartObject& vr_commands =
+        new_choice_set[i][strings::vr_commands];
+    for (size_t j = 0; j < vr_commands.length(); ++j) {
+      const std::string vr_synonym = vr_commands[j].asString();
+      if (vr_synonyms.Contains(vr_synonym)) {
+        LOG4CXX_ERROR(logger_, "Incoming choice set has duplicated VR synonyms "
+                      << vr_synonym);
         return mobile_apis::Result::DUPLICATE_NAME;
       }
+      vr_synonyms.Add(vr_synonym);
     }
   }
 
   return mobile_apis::Result::SUCCESS;
 }
 
-bool CreateInteractionChoiceSetRequest::compareSynonyms(
-    const NsSmartDeviceLink::NsSmartObjects::SmartObject& choice1,
-    const NsSmartDeviceLink::NsSmartObjects::SmartObject& choice2) {
-
-  smart_objects::SmartArray* vr_cmds_1 =
-      choice1[strings::vr_commands].asArray();
-  DCHECK(vr_cmds_1 != NULL);
-  smart_objects::SmartArray* vr_cmds_2 =
-      choice2[strings::vr_commands].asArray();
-  DCHECK(vr_cmds_2 != NULL);
-
-  smart_objects::SmartArray::iterator it;
-  it = std::find_first_of(vr_cmds_1->begin(), vr_cmds_1->end(),
-                          vr_cmds_2->begin(), vr_cmds_2->end(),
-                          CreateInteractionChoiceSetRequest::compareStr);
-
-
-  if (it != vr_cmds_1->end()) {
-    LOG4CXX_INFO(logger_, "Incoming choice set has duplicated VR synonyms "
-                 << it->asString());
-    return true;
-  }
-
-  return false;
-}
-
-bool CreateInteractionChoiceSetRequest::compareStr(
-    const NsSmartDeviceLink::NsSmartObjects::SmartObject& str1,
-    const NsSmartDeviceLink::NsSmartObjects::SmartObject& str2) {
-  return 0 == strcasecmp(str1.asCharArray(), str2.asCharArray());
-}
-
 void CreateInteractionChoiceSetRequest::SendVRAddCommandRequest(
     application_manager::ApplicationSharedPtr const app) {
 
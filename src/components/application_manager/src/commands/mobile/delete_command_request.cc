@@ -163,6 +163,8 @@ void DeleteCommandRequest::on_event(const event_engine::Event& event) {
       if (result) {
         application->RemoveCommand(
           (*message_)[strings::msg_params][strings::cmd_id].asInt());
+        ApplicationManagerImpl::instance()->resume_controller().
+            OnApplicationDataChanged(application);
       }
 
       if (!result && (hmi_apis::Common_Result::REJECTED == ui_result_)) {
@@ -83,13 +83,18 @@ void DeleteFileRequest::Run() {
   full_file_path += sync_file_name;
 
   if (file_system::FileExists(full_file_path)) {
+    const uint32_t file_size = file_system::FileSize(full_file_path);
     if (file_system::DeleteFile(full_file_path)) {
+      ApplicationManagerImpl::instance()->storage_ledger().OnFileChanged(
+          application->folder_name(), file_size, 0);
       const AppFile* file = application->GetFile(full_file_path);
       if (file) {
         SendFileRemovedNotification(file);
       }
 
       application->DeleteFile(full_file_path);
+      ApplicationManagerImpl::instance()->resume_controller().
+          OnApplicationDataChanged(application);
       application->increment_delete_file_in_none_count();
       SendResponse(true, mobile_apis::Result::SUCCESS);
     } else {
@@ -88,6 +88,8 @@ void DeleteInteractionChoiceSetRequest::Run() {
   msg_params[strings::app_id] = app->app_id();
 
   app->RemoveChoiceSet(choise_set_id);
+  ApplicationManagerImpl::instance()->resume_controller().
+      OnApplicationDataChanged(app);
 
   SendResponse(true, mobile_apis::Result::SUCCESS);
 #ifdef MODIFY_FUNCTION_SIGN
@@ -105,15 +107,12 @@ bool DeleteInteractionChoiceSetRequest::ChoiceSetInUse(ApplicationConstSharedPtr
     const PerformChoiceSetMap& choice_set_map = app
         ->performinteraction_choice_set_map();
 
-    PerformChoiceSetMap::const_iterator it = choice_set_map.begin();
-    for (; choice_set_map.end() != it; ++it) {
-      if (it->first
-          == (*message_)[strings::msg_params]
-                         [strings::interaction_choice_set_id].asInt()) {
-        LOG4CXX_ERROR_EXT(logger_,
-                          "DeleteInteractionChoiceSetRequest::ChoiceSetInUse");
-        return true;
-      }
+    if (choice_set_map.end() != choice_set_map.find(
+        (*message_)[strings::msg_params]
+                    [strings::interaction_choice_set_id].asUInt())) {
+      LOG4CXX_ERROR_EXT(logger_,
+                        "DeleteInteractionChoiceSetRequest::ChoiceSetInUse");
+      return true;
     }
   }
   return false;
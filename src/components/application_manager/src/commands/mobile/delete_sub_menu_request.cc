@@ -164,6 +164,8 @@ void DeleteSubMenuRequest::on_event(const event_engine::Event& event) {
         DeleteSubMenuUICommands(application);
         application->RemoveSubMenu(
             (*message_)[strings::msg_params][strings::menu_id].asInt());
+        ApplicationManagerImpl::instance()->resume_controller().
+            OnApplicationDataChanged(application);
        }
 
       SendResponse(result, result_code, NULL, &(message[strings::msg_params]));
@@ -51,16 +51,19 @@ EndAudioPassThruRequest::~EndAudioPassThruRequest() {
 
 void EndAudioPassThruRequest::Run() {
   LOG4CXX_INFO(logger_, "EndAudioPassThruRequest::Run");
-  bool ended_successfully =
-      ApplicationManagerImpl::instance()->end_audio_pass_thru();
-
-  if (ended_successfully) {
-    SendHMIRequest(hmi_apis::FunctionID::UI_EndAudioPassThru, NULL, true);
 #ifdef MODIFY_FUNCTION_SIGN
 		// do nothing
 #else
+  // Recording is stopped first, its tail is sent while passthru is active
+  if (ApplicationManagerImpl::instance()->audio_pass_thru_active()) {
     ApplicationManagerImpl::instance()->StopAudioPassThru(connection_key());
+  }
 #endif
+  bool ended_successfully =
+      ApplicationManagerImpl::instance()->end_audio_pass_thru();
+
+  if (ended_successfully) {
+    SendHMIRequest(hmi_apis::FunctionID::UI_EndAudioPassThru, NULL, true);
   } else {
     SendResponse(false, mobile_apis::Result::REJECTED,
                  "No PerformAudioPassThru is now active");
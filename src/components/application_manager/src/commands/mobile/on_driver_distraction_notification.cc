@@ -56,7 +56,7 @@ OnDriverDistractionNotification::~OnDriverDistractionNotification() {
 void OnDriverDistractionNotification::Run() {
   LOG4CXX_INFO(logger_, "OnDriverDistractionNotification::Run");
 
-  const std::set<ApplicationSharedPtr>& applications =
+  const std::set<ApplicationSharedPtr> applications =
       ApplicationManagerImpl::instance()->applications();
 
 #ifdef OS_WINCE
@@ -122,13 +122,15 @@ void PerformAudioPassThruRequest::on_event(const event_engine::Event& event) {
         return_info = "Unsupported phoneme type sent in a prompt";
       }
 
-      if (ApplicationManagerImpl::instance()->end_audio_pass_thru()) {
 #ifdef MODIFY_FUNCTION_SIGN
 	// do nothing
 #else
+      // Recording is stopped first, its tail is sent while passthru is active
+      if (ApplicationManagerImpl::instance()->audio_pass_thru_active()) {
         ApplicationManagerImpl::instance()->StopAudioPassThru(connection_key());
-#endif
       }
+#endif
+      ApplicationManagerImpl::instance()->end_audio_pass_thru();
 
 
 #ifdef MODIFY_FUNCTION_SIGN
@@ -40,6 +40,7 @@
 #include "application_manager/application_manager_impl.h"
 #include "application_manager/application_impl.h"
 #include "application_manager/message_helper.h"
+#include "application_manager/name_index.h"
 #include "config_profile/profile.h"
 #include "interfaces/MOBILE_API.h"
 #include "interfaces/HMI_API.h"
@@ -595,45 +596,32 @@ bool PerformInteractionRequest::CheckChoiceSetMenuNames(
   smart_objects::SmartObject& choice_list =
       (*message_)[strings::msg_params][strings::interaction_choice_set_id_list];
 
+  // Names of choice sets already walked, each set is unique by itself
+  // so it is checked against previous sets only
+  NameIndex menu_names(NameIndex::kCaseSensitive);
   for (size_t i = 0; i < choice_list.length(); ++i) {
     // choice_set contains SmartObject msg_params
-    smart_objects::SmartObject* i_choice_set = app->FindChoiceSet(
+    smart_objects::SmartObject* choice_set = app->FindChoiceSet(
         choice_list[i].asInt());
 
-    for (size_t j = 0; j < choice_list.length(); ++j) {
-      smart_objects::SmartObject* j_choice_set = app->FindChoiceSet(
-          choice_list[j].asInt());
-
-      if (i == j) {
-        // skip check the same element
-        continue;
-      }
+    if (!choice_set) {
+      LOG4CXX_ERROR(logger_, "Invalid ID");
+      SendResponse(false, mobile_apis::Result::INVALID_ID);
+      return false;
+    }
 
-      if (!i_choice_set || !j_choice_set) {
-        LOG4CXX_ERROR(logger_, "Invalid ID");
-        SendResponse(false, mobile_apis::Result::INVALID_ID);
+    const smart_objects::SmartObject& choices =
+        (*choice_set)[strings::choice_set];
+    for (size_t ii = 0; ii < choices.length(); ++ii) {
+      if (menu_names.Contains(choices[ii][strings::menu_name].asString())) {
+        LOG4CXX_ERROR(logger_, "Choice set has duplicated menu name");
+        SendResponse(false, mobile_apis::Result::DUPLICATE_NAME,
+                     "Choice set has duplicated menu name");
         return false;
       }
-
-      size_t ii = 0;
-      size_t jj = 0;
-      for (; ii < (*i_choice_set)[strings::choice_set].length(); ++ii) {
-        for (; jj < (*j_choice_set)[strings::choice_set].length(); ++jj) {
-          std::string ii_menu_name =
-              (*i_choice_set)[strings::choice_set][ii][strings::menu_name]
-                  .asString();
-          std::string jj_menu_name =
-              (*j_choice_set)[strings::choice_set][jj][strings::menu_name]
-                  .asString();
-
-          if (ii_menu_name == jj_menu_name) {
-            LOG4CXX_ERROR(logger_, "Choice set has duplicated menu name");
-            SendResponse(false, mobile_apis::Result::DUPLICATE_NAME,
-                         "Choice set has duplicated menu name");
-            return false;
-          }
-        }
-      }
+    }
+    for (size_t ii = 0; ii < choices.length(); ++ii) {
+      menu_names.Add(choices[ii][strings::menu_name].asString());
     }
   }
 
@@ -645,52 +633,39 @@ bool PerformInteractionRequest::CheckChoiceSetVRSynonyms(
   smart_objects::SmartObject& choice_list =
       (*message_)[strings::msg_params][strings::interaction_choice_set_id_list];
 
+  NameIndex vr_synonyms(NameIndex::kCaseInsensitive);
   for (size_t i = 0; i < choice_list.length(); ++i) {
     // choice_set contains SmartObject msg_params
-    smart_objects::SmartObject* i_choice_set = app->FindChoiceSet(
+    smart_objects::SmartObject* choice_set = app->FindChoiceSet(
         choice_list[i].asInt());
 
-    for (size_t j = 0; j < choice_list.length(); ++j) {
-      smart_objects::SmartObject* j_choice_set = app->FindChoiceSet(
-          choice_list[j].asInt());
-
-      if (i == j) {
-        // skip check the same element
-        continue;
-      }
-
-      if ((!i_choice_set) || (!j_choice_set)) {
-        LOG4CXX_ERROR(logger_, "Invalid ID");
-        SendResponse(false, mobile_apis::Result::INVALID_ID);
-        return false;
-      }
+    if (!choice_set) {
+      LOG4CXX_ERROR(logger_, "Invalid ID");
+      SendResponse(false, mobile_apis::Result::INVALID_ID);
+      return false;
+    }
 
-      size_t ii = 0;
-      size_t jj = 0;
-      for (; ii < (*i_choice_set)[strings::choice_set].length(); ++ii) {
-        for (; jj < (*j_choice_set)[strings::choice_set].length(); ++jj) {
-          // choice_set pointer contains SmartObject msg_params
-          smart_objects::SmartObject& ii_vr_commands =
-              (*i_choice_set)[strings::choice_set][ii][strings::vr_commands];
-
-          smart_objects::SmartObject& jj_vr_commands =
-              (*j_choice_set)[strings::choice_set][jj][strings::vr_commands];
-
-          for (size_t iii = 0; iii < ii_vr_commands.length(); ++iii) {
-            for (size_t jjj = 0; jjj < jj_vr_commands.length(); ++jjj) {
-              std::string vr_cmd_i = ii_vr_commands[iii].asString();
-              std::string vr_cmd_j = jj_vr_commands[jjj].asString();
-              if (0 == strcasecmp(vr_cmd_i.c_str(), vr_cmd_j.c_str())) {
-                LOG4CXX_ERROR(logger_, "Choice set has duplicated VR synonym");
-                SendResponse(false, mobile_apis::Result::DUPLICATE_NAME,
-                             "Choice set has duplicated VR synonym");
-                return false;
-              }
-            }
-          }
+    const smart_objects::SmartObject& choices =
+        (*choice_set)[strings::choice_set];
+    for (size_t ii = 0; ii < choices.length(); ++ii) {
+      const smart_objects::SmartObject& vr_commands =
+          choices[ii][strings::vr_commands];
+      for (size_t iii = 0; iii < vr_commands.length(); ++iii) {
+        if (vr_synonyms.Contains(vr_commands[iii].asString())) {
+          LOG4CXX_ERROR(logger_, "Choice set has duplicated VR synonym");
+          SendResponse(false, mobile_apis::Result::DUPLICATE_NAME,
+                       "Choice set has duplicated VR synonym");
+          return false;
         }
       }
     }
+    for (size_t ii = 0; ii < choices.length(); ++ii) {
+      const smart_objects::SmartObject& vr_commands =
+          choices[ii][strings::vr_commands];
+      for (size_t iii = 0; iii < vr_commands.length(); ++iii) {
+        vr_synonyms.Add(vr_commands[iii].asString());
+      }
+    }
   }
 
   return true;
@@ -51,7 +51,8 @@ PutFileRequest::PutFileRequest(const MessageSharedPtr& message)
   , sync_file_name_()
   , length_(0)
   , file_type_(mobile_apis::FileType::INVALID_ENUM)
-  , is_persistent_file_(false) {
+  , is_persistent_file_(false)
+  , is_system_file_(false) {
 }
 
 PutFileRequest::~PutFileRequest() {
@@ -113,20 +114,22 @@ void PutFileRequest::Run() {
   file_type_ =
     static_cast<mobile_apis::FileType::eType>(
       (*message_)[strings::msg_params][strings::file_type].asInt());
-  const std::vector<uint8_t> binary_data =
-    (*message_)[strings::params][strings::binary_data].asBinary();
+  // Data is shared with incoming message, it is not copied until
+  // it is written to the file
+  const BinaryData binary_data =
+    (*message_)[strings::params][strings::binary_data].asBinaryBuffer();
 
   // Policy table update in json format is currently to be received via PutFile
   // TODO(PV): after latest discussion has to be changed
   if (mobile_apis::FileType::JSON == file_type_) {
-    policy::PolicyHandler::instance()->ReceiveMessageFromSDK(sync_file_name_, binary_data);
+    policy::PolicyHandler::instance()->ReceiveMessageFromSDK(
+        sync_file_name_, binary_data.ToVector());
   }
 
   offset_ = 0;
   is_persistent_file_ = false;
-  bool is_system_file = false;
+  is_system_file_ = false;
   length_ = binary_data.size();
-  bool is_download_compleate = true;
   bool offset_exist =
       (*message_)[strings::msg_params].keyExists(strings::offset);
 
@@ -141,25 +144,25 @@ void PutFileRequest::Run() {
   }
   if ((*message_)[strings::msg_params].
       keyExists(strings::system_file)) {
-    is_system_file =
+    is_system_file_ =
       (*message_)[strings::msg_params][strings::system_file].asBool();
   }
 
   std::string file_path;
 
-  if (is_system_file) {
+  if (is_system_file_) {
     response_params[strings::space_available] = 0;
     file_path = profile::Profile::instance()->system_files_path();
   } else {
 
     response_params[strings::space_available] = static_cast<int32_t>(
-        ApplicationManagerImpl::instance()->GetAvailableSpaceForApp(application->name()));
+        ApplicationManagerImpl::instance()->GetAvailableSpaceForApp(application->folder_name()));
 
     file_path = profile::Profile::instance()->app_storage_folder();
     file_path += "/" + application->folder_name();
 
     if (binary_data.size() >
-      ApplicationManagerImpl::instance()->GetAvailableSpaceForApp(application->name())) {
+      ApplicationManagerImpl::instance()->GetAvailableSpaceForApp(application->folder_name())) {
       LOG4CXX_ERROR(logger_, "Out of memory");
       SendResponse(false, mobile_apis::Result::OUT_OF_MEMORY,
                    "Out of memory",
@@ -176,52 +179,54 @@ void PutFileRequest::Run() {
     return;
   }
 
+  const std::string file_name = sync_file_name_;
+  sync_file_name_ = file_path + "/" + sync_file_name_;
+  const bool is_download_compleate = true;
+  const AppFile file(sync_file_name_, is_persistent_file_,
+                     is_download_compleate, file_type_);
+
+  // File is recorded in application once it is written, response is sent
+  // from on_file_written then
   mobile_apis::Result::eType save_result =
-      ApplicationManagerImpl::instance()->SaveBinary(binary_data, file_path,
-                                                     sync_file_name_, offset_);
+      ApplicationManagerImpl::instance()->SaveBinaryAsync(
+          binary_data, file_path, file_name, offset_,
+          connection_key(), correlation_id(), &file,
+          is_system_file_ ? std::string() : application->folder_name());
+
+  if (mobile_apis::Result::SUCCESS != save_result) {
+    LOG4CXX_INFO(logger_, "Save in unsuccessful. Result = " << save_result);
+    SendResponse(false, save_result, "Can't save file", &response_params);
+    return;
+  }
+  response_params_ = response_params;
+}
 
-  sync_file_name_ = file_path + "/" + sync_file_name_;
-  switch (save_result) {
-    case mobile_apis::Result::SUCCESS: {
-      AppFile file(sync_file_name_, is_persistent_file_,
-                   is_download_compleate, file_type_);
-
-      if (0 == offset_) {
-        LOG4CXX_INFO(logger_, "New file downloading");
-        if (!application->AddFile(file)) {
-
-          LOG4CXX_INFO(logger_,
-                       "Couldn't add file to application (File already Exist"
-                       << " in application and was rewritten on FS)");
-          /* It can be first part of new big file, so we need to update
-             information about it's downloading status and persistence */
-          if (!application->UpdateFile(file)) {
-            LOG4CXX_INFO(logger_, "Couldn't update file");
-            /* If it is impossible to update file, application doesn't
-            know about existing this file */
-            SendResponse(false, mobile_apis::Result::INVALID_DATA,
-                         "Couldn't update file",
-                         &response_params);
-            return;
-          }
-        } else {
-          /* if file added - increment it's count
-           ( may be application->AddFile have to incapsulate it? )
-            Any way now this method evals not only in "none"*/
-          application->increment_put_file_in_none_count();
-        }
-      }
-
-      SendResponse(true, save_result, "File was downloaded", &response_params);
-      if (is_system_file) {
-        SendOnPutFileNotification();
-      }
+void PutFileRequest::on_file_written(const std::string& file_name,
+                                     mobile_apis::Result::eType result) {
+  LOG4CXX_INFO(logger_, "PutFileRequest::on_file_written");
+
+  switch (result) {
+    case mobile_apis::Result::SUCCESS:
       break;
-    }
+    case mobile_apis::Result::APPLICATION_NOT_REGISTERED:
+      LOG4CXX_ERROR(logger_, "Application is not registered");
+      SendResponse(false, result);
+      return;
+    case mobile_apis::Result::INVALID_DATA:
+      /* If it is impossible to update file, application doesn't
+      know about existing this file */
+      SendResponse(false, result, "Couldn't update file", &response_params_);
+      return;
     default:
-      LOG4CXX_INFO(logger_, "Save in unsuccessful. Result = " << save_result);
-      SendResponse(false, save_result, "Can't save file", &response_params);
-      break;
+      LOG4CXX_INFO(logger_, "Save in unsuccessful. Result = " << result);
+      SendResponse(false, result, "Can't save file", &response_params_);
+      return;
+  }
+
+  SendResponse(true, mobile_apis::Result::SUCCESS, "File was downloaded",
+               &response_params_);
+  if (is_system_file_) {
+    SendOnPutFileNotification();
   }
 }
 
@@ -148,10 +148,13 @@ void RegisterAppInterfaceRequest::Run() {
     return;
   }
 
+  const std::set<ApplicationSharedPtr> applications =
+    ApplicationManagerImpl::instance()->applications();
+
 #ifdef MODIFY_FUNCTION_SIGN
 	//
 #else
-  if (IsApplicationWithSameAppIdRegistered()) {
+  if (IsApplicationWithSameAppIdRegistered(applications)) {
     SendResponse(false, mobile_apis::Result::INVALID_DATA);
     return;
   }
@@ -165,7 +168,7 @@ void RegisterAppInterfaceRequest::Run() {
   }
 
   mobile_apis::Result::eType coincidence_result =
-    CheckCoincidence();
+    CheckCoincidence(applications);
 
   if (mobile_apis::Result::SUCCESS != coincidence_result) {
     LOG4CXX_ERROR_EXT(logger_, "Coincidence check failed.");
@@ -183,8 +186,10 @@ void RegisterAppInterfaceRequest::Run() {
   const smart_objects::SmartObject& msg_params =
     (*message_)[strings::msg_params];
 
+  // Checks above are repeated by Validate under applications list lock,
+  // since other application may have registered meanwhile
   ApplicationSharedPtr app =
-    ApplicationManagerImpl::instance()->RegisterApplication(message_);
+    ApplicationManagerImpl::instance()->RegisterApplication(message_, this);
 
   if (!app) {
     LOG4CXX_ERROR_EXT(logger_, "Application " <<
@@ -207,19 +212,11 @@ void RegisterAppInterfaceRequest::Run() {
     app->set_is_media_application(
       msg_params[strings::is_media_application].asBool());
 
-    if (msg_params.keyExists(strings::vr_synonyms)) {
-      app->set_vr_synonyms(msg_params[strings::vr_synonyms]);
-    }
-
     if (msg_params.keyExists(strings::ngn_media_screen_app_name)) {
       app->set_ngn_media_screen_name(
         msg_params[strings::ngn_media_screen_app_name]);
     }
 
-    if (msg_params.keyExists(strings::tts_name)) {
-      app->set_tts_name(msg_params[strings::tts_name]);
-    }
-
     if (msg_params.keyExists(strings::app_hmi_type)) {
       app->set_app_types(msg_params[strings::app_hmi_type]);
 
@@ -481,17 +478,31 @@ void RegisterAppInterfaceRequest::SendRegisterAppInterfaceResponseToMobile(
   }
 }
 
+mobile_apis::Result::eType RegisterAppInterfaceRequest::Validate(
+    const std::set<ApplicationSharedPtr>& applications) const {
+  std::set<ApplicationSharedPtr>::const_iterator it = applications.begin();
+  for (; applications.end() != it; ++it) {
+    if (connection_key() == (*it)->app_id()) {
+      return mobile_apis::Result::APPLICATION_REGISTERED_ALREADY;
+    }
+  }
+#ifndef MODIFY_FUNCTION_SIGN
+  if (IsApplicationWithSameAppIdRegistered(applications)) {
+    return mobile_apis::Result::INVALID_DATA;
+  }
+#endif
+  return CheckCoincidence(applications);
+}
+
 mobile_apis::Result::eType
-RegisterAppInterfaceRequest::CheckCoincidence() {
+RegisterAppInterfaceRequest::CheckCoincidence(
+    const std::set<ApplicationSharedPtr>& applications) const {
 
   LOG4CXX_INFO(logger_, "RegisterAppInterfaceRequest::CheckCoincidence ");
 
   const smart_objects::SmartObject& msg_params =
     (*message_)[strings::msg_params];
 
-  ApplicationManagerImpl* app_manager = ApplicationManagerImpl::instance();
-
-  const std::set<ApplicationSharedPtr>& applications = app_manager->applications();
   std::set<ApplicationSharedPtr>::const_iterator it = applications.begin();
   const std::string app_name = msg_params[strings::app_name].asString();
 
@@ -854,7 +865,8 @@ RegisterAppInterfaceRequest::ClearParamName(std::string param_name) const {
   return std::string(param_name.begin(), param_name_new_end);
 }
 
-bool RegisterAppInterfaceRequest::IsApplicationWithSameAppIdRegistered() {
+bool RegisterAppInterfaceRequest::IsApplicationWithSameAppIdRegistered(
+    const std::set<ApplicationSharedPtr>& applications) const {
 
   LOG4CXX_INFO(logger_, "RegisterAppInterfaceRequest::"
                "IsApplicationWithSameAppIdRegistered");
@@ -862,9 +874,6 @@ bool RegisterAppInterfaceRequest::IsApplicationWithSameAppIdRegistered() {
   const std::string mobile_app_id = (*message_)[strings::msg_params]
                                     [strings::app_id].asString();
 
-  const std::set<ApplicationSharedPtr>& applications =
-    ApplicationManagerImpl::instance()->applications();
-
   std::set<ApplicationSharedPtr>::const_iterator it = applications.begin();
   std::set<ApplicationSharedPtr>::const_iterator it_end = applications.end();
 
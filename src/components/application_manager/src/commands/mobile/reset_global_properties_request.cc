@@ -342,6 +342,8 @@ void ResetGlobalPropertiesRequest::on_event(const event_engine::Event& event) {
     SendResponse(result, static_cast<mobile_apis::Result::eType>(result_code),
                      return_info, &(message[strings::msg_params]));
     application->UpdateHash();
+    ApplicationManagerImpl::instance()->resume_controller().
+        OnApplicationDataChanged(application);
   }
 }
 
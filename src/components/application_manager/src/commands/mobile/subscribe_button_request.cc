@@ -76,6 +76,8 @@ void SubscribeButtonRequest::Run() {
   SendResponse(true, mobile_apis::Result::SUCCESS);
 
   app->UpdateHash();
+  ApplicationManagerImpl::instance()->resume_controller().
+      OnApplicationDataChanged(app);
 
 #ifdef MODIFY_FUNCTION_SIGN
 	smart_objects::SmartObject msg_params =
@@ -148,6 +148,8 @@ void SubscribeVehicleDataRequest::Run() {
                  "Already subscribed on provided VehicleData");
     return;
   }
+  ApplicationManagerImpl::instance()->resume_controller().
+      OnApplicationDataChanged(app);
 #ifdef MODIFY_FUNCTION_SIGN
   SendResponse(true, mobile_apis::Result::SUCCESS,
                 "Subscribed on provided VehicleData", &response_params);
@@ -78,9 +78,10 @@ void SystemRequest::Run() {
       return;
   }
 
-  std::vector<uint8_t> binary_data;
+  BinaryData binary_data;
   if ((*message_)[strings::params].keyExists(strings::binary_data)) {
-    binary_data = (*message_)[strings::params][strings::binary_data].asBinary();
+    binary_data =
+        (*message_)[strings::params][strings::binary_data].asBinaryBuffer();
   }
 
   std::string file_path = profile::Profile::instance()->system_files_path();
@@ -97,19 +98,50 @@ void SystemRequest::Run() {
 
   std::string full_file_path = file_path + "/" + file_name;
   if (binary_data.size()) {
+    // HMI is notified from on_file_written once data is on the storage
     if (mobile_apis::Result::SUCCESS  !=
-        (ApplicationManagerImpl::instance()->SaveBinary(
-            binary_data, file_path, file_name, 0))) {
-      SendResponse(false, mobile_apis::Result::GENERIC_ERROR);
-      return;
-    }
-  } else {
-    if (!(file_system::CreateFile(full_file_path))) {
+        (ApplicationManagerImpl::instance()->SaveBinaryAsync(
+            binary_data, file_path, file_name, 0,
+            connection_key(), correlation_id()))) {
       SendResponse(false, mobile_apis::Result::GENERIC_ERROR);
       return;
     }
+    file_name_ = file_name;
+    return;
   }
 
+  if (!(file_system::CreateFile(full_file_path))) {
+    SendResponse(false, mobile_apis::Result::GENERIC_ERROR);
+    return;
+  }
+  SendSystemRequestToHMI(file_name, full_file_path);
+}
+
+void SystemRequest::on_file_written(const std::string& file_name,
+                                    mobile_apis::Result::eType result) {
+  LOG4CXX_INFO(logger_, "SystemRequest::on_file_written");
+  if (mobile_apis::Result::SUCCESS != result) {
+    SendResponse(false, mobile_apis::Result::GENERIC_ERROR);
+    return;
+  }
+  SendSystemRequestToHMI(file_name_, file_name);
+}
+
+void SystemRequest::SendSystemRequestToHMI(const std::string& file_name,
+                                           const std::string& full_file_path) {
+  ApplicationSharedPtr application =
+      ApplicationManagerImpl::instance()->application(connection_key());
+
+  if (!(application.valid())) {
+    LOG4CXX_ERROR(logger_, "NULL pointer");
+    SendResponse(false, mobile_apis::Result::APPLICATION_NOT_REGISTERED);
+    return;
+  }
+
+  mobile_apis::RequestType::eType request_type =
+      static_cast<mobile_apis::RequestType::eType>(
+          (*message_)[strings::msg_params][strings::request_type].asInt());
+
   smart_objects::SmartObject msg_params = smart_objects::SmartObject(
       smart_objects::SmartType_Map);
   if (file_name == "IVSU") {
@@ -124,7 +156,6 @@ void SystemRequest::Run() {
                                                   [strings::request_type];
   SendHMIRequest(hmi_apis::FunctionID::BasicCommunication_SystemRequest,
                  &msg_params, true);
-
 }
 
 void SystemRequest::on_event(const event_engine::Event& event) {
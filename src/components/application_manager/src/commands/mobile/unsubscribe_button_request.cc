@@ -74,6 +74,8 @@ void UnsubscribeButtonRequest::Run() {
   }
 
   app->UnsubscribeFromButton(static_cast<mobile_apis::ButtonName::eType>(btn_id));
+  ApplicationManagerImpl::instance()->resume_controller().
+      OnApplicationDataChanged(app);
   SendResponse(true, mobile_apis::Result::SUCCESS);
 
 #ifdef MODIFY_FUNCTION_SIGN
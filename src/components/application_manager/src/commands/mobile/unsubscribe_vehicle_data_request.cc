@@ -150,6 +150,8 @@ void UnsubscribeVehicleDataRequest::Run() {
                  "Was not subscribed on any VehicleData", &msg_params);
     return;
   }
+  ApplicationManagerImpl::instance()->resume_controller().
+      OnApplicationDataChanged(app);
 #ifdef MODIFY_FUNCTION_SIGN
   SendResponse(true, mobile_apis::Result::SUCCESS,
                 "Unsubscribed on provided VehicleData", &response_params);
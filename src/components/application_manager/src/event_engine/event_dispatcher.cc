@@ -41,83 +41,240 @@ namespace application_manager {
 namespace event_engine {
 using namespace sync_primitives;
 
-EventDispatcher::EventDispatcher()
-    : observers_() {
+/*
+ * Subscription is linked into two intrusive lists: bucket list
+ * of hash table and list of observer's own subscriptions, so every
+ * unsubscribe is O(1) per subscription. Delivery walks the bucket list
+ * without copying it and pins the node it stands on, unsubscribed node
+ * stays in the bucket list with NULL observer until it is unpinned.
+ */
+struct EventDispatcher::Subscription {
+  Event::EventID event_id;
+  int32_t hmi_correlation_id;
+  EventObserver* observer;
+  uint32_t serial;
+  uint32_t pins;
+  Subscription* bucket_prev;
+  Subscription* bucket_next;
+  Subscription* observer_prev;
+  Subscription* observer_next;
+};
+
+namespace {
+const size_t kInitialBucketsCount = 64;
+
+uint32_t SubscriptionHash(const Event::EventID& event_id,
+                          int32_t hmi_correlation_id) {
+  uint32_t hash = static_cast<uint32_t>(event_id) * 0x9E3779B1u
+      ^ static_cast<uint32_t>(hmi_correlation_id) * 0x85EBCA6Bu;
+  return hash ^ (hash >> 16);
 }
 
-EventDispatcher::~EventDispatcher() {
+bool IsMadeAfter(uint32_t serial, uint32_t limit) {
+  return static_cast<int32_t>(serial - limit) > 0;
 }
+}  // namespace
 
-void EventDispatcher::raise_event(const Event& event) {
-  // create local list
-  ObserverList list;
-  {
-    AutoLock auto_lock(state_lock_);
-    // check if event is notification
-    if (hmi_apis::messageType::notification == event.smart_object_type()) {
-
-      //ObserversMap iterator
-      ObserversMap::iterator it = observers_[event.id()].begin();
-      for (; observers_[event.id()].end() != it; ++it) {
-        list = it->second;
+EventDispatcher::EventDispatcher()
+    : subscriptions_count_(0),
+      last_serial_(0),
+      deliveries_count_(0) {
+  const Bucket empty = { NULL, NULL };
+  buckets_.assign(kInitialBucketsCount, empty);
+}
+
+EventDispatcher::~EventDispatcher() {
+  for (Buckets::iterator it = buckets_.begin(); buckets_.end() != it; ++it) {
+    Subscription* node = it->head;
+    while (node) {
+      Subscription* next = node->bucket_next;
+      if (node->observer) {
+        node->observer->subscriptions_ = NULL;
       }
+      delete node;
+      node = next;
     }
+  }
+}
 
-    if (hmi_apis::messageType::response == event.smart_object_type()
-        || hmi_apis::messageType::error_response == event.smart_object_type()) {
-      list = observers_[event.id()][event.smart_object_correlation_id()];
-    }
+void EventDispatcher::raise_event(const Event& event) {
+  int32_t hmi_correlation_id = 0;
+  switch (event.smart_object_type()) {
+    case hmi_apis::messageType::notification:
+      // notifications are subscribed for without correlation ID
+      break;
+    case hmi_apis::messageType::response:
+    case hmi_apis::messageType::error_response:
+      hmi_correlation_id = event.smart_object_correlation_id();
+      break;
+    default:
+      return;
   }
+  const Event::EventID event_id = event.id();
 
-  // Call observers
-  ObserverList::iterator observers =  list.begin();
-  for (; list.end() != observers; ++observers) {
-      (*observers)->on_event(event);
+  AutoLock auto_lock(state_lock_);
+  const uint32_t serial = last_serial_;
+  ++deliveries_count_;
+  Subscription* node = FindSubscription(
+      bucket(event_id, hmi_correlation_id).head, event_id,
+      hmi_correlation_id, serial);
+  while (node) {
+    ++node->pins;
+    EventObserver* observer = node->observer;
+    {
+      AutoUnlock auto_unlock(auto_lock);
+      observer->on_event(event);
+    }
+    Subscription* next = FindSubscription(node->bucket_next, event_id,
+                                          hmi_correlation_id, serial);
+    if (0 == --node->pins && !node->observer) {
+      Free(node);
+    }
+    node = next;
   }
+  --deliveries_count_;
+  Rehash();
 }
 
 void EventDispatcher::add_observer(const Event::EventID& event_id,
                                    int32_t hmi_correlation_id,
                                    EventObserver* const observer) {
   AutoLock auto_lock(state_lock_);
-  observers_[event_id][hmi_correlation_id].push_back(observer);
+  Subscription* subscription = new Subscription();
+  subscription->event_id = event_id;
+  subscription->hmi_correlation_id = hmi_correlation_id;
+  subscription->observer = observer;
+  subscription->serial = ++last_serial_;
+  subscription->pins = 0;
+
+  AppendToBucket(&bucket(event_id, hmi_correlation_id), subscription);
+
+  subscription->observer_prev = NULL;
+  subscription->observer_next = observer->subscriptions_;
+  if (observer->subscriptions_) {
+    observer->subscriptions_->observer_prev = subscription;
+  }
+  observer->subscriptions_ = subscription;
+
+  ++subscriptions_count_;
+  Rehash();
 }
 
 void EventDispatcher::remove_observer(const Event::EventID& event_id,
                                       EventObserver* const observer) {
   AutoLock auto_lock(state_lock_);
-  ObserversMap::iterator it =  observers_[event_id].begin();
-  for (; observers_[event_id].end() != it; ++it) {
-
-    //ObserverList iterator
-    ObserverList::iterator observer_it =  it->second.begin();
-    while (it->second.end() != observer_it) {
-      if (observer->id() == (*observer_it)->id()) {
-        observer_it = it->second.erase(observer_it);
-      } else {
-        ++observer_it;
-      }
+  Subscription* node = observer->subscriptions_;
+  while (node) {
+    Subscription* next = node->observer_next;
+    if (event_id == node->event_id) {
+      Unsubscribe(node);
     }
+    node = next;
+  }
+}
+
+void EventDispatcher::remove_observer(const Event::EventID& event_id,
+                                      int32_t hmi_correlation_id,
+                                      EventObserver* const observer) {
+  AutoLock auto_lock(state_lock_);
+  Subscription* node = observer->subscriptions_;
+  while (node) {
+    Subscription* next = node->observer_next;
+    if (event_id == node->event_id
+        && hmi_correlation_id == node->hmi_correlation_id) {
+      Unsubscribe(node);
+    }
+    node = next;
   }
 }
 
 void EventDispatcher::remove_observer(EventObserver* const observer) {
   AutoLock auto_lock(state_lock_);
-  EventObserverMap::iterator event_map = observers_.begin();
-  for (; observers_.end() != event_map; ++event_map) {
-
-    ObserversMap::iterator it =  event_map->second.begin();
-    for (; event_map->second.end() != it; ++it) {
-      //ObserverList iterator
-      ObserverList::iterator observer_it =  it->second.begin();
-      while (it->second.end() != observer_it) {
-        if (observer->id() == (*observer_it)->id()) {
-
-          observer_it = it->second.erase(observer_it);
-        } else {
-          ++observer_it;
-        }
-      }
+  while (observer->subscriptions_) {
+    Unsubscribe(observer->subscriptions_);
+  }
+}
+
+EventDispatcher::Bucket& EventDispatcher::bucket(
+    const Event::EventID& event_id, int32_t hmi_correlation_id) {
+  // buckets count is power of two
+  return buckets_[SubscriptionHash(event_id, hmi_correlation_id)
+                  & (buckets_.size() - 1)];
+}
+
+void EventDispatcher::AppendToBucket(Bucket* target, Subscription* node) {
+  node->bucket_prev = target->tail;
+  node->bucket_next = NULL;
+  if (target->tail) {
+    target->tail->bucket_next = node;
+  } else {
+    target->head = node;
+  }
+  target->tail = node;
+}
+
+EventDispatcher::Subscription* EventDispatcher::FindSubscription(
+    Subscription* node, const Event::EventID& event_id,
+    int32_t hmi_correlation_id, uint32_t serial) {
+  for (; node; node = node->bucket_next) {
+    if (node->observer
+        && event_id == node->event_id
+        && hmi_correlation_id == node->hmi_correlation_id
+        && !IsMadeAfter(node->serial, serial)) {
+      return node;
+    }
+  }
+  return NULL;
+}
+
+void EventDispatcher::Unsubscribe(Subscription* subscription) {
+  EventObserver* observer = subscription->observer;
+  if (subscription->observer_prev) {
+    subscription->observer_prev->observer_next = subscription->observer_next;
+  } else {
+    observer->subscriptions_ = subscription->observer_next;
+  }
+  if (subscription->observer_next) {
+    subscription->observer_next->observer_prev = subscription->observer_prev;
+  }
+  subscription->observer = NULL;
+  if (0 == subscription->pins) {
+    Free(subscription);
+  }
+}
+
+void EventDispatcher::Free(Subscription* subscription) {
+  Bucket& owner = bucket(subscription->event_id,
+                         subscription->hmi_correlation_id);
+  if (subscription->bucket_prev) {
+    subscription->bucket_prev->bucket_next = subscription->bucket_next;
+  } else {
+    owner.head = subscription->bucket_next;
+  }
+  if (subscription->bucket_next) {
+    subscription->bucket_next->bucket_prev = subscription->bucket_prev;
+  } else {
+    owner.tail = subscription->bucket_prev;
+  }
+  delete subscription;
+  --subscriptions_count_;
+}
+
+void EventDispatcher::Rehash() {
+  if (0 != deliveries_count_ || subscriptions_count_ <= buckets_.size()) {
+    return;
+  }
+  Buckets old_buckets;
+  old_buckets.swap(buckets_);
+  const Bucket empty = { NULL, NULL };
+  buckets_.assign(old_buckets.size() * 2, empty);
+  for (Buckets::iterator it = old_buckets.begin();
+       old_buckets.end() != it; ++it) {
+    Subscription* node = it->head;
+    while (node) {
+      Subscription* next = node->bucket_next;
+      AppendToBucket(&bucket(node->event_id, node->hmi_correlation_id), node);
+      node = next;
     }
   }
 }
@@ -40,7 +40,8 @@ namespace application_manager {
 namespace event_engine {
 
 EventObserver::EventObserver()
- : id_(0) {
+ : id_(0),
+   subscriptions_(NULL) {
   //Get unique id based on this
   id_ = reinterpret_cast<unsigned long>(this);
 }
@@ -58,6 +59,12 @@ void EventObserver::unsubscribe_from_event(const Event::EventID& event_id) {
   EventDispatcher::instance()->remove_observer(event_id, this);
 }
 
+void EventObserver::unsubscribe_from_event(const Event::EventID& event_id,
+                                           int32_t hmi_correlation_id) {
+  EventDispatcher::instance()->remove_observer(event_id, hmi_correlation_id,
+                                               this);
+}
+
 void EventObserver::unsubscribe_from_all_events() {
   EventDispatcher::instance()->remove_observer(this);
 }
@@ -33,9 +33,12 @@
 #ifdef MODIFY_FUNCTION_SIGN
 #include <global_first.h>
 #endif
+#include <string.h>
 #include <map>
+#include <vector>
 #include "json/json.h"
 #include "utils/file_system.h"
+#include "utils/mapped_file.h"
 #include "interfaces/HMI_API.h"
 #include "config_profile/profile.h"
 #include "smart_objects/smart_object.h"
@@ -52,6 +55,231 @@ namespace Formatters = NsSmartDeviceLink::NsJSONHandler::Formatters;
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "HMICapabilities")
 
+namespace {
+
+const char kCapabilitiesCacheName[] = "hmi_capabilities.cache";
+const uint32_t kCacheSignature = 0x43494D48;  // "HMIC"
+// Must be changed whenever conversion of file or enums of HMI API change
+const uint32_t kCacheFormatVersion = 1;
+
+struct CacheHeader {
+  uint32_t signature;
+  uint32_t format_version;
+  // Identify content of hmi_capabilities.json cache was made from
+  uint32_t source_size;
+  uint32_t source_hash;
+  uint32_t payload_size;
+  uint32_t payload_hash;
+};
+
+// FNV-1a
+uint32_t Hash(const uint8_t* data, size_t size) {
+  uint32_t hash = 2166136261U;
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ data[i]) * 16777619U;
+  }
+  return hash;
+}
+
+std::string CapabilitiesCachePath() {
+  std::string path = profile::Profile::instance()->app_storage_folder();
+  if (!path.empty()) {
+    path += "/";
+  }
+  return path + kCapabilitiesCacheName;
+}
+
+void PutBytes(const void* data, size_t size, std::vector<uint8_t>* output) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  output->insert(output->end(), bytes, bytes + size);
+}
+
+void PutSize(size_t size, std::vector<uint8_t>* output) {
+  const uint32_t value = size;
+  PutBytes(&value, sizeof(value), output);
+}
+
+void PutString(const std::string& value, std::vector<uint8_t>* output) {
+  PutSize(value.size(), output);
+  PutBytes(value.data(), value.size(), output);
+}
+
+// Writes object as type byte followed by its value, containers are
+// written as number of elements followed by elements
+void PutObject(const smart_objects::SmartObject& object,
+               std::vector<uint8_t>* output) {
+  const smart_objects::SmartType type = object.getType();
+  output->push_back(static_cast<uint8_t>(type));
+  switch (type) {
+    case smart_objects::SmartType_Boolean:
+      output->push_back(object.asBool() ? 1 : 0);
+      break;
+    case smart_objects::SmartType_Integer: {
+      const int32_t value = object.asInt();
+      PutBytes(&value, sizeof(value), output);
+    } break;
+    case smart_objects::SmartType_Character:
+      output->push_back(static_cast<uint8_t>(object.asChar()));
+      break;
+    case smart_objects::SmartType_Double: {
+      const double value = object.asDouble();
+      PutBytes(&value, sizeof(value), output);
+    } break;
+    case smart_objects::SmartType_String:
+      PutString(object.asString(), output);
+      break;
+    case smart_objects::SmartType_Map: {
+      const std::set<std::string> keys = object.enumerate();
+      PutSize(keys.size(), output);
+      for (std::set<std::string>::const_iterator it = keys.begin();
+           keys.end() != it; ++it) {
+        PutString(*it, output);
+        PutObject(object.getElement(*it), output);
+      }
+    } break;
+    case smart_objects::SmartType_Array: {
+      const size_t length = object.length();
+      PutSize(length, output);
+      for (size_t i = 0; i < length; ++i) {
+        PutObject(object.getElement(i), output);
+      }
+    } break;
+    case smart_objects::SmartType_Binary: {
+      const smart_objects::SmartBinary binary = object.asBinary();
+      PutSize(binary.size(), output);
+      if (!binary.empty()) {
+        PutBytes(&binary[0], binary.size(), output);
+      }
+    } break;
+    default:
+      break;
+  }
+}
+
+class CacheReader {
+ public:
+  CacheReader(const uint8_t* begin, const uint8_t* end)
+    : current_(begin),
+      end_(end) {
+  }
+
+  bool GetObject(smart_objects::SmartObject* object) {
+    uint8_t type = 0;
+    if (!GetBytes(&type, sizeof(type))) {
+      return false;
+    }
+    switch (static_cast<int8_t>(type)) {
+      case smart_objects::SmartType_Null:
+        *object = smart_objects::SmartObject();
+        return true;
+      case smart_objects::SmartType_Boolean: {
+        uint8_t value = 0;
+        if (!GetBytes(&value, sizeof(value))) {
+          return false;
+        }
+        *object = smart_objects::SmartObject(0 != value);
+      } return true;
+      case smart_objects::SmartType_Integer: {
+        int32_t value = 0;
+        if (!GetBytes(&value, sizeof(value))) {
+          return false;
+        }
+        *object = smart_objects::SmartObject(value);
+      } return true;
+      case smart_objects::SmartType_Character: {
+        char value = 0;
+        if (!GetBytes(&value, sizeof(value))) {
+          return false;
+        }
+        *object = smart_objects::SmartObject(value);
+      } return true;
+      case smart_objects::SmartType_Double: {
+        double value = 0;
+        if (!GetBytes(&value, sizeof(value))) {
+          return false;
+        }
+        *object = smart_objects::SmartObject(value);
+      } return true;
+      case smart_objects::SmartType_String: {
+        std::string value;
+        if (!GetString(&value)) {
+          return false;
+        }
+        *object = smart_objects::SmartObject(value);
+      } return true;
+      case smart_objects::SmartType_Map: {
+        uint32_t count = 0;
+        if (!GetBytes(&count, sizeof(count))) {
+          return false;
+        }
+        *object = smart_objects::SmartObject(smart_objects::SmartType_Map);
+        std::string key;
+        for (uint32_t i = 0; i < count; ++i) {
+          if (!GetString(&key) || !GetObject(&(*object)[key])) {
+            return false;
+          }
+        }
+      } return true;
+      case smart_objects::SmartType_Array: {
+        uint32_t count = 0;
+        if (!GetBytes(&count, sizeof(count))) {
+          return false;
+        }
+        *object = smart_objects::SmartObject(smart_objects::SmartType_Array);
+        for (uint32_t i = 0; i < count; ++i) {
+          if (!GetObject(&(*object)[i])) {
+            return false;
+          }
+        }
+      } return true;
+      case smart_objects::SmartType_Binary: {
+        uint32_t size = 0;
+        if (!GetBytes(&size, sizeof(size)) || Left() < size) {
+          return false;
+        }
+        *object = smart_objects::SmartObject(
+            smart_objects::SmartBinary(current_, current_ + size));
+        current_ += size;
+      } return true;
+      default:
+        return false;
+    }
+  }
+
+  bool at_end() const {
+    return current_ == end_;
+  }
+
+ private:
+  size_t Left() const {
+    return end_ - current_;
+  }
+
+  bool GetBytes(void* value, size_t size) {
+    if (Left() < size) {
+      return false;
+    }
+    memcpy(value, current_, size);
+    current_ += size;
+    return true;
+  }
+
+  bool GetString(std::string* value) {
+    uint32_t size = 0;
+    if (!GetBytes(&size, sizeof(size)) || Left() < size) {
+      return false;
+    }
+    value->assign(reinterpret_cast<const char*>(current_), size);
+    current_ += size;
+    return true;
+  }
+
+  const uint8_t* current_;
+  const uint8_t* end_;
+};
+
+}  // namespace
+
 #ifndef BUILD_TARGET_LIB
 #if defined(OS_MAC) || defined(OS_WINCE)
 std::map<std::string, hmi_apis::Common_Language::eType> languages_enum_values;
@@ -667,112 +895,79 @@ void HMICapabilities::set_active_tts_language(
 
 void HMICapabilities::set_ui_supported_languages(
     const smart_objects::SmartObject& supported_languages) {
-  if (ui_supported_languages_) {
-    delete ui_supported_languages_;
-  }
-  ui_supported_languages_ = new smart_objects::SmartObject(supported_languages);
+  replace_capability(&ui_supported_languages_, supported_languages);
 }
 
 void HMICapabilities::set_tts_supported_languages(
     const smart_objects::SmartObject& supported_languages) {
-  if (tts_supported_languages_) {
-    delete tts_supported_languages_;
-  }
-  tts_supported_languages_ = new smart_objects::SmartObject(
-      supported_languages);
+  replace_capability(&tts_supported_languages_, supported_languages);
 }
 
 void HMICapabilities::set_vr_supported_languages(
     const smart_objects::SmartObject& supported_languages) {
-  if (vr_supported_languages_) {
-    delete vr_supported_languages_;
-  }
-  vr_supported_languages_ = new smart_objects::SmartObject(supported_languages);
+  replace_capability(&vr_supported_languages_, supported_languages);
 }
 
 void HMICapabilities::set_display_capabilities(
     const smart_objects::SmartObject& display_capabilities) {
-  if (display_capabilities_) {
-    delete display_capabilities_;
-  }
-  display_capabilities_ = new smart_objects::SmartObject(display_capabilities);
+  replace_capability(&display_capabilities_, display_capabilities);
 }
 
 void HMICapabilities::set_hmi_zone_capabilities(
     const smart_objects::SmartObject& hmi_zone_capabilities) {
-  if (hmi_zone_capabilities_) {
-    delete hmi_zone_capabilities_;
-  }
-  hmi_zone_capabilities_ = new smart_objects::SmartObject(
-      hmi_zone_capabilities);
+  replace_capability(&hmi_zone_capabilities_, hmi_zone_capabilities);
 }
 
 void HMICapabilities::set_soft_button_capabilities(
     const smart_objects::SmartObject& soft_button_capabilities) {
-  if (soft_buttons_capabilities_) {
-    delete soft_buttons_capabilities_;
-  }
-  soft_buttons_capabilities_ = new smart_objects::SmartObject(
-      soft_button_capabilities);
+  replace_capability(&soft_buttons_capabilities_, soft_button_capabilities);
 }
 
 void HMICapabilities::set_button_capabilities(
     const smart_objects::SmartObject& button_capabilities) {
-  if (button_capabilities_) {
-    delete button_capabilities_;
-  }
-  button_capabilities_ = new smart_objects::SmartObject(button_capabilities);
+  replace_capability(&button_capabilities_, button_capabilities);
 }
 
 void HMICapabilities::set_vr_capabilities(
     const smart_objects::SmartObject& vr_capabilities) {
-  if (vr_capabilities_) {
-    delete vr_capabilities_;
-  }
-  vr_capabilities_ = new smart_objects::SmartObject(vr_capabilities);
+  replace_capability(&vr_capabilities_, vr_capabilities);
 }
 
 void HMICapabilities::set_speech_capabilities(
     const smart_objects::SmartObject& speech_capabilities) {
-  if (speech_capabilities_) {
-    delete speech_capabilities_;
-  }
-  speech_capabilities_ = new smart_objects::SmartObject(speech_capabilities);
+  replace_capability(&speech_capabilities_, speech_capabilities);
 }
 
 void HMICapabilities::set_audio_pass_thru_capabilities(
     const smart_objects::SmartObject& audio_pass_thru_capabilities) {
-  if (audio_pass_thru_capabilities_) {
-    delete audio_pass_thru_capabilities_;
-  }
-  audio_pass_thru_capabilities_ = new smart_objects::SmartObject(
-      audio_pass_thru_capabilities);
+  replace_capability(&audio_pass_thru_capabilities_, audio_pass_thru_capabilities);
 }
 
 void HMICapabilities::set_preset_bank_capabilities(
     const smart_objects::SmartObject& preset_bank_capabilities) {
-  if (preset_bank_capabilities_) {
-    delete preset_bank_capabilities_;
-  }
-  preset_bank_capabilities_ = new smart_objects::SmartObject(
-      preset_bank_capabilities);
+  replace_capability(&preset_bank_capabilities_, preset_bank_capabilities);
 }
 
 void HMICapabilities::set_vehicle_type(
   const smart_objects::SmartObject& vehicle_type) {
-  if (vehicle_type_) {
-    delete vehicle_type_;
-  }
-  vehicle_type_ = new smart_objects::SmartObject(vehicle_type);
+  replace_capability(&vehicle_type_, vehicle_type);
 }
 
 void HMICapabilities::set_prerecorded_speech(
        const smart_objects::SmartObject& prerecorded_speech) {
-  if (prerecorded_speech_) {
-    delete prerecorded_speech_;
-    prerecorded_speech_ = NULL;
+  replace_capability(&prerecorded_speech_, prerecorded_speech);
+}
+
+void HMICapabilities::replace_capability(
+    smart_objects::SmartObject** capability,
+    const smart_objects::SmartObject& value) {
+  // HMI usually reports the same capabilities as were loaded from file,
+  // object is kept then and pointers given out earlier stay valid
+  if (*capability && **capability == value) {
+    return;
   }
-  prerecorded_speech_ = new smart_objects::SmartObject(prerecorded_speech);
+  delete *capability;
+  *capability = new smart_objects::SmartObject(value);
 }
 
 bool HMICapabilities::load_capabilities_from_file() {
@@ -788,6 +983,11 @@ bool HMICapabilities::load_capabilities_from_file() {
     return false;
   }
 
+  if (load_capabilities_from_cache(json_string)) {
+    LOG4CXX_INFO(logger_, "Capabilities are restored from cache");
+    return true;
+  }
+
   try {
 
     Json::Reader reader_;
@@ -1104,9 +1304,119 @@ bool HMICapabilities::load_capabilities_from_file() {
   } catch (...) {
     return false;
   }
+  save_capabilities_to_cache(json_string);
   return true;
 }
 
+const HMICapabilities::CachedCapability*
+HMICapabilities::cached_capabilities(size_t* count) {
+  static const CachedCapability kCapabilities[] = {
+    { "ui_supported_languages", &HMICapabilities::ui_supported_languages_ },
+    { "tts_supported_languages", &HMICapabilities::tts_supported_languages_ },
+    { "vr_supported_languages", &HMICapabilities::vr_supported_languages_ },
+    { "display_capabilities", &HMICapabilities::display_capabilities_ },
+    { "hmi_zone_capabilities", &HMICapabilities::hmi_zone_capabilities_ },
+    { "soft_button_capabilities",
+      &HMICapabilities::soft_buttons_capabilities_ },
+    { "button_capabilities", &HMICapabilities::button_capabilities_ },
+    { "preset_bank_capabilities",
+      &HMICapabilities::preset_bank_capabilities_ },
+    { "vr_capabilities", &HMICapabilities::vr_capabilities_ },
+    { "speech_capabilities", &HMICapabilities::speech_capabilities_ },
+    { "audio_pass_thru_capabilities",
+      &HMICapabilities::audio_pass_thru_capabilities_ },
+    { "vehicle_type", &HMICapabilities::vehicle_type_ }
+  };
+  *count = sizeof(kCapabilities) / sizeof(kCapabilities[0]);
+  return kCapabilities;
+}
+
+bool HMICapabilities::load_capabilities_from_cache(const std::string& source) {
+  file_system::MappedFile cache;
+  if (!cache.Open(CapabilitiesCachePath())) {
+    return false;
+  }
+  CacheHeader header;
+  if (cache.size() < sizeof(header)) {
+    return false;
+  }
+  memcpy(&header, cache.data(), sizeof(header));
+  const uint8_t* payload = cache.data() + sizeof(header);
+  const uint8_t* source_data = reinterpret_cast<const uint8_t*>(source.data());
+  if (kCacheSignature != header.signature ||
+      kCacheFormatVersion != header.format_version ||
+      source.size() != header.source_size ||
+      Hash(source_data, source.size()) != header.source_hash ||
+      cache.size() - sizeof(header) != header.payload_size ||
+      Hash(payload, header.payload_size) != header.payload_hash) {
+    LOG4CXX_INFO(logger_, "Capabilities cache is outdated");
+    return false;
+  }
+
+  smart_objects::SmartObject capabilities;
+  CacheReader reader(payload, payload + header.payload_size);
+  if (!reader.GetObject(&capabilities) || !reader.at_end() ||
+      smart_objects::SmartType_Map != capabilities.getType()) {
+    LOG4CXX_WARN(logger_, "Capabilities cache is damaged");
+    return false;
+  }
+
+  set_active_ui_language(static_cast<hmi_apis::Common_Language::eType>(
+      capabilities["ui_language"].asInt()));
+  set_active_vr_language(static_cast<hmi_apis::Common_Language::eType>(
+      capabilities["vr_language"].asInt()));
+  set_active_tts_language(static_cast<hmi_apis::Common_Language::eType>(
+      capabilities["tts_language"].asInt()));
+  size_t count = 0;
+  const CachedCapability* cached = cached_capabilities(&count);
+  for (size_t i = 0; i < count; ++i) {
+    if (capabilities.keyExists(cached[i].name)) {
+      replace_capability(&(this->*cached[i].field),
+                         capabilities[cached[i].name]);
+    }
+  }
+  return true;
+}
+
+void HMICapabilities::save_capabilities_to_cache(
+    const std::string& source) const {
+  smart_objects::SmartObject capabilities(smart_objects::SmartType_Map);
+  capabilities["ui_language"] = static_cast<int32_t>(ui_language_);
+  capabilities["vr_language"] = static_cast<int32_t>(vr_language_);
+  capabilities["tts_language"] = static_cast<int32_t>(tts_language_);
+  size_t count = 0;
+  const CachedCapability* cached = cached_capabilities(&count);
+  for (size_t i = 0; i < count; ++i) {
+    if (this->*cached[i].field) {
+      capabilities[cached[i].name] = *(this->*cached[i].field);
+    }
+  }
+
+  std::vector<uint8_t> payload;
+  PutObject(capabilities, &payload);
+  CacheHeader header;
+  header.signature = kCacheSignature;
+  header.format_version = kCacheFormatVersion;
+  header.source_size = source.size();
+  header.source_hash = Hash(reinterpret_cast<const uint8_t*>(source.data()),
+                            source.size());
+  header.payload_size = payload.size();
+  header.payload_hash = Hash(&payload[0], payload.size());
+
+  std::vector<uint8_t> cache;
+  cache.reserve(sizeof(header) + payload.size());
+  PutBytes(&header, sizeof(header), &cache);
+  cache.insert(cache.end(), payload.begin(), payload.end());
+  // Cache is replaced at once, so it is never read half written
+  const std::string cache_path = CapabilitiesCachePath();
+  const std::string temp_path = cache_path + ".tmp";
+  if (!file_system::WriteBinaryFile(temp_path, cache) ||
+      !file_system::RenameFile(temp_path, cache_path)) {
+    LOG4CXX_WARN(logger_, "Failed to save capabilities cache");
+    file_system::DeleteFile(temp_path);
+  }
+}
+
 bool HMICapabilities::check_existing_json_member(
     const Json::Value& json_member, const char* name_of_member) {
   return json_member.isMember(name_of_member);
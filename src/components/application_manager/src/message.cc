@@ -35,12 +35,6 @@
 #endif
 #include "application_manager/message.h"
 
-namespace {
-bool BinaryDataPredicate(uint8_t i, uint8_t j) {
-  return (i == j);
-}
-}
-
 namespace application_manager {
 
 MessageType MessageTypeFromRpcType(protocol_handler::RpcType rpc_type) {
@@ -64,7 +58,7 @@ Message::Message(protocol_handler::MessagePriority priority)
       priority_(priority),
       correlation_id_(0),
       connection_key_(0),
-      binary_data_(NULL),
+      binary_data_(),
       version_(kUnknownProtocol) {
 }
 
@@ -78,9 +72,7 @@ Message& Message::operator=(const Message& message) {
   set_correlation_id(message.correlation_id_);
   set_connection_key(message.connection_key_);
   set_message_type(message.type_);
-  if (message.binary_data_) {
-    set_binary_data(message.binary_data_);
-  }
+  set_binary_data(message.binary_data_);
   set_json_message(message.json_message_);
   set_protocol_version(message.protocol_version());
   priority_ = message.priority_;
@@ -95,19 +87,13 @@ bool Message::operator==(const Message& message) {
   bool type = type_ == message.type_;
   bool json_message = json_message_ == message.json_message_;
   bool version = version_ == message.version_;
-
-  bool binary_data = std::equal(binary_data_->begin(), binary_data_->end(),
-                                message.binary_data_->begin(),
-                                BinaryDataPredicate);
+  bool binary_data = binary_data_ == message.binary_data_;
 
   return function_id && correlation_id && connection_key && type && binary_data
       && json_message && version;
 }
 
 Message::~Message() {
-  if (binary_data_) {
-    delete binary_data_;
-  }
 }
 
 int32_t Message::function_id() const {
@@ -134,12 +120,12 @@ const std::string& Message::json_message() const {
   return json_message_;
 }
 
-const BinaryData* Message::binary_data() const {
+const BinaryData& Message::binary_data() const {
   return binary_data_;
 }
 
 bool Message::has_binary_data() const {
-  return (binary_data_ != NULL);
+  return !binary_data_.empty();
 }
 
 void Message::set_function_id(int32_t id) {
@@ -158,16 +144,7 @@ void Message::set_message_type(MessageType type) {
   type_ = type;
 }
 
-void Message::set_binary_data(BinaryData* data) {
-  if (NULL == data) {
-    NOTREACHED();
-    return;
-  }
-
-  if (binary_data_) {
-    delete binary_data_;
-  }
-
+void Message::set_binary_data(const BinaryData& data) {
   binary_data_ = data;
 }
 
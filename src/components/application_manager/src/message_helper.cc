@@ -651,11 +651,11 @@ MessageHelper::SmartObjectList MessageHelper::GetIVISubscribtionRequests(
   msg_params[strings::app_id] = app_id;
   const VehicleData& vehicle_data = MessageHelper::vehicle_data_;
   VehicleData::const_iterator ivi_it = vehicle_data.begin();
-  const std::set<uint32_t>& subscribes = app->SubscribesIVI();
+  const VehicleInfoSubscriptions& subscribes = app->SubscribesIVI();
 
   for (; vehicle_data.end() != ivi_it; ++ivi_it) {
     uint32_t type_id = static_cast<int>(ivi_it->second);
-    if (subscribes.end() != subscribes.find(type_id)) {
+    if (subscribes.contains(type_id)) {
       std::string key_name = ivi_it->first;
       msg_params[key_name] = true;
     }
@@ -833,7 +833,7 @@ smart_objects::SmartObject* MessageHelper::CreateAppVrHelp(
   if (app->vr_help()) {
     vr_help[strings::vr_help] = (*app->vr_help());
   } else {
-    const std::set<ApplicationSharedPtr>& apps =
+    const std::set<ApplicationSharedPtr> apps =
       ApplicationManagerImpl::instance()->applications();
 
     int32_t index = 0;
@@ -984,8 +984,11 @@ MessageHelper::SmartObjectList MessageHelper::CreateAddCommandRequestToHMI(
 
     // VR Interface
     if ((*i->second).keyExists(strings::vr_commands)) {
-      SendAddVRCommandToHMI(i->first, (*i->second)[strings::vr_commands],
-                            app->app_id());
+      smart_objects::SmartObject* vr_command = CreateAddVRCommandToHMI(
+            i->first, (*i->second)[strings::vr_commands], app->app_id());
+      if (vr_command) {
+        requests.push_back(vr_command);
+      }
     }
   }
   return requests;
@@ -1233,8 +1236,8 @@ void MessageHelper::SendSubscribeButtonNotificationToHMI(ApplicationConstSharedP
 		return;
 	}
 
-	const std::set<mobile_apis::ButtonName::eType>& subscribed_buttons = app->SubscribedButtons();
-	std::set<mobile_apis::ButtonName::eType>::const_iterator i = subscribed_buttons.begin();
+	const ButtonSubscriptions& subscribed_buttons = app->SubscribedButtons();
+	ButtonSubscriptions::const_iterator i = subscribed_buttons.begin();
 	for (; subscribed_buttons.end() != i; ++i) {
 		smart_objects::SmartObject* ui_subscribed_button = new smart_objects::SmartObject(
 			smart_objects::SmartType_Map);
@@ -1340,8 +1343,8 @@ void MessageHelper::SendUnsubscribeButtonNotificationToHMI(ApplicationConstShare
 		return;
 	}
 
-	const std::set<mobile_apis::ButtonName::eType>& subscribed_buttons = app->SubscribedButtons();
-	std::set<mobile_apis::ButtonName::eType>::const_iterator i = subscribed_buttons.begin();
+	const ButtonSubscriptions& subscribed_buttons = app->SubscribedButtons();
+	ButtonSubscriptions::const_iterator i = subscribed_buttons.begin();
 	for (; subscribed_buttons.end() != i; ++i) {
 		smart_objects::SmartObject* ui_subscribed_button = new smart_objects::SmartObject(
 			smart_objects::SmartType_Map);
@@ -96,7 +96,7 @@ MobileMessageHandler::HandleIncomingMessageProtocolV2(
   utils::BitStream message_bytestream(message->data(), message->data_size());
   protocol_handler::ProtocolPayloadV2 payload;
   protocol_handler::Extract(&message_bytestream, &payload,
-                            message->data_size());
+                            message->buffer());
 
   // Silently drop message if it wasn't parsed correctly
   if (message_bytestream.IsBad()) {
@@ -122,8 +122,7 @@ MobileMessageHandler::HandleIncomingMessageProtocolV2(
         ->protocol_version()));
 
   if (!payload.data.empty()) {
-    outgoing_message->set_binary_data(
-        new application_manager::BinaryData(payload.data));
+    outgoing_message->set_binary_data(payload.data);
   }
   return outgoing_message.release();
 }
@@ -162,7 +161,7 @@ MobileMessageHandler::HandleOutgoingMessageProtocolV2(
   uint32_t jsonSize = message->json_message().length();
   uint32_t binarySize = 0;
   if (message->has_binary_data()) {
-    binarySize = message->binary_data()->size();
+    binarySize = message->binary_data().size();
   }
 
   uint8_t* dataForSending = new uint8_t[MAX_HEADER_SIZE + jsonSize
@@ -205,11 +204,8 @@ MobileMessageHandler::HandleOutgoingMessageProtocolV2(
   memcpy(dataForSending + offset, message->json_message().c_str(), jsonSize);
 
   if (message->has_binary_data()) {
-    const std::vector<uint8_t>& binaryData = *(message->binary_data());
-    uint8_t* currentPointer = dataForSending + offset + jsonSize;
-    for (uint32_t i = 0; i < binarySize; ++i) {
-      currentPointer[i] = binaryData[i];
-    }
+    memcpy(dataForSending + offset + jsonSize,
+           message->binary_data().data(), binarySize);
   }
 
   protocol_handler::RawMessage* msgToProtocolHandler =
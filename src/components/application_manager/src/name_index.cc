@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef MODIFY_FUNCTION_SIGN
+#include <global_first.h>
+#endif
+#include "application_manager/name_index.h"
+
+#include <ctype.h>
+
+namespace application_manager {
+
+namespace {
+const size_t kInitialBucketsCount = 16;
+}
+
+NameIndex::NameIndex(CaseMode case_mode)
+  : case_mode_(case_mode),
+    buckets_(kInitialBucketsCount),
+    size_(0) {
+}
+
+void NameIndex::Add(const std::string& name) {
+  const std::string key = Key(name);
+  const uint32_t hash = Hash(key);
+  Bucket& bucket = buckets_[hash & (buckets_.size() - 1)];
+  for (Bucket::iterator it = bucket.begin(); bucket.end() != it; ++it) {
+    if (hash == it->hash && key == it->key) {
+      ++it->count;
+      return;
+    }
+  }
+  Entry entry;
+  entry.key = key;
+  entry.hash = hash;
+  entry.count = 1;
+  bucket.push_back(entry);
+  if (++size_ > buckets_.size()) {
+    Grow();
+  }
+}
+
+void NameIndex::Remove(const std::string& name) {
+  const std::string key = Key(name);
+  const uint32_t hash = Hash(key);
+  Bucket& bucket = buckets_[hash & (buckets_.size() - 1)];
+  for (Bucket::iterator it = bucket.begin(); bucket.end() != it; ++it) {
+    if (hash == it->hash && key == it->key) {
+      if (0 == --it->count) {
+        bucket.erase(it);
+        --size_;
+      }
+      return;
+    }
+  }
+}
+
+bool NameIndex::Contains(const std::string& name) const {
+  const std::string key = Key(name);
+  const uint32_t hash = Hash(key);
+  const Bucket& bucket = buckets_[hash & (buckets_.size() - 1)];
+  for (Bucket::const_iterator it = bucket.begin(); bucket.end() != it; ++it) {
+    if (hash == it->hash && key == it->key) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void NameIndex::Clear() {
+  buckets_.assign(kInitialBucketsCount, Bucket());
+  size_ = 0;
+}
+
+std::string NameIndex::Key(const std::string& name) const {
+  if (kCaseSensitive == case_mode_) {
+    return name;
+  }
+  std::string key(name);
+  for (std::string::iterator it = key.begin(); key.end() != it; ++it) {
+    *it = static_cast<char>(tolower(static_cast<unsigned char>(*it)));
+  }
+  return key;
+}
+
+uint32_t NameIndex::Hash(const std::string& key) {
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (std::string::const_iterator it = key.begin(); key.end() != it; ++it) {
+    hash ^= static_cast<unsigned char>(*it);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+void NameIndex::Grow() {
+  std::vector<Bucket> buckets(buckets_.size() * 2);
+  for (std::vector<Bucket>::iterator bucket = buckets_.begin();
+       buckets_.end() != bucket; ++bucket) {
+    for (Bucket::iterator it = bucket->begin(); bucket->end() != it; ++it) {
+      buckets[it->hash & (buckets.size() - 1)].push_back(*it);
+    }
+  }
+  buckets_.swap(buckets);
+}
+
+}  // namespace application_manager
@@ -75,6 +75,7 @@ PolicyHandler::PolicyHandler()
     dl_handle_(0),
     exchange_handler_(NULL),
     on_ignition_check_done_(false),
+    policy_table_loaded_(false),
     retry_sequence_("RetrySequence", new RetrySequence(this)) {
 }
 
@@ -163,6 +164,18 @@ bool PolicyHandler::InitPolicyTable() {
   return policy_manager_->InitPT(preloaded_file);
 }
 
+PolicyManager* PolicyHandler::LoadPolicyTable() {
+  sync_primitives::AutoLock lock(load_lock_);
+  if (!policy_table_loaded_) {
+    policy_table_loaded_ = true;
+    if (LoadPolicyLibrary()) {
+      LOG4CXX_INFO(logger_, "Policy library is loaded, now initing PT");
+      InitPolicyTable();
+    }
+  }
+  return policy_manager_;
+}
+
 bool PolicyHandler::ResetPolicyTable() {
   LOG4CXX_TRACE(logger_, "Reset policy table.");
   if (!policy_manager_) {
@@ -604,7 +617,10 @@ bool PolicyHandler::ReceiveMessageFromSDK(const std::string& file,
 }
 
 bool PolicyHandler::UnloadPolicyLibrary() {
+  // Library is not unloaded while startup sequence loads it
+  sync_primitives::AutoLock lock(load_lock_);
   bool ret = true;
+  policy_table_loaded_ = false;
   delete policy_manager_;
   policy_manager_ = 0;
   if (dl_handle_) {
@@ -35,11 +35,15 @@
 #include <fstream>
 #include <string>
 
+#include "application_manager/application_manager_impl.h"
 #include "application_manager/message_helper.h"
 #include "config_profile/profile.h"
+#include "utils/async_file_io.h"
 #include "utils/file_system.h"
 
+using application_manager::ApplicationManagerImpl;
 using application_manager::MessageHelper;
+using application_manager::StrandExecutor;
 using profile::Profile;
 using std::string;
 
@@ -48,6 +52,57 @@ namespace policy {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "PTExchangeHandlerExt")
 
+namespace {
+
+/**
+ * @brief Sends policy update to HMI on strand of HMI messages
+ */
+class PolicyUpdateTask : public StrandExecutor::Task {
+ public:
+  PolicyUpdateTask(const string& file_name, int timeout,
+                   const std::vector<int>& retries)
+    : file_name_(file_name),
+      timeout_(timeout),
+      retries_(retries) {
+  }
+
+  virtual void Run() {
+    MessageHelper::SendPolicyUpdate(file_name_, timeout_, retries_);
+  }
+
+ private:
+  string file_name_;
+  int timeout_;
+  std::vector<int> retries_;
+};
+
+/**
+ * @brief Sends policy update to HMI once snapshot is written
+ */
+class SnapshotWriteCompletion : public file_system::AsyncFileIO::Completion {
+ public:
+  SnapshotWriteCompletion(int timeout, const std::vector<int>& retries)
+    : timeout_(timeout),
+      retries_(retries) {
+  }
+
+  // CALLED ON AsyncFileIO worker!
+  virtual void OnWriteCompleted(const string& file_name, bool success) {
+    if (!success) {
+      LOG4CXX_ERROR(logger_, "Failed to write snapshot file to " << file_name);
+      return;
+    }
+    ApplicationManagerImpl::instance()->PostHmiTask(
+      new PolicyUpdateTask(file_name, timeout_, retries_));
+  }
+
+ private:
+  int timeout_;
+  std::vector<int> retries_;
+};
+
+}  // namespace
+
 PTExchangeHandlerExt::PTExchangeHandlerExt(PolicyHandler* policy_handler)
   : PTExchangeHandler(),
     policy_handler_(policy_handler) {
@@ -69,14 +124,15 @@ bool PTExchangeHandlerExt::StartExchange() {
   BinaryMessageSptr pt_snapshot = policy_manager->RequestPTUpdate();
   if (pt_snapshot.valid()) {
     pt_snapshot = policy_handler_->AddHttpHeader(pt_snapshot);
-    if (file_system::WriteBinaryFile(policy_snapshot_file_name, *pt_snapshot)) {
-      MessageHelper::SendPolicyUpdate(policy_snapshot_file_name,
-                                      policy_manager->TimeoutExchange(),
-                                      policy_manager->RetrySequenceDelaysSeconds());
-      return true;
-    } else {
-      LOG4CXX_ERROR(logger_, "Failed to write snapshot file to " << policy_snapshot_file_name);
-    }
+    // Snapshot is written off the caller thread, HMI is notified once
+    // the file is complete
+    file_system::AsyncFileIO::instance()->WriteAt(
+      policy_snapshot_file_name, utils::SharedBuffer::Adopt(&*pt_snapshot), 0,
+      file_system::AsyncFileIO::kSyncData,
+      file_system::AsyncFileIO::CompletionPtr(new SnapshotWriteCompletion(
+          policy_manager->TimeoutExchange(),
+          policy_manager->RetrySequenceDelaysSeconds())));
+    return true;
   } else {
     LOG4CXX_ERROR(logger_, "Failed to obtain policy table snapshot");
   }
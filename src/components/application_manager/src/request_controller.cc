@@ -45,21 +45,39 @@ using namespace sync_primitives;
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "RequestController")
 
+namespace {
+// Time given to HMI to respond after request timeout
+const uint32_t kHmiResponseDelay = 1000;
+}
+
+RequestController::TimerDelegate::TimerDelegate(
+    RequestController* controller)
+  : controller_(controller) {
+}
+
+void RequestController::TimerDelegate::threadMain() {
+  controller_->TimerLoop();
+}
+
+bool RequestController::TimerDelegate::exitThreadMain() {
+  controller_->Stop();
+  return true;
+}
+
 RequestController::RequestController()
-  : watchdog_(NULL) {
+  : stopped_(false),
+    timer_("RequestTimerThread", new TimerDelegate(this)) {
   LOG4CXX_INFO(logger_, "RequestController::RequestController()");
-  watchdog_ = new request_watchdog::RequestWatchdog;
-  watchdog_->AddListener(this);
+  timer_.start();
 }
 
 RequestController::~RequestController() {
   LOG4CXX_INFO(logger_, "RequestController::~RequestController()");
-  request_list_.clear();
+  timer_.stop();
 
-  if (watchdog_) {
-    watchdog_->RemoveListener(this);
-    delete watchdog_; 
-    watchdog_ = NULL;
+  AutoLock auto_lock(request_list_lock_);
+  while (!requests_.empty()) {
+    removeRequest(requests_.begin());
   }
 }
 
@@ -67,90 +85,96 @@ RequestController::TResult RequestController::addRequest(
     const Request& request, const mobile_apis::HMILevel::eType& hmi_level) {
   LOG4CXX_INFO(logger_, "RequestController::addRequest()");
 
-  RequestController::TResult result = RequestController::SUCCESS;
-  {
-    AutoLock auto_lock(request_list_lock_);
-
-    const commands::CommandRequestImpl* request_impl =
-      static_cast<commands::CommandRequestImpl*>(request.get());
-
-    const uint32_t& app_hmi_level_none_time_scale =
-        profile::Profile::instance()->app_hmi_level_none_time_scale();
-
-    const uint32_t& app_hmi_level_none_max_request_per_time_scale =
-     profile::Profile::instance()->app_hmi_level_none_time_scale_max_requests();
-
-    const uint32_t& app_time_scale =
-        profile::Profile::instance()->app_time_scale();
-
-    const uint32_t& max_request_per_time_scale =
-        profile::Profile::instance()->app_time_scale_max_requests();
-
-    const uint32_t& pending_requests_amount =
-        profile::Profile::instance()->pending_requests_amount();
-
-    const mobile_apis::HMILevel::eType hmi_level =
-        mobile_apis::HMILevel::HMI_NONE;
-
-    if (false == watchdog_->checkHMILevelTimeScaleMaxRequest(hmi_level,
-                  request_impl->connection_key(), app_hmi_level_none_time_scale,
-                  app_hmi_level_none_max_request_per_time_scale)) {
-      LOG4CXX_ERROR(logger_, "Too many application requests in hmi level NONE");
-      result = RequestController::NONE_HMI_LEVEL_MANY_REQUESTS;
-    } else if (false == watchdog_->checkTimeScaleMaxRequest(
-                                  request_impl->connection_key(),
-                                  app_time_scale, max_request_per_time_scale)) {
-      LOG4CXX_ERROR(logger_, "Too many application requests");
-      result = RequestController::TOO_MANY_REQUESTS;
-    } else if (pending_requests_amount == request_list_.size()) {
-      LOG4CXX_ERROR(logger_, "Too many pending request");
-      result = RequestController::TOO_MANY_PENDING_REQUESTS;
-    } else {
-
-      request_list_.push_back(request);
-      LOG4CXX_INFO(logger_, "RequestController size is " <<
-                   request_list_.size());
-
-      if (0 == request_impl->default_timeout()) {
-        LOG4CXX_INFO(logger_, "Default timeout was set to 0. Watchdog will not "
-                     "track this request.");
-        return result;
-      }
-
-      LOG4CXX_INFO(logger_, "Adding request to watchdog. Default timeout is "
-                   << request_impl->default_timeout());
-
-      watchdog_->addRequest(new request_watchdog::RequestInfo(
-                              request_impl->function_id(),
-                              request_impl->connection_key(),
-                              request_impl->correlation_id(),
-                              request_impl->default_timeout(),
-                              hmi_level));
-
-      LOG4CXX_INFO(logger_, "Added request to watchdog.");      
-    }
+  const commands::CommandRequestImpl* request_impl =
+    static_cast<commands::CommandRequestImpl*>(request.get());
+
+  const uint32_t& app_hmi_level_none_time_scale =
+      profile::Profile::instance()->app_hmi_level_none_time_scale();
+
+  const uint32_t& app_hmi_level_none_max_request_per_time_scale =
+   profile::Profile::instance()->app_hmi_level_none_time_scale_max_requests();
+
+  const uint32_t& app_time_scale =
+      profile::Profile::instance()->app_time_scale();
+
+  const uint32_t& max_request_per_time_scale =
+      profile::Profile::instance()->app_time_scale_max_requests();
+
+  const uint32_t& pending_requests_amount =
+      profile::Profile::instance()->pending_requests_amount();
+
+  const uint32_t connection_key = request_impl->connection_key();
+
+  AutoLock auto_lock(request_list_lock_);
+  if (mobile_apis::HMILevel::HMI_NONE == hmi_level &&
+      false == checkTimeScaleMaxRequest(connection_key, hmi_level,
+                 app_hmi_level_none_time_scale,
+                 app_hmi_level_none_max_request_per_time_scale)) {
+    LOG4CXX_ERROR(logger_, "Too many application requests in hmi level NONE");
+    return RequestController::NONE_HMI_LEVEL_MANY_REQUESTS;
+  }
+  if (false == checkTimeScaleMaxRequest(connection_key,
+                 mobile_apis::HMILevel::INVALID_ENUM,
+                 app_time_scale, max_request_per_time_scale)) {
+    LOG4CXX_ERROR(logger_, "Too many application requests");
+    return RequestController::TOO_MANY_REQUESTS;
+  }
+  if (pending_requests_amount <= requests_.size()) {
+    LOG4CXX_ERROR(logger_, "Too many pending request");
+    return RequestController::TOO_MANY_PENDING_REQUESTS;
+  }
+
+  const RequestKey key(connection_key, request_impl->correlation_id());
+  Requests::iterator it = requests_.find(key);
+  if (requests_.end() != it) {
+    LOG4CXX_WARN(logger_, "Request " << key.second << " of application "
+                 << key.first << " replaces pending one with same id");
+    removeRequest(it);
+  }
+
+  RequestInfo* info = new RequestInfo();
+  info->request = request;
+  info->key = key;
+  info->hmi_level = hmi_level;
+  info->start_time = date_time::DateTime::getCurrentTime();
+  info->has_deadline = false;
+  requests_.insert(std::make_pair(key, info));
+
+  AppsRequests::iterator app = apps_requests_.find(connection_key);
+  if (apps_requests_.end() == app) {
+    AppRequests empty = { NULL, NULL };
+    app = apps_requests_.insert(std::make_pair(connection_key, empty)).first;
+  }
+  info->app_prev = app->second.last;
+  info->app_next = NULL;
+  if (app->second.last) {
+    app->second.last->app_next = info;
+  } else {
+    app->second.first = info;
   }
+  app->second.last = info;
 
-  return result;
+  LOG4CXX_INFO(logger_, "RequestController size is " << requests_.size());
+
+  if (0 == request_impl->default_timeout()) {
+    LOG4CXX_INFO(logger_, "Default timeout was set to 0. Request timeout "
+                 "will not be tracked.");
+  } else {
+    setDeadline(info, request_impl->default_timeout());
+  }
+  return RequestController::SUCCESS;
 }
 
 void RequestController::terminateRequest(
+    const uint32_t& connection_key,
     const uint32_t& mobile_correlation_id) {
   LOG4CXX_INFO(logger_, "RequestController::terminateRequest()");
 
-  {
-    AutoLock auto_lock(request_list_lock_);
-    std::list<Request>::iterator it = request_list_.begin();
-    for (; request_list_.end() != it; ++it) {
-      const commands::CommandRequestImpl* request_impl =
-        static_cast<commands::CommandRequestImpl*>(it->get());
-      if (request_impl->correlation_id() == mobile_correlation_id) {
-        watchdog_->removeRequest(
-          request_impl->connection_key(), request_impl->correlation_id());
-        request_list_.erase(it);
-        break;
-      }
-    }
+  AutoLock auto_lock(request_list_lock_);
+  Requests::iterator it =
+    requests_.find(RequestKey(connection_key, mobile_correlation_id));
+  if (requests_.end() != it) {
+    removeRequest(it);
   }
 }
 
@@ -158,21 +182,25 @@ void RequestController::terminateAppRequests(
     const uint32_t& app_id) {
   LOG4CXX_INFO(logger_, "RequestController::terminateAppRequests()");
 
-  {
-    AutoLock auto_lock(request_list_lock_);
-    std::list<Request>::iterator it = request_list_.begin();
-    while (request_list_.end() != it) {
-      const commands::CommandRequestImpl* request_impl =
-          static_cast<commands::CommandRequestImpl*>(it->get());
-      if (request_impl->connection_key() == app_id) {
-        watchdog_->removeRequest(
-          request_impl->connection_key(), request_impl->correlation_id());
-        it = request_list_.erase(it);
-      } else {
-        ++it;
-      }
-    }
+  AutoLock auto_lock(request_list_lock_);
+  AppsRequests::iterator app = apps_requests_.find(app_id);
+  // removing the last request of application removes its entry as well
+  while (apps_requests_.end() != app) {
+    removeRequest(requests_.find(app->second.first->key));
+    app = apps_requests_.find(app_id);
+  }
+}
+
+RequestController::Request RequestController::findRequest(
+    const uint32_t& connection_key,
+    const uint32_t& mobile_correlation_id) {
+  AutoLock auto_lock(request_list_lock_);
+  Requests::const_iterator it =
+    requests_.find(RequestKey(connection_key, mobile_correlation_id));
+  if (requests_.end() == it) {
+    return Request();
   }
+  return it->second->request;
 }
 
 void RequestController::updateRequestTimeout(
@@ -181,35 +209,127 @@ void RequestController::updateRequestTimeout(
     const uint32_t& new_timeout) {
   LOG4CXX_INFO(logger_, "RequestController::updateRequestTimeout()");
 
-  watchdog_->updateRequestTimeout(connection_key,
-                                  mobile_correlation_id,
-                                  new_timeout);
-}
-
-void RequestController::onTimeoutExpired(
-    const request_watchdog::RequestInfo& info) {
-  LOG4CXX_INFO(logger_, "RequestController::onTimeoutExpired()");
-
-  commands::CommandRequestImpl* request_impl = NULL;
-  {
-    AutoLock auto_lock(request_list_lock_);
-    std::list<Request>::iterator it = request_list_.begin();
-    for (; request_list_.end() != it; ++it) {
-      request_impl = static_cast<commands::CommandRequestImpl*>(it->get());
-      if (request_impl->correlation_id() == info.correlationID_ &&
-          request_impl->connection_key() == info.connectionID_) {
-        LOG4CXX_INFO(logger_, "Timeout for request id " << info.correlationID_
-                     << " of application " << info.connectionID_ << " expired");
-        break;
-      }
+  AutoLock auto_lock(request_list_lock_);
+  Requests::iterator it =
+    requests_.find(RequestKey(connection_key, mobile_correlation_id));
+  if (requests_.end() == it) {
+    LOG4CXX_WARN(logger_, "Request " << mobile_correlation_id
+                 << " of application " << connection_key << " is not found");
+    return;
+  }
+  // Expired request is tracked again with new timeout
+  setDeadline(it->second, new_timeout);
+}
+
+void RequestController::TimerLoop() {
+  AutoLock auto_lock(request_list_lock_);
+  while (!stopped_) {
+    if (deadlines_.empty()) {
+      deadlines_changed_.Wait(auto_lock);
+      continue;
+    }
+    const int64_t wait_time = deadlines_.begin()->first -
+      date_time::DateTime::getmSecs(date_time::DateTime::getCurrentTime());
+    if (0 < wait_time) {
+      deadlines_changed_.WaitFor(auto_lock, static_cast<int32_t>(wait_time));
+      continue;
+    }
+
+    RequestInfo* info = deadlines_.begin()->second;
+    clearDeadline(info);
+    LOG4CXX_INFO(logger_, "Timeout for request id " << info->key.second
+                 << " of application " << info->key.first << " expired");
+    // Request stays registered until response terminates it,
+    // reference keeps it alive if it is terminated meanwhile
+    const Request request = info->request;
+    {
+      AutoUnlock auto_unlock(auto_lock);
+      static_cast<commands::CommandRequestImpl*>(request.get())->onTimeOut();
+    }
+  }
+}
+
+void RequestController::Stop() {
+  AutoLock auto_lock(request_list_lock_);
+  stopped_ = true;
+  deadlines_changed_.NotifyOne();
+}
+
+bool RequestController::checkTimeScaleMaxRequest(
+    const uint32_t& connection_key,
+    const mobile_apis::HMILevel::eType hmi_level,
+    const uint32_t& app_time_scale,
+    const uint32_t& max_request_per_time_scale) {
+  AppsRequests::const_iterator app = apps_requests_.find(connection_key);
+  if (apps_requests_.end() == app) {
+    return true;
+  }
+  const TimevalStruct now = date_time::DateTime::getCurrentTime();
+  const int64_t scale_start = now.tv_sec - app_time_scale;
+
+  // Requests of application are in arrival order, so only requests
+  // of time scale are visited
+  uint32_t count = 0;
+  for (const RequestInfo* info = app->second.last;
+       info && info->start_time.tv_sec >= scale_start;
+       info = info->app_prev) {
+    if (mobile_apis::HMILevel::INVALID_ENUM == hmi_level ||
+        info->hmi_level == hmi_level) {
+      ++count;
     }
   }
 
-  if (request_impl) {
-    request_impl->onTimeOut();
+  if (count >= max_request_per_time_scale) {
+    LOG4CXX_ERROR(logger_, "Requests count " << count <<
+                  " exceed application limit " << max_request_per_time_scale);
+    return false;
+  }
+  return true;
+}
+
+void RequestController::setDeadline(RequestInfo* info,
+                                    const uint32_t& timeout) {
+  clearDeadline(info);
+  const int64_t deadline =
+    date_time::DateTime::getmSecs(date_time::DateTime::getCurrentTime()) +
+    timeout + kHmiResponseDelay;
+  info->deadline = deadlines_.insert(std::make_pair(deadline, info));
+  info->has_deadline = true;
+  if (deadlines_.begin() == info->deadline) {
+    deadlines_changed_.NotifyOne();
+  }
+}
+
+void RequestController::clearDeadline(RequestInfo* info) {
+  if (info->has_deadline) {
+    deadlines_.erase(info->deadline);
+    info->has_deadline = false;
   }
 }
 
+void RequestController::removeRequest(Requests::iterator it) {
+  RequestInfo* info = it->second;
+  clearDeadline(info);
+
+  AppsRequests::iterator app = apps_requests_.find(info->key.first);
+  if (info->app_prev) {
+    info->app_prev->app_next = info->app_next;
+  } else {
+    app->second.first = info->app_next;
+  }
+  if (info->app_next) {
+    info->app_next->app_prev = info->app_prev;
+  } else {
+    app->second.last = info->app_prev;
+  }
+  if (!app->second.first) {
+    apps_requests_.erase(app);
+  }
+
+  requests_.erase(it);
+  delete info;
+}
+
 }  //  namespace request_controller
 
 }  //  namespace application_manager
@@ -1,7 +1,9 @@
 #ifdef MODIFY_FUNCTION_SIGN
 #include <global_first.h>
 #endif
+#include <cstdlib>
 #include <fstream>
+#include <sstream>
 
 #include "application_manager/resume_ctrl.h"
 #include "config_profile/profile.h"
@@ -22,19 +24,143 @@ CREATE_LOGGERPTR_GLOBAL(logger_, "ResumeCtrl")
 
 namespace Formatters = NsSmartDeviceLink::NsJSONHandler::Formatters;
 
+namespace {
+
+std::string IdToKey(uint32_t id) {
+  std::stringstream stream;
+  stream << id;
+  return stream.str();
+}
+
+resumption::LastState::Path AppendPath(const resumption::LastState::Path& path,
+                                       const std::string& member) {
+  resumption::LastState::Path result(path);
+  result.push_back(member);
+  return result;
+}
+
+
+/**
+ * @brief Key of application data part in saved application
+ */
+const char* DataPartKey(ResumptionDataPart part) {
+  switch (part) {
+    case kCommandsData:
+      return strings::application_commands;
+    case kSubMenusData:
+      return strings::application_submenus;
+    case kChoiceSetsData:
+      return strings::application_choise_sets;
+    case kFilesData:
+      return strings::application_files;
+    default:
+      NOTREACHED();
+      return "";
+  }
+}
+
+/**
+ * @brief Saved items keyed by id ordered numerically, json object
+ * members are iterated in lexicographic order ("10" before "2")
+ */
+typedef std::map<uint32_t, const Json::Value*> SortedJsonItems;
+
+SortedJsonItems SortById(const Json::Value& items) {
+  SortedJsonItems result;
+  if (items.isArray()) {
+    for (Json::ArrayIndex i = 0; i < items.size(); ++i) {
+      result[i] = &items[i];
+    }
+    return result;
+  }
+  if (!items.isObject()) {
+    return result;
+  }
+  const Json::Value::Members members = items.getMemberNames();
+  for (Json::Value::Members::const_iterator it = members.begin();
+      it != members.end(); ++it) {
+    result[strtoul(it->c_str(), NULL, 10)] = &items[*it];
+  }
+  return result;
+}
+
+/**
+ * @brief Path to saved applications in last state,
+ * applications are keyed by mobile app id
+ */
+resumption::LastState::Path SavedApplicationsPath() {
+  return resumption::LastState::Path(1, strings::resumption);
+}
+
+/**
+ * @brief Record in last state only members of value which differ from
+ * saved ones, objects are compared member by member
+ */
+void UpdateSavedValue(const resumption::LastState::Path& path,
+                      const Json::Value& saved,
+                      const Json::Value& value) {
+  if (saved == value) {
+    return;
+  }
+  if (!saved.isObject() || !value.isObject()) {
+    resumption::LastState::instance()->SetValue(path, value);
+    return;
+  }
+
+  const Json::Value::Members saved_members = saved.getMemberNames();
+  for (Json::Value::Members::const_iterator it = saved_members.begin();
+      it != saved_members.end(); ++it) {
+    if (!value.isMember(*it)) {
+      resumption::LastState::instance()->RemoveValue(AppendPath(path, *it));
+    }
+  }
+  const Json::Value::Members members = value.getMemberNames();
+  for (Json::Value::Members::const_iterator it = members.begin();
+      it != members.end(); ++it) {
+    UpdateSavedValue(AppendPath(path, *it), saved[*it], value[*it]);
+  }
+}
+
+}  // namespace
+
 ResumeCtrl::ResumeCtrl(ApplicationManagerImpl* app_mngr)
   : app_mngr_(app_mngr),
-    timer_(this, &ResumeCtrl::onTimer) {
+    timer_(this, &ResumeCtrl::onTimer),
+    restoration_timer_(this, &ResumeCtrl::onRestorationTimer, true),
+    restoration_timer_started_(false) {
+  // Applications were stored as array before, key them by mobile app id
+  const Json::Value saved_apps = GetSavedApplications();
+  if (saved_apps.isArray()) {
+    Json::Value apps_json(Json::objectValue);
+    for (Json::Value::const_iterator it = saved_apps.begin();
+        it != saved_apps.end(); ++it) {
+      apps_json[(*it)[strings::app_id].asString()] = *it;
+    }
+    resumption::LastState::instance()->SetValue(SavedApplicationsPath(),
+                                                apps_json);
+  }
+}
+
+ResumeCtrl::~ResumeCtrl() {
+  restoration_timer_.stop();
+
+  std::map<uint32_t, RestorationBatch>::iterator it =
+      restoration_batches_.begin();
+  for (; restoration_batches_.end() != it; ++it) {
+    std::deque<smart_objects::SmartObject*>& queued = it->second.queued;
+    for (size_t i = 0; i < queued.size(); ++i) {
+      delete queued[i];
+    }
+  }
 }
 
 void ResumeCtrl::SaveAllApplications() {
   LOG4CXX_INFO(logger_, "ResumeCtrl::SaveApplications()");
   DCHECK(app_mngr_);
 
-  std::set<ApplicationSharedPtr>::iterator it = 
-								  app_mngr_->application_list_.begin();
-  std::set<ApplicationSharedPtr>::iterator it_end =
-								   app_mngr_->application_list_.end();
+  const std::set<ApplicationSharedPtr> apps = app_mngr_->applications();
+  std::set<ApplicationSharedPtr>::const_iterator it = apps.begin();
+  std::set<ApplicationSharedPtr>::const_iterator it_end = apps.end();
   for (; it != it_end; ++it) {
     SaveApplication(*it);
   }
@@ -45,65 +171,123 @@ void ResumeCtrl::SaveApplication(ApplicationConstSharedPtr application) {
 
   DCHECK(application.get());
 
-  Json::Value* json_app = NULL;
-
   const std::string& m_app_id = application->mobile_app_id()->asString();
-  Json::Value::iterator it = GetSavedApplications().begin();
-  for (; it != GetSavedApplications().end(); ++it) {
-    if (m_app_id == (*it)[strings::app_id].asString()) {
-      json_app = &(*it);
-      LOG4CXX_INFO(logger_, "ResumeCtrl Application with this id "
-                            "already exist ( update info )."
-                            "mobile app_id = " << m_app_id);
-      break;
-    }
-  }
-
-  if (json_app == NULL) {
-    LOG4CXX_INFO(logger_, "ResumeCtrl Application with this ID does not"
-         "exist. Add new. mobile app_id = " << m_app_id);
-    json_app = &(GetSavedApplications().append(Json::Value()));
-  }
-
   uint32_t hash = application->curHash();
   uint32_t grammar_id = application->get_grammar_id();
 
   LOG4CXX_INFO(logger_, "Hash = " << hash);
-  (*json_app)[strings::device_mac] =
+  Json::Value json_app;
+  json_app[strings::device_mac] =
       MessageHelper::GetDeviceMacAddressForHandle(application->device());
-  (*json_app)[strings::app_id] = m_app_id;
-  (*json_app)[strings::grammar_id] = grammar_id;
-  (*json_app)[strings::connection_key] = application->app_id();
-  (*json_app)[strings::hmi_app_id] = application->hmi_app_id();
-  (*json_app)[strings::hmi_level] =
+  json_app[strings::app_id] = m_app_id;
+  json_app[strings::grammar_id] = grammar_id;
+  json_app[strings::connection_key] = application->app_id();
+  json_app[strings::hmi_app_id] = application->hmi_app_id();
+  json_app[strings::hmi_level] =
       static_cast<int32_t> (application->hmi_level());
-  (*json_app)[strings::ign_off_count] = 0;
-  (*json_app)[strings::hash_id] = hash;
-  (*json_app)[strings::application_commands] =
-      GetApplicationCommands(application);
-  (*json_app)[strings::application_submenus] =
-      GetApplicationSubMenus(application);
-  (*json_app)[strings::application_choise_sets] =
-      GetApplicationInteractionChoiseSets(application);
-  (*json_app)[strings::application_global_properties] =
+  json_app[strings::ign_off_count] = 0;
+  json_app[strings::hash_id] = hash;
+  json_app[strings::application_global_properties] =
       GetApplicationGlobalProperties(application);
-  (*json_app)[strings::application_subscribtions] =
+  json_app[strings::application_subscribtions] =
       GetApplicationSubscriptions(application);
-  (*json_app)[strings::application_files] = GetApplicationFiles(application);
-  (*json_app)[strings::time_stamp] = (uint32_t)time(NULL);
-  (*json_app)[strings::audio_streaming_state] = application->audio_streaming_state();
+  json_app[strings::time_stamp] = (uint32_t)time(NULL);
+  json_app[strings::audio_streaming_state] = application->audio_streaming_state();
+
+  sync_primitives::AutoLock lock(saved_versions_lock_);
+  const resumption::LastState::Path app_path =
+      AppendPath(SavedApplicationsPath(), m_app_id);
+  const Json::Value saved_app =
+      resumption::LastState::instance()->GetValue(app_path);
+  std::map<std::string, SavedDataVersions>::iterator versions_it =
+      saved_versions_.find(m_app_id);
+  const bool versions_known = saved_versions_.end() != versions_it &&
+      versions_it->second.app_id == application->app_id();
+
+  SavedDataVersions versions;
+  versions.app_id = application->app_id();
+  for (int32_t part = 0; part < kResumptionDataPartsCount; ++part) {
+    versions.versions[part] = application->data_version(
+        static_cast<ResumptionDataPart>(part));
+  }
+
+  if (!saved_app.isNull()) {
+    LOG4CXX_INFO(logger_, "ResumeCtrl Application with this id "
+                          "already exist ( update info )."
+                          "mobile app_id = " << m_app_id);
+    const Json::Value::Members members = json_app.getMemberNames();
+    for (Json::Value::Members::const_iterator it = members.begin();
+        it != members.end(); ++it) {
+      UpdateSavedValue(AppendPath(app_path, *it), saved_app[*it],
+                       json_app[*it]);
+    }
+    // Commands, sub menus, choice sets and files are converted only if
+    // they were modified since previous save of this application
+    for (int32_t part = 0; part < kResumptionDataPartsCount; ++part) {
+      if (versions_known &&
+          versions_it->second.versions[part] == versions.versions[part]) {
+        continue;
+      }
+      const char* key = DataPartKey(static_cast<ResumptionDataPart>(part));
+      UpdateSavedValue(AppendPath(app_path, key), saved_app[key],
+                       GetApplicationDataPart(
+                           application, static_cast<ResumptionDataPart>(part)));
+    }
+  } else {
+    LOG4CXX_INFO(logger_, "ResumeCtrl Application with this ID does not"
+         "exist. Add new. mobile app_id = " << m_app_id);
+    for (int32_t part = 0; part < kResumptionDataPartsCount; ++part) {
+      json_app[DataPartKey(static_cast<ResumptionDataPart>(part))] =
+          GetApplicationDataPart(application,
+                                 static_cast<ResumptionDataPart>(part));
+    }
+    resumption::LastState::instance()->SetValue(app_path, json_app);
+  }
+  saved_versions_[m_app_id] = versions;
+}
+
+void ResumeCtrl::OnApplicationDataChanged(
+    ApplicationConstSharedPtr application) {
+  DCHECK(application.get());
+  {
+    sync_primitives::AutoLock auto_lock(queue_lock_);
+    std::multiset<application_timestamp, TimeStampComparator>::const_iterator
+        it = waiting_for_timer_.begin();
+    for (; waiting_for_timer_.end() != it; ++it) {
+      if (it->first == application->app_id()) {
+        // Saved HMI level is not restored yet, it is saved on next change
+        LOG4CXX_INFO(logger_, "Application " << application->app_id()
+                     << " waits for HMI level resumption");
+        return;
+      }
+    }
+  }
+  SaveApplication(application);
 }
 
 void ResumeCtrl::on_event(const event_engine::Event& event) {
   LOG4CXX_INFO(logger_, "ResumeCtrl::on_event ");
+
+  const int32_t correlation_id = event.smart_object_correlation_id();
+  unsubscribe_from_event(event.id(), correlation_id);
+
+  const hmi_apis::Common_Result::eType result_code =
+      static_cast<hmi_apis::Common_Result::eType>(
+          event.smart_object()[strings::params][hmi_response::code].asInt());
+  const bool success = hmi_apis::Common_Result::SUCCESS == result_code ||
+                       hmi_apis::Common_Result::WARNINGS == result_code;
+
+  OnRestorationResponse(correlation_id, success);
+  SendRestorationRequests();
 }
 
 bool ResumeCtrl::RestoreApplicationHMILevel(ApplicationSharedPtr application) {
   LOG4CXX_INFO(logger_, "ResumeCtrl::RestoreApplicationHMILevel");
   DCHECK(application.get());
 
-  for (Json::Value::iterator it = GetSavedApplications().begin();
-      it != GetSavedApplications().end(); ++it) {
+  const Json::Value saved_apps = GetSavedApplications();
+  for (Json::Value::const_iterator it = saved_apps.begin();
+      it != saved_apps.end(); ++it) {
     const std::string& saved_m_app_id = (*it)[strings::app_id].asString();
 
     if (saved_m_app_id == application->mobile_app_id()->asString()) {
@@ -149,37 +333,39 @@ bool ResumeCtrl::RestoreApplicationData(ApplicationSharedPtr application) {
   LOG4CXX_INFO(logger_, "RestoreApplicationData");
   DCHECK(application.get());
 
-  Json::Value::iterator it = GetSavedApplications().begin();
-  for (; it != GetSavedApplications().end(); ++it) {
+  const Json::Value saved_apps = GetSavedApplications();
+  Json::Value::const_iterator it = saved_apps.begin();
+  for (; it != saved_apps.end(); ++it) {
     const std::string& saved_m_app_id = (*it)[strings::app_id].asString();
     if (saved_m_app_id == application->mobile_app_id()->asString()) {
       break;
     }
   }
 
-  if (it == GetSavedApplications().end()) {
+  if (it == saved_apps.end()) {
     LOG4CXX_WARN(logger_, "Application not saved");
     return false;
   }
 
-  Json::Value& saved_app = *it;
+  const Json::Value& saved_app = *it;
   MessageHelper::SmartObjectList requests;
+  RequestList restoration_requests;
 
   LOG4CXX_INFO(logger_, saved_app.toStyledString());
-  Json::Value& app_commands = saved_app[strings::application_commands];
-  Json::Value& app_submenus = saved_app[strings::application_submenus];
-  Json::Value& app_choise_sets = saved_app[strings::application_choise_sets];
-  Json::Value& global_properties = saved_app[strings::application_global_properties];
-  Json::Value& subscribtions = saved_app[strings::application_subscribtions];
-  Json::Value& application_files = saved_app[strings::application_files];
+  const Json::Value& app_commands = saved_app[strings::application_commands];
+  const Json::Value& app_submenus = saved_app[strings::application_submenus];
+  const Json::Value& app_choise_sets = saved_app[strings::application_choise_sets];
+  const Json::Value& global_properties = saved_app[strings::application_global_properties];
+  const Json::Value& subscribtions = saved_app[strings::application_subscribtions];
+  const Json::Value& application_files = saved_app[strings::application_files];
   uint32_t app_grammar_id = saved_app[strings::grammar_id].asUInt();
   application->set_grammar_id(app_grammar_id);
 
 
   // files
-  for (Json::Value::iterator json_it = application_files.begin();
+  for (Json::Value::const_iterator json_it = application_files.begin();
       json_it != application_files.end(); ++json_it)  {
-    Json::Value& file_data = *json_it;
+    const Json::Value& file_data = *json_it;
 
     bool is_persistent = file_data[strings::persistent_file].asBool();
     if (is_persistent) {
@@ -194,25 +380,24 @@ bool ResumeCtrl::RestoreApplicationData(ApplicationSharedPtr application) {
   }
 
   //add submenus
-  for (Json::Value::iterator json_it = app_submenus.begin();
-      json_it != app_submenus.end(); ++json_it)  {
-    Json::Value& json_submenu = *json_it;
+  const SortedJsonItems submenus = SortById(app_submenus);
+  for (SortedJsonItems::const_iterator json_it = submenus.begin();
+      json_it != submenus.end(); ++json_it)  {
+    const Json::Value& json_submenu = *json_it->second;
     smart_objects::SmartObject message = smart_objects::SmartObject(
                                          smart_objects::SmartType::SmartType_Map);
     Formatters::CFormatterJsonBase::jsonValueToObj(json_submenu, message);
     application->AddSubMenu(message[strings::menu_id].asUInt(), message);
   }
   requests = MessageHelper::CreateAddSubMenuRequestToHMI(application);
-
-  for (MessageHelper::SmartObjectList::iterator it = requests.begin();
-       it != requests.end(); ++it) {
-    ProcessHMIRequest(*it, true);
-  }
+  restoration_requests.insert(restoration_requests.end(),
+                              requests.begin(), requests.end());
 
   //add commands
-  for (Json::Value::iterator json_it = app_commands.begin();
-      json_it != app_commands.end(); ++json_it)  {
-    Json::Value& json_command = *json_it;
+  const SortedJsonItems commands = SortById(app_commands);
+  for (SortedJsonItems::const_iterator json_it = commands.begin();
+      json_it != commands.end(); ++json_it)  {
+    const Json::Value& json_command = *json_it->second;
     smart_objects::SmartObject message = smart_objects::SmartObject(
                                          smart_objects::SmartType::SmartType_Map);
     Formatters::CFormatterJsonBase::jsonValueToObj(json_command, message);
@@ -220,16 +405,14 @@ bool ResumeCtrl::RestoreApplicationData(ApplicationSharedPtr application) {
   }
 
   requests = MessageHelper::CreateAddCommandRequestToHMI(application);
-
-  for (MessageHelper::SmartObjectList::iterator it = requests.begin();
-       it != requests.end(); ++it) {
-    ProcessHMIRequest(*it, true);
-  }
+  restoration_requests.insert(restoration_requests.end(),
+                              requests.begin(), requests.end());
 
   //add choisets
-  for (Json::Value::iterator json_it = app_choise_sets.begin();
-      json_it != app_choise_sets.end(); ++json_it)  {
-    Json::Value& json_choiset = *json_it;
+  const SortedJsonItems choice_sets = SortById(app_choise_sets);
+  for (SortedJsonItems::const_iterator json_it = choice_sets.begin();
+      json_it != choice_sets.end(); ++json_it)  {
+    const Json::Value& json_choiset = *json_it->second;
     smart_objects::SmartObject msg_param = smart_objects::SmartObject(
                                          smart_objects::SmartType::SmartType_Map);
     Formatters::CFormatterJsonBase::jsonValueToObj(json_choiset , msg_param);
@@ -251,7 +434,8 @@ bool ResumeCtrl::RestoreApplicationData(ApplicationSharedPtr application) {
 
       choise_params[strings::type] = hmi_apis::Common_VRCommandType::Choice;
       choise_params[strings::grammar_id] =  choice_grammar_id;
-      SendHMIRequest(hmi_apis::FunctionID::VR_AddCommand, &choise_params);
+      restoration_requests.push_back(
+          CreateHMIRequest(hmi_apis::FunctionID::VR_AddCommand, choise_params));
     }
   }
 
@@ -310,21 +494,23 @@ bool ResumeCtrl::RestoreApplicationData(ApplicationSharedPtr application) {
       application->set_menu_icon(menu_icon);
     }
 
-    MessageHelper::SendGlobalPropertiesToHMI(application);
+    requests = MessageHelper::CreateGlobalPropertiesRequestsToHMI(application);
+    restoration_requests.insert(restoration_requests.end(),
+                                requests.begin(), requests.end());
   }
 
   //subscribes
   if (!subscribtions.isNull()) {
-    Json::Value& subscribtions_buttons = subscribtions[strings::application_buttons];
-    Json::Value& subscribtions_ivi= subscribtions[strings::application_vehicle_info];
-    for (Json::Value::iterator json_it = subscribtions_buttons.begin();
+    const Json::Value& subscribtions_buttons = subscribtions[strings::application_buttons];
+    const Json::Value& subscribtions_ivi= subscribtions[strings::application_vehicle_info];
+    for (Json::Value::const_iterator json_it = subscribtions_buttons.begin();
          json_it != subscribtions_buttons.end(); ++json_it) {
       mobile_apis::ButtonName::eType btn;
       btn = static_cast<mobile_apis::ButtonName::eType>((*json_it).asInt());
       application->SubscribeToButton(btn);
     }
 
-    for (Json::Value::iterator json_it = subscribtions_ivi.begin();
+    for (Json::Value::const_iterator json_it = subscribtions_ivi.begin();
          json_it != subscribtions_ivi.end(); ++json_it) {
       VehicleDataType ivi;
       ivi = static_cast<VehicleDataType>((*json_it).asInt());
@@ -333,20 +519,20 @@ bool ResumeCtrl::RestoreApplicationData(ApplicationSharedPtr application) {
       LOG4CXX_INFO(logger_, "result = :" <<  result);
     }
     requests = MessageHelper::GetIVISubscribtionRequests(application->app_id());
-
-    for (MessageHelper::SmartObjectList::iterator it = requests.begin();
-         it != requests.end(); ++it) {
-      ProcessHMIRequest(*it,true);
-    }
+    restoration_requests.insert(restoration_requests.end(),
+                                requests.begin(), requests.end());
   }
+
+  StartRestoration(application->app_id(), restoration_requests);
   return true;
 }
 
 bool ResumeCtrl::IsHMIApplicationIdExist(uint32_t hmi_app_id) {
   LOG4CXX_INFO(logger_, "ResumeCtrl::IsHMIApplicationIdExist " << hmi_app_id);
 
-  for (Json::Value::iterator it = GetSavedApplications().begin();
-      it != GetSavedApplications().end(); ++it) {
+  const Json::Value saved_apps = GetSavedApplications();
+  for (Json::Value::const_iterator it = saved_apps.begin();
+      it != saved_apps.end(); ++it) {
     if ((*it)[strings::hmi_app_id].asUInt() == hmi_app_id) {
       return true;
     }
@@ -358,8 +544,9 @@ bool ResumeCtrl::IsHMIApplicationIdExist(uint32_t hmi_app_id) {
 bool ResumeCtrl::IsApplicationSaved(const std::string& mobile_app_id) {
   LOG4CXX_INFO(logger_, "ResumeCtrl::IsApplicationSaved " << mobile_app_id);
 
-  for (Json::Value::iterator it = GetSavedApplications().begin();
-      it != GetSavedApplications().end(); ++it) {
+  const Json::Value saved_apps = GetSavedApplications();
+  for (Json::Value::const_iterator it = saved_apps.begin();
+      it != saved_apps.end(); ++it) {
     if ((*it)[strings::app_id].asString() == mobile_app_id) {
       return true;
     }
@@ -370,8 +557,9 @@ bool ResumeCtrl::IsApplicationSaved(const std::string& mobile_app_id) {
 
 uint32_t ResumeCtrl::GetHMIApplicationID(const std::string& mobile_app_id) {
   uint32_t hmi_app_id = 0;
-  for (Json::Value::iterator it = GetSavedApplications().begin();
-      it != GetSavedApplications().end(); ++it) {
+  const Json::Value saved_apps = GetSavedApplications();
+  for (Json::Value::const_iterator it = saved_apps.begin();
+      it != saved_apps.end(); ++it) {
     if ((*it)[strings::app_id].asString() == mobile_app_id) {
       hmi_app_id = (*it)[strings::hmi_app_id].asUInt();
     }
@@ -384,45 +572,39 @@ bool ResumeCtrl::RemoveApplicationFromSaved(ApplicationConstSharedPtr applicatio
   LOG4CXX_INFO(logger_, "ResumeCtrl::RemoveApplicationFromSaved ");
   DCHECK(application.get());
 
-  bool result = false;
-  std::vector<Json::Value> temp;
-  for (Json::Value::iterator it = GetSavedApplications().begin();
-      it != GetSavedApplications().end(); ++it) {
-    const std::string& saved_m_app_id = (*it)[strings::app_id].asString();
-
-    if (saved_m_app_id != application->mobile_app_id()->asString()) {
-      temp.push_back((*it));
-    } else {
-      result = true;
-    }
-  }
-
-  if (false == result) {
-    return result;
+  const std::string& m_app_id = application->mobile_app_id()->asString();
+  const resumption::LastState::Path app_path =
+      AppendPath(SavedApplicationsPath(), m_app_id);
+  if (resumption::LastState::instance()->GetValue(app_path).isNull()) {
+    return false;
   }
 
-  GetSavedApplications().clear();
-  for (std::vector<Json::Value>::iterator it = temp.begin();
-      it != temp.end(); ++it) {
-    GetSavedApplications().append((*it));
-  }
-  return result;
+  sync_primitives::AutoLock lock(saved_versions_lock_);
+  saved_versions_.erase(m_app_id);
+  resumption::LastState::instance()->RemoveValue(app_path);
+  return true;
 }
 
 void ResumeCtrl::IgnitionOff() {
   LOG4CXX_INFO(logger_, "ResumeCtrl::IgnitionOff()");
 
-  Json::Value to_save;
-  for (Json::Value::iterator it = GetSavedApplications().begin();
-      it != GetSavedApplications().end(); ++it) {
-    uint32_t ign_off_count = (*it)[strings::ign_off_count].asUInt();
+  resumption::LastState* last_state = resumption::LastState::instance();
+  const Json::Value saved_apps = GetSavedApplications();
+  const Json::Value::Members saved_ids = saved_apps.getMemberNames();
+  for (Json::Value::Members::const_iterator it = saved_ids.begin();
+      it != saved_ids.end(); ++it) {
+    const resumption::LastState::Path app_path =
+        AppendPath(SavedApplicationsPath(), *it);
+    uint32_t ign_off_count =
+        saved_apps[*it][strings::ign_off_count].asUInt();
     if (ign_off_count < kApplicationLifes) {
       ign_off_count++;
-      (*it)[strings::ign_off_count] = ign_off_count;
-      to_save.append(*it);
+      last_state->SetValue(AppendPath(app_path, strings::ign_off_count),
+                           ign_off_count);
+    } else {
+      last_state->RemoveValue(app_path);
     }
   }
-  SetSavedApplication(to_save);
 }
 
 bool ResumeCtrl::StartResumption(ApplicationSharedPtr application,
@@ -433,8 +615,9 @@ bool ResumeCtrl::StartResumption(ApplicationSharedPtr application,
   LOG4CXX_INFO(logger_, "hmi_app_id = " << application->hmi_app_id());
   LOG4CXX_INFO(logger_, "mobile_id = " << application->mobile_app_id()->asString());
 
-  Json::Value::iterator it = GetSavedApplications().begin();
-  for (; it != GetSavedApplications().end(); ++it) {
+  const Json::Value saved_apps = GetSavedApplications();
+  Json::Value::const_iterator it = saved_apps.begin();
+  for (; it != saved_apps.end(); ++it) {
     const std::string& saved_m_app_id = (*it)[strings::app_id].asString();
 
     if (saved_m_app_id == application->mobile_app_id()->asString()) {
@@ -442,10 +625,10 @@ bool ResumeCtrl::StartResumption(ApplicationSharedPtr application,
       uint32_t saved_hash = (*it)[strings::hash_id].asUInt();
       uint32_t time_stamp= (*it)[strings::time_stamp].asUInt();
 
-      if (hash == saved_hash) {
-        RestoreApplicationData(application);
+      // Hash is updated once restoration of application data completes
+      if (hash != saved_hash || !RestoreApplicationData(application)) {
+        application->UpdateHash();
       }
-      application->UpdateHash();
       if (!timer_.isRunning() && app_mngr_->applications().size() > 1) {
         RestoreApplicationHMILevel(application);
         RemoveApplicationFromSaved(application);
@@ -472,8 +655,9 @@ bool ResumeCtrl::StartResumptionOnlyHMILevel(ApplicationSharedPtr application) {
   LOG4CXX_INFO(logger_, "app_id = " << application->app_id());
   LOG4CXX_INFO(logger_, "mobile_id = " << application->mobile_app_id()->asString());
 
-  Json::Value::iterator it = GetSavedApplications().begin();
-  for (; it != GetSavedApplications().end(); ++it) {
+  const Json::Value saved_apps = GetSavedApplications();
+  Json::Value::const_iterator it = saved_apps.begin();
+  for (; it != saved_apps.end(); ++it) {
     const std::string& saved_m_app_id = (*it)[strings::app_id].asString();
     if (saved_m_app_id == application->mobile_app_id()->asString()) {
       uint32_t time_stamp= (*it)[strings::time_stamp].asUInt();
@@ -500,8 +684,9 @@ bool ResumeCtrl::CheckPersistenceFilesForResumption(ApplicationSharedPtr applica
   LOG4CXX_INFO(logger_, "RestoreApplicationData");
   DCHECK(application.get());
 
-  Json::Value::iterator it = GetSavedApplications().begin();
-  for (; it != GetSavedApplications().end(); ++it) {
+  const Json::Value saved_apps = GetSavedApplications();
+  Json::Value::const_iterator it = saved_apps.begin();
+  for (; it != saved_apps.end(); ++it) {
     const std::string& saved_m_app_id = (*it)[strings::app_id].asString();
 
     if (saved_m_app_id == application->mobile_app_id()->asString()) {
@@ -509,22 +694,22 @@ bool ResumeCtrl::CheckPersistenceFilesForResumption(ApplicationSharedPtr applica
     }
   }
 
-  if (it == GetSavedApplications().end()) {
+  if (it == saved_apps.end()) {
     LOG4CXX_WARN(logger_, "Application not saved");
     return false;
   }
 
-  Json::Value& saved_app = *it;
+  const Json::Value& saved_app = *it;
   MessageHelper::SmartObjectList requests;
 
   LOG4CXX_INFO(logger_, saved_app.toStyledString());
-  Json::Value& app_commands = saved_app[strings::application_commands];
-  Json::Value& app_choise_sets = saved_app[strings::application_choise_sets];
+  const Json::Value& app_commands = saved_app[strings::application_commands];
+  const Json::Value& app_choise_sets = saved_app[strings::application_choise_sets];
 
   //add commands
-  for (Json::Value::iterator json_it = app_commands.begin();
+  for (Json::Value::const_iterator json_it = app_commands.begin();
       json_it != app_commands.end(); ++json_it)  {
-    Json::Value& json_command = *json_it;
+    const Json::Value& json_command = *json_it;
     smart_objects::SmartObject message =
         smart_objects::SmartObject(smart_objects::SmartType::SmartType_Map);
     Formatters::CFormatterJsonBase::jsonValueToObj(json_command, message);
@@ -537,9 +722,9 @@ bool ResumeCtrl::CheckPersistenceFilesForResumption(ApplicationSharedPtr applica
   }
 
   //add choice sets
-  for (Json::Value::iterator json_it = app_choise_sets.begin();
+  for (Json::Value::const_iterator json_it = app_choise_sets.begin();
       json_it != app_choise_sets.end(); ++json_it)  {
-    Json::Value& json_choiset = *json_it;
+    const Json::Value& json_choiset = *json_it;
     smart_objects::SmartObject msg_param =
         smart_objects::SmartObject(smart_objects::SmartType::SmartType_Map);
     Formatters::CFormatterJsonBase::jsonValueToObj(json_choiset , msg_param);
@@ -556,8 +741,9 @@ bool ResumeCtrl::CheckPersistenceFilesForResumption(ApplicationSharedPtr applica
 
 bool ResumeCtrl::CheckApplicationHash(ApplicationSharedPtr application,
                                       uint32_t hash) {
-  Json::Value::iterator it = GetSavedApplications().begin();
-  for (; it != GetSavedApplications().end(); ++it) {
+  const Json::Value saved_apps = GetSavedApplications();
+  Json::Value::const_iterator it = saved_apps.begin();
+  for (; it != saved_apps.end(); ++it) {
     std::string saved_m_app_id = (*it)[strings::app_id].asString();
 
     if (saved_m_app_id == application->mobile_app_id()->asString()) {
@@ -603,12 +789,8 @@ bool ResumeCtrl::IsDeviceMacAddressEqual(ApplicationSharedPtr application,
   return device_mac == saved_device_mac;
 }
 
-Json::Value& ResumeCtrl::GetSavedApplications() {
-  return resumption::LastState::instance()->dictionary[strings::resumption];
-}
-
-void ResumeCtrl::SetSavedApplication(Json::Value& apps_json) {
-  resumption::LastState::instance()->dictionary[strings::resumption] = apps_json ;
+Json::Value ResumeCtrl::GetSavedApplications() {
+  return resumption::LastState::instance()->GetValue(SavedApplicationsPath());
 }
 
 Json::Value ResumeCtrl::GetApplicationCommands(
@@ -624,7 +806,7 @@ Json::Value ResumeCtrl::GetApplicationCommands(
     smart_objects::SmartObject* so = it->second;
     Json::Value curr;
     Formatters::CFormatterJsonBase::objToJsonValue(*so, curr);
-    result.append(curr);
+    result[IdToKey(it->first)] = curr;
     LOG4CXX_INFO(logger_, "Converted:" << curr.toStyledString());
   }
   return result;
@@ -643,7 +825,7 @@ Json::Value ResumeCtrl::GetApplicationSubMenus(
     smart_objects::SmartObject* so = it->second;
     Json::Value curr;
     Formatters::CFormatterJsonBase::objToJsonValue(*so, curr);
-    result.append(curr);
+    result[IdToKey(it->first)] = curr;
     LOG4CXX_INFO(logger_, "Converted:" << curr.toStyledString());
   }
   return result;
@@ -662,7 +844,7 @@ Json::Value ResumeCtrl::GetApplicationInteractionChoiseSets(
     smart_objects::SmartObject* so = it->second;
     Json::Value curr;
     Formatters::CFormatterJsonBase::objToJsonValue(*so, curr);
-    result.append(curr);
+    result[IdToKey(it->first)] = curr;
     LOG4CXX_INFO(logger_, "Converted:" << curr.toStyledString());
   }
   return result;
@@ -704,13 +886,8 @@ Json::Value ResumeCtrl::GetApplicationSubscriptions(
                << application->app_id());
 
   Json::Value result;
-#ifdef OS_WINCE
-  std::set<mobile_apis::ButtonName::eType>::const_iterator it_button ;
-  std::set<uint32_t>::const_iterator it_vehicle;
-#else
-  std::set<mobile_apis::ButtonName::eType>::iterator it_button ;
-  std::set<uint32_t>::iterator it_vehicle;
-#endif
+  ButtonSubscriptions::const_iterator it_button;
+  VehicleInfoSubscriptions::const_iterator it_vehicle;
 
   for (it_button = application->SubscribedButtons().begin() ;
        it_button != application->SubscribedButtons().end(); ++it_button) {
@@ -740,12 +917,29 @@ Json::Value ResumeCtrl::GetApplicationFiles(
       file_data[strings::is_download_complete] = file.is_download_complete;
       file_data[strings::sync_file_name] = file.file_name;
       file_data[strings::file_type] = file.file_type;
-      result.append(file_data);
+      result[file.file_name] = file_data;
     }
   }
   return result;
 }
 
+Json::Value ResumeCtrl::GetApplicationDataPart(
+    ApplicationConstSharedPtr application, ResumptionDataPart part) {
+  switch (part) {
+    case kCommandsData:
+      return GetApplicationCommands(application);
+    case kSubMenusData:
+      return GetApplicationSubMenus(application);
+    case kChoiceSetsData:
+      return GetApplicationInteractionChoiseSets(application);
+    case kFilesData:
+      return GetApplicationFiles(application);
+    default:
+      NOTREACHED();
+      return Json::Value();
+  }
+}
+
 Json::Value ResumeCtrl::GetApplicationShow(
     ApplicationConstSharedPtr application) {
   DCHECK(application.get());
@@ -769,43 +963,193 @@ Json::Value ResumeCtrl::JsonFromSO(const smart_objects::SmartObject *so) {
   return temp;
 }
 
-bool ResumeCtrl::ProcessHMIRequest(smart_objects::SmartObject* request,
-                                   bool use_events) {
-  if (use_events) {
+smart_objects::SmartObject* ResumeCtrl::CreateHMIRequest(
+    const hmi_apis::FunctionID::eType& function_id,
+    const smart_objects::SmartObject& msg_params) {
+  smart_objects::SmartObject* result =
+      MessageHelper::CreateModuleInfoSO(function_id);
+  (*result)[strings::msg_params] = msg_params;
+  return result;
+}
+
+void ResumeCtrl::StartRestoration(uint32_t app_id,
+                                  const RequestList& requests) {
+  LOG4CXX_INFO(logger_, "ResumeCtrl::StartRestoration " << app_id
+               << ", requests: " << requests.size());
+  if (requests.empty()) {
+    OnRestorationCompleted(app_id, 0, 0);
+    return;
+  }
+
+  {
+    sync_primitives::AutoLock auto_lock(restoration_lock_);
+    RestorationBatch& batch = restoration_batches_[app_id];
+    batch.queued.insert(batch.queued.end(), requests.begin(), requests.end());
+    batch.total += requests.size();
+
+    if (!restoration_timer_started_) {
+      uint32_t period = profile::Profile::instance()->default_timeout() / 1000;
+      restoration_timer_.start(period ? period : 1);
+      restoration_timer_started_ = true;
+    }
+  }
+  SendRestorationRequests();
+}
+
+void ResumeCtrl::StopRestoration(uint32_t app_id) {
+  sync_primitives::AutoLock auto_lock(restoration_lock_);
+  std::map<uint32_t, RestorationBatch>::iterator it =
+      restoration_batches_.find(app_id);
+  if (restoration_batches_.end() == it) {
+    return;
+  }
+
+  LOG4CXX_INFO(logger_, "ResumeCtrl::StopRestoration " << app_id);
+  std::deque<smart_objects::SmartObject*>& queued = it->second.queued;
+  for (size_t i = 0; i < queued.size(); ++i) {
+    delete queued[i];
+  }
+  // Responses to requests already sent are ignored
+  restoration_batches_.erase(it);
+}
+
+void ResumeCtrl::SendRestorationRequests() {
+  const uint32_t window =
+      profile::Profile::instance()->resumption_requests_window();
+  RequestList to_send;
+  {
+    sync_primitives::AutoLock auto_lock(restoration_lock_);
+    const time_t now = time(NULL);
+    // Take requests of all applications in turn, so one application
+    // with lots of data does not delay others
+    bool taken = true;
+    while (taken) {
+      taken = false;
+      std::map<uint32_t, RestorationBatch>::iterator it =
+          restoration_batches_.begin();
+      for (; restoration_batches_.end() != it; ++it) {
+        if (window && restoration_requests_.size() >= window) {
+          break;
+        }
+        RestorationBatch& batch = it->second;
+        if (batch.queued.empty()) {
+          continue;
+        }
+        smart_objects::SmartObject* request = batch.queued.front();
+        batch.queued.pop_front();
+
+        RestorationRequest& sent =
+            restoration_requests_[
+                (*request)[strings::params][strings::correlation_id].asInt()];
+        sent.app_id = it->first;
+        sent.function_id = static_cast<hmi_apis::FunctionID::eType>(
+            (*request)[strings::params][strings::function_id].asInt());
+        sent.sent_time = now;
+        ++batch.in_flight;
+
+        to_send.push_back(request);
+        taken = true;
+      }
+    }
+  }
+
+  for (RequestList::const_iterator it = to_send.begin();
+       to_send.end() != it; ++it) {
+    smart_objects::SmartObject* request = *it;
+    const int32_t correlation_id =
+        (*request)[strings::params][strings::correlation_id].asInt();
     const hmi_apis::FunctionID::eType function_id =
         static_cast<hmi_apis::FunctionID::eType>(
-            (*request)[strings::function_id].asInt());
-
-    const int32_t hmi_correlation_id =
-        (*request)[strings::correlation_id].asInt();
-    subscribe_on_event(function_id, hmi_correlation_id);
+            (*request)[strings::params][strings::function_id].asInt());
+    subscribe_on_event(function_id, correlation_id);
+    if (!ApplicationManagerImpl::instance()->ManageHMICommand(request)) {
+      LOG4CXX_ERROR(logger_, "Unable to send request");
+      unsubscribe_from_event(function_id, correlation_id);
+      OnRestorationResponse(correlation_id, false);
+    }
   }
-  if (!ApplicationManagerImpl::instance()->ManageHMICommand(request)) {
-    LOG4CXX_ERROR(logger_, "Unable to send request");
-    return true;
+}
+
+void ResumeCtrl::OnRestorationResponse(int32_t correlation_id, bool success) {
+  uint32_t app_id = 0;
+  uint32_t total = 0;
+  uint32_t failed = 0;
+  {
+    sync_primitives::AutoLock auto_lock(restoration_lock_);
+    std::map<int32_t, RestorationRequest>::iterator request_it =
+        restoration_requests_.find(correlation_id);
+    if (restoration_requests_.end() == request_it) {
+      return;
+    }
+    app_id = request_it->second.app_id;
+    restoration_requests_.erase(request_it);
+
+    std::map<uint32_t, RestorationBatch>::iterator it =
+        restoration_batches_.find(app_id);
+    if (restoration_batches_.end() == it) {
+      return;
+    }
+    RestorationBatch& batch = it->second;
+    --batch.in_flight;
+    if (!success) {
+      ++batch.failed;
+    }
+    if (!batch.queued.empty() || batch.in_flight) {
+      return;
+    }
+    total = batch.total;
+    failed = batch.failed;
+    restoration_batches_.erase(it);
   }
-  return false;
+  OnRestorationCompleted(app_id, total, failed);
 }
 
-void ResumeCtrl::SendHMIRequest(
-    const hmi_apis::FunctionID::eType& function_id,
-    const smart_objects::SmartObject* msg_params, bool use_events) {
+void ResumeCtrl::OnRestorationCompleted(uint32_t app_id, uint32_t total,
+                                        uint32_t failed) {
+  if (failed) {
+    LOG4CXX_WARN(logger_, "Data of application " << app_id
+                 << " restored partially, " << failed << " of " << total
+                 << " HMI requests failed");
+  } else {
+    LOG4CXX_INFO(logger_, "Data of application " << app_id
+                 << " restored, HMI requests: " << total);
+  }
 
-  NsSmartDeviceLink::NsSmartObjects::SmartObject* result =
-      MessageHelper::CreateModuleInfoSO(function_id);
-  int32_t hmi_correlation_id =
-      (*result)[strings::params][strings::correlation_id].asInt();
-  if (use_events) {
-    subscribe_on_event(function_id, hmi_correlation_id);
+  ApplicationSharedPtr application = app_mngr_->application(app_id);
+  if (!application) {
+    LOG4CXX_WARN(logger_, "Application " << app_id << " is unregistered");
+    return;
   }
+  // Mobile gets new hash only after HMI answered all restoration requests,
+  // so it does not rely on data HMI has not processed yet
+  application->UpdateHash();
+}
 
-  if (msg_params) {
-    (*result)[strings::msg_params] = *msg_params;
+void ResumeCtrl::onRestorationTimer() {
+  const uint32_t timeout =
+      profile::Profile::instance()->default_timeout() / 1000;
+  std::vector<std::pair<int32_t, hmi_apis::FunctionID::eType> > expired;
+  {
+    sync_primitives::AutoLock auto_lock(restoration_lock_);
+    const time_t now = time(NULL);
+    std::map<int32_t, RestorationRequest>::const_iterator it =
+        restoration_requests_.begin();
+    for (; restoration_requests_.end() != it; ++it) {
+      if (difftime(now, it->second.sent_time) >= timeout) {
+        expired.push_back(std::make_pair(it->first, it->second.function_id));
+      }
+    }
+  }
+  if (expired.empty()) {
+    return;
   }
 
-  if (!ApplicationManagerImpl::instance()->ManageHMICommand(result)) {
-    LOG4CXX_ERROR(logger_, "Unable to send request");
+  LOG4CXX_WARN(logger_, expired.size() << " restoration requests expired");
+  for (size_t i = 0; i < expired.size(); ++i) {
+    unsubscribe_from_event(expired[i].second, expired[i].first);
+    OnRestorationResponse(expired[i].first, false);
   }
+  SendRestorationRequests();
 }
 
 }  // namespace application_manager
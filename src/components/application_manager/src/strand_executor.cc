@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef MODIFY_FUNCTION_SIGN
+#include <global_first.h>
+#endif
+#include "application_manager/strand_executor.h"
+
+#include <sstream>
+
+#include "utils/logger.h"
+#include "utils/threads/thread.h"
+#include "utils/threads/thread_delegate.h"
+
+namespace application_manager {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "ApplicationManager")
+
+namespace {
+const size_t kWorkerStackSize = 65536;
+}
+
+class StrandExecutor::Worker : public threads::ThreadDelegate {
+ public:
+  explicit Worker(StrandExecutor* executor)
+    : executor_(executor) {
+  }
+
+  virtual void threadMain() {
+    executor_->WorkerLoop();
+  }
+
+  virtual bool exitThreadMain() {
+    executor_->Stop();
+    // Prevent canceling thread until queued tasks are run
+    return true;
+  }
+
+ private:
+  StrandExecutor* executor_;
+};
+
+StrandExecutor::StrandExecutor(const std::string& name,
+                               uint32_t workers_count)
+  : pending_tasks_(0),
+    stopping_(false) {
+  if (0 == workers_count) {
+    workers_count = 1;
+  }
+  for (uint32_t i = 0; i < workers_count; ++i) {
+    std::stringstream thread_name;
+    thread_name << name << i;
+    threads::Thread* worker =
+        new threads::Thread(thread_name.str().c_str(), new Worker(this));
+    if (!worker->startWithOptions(threads::ThreadOptions(kWorkerStackSize))) {
+      LOG4CXX_ERROR(logger_, "Failed to start thread " << thread_name.str());
+    }
+    workers_.push_back(worker);
+  }
+}
+
+StrandExecutor::~StrandExecutor() {
+  for (std::vector<threads::Thread*>::iterator it = workers_.begin();
+       workers_.end() != it; ++it) {
+    // joins worker after it has run all queued tasks
+    (*it)->stop();
+    delete *it;
+  }
+  workers_.clear();
+}
+
+void StrandExecutor::Post(StrandId strand_id, Task* task) {
+  if (!task) {
+    return;
+  }
+  sync_primitives::AutoLock lock(lock_);
+  Strand& strand = strands_[strand_id];
+  strand.tasks.push_back(task);
+  ++pending_tasks_;
+  if (1 == strand.tasks.size()) {
+    ready_strands_.push_back(strand_id);
+    strand_ready_.NotifyOne();
+  }
+}
+
+size_t StrandExecutor::PendingTasks() const {
+  sync_primitives::AutoLock lock(lock_);
+  return pending_tasks_;
+}
+
+void StrandExecutor::WorkerLoop() {
+  sync_primitives::AutoLock lock(lock_);
+  while (true) {
+    while (ready_strands_.empty() && !stopping_) {
+      strand_ready_.Wait(lock);
+    }
+    if (ready_strands_.empty()) {
+      // stopping and nothing to run
+      break;
+    }
+
+    const StrandId strand_id = ready_strands_.front();
+    ready_strands_.pop_front();
+    Task* task = strands_[strand_id].tasks.front();
+
+    {
+      sync_primitives::AutoUnlock unlock(lock);
+      task->Run();
+      delete task;
+    }
+
+    --pending_tasks_;
+    Strands::iterator it = strands_.find(strand_id);
+    it->second.tasks.pop_front();
+    if (it->second.tasks.empty()) {
+      strands_.erase(it);
+    } else {
+      // other strands which are ready go first
+      ready_strands_.push_back(strand_id);
+      strand_ready_.NotifyOne();
+    }
+  }
+}
+
+void StrandExecutor::Stop() {
+  sync_primitives::AutoLock lock(lock_);
+  stopping_ = true;
+  strand_ready_.Broadcast();
+}
+
+}  // namespace application_manager
@@ -147,6 +147,13 @@ class Profile : public utils::Singleton<Profile> {
      */
     const uint32_t& app_resuming_timeout() const;
 
+    /**
+     * @brief Returns max number of HMI requests which are sent during
+     * restoration of resumed applications data and not answered yet,
+     * 0 if not limited
+     */
+    const uint32_t& resumption_requests_window() const;
+
     /**
      * @brief Returns desirable thread stack size
      */
@@ -172,6 +179,18 @@ class Profile : public utils::Singleton<Profile> {
       */
     const uint32_t& app_dir_quota() const;
 
+    /**
+      * @brief Returns true if disk space has to be preallocated
+      * before writing application files
+      */
+    bool preallocate_files() const;
+
+    /**
+      * @brief Returns period in seconds after which disk usage of
+      * application folder is recalculated, 0 if it is never recalculated
+      */
+    const uint32_t& app_storage_reconcile_period() const;
+
     /**
       * @brief Returns the video server type
       */
@@ -192,6 +211,21 @@ class Profile : public utils::Singleton<Profile> {
      */
     const std::string& named_audio_pipe_path() const;
 
+    /**
+     * @brief Returns name of shared memory object for video stream
+     */
+    const std::string& video_shm_name() const;
+
+    /**
+     * @brief Returns name of shared memory object for audio stream
+     */
+    const std::string& audio_shm_name() const;
+
+    /**
+     * @brief Returns size of payload area of media shared memory ring in KB
+     */
+    const uint32_t& media_shm_ring_size() const;
+
     /**
      * @brief Returns time scale for max amount of requests for application
      * in hmi level none.
@@ -259,6 +293,29 @@ class Profile : public utils::Singleton<Profile> {
      */
     const int32_t heart_beat_timeout() const;
 
+    /*
+     * @brief Returns true if RPC payloads may be compressed
+     * on sessions which negotiated it
+     */
+    bool payload_compression() const;
+
+    /*
+     * @brief Payloads smaller than threshold are sent uncompressed
+     */
+    uint32_t payload_compression_threshold() const;
+
+    /*
+     * @brief Number of connection shards of protocol handler, each shard
+     * has own threads for incoming and outgoing frames
+     */
+    uint32_t protocol_handler_shards() const;
+
+    /*
+     * @brief Number of threads running commands from mobile and HMI,
+     * commands of one application are run in order
+     */
+    uint32_t app_command_threads() const;
+
     /*
      * @brief Path to preloaded policy file
      */
@@ -301,6 +358,23 @@ class Profile : public utils::Singleton<Profile> {
      */
     uint16_t transport_manager_tcp_adapter_port() const;
 
+    /**
+     * @brief Returns number of concurrent USB IN transfers per connection
+     */
+    uint32_t usb_in_transfers_count() const;
+
+    /**
+     * @brief Returns buffer size of USB IN transfer, rounded up to
+     * endpoint max packet size by connection
+     */
+    uint32_t usb_in_transfer_size() const;
+
+    /**
+     * @brief Returns max size of USB OUT transfer, queued messages are
+     * joined up to this size, message bigger than it is sent alone
+     */
+    uint32_t usb_out_transfer_max_size() const;
+
     /**
      * @brief Returns delimiter for SDL-generated TTS chunks
      * @return TTS delimiter
@@ -317,6 +391,12 @@ class Profile : public utils::Singleton<Profile> {
      */
     const std::string& recording_file_name() const;
 
+    /**
+     * @brief Returns duration in milliseconds of audio pass thru chunk
+     * sent to mobile in single OnAudioPassThru notification
+     */
+    const uint32_t& audio_pass_thru_chunk_duration() const;
+
   private:
     /**
      * Default constructor
@@ -423,12 +503,18 @@ class Profile : public utils::Singleton<Profile> {
     uint32_t                        max_cmd_id_;
     uint32_t                        default_timeout_;
     uint32_t                        app_resuming_timeout_;
+    uint32_t                        resumption_requests_window_;
     std::string                     vr_help_title_;
     uint32_t                        app_dir_quota_;
+    bool                            preallocate_files_;
+    uint32_t                        app_storage_reconcile_period_;
     std::string                     video_consumer_type_;
     std::string                     audio_consumer_type_;
     std::string                     named_video_pipe_path_;
     std::string                     named_audio_pipe_path_;
+    std::string                     video_shm_name_;
+    std::string                     audio_shm_name_;
+    uint32_t                        media_shm_ring_size_;
     uint32_t                        app_hmi_level_none_time_scale_max_requests_;
     uint32_t                        app_hmi_level_none_requests_time_scale_;
     std::string                     video_stream_file_;
@@ -441,6 +527,10 @@ class Profile : public utils::Singleton<Profile> {
     uint32_t                        list_files_in_none_;
     std::string                     app_info_storage_;
     uint32_t                        heart_beat_timeout_;
+    bool                            payload_compression_;
+    uint32_t                        payload_compression_threshold_;
+    uint32_t                        protocol_handler_shards_;
+    uint32_t                        app_command_threads_;
     std::string                     preloaded_pt_file_;
     std::string                     policy_snapshot_file_name_;
     bool                            policy_turn_off_;
@@ -449,9 +539,13 @@ class Profile : public utils::Singleton<Profile> {
     std::vector<uint32_t>           supported_diag_modes_;
     std::string                     system_files_path_;
     uint16_t                        transport_manager_tcp_adapter_port_;
+    uint32_t                        usb_in_transfers_count_;
+    uint32_t                        usb_in_transfer_size_;
+    uint32_t                        usb_out_transfer_max_size_;
     std::string                     tts_delimiter_;
     std::string                     recording_file_source_;
     std::string                     recording_file_name_;
+    uint32_t                        audio_pass_thru_chunk_duration_;
 
     DISALLOW_COPY_AND_ASSIGN(Profile);
 
@@ -83,6 +83,9 @@ const char* kVideoStreamConsumerKey = "VideoStreamConsumer";
 const char* kAudioStreamConsumerKey = "AudioStreamConsumer";
 const char* kNamedVideoPipePathKey = "NamedVideoPipePath";
 const char* kNamedAudioPipePathKey = "NamedAudioPipePath";
+const char* kVideoShmNameKey = "VideoShmName";
+const char* kAudioShmNameKey = "AudioShmName";
+const char* kMediaShmRingSizeKey = "MediaShmRingSize";
 const char* kVideoStreamFileKey = "VideoStreamFile";
 const char* kAudioStreamFileKey = "AudioStreamFile";
 const char* kMixingAudioSupportedKey = "MixingAudioSupported";
@@ -93,6 +96,10 @@ const char* kHelpCommandKey = "HelpCommand";
 const char* kSystemFilesPathKey = "SystemFilesPath";
 const char* kHeartBeatTimeoutKey = "HeartBeatTimeout";
 const char* kUseLastStateKey = "UseLastState";
+const char* kPayloadCompressionKey = "PayloadCompression";
+const char* kPayloadCompressionThresholdKey = "PayloadCompressionThreshold";
+const char* kProtocolHandlerShardsKey = "ProtocolHandlerShards";
+const char* kAppCommandThreadsKey = "AppCommandThreads";
 const char* kTCPAdapterPortKey = "TCPAdapterPort";
 const char* kServerPortKey = "ServerPort";
 const char* kVideoStreamingPortKey = "VideoStreamingPort";
@@ -105,7 +112,10 @@ const char* kDeleteFileRequestKey = "DeleteFileRequest";
 const char* kListFilesRequestKey = "ListFilesRequest";
 const char* kDefaultTimeoutKey = "DefaultTimeout";
 const char* kAppResumingTimeoutKey = "ApplicationResumingTimeout";
+const char* kResumptionRequestsWindowKey = "ResumptionRequestsWindow";
 const char* kAppDirectoryQuotaKey = "AppDirectoryQuota";
+const char* kPreallocateFilesKey = "PreallocateFiles";
+const char* kAppStorageReconcilePeriodKey = "AppStorageReconcilePeriod";
 const char* kAppTimeScaleMaxRequestsKey = "AppTimeScaleMaxRequests";
 const char* kAppRequestsTimeScaleKey = "AppRequestsTimeScale";
 const char* kAppHmiLevelNoneTimeScaleMaxRequestsKey =
@@ -115,9 +125,13 @@ const char* kAppHmiLevelNoneRequestsTimeScaleKey =
 const char* kPendingRequestsAmoundKey = "PendingRequestsAmount";
 const char* kSupportedDiagModesKey = "SupportedDiagModes";
 const char* kTransportManagerDisconnectTimeoutKey = "DisconnectTimeout";
+const char* kUsbInTransfersCountKey = "UsbInTransfersCount";
+const char* kUsbInTransferSizeKey = "UsbInTransferSize";
+const char* kUsbOutTransferMaxSizeKey = "UsbOutTransferMaxSize";
 const char* kTTSDelimiterKey = "TTSDelimiter";
 const char* kRecordingFileNameKey = "RecordingFileName";
 const char* kRecordingFileSourceKey = "RecordingFileSource";
+const char* kAudioPassThruChunkDurationKey = "AudioPassThruChunkDuration";
 const char* kPolicyOffKey = "PolicySwitchOff";
 
 const char* kDefaultPoliciesSnapshotFileName = "sdl_snapshot.json";
@@ -129,7 +143,12 @@ const char* kDefaultSystemFilesPath = "/tmp/fs/mp/images/ivsu_cache";
 const char* kDefaultTtsDelimiter = ",";
 const char* kDefaultRecordingFileSourceName = "audio.8bit.wav";
 const char* kDefaultRecordingFileName = "record.wav";
+const char* kDefaultVideoShmName = "/sdl_video_stream";
+const char* kDefaultAudioShmName = "/sdl_audio_stream";
 const uint32_t kDefaultHeartBeatTimeout = 0;
+const uint32_t kDefaultPayloadCompressionThreshold = 256;
+const uint32_t kDefaultProtocolHandlerShards = 2;
+const uint32_t kDefaultAppCommandThreads = 4;
 const uint16_t kDefautTransportManagerTCPPort = 12345;
 const uint16_t kDefaultServerPort = 8087;
 const uint16_t kDefaultVideoStreamingPort = 5050;
@@ -141,13 +160,20 @@ const uint32_t kDefaultDeleteFileRequestInNone = 5;
 const uint32_t kDefaultListFilesRequestInNone = 5;
 const uint32_t kDefaultTimeout = 10000;
 const uint32_t kDefaultAppResumingTimeout = 5;
+const uint32_t kDefaultResumptionRequestsWindow = 32;
 const uint32_t kDefaultDirQuota = 104857600;
+const uint32_t kDefaultAppStorageReconcilePeriod = 0;
+const uint32_t kDefaultMediaShmRingSize = 4096;
+const uint32_t kDefaultAudioPassThruChunkDuration = 50;
 const uint32_t kDefaultAppTimeScaleMaxRequests = 100;
 const uint32_t kDefaultAppRequestsTimeScale = 10;
 const uint32_t kDefaultAppHmiLevelNoneTimeScaleMaxRequests = 100;
 const uint32_t kDefaultAppHmiLevelNoneRequestsTimeScale = 10;
 const uint32_t kDefaultPendingRequestsAmount = 1000;
 const uint32_t kDefaultTransportManagerDisconnectTimeout = 0;
+const uint32_t kDefaultUsbInTransfersCount = 4;
+const uint32_t kDefaultUsbInTransferSize = 16384;
+const uint32_t kDefaultUsbOutTransferMaxSize = 16384;
 
 }  // namespace
 
@@ -175,7 +201,11 @@ Profile::Profile()
     max_cmd_id_(kDefaultMaxCmdId),
     default_timeout_(kDefaultTimeout),
     app_resuming_timeout_(kDefaultAppResumingTimeout),
+    resumption_requests_window_(kDefaultResumptionRequestsWindow),
     app_dir_quota_(kDefaultDirQuota),
+    preallocate_files_(false),
+    app_storage_reconcile_period_(kDefaultAppStorageReconcilePeriod),
+    media_shm_ring_size_(kDefaultMediaShmRingSize),
     app_hmi_level_none_time_scale_max_requests_(
       kDefaultAppHmiLevelNoneTimeScaleMaxRequests),
     app_hmi_level_none_requests_time_scale_(
@@ -188,6 +218,10 @@ Profile::Profile()
     list_files_in_none_(kDefaultListFilesRequestInNone),
     app_info_storage_(kDefaultAppInfoFileName),
     heart_beat_timeout_(kDefaultHeartBeatTimeout),
+    payload_compression_(false),
+    payload_compression_threshold_(kDefaultPayloadCompressionThreshold),
+    protocol_handler_shards_(kDefaultProtocolHandlerShards),
+    app_command_threads_(kDefaultAppCommandThreads),
     policy_snapshot_file_name_(kDefaultPoliciesSnapshotFileName),
     policy_turn_off_(false),
     transport_manager_disconnect_timeout_(
@@ -196,9 +230,13 @@ Profile::Profile()
     supported_diag_modes_(),
     system_files_path_(kDefaultSystemFilesPath),
     transport_manager_tcp_adapter_port_(kDefautTransportManagerTCPPort),
+    usb_in_transfers_count_(kDefaultUsbInTransfersCount),
+    usb_in_transfer_size_(kDefaultUsbInTransferSize),
+    usb_out_transfer_max_size_(kDefaultUsbOutTransferMaxSize),
     tts_delimiter_(kDefaultTtsDelimiter),
     recording_file_source_(kDefaultRecordingFileSourceName),
-    recording_file_name_(kDefaultRecordingFileName) {
+    recording_file_name_(kDefaultRecordingFileName),
+    audio_pass_thru_chunk_duration_(kDefaultAudioPassThruChunkDuration) {
 }
 
 Profile::~Profile() {
@@ -264,6 +302,10 @@ const uint32_t& Profile::app_resuming_timeout() const {
   return app_resuming_timeout_;
 }
 
+const uint32_t& Profile::resumption_requests_window() const {
+  return resumption_requests_window_;
+}
+
 const std::string& Profile::vr_help_title() const {
   return vr_help_title_;
 }
@@ -297,6 +339,14 @@ const uint32_t& Profile::app_dir_quota() const {
   return app_dir_quota_;
 }
 
+bool Profile::preallocate_files() const {
+  return preallocate_files_;
+}
+
+const uint32_t& Profile::app_storage_reconcile_period() const {
+  return app_storage_reconcile_period_;
+}
+
 bool Profile::is_redecoding_enabled() const {
   return is_redecoding_enabled_;
 }
@@ -317,6 +367,18 @@ const std::string& Profile::named_audio_pipe_path() const {
   return named_audio_pipe_path_;
 }
 
+const std::string& Profile::video_shm_name() const {
+  return video_shm_name_;
+}
+
+const std::string& Profile::audio_shm_name() const {
+  return audio_shm_name_;
+}
+
+const uint32_t& Profile::media_shm_ring_size() const {
+  return media_shm_ring_size_;
+}
+
 const uint32_t& Profile::app_hmi_level_none_time_scale() const {
   return app_hmi_level_none_requests_time_scale_;
 }
@@ -365,6 +427,22 @@ const int32_t Profile::heart_beat_timeout() const {
   return heart_beat_timeout_;
 }
 
+bool Profile::payload_compression() const {
+  return payload_compression_;
+}
+
+uint32_t Profile::payload_compression_threshold() const {
+  return payload_compression_threshold_;
+}
+
+uint32_t Profile::protocol_handler_shards() const {
+  return protocol_handler_shards_;
+}
+
+uint32_t Profile::app_command_threads() const {
+  return app_command_threads_;
+}
+
 const std::string& Profile::preloaded_pt_file() const {
   return preloaded_pt_file_;
 }
@@ -397,6 +475,18 @@ uint16_t Profile::transport_manager_tcp_adapter_port() const {
   return transport_manager_tcp_adapter_port_;
 }
 
+uint32_t Profile::usb_in_transfers_count() const {
+  return usb_in_transfers_count_;
+}
+
+uint32_t Profile::usb_in_transfer_size() const {
+  return usb_in_transfer_size_;
+}
+
+uint32_t Profile::usb_out_transfer_max_size() const {
+  return usb_out_transfer_max_size_;
+}
+
 const std::string& Profile::tts_delimiter() const {
   return tts_delimiter_;
 }
@@ -409,6 +499,10 @@ const std::string&Profile::recording_file_name() const {
   return recording_file_name_;
 }
 
+const uint32_t& Profile::audio_pass_thru_chunk_duration() const {
+  return audio_pass_thru_chunk_duration_;
+}
+
 void Profile::UpdateValues() {
   LOG4CXX_INFO(logger_, "Profile::UpdateValues");
 
@@ -549,6 +643,25 @@ void Profile::UpdateValues() {
   LOG_UPDATED_VALUE(named_audio_pipe_path_, kNamedAudioPipePathKey,
                     kMediaManagerSection);
 
+  // Video shared memory name
+  ReadStringValue(&video_shm_name_, kDefaultVideoShmName,
+                  kMediaManagerSection, kVideoShmNameKey);
+
+  LOG_UPDATED_VALUE(video_shm_name_, kVideoShmNameKey, kMediaManagerSection);
+
+  // Audio shared memory name
+  ReadStringValue(&audio_shm_name_, kDefaultAudioShmName,
+                  kMediaManagerSection, kAudioShmNameKey);
+
+  LOG_UPDATED_VALUE(audio_shm_name_, kAudioShmNameKey, kMediaManagerSection);
+
+  // Size of media shared memory ring
+  ReadUIntValue(&media_shm_ring_size_, kDefaultMediaShmRingSize,
+                kMediaManagerSection, kMediaShmRingSizeKey);
+
+  LOG_UPDATED_VALUE(media_shm_ring_size_, kMediaShmRingSizeKey,
+                    kMediaManagerSection);
+
   // Video stream file
   ReadStringValue(&video_stream_file_, "", kMediaManagerSection,
                   kVideoStreamFileKey);
@@ -642,6 +755,13 @@ void Profile::UpdateValues() {
   LOG_UPDATED_VALUE(app_resuming_timeout_, kAppResumingTimeoutKey,
                     kMainSection);
 
+  // Window of outstanding HMI requests during resumption
+  ReadUIntValue(&resumption_requests_window_, kDefaultResumptionRequestsWindow,
+                kMainSection, kResumptionRequestsWindowKey);
+
+  LOG_UPDATED_VALUE(resumption_requests_window_, kResumptionRequestsWindowKey,
+                    kMainSection);
+
   // Application directory quota
   ReadUIntValue(&app_dir_quota_, kDefaultDirQuota, kMainSection,
                 kAppDirectoryQuotaKey);
@@ -652,6 +772,26 @@ void Profile::UpdateValues() {
 
   LOG_UPDATED_VALUE(app_dir_quota_, kAppDirectoryQuotaKey, kMainSection);
 
+  // Disk space preallocation for application files
+  std::string preallocate_files_value;
+  if (ReadValue(&preallocate_files_value, kMainSection, kPreallocateFilesKey)
+      && 0 == strcmp("true", preallocate_files_value.c_str())) {
+    preallocate_files_ = true;
+  } else {
+    preallocate_files_ = false;
+  }
+
+  LOG_UPDATED_BOOL_VALUE(preallocate_files_, kPreallocateFilesKey,
+                         kMainSection);
+
+  // Application storage usage reconciliation period
+  ReadUIntValue(&app_storage_reconcile_period_,
+                kDefaultAppStorageReconcilePeriod, kMainSection,
+                kAppStorageReconcilePeriodKey);
+
+  LOG_UPDATED_VALUE(app_storage_reconcile_period_,
+                    kAppStorageReconcilePeriodKey, kMainSection);
+
   // TTS delimiter
   // Should be gotten before any TTS prompts, since it should be appended back
   ReadStringValue(&tts_delimiter_, kDefaultTtsDelimiter,
@@ -810,6 +950,40 @@ void Profile::UpdateValues() {
 
   LOG_UPDATED_VALUE(heart_beat_timeout_, kHeartBeatTimeoutKey, kMainSection);
 
+  // Payload compression
+  std::string payload_compression_value;
+  if (ReadValue(&payload_compression_value, kMainSection,
+                kPayloadCompressionKey) &&
+      0 == strcmp("true", payload_compression_value.c_str())) {
+    payload_compression_ = true;
+  } else {
+    payload_compression_ = false;
+  }
+
+  LOG_UPDATED_BOOL_VALUE(payload_compression_, kPayloadCompressionKey,
+                         kMainSection);
+
+  ReadUIntValue(&payload_compression_threshold_,
+                kDefaultPayloadCompressionThreshold, kMainSection,
+                kPayloadCompressionThresholdKey);
+
+  LOG_UPDATED_VALUE(payload_compression_threshold_,
+                    kPayloadCompressionThresholdKey, kMainSection);
+
+  // Protocol handler shards
+  ReadUIntValue(&protocol_handler_shards_, kDefaultProtocolHandlerShards,
+                kMainSection, kProtocolHandlerShardsKey);
+
+  LOG_UPDATED_VALUE(protocol_handler_shards_, kProtocolHandlerShardsKey,
+                    kMainSection);
+
+  // Application manager command threads
+  ReadUIntValue(&app_command_threads_, kDefaultAppCommandThreads,
+                kMainSection, kAppCommandThreadsKey);
+
+  LOG_UPDATED_VALUE(app_command_threads_, kAppCommandThreadsKey,
+                    kMainSection);
+
   // Use last state value
   std::string last_state_value;
   if (ReadValue(&last_state_value, kMainSection, kUseLastStateKey) &&
@@ -840,6 +1014,25 @@ void Profile::UpdateValues() {
                     kTransportManagerDisconnectTimeoutKey,
                     kTransportManagerSection);
 
+  // USB transfers
+  ReadUIntValue(&usb_in_transfers_count_, kDefaultUsbInTransfersCount,
+                kTransportManagerSection, kUsbInTransfersCountKey);
+
+  LOG_UPDATED_VALUE(usb_in_transfers_count_, kUsbInTransfersCountKey,
+                    kTransportManagerSection);
+
+  ReadUIntValue(&usb_in_transfer_size_, kDefaultUsbInTransferSize,
+                kTransportManagerSection, kUsbInTransferSizeKey);
+
+  LOG_UPDATED_VALUE(usb_in_transfer_size_, kUsbInTransferSizeKey,
+                    kTransportManagerSection);
+
+  ReadUIntValue(&usb_out_transfer_max_size_, kDefaultUsbOutTransferMaxSize,
+                kTransportManagerSection, kUsbOutTransferMaxSizeKey);
+
+  LOG_UPDATED_VALUE(usb_out_transfer_max_size_, kUsbOutTransferMaxSizeKey,
+                    kTransportManagerSection);
+
   // Recording file
   ReadStringValue(&recording_file_name_, kDefaultRecordingFileName,
                   kMediaManagerSection, kRecordingFileNameKey);
@@ -853,6 +1046,18 @@ void Profile::UpdateValues() {
   LOG_UPDATED_VALUE(recording_file_source_, kRecordingFileSourceKey,
                     kMediaManagerSection);
 
+  // Audio pass thru chunk duration
+  ReadUIntValue(&audio_pass_thru_chunk_duration_,
+                kDefaultAudioPassThruChunkDuration,
+                kMediaManagerSection, kAudioPassThruChunkDurationKey);
+
+  if (0 == audio_pass_thru_chunk_duration_) {
+    audio_pass_thru_chunk_duration_ = kDefaultAudioPassThruChunkDuration;
+  }
+
+  LOG_UPDATED_VALUE(audio_pass_thru_chunk_duration_,
+                    kAudioPassThruChunkDurationKey, kMediaManagerSection);
+
   // Policy preloaded file
   ReadStringValue(&preloaded_pt_file_,
                   kDefaultPreloadedPTFileName,
@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_AUDIO_PASS_THRU_BUFFER_H_
+#define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_AUDIO_PASS_THRU_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "utils/macro.h"
+#include "utils/lock.h"
+
+namespace media_manager {
+
+/*
+ * @brief Fixed size byte ring between microphone recorder (producer) and
+ * AudioStreamSenderThread (consumer).
+ * When consumer falls behind, the oldest samples are overwritten so the
+ * delay between recording and sending never exceeds buffer capacity.
+ */
+class AudioPassThruBuffer {
+  public:
+    /*
+     * @brief Overwritten amount of bytes is rounded up to this value
+     * to keep PCM frames of up to 16 bit stereo aligned.
+     */
+    static const size_t kAlignment = 4;
+
+    /*
+     * @param capacity Buffer size in bytes, rounded up to kAlignment
+     */
+    explicit AudioPassThruBuffer(size_t capacity);
+
+    ~AudioPassThruBuffer();
+
+    /*
+     * @brief Appends bytes to buffer, overwrites oldest bytes if full
+     */
+    void Write(const uint8_t* data, size_t size);
+
+    /*
+     * @brief Moves up to |size| oldest bytes out of buffer
+     *
+     * @return Amount of bytes copied to |data|
+     */
+    size_t Read(uint8_t* data, size_t size);
+
+    /*
+     * @brief Amount of bytes available for Read
+     */
+    size_t size() const;
+
+    /*
+     * @brief Amount of Write calls which had to overwrite unread bytes
+     */
+    uint32_t overruns() const;
+
+    void Clear();
+
+  private:
+    mutable sync_primitives::Lock lock_;
+    uint8_t* data_;
+    size_t capacity_;
+    size_t read_position_;
+    size_t size_;
+    uint32_t overruns_;
+
+    DISALLOW_COPY_AND_ASSIGN(AudioPassThruBuffer);
+};
+
+}  // namespace media_manager
+
+#endif  // SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_AUDIO_PASS_THRU_BUFFER_H_
@@ -33,10 +33,15 @@
 #ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_AUDIO_STREAM_SENDER_THREAD_H_
 #define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_AUDIO_STREAM_SENDER_THREAD_H_
 
+#include <fstream>
 #include <string>
+#include <vector>
 #include "utils/macro.h"
+#include "utils/shared_ptr.h"
 #include "utils/threads/thread_delegate.h"
 #include "utils/lock.h"
+#include "utils/conditional_variable.h"
+#include "media_manager/audio/pcm_converter.h"
 
 namespace NsSmartDeviceLink {
 namespace NsSmartObjects {
@@ -65,20 +70,35 @@ typedef enum {
   AT_PCM = 0
 } AudioType;
 
+class AudioPassThruBuffer;
+
 /*
- * @brief AudioStreamSenderThread class used to read binary data written from microphone
- * and send it every 1 second to mobile device.
+ * @brief AudioStreamSenderThread class used to send binary data recorded
+ * from microphone to mobile device in chunks of fixed duration.
+ * Chunks are taken from AudioPassThruBuffer filled by recorder, or
+ * read incrementally from the recording file, and are emitted on
+ * monotonic clock schedule.
  */
 class AudioStreamSenderThread : public threads::ThreadDelegate {
   public:
     /*
      * @brief AudioStreamSenderThread class constructor
      *
+     * @param file_name       Recording file to read from, if empty data is
+     * taken from |buffer| only
      * @param session_key     Session key of connection for Mobile side
-     * @param correlation_id  Correlation id for response for Mobile side
+     * @param buffer          Buffer with recorded samples
+     * @param source_format   Format of samples written to |buffer|, file
+     * format is taken from WAV header
+     * @param target_format   Format requested by application
+     * @param chunk_duration  Duration of audio sent in one notification, ms
      */
-    AudioStreamSenderThread(const std::string fileName,
-                            uint32_t session_key);
+    AudioStreamSenderThread(const std::string& file_name,
+                            uint32_t session_key,
+                            AudioPassThruBuffer* buffer,
+                            const PcmFormat& source_format,
+                            const PcmFormat& target_format,
+                            uint32_t chunk_duration);
 
     /*
      * @brief AudioStreamSenderThread class destructor
@@ -101,30 +121,57 @@ class AudioStreamSenderThread : public threads::ThreadDelegate {
 
   private:
     /*
-     * @brief Sends AudioPassThru request
+     * @brief Sets format of recorded samples, chunk size and converter
+     * are updated accordingly
+     */
+    void SetSourceFormat(const PcmFormat& format);
+
+    /*
+     * @brief Moves newly recorded part of file to buffer
+     */
+    void ReadRecordingFile();
+
+    /*
+     * @brief Parses WAV header of recording file
+     *
+     * @return false if header is not complete yet
      */
-    bool SendEndAudioPassThru();
+    bool ReadWavHeader();
 
-    void sendAudioChunkToMobile();
+    /*
+     * @brief Sends complete chunks available in buffer
+     *
+     * @param flush Send also incomplete chunk
+     */
+    void SendBufferedChunks(bool flush);
+
+    void sendAudioChunkToMobile(const uint8_t* data, size_t size);
 
     /*
-     * @brief Creates command for corresponding smart object
+     * @brief Waits until |deadline| or until thread is stopped
      *
-     * @param cmd Smart object representing command
+     * @return false if thread should be stopped
      */
-    void FactoryCreateCommand(
-      NsSmartDeviceLink::NsSmartObjects::SmartObject* cmd);
+    bool WaitUntil(int64_t deadline);
 
-    bool getShouldBeStopped();
-    void setShouldBeStopped(bool should_stop);
+    static int64_t MonotonicTime();
 
     uint32_t session_key_;
     const std::string fileName_;
+    AudioPassThruBuffer* buffer_;
+    PcmFormat source_format_;
+    PcmFormat target_format_;
+    utils::SharedPtr<PcmConverter> converter_;
+    uint32_t chunk_duration_;
+    size_t chunk_size_;
+    std::vector<uint8_t> chunk_;
+    std::ifstream file_;
     int32_t offset_;
-    volatile bool shouldBeStoped_;
-    sync_primitives::Lock shouldBeStoped_lock_;
+    int32_t data_offset_;
 
-    static const int32_t kAudioPassThruTimeout;
+    bool shouldBeStoped_;
+    sync_primitives::Lock shouldBeStoped_lock_;
+    sync_primitives::ConditionalVariable shouldBeStoped_cond_;
 
     DISALLOW_COPY_AND_ASSIGN(AudioStreamSenderThread);
 };
@@ -34,7 +34,10 @@
 #define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_FROM_MIC_RECORDER_LISTENER_H_
 
 #include <string>
+#include "utils/macro.h"
 #include "media_manager/media_adapter_listener.h"
+#include "media_manager/audio/audio_pass_thru_buffer.h"
+#include "media_manager/audio/pcm_converter.h"
 
 namespace threads {
 class Thread;
@@ -43,9 +46,20 @@ class Thread;
 namespace media_manager {
 class FromMicRecorderListener : public MediaAdapterListener {
   public:
-    explicit FromMicRecorderListener(
-      const std::string& file_name);
+    /*
+     * @param file_name     Recording file, if empty samples are expected
+     * to come through OnMicrophoneData
+     * @param source_format Format of samples passed to OnMicrophoneData
+     * @param target_format Format requested by application
+     */
+    FromMicRecorderListener(const std::string& file_name,
+                            const PcmFormat& source_format,
+                            const PcmFormat& target_format);
     ~FromMicRecorderListener();
+    /*
+     * @brief Queues recorded samples for sending to mobile
+     */
+    void OnMicrophoneData(const uint8_t* data, size_t size);
     virtual void OnDataReceived(
       int32_t application_key,
       const DataForListener& data);
@@ -58,6 +72,9 @@ class FromMicRecorderListener : public MediaAdapterListener {
   private:
     threads::Thread* reader_;
     std::string file_name_;
+    PcmFormat source_format_;
+    PcmFormat target_format_;
+    AudioPassThruBuffer buffer_;
     int32_t current_application_;
     DISALLOW_COPY_AND_ASSIGN(FromMicRecorderListener);
 };
@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_PCM_CONVERTER_H_
+#define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_PCM_CONVERTER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "utils/macro.h"
+
+namespace media_manager {
+
+/*
+ * @brief Format of mono PCM stream, 8 bit samples are unsigned
+ * and 16 bit samples are signed little endian as in WAV files.
+ */
+struct PcmFormat {
+  PcmFormat()
+    : sampling_rate(0),
+      bits_per_sample(0) {
+  }
+
+  PcmFormat(uint32_t rate, uint32_t bits)
+    : sampling_rate(rate),
+      bits_per_sample(bits) {
+  }
+
+  /*
+   * @brief Creates format from SamplingRate and AudioCaptureQuality
+   * values of PerformAudioPassThru request
+   */
+  static PcmFormat FromMobileApi(int32_t sampling_rate,
+                                 int32_t bits_per_sample);
+
+  bool is_valid() const {
+    return sampling_rate && (8 == bits_per_sample || 16 == bits_per_sample);
+  }
+
+  uint32_t bytes_per_sample() const {
+    return bits_per_sample / 8;
+  }
+
+  uint32_t bytes_per_second() const {
+    return sampling_rate * bytes_per_sample();
+  }
+
+  bool operator==(const PcmFormat& other) const {
+    return sampling_rate == other.sampling_rate &&
+           bits_per_sample == other.bits_per_sample;
+  }
+
+  uint32_t sampling_rate;
+  uint32_t bits_per_sample;
+};
+
+/*
+ * @brief Converts mono PCM stream chunk by chunk to other sampling rate
+ * and/or bit depth. Resampling is linear interpolation, interpolation
+ * phase is kept between chunks so chunk boundaries are seamless.
+ */
+class PcmConverter {
+  public:
+    PcmConverter(const PcmFormat& source, const PcmFormat& target);
+
+    /*
+     * @brief True if formats are equal and Convert only copies data
+     */
+    bool is_pass_through() const;
+
+    /*
+     * @brief Appends converted samples to |output|, trailing bytes
+     * of incomplete sample are ignored
+     */
+    void Convert(const uint8_t* data, size_t size,
+                 std::vector<uint8_t>* output);
+
+    /*
+     * @brief Size of |size| bytes of source stream after conversion
+     */
+    size_t ConvertedSize(size_t size) const;
+
+    void Reset();
+
+  private:
+    int32_t ReadSample(const uint8_t* data) const;
+    void WriteSample(int32_t sample, std::vector<uint8_t>* output) const;
+
+    PcmFormat source_;
+    PcmFormat target_;
+    // Position of next target sample after previous_ source sample
+    // in 1 / target sampling rate units, so stepping has no rounding drift
+    uint32_t phase_;
+    int32_t previous_;
+    bool has_previous_;
+
+    DISALLOW_COPY_AND_ASSIGN(PcmConverter);
+};
+
+}  // namespace media_manager
+
+#endif  // SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_PCM_CONVERTER_H_
@@ -1,5 +1,5 @@
-/*
- * Copyright (c) 2014, Ford Motor Company
+/**
+ * Copyright (c) 2013, Ford Motor Company
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -28,22 +28,24 @@
  * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
- */
+*/
 
-#ifndef SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_TRANSPORT_MANAGER_MECTRIC_H_
-#define SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_TRANSPORT_MANAGER_MECTRIC_H_
+#ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_SHM_AUDIO_STREAMER_ADAPTER_H_
+#define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_SHM_AUDIO_STREAMER_ADAPTER_H_
 
-#include <string>
-#include "metric_wrapper.h"
-#include "transport_manager_observer.h"
+#include "media_manager/shm_streamer_adapter.h"
 
-namespace time_tester {
+namespace media_manager {
 
-class TransportManagerMecticWrapper: public MetricWrapper {
- public:
-  utils::SharedPtr<transport_manager::TMMetricObserver::MessageMetric> message_metric;
-  protected:
-    virtual Json::Value GetJsonMetric();
+class ShmAudioStreamerAdapter : public ShmStreamerAdapter {
+  public:
+    ShmAudioStreamerAdapter();
+    ~ShmAudioStreamerAdapter();
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(ShmAudioStreamerAdapter);
 };
-}  // namespace time_tester
-#endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_TRANSPORT_MANAGER_MECTRIC_H_
+
+}  //  namespace media_manager
+
+#endif  // SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_SHM_AUDIO_STREAMER_ADAPTER_H_
@@ -33,6 +33,8 @@
 #ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_MEDIA_MANAGER_H_
 #define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_MEDIA_MANAGER_H_
 
+#include <stddef.h>
+#include <stdint.h>
 #include <string>
 
 namespace media_manager {
@@ -40,10 +42,22 @@ class MediaManager {
   public:
     virtual void PlayA2DPSource(int32_t application_key) = 0;
     virtual void StopA2DPSource(int32_t application_key) = 0;
+    /*
+     * @param sampling_rate   SamplingRate value requested by application
+     * @param bits_per_sample AudioCaptureQuality value requested by application
+     */
     virtual void StartMicrophoneRecording(int32_t application_key,
                                           const std::string& outputFileName,
-                                          int32_t duration) = 0;
+                                          int32_t duration,
+                                          int32_t sampling_rate,
+                                          int32_t bits_per_sample) = 0;
     virtual void StopMicrophoneRecording(int32_t application_key) = 0;
+    /*
+     * @brief Passes samples captured by recorder outside of media manager
+     * to audio pass thru sender, samples are in requested format
+     */
+    virtual void OnMicrophoneData(int32_t application_key,
+                                  const uint8_t* data, size_t size) = 0;
     virtual void StartVideoStreaming(int32_t application_key) = 0;
     virtual void StopVideoStreaming(int32_t application_key) = 0;
     virtual void StartAudioStreaming(int32_t application_key) = 0;
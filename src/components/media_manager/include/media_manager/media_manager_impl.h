@@ -35,12 +35,14 @@
 
 #include <string>
 #include "utils/singleton.h"
+#include "utils/lock.h"
 #include "protocol_handler/protocol_observer.h"
 #include "protocol_handler/protocol_handler.h"
 #include "protocol_handler/service_type.h"
 #include "media_manager/media_manager.h"
 #include "media_manager/media_adapter_impl.h"
 #include "media_manager/media_adapter_listener.h"
+#include "media_manager/video/video_flow_controller.h"
 
 namespace media_manager {
 
@@ -55,8 +57,12 @@ class MediaManagerImpl : public MediaManager,
     virtual void StopA2DPSource(int32_t application_key);
     virtual void StartMicrophoneRecording(int32_t application_key,
                                           const std::string& outputFileName,
-                                          int32_t duration);
+                                          int32_t duration,
+                                          int32_t sampling_rate,
+                                          int32_t bits_per_sample);
     virtual void StopMicrophoneRecording(int32_t application_key);
+    virtual void OnMicrophoneData(int32_t application_key,
+                                  const uint8_t* data, size_t size);
     virtual void StartVideoStreaming(int32_t application_key);
     virtual void StopVideoStreaming(int32_t application_key);
     virtual void StartAudioStreaming(int32_t application_key);
@@ -65,7 +71,8 @@ class MediaManagerImpl : public MediaManager,
       const protocol_handler::RawMessagePtr& message);
     virtual void OnMobileMessageSent(
       const protocol_handler::RawMessagePtr& message);
-    virtual void FramesProcessed(int32_t application_key, int32_t frame_number);
+    virtual void FramesProcessed(int32_t application_key, int32_t frame_number,
+                                 protocol_handler::ServiceType service_type);
 
   protected:
     MediaManagerImpl();
@@ -74,12 +81,14 @@ class MediaManagerImpl : public MediaManager,
     MediaAdapter*                      a2dp_player_;
     MediaAdapterImpl*                  from_mic_recorder_;
     MediaListenerPtr                   from_mic_listener_;
+    sync_primitives::Lock              from_mic_listener_lock_;
     MediaAdapterImpl*                  video_streamer_;
     MediaAdapterImpl*                  audio_streamer_;
     MediaListenerPtr                   video_streamer_listener_;
     MediaListenerPtr                   audio_streamer_listener_;
     bool                               video_stream_active_;
     bool                               audio_stream_active_;
+    VideoFlowController                video_flow_controller_;
 
   private:
     DISALLOW_COPY_AND_ASSIGN(MediaManagerImpl);
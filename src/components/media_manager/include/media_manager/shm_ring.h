@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_SHM_RING_H_
+#define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_SHM_RING_H_
+
+#include <stdint.h>
+
+namespace media_manager {
+
+/**
+ * Layout of single producer single consumer ring shared by
+ * ShmStreamerAdapter with media consumer process.
+ *
+ * Shared memory object consists of Header followed by data area of
+ * Header::data_size bytes, which is power of two. Every frame payload is stored contiguously at
+ * offset FrameDescriptor::position % data_size of data area, so consumer
+ * reads it in place.
+ *
+ * Producer fills payload and descriptor, then increments write_index and
+ * doorbell. On Linux doorbell is a futex word, consumer may wait on it
+ * with FUTEX_WAIT instead of polling. Consumer increments read_index once
+ * it is done with frame, after that payload may be overwritten.
+ * When consumer is too slow producer drops new frames and counts them in
+ * overruns, it never waits for consumer.
+ */
+namespace shm_ring {
+
+const uint32_t kMagic = 0x53444C52;  // "SDLR"
+const uint32_t kVersion = 1;
+const uint32_t kDescriptorsCount = 256;
+const uint32_t kCacheLineSize = 64;
+
+enum FrameFlags {
+  kKeyFrame = 1 << 0
+};
+
+enum State {
+  kIdle = 0,
+  kStreaming = 1
+};
+
+struct FrameDescriptor {
+  // Time frame was received from mobile, microseconds since epoch
+  uint64_t timestamp;
+  // Position of payload in data area, increases monotonically
+  uint32_t position;
+  uint32_t size;
+  // Combination of FrameFlags
+  uint32_t flags;
+  // Number of frames dropped by producer right before this one
+  uint32_t dropped_before;
+};
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t data_size;
+  uint32_t descriptors_count;
+  // Current State, changed by producer on stream start and stop
+  volatile uint32_t state;
+  // Incremented by producer on every stream start
+  volatile uint32_t session;
+  // Total count of published frames, written by producer only
+  volatile uint32_t write_index;
+  // Futex word incremented on every producer event
+  volatile uint32_t doorbell;
+  // Total count of frames dropped because ring was full
+  volatile uint32_t overruns;
+  uint8_t producer_padding[kCacheLineSize - 9 * sizeof(uint32_t)];
+  // Total count of consumed frames, written by consumer only
+  volatile uint32_t read_index;
+  uint8_t consumer_padding[kCacheLineSize - sizeof(uint32_t)];
+  FrameDescriptor descriptors[kDescriptorsCount];
+};
+
+/**
+ * @brief Size of shared memory object with given size of data area
+ */
+inline uint32_t ObjectSize(uint32_t data_size) {
+  return sizeof(Header) + data_size;
+}
+
+/**
+ * @brief Data area of ring
+ */
+inline uint8_t* Data(Header* header) {
+  return reinterpret_cast<uint8_t*>(header) + sizeof(Header);
+}
+
+}  // namespace shm_ring
+}  // namespace media_manager
+
+#endif  // SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_SHM_RING_H_
@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_SHM_STREAMER_ADAPTER_H_
+#define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_SHM_STREAMER_ADAPTER_H_
+
+#include <string>
+#include "media_manager/media_adapter_impl.h"
+#include "media_manager/shm_ring.h"
+
+namespace media_manager {
+
+/**
+ * @brief Streams data into POSIX shared memory ring described in
+ * shm_ring.h.
+ *
+ * Data is copied into ring directly in SendData, there is no intermediate
+ * queue and thread. SendData must be called from single thread, which is
+ * the case for MediaManagerImpl.
+ */
+class ShmStreamerAdapter : public MediaAdapterImpl {
+  public:
+    ShmStreamerAdapter();
+    virtual ~ShmStreamerAdapter();
+    virtual void SendData(int32_t application_key,
+                          const protocol_handler::RawMessagePtr& message);
+    virtual void StartActivity(int32_t application_key);
+    virtual void StopActivity(int32_t application_key);
+    virtual bool is_app_performing_activity(int32_t application_key);
+
+  protected:
+    std::string shm_name_;
+
+    /*
+     * @brief Create and map shared memory object named shm_name_
+     */
+    virtual void Init();
+
+    /*
+     * @brief Flags of frame descriptor for given payload
+     */
+    virtual uint32_t FrameFlags(const uint8_t* data, uint32_t size) const;
+
+  private:
+    /*
+     * @brief Copy payload into ring and publish its descriptor
+     * @return false if ring has no space for payload
+     */
+    bool Publish(const protocol_handler::RawMessagePtr& message);
+
+    /*
+     * @brief Wake up consumer waiting on doorbell
+     */
+    void RingDoorbell();
+
+    shm_ring::Header* header_;
+    uint32_t          data_size_;
+    uint32_t          write_position_;
+    uint32_t          dropped_;
+    uint32_t          messages_for_session_;
+    volatile bool     is_ready_;
+
+    DISALLOW_COPY_AND_ASSIGN(ShmStreamerAdapter);
+};
+
+}  //  namespace media_manager
+
+#endif  // SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_SHM_STREAMER_ADAPTER_H_
@@ -35,12 +35,13 @@
 
 #include <stdint.h>
 #include "media_manager/media_adapter_listener.h"
+#include "protocol_handler/service_type.h"
 #include "utils/macro.h"
 
 namespace media_manager {
 class StreamerListener : public MediaAdapterListener {
   public:
-    StreamerListener();
+    explicit StreamerListener(protocol_handler::ServiceType service_type);
     ~StreamerListener();
     virtual void OnDataReceived(
       int32_t application_key,
@@ -52,6 +53,7 @@ class StreamerListener : public MediaAdapterListener {
     virtual void OnActivityEnded(int32_t application_key);
   private:
     int32_t current_application_;
+    protocol_handler::ServiceType service_type_;
     DISALLOW_COPY_AND_ASSIGN(StreamerListener);
 };
 }  //  namespace media_manager
@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_VIDEO_H264_ACCESS_UNIT_TRACKER_H_
+#define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_VIDEO_H264_ACCESS_UNIT_TRACKER_H_
+
+#include <stdint.h>
+#include "utils/macro.h"
+
+namespace media_manager {
+
+/**
+ * @brief Splits H.264 Annex B byte stream into NAL units and tracks
+ * access unit boundaries.
+ *
+ * Stream is fed in arbitrary chunks, start codes split between chunks
+ * are handled. Only NAL and slice headers are inspected.
+ */
+class H264AccessUnitTracker {
+  public:
+    /**
+     * @brief What was found in chunk of stream. Offsets are relative to
+     * the chunk and are negative if the item began in previous chunk.
+     */
+    struct ChunkInfo {
+      ChunkInfo();
+      // Access unit starts in chunk
+      bool access_unit;
+      // Offset of start code of NAL unit which starts access unit
+      int32_t access_unit_offset;
+      // SPS or first slice of IDR picture starts in chunk,
+      // decoding may be started from it
+      bool key_frame;
+      // Offset of header of that NAL unit
+      int32_t key_frame_offset;
+      // Header byte of that NAL unit
+      uint8_t key_frame_header;
+    };
+
+    H264AccessUnitTracker();
+
+    /**
+     * @brief Parse next chunk of stream, only first access unit and
+     * first key frame of chunk are reported
+     */
+    ChunkInfo Process(const uint8_t* data, uint32_t size);
+
+    /**
+     * @brief Forget state of stream, e.g. on stream restart
+     */
+    void Reset();
+
+  private:
+    enum State {
+      kSearchStartCode,
+      kNalHeader,
+      kSliceHeader
+    };
+
+    void OnNalHeader(uint8_t header, ChunkInfo* info);
+    void OnSliceHeader(uint8_t first_byte, ChunkInfo* info);
+    void StartAccessUnit(ChunkInfo* info);
+    void FoundKeyFrame(ChunkInfo* info);
+    int32_t OffsetInChunk(uint64_t position) const;
+
+    State   state_;
+    // Zero bytes seen right before current position
+    uint32_t zeros_;
+    uint8_t nal_header_;
+    // Stream positions of first chunk byte, current byte,
+    // start code and header of current NAL unit
+    uint64_t chunk_begin_;
+    uint64_t position_;
+    uint64_t nal_start_;
+    uint64_t nal_header_position_;
+    // Current access unit already has slice, next slice with
+    // first_mb_in_slice 0 or non VCL header starts new access unit
+    bool    access_unit_has_slice_;
+
+    DISALLOW_COPY_AND_ASSIGN(H264AccessUnitTracker);
+};
+
+}  //  namespace media_manager
+
+#endif  // SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_VIDEO_H264_ACCESS_UNIT_TRACKER_H_
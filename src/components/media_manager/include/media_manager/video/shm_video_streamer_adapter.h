@@ -1,5 +1,5 @@
-/*
- * Copyright (c) 2014, Ford Motor Company
+/**
+ * Copyright (c) 2013, Ford Motor Company
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -28,32 +28,30 @@
  * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
- */
+*/
 
-#ifndef SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_MECTRIC_H_
-#define SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_MECTRIC_H_
+#ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_VIDEO_SHM_VIDEO_STREAMER_ADAPTER_H_
+#define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_VIDEO_SHM_VIDEO_STREAMER_ADAPTER_H_
 
-#include <string>
-#include "utils/resource_usage.h"
-#include "json/json.h"
+#include "media_manager/shm_streamer_adapter.h"
 
-namespace time_tester {
+namespace media_manager {
 
-class MetricWrapper {
-  utils::ResourseUsage* resources;
+class ShmVideoStreamerAdapter : public ShmStreamerAdapter {
   public:
-    MetricWrapper();
+    ShmVideoStreamerAdapter();
+    ~ShmVideoStreamerAdapter();
+
+  protected:
     /*
-     * @brief get current cpu and memory info and store it as member
+     * @brief Marks H.264 access units with IDR slice or SPS as key frames
      */
-    bool grabResources();
-    virtual std::string GetStyledString();
-    ~MetricWrapper();
-  protected:
-    virtual Json::Value GetJsonMetric();
-    void Clear();
+    virtual uint32_t FrameFlags(const uint8_t* data, uint32_t size) const;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(ShmVideoStreamerAdapter);
 };
 
+}  //  namespace media_manager
 
-}  // namespace time_tester
-#endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_MECTRIC_H_
+#endif  // SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_VIDEO_SHM_VIDEO_STREAMER_ADAPTER_H_
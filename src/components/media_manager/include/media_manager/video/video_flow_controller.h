@@ -0,0 +1,124 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_VIDEO_VIDEO_FLOW_CONTROLLER_H_
+#define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_VIDEO_VIDEO_FLOW_CONTROLLER_H_
+
+#include <stdint.h>
+#include "media_manager/video/h264_access_unit_tracker.h"
+#include "utils/date_time.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace media_manager {
+
+/**
+ * @brief Keeps latency of mobile navigation stream bounded.
+ *
+ * Measures how fast video streamer drains frames and compares it with
+ * amount of frames waiting in streamer. When backlog exceeds latency
+ * budget, stream is cut at next access unit boundary and dropped up to
+ * next key frame, so consumer always gets whole groups of pictures and
+ * never a damaged one. Frame (chunk of stream) may contain end of one
+ * access unit and start of another, so only part of it may be streamed.
+ * Acknowledges to mobile are paced by frames actually drained (or
+ * dropped), so mobile slows down together with consumer.
+ *
+ * OnFrameReceived and OnFrameProcessed may be called from different
+ * threads.
+ */
+class VideoFlowController {
+  public:
+    /**
+     * @brief Part of received frame which goes to streamer
+     */
+    struct FramePart {
+      FramePart();
+      uint32_t offset;
+      uint32_t size;
+      // Bytes to put in front of the part: start code, and header of
+      // key frame NAL unit if it came with previous frame
+      uint8_t  prefix[5];
+      uint32_t prefix_size;
+    };
+
+    VideoFlowController();
+
+    /**
+     * @brief Reset state for new stream
+     */
+    void Start();
+
+    /**
+     * @brief Decide which part of frame received from mobile goes
+     * to streamer
+     * @param data frame payload, H.264 Annex B
+     * @param size size of payload
+     * @param part set to part of frame to be streamed
+     * @param frames_to_ack set to number of frames to acknowledge to
+     * mobile, 0 if acknowledge is not due yet
+     * @return true if frame should be streamed, false if it is dropped
+     */
+    bool OnFrameReceived(const uint8_t* data, uint32_t size,
+                         FramePart* part, uint32_t* frames_to_ack);
+
+    /**
+     * @brief Streamer finished with one frame
+     * @param frames_to_ack same as for OnFrameReceived
+     */
+    void OnFrameProcessed(uint32_t* frames_to_ack);
+
+  private:
+    void UpdateDrainRate();
+    bool IsBacklogAbove(uint32_t latency_ms, uint32_t frames) const;
+    uint32_t FramesToAck();
+
+    sync_primitives::Lock lock_;
+    H264AccessUnitTracker tracker_;
+    // Frames passed to streamer
+    uint32_t      queued_;
+    // Frames streamer reported as processed
+    uint32_t      processed_;
+    uint32_t      dropped_;
+    uint32_t      acked_;
+    bool          dropping_;
+    TimevalStruct rate_window_start_;
+    uint32_t      rate_window_processed_;
+    // Frames per second drained by streamer, 0 until measured
+    uint32_t      drain_rate_;
+
+    DISALLOW_COPY_AND_ASSIGN(VideoFlowController);
+};
+
+}  //  namespace media_manager
+
+#endif  // SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_VIDEO_VIDEO_FLOW_CONTROLLER_H_
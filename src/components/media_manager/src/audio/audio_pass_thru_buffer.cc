@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef MODIFY_FUNCTION_SIGN
+#include <global_first.h>
+#endif
+#include <string.h>
+#include <algorithm>
+#include "media_manager/audio/audio_pass_thru_buffer.h"
+
+namespace media_manager {
+
+using sync_primitives::AutoLock;
+
+const size_t AudioPassThruBuffer::kAlignment;
+
+AudioPassThruBuffer::AudioPassThruBuffer(size_t capacity)
+  : data_(NULL),
+    capacity_((capacity + kAlignment - 1) / kAlignment * kAlignment),
+    read_position_(0),
+    size_(0),
+    overruns_(0) {
+  if (0 == capacity_) {
+    capacity_ = kAlignment;
+  }
+  data_ = new uint8_t[capacity_];
+}
+
+AudioPassThruBuffer::~AudioPassThruBuffer() {
+  delete[] data_;
+}
+
+void AudioPassThruBuffer::Write(const uint8_t* data, size_t size) {
+  AutoLock auto_lock(lock_);
+  if (size > capacity_) {
+    // Only the newest part fits, the rest would be overwritten anyway
+    data += size - capacity_;
+    size = capacity_;
+  }
+  if (size_ + size > capacity_) {
+    size_t dropped = size_ + size - capacity_;
+    dropped = (dropped + kAlignment - 1) / kAlignment * kAlignment;
+    dropped = std::min(dropped, size_);
+    read_position_ = (read_position_ + dropped) % capacity_;
+    size_ -= dropped;
+    ++overruns_;
+  }
+  const size_t write_position = (read_position_ + size_) % capacity_;
+  const size_t head = std::min(size, capacity_ - write_position);
+  memcpy(data_ + write_position, data, head);
+  memcpy(data_, data + head, size - head);
+  size_ += size;
+}
+
+size_t AudioPassThruBuffer::Read(uint8_t* data, size_t size) {
+  AutoLock auto_lock(lock_);
+  size = std::min(size, size_);
+  const size_t head = std::min(size, capacity_ - read_position_);
+  memcpy(data, data_ + read_position_, head);
+  memcpy(data + head, data_, size - head);
+  read_position_ = (read_position_ + size) % capacity_;
+  size_ -= size;
+  return size;
+}
+
+size_t AudioPassThruBuffer::size() const {
+  AutoLock auto_lock(lock_);
+  return size_;
+}
+
+uint32_t AudioPassThruBuffer::overruns() const {
+  AutoLock auto_lock(lock_);
+  return overruns_;
+}
+
+void AudioPassThruBuffer::Clear() {
+  AutoLock auto_lock(lock_);
+  read_position_ = 0;
+  size_ = 0;
+}
+
+}  // namespace media_manager
@@ -34,153 +34,286 @@
 #ifdef MODIFY_FUNCTION_SIGN
 #include <global_first.h>
 #endif
-#if defined(OS_POSIX) && defined(OS_LINUX)
-#include <pthread.h>  // TODO(DK): Need to remove
-#include <unistd.h>
-#endif
-
-#ifdef OS_WIN32
-#elif defined(OS_MAC)
-#include <unistd.h>
-#endif
-
+#include <string.h>
+#include <algorithm>
 #include <string>
 #include "application_manager/application_manager_impl.h"
-#include "application_manager/mobile_command_factory.h"
-#include "application_manager/application_impl.h"
-#include "smart_objects/smart_object.h"
-#include "interfaces/MOBILE_API.h"
-#include "utils/file_system.h"
+#include "application_manager/message.h"
+#include "utils/date_time.h"
 #include "utils/logger.h"
 
 #include "media_manager/audio/audio_stream_sender_thread.h"
-#include "application_manager/smart_object_keys.h"
-#include "application_manager/message.h"
+#include "media_manager/audio/audio_pass_thru_buffer.h"
 
 namespace media_manager {
 using sync_primitives::AutoLock;
 
-const int32_t AudioStreamSenderThread::kAudioPassThruTimeout = 1;
+namespace {
+// Schedule is restarted if sender is late for more chunks than this
+const int64_t kMaxLateChunks = 4;
+// Recording file is read by blocks of this size
+const size_t kReadBlockSize = 4096;
+// WAV header is expected to fit into this size
+const size_t kMaxWavHeaderSize = 512;
+#if defined(EXTENDED_MEDIA_MODE)
+// File grows in real time, so everything recorded so far is taken
+const size_t kChunksPerFileRead = 16;
+#else
+// Emulated recording is played back in real time
+const size_t kChunksPerFileRead = 1;
+#endif
+
+uint32_t ReadUInt16(const uint8_t* data) {
+  return data[0] | (data[1] << 8);
+}
+
+uint32_t ReadUInt32(const uint8_t* data) {
+  return data[0] | (data[1] << 8) | (data[2] << 16) |
+         (static_cast<uint32_t>(data[3]) << 24);
+}
+}  // namespace
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "AudioPassThruThread")
 
 AudioStreamSenderThread::AudioStreamSenderThread(
-  const std::string fileName, uint32_t session_key)
+  const std::string& file_name,
+  uint32_t session_key,
+  AudioPassThruBuffer* buffer,
+  const PcmFormat& source_format,
+  const PcmFormat& target_format,
+  uint32_t chunk_duration)
   : session_key_(session_key),
-    shouldBeStoped_(false),
-    fileName_(fileName) {
+    fileName_(file_name),
+    buffer_(buffer),
+    target_format_(target_format),
+    chunk_duration_(chunk_duration ? chunk_duration : 1),
+    chunk_size_(0),
+    offset_(0),
+    data_offset_(-1),
+    shouldBeStoped_(false) {
   LOG4CXX_TRACE_ENTER(logger_);
+  DCHECK(buffer_);
+  SetSourceFormat(source_format);
 }
 
 AudioStreamSenderThread::~AudioStreamSenderThread() {
 }
 
+void AudioStreamSenderThread::SetSourceFormat(const PcmFormat& format) {
+  source_format_ = format;
+  if (!source_format_.is_valid()) {
+    LOG4CXX_WARN(logger_, "Unknown recording format, "
+                 "target format is assumed");
+    source_format_ = target_format_.is_valid() ?
+                     target_format_ : PcmFormat(16000, 16);
+  }
+  if (!target_format_.is_valid()) {
+    target_format_ = source_format_;
+  }
+
+  const uint32_t sample_size = source_format_.bytes_per_sample();
+  chunk_size_ = static_cast<size_t>(source_format_.bytes_per_second()) *
+                chunk_duration_ / date_time::DateTime::MILLISECONDS_IN_SECOND;
+  chunk_size_ = std::max<size_t>(chunk_size_ / sample_size, 1) * sample_size;
+  chunk_.resize(chunk_size_);
+
+  converter_.reset();
+  if (!(source_format_ == target_format_)) {
+    converter_.reset(new PcmConverter(source_format_, target_format_));
+  }
+  LOG4CXX_INFO(logger_, "Recording " << source_format_.sampling_rate << "Hz/"
+               << source_format_.bits_per_sample << "bit, sending "
+               << target_format_.sampling_rate << "Hz/"
+               << target_format_.bits_per_sample << "bit by "
+               << chunk_duration_ << "ms");
+}
+
 void AudioStreamSenderThread::threadMain() {
   LOG4CXX_TRACE_ENTER(logger_);
 
   offset_ = 0;
+  int64_t deadline = MonotonicTime();
 
   while (true) {
-    if (getShouldBeStopped()) {
+    deadline += chunk_duration_;
+    if (!WaitUntil(deadline)) {
       break;
     }
 
-#ifdef OS_WIN32
-	Sleep(kAudioPassThruTimeout * 1000);
-#else
-	usleep(kAudioPassThruTimeout * 1000000);
-#endif
+    const int64_t now = MonotonicTime();
+    if (now - deadline > kMaxLateChunks * chunk_duration_) {
+      LOG4CXX_WARN(logger_, "Sender is late for " << now - deadline
+                   << "ms, restarting schedule");
+      deadline = now;
+    }
 
-    if (getShouldBeStopped()) {
-      break;
+    if (!fileName_.empty()) {
+      ReadRecordingFile();
     }
+    SendBufferedChunks(false);
+  }
 
-    sendAudioChunkToMobile();
+  // Samples recorded before stop are still delivered
+  if (!fileName_.empty()) {
+    ReadRecordingFile();
   }
+  SendBufferedChunks(true);
 
+  if (buffer_->overruns()) {
+    LOG4CXX_WARN(logger_, "Audio pass thru buffer overruns: "
+                 << buffer_->overruns());
+  }
   LOG4CXX_TRACE_EXIT(logger_);
 }
 
-void AudioStreamSenderThread::sendAudioChunkToMobile() {
-  LOG4CXX_TRACE_ENTER(logger_);
-
-  std::vector<uint8_t> binaryData;
-  std::vector<uint8_t>::iterator from;
-  std::vector<uint8_t>::iterator to;
-
+bool AudioStreamSenderThread::WaitUntil(int64_t deadline) {
+  AutoLock auto_lock(shouldBeStoped_lock_);
+  while (!shouldBeStoped_) {
+    const int64_t now = MonotonicTime();
+    if (now >= deadline) {
+      return true;
+    }
+    shouldBeStoped_cond_.WaitFor(auto_lock,
+                                 static_cast<int32_t>(deadline - now));
+  }
+  return false;
+}
 
-#ifdef MODIFY_FUNCTION_SIGN
-#	ifdef OS_WIN32
-  Sleep(kAudioPassThruTimeout * 250);
-#	else
-  usleep(kAudioPassThruTimeout * 250000);
-#	endif
+int64_t AudioStreamSenderThread::MonotonicTime() {
+#ifdef OS_WIN32
+  // GetTickCount wraps every 49.7 days, count the wraps so deadlines
+  // keep growing. Called from sender thread only.
+  static uint32_t last_ticks = 0;
+  static int64_t wraps = 0;
+  const uint32_t ticks = GetTickCount();
+  if (ticks < last_ticks) {
+    ++wraps;
+  }
+  last_ticks = ticks;
+  return (wraps << 32) + ticks;
 #else
-#	ifdef OS_WIN32
-  Sleep(kAudioPassThruTimeout * 1000);
-#	else
-  usleep(kAudioPassThruTimeout * 1000000);
-#	endif
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<int64_t>(now.tv_sec) *
+         date_time::DateTime::MILLISECONDS_IN_SECOND +
+         now.tv_nsec / 1000000;
 #endif
+}
 
-#ifdef MODIFY_FUNCTION_SIGN
-	application_manager::ApplicationManagerImpl::instance()->getAudioPassThruData(binaryData);
-#else
-  if (!file_system::ReadBinaryFile(fileName_, binaryData)) {
-    LOG4CXX_ERROR_EXT(logger_, "Unable to read file." << fileName_);
+bool AudioStreamSenderThread::ReadWavHeader() {
+  char header[kMaxWavHeaderSize];
+  file_.clear();
+  file_.seekg(0);
+  file_.read(header, sizeof(header));
+  const size_t size = static_cast<size_t>(file_.gcount());
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(header);
 
-    return;
+  if (size < 12) {
+    return false;
   }
-#endif
-
-  if (binaryData.empty()) {
-    LOG4CXX_ERROR_EXT(logger_, "Binary data is empty.");
-    return;
+  if (0 != memcmp(data, "RIFF", 4) || 0 != memcmp(data + 8, "WAVE", 4)) {
+    LOG4CXX_WARN(logger_, fileName_ << " is not WAV file, sent as is");
+    data_offset_ = 0;
+    return true;
   }
 
-  LOG4CXX_INFO_EXT(logger_, "offset = " << offset_);
-
-  from = binaryData.begin() + offset_;
-  to = binaryData.end();
-
-  if (from < binaryData.end() /*from != binaryData.end()*/) {
-    LOG4CXX_INFO_EXT(logger_, "from != binaryData.end()");
+  PcmFormat format;
+  uint32_t channels = 1;
+  size_t position = 12;
+  while (position + 8 <= size) {
+    const uint8_t* chunk = data + position;
+    const uint32_t chunk_size = ReadUInt32(chunk + 4);
+    if (0 == memcmp(chunk, "fmt ", 4) && position + 24 <= size) {
+      channels = ReadUInt16(chunk + 10);
+      format.sampling_rate = ReadUInt32(chunk + 12);
+      format.bits_per_sample = ReadUInt16(chunk + 22);
+    } else if (0 == memcmp(chunk, "data", 4)) {
+      data_offset_ = static_cast<int32_t>(position + 8);
+      if (1 != channels) {
+        LOG4CXX_WARN(logger_, "Recording has " << channels
+                     << " channels, sent without conversion");
+        target_format_ = PcmFormat();
+      }
+      SetSourceFormat(format);
+      return true;
+    }
+    position += 8 + chunk_size + (chunk_size & 1);
+  }
+  return false;
+}
 
-#ifdef OS_WIN32
-	offset_ = to - from + offset_;
-#else
-	offset_ = offset_ + to - from;
-#endif
+void AudioStreamSenderThread::ReadRecordingFile() {
+  if (!file_.is_open()) {
+    file_.open(fileName_.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (!file_.is_open()) {
+      return;
+    }
+  }
+  if (data_offset_ < 0) {
+    if (!ReadWavHeader()) {
+      return;
+    }
+    offset_ = data_offset_;
+  }
 
-    application_manager::ApplicationManagerImpl::instance()->
-    SendAudioPassThroughNotification(session_key_,
-                                     std::vector<uint8_t>(from, to));
-    binaryData.clear();
+  char block[kReadBlockSize];
+  size_t left = kChunksPerFileRead * chunk_size_;
+  file_.clear();
+  file_.seekg(offset_);
+  while (left > 0) {
+    file_.read(block, std::min(left, sizeof(block)));
+    const size_t size = static_cast<size_t>(file_.gcount());
+    if (0 == size) {
+      break;
+    }
+    buffer_->Write(reinterpret_cast<const uint8_t*>(block), size);
+    offset_ += static_cast<int32_t>(size);
+    left -= size;
   }
-#ifdef MODIFY_FUNCTION_SIGN
-	// do nothing
-#else
+
 #if !defined(EXTENDED_MEDIA_MODE)
-  // without recording stream restart reading 1-sec file
-  offset_ = 0;
-#endif
+  // without recording stream restart reading file from the beginning
+  if (file_.eof()) {
+    offset_ = data_offset_;
+  }
 #endif
 }
 
-bool AudioStreamSenderThread::getShouldBeStopped() {
-  AutoLock auto_lock(shouldBeStoped_lock_);
-
-  return shouldBeStoped_;
+void AudioStreamSenderThread::SendBufferedChunks(bool flush) {
+  while (buffer_->size() >= chunk_size_) {
+    const size_t size = buffer_->Read(&chunk_[0], chunk_size_);
+    sendAudioChunkToMobile(&chunk_[0], size);
+  }
+  if (flush) {
+    const size_t size = buffer_->Read(&chunk_[0], chunk_size_);
+    if (size) {
+      sendAudioChunkToMobile(&chunk_[0], size);
+    }
+  }
 }
 
-void AudioStreamSenderThread::setShouldBeStopped(bool should_stop) {
-  AutoLock auto_lock(shouldBeStoped_lock_);
-  shouldBeStoped_ = should_stop;
+void AudioStreamSenderThread::sendAudioChunkToMobile(const uint8_t* data,
+                                                     size_t size) {
+  std::vector<uint8_t> binary_data;
+  if (converter_) {
+    converter_->Convert(data, size, &binary_data);
+  } else {
+    binary_data.assign(data, data + size);
+  }
+  if (binary_data.empty()) {
+    return;
+  }
+
+  application_manager::ApplicationManagerImpl::instance()->
+  SendAudioPassThroughNotification(
+    session_key_, application_manager::BinaryData::Adopt(&binary_data));
 }
 
 bool AudioStreamSenderThread::exitThreadMain() {
   LOG4CXX_INFO(logger_, "AudioStreamSenderThread::exitThreadMain");
-  setShouldBeStopped(true);
+  AutoLock auto_lock(shouldBeStoped_lock_);
+  shouldBeStoped_ = true;
+  shouldBeStoped_cond_.NotifyOne();
   return true;
 }
 
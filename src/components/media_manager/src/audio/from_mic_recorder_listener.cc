@@ -35,6 +35,7 @@
 #endif
 #include "utils/threads/thread.h"
 #include "utils/logger.h"
+#include "config_profile/profile.h"
 #include "media_manager/audio/from_mic_recorder_listener.h"
 #include "media_manager/audio/audio_stream_sender_thread.h"
 
@@ -42,10 +43,21 @@ namespace media_manager {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "FromMicRecorderListener")
 
+namespace {
+// About 1.5 seconds of 44.1 kHz 16 bit stereo
+const size_t kBufferCapacity = 256 * 1024;
+}
+
 FromMicRecorderListener::FromMicRecorderListener(
-  const std::string& file_name)
+  const std::string& file_name,
+  const PcmFormat& source_format,
+  const PcmFormat& target_format)
   : reader_(NULL)
-  , file_name_(file_name) {
+  , file_name_(file_name)
+  , source_format_(source_format)
+  , target_format_(target_format)
+  , buffer_(kBufferCapacity)
+  , current_application_(0) {
 }
 
 FromMicRecorderListener::~FromMicRecorderListener() {
@@ -56,6 +68,11 @@ FromMicRecorderListener::~FromMicRecorderListener() {
   }
 }
 
+void FromMicRecorderListener::OnMicrophoneData(const uint8_t* data,
+                                               size_t size) {
+  buffer_.Write(data, size);
+}
+
 void FromMicRecorderListener::OnDataReceived(
   int32_t application_key,
   const DataForListener& data) {
@@ -73,8 +90,12 @@ void FromMicRecorderListener::OnActivityStarted(int32_t application_key) {
     return;
   }
   if (!reader_) {
+    buffer_.Clear();
     AudioStreamSenderThread* thread_delegate =
-      new AudioStreamSenderThread(file_name_, application_key);
+      new AudioStreamSenderThread(
+        file_name_, application_key, &buffer_, source_format_,
+        target_format_,
+        profile::Profile::instance()->audio_pass_thru_chunk_duration());
     reader_ = new threads::Thread("FromMicRecorderSender", thread_delegate);
   }
   if (reader_) {
@@ -0,0 +1,151 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef MODIFY_FUNCTION_SIGN
+#include <global_first.h>
+#endif
+#include "media_manager/audio/pcm_converter.h"
+#include "media_manager/audio/audio_stream_sender_thread.h"
+
+namespace media_manager {
+
+PcmFormat PcmFormat::FromMobileApi(int32_t sampling_rate,
+                                   int32_t bits_per_sample) {
+  PcmFormat format;
+  switch (sampling_rate) {
+    case SR_8KHZ:
+      format.sampling_rate = 8000;
+      break;
+    case SR_16KHZ:
+      format.sampling_rate = 16000;
+      break;
+    case SR_22KHZ:
+      format.sampling_rate = 22050;
+      break;
+    case SR_44KHZ:
+      format.sampling_rate = 44100;
+      break;
+    default:
+      break;
+  }
+  switch (bits_per_sample) {
+    case ACQ_8_BIT:
+      format.bits_per_sample = 8;
+      break;
+    case ACQ_16_BIT:
+      format.bits_per_sample = 16;
+      break;
+    default:
+      break;
+  }
+  return format;
+}
+
+PcmConverter::PcmConverter(const PcmFormat& source, const PcmFormat& target)
+  : source_(source),
+    target_(target),
+    phase_(0),
+    previous_(0),
+    has_previous_(false) {
+  DCHECK(source_.is_valid());
+  DCHECK(target_.is_valid());
+}
+
+bool PcmConverter::is_pass_through() const {
+  return source_ == target_;
+}
+
+void PcmConverter::Convert(const uint8_t* data, size_t size,
+                           std::vector<uint8_t>* output) {
+  DCHECK(output);
+  const uint32_t sample_size = source_.bytes_per_sample();
+  const size_t samples = size / sample_size;
+  output->reserve(output->size() + ConvertedSize(size) + 2);
+
+  if (source_.sampling_rate == target_.sampling_rate) {
+    for (size_t i = 0; i < samples; ++i) {
+      WriteSample(ReadSample(data + i * sample_size), output);
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < samples; ++i) {
+    const int32_t current = ReadSample(data + i * sample_size);
+    if (!has_previous_) {
+      previous_ = current;
+      has_previous_ = true;
+      continue;
+    }
+    // Target sample n lies at n * source rate / target rate
+    while (phase_ < target_.sampling_rate) {
+      const int64_t delta = current - previous_;
+      WriteSample(previous_ + static_cast<int32_t>(
+          delta * phase_ / static_cast<int64_t>(target_.sampling_rate)),
+                  output);
+      phase_ += source_.sampling_rate;
+    }
+    phase_ -= target_.sampling_rate;
+    previous_ = current;
+  }
+}
+
+size_t PcmConverter::ConvertedSize(size_t size) const {
+  const uint64_t samples = size / source_.bytes_per_sample();
+  return static_cast<size_t>(samples * target_.sampling_rate /
+                             source_.sampling_rate) *
+         target_.bytes_per_sample();
+}
+
+void PcmConverter::Reset() {
+  phase_ = 0;
+  previous_ = 0;
+  has_previous_ = false;
+}
+
+int32_t PcmConverter::ReadSample(const uint8_t* data) const {
+  if (8 == source_.bits_per_sample) {
+    return (static_cast<int32_t>(data[0]) - 128) << 8;
+  }
+  return static_cast<int16_t>(data[0] | (data[1] << 8));
+}
+
+void PcmConverter::WriteSample(int32_t sample,
+                               std::vector<uint8_t>* output) const {
+  if (8 == target_.bits_per_sample) {
+    output->push_back(static_cast<uint8_t>((sample >> 8) + 128));
+    return;
+  }
+  output->push_back(static_cast<uint8_t>(sample & 0xFF));
+  output->push_back(static_cast<uint8_t>((sample >> 8) & 0xFF));
+}
+
+}  // namespace media_manager
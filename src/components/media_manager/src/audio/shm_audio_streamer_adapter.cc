@@ -1,5 +1,5 @@
-/*
- * Copyright (c) 2014, Ford Motor Company
+/**
+ * Copyright (c) 2013, Ford Motor Company
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -28,19 +28,25 @@
  * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
- */
+*/
 
-#ifndef SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_MECTRIC_H_
-#define SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_MECTRIC_H_
+#include "media_manager/audio/shm_audio_streamer_adapter.h"
+#include "config_profile/profile.h"
+#include "utils/logger.h"
 
-#include <string>
+namespace media_manager {
 
-namespace time_tester {
+CREATE_LOGGERPTR_GLOBAL(logger, "ShmAudioStreamerAdapter")
 
-class Metric {
-  public:
-    virtual std::string GetStyledString() = 0;
-    virtual ~Metric(){}
-};
-}  // namespace time_tester
-#endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_MECTRIC_H_
+ShmAudioStreamerAdapter::ShmAudioStreamerAdapter() {
+  LOG4CXX_INFO(logger, "ShmAudioStreamerAdapter::ShmAudioStreamerAdapter");
+  shm_name_ = profile::Profile::instance()->audio_shm_name();
+
+  Init();
+}
+
+ShmAudioStreamerAdapter::~ShmAudioStreamerAdapter() {
+  LOG4CXX_INFO(logger, "ShmAudioStreamerAdapter::~ShmAudioStreamerAdapter");
+}
+
+}  // namespace media_manager
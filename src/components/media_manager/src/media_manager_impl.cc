@@ -52,6 +52,10 @@
 #include "media_manager/video/pipe_video_streamer_adapter.h"
 #include "media_manager/audio/pipe_audio_streamer_adapter.h"
 #include "media_manager/video/video_stream_to_file_adapter.h"
+#if defined(OS_LINUX) && !defined(OS_ANDROID)
+#include "media_manager/video/shm_video_streamer_adapter.h"
+#include "media_manager/audio/shm_audio_streamer_adapter.h"
+#endif
 #ifdef SP_C9_PRIMA1
 #include "media_manager/video/sharedmem_video_streamer_adapter.h"
 #endif
@@ -66,6 +70,28 @@ namespace media_manager {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "MediaManagerImpl")
 
+namespace {
+// Message with part of received frame, frame itself if it goes whole
+protocol_handler::RawMessagePtr FramePartMessage(
+  const protocol_handler::RawMessagePtr& message,
+  const VideoFlowController::FramePart& part) {
+  if (0 == part.prefix_size && 0 == part.offset &&
+      message->data_size() == part.size) {
+    return message;
+  }
+  utils::SharedBuffer payload =
+    message->buffer().Slice(part.offset, part.size);
+  if (part.prefix_size) {
+    std::vector<uint8_t> bytes(part.prefix, part.prefix + part.prefix_size);
+    bytes.insert(bytes.end(), payload.begin(), payload.end());
+    payload = utils::SharedBuffer::Adopt(&bytes);
+  }
+  return protocol_handler::RawMessagePtr(new protocol_handler::RawMessage(
+    message->connection_key(), message->protocol_version(), payload,
+    message->service_type()));
+}
+}  // namespace
+
 MediaManagerImpl::MediaManagerImpl()
   : protocol_handler_(NULL)
   , a2dp_player_(NULL)
@@ -155,6 +181,10 @@ void MediaManagerImpl::Init() {
     video_streamer_ = new SocketVideoStreamerAdapter();
   } else if ("pipe" == profile::Profile::instance()->video_server_type()) {
     video_streamer_ = new PipeVideoStreamerAdapter();
+#if defined(OS_LINUX) && !defined(OS_ANDROID)
+  } else if ("shm" == profile::Profile::instance()->video_server_type()) {
+    video_streamer_ = new ShmVideoStreamerAdapter();
+#endif
   } else if ("file" == profile::Profile::instance()->video_server_type()) {
     video_streamer_ = new VideoStreamToFileAdapter(
         profile::Profile::instance()->video_stream_file());
@@ -164,14 +194,18 @@ void MediaManagerImpl::Init() {
     audio_streamer_ = new SocketAudioStreamerAdapter();
   } else if ("pipe" == profile::Profile::instance()->audio_server_type()) {
     audio_streamer_ = new PipeAudioStreamerAdapter();
+#if defined(OS_LINUX) && !defined(OS_ANDROID)
+  } else if ("shm" == profile::Profile::instance()->audio_server_type()) {
+    audio_streamer_ = new ShmAudioStreamerAdapter();
+#endif
   } else if ("file" == profile::Profile::instance()->audio_server_type()) {
     audio_streamer_ = new VideoStreamToFileAdapter(
         profile::Profile::instance()->audio_stream_file());
   }
 #endif
 
-  video_streamer_listener_ = new StreamerListener();
-  audio_streamer_listener_ = new StreamerListener();
+  video_streamer_listener_ = new StreamerListener(protocol_handler::kMobileNav);
+  audio_streamer_listener_ = new StreamerListener(protocol_handler::kAudio);
 
   if (NULL != video_streamer_) {
     video_streamer_->AddListener(video_streamer_listener_);
@@ -199,7 +233,9 @@ void MediaManagerImpl::StopA2DPSource(int32_t application_key) {
 void MediaManagerImpl::StartMicrophoneRecording(
   int32_t application_key,
   const std::string& output_file,
-  int32_t duration) {
+  int32_t duration,
+  int32_t sampling_rate,
+  int32_t bits_per_sample) {
   LOG4CXX_INFO(logger_, "MediaManagerImpl::StartMicrophoneRecording to "
                << output_file);
   application_manager::ApplicationSharedPtr app =
@@ -208,7 +244,20 @@ void MediaManagerImpl::StartMicrophoneRecording(
   std::string file_path = profile::Profile::instance()->app_storage_folder();
   file_path += "/";
   file_path += output_file;
-  from_mic_listener_ = new FromMicRecorderListener(file_path);
+  const PcmFormat format =
+    PcmFormat::FromMobileApi(sampling_rate, bits_per_sample);
+  MediaListenerPtr listener;
+#if defined(MODIFY_FUNCTION_SIGN) || defined(OS_WIN32)
+  // Recorder pushes samples in requested format with OnMicrophoneData
+  listener = new FromMicRecorderListener("", format, format);
+#else
+  // Recording file format is taken from its header
+  listener = new FromMicRecorderListener(file_path, PcmFormat(), format);
+#endif
+  {
+    sync_primitives::AutoLock auto_lock(from_mic_listener_lock_);
+    from_mic_listener_ = listener;
+  }
 #if defined(MODIFY_FUNCTION_SIGN) || defined(OS_WIN32)
 	// do nothing
 #else
@@ -249,7 +298,7 @@ void MediaManagerImpl::StartMicrophoneRecording(
   }
 #endif
 #endif // MODIFY_FUNCTION_SIGN
-  from_mic_listener_->OnActivityStarted(application_key);
+  listener->OnActivityStarted(application_key);
 }
 
 void MediaManagerImpl::StopMicrophoneRecording(int32_t application_key) {
@@ -263,8 +312,26 @@ void MediaManagerImpl::StopMicrophoneRecording(int32_t application_key) {
   }
 #endif
 #endif
-  if (from_mic_listener_) {
-    from_mic_listener_->OnActivityEnded(application_key);
+  MediaListenerPtr listener;
+  {
+    sync_primitives::AutoLock auto_lock(from_mic_listener_lock_);
+    listener = from_mic_listener_;
+  }
+  if (listener) {
+    listener->OnActivityEnded(application_key);
+  }
+}
+
+void MediaManagerImpl::OnMicrophoneData(int32_t application_key,
+                                        const uint8_t* data, size_t size) {
+  MediaListenerPtr listener;
+  {
+    sync_primitives::AutoLock auto_lock(from_mic_listener_lock_);
+    listener = from_mic_listener_;
+  }
+  if (listener) {
+    static_cast<FromMicRecorderListener*>(listener.get())->
+      OnMicrophoneData(data, size);
   }
 }
 
@@ -275,6 +342,7 @@ void MediaManagerImpl::StartVideoStreaming(int32_t application_key) {
   if (video_streamer_) {
     if (!video_stream_active_) {
       video_stream_active_ = true;
+      video_flow_controller_.Start();
       video_streamer_->StartActivity(application_key);
 
       char url[100] = {'\0'};
@@ -288,6 +356,9 @@ void MediaManagerImpl::StartVideoStreaming(int32_t application_key) {
       } else if ("pipe" == profile::Profile::instance()->video_server_type()) {
         snprintf(url, sizeof(url) / sizeof(url[0]), "%s",
                  profile::Profile::instance()->named_video_pipe_path().c_str());
+      } else if ("shm" == profile::Profile::instance()->video_server_type()) {
+        snprintf(url, sizeof(url) / sizeof(url[0]), "shm://%s",
+                 profile::Profile::instance()->video_shm_name().c_str());
 #ifdef SP_C9_PRIMA1
 	  } else if("sharedmem" == profile::Profile::instance()->video_server_type()){
 		snprintf(url, sizeof(url) / sizeof(url[0]), "%s",
@@ -330,6 +401,9 @@ void MediaManagerImpl::StartAudioStreaming(int32_t application_key) {
       } else if ("pipe" == profile::Profile::instance()->audio_server_type()) {
         snprintf(url, sizeof(url) / sizeof(url[0]), "%s",
                  profile::Profile::instance()->named_audio_pipe_path().c_str());
+      } else if ("shm" == profile::Profile::instance()->audio_server_type()) {
+        snprintf(url, sizeof(url) / sizeof(url[0]), "shm://%s",
+                 profile::Profile::instance()->audio_shm_name().c_str());
 #ifdef SP_C9_PRIMA1
 	  } else if("sharedmem" == profile::Profile::instance()->audio_server_type()){
 		snprintf(url, sizeof(url) / sizeof(url[0]), "%s",
@@ -375,7 +449,18 @@ void MediaManagerImpl::OnMessageReceived(
    //                              << message.get()->data_size()
    //                              << ", data:" << hexdata.str());
 #endif
-      video_streamer_->SendData(message->connection_key(), message);
+      uint32_t frames_to_ack = 0;
+      VideoFlowController::FramePart part;
+      const bool is_streamed = video_flow_controller_.OnFrameReceived(
+        message->data(), message->data_size(), &part, &frames_to_ack);
+      if (frames_to_ack && protocol_handler_) {
+        protocol_handler_->SendFramesNumber(message->connection_key(),
+                                            frames_to_ack);
+      }
+      if (is_streamed) {
+        video_streamer_->SendData(message->connection_key(),
+                                  FramePartMessage(message, part));
+      }
     }
   } else if (message->service_type()
           == protocol_handler::kAudio) {
@@ -393,11 +478,17 @@ void MediaManagerImpl::OnMobileMessageSent(
   const protocol_handler::RawMessagePtr& message) {
 }
 
-void MediaManagerImpl::FramesProcessed(int32_t application_key,
-                                       int32_t frame_number) {
-  if (protocol_handler_) {
-    /*protocol_handler_->SendFramesNumber(application_key,
-                                        frame_number);*/
+void MediaManagerImpl::FramesProcessed(
+  int32_t application_key,
+  int32_t frame_number,
+  protocol_handler::ServiceType service_type) {
+  if (protocol_handler::kMobileNav != service_type) {
+    return;
+  }
+  uint32_t frames_to_ack = 0;
+  video_flow_controller_.OnFrameProcessed(&frames_to_ack);
+  if (frames_to_ack && protocol_handler_) {
+    protocol_handler_->SendFramesNumber(application_key, frames_to_ack);
   }
 }
 
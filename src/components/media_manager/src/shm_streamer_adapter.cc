@@ -0,0 +1,285 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(OS_LINUX)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+#include "utils/atomic.h"
+#include "utils/date_time.h"
+#include "utils/logger.h"
+#include "utils/memory_barrier.h"
+#include "config_profile/profile.h"
+#include "media_manager/shm_streamer_adapter.h"
+
+namespace media_manager {
+
+CREATE_LOGGERPTR_GLOBAL(logger, "ShmStreamerAdapter")
+
+namespace {
+const uint32_t kMinDataSize = 64 * 1024;
+// Overruns are reported once per this amount of dropped frames
+const uint32_t kOverrunsReportPeriod = 100;
+
+uint32_t RoundDownToPowerOfTwo(uint32_t value) {
+  uint32_t result = 1;
+  while (value / 2 >= result) {
+    result *= 2;
+  }
+  return result;
+}
+}  // namespace
+
+ShmStreamerAdapter::ShmStreamerAdapter()
+  : header_(NULL),
+    data_size_(0),
+    write_position_(0),
+    dropped_(0),
+    messages_for_session_(0),
+    is_ready_(false) {
+  LOG4CXX_INFO(logger, "ShmStreamerAdapter::ShmStreamerAdapter");
+}
+
+ShmStreamerAdapter::~ShmStreamerAdapter() {
+  LOG4CXX_INFO(logger, "ShmStreamerAdapter::~ShmStreamerAdapter");
+
+  if ((0 != current_application_) && (is_ready_)) {
+    StopActivity(current_application_);
+  }
+
+  if (header_) {
+    munmap(header_, shm_ring::ObjectSize(data_size_));
+    header_ = NULL;
+    shm_unlink(shm_name_.c_str());
+  }
+}
+
+void ShmStreamerAdapter::SendData(
+  int32_t application_key,
+  const protocol_handler::RawMessagePtr& message) {
+  LOG4CXX_TRACE(logger, "ShmStreamerAdapter::SendData");
+
+  if (application_key != current_application_) {
+    LOG4CXX_WARN(logger, "Wrong application " << application_key);
+    return;
+  }
+
+  if (!is_ready_ || !header_ || !message) {
+    return;
+  }
+
+  if (!Publish(message)) {
+    ++dropped_;
+    header_->overruns = header_->overruns + 1;
+    if (0 == header_->overruns % kOverrunsReportPeriod) {
+      LOG4CXX_WARN(logger, "Consumer of " << shm_name_ << " is too slow, "
+                   << header_->overruns << " frames dropped");
+    }
+    return;
+  }
+
+  ++messages_for_session_;
+  for (std::set<MediaListenerPtr>::iterator it = media_listeners_.begin();
+       media_listeners_.end() != it; ++it) {
+    (*it)->OnDataReceived(current_application_, messages_for_session_);
+  }
+}
+
+void ShmStreamerAdapter::StartActivity(int32_t application_key) {
+  LOG4CXX_INFO(logger, "ShmStreamerAdapter::StartActivity");
+
+  if (application_key == current_application_) {
+    LOG4CXX_WARN(logger, "Already started activity for " << application_key);
+    return;
+  }
+
+  current_application_ = application_key;
+  messages_for_session_ = 0;
+  if (header_) {
+    header_->session = header_->session + 1;
+    header_->state = shm_ring::kStreaming;
+    RingDoorbell();
+    is_ready_ = true;
+  }
+
+  for (std::set<MediaListenerPtr>::iterator it = media_listeners_.begin();
+       media_listeners_.end() != it; ++it) {
+    (*it)->OnActivityStarted(application_key);
+  }
+}
+
+void ShmStreamerAdapter::StopActivity(int32_t application_key) {
+  LOG4CXX_INFO(logger, "ShmStreamerAdapter::StopActivity");
+
+  if (application_key != current_application_) {
+    LOG4CXX_WARN(logger, "Not performing activity for " << application_key);
+    return;
+  }
+
+  is_ready_ = false;
+  current_application_ = 0;
+  if (header_) {
+    header_->state = shm_ring::kIdle;
+    RingDoorbell();
+  }
+
+  for (std::set<MediaListenerPtr>::iterator it = media_listeners_.begin();
+       media_listeners_.end() != it; ++it) {
+    (*it)->OnActivityEnded(application_key);
+  }
+}
+
+bool ShmStreamerAdapter::is_app_performing_activity(int32_t application_key) {
+  return (application_key == current_application_);
+}
+
+void ShmStreamerAdapter::Init() {
+  if (header_) {
+    return;
+  }
+
+  uint32_t data_size =
+    profile::Profile::instance()->media_shm_ring_size() * 1024;
+  if (data_size < kMinDataSize) {
+    data_size = kMinDataSize;
+  }
+  // Power of two size keeps positions continuous when they wrap
+  data_size = RoundDownToPowerOfTwo(data_size);
+  const uint32_t object_size = shm_ring::ObjectSize(data_size);
+
+  const int fd = shm_open(shm_name_.c_str(), O_CREAT | O_RDWR,
+                          S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  if (-1 == fd) {
+    LOG4CXX_ERROR(logger, "Cannot open shared memory " << shm_name_
+                  << ": " << strerror(errno));
+    return;
+  }
+
+  if (-1 == ftruncate(fd, object_size)) {
+    LOG4CXX_ERROR(logger, "Cannot resize shared memory " << shm_name_
+                  << ": " << strerror(errno));
+    close(fd);
+    shm_unlink(shm_name_.c_str());
+    return;
+  }
+
+  void* memory = mmap(NULL, object_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      fd, 0);
+  close(fd);
+  if (MAP_FAILED == memory) {
+    LOG4CXX_ERROR(logger, "Cannot map shared memory " << shm_name_
+                  << ": " << strerror(errno));
+    shm_unlink(shm_name_.c_str());
+    return;
+  }
+
+  header_ = static_cast<shm_ring::Header*>(memory);
+  memset(header_, 0, sizeof(*header_));
+  header_->version = shm_ring::kVersion;
+  header_->data_size = data_size;
+  header_->descriptors_count = shm_ring::kDescriptorsCount;
+  header_->state = shm_ring::kIdle;
+  utils::memory_barrier();
+  // Consumer checks magic to know header is initialized
+  header_->magic = shm_ring::kMagic;
+  data_size_ = data_size;
+  write_position_ = 0;
+
+  LOG4CXX_INFO(logger, "Shared memory " << shm_name_ << " with ring of "
+               << data_size_ << " bytes is ready");
+}
+
+uint32_t ShmStreamerAdapter::FrameFlags(const uint8_t* data,
+                                        uint32_t size) const {
+  return 0;
+}
+
+bool ShmStreamerAdapter::Publish(
+  const protocol_handler::RawMessagePtr& message) {
+  const uint32_t size = message->data_size();
+  const uint32_t write_index = header_->write_index;
+  const uint32_t read_index = header_->read_index;
+
+  if (write_index - read_index >= shm_ring::kDescriptorsCount ||
+      size > data_size_) {
+    return false;
+  }
+
+  // Payload must be contiguous, remainder of data area is skipped
+  uint32_t position = write_position_;
+  const uint32_t offset = position % data_size_;
+  if (offset + size > data_size_) {
+    position += data_size_ - offset;
+  }
+
+  const uint32_t tail = (write_index == read_index) ? position :
+      header_->descriptors[read_index % shm_ring::kDescriptorsCount].position;
+  if (position + size - tail > data_size_) {
+    return false;
+  }
+
+  memcpy(shm_ring::Data(header_) + position % data_size_, message->data(),
+         size);
+
+  shm_ring::FrameDescriptor& descriptor =
+    header_->descriptors[write_index % shm_ring::kDescriptorsCount];
+  descriptor.timestamp = static_cast<uint64_t>(
+    date_time::DateTime::getuSecs(message->creation_time()));
+  descriptor.position = position;
+  descriptor.size = size;
+  descriptor.flags = FrameFlags(message->data(), size);
+  descriptor.dropped_before = dropped_;
+  dropped_ = 0;
+
+  // Payload and descriptor must be visible before index
+  utils::memory_barrier();
+  header_->write_index = write_index + 1;
+  write_position_ = position + size;
+  RingDoorbell();
+  return true;
+}
+
+void ShmStreamerAdapter::RingDoorbell() {
+  atomic_post_inc(&header_->doorbell);
+#if defined(OS_LINUX)
+  syscall(SYS_futex, &header_->doorbell, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+}  // namespace media_manager
@@ -41,8 +41,10 @@ namespace media_manager {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "StreamerListener")
 
-StreamerListener::StreamerListener()
-  : current_application_(0) {
+StreamerListener::StreamerListener(
+  protocol_handler::ServiceType service_type)
+  : current_application_(0),
+    service_type_(service_type) {
 }
 
 StreamerListener::~StreamerListener() {
@@ -52,7 +54,8 @@ StreamerListener::~StreamerListener() {
 void StreamerListener::OnDataReceived(
   int32_t application_key,
   const DataForListener& data) {
-  MediaManagerImpl::instance()->FramesProcessed(application_key, data);
+  MediaManagerImpl::instance()->FramesProcessed(application_key, data,
+                                                service_type_);
 }
 
 void StreamerListener::OnErrorReceived(
@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef MODIFY_FUNCTION_SIGN
+#include <global_first.h>
+#endif
+#include "media_manager/video/h264_access_unit_tracker.h"
+
+namespace media_manager {
+
+namespace {
+const uint8_t kNalTypeMask = 0x1F;
+const uint8_t kNalTypeSlice = 1;
+const uint8_t kNalTypeIdrSlice = 5;
+const uint8_t kNalTypeSei = 6;
+const uint8_t kNalTypeSps = 7;
+const uint8_t kNalTypePps = 8;
+const uint8_t kNalTypeAccessUnitDelimiter = 9;
+// first_mb_in_slice is ue(v), its value is 0 if first bit is set
+const uint8_t kFirstMbInSliceZeroMask = 0x80;
+}  // namespace
+
+H264AccessUnitTracker::ChunkInfo::ChunkInfo()
+  : access_unit(false),
+    access_unit_offset(0),
+    key_frame(false),
+    key_frame_offset(0),
+    key_frame_header(0) {
+}
+
+H264AccessUnitTracker::H264AccessUnitTracker() {
+  Reset();
+}
+
+void H264AccessUnitTracker::Reset() {
+  state_ = kSearchStartCode;
+  zeros_ = 0;
+  nal_header_ = 0;
+  chunk_begin_ = 0;
+  position_ = 0;
+  nal_start_ = 0;
+  nal_header_position_ = 0;
+  access_unit_has_slice_ = false;
+}
+
+H264AccessUnitTracker::ChunkInfo H264AccessUnitTracker::Process(
+  const uint8_t* data, uint32_t size) {
+  ChunkInfo info;
+  chunk_begin_ = position_;
+  for (uint32_t i = 0; i < size; ++i, ++position_) {
+    const uint8_t byte = data[i];
+    switch (state_) {
+      case kNalHeader:
+        OnNalHeader(byte, &info);
+        break;
+      case kSliceHeader:
+        OnSliceHeader(byte, &info);
+        break;
+      case kSearchStartCode:
+        if (0 == byte) {
+          ++zeros_;
+        } else {
+          if (1 == byte && zeros_ >= 2) {
+            state_ = kNalHeader;
+            nal_start_ = position_ - zeros_;
+          }
+          zeros_ = 0;
+        }
+        break;
+    }
+  }
+  return info;
+}
+
+void H264AccessUnitTracker::OnNalHeader(uint8_t header, ChunkInfo* info) {
+  const uint8_t nal_type = header & kNalTypeMask;
+  nal_header_ = header;
+  nal_header_position_ = position_;
+  state_ = kSearchStartCode;
+
+  if (kNalTypeSlice <= nal_type && kNalTypeIdrSlice >= nal_type) {
+    state_ = kSliceHeader;
+    return;
+  }
+
+  const bool starts_access_unit =
+    kNalTypeSei == nal_type || kNalTypeSps == nal_type ||
+    kNalTypePps == nal_type || kNalTypeAccessUnitDelimiter == nal_type;
+  if (starts_access_unit && access_unit_has_slice_) {
+    StartAccessUnit(info);
+  }
+  if (kNalTypeSps == nal_type) {
+    FoundKeyFrame(info);
+  }
+}
+
+void H264AccessUnitTracker::OnSliceHeader(uint8_t first_byte,
+                                          ChunkInfo* info) {
+  state_ = kSearchStartCode;
+  const bool first_slice = 0 != (first_byte & kFirstMbInSliceZeroMask);
+  if (first_slice && access_unit_has_slice_) {
+    StartAccessUnit(info);
+  }
+  access_unit_has_slice_ = true;
+  if (first_slice && kNalTypeIdrSlice == (nal_header_ & kNalTypeMask)) {
+    FoundKeyFrame(info);
+  }
+}
+
+void H264AccessUnitTracker::StartAccessUnit(ChunkInfo* info) {
+  access_unit_has_slice_ = false;
+  if (!info->access_unit) {
+    info->access_unit = true;
+    info->access_unit_offset = OffsetInChunk(nal_start_);
+  }
+}
+
+void H264AccessUnitTracker::FoundKeyFrame(ChunkInfo* info) {
+  if (!info->key_frame) {
+    info->key_frame = true;
+    info->key_frame_offset = OffsetInChunk(nal_header_position_);
+    info->key_frame_header = nal_header_;
+  }
+}
+
+int32_t H264AccessUnitTracker::OffsetInChunk(uint64_t position) const {
+  return static_cast<int32_t>(static_cast<int64_t>(position) -
+                              static_cast<int64_t>(chunk_begin_));
+}
+
+}  // namespace media_manager
@@ -1,5 +1,5 @@
-/*
- * Copyright (c) 2014, Ford Motor Company
+/**
+ * Copyright (c) 2013, Ford Motor Company
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -28,44 +28,52 @@
  * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
- */
+*/
 
-#include "protocol_handler_observer.h"
-#include "utils/date_time.h"
-#include "protocol_handler_metric.h"
-#include "time_manager.h"
+#include "media_manager/video/shm_video_streamer_adapter.h"
+#include "config_profile/profile.h"
+#include "utils/logger.h"
 
-namespace time_tester {
+namespace media_manager {
 
-CREATE_LOGGERPTR_GLOBAL(logger_, "Utils")
+CREATE_LOGGERPTR_GLOBAL(logger, "ShmVideoStreamerAdapter")
 
-ProtocolHandlerObserver::ProtocolHandlerObserver(TimeManager *time_manager):
-  time_manager_(time_manager) {
+namespace {
+const uint8_t kNalTypeMask = 0x1F;
+const uint8_t kNalTypeSlice = 1;
+const uint8_t kNalTypeIdrSlice = 5;
+const uint8_t kNalTypeSps = 7;
+}  // namespace
+
+ShmVideoStreamerAdapter::ShmVideoStreamerAdapter() {
+  LOG4CXX_INFO(logger, "ShmVideoStreamerAdapter::ShmVideoStreamerAdapter");
+  shm_name_ = profile::Profile::instance()->video_shm_name();
+
+  Init();
 }
 
-void ProtocolHandlerObserver::StartMessageProcess(uint32_t message_id) {
-  if (message_id == 0) {
-    return;
-  }
-  if (time_starts.find(message_id) != time_starts.end()) {
-    LOG4CXX_INFO(logger_, "Message ID already wait for stop processing" << message_id);
-    return;
-  }
-  time_starts[message_id] = date_time::DateTime::getCurrentTime();
+ShmVideoStreamerAdapter::~ShmVideoStreamerAdapter() {
+  LOG4CXX_INFO(logger, "ShmVideoStreamerAdapter::~ShmVideoStreamerAdapter");
 }
 
-void ProtocolHandlerObserver::EndMessageProcess(utils::SharedPtr<MessageMetric> m) {
-  uint32_t message_id = m->message_id;
-  std::map<uint32_t, TimevalStruct>::const_iterator it = time_starts.find(message_id);
-  if (it == time_starts.end()) {
-    LOG4CXX_WARN(logger_, "Cant find start time for message" << message_id);
-    return;
+uint32_t ShmVideoStreamerAdapter::FrameFlags(const uint8_t* data,
+                                             uint32_t size) const {
+  // Look through Annex B start codes up to first slice, so only headers
+  // of access unit are scanned and not the slice data
+  for (uint32_t i = 0; i + 3 < size; ++i) {
+    if (0 != data[i] || 0 != data[i + 1] || 1 != data[i + 2]) {
+      continue;
+    }
+    const uint8_t nal_type = data[i + 3] & kNalTypeMask;
+    if (kNalTypeSps == nal_type) {
+      return shm_ring::kKeyFrame;
+    }
+    if (kNalTypeSlice <= nal_type && kNalTypeIdrSlice >= nal_type) {
+      return kNalTypeIdrSlice == nal_type ? shm_ring::kKeyFrame : 0;
+    }
+    i += 2;
   }
-  m->begin= time_starts[message_id];
-  m->end = date_time::DateTime::getCurrentTime();
-  ProtocolHandlerMecticWrapper* metric = new ProtocolHandlerMecticWrapper();
-  metric->message_metric = m;
-  metric->grabResources();
-  time_manager_->SendMetric(metric);
+  return 0;
 }
-}  //namespace time_tester
+
+}  // namespace media_manager
@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef MODIFY_FUNCTION_SIGN
+#include <global_first.h>
+#endif
+#include "media_manager/video/video_flow_controller.h"
+
+#include <string.h>
+
+#include "utils/logger.h"
+
+namespace media_manager {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "VideoFlowController")
+
+namespace {
+// Backlog which starts dropping till next key frame
+const uint32_t kMaxLatencyMs = 500;
+// Used while drain rate is unknown
+const uint32_t kMaxFramesInFlight = 60;
+// Dropping stops at key frame only if backlog went below half of limits
+const uint32_t kResumeLatencyMs = kMaxLatencyMs / 2;
+const uint32_t kResumeFramesInFlight = kMaxFramesInFlight / 2;
+const uint32_t kRateWindowMs = 1000;
+const uint32_t kAcksPerSecond = 10;
+const uint32_t kMaxAckPeriod = 30;
+}  // namespace
+
+VideoFlowController::FramePart::FramePart()
+  : offset(0),
+    size(0),
+    prefix_size(0) {
+}
+
+VideoFlowController::VideoFlowController() {
+  Start();
+}
+
+void VideoFlowController::Start() {
+  sync_primitives::AutoLock lock(lock_);
+  tracker_.Reset();
+  queued_ = 0;
+  processed_ = 0;
+  dropped_ = 0;
+  acked_ = 0;
+  dropping_ = false;
+  rate_window_start_ = date_time::DateTime::getCurrentTime();
+  rate_window_processed_ = 0;
+  drain_rate_ = 0;
+}
+
+bool VideoFlowController::OnFrameReceived(const uint8_t* data, uint32_t size,
+                                          FramePart* part,
+                                          uint32_t* frames_to_ack) {
+  sync_primitives::AutoLock lock(lock_);
+  // Stream is parsed even when frames are dropped to stay in sync
+  const H264AccessUnitTracker::ChunkInfo info = tracker_.Process(data, size);
+  UpdateDrainRate();
+
+  *part = FramePart();
+  if (!dropping_) {
+    part->size = size;
+    // Dropping may start only where new access unit starts, bytes
+    // before it complete access unit already passed to streamer
+    if (info.access_unit &&
+        IsBacklogAbove(kMaxLatencyMs, kMaxFramesInFlight)) {
+      LOG4CXX_WARN(logger_, "Video consumer is behind by "
+                   << queued_ - processed_ << " frames, draining "
+                   << drain_rate_ << " fps. Dropping till next key frame");
+      dropping_ = true;
+      part->size = info.access_unit_offset > 0 ?
+                   static_cast<uint32_t>(info.access_unit_offset) : 0;
+    }
+  } else if (info.key_frame &&
+             !IsBacklogAbove(kResumeLatencyMs, kResumeFramesInFlight)) {
+    LOG4CXX_INFO(logger_, "Resuming video at key frame, "
+                 << dropped_ << " frames dropped so far");
+    dropping_ = false;
+    // Start code of key frame NAL unit may be split with previous frame,
+    // so a fresh one is put in front of the NAL unit
+    static const uint8_t kStartCode[] = {0, 0, 0, 1};
+    memcpy(part->prefix, kStartCode, sizeof(kStartCode));
+    part->prefix_size = sizeof(kStartCode);
+    if (info.key_frame_offset < 0) {
+      part->prefix[part->prefix_size++] = info.key_frame_header;
+    } else {
+      part->offset = info.key_frame_offset;
+    }
+    part->size = size - part->offset;
+  }
+
+  if (0 == part->size && 0 == part->prefix_size) {
+    ++dropped_;
+    *frames_to_ack = FramesToAck();
+    return false;
+  }
+
+  ++queued_;
+  *frames_to_ack = 0;
+  return true;
+}
+
+void VideoFlowController::OnFrameProcessed(uint32_t* frames_to_ack) {
+  sync_primitives::AutoLock lock(lock_);
+  // Frames queued before stream restart are not accounted
+  if (processed_ < queued_) {
+    ++processed_;
+  }
+  ++rate_window_processed_;
+  UpdateDrainRate();
+  *frames_to_ack = FramesToAck();
+}
+
+void VideoFlowController::UpdateDrainRate() {
+  const int64_t elapsed =
+    date_time::DateTime::calculateTimeSpan(rate_window_start_);
+  if (elapsed < kRateWindowMs) {
+    return;
+  }
+  const uint32_t rate =
+    static_cast<uint32_t>(rate_window_processed_ * 1000 / elapsed);
+  // Smooth measurements, but let stalled consumer show up quickly
+  drain_rate_ = (0 == drain_rate_ || rate < drain_rate_ / 2) ?
+                rate : (drain_rate_ * 3 + rate) / 4;
+  rate_window_start_ = date_time::DateTime::getCurrentTime();
+  rate_window_processed_ = 0;
+}
+
+bool VideoFlowController::IsBacklogAbove(uint32_t latency_ms,
+                                         uint32_t frames) const {
+  const uint32_t in_flight = queued_ - processed_;
+  if (0 == drain_rate_) {
+    return in_flight > frames;
+  }
+  return in_flight * 1000 / drain_rate_ > latency_ms;
+}
+
+uint32_t VideoFlowController::FramesToAck() {
+  const uint32_t consumed = processed_ + dropped_;
+  uint32_t ack_period = drain_rate_ / kAcksPerSecond;
+  if (0 == ack_period) {
+    ack_period = 1;
+  } else if (ack_period > kMaxAckPeriod) {
+    ack_period = kMaxAckPeriod;
+  }
+  if (consumed - acked_ < ack_period) {
+    return 0;
+  }
+  acked_ = consumed;
+  return consumed;
+}
+
+}  // namespace media_manager
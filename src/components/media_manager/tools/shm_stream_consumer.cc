@@ -0,0 +1,211 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+ * Reference consumer of media shared memory ring (see shm_ring.h).
+ *
+ * Usage: shm_stream_consumer [shm_name] [output_file]
+ * Writes received payloads to output_file (stdout by default), so stream
+ * can be piped into decoder, and prints ring statistics to stderr.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include "media_manager/shm_ring.h"
+
+namespace shm_ring = media_manager::shm_ring;
+
+namespace {
+
+const char kDefaultShmName[] = "/sdl_video_stream";
+const uint32_t kWaitTimeoutMs = 1000;
+
+uint64_t NowUsec() {
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  return static_cast<uint64_t>(now.tv_sec) * 1000000 + now.tv_usec;
+}
+
+void Sleep(uint32_t milliseconds) {
+  usleep(milliseconds * 1000);
+}
+
+/**
+ * Wait until doorbell differs from seen value or timeout expires
+ */
+void WaitDoorbell(volatile uint32_t* doorbell, uint32_t seen) {
+#if defined(__linux__)
+  struct timespec timeout;
+  timeout.tv_sec = kWaitTimeoutMs / 1000;
+  timeout.tv_nsec = (kWaitTimeoutMs % 1000) * 1000000;
+  syscall(SYS_futex, doorbell, FUTEX_WAIT, seen, &timeout, NULL, 0);
+#else
+  // No cross process wait primitive, poll with short period
+  for (uint32_t i = 0; i < kWaitTimeoutMs && *doorbell == seen; ++i) {
+    Sleep(1);
+  }
+#endif
+}
+
+shm_ring::Header* MapRing(const char* name) {
+  const int fd = shm_open(name, O_RDWR, 0);
+  if (-1 == fd) {
+    return NULL;
+  }
+  struct stat info;
+  if (-1 == fstat(fd, &info) ||
+      info.st_size < static_cast<off_t>(sizeof(shm_ring::Header))) {
+    close(fd);
+    return NULL;
+  }
+  void* memory = mmap(NULL, info.st_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, 0);
+  close(fd);
+  if (MAP_FAILED == memory) {
+    return NULL;
+  }
+  shm_ring::Header* header = static_cast<shm_ring::Header*>(memory);
+  if (shm_ring::kMagic != header->magic ||
+      shm_ring::kVersion != header->version ||
+      info.st_size < static_cast<off_t>(
+          shm_ring::ObjectSize(header->data_size))) {
+    munmap(memory, info.st_size);
+    return NULL;
+  }
+  return header;
+}
+
+bool WriteAll(int fd, const uint8_t* data, uint32_t size) {
+  while (size > 0) {
+    const ssize_t written = write(fd, data, size);
+    if (written <= 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const char* shm_name = argc > 1 ? argv[1] : kDefaultShmName;
+  int output_fd = STDOUT_FILENO;
+  if (argc > 2) {
+    output_fd = open(argv[2], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (-1 == output_fd) {
+      fprintf(stderr, "Cannot open %s: %s\n", argv[2], strerror(errno));
+      return EXIT_FAILURE;
+    }
+  }
+
+  shm_ring::Header* header = NULL;
+  while (!(header = MapRing(shm_name))) {
+    fprintf(stderr, "Waiting for %s\n", shm_name);
+    Sleep(kWaitTimeoutMs);
+  }
+  fprintf(stderr, "Attached to %s, ring of %u bytes\n", shm_name,
+          header->data_size);
+
+  // Start from the newest frames, older ones are of no use for live stream
+  uint32_t read_index = header->write_index;
+  header->read_index = read_index;
+
+  uint64_t frames = 0;
+  uint64_t key_frames = 0;
+  uint64_t latency_sum = 0;
+  uint64_t report_time = NowUsec();
+
+  for (;;) {
+    const uint32_t doorbell = header->doorbell;
+    const uint32_t write_index = header->write_index;
+    __sync_synchronize();
+
+    while (read_index != write_index) {
+      const shm_ring::FrameDescriptor& descriptor =
+        header->descriptors[read_index % shm_ring::kDescriptorsCount];
+      const uint8_t* payload = shm_ring::Data(header) +
+                               descriptor.position % header->data_size;
+      if (!WriteAll(output_fd, payload, descriptor.size)) {
+        fprintf(stderr, "Cannot write output: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+      }
+      ++frames;
+      if (descriptor.flags & shm_ring::kKeyFrame) {
+        ++key_frames;
+      }
+      latency_sum += NowUsec() - descriptor.timestamp;
+
+      // Frame is processed, let producer reuse its space
+      __sync_synchronize();
+      header->read_index = ++read_index;
+    }
+
+    const uint64_t now = NowUsec();
+    if (now - report_time >= 1000000) {
+      fprintf(stderr, "state %u session %u frames %llu key frames %llu "
+              "overruns %u average latency %llu us\n",
+              header->state, header->session,
+              static_cast<unsigned long long>(frames),
+              static_cast<unsigned long long>(key_frames),
+              header->overruns,
+              static_cast<unsigned long long>(
+                frames ? latency_sum / frames : 0));
+      frames = 0;
+      key_frames = 0;
+      latency_sum = 0;
+      report_time = now;
+    }
+
+    if (header->write_index == read_index) {
+      WaitDoorbell(&header->doorbell, doorbell);
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -152,6 +152,19 @@ void FillFunctionalGroupPermissions(
   GroupConsent state,
   std::vector<FunctionalGroupPermission>& permissions);
 
+/**
+ * @brief Compares policy table update with current data snapshot.
+ * Functional groupings, module config and messages of update replace current
+ * ones, application policies are merged, so applications absent in update
+ * are not changed
+ * @param current Current data snapshot
+ * @param update Policy table update
+ * @param delta Entries to be stored, filled by function
+ */
+void CollectTableDelta(const policy_table::Table& current,
+                       const policy_table::Table& update,
+                       PolicyTableDelta* delta);
+
 }
 
 #endif // SRC_COMPONENTS_POLICY_INCLUDE_POLICY_POLICY_HELPER_H_
@@ -36,8 +36,10 @@
 #include <list>
 #include "utils/shared_ptr.h"
 #include "utils/lock.h"
+#include "utils/timer_thread.h"
 #include "policy/policy_manager.h"
 #include "policy/policy_table.h"
+#include "policy/snapshot_cache.h"
 #include "./functions.h"
 #include "usage_statistics/statistics_manager.h"
 
@@ -157,9 +159,12 @@ class PolicyManagerImpl : public PolicyManager {
      * in assigned functional group list of application
      *
      * @param Policy table update struct
+     * @param delta Entries changed by update, only changed applications
+     * are checked
      */
     void CheckPermissionsChanges(
-      const utils::SharedPtr<policy_table::Table> update);
+      const utils::SharedPtr<policy_table::Table> update,
+      const PolicyTableDelta& delta);
 
     /**
      * @brief Fill structure to be sent with OnPermissionsChanged notification
@@ -213,9 +218,49 @@ class PolicyManagerImpl : public PolicyManager {
      */
     void CheckUpdateStatus();
 
+    /**
+     * @brief Gives policy image, which serves queries of application
+     * registration instead of database
+     * @return empty pointer while image is rebuilt, so database is queried
+     */
+    utils::SharedPtr<PolicyImage> policy_image() const;
+
+    bool IsApplicationRepresented(const std::string& app_id) const;
+    bool IsDefaultPolicy(const std::string& app_id) const;
+    bool IsPredataPolicy(const std::string& app_id) const;
+    void GetFunctionalGroupings(
+      policy_table::FunctionalGroupings& groups) const;
+
+    /**
+     * @brief Marks start of database change. Image file is removed and
+     * image is not rebuilt until change is ended.
+     * @param drop_image true if change can't be applied to image, so it is
+     * rebuilt from database later
+     */
+    void BeginPolicyImageChange(bool drop_image);
+
+    /**
+     * @brief Marks end of database change started by BeginPolicyImageChange
+     */
+    void EndPolicyImageChange();
+
+    /**
+     * @brief Gives application policies of "default" or "pre_DataConsent"
+     * application in image, image is saved later
+     */
+    void AssignImagePolicy(const std::string& app_id,
+                           const std::string& policy_id);
+
+    /**
+     * @brief Rebuilds image from database or saves it, if it was changed.
+     * Called by timer, so neither registration nor consent waits for it.
+     */
+    void UpdatePolicyImage();
+
     PolicyListener* listener_;
     PolicyTable policy_table_;
     utils::SharedPtr<policy_table::Table> policy_table_snapshot_;
+    SnapshotCache snapshot_cache_;
     bool exchange_in_progress_;
     bool update_required_;
     bool exchange_pending_;
@@ -271,6 +316,38 @@ class PolicyManagerImpl : public PolicyManager {
      */
     DeviceIds unpaired_device_ids_;
 
+    /**
+     * @brief Policy data served instead of database. Image is replaced as
+     * a whole and never changed in place, so reader keeps it while in use.
+     * Consent records in image may be outdated, consent is always read
+     * from database.
+     */
+    utils::SharedPtr<PolicyImage> policy_image_;
+
+    /**
+     * @brief Changes counter, rebuild overlapped by change is discarded
+     */
+    uint32_t image_changes_;
+
+    /**
+     * @brief Number of database changes in progress
+     */
+    uint32_t image_changes_in_progress_;
+    bool image_rebuild_required_;
+    bool image_save_required_;
+
+    /**
+     * @brief Lock for guarding image and its state
+     */
+    mutable sync_primitives::Lock image_lock_;
+
+    /**
+     * @brief Lock for serializing writes and removal of image file
+     */
+    sync_primitives::Lock image_file_lock_;
+
+    timer::TimerThread<PolicyManagerImpl> image_timer_;
+
     friend struct CheckAppPolicy;
 };
 
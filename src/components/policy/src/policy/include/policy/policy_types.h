@@ -286,6 +286,32 @@ typedef std::map<uint32_t, std::pair<std::string, std::string> > FunctionalGroup
  */
 typedef std::vector<std::string> DeviceIds;
 
+/**
+ * @brief Entries of policy table changed by update, storage rewrites only
+ * these entries instead of the whole table
+ */
+struct PolicyTableDelta {
+    PolicyTableDelta()
+        : module_config_updated(false) {
+    }
+
+    bool IsEmpty() const {
+      return updated_groups.empty() && removed_groups.empty() &&
+             updated_apps.empty() && updated_messages.empty() &&
+             removed_messages.empty() && !module_config_updated;
+    }
+
+    // New functional groups and groups with changed rpcs or consent prompt
+    std::set<std::string> updated_groups;
+    std::set<std::string> removed_groups;
+    // New applications and applications with changed policies
+    std::set<std::string> updated_apps;
+    // Message types with new or changed strings
+    std::set<std::string> updated_messages;
+    std::set<std::string> removed_messages;
+    bool module_config_updated;
+};
+
 }  //  namespace policy
 
 #endif  //  SRC_COMPONENTS_POLICY_INCLUDE_POLICY_POLICY_TYPES_H_
@@ -216,6 +216,15 @@ class PTRepresentation {
      */
     virtual bool Save(const policy_table::Table& table) = 0;
 
+    /**
+     * Saves only changed entries of policy table in storage
+     * @param table policy table, which contains changed entries
+     * @param delta entries changed by update
+     * @return true if successfully
+     */
+    virtual bool SaveDelta(const policy_table::Table& table,
+                           const PolicyTableDelta& delta) = 0;
+
     /**
      * Gets flag updateRequired
      * @return true if update is required
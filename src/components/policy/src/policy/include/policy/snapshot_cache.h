@@ -0,0 +1,100 @@
+/*
+ Copyright (c) 2013, Ford Motor Company
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following
+ disclaimer in the documentation and/or other materials provided with the
+ distribution.
+
+ Neither the name of the Ford Motor Company nor the names of its contributors
+ may be used to endorse or promote products derived from this software
+ without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_POLICY_INCLUDE_POLICY_SNAPSHOT_CACHE_H_
+#define SRC_COMPONENTS_POLICY_INCLUDE_POLICY_SNAPSHOT_CACHE_H_
+
+#include <set>
+#include <string>
+#include "utils/shared_ptr.h"
+#include "./types.h"
+
+namespace policy_table = rpc::policy_table_interface_base;
+
+namespace policy {
+
+/**
+ * @brief Policy data needed to register applications and check their
+ * permissions without querying the database
+ */
+struct PolicyImage {
+  policy_table::Table table;
+  // Applications which got policies of "default" application
+  std::set<std::string> default_apps;
+  // Applications which got policies of "pre_DataConsent" application
+  std::set<std::string> predata_apps;
+};
+
+/**
+ * @brief Image of policy data kept in file next to database, so it is
+ * available at startup without querying the database.
+ *
+ * Image consists of header (signature, format version, policy flavour,
+ * payload size and checksum) followed by compact json of the data.
+ * It holds no pointers and is mapped into memory for loading. Database
+ * stays the source of truth: image is invalidated before database is
+ * changed and saved again later, so image which doesn't pass the checks
+ * is simply rebuilt from database.
+ */
+class SnapshotCache {
+ public:
+  explicit SnapshotCache(const std::string& file_name);
+
+  /**
+   * @brief Reads policy data from image
+   * @return empty pointer if image is missing, damaged or was made by
+   * another version of format or policy flavour
+   */
+  utils::SharedPtr<PolicyImage> Load() const;
+
+  /**
+   * @brief Replaces image with given policy data
+   * @return true if image is written completely
+   */
+  bool Save(const PolicyImage& image) const;
+
+  /**
+   * @brief Removes image, so it is not used until next Save
+   */
+  void Invalidate() const;
+
+  const std::string& file_name() const {
+    return file_name_;
+  }
+
+ private:
+  std::string file_name_;
+};
+
+}  // namespace policy
+
+#endif  // SRC_COMPONENTS_POLICY_INCLUDE_POLICY_SNAPSHOT_CACHE_H_
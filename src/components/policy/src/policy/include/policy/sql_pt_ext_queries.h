@@ -54,6 +54,7 @@ extern const std::string kSelectConsentGroup;
 extern const std::string kInsertPreconsentedGroups;
 extern const std::string kSelectPreconsentedGroups;
 extern const std::string kDeletePreconsentedGroups;
+extern const std::string kDeletePreconsentedGroupsOfApp;
 extern const std::string kSelectUsageAndErrorCount;
 extern const std::string kSelectAppLevels;
 extern const std::string kInsertDeviceData;
@@ -137,6 +137,9 @@ class SQLPTExtRepresentation : public SQLPTRepresentation,
     bool SaveConsentGroup(const std::string& device_id,
                           const policy_table::UserConsentRecords& records);
     bool SaveApplicationPolicies(const policy_table::ApplicationPolicies& apps);
+    bool SaveApplicationPolicy(
+      const policy_table::ApplicationPolicies::value_type& app);
+    bool DeleteApplicationPolicy(const std::string& app_id);
     bool SavePreconsentedGroup(const std::string& app_id,
                                const policy_table::Strings& groups);
     bool SaveMessageString(const std::string& type, const std::string& lang,
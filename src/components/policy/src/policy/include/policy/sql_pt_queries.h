@@ -89,6 +89,16 @@ extern const std::string kDeleteRpc;
 extern const std::string kDeleteAppGroup;
 extern const std::string kDeleteApplication;
 extern const std::string kDeleteDevice;
+extern const std::string kSelectFunctionalGroupId;
+extern const std::string kUpdateFunctionalGroup;
+extern const std::string kDeleteFunctionalGroupById;
+extern const std::string kDeleteRpcOfGroup;
+extern const std::string kDeleteAppGroupOfGroup;
+extern const std::string kDeleteAppGroupOfApp;
+extern const std::string kDeleteNicknameOfApp;
+extern const std::string kDeleteAppTypeOfApp;
+extern const std::string kDeleteApplicationById;
+extern const std::string kDeleteMessageStringOfType;
 extern const std::string kIncrementIgnitionCycles;
 extern const std::string kResetIgnitionCycles;
 extern const std::string kUpdateFlagUpdateRequired;
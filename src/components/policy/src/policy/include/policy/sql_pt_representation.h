@@ -33,6 +33,7 @@
 #ifndef SRC_COMPONENTS_POLICY_INCLUDE_POLICY_SQL_PT_REPRESENTATION_H_
 #define SRC_COMPONENTS_POLICY_INCLUDE_POLICY_SQL_PT_REPRESENTATION_H_
 
+#include <set>
 #include <string>
 #include <vector>
 #include "policy/pt_representation.h"
@@ -80,6 +81,8 @@ class SQLPTRepresentation : public virtual PTRepresentation {
     bool Drop();
     virtual utils::SharedPtr<policy_table::Table> GenerateSnapshot() const;
     bool Save(const policy_table::Table& table);
+    bool SaveDelta(const policy_table::Table& table,
+                   const PolicyTableDelta& delta);
     bool GetInitialAppData(const std::string& app_id, StringArray* nicknames =
                              NULL,
                            StringArray* app_hmi_types = NULL);
@@ -116,6 +119,9 @@ class SQLPTRepresentation : public virtual PTRepresentation {
       const policy_table::ConsumerFriendlyMessages& messages);
     virtual bool SaveApplicationPolicies(
       const policy_table::ApplicationPolicies& apps);
+    virtual bool SaveApplicationPolicy(
+      const policy_table::ApplicationPolicies::value_type& app);
+    virtual bool DeleteApplicationPolicy(const std::string& app_id);
 
     virtual bool SaveMessageString(const std::string& type,
                                    const std::string& lang,
@@ -152,6 +158,20 @@ class SQLPTRepresentation : public virtual PTRepresentation {
       const policy_table::NumberOfNotificationsPerMinute& notifications);
     bool SaveMessageType(const std::string& type);
     bool SaveLanguage(const std::string& code);
+    bool SaveMessage(const std::string& type,
+                     const policy_table::Languages& langs);
+
+    bool SaveFunctionalGroupingsDelta(
+      const policy_table::PolicyTable& policy_data,
+      const PolicyTableDelta& delta);
+    bool SaveGroupLinks(const std::string& group_name,
+                        const policy_table::ApplicationPolicies& apps);
+    bool SaveApplicationPoliciesDelta(
+      const policy_table::ApplicationPolicies& apps,
+      const std::set<std::string>& app_ids);
+    bool SaveConsumerFriendlyMessagesDelta(
+      const policy_table::ConsumerFriendlyMessages& messages,
+      const PolicyTableDelta& delta);
 };
 }  //  namespace policy
 
@@ -4,6 +4,7 @@
 // This file is generated, do not edit
 #include "./types.h"
 #include "rpc_base/rpc_base_json_inl.h"
+#include "rpc_base/rpc_base_json_stream_inl.h"
 
 namespace rpc {
 namespace policy_table_interface_base {
@@ -36,6 +37,42 @@ Json::Value ApplicationParams::ToJsonValue() const {
   impl::WriteJsonField("certificate", certificate, &result__);
   return result__;
 }
+void ApplicationParams::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "groups") {
+      groups.ReadJson(reader__);
+    } else if (name__ == "nicknames") {
+      nicknames.ReadJson(reader__);
+    } else if (name__ == "AppHMIType") {
+      AppHMIType.ReadJson(reader__);
+    } else if (name__ == "memory_kb") {
+      memory_kb.ReadJson(reader__);
+    } else if (name__ == "heart_beat_timeout_ms") {
+      heart_beat_timeout_ms.ReadJson(reader__);
+    } else if (name__ == "certificate") {
+      certificate.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void ApplicationParams::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("AppHMIType", AppHMIType, writer__);
+  impl::WriteJsonField("certificate", certificate, writer__);
+  impl::WriteJsonField("groups", groups, writer__);
+  impl::WriteJsonField("heart_beat_timeout_ms", heart_beat_timeout_ms, writer__);
+  impl::WriteJsonField("memory_kb", memory_kb, writer__);
+  impl::WriteJsonField("nicknames", nicknames, writer__);
+  writer__->EndObject();
+}
 bool ApplicationParams::is_valid() const {
   if (!groups.is_valid()) {
     return false;
@@ -129,6 +166,30 @@ Json::Value RpcParameters::ToJsonValue() const {
   impl::WriteJsonField("parameters", parameters, &result__);
   return result__;
 }
+void RpcParameters::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "hmi_levels") {
+      hmi_levels.ReadJson(reader__);
+    } else if (name__ == "parameters") {
+      parameters.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void RpcParameters::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("hmi_levels", hmi_levels, writer__);
+  impl::WriteJsonField("parameters", parameters, writer__);
+  writer__->EndObject();
+}
 bool RpcParameters::is_valid() const {
   if (!hmi_levels.is_valid()) {
     return false;
@@ -184,6 +245,30 @@ Json::Value Rpcs::ToJsonValue() const {
   impl::WriteJsonField("rpcs", rpcs, &result__);
   return result__;
 }
+void Rpcs::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "user_consent_prompt") {
+      user_consent_prompt.ReadJson(reader__);
+    } else if (name__ == "rpcs") {
+      rpcs.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void Rpcs::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("rpcs", rpcs, writer__);
+  impl::WriteJsonField("user_consent_prompt", user_consent_prompt, writer__);
+  writer__->EndObject();
+}
 bool Rpcs::is_valid() const {
   if (!user_consent_prompt.is_valid()) {
     return false;
@@ -265,6 +350,60 @@ Json::Value ModuleConfig::ToJsonValue() const {
   impl::WriteJsonField("vehicle_year", vehicle_year, &result__);
   return result__;
 }
+void ModuleConfig::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "device_certificates") {
+      device_certificates.ReadJson(reader__);
+    } else if (name__ == "preloaded_pt") {
+      preloaded_pt.ReadJson(reader__);
+    } else if (name__ == "exchange_after_x_ignition_cycles") {
+      exchange_after_x_ignition_cycles.ReadJson(reader__);
+    } else if (name__ == "exchange_after_x_kilometers") {
+      exchange_after_x_kilometers.ReadJson(reader__);
+    } else if (name__ == "exchange_after_x_days") {
+      exchange_after_x_days.ReadJson(reader__);
+    } else if (name__ == "timeout_after_x_seconds") {
+      timeout_after_x_seconds.ReadJson(reader__);
+    } else if (name__ == "seconds_between_retries") {
+      seconds_between_retries.ReadJson(reader__);
+    } else if (name__ == "endpoints") {
+      endpoints.ReadJson(reader__);
+    } else if (name__ == "notifications_per_minute_by_priority") {
+      notifications_per_minute_by_priority.ReadJson(reader__);
+    } else if (name__ == "vehicle_make") {
+      vehicle_make.ReadJson(reader__);
+    } else if (name__ == "vehicle_model") {
+      vehicle_model.ReadJson(reader__);
+    } else if (name__ == "vehicle_year") {
+      vehicle_year.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void ModuleConfig::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("device_certificates", device_certificates, writer__);
+  impl::WriteJsonField("endpoints", endpoints, writer__);
+  impl::WriteJsonField("exchange_after_x_days", exchange_after_x_days, writer__);
+  impl::WriteJsonField("exchange_after_x_ignition_cycles", exchange_after_x_ignition_cycles, writer__);
+  impl::WriteJsonField("exchange_after_x_kilometers", exchange_after_x_kilometers, writer__);
+  impl::WriteJsonField("notifications_per_minute_by_priority", notifications_per_minute_by_priority, writer__);
+  impl::WriteJsonField("preloaded_pt", preloaded_pt, writer__);
+  impl::WriteJsonField("seconds_between_retries", seconds_between_retries, writer__);
+  impl::WriteJsonField("timeout_after_x_seconds", timeout_after_x_seconds, writer__);
+  impl::WriteJsonField("vehicle_make", vehicle_make, writer__);
+  impl::WriteJsonField("vehicle_model", vehicle_model, writer__);
+  impl::WriteJsonField("vehicle_year", vehicle_year, writer__);
+  writer__->EndObject();
+}
 bool ModuleConfig::is_valid() const {
   if (!device_certificates.is_valid()) {
     return false;
@@ -417,6 +556,39 @@ Json::Value MessageString::ToJsonValue() const {
   impl::WriteJsonField("textBody", textBody, &result__);
   return result__;
 }
+void MessageString::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "line1") {
+      line1.ReadJson(reader__);
+    } else if (name__ == "line2") {
+      line2.ReadJson(reader__);
+    } else if (name__ == "tts") {
+      tts.ReadJson(reader__);
+    } else if (name__ == "label") {
+      label.ReadJson(reader__);
+    } else if (name__ == "textBody") {
+      textBody.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void MessageString::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("label", label, writer__);
+  impl::WriteJsonField("line1", line1, writer__);
+  impl::WriteJsonField("line2", line2, writer__);
+  impl::WriteJsonField("textBody", textBody, writer__);
+  impl::WriteJsonField("tts", tts, writer__);
+  writer__->EndObject();
+}
 bool MessageString::is_valid() const {
   if (struct_empty()) {
     return initialization_state__ == kInitialized;
@@ -501,6 +673,27 @@ Json::Value MessageLanguages::ToJsonValue() const {
   impl::WriteJsonField("languages", languages, &result__);
   return result__;
 }
+void MessageLanguages::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "languages") {
+      languages.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void MessageLanguages::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("languages", languages, writer__);
+  writer__->EndObject();
+}
 bool MessageLanguages::is_valid() const {
   if (!languages.is_valid()) {
     return false;
@@ -546,6 +739,30 @@ Json::Value ConsumerFriendlyMessages::ToJsonValue() const {
   impl::WriteJsonField("messages", messages, &result__);
   return result__;
 }
+void ConsumerFriendlyMessages::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "version") {
+      version.ReadJson(reader__);
+    } else if (name__ == "messages") {
+      messages.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void ConsumerFriendlyMessages::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("messages", messages, writer__);
+  impl::WriteJsonField("version", version, writer__);
+  writer__->EndObject();
+}
 bool ConsumerFriendlyMessages::is_valid() const {
   if (!version.is_valid()) {
     return false;
@@ -593,6 +810,22 @@ Json::Value ModuleMeta::ToJsonValue() const {
   Json::Value result__(Json::objectValue);
   return result__;
 }
+void ModuleMeta::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    reader__->SkipValue();
+  }
+}
+void ModuleMeta::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  writer__->EndObject();
+}
 bool ModuleMeta::is_valid() const {
   if (struct_empty()) {
     return initialization_state__ == kInitialized;
@@ -624,6 +857,22 @@ Json::Value AppLevel::ToJsonValue() const {
   Json::Value result__(Json::objectValue);
   return result__;
 }
+void AppLevel::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    reader__->SkipValue();
+  }
+}
+void AppLevel::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  writer__->EndObject();
+}
 bool AppLevel::is_valid() const {
   if (struct_empty()) {
     return initialization_state__ == kInitialized;
@@ -657,6 +906,27 @@ Json::Value UsageAndErrorCounts::ToJsonValue() const {
   impl::WriteJsonField("app_level", app_level, &result__);
   return result__;
 }
+void UsageAndErrorCounts::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "app_level") {
+      app_level.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void UsageAndErrorCounts::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("app_level", app_level, writer__);
+  writer__->EndObject();
+}
 bool UsageAndErrorCounts::is_valid() const {
   if (struct_empty()) {
     return initialization_state__ == kInitialized;
@@ -697,6 +967,22 @@ Json::Value DeviceParams::ToJsonValue() const {
   Json::Value result__(Json::objectValue);
   return result__;
 }
+void DeviceParams::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    reader__->SkipValue();
+  }
+}
+void DeviceParams::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  writer__->EndObject();
+}
 bool DeviceParams::is_valid() const {
   if (struct_empty()) {
     return initialization_state__ == kInitialized;
@@ -749,6 +1035,45 @@ Json::Value PolicyTable::ToJsonValue() const {
   impl::WriteJsonField("device_data", device_data, &result__);
   return result__;
 }
+void PolicyTable::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "app_policies") {
+      app_policies.ReadJson(reader__);
+    } else if (name__ == "functional_groupings") {
+      functional_groupings.ReadJson(reader__);
+    } else if (name__ == "consumer_friendly_messages") {
+      consumer_friendly_messages.ReadJson(reader__);
+    } else if (name__ == "module_config") {
+      module_config.ReadJson(reader__);
+    } else if (name__ == "module_meta") {
+      module_meta.ReadJson(reader__);
+    } else if (name__ == "usage_and_error_counts") {
+      usage_and_error_counts.ReadJson(reader__);
+    } else if (name__ == "device_data") {
+      device_data.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void PolicyTable::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("app_policies", app_policies, writer__);
+  impl::WriteJsonField("consumer_friendly_messages", consumer_friendly_messages, writer__);
+  impl::WriteJsonField("device_data", device_data, writer__);
+  impl::WriteJsonField("functional_groupings", functional_groupings, writer__);
+  impl::WriteJsonField("module_config", module_config, writer__);
+  impl::WriteJsonField("module_meta", module_meta, writer__);
+  impl::WriteJsonField("usage_and_error_counts", usage_and_error_counts, writer__);
+  writer__->EndObject();
+}
 bool PolicyTable::is_valid() const {
   if (!app_policies.is_valid()) {
     return false;
@@ -849,6 +1174,27 @@ Json::Value Table::ToJsonValue() const {
   impl::WriteJsonField("policy_table", policy_table, &result__);
   return result__;
 }
+void Table::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "policy_table") {
+      policy_table.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void Table::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("policy_table", policy_table, writer__);
+  writer__->EndObject();
+}
 bool Table::is_valid() const {
   if (!policy_table.is_valid()) {
     return false;
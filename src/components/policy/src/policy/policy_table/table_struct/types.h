@@ -69,6 +69,8 @@ struct ApplicationParams : CompositeType {
     ~ApplicationParams();
     explicit ApplicationParams(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -87,6 +89,8 @@ struct RpcParameters : CompositeType {
     ~RpcParameters();
     explicit RpcParameters(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -105,6 +109,8 @@ struct Rpcs : CompositeType {
     ~Rpcs();
     explicit Rpcs(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -133,6 +139,8 @@ struct ModuleConfig : CompositeType {
     ~ModuleConfig();
     explicit ModuleConfig(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -153,6 +161,8 @@ struct MessageString : CompositeType {
     ~MessageString();
     explicit MessageString(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -170,6 +180,8 @@ struct MessageLanguages : CompositeType {
     ~MessageLanguages();
     explicit MessageLanguages(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -188,6 +200,8 @@ struct ConsumerFriendlyMessages : CompositeType {
     ~ConsumerFriendlyMessages();
     explicit ConsumerFriendlyMessages(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -203,6 +217,8 @@ struct ModuleMeta : CompositeType {
     ~ModuleMeta();
     explicit ModuleMeta(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -218,6 +234,8 @@ struct AppLevel : CompositeType {
     ~AppLevel();
     explicit AppLevel(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -234,6 +252,8 @@ struct UsageAndErrorCounts : CompositeType {
     ~UsageAndErrorCounts();
     explicit UsageAndErrorCounts(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -249,6 +269,8 @@ struct DeviceParams : CompositeType {
     ~DeviceParams();
     explicit DeviceParams(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -272,6 +294,8 @@ struct PolicyTable : CompositeType {
     ~PolicyTable();
     explicit PolicyTable(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -289,6 +313,8 @@ struct Table : CompositeType {
     ~Table();
     explicit Table(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -1,6 +1,7 @@
 // This file is generated, do not edit
 #include "./types.h"
 #include "rpc_base/rpc_base_json_inl.h"
+#include "rpc_base/rpc_base_json_stream_inl.h"
 
 namespace rpc {
 namespace policy_table_interface_base {
@@ -47,6 +48,57 @@ Json::Value ApplicationParams::ToJsonValue() const {
   impl::WriteJsonField("certificate", certificate, &result__);
   return result__;
 }
+void ApplicationParams::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "groups") {
+      groups.ReadJson(reader__);
+    } else if (name__ == "nicknames") {
+      nicknames.ReadJson(reader__);
+    } else if (name__ == "preconsented_groups") {
+      preconsented_groups.ReadJson(reader__);
+    } else if (name__ == "AppHMIType") {
+      AppHMIType.ReadJson(reader__);
+    } else if (name__ == "priority") {
+      priority.ReadJson(reader__);
+    } else if (name__ == "default_hmi") {
+      default_hmi.ReadJson(reader__);
+    } else if (name__ == "keep_context") {
+      keep_context.ReadJson(reader__);
+    } else if (name__ == "steal_focus") {
+      steal_focus.ReadJson(reader__);
+    } else if (name__ == "memory_kb") {
+      memory_kb.ReadJson(reader__);
+    } else if (name__ == "heart_beat_timeout_ms") {
+      heart_beat_timeout_ms.ReadJson(reader__);
+    } else if (name__ == "certificate") {
+      certificate.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void ApplicationParams::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("AppHMIType", AppHMIType, writer__);
+  impl::WriteJsonField("certificate", certificate, writer__);
+  impl::WriteJsonField("default_hmi", default_hmi, writer__);
+  impl::WriteJsonField("groups", groups, writer__);
+  impl::WriteJsonField("heart_beat_timeout_ms", heart_beat_timeout_ms, writer__);
+  impl::WriteJsonField("keep_context", keep_context, writer__);
+  impl::WriteJsonField("memory_kb", memory_kb, writer__);
+  impl::WriteJsonField("nicknames", nicknames, writer__);
+  impl::WriteJsonField("preconsented_groups", preconsented_groups, writer__);
+  impl::WriteJsonField("priority", priority, writer__);
+  impl::WriteJsonField("steal_focus", steal_focus, writer__);
+  writer__->EndObject();
+}
 bool ApplicationParams::is_valid() const {
   if (!groups.is_valid()) {
     return false;
@@ -187,6 +239,30 @@ Json::Value RpcParameters::ToJsonValue() const {
   impl::WriteJsonField("parameters", parameters, &result__);
   return result__;
 }
+void RpcParameters::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "hmi_levels") {
+      hmi_levels.ReadJson(reader__);
+    } else if (name__ == "parameters") {
+      parameters.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void RpcParameters::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("hmi_levels", hmi_levels, writer__);
+  impl::WriteJsonField("parameters", parameters, writer__);
+  writer__->EndObject();
+}
 bool RpcParameters::is_valid() const {
   if (!hmi_levels.is_valid()) {
     return false;
@@ -242,6 +318,30 @@ Json::Value Rpcs::ToJsonValue() const {
   impl::WriteJsonField("rpcs", rpcs, &result__);
   return result__;
 }
+void Rpcs::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "user_consent_prompt") {
+      user_consent_prompt.ReadJson(reader__);
+    } else if (name__ == "rpcs") {
+      rpcs.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void Rpcs::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("rpcs", rpcs, writer__);
+  impl::WriteJsonField("user_consent_prompt", user_consent_prompt, writer__);
+  writer__->EndObject();
+}
 bool Rpcs::is_valid() const {
   if (!user_consent_prompt.is_valid()) {
     return false;
@@ -323,6 +423,60 @@ Json::Value ModuleConfig::ToJsonValue() const {
   impl::WriteJsonField("vehicle_year", vehicle_year, &result__);
   return result__;
 }
+void ModuleConfig::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "device_certificates") {
+      device_certificates.ReadJson(reader__);
+    } else if (name__ == "preloaded_pt") {
+      preloaded_pt.ReadJson(reader__);
+    } else if (name__ == "exchange_after_x_ignition_cycles") {
+      exchange_after_x_ignition_cycles.ReadJson(reader__);
+    } else if (name__ == "exchange_after_x_kilometers") {
+      exchange_after_x_kilometers.ReadJson(reader__);
+    } else if (name__ == "exchange_after_x_days") {
+      exchange_after_x_days.ReadJson(reader__);
+    } else if (name__ == "timeout_after_x_seconds") {
+      timeout_after_x_seconds.ReadJson(reader__);
+    } else if (name__ == "seconds_between_retries") {
+      seconds_between_retries.ReadJson(reader__);
+    } else if (name__ == "endpoints") {
+      endpoints.ReadJson(reader__);
+    } else if (name__ == "notifications_per_minute_by_priority") {
+      notifications_per_minute_by_priority.ReadJson(reader__);
+    } else if (name__ == "vehicle_make") {
+      vehicle_make.ReadJson(reader__);
+    } else if (name__ == "vehicle_model") {
+      vehicle_model.ReadJson(reader__);
+    } else if (name__ == "vehicle_year") {
+      vehicle_year.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void ModuleConfig::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("device_certificates", device_certificates, writer__);
+  impl::WriteJsonField("endpoints", endpoints, writer__);
+  impl::WriteJsonField("exchange_after_x_days", exchange_after_x_days, writer__);
+  impl::WriteJsonField("exchange_after_x_ignition_cycles", exchange_after_x_ignition_cycles, writer__);
+  impl::WriteJsonField("exchange_after_x_kilometers", exchange_after_x_kilometers, writer__);
+  impl::WriteJsonField("notifications_per_minute_by_priority", notifications_per_minute_by_priority, writer__);
+  impl::WriteJsonField("preloaded_pt", preloaded_pt, writer__);
+  impl::WriteJsonField("seconds_between_retries", seconds_between_retries, writer__);
+  impl::WriteJsonField("timeout_after_x_seconds", timeout_after_x_seconds, writer__);
+  impl::WriteJsonField("vehicle_make", vehicle_make, writer__);
+  impl::WriteJsonField("vehicle_model", vehicle_model, writer__);
+  impl::WriteJsonField("vehicle_year", vehicle_year, writer__);
+  writer__->EndObject();
+}
 bool ModuleConfig::is_valid() const {
   if (!device_certificates.is_valid()) {
     return false;
@@ -475,6 +629,39 @@ Json::Value MessageString::ToJsonValue() const {
   impl::WriteJsonField("textBody", textBody, &result__);
   return result__;
 }
+void MessageString::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "line1") {
+      line1.ReadJson(reader__);
+    } else if (name__ == "line2") {
+      line2.ReadJson(reader__);
+    } else if (name__ == "tts") {
+      tts.ReadJson(reader__);
+    } else if (name__ == "label") {
+      label.ReadJson(reader__);
+    } else if (name__ == "textBody") {
+      textBody.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void MessageString::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("label", label, writer__);
+  impl::WriteJsonField("line1", line1, writer__);
+  impl::WriteJsonField("line2", line2, writer__);
+  impl::WriteJsonField("textBody", textBody, writer__);
+  impl::WriteJsonField("tts", tts, writer__);
+  writer__->EndObject();
+}
 bool MessageString::is_valid() const {
   if (struct_empty()) {
     return initialization_state__ == kInitialized;
@@ -559,6 +746,27 @@ Json::Value MessageLanguages::ToJsonValue() const {
   impl::WriteJsonField("languages", languages, &result__);
   return result__;
 }
+void MessageLanguages::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "languages") {
+      languages.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void MessageLanguages::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("languages", languages, writer__);
+  writer__->EndObject();
+}
 bool MessageLanguages::is_valid() const {
   if (!languages.is_valid()) {
     return false;
@@ -604,6 +812,30 @@ Json::Value ConsumerFriendlyMessages::ToJsonValue() const {
   impl::WriteJsonField("messages", messages, &result__);
   return result__;
 }
+void ConsumerFriendlyMessages::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "version") {
+      version.ReadJson(reader__);
+    } else if (name__ == "messages") {
+      messages.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void ConsumerFriendlyMessages::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("messages", messages, writer__);
+  impl::WriteJsonField("version", version, writer__);
+  writer__->EndObject();
+}
 bool ConsumerFriendlyMessages::is_valid() const {
   if (!version.is_valid()) {
     return false;
@@ -665,6 +897,45 @@ Json::Value ModuleMeta::ToJsonValue() const {
   impl::WriteJsonField("vin", vin, &result__);
   return result__;
 }
+void ModuleMeta::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "ccpu_version") {
+      ccpu_version.ReadJson(reader__);
+    } else if (name__ == "language") {
+      language.ReadJson(reader__);
+    } else if (name__ == "wers_country_code") {
+      wers_country_code.ReadJson(reader__);
+    } else if (name__ == "pt_exchanged_at_odometer_x") {
+      pt_exchanged_at_odometer_x.ReadJson(reader__);
+    } else if (name__ == "pt_exchanged_x_days_after_epoch") {
+      pt_exchanged_x_days_after_epoch.ReadJson(reader__);
+    } else if (name__ == "ignition_cycles_since_last_exchange") {
+      ignition_cycles_since_last_exchange.ReadJson(reader__);
+    } else if (name__ == "vin") {
+      vin.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void ModuleMeta::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("ccpu_version", ccpu_version, writer__);
+  impl::WriteJsonField("ignition_cycles_since_last_exchange", ignition_cycles_since_last_exchange, writer__);
+  impl::WriteJsonField("language", language, writer__);
+  impl::WriteJsonField("pt_exchanged_at_odometer_x", pt_exchanged_at_odometer_x, writer__);
+  impl::WriteJsonField("pt_exchanged_x_days_after_epoch", pt_exchanged_x_days_after_epoch, writer__);
+  impl::WriteJsonField("vin", vin, writer__);
+  impl::WriteJsonField("wers_country_code", wers_country_code, writer__);
+  writer__->EndObject();
+}
 bool ModuleMeta::is_valid() const {
   if (struct_empty()) {
     return initialization_state__ == kInitialized;
@@ -810,6 +1081,69 @@ Json::Value AppLevel::ToJsonValue() const {
   impl::WriteJsonField("count_of_run_attempts_while_revoked", count_of_run_attempts_while_revoked, &result__);
   return result__;
 }
+void AppLevel::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "minutes_in_hmi_full") {
+      minutes_in_hmi_full.ReadJson(reader__);
+    } else if (name__ == "app_registration_language_gui") {
+      app_registration_language_gui.ReadJson(reader__);
+    } else if (name__ == "app_registration_language_vui") {
+      app_registration_language_vui.ReadJson(reader__);
+    } else if (name__ == "count_of_rfcom_limit_reached") {
+      count_of_rfcom_limit_reached.ReadJson(reader__);
+    } else if (name__ == "minutes_in_hmi_limited") {
+      minutes_in_hmi_limited.ReadJson(reader__);
+    } else if (name__ == "minutes_in_hmi_background") {
+      minutes_in_hmi_background.ReadJson(reader__);
+    } else if (name__ == "minutes_in_hmi_none") {
+      minutes_in_hmi_none.ReadJson(reader__);
+    } else if (name__ == "count_of_user_selections") {
+      count_of_user_selections.ReadJson(reader__);
+    } else if (name__ == "count_of_rejections_sync_out_of_memory") {
+      count_of_rejections_sync_out_of_memory.ReadJson(reader__);
+    } else if (name__ == "count_of_rejections_nickname_mismatch") {
+      count_of_rejections_nickname_mismatch.ReadJson(reader__);
+    } else if (name__ == "count_of_rejections_duplicate_name") {
+      count_of_rejections_duplicate_name.ReadJson(reader__);
+    } else if (name__ == "count_of_rejected_rpc_calls") {
+      count_of_rejected_rpc_calls.ReadJson(reader__);
+    } else if (name__ == "count_of_rpcs_sent_in_hmi_none") {
+      count_of_rpcs_sent_in_hmi_none.ReadJson(reader__);
+    } else if (name__ == "count_of_removals_for_bad_behavior") {
+      count_of_removals_for_bad_behavior.ReadJson(reader__);
+    } else if (name__ == "count_of_run_attempts_while_revoked") {
+      count_of_run_attempts_while_revoked.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void AppLevel::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("app_registration_language_gui", app_registration_language_gui, writer__);
+  impl::WriteJsonField("app_registration_language_vui", app_registration_language_vui, writer__);
+  impl::WriteJsonField("count_of_rejected_rpc_calls", count_of_rejected_rpc_calls, writer__);
+  impl::WriteJsonField("count_of_rejections_duplicate_name", count_of_rejections_duplicate_name, writer__);
+  impl::WriteJsonField("count_of_rejections_nickname_mismatch", count_of_rejections_nickname_mismatch, writer__);
+  impl::WriteJsonField("count_of_rejections_sync_out_of_memory", count_of_rejections_sync_out_of_memory, writer__);
+  impl::WriteJsonField("count_of_removals_for_bad_behavior", count_of_removals_for_bad_behavior, writer__);
+  impl::WriteJsonField("count_of_rfcom_limit_reached", count_of_rfcom_limit_reached, writer__);
+  impl::WriteJsonField("count_of_rpcs_sent_in_hmi_none", count_of_rpcs_sent_in_hmi_none, writer__);
+  impl::WriteJsonField("count_of_run_attempts_while_revoked", count_of_run_attempts_while_revoked, writer__);
+  impl::WriteJsonField("count_of_user_selections", count_of_user_selections, writer__);
+  impl::WriteJsonField("minutes_in_hmi_background", minutes_in_hmi_background, writer__);
+  impl::WriteJsonField("minutes_in_hmi_full", minutes_in_hmi_full, writer__);
+  impl::WriteJsonField("minutes_in_hmi_limited", minutes_in_hmi_limited, writer__);
+  impl::WriteJsonField("minutes_in_hmi_none", minutes_in_hmi_none, writer__);
+  writer__->EndObject();
+}
 bool AppLevel::is_valid() const {
   if (!minutes_in_hmi_full.is_valid()) {
     return false;
@@ -988,6 +1322,36 @@ Json::Value UsageAndErrorCounts::ToJsonValue() const {
   impl::WriteJsonField("app_level", app_level, &result__);
   return result__;
 }
+void UsageAndErrorCounts::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "count_of_iap_buffer_full") {
+      count_of_iap_buffer_full.ReadJson(reader__);
+    } else if (name__ == "count_sync_out_of_memory") {
+      count_sync_out_of_memory.ReadJson(reader__);
+    } else if (name__ == "count_of_sync_reboots") {
+      count_of_sync_reboots.ReadJson(reader__);
+    } else if (name__ == "app_level") {
+      app_level.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void UsageAndErrorCounts::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("app_level", app_level, writer__);
+  impl::WriteJsonField("count_of_iap_buffer_full", count_of_iap_buffer_full, writer__);
+  impl::WriteJsonField("count_of_sync_reboots", count_of_sync_reboots, writer__);
+  impl::WriteJsonField("count_sync_out_of_memory", count_sync_out_of_memory, writer__);
+  writer__->EndObject();
+}
 bool UsageAndErrorCounts::is_valid() const {
   if (struct_empty()) {
     return initialization_state__ == kInitialized;
@@ -1063,6 +1427,33 @@ Json::Value ConsentRecords::ToJsonValue() const {
   impl::WriteJsonField("time_stamp", time_stamp, &result__);
   return result__;
 }
+void ConsentRecords::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "consent_groups") {
+      consent_groups.ReadJson(reader__);
+    } else if (name__ == "input") {
+      input.ReadJson(reader__);
+    } else if (name__ == "time_stamp") {
+      time_stamp.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void ConsentRecords::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("consent_groups", consent_groups, writer__);
+  impl::WriteJsonField("input", input, writer__);
+  impl::WriteJsonField("time_stamp", time_stamp, writer__);
+  writer__->EndObject();
+}
 bool ConsentRecords::is_valid() const {
   if (struct_empty()) {
     return initialization_state__ == kInitialized;
@@ -1136,6 +1527,45 @@ Json::Value DeviceParams::ToJsonValue() const {
   impl::WriteJsonField("max_number_rfcom_ports", max_number_rfcom_ports, &result__);
   return result__;
 }
+void DeviceParams::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "hardware") {
+      hardware.ReadJson(reader__);
+    } else if (name__ == "firmware_rev") {
+      firmware_rev.ReadJson(reader__);
+    } else if (name__ == "os") {
+      os.ReadJson(reader__);
+    } else if (name__ == "os_version") {
+      os_version.ReadJson(reader__);
+    } else if (name__ == "carrier") {
+      carrier.ReadJson(reader__);
+    } else if (name__ == "user_consent_records") {
+      user_consent_records.ReadJson(reader__);
+    } else if (name__ == "max_number_rfcom_ports") {
+      max_number_rfcom_ports.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void DeviceParams::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("carrier", carrier, writer__);
+  impl::WriteJsonField("firmware_rev", firmware_rev, writer__);
+  impl::WriteJsonField("hardware", hardware, writer__);
+  impl::WriteJsonField("max_number_rfcom_ports", max_number_rfcom_ports, writer__);
+  impl::WriteJsonField("os", os, writer__);
+  impl::WriteJsonField("os_version", os_version, writer__);
+  impl::WriteJsonField("user_consent_records", user_consent_records, writer__);
+  writer__->EndObject();
+}
 bool DeviceParams::is_valid() const {
   if (struct_empty()) {
     return initialization_state__ == kInitialized;
@@ -1254,6 +1684,45 @@ Json::Value PolicyTable::ToJsonValue() const {
   impl::WriteJsonField("device_data", device_data, &result__);
   return result__;
 }
+void PolicyTable::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "app_policies") {
+      app_policies.ReadJson(reader__);
+    } else if (name__ == "functional_groupings") {
+      functional_groupings.ReadJson(reader__);
+    } else if (name__ == "consumer_friendly_messages") {
+      consumer_friendly_messages.ReadJson(reader__);
+    } else if (name__ == "module_config") {
+      module_config.ReadJson(reader__);
+    } else if (name__ == "module_meta") {
+      module_meta.ReadJson(reader__);
+    } else if (name__ == "usage_and_error_counts") {
+      usage_and_error_counts.ReadJson(reader__);
+    } else if (name__ == "device_data") {
+      device_data.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void PolicyTable::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("app_policies", app_policies, writer__);
+  impl::WriteJsonField("consumer_friendly_messages", consumer_friendly_messages, writer__);
+  impl::WriteJsonField("device_data", device_data, writer__);
+  impl::WriteJsonField("functional_groupings", functional_groupings, writer__);
+  impl::WriteJsonField("module_config", module_config, writer__);
+  impl::WriteJsonField("module_meta", module_meta, writer__);
+  impl::WriteJsonField("usage_and_error_counts", usage_and_error_counts, writer__);
+  writer__->EndObject();
+}
 bool PolicyTable::is_valid() const {
   if (!app_policies.is_valid()) {
     return false;
@@ -1354,6 +1823,27 @@ Json::Value Table::ToJsonValue() const {
   impl::WriteJsonField("policy_table", policy_table, &result__);
   return result__;
 }
+void Table::ReadJson(rpc::JsonReader* reader__) {
+  if (!reader__->NextIsObject()) {
+    reader__->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+    return;
+  }
+  initialization_state__ = kInitialized;
+  std::string name__;
+  for (reader__->EnterObject(); reader__->NextMember(&name__);) {
+    if (name__ == "policy_table") {
+      policy_table.ReadJson(reader__);
+    } else {
+      reader__->SkipValue();
+    }
+  }
+}
+void Table::WriteJson(rpc::JsonWriter* writer__) const {
+  writer__->BeginObject();
+  impl::WriteJsonField("policy_table", policy_table, writer__);
+  writer__->EndObject();
+}
 bool Table::is_valid() const {
   if (!policy_table.is_valid()) {
     return false;
@@ -79,6 +79,8 @@ struct ApplicationParams : CompositeType {
     ~ApplicationParams();
     explicit ApplicationParams(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -97,6 +99,8 @@ struct RpcParameters : CompositeType {
     ~RpcParameters();
     explicit RpcParameters(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -115,6 +119,8 @@ struct Rpcs : CompositeType {
     ~Rpcs();
     explicit Rpcs(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -143,6 +149,8 @@ struct ModuleConfig : CompositeType {
     ~ModuleConfig();
     explicit ModuleConfig(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -163,6 +171,8 @@ struct MessageString : CompositeType {
     ~MessageString();
     explicit MessageString(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -180,6 +190,8 @@ struct MessageLanguages : CompositeType {
     ~MessageLanguages();
     explicit MessageLanguages(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -198,6 +210,8 @@ struct ConsumerFriendlyMessages : CompositeType {
     ~ConsumerFriendlyMessages();
     explicit ConsumerFriendlyMessages(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -220,6 +234,8 @@ struct ModuleMeta : CompositeType {
     ~ModuleMeta();
     explicit ModuleMeta(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -251,6 +267,8 @@ struct AppLevel : CompositeType {
     ~AppLevel();
     explicit AppLevel(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -270,6 +288,8 @@ struct UsageAndErrorCounts : CompositeType {
     ~UsageAndErrorCounts();
     explicit UsageAndErrorCounts(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -288,6 +308,8 @@ struct ConsentRecords : CompositeType {
     ~ConsentRecords();
     explicit ConsentRecords(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -310,6 +332,8 @@ struct DeviceParams : CompositeType {
     ~DeviceParams();
     explicit DeviceParams(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -333,6 +357,8 @@ struct PolicyTable : CompositeType {
     ~PolicyTable();
     explicit PolicyTable(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -350,6 +376,8 @@ struct Table : CompositeType {
     ~Table();
     explicit Table(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void ReadJson(rpc::JsonReader* reader__);
+    void WriteJson(rpc::JsonWriter* writer__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
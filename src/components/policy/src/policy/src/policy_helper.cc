@@ -36,6 +36,7 @@
 #include <sstream>
 #include <string.h>
 #include "utils/logger.h"
+#include "rpc_base/json_stream.h"
 #include "policy/policy_helper.h"
 #include "policy/policy_manager_impl.h"
 
@@ -66,6 +67,41 @@ bool Compare(const StringsValueType& first, const StringsValueType& second) {
 #endif
 }
 
+template <typename T>
+std::string SerializeJson(const T& value) {
+  std::string result;
+  rpc::JsonWriter writer(&result);
+  value.WriteJson(&writer);
+  return result;
+}
+
+/*
+ * @brief Collects keys of entries, which are new in update or differ from
+ * current ones. Generated types have no comparison, so entries are compared
+ * by their json representation
+ */
+template <typename Entries>
+void CollectEntriesDelta(const Entries& current, const Entries& update,
+                         std::set<std::string>* updated,
+                         std::set<std::string>* removed) {
+  typename Entries::const_iterator it = update.begin();
+  for (; update.end() != it; ++it) {
+    typename Entries::const_iterator current_it = current.find(it->first);
+    if (current.end() == current_it ||
+        SerializeJson(current_it->second) != SerializeJson(it->second)) {
+      updated->insert(it->first);
+    }
+  }
+  if (!removed) {
+    return;
+  }
+  for (it = current.begin(); current.end() != it; ++it) {
+    if (update.end() == update.find(it->first)) {
+      removed->insert(it->first);
+    }
+  }
+}
+
 }
 
 CompareGroupName::CompareGroupName(const StringsValueType& group_name)
@@ -520,4 +556,33 @@ void FillFunctionalGroupPermissions(FunctionalGroupIDs& ids,
   }
 }
 
+void CollectTableDelta(const policy_table::Table& current,
+                       const policy_table::Table& update,
+                       PolicyTableDelta* delta) {
+  const policy_table::PolicyTable& current_pt = current.policy_table;
+  const policy_table::PolicyTable& update_pt = update.policy_table;
+
+  CollectEntriesDelta(current_pt.functional_groupings,
+                      update_pt.functional_groupings,
+                      &delta->updated_groups, &delta->removed_groups);
+  CollectEntriesDelta(current_pt.app_policies, update_pt.app_policies,
+                      &delta->updated_apps, NULL);
+
+  if (update_pt.consumer_friendly_messages.is_initialized()) {
+    CollectEntriesDelta(*current_pt.consumer_friendly_messages->messages,
+                        *update_pt.consumer_friendly_messages->messages,
+                        &delta->updated_messages, &delta->removed_messages);
+  }
+
+  delta->module_config_updated = SerializeJson(current_pt.module_config) !=
+                                 SerializeJson(update_pt.module_config);
+
+  LOG4CXX_INFO(logger_, "Policy table update changes "
+               << delta->updated_groups.size() << " groups, removes "
+               << delta->removed_groups.size() << " groups, changes "
+               << delta->updated_apps.size() << " applications and "
+               << delta->updated_messages.size() + delta->removed_messages.size()
+               << " messages");
+}
+
 }
@@ -35,14 +35,16 @@
 #include <algorithm>
 #include <set>
 #include <iterator>
-#include "json/reader.h"
-#include "json/writer.h"
+#include "rpc_base/json_stream.h"
 #include "policy/policy_table.h"
 #include "policy/pt_representation.h"
 #include "policy/policy_manager_impl.h"
 #include "policy/policy_helper.h"
 #include "utils/file_system.h"
 #include "utils/logger.h"
+#ifndef __QNX__
+#  include "config_profile/profile.h"
+#endif  // __QNX__
 
 __declspec(dllexport) policy::PolicyManager* CreateManager() {
   return new policy::PolicyManagerImpl();
@@ -52,6 +54,76 @@ namespace {
 void CheckPreloadedGroups(policy_table::ApplicationParams& app_param) {
 
 }
+
+// Snapshot image is kept in the same folder as policy database
+std::string SnapshotImagePath() {
+  std::string path;
+#ifndef __QNX__
+  path = profile::Profile::instance()->app_storage_folder();
+  if (!path.empty()) {
+    path += "/";
+  }
+#endif  // __QNX__
+  return path + "policy.snapshot";
+}
+
+// Seconds between checks for policy image to be rebuilt or saved
+const uint32_t kPolicyImageUpdatePeriod = 5;
+
+policy::CheckPermissionResult CheckImagePermissions(const policy_table::Table& table,
+    const std::string& app_id, const std::string& hmi_level,
+    const std::string& rpc) {
+  policy::CheckPermissionResult result;
+  const policy_table::ApplicationPolicies& apps =
+    table.policy_table.app_policies;
+  policy_table::ApplicationPolicies::const_iterator app = apps.find(app_id);
+  if (apps.end() == app || app->second.is_null()) {
+    return result;
+  }
+
+  const policy_table::FunctionalGroupings& groupings =
+    table.policy_table.functional_groupings;
+  std::set<std::string> parameters;
+  const policy_table::Strings& groups = app->second.groups;
+  policy_table::Strings::const_iterator it = groups.begin();
+  for (; groups.end() != it; ++it) {
+    policy_table::FunctionalGroupings::const_iterator grouping =
+      groupings.find(*it);
+    if (groupings.end() == grouping) {
+      continue;
+    }
+    const policy_table::Rpc& rpcs = grouping->second.rpcs;
+    policy_table::Rpc::const_iterator rpc_it = rpcs.find(rpc);
+    if (rpcs.end() == rpc_it) {
+      continue;
+    }
+    const policy_table::HmiLevels& levels = rpc_it->second.hmi_levels;
+    policy_table::HmiLevels::const_iterator level = levels.begin();
+    for (; levels.end() != level; ++level) {
+      if (hmi_level == policy_table::EnumToJsonString(*level)) {
+        break;
+      }
+    }
+    if (levels.end() == level) {
+      continue;
+    }
+    result.hmi_level_permitted = policy::kRpcAllowed;
+    if (rpc_it->second.parameters.is_initialized()) {
+      const policy_table::Parameters& rpc_parameters =
+        *rpc_it->second.parameters;
+      policy_table::Parameters::const_iterator parameter =
+        rpc_parameters.begin();
+      for (; rpc_parameters.end() != parameter; ++parameter) {
+        parameters.insert(policy_table::EnumToJsonString(*parameter));
+      }
+    }
+  }
+  if (!parameters.empty()) {
+    result.list_of_allowed_params =
+      new std::vector<policy::PTString>(parameters.begin(), parameters.end());
+  }
+  return result;
+}
 }
 
 namespace policy {
@@ -75,11 +147,17 @@ bool check_gcov = CheckGcov();
 PolicyManagerImpl::PolicyManagerImpl()
   : PolicyManager(),
     listener_(NULL),
+    snapshot_cache_(SnapshotImagePath()),
     exchange_in_progress_(false),
     update_required_(policy_table_.pt_data()->UpdateRequired()),
     exchange_pending_(false),
     retry_sequence_index_(0),
-    last_update_status_(policy::StatusUnknown) {
+    last_update_status_(policy::StatusUnknown),
+    image_changes_(0),
+    image_changes_in_progress_(0),
+    image_rebuild_required_(false),
+    image_save_required_(false),
+    image_timer_(this, &PolicyManagerImpl::UpdatePolicyImage, true) {
   RefreshRetrySequence();
 }
 
@@ -99,6 +177,11 @@ void PolicyManagerImpl::set_listener(PolicyListener* listener) {
 
 PolicyManagerImpl::~PolicyManagerImpl() {
   LOG4CXX_INFO(logger_, "Destroying policy manager.");
+  image_timer_.stop();
+  // Image changed by registrations is not lost, rebuild waits for next start
+  if (image_save_required_ && !image_rebuild_required_) {
+    UpdatePolicyImage();
+  }
   policy_table_.pt_data()->SaveUpdateRequired(update_required_);
 }
 
@@ -119,7 +202,9 @@ bool PolicyManagerImpl::LoadPTFromFile(const std::string& file_name) {
     utils::SharedPtr<policy_table::Table> table = new policy_table::Table();
     return false;
   }
+  BeginPolicyImageChange(true);
   final_result = final_result && policy_table_.pt_data()->Save(*table);
+  EndPolicyImageChange();
   LOG4CXX_INFO(
     logger_,
     "Loading from file was " << (final_result ? "successful" : "unsuccessful"));
@@ -140,14 +225,18 @@ bool PolicyManagerImpl::LoadPTFromFile(const std::string& file_name) {
 
 utils::SharedPtr<policy_table::Table> PolicyManagerImpl::Parse(
   const BinaryMessage& pt_content) {
-  std::string json(pt_content.begin(), pt_content.end());
-  Json::Value value;
-  Json::Reader reader;
-  if (reader.parse(json.c_str(), value)) {
-    return new policy_table::Table(&value);
-  } else {
+  if (pt_content.empty()) {
     return utils::SharedPtr<policy_table::Table>();
   }
+  // Table is filled straight from the buffer, no Json::Value tree is built
+  const char* begin = reinterpret_cast<const char*>(&pt_content[0]);
+  rpc::JsonReader reader(begin, begin + pt_content.size());
+  utils::SharedPtr<policy_table::Table> table = new policy_table::Table();
+  table->ReadJson(&reader);
+  if (reader.has_failed()) {
+    return utils::SharedPtr<policy_table::Table>();
+  }
+  return table;
 }
 
 bool PolicyManagerImpl::LoadPT(const std::string& file,
@@ -175,8 +264,12 @@ bool PolicyManagerImpl::LoadPT(const std::string& file,
     return false;
   }
 
+  // Only entries changed by update are checked and stored
+  PolicyTableDelta delta;
+  CollectTableDelta(*policy_table_snapshot_, *pt_update, &delta);
+
   // Check and update permissions for applications, send notifications
-  CheckPermissionsChanges(pt_update);
+  CheckPermissionsChanges(pt_update, delta);
 
   // Replace current data with updated
   policy_table_snapshot_->policy_table.functional_groupings = pt_update
@@ -196,7 +289,11 @@ bool PolicyManagerImpl::LoadPT(const std::string& file,
   //policy_table.module_meta
 
   // Save data to DB
-  if (!policy_table_.pt_data()->Save(*policy_table_snapshot_)) {
+  BeginPolicyImageChange(true);
+  const bool is_saved =
+    policy_table_.pt_data()->SaveDelta(*policy_table_snapshot_, delta);
+  EndPolicyImageChange();
+  if (!is_saved) {
     LOG4CXX_WARN(logger_, "Unsuccessful save of updated policy table.");
     return false;
   }
@@ -219,12 +316,20 @@ bool PolicyManagerImpl::LoadPT(const std::string& file,
 }
 
 void PolicyManagerImpl::CheckPermissionsChanges(
-  const utils::SharedPtr<policy_table::Table> pt_update) {
+  const utils::SharedPtr<policy_table::Table> pt_update,
+  const PolicyTableDelta& delta) {
   LOG4CXX_INFO(logger_, "Checking incoming permissions.");
 
-  std::for_each(pt_update->policy_table.app_policies.begin(),
-                pt_update->policy_table.app_policies.end(),
-                CheckAppPolicy(this, pt_update));
+  const policy_table::ApplicationPolicies& app_policies =
+    pt_update->policy_table.app_policies;
+  CheckAppPolicy check_app_policy(this, pt_update);
+  std::set<std::string>::const_iterator it = delta.updated_apps.begin();
+  for (; delta.updated_apps.end() != it; ++it) {
+    AppPoliciesConstItr app_policy = app_policies.find(*it);
+    if (app_policies.end() != app_policy) {
+      check_app_policy(*app_policy);
+    }
+  }
 }
 
 void PolicyManagerImpl::PrepareNotificationData(
@@ -351,9 +456,9 @@ BinaryMessageSptr PolicyManagerImpl::RequestPTUpdate() {
   }
 #endif  // EXTENDED_POLICY
 
-  Json::Value value = policy_table_snapshot_->ToJsonValue();
-  Json::FastWriter writer;
-  std::string message_string = writer.write(value);
+  std::string message_string;
+  rpc::JsonWriter writer(&message_string);
+  policy_table_snapshot_->WriteJson(&writer);
   return new BinaryMessage(message_string.begin(), message_string.end());
 }
 
@@ -372,7 +477,7 @@ CheckPermissionResult PolicyManagerImpl::CheckPermissions(
 
   // Fill struct with known groups RPCs
   policy_table::FunctionalGroupings functional_groupings;
-  policy_table_.pt_data()->GetFunctionalGroupings(functional_groupings);
+  GetFunctionalGroupings(functional_groupings);
 
   policy_table::Strings app_groups;
   std::vector<FunctionalGroupPermission>::const_iterator it =
@@ -416,7 +521,11 @@ CheckPermissionResult PolicyManagerImpl::CheckPermissions(
 
   return result;
 #else
-  return policy_table_.pt_data()->CheckPermissions(app_id, hmi_level, rpc);
+  const utils::SharedPtr<PolicyImage> image = policy_image();
+  if (!image) {
+    return policy_table_.pt_data()->CheckPermissions(app_id, hmi_level, rpc);
+  }
+  return CheckImagePermissions(image->table, app_id, hmi_level, rpc);
 #endif
 }
 
@@ -438,10 +547,11 @@ void PolicyManagerImpl::CheckAppPolicyState(const std::string& application_id) {
   LOG4CXX_INFO(logger_, "CheckAppPolicyState");
   const std::string device_id = GetCurrentDeviceId(application_id);
   DeviceConsent device_consent  = GetUserConsentForDevice(device_id);
-  if (!policy_table_.pt_data()->IsApplicationRepresented(application_id)) {
+  if (!IsApplicationRepresented(application_id)) {
     LOG4CXX_INFO(
       logger_,
       "Setting default permissions for application id: " << application_id);
+    BeginPolicyImageChange(false);
 #if defined (EXTENDED_POLICY)
     if (kDeviceHasNoConsent == device_consent ||
         kDeviceDisallowed == device_consent) {
@@ -449,20 +559,26 @@ void PolicyManagerImpl::CheckAppPolicyState(const std::string& application_id) {
                                     .pt_data().get());
       if (!pt_ext) {
         LOG4CXX_WARN(logger_, "Can't cleanup unpaired devices.");
+        EndPolicyImageChange();
         return;
       }
-      pt_ext->SetPredataPolicy(application_id);
-    } else {
-      policy_table_.pt_data()->SetDefaultPolicy(application_id);
+      if (pt_ext->SetPredataPolicy(application_id)) {
+        AssignImagePolicy(application_id, kPreDataConsentId);
+      }
+    } else if (policy_table_.pt_data()->SetDefaultPolicy(application_id)) {
+      AssignImagePolicy(application_id, kDefaultId);
     }
 #else
-    policy_table_.pt_data()->SetDefaultPolicy(application_id);
+    if (policy_table_.pt_data()->SetDefaultPolicy(application_id)) {
+      AssignImagePolicy(application_id, kDefaultId);
+    }
 #endif
+    EndPolicyImageChange();
     SendNotificationOnPermissionsUpdated(application_id);
   } else {
-    if (!policy_table_.pt_data()->IsDefaultPolicy(application_id)
+    if (!IsDefaultPolicy(application_id)
         || (kDeviceHasNoConsent != device_consent
-            && policy_table_.pt_data()->IsPredataPolicy(application_id))) {
+            && IsPredataPolicy(application_id))) {
       return;
     }
   }
@@ -489,7 +605,7 @@ void PolicyManagerImpl::SendNotificationOnPermissionsUpdated(
   GetUserPermissionsForApp(device_id, application_id, app_group_permissions);
 
   policy_table::FunctionalGroupings functional_groupings;
-  policy_table_.pt_data()->GetFunctionalGroupings(functional_groupings);
+  GetFunctionalGroupings(functional_groupings);
 
   policy_table::Strings app_groups;
   std::vector<FunctionalGroupPermission>::const_iterator it =
@@ -667,7 +783,12 @@ bool PolicyManagerImpl::ReactOnUserDevConsentForApp(const std::string app_id,
     LOG4CXX_WARN(logger_, "Can't set user consent for device");
     return false;
   }
-  return pt_ext->ReactOnUserDevConsentForApp(app_id, is_device_allowed);
+  // Application policies may be changed, image is rebuilt later
+  BeginPolicyImageChange(true);
+  const bool result = pt_ext->ReactOnUserDevConsentForApp(app_id,
+                                                           is_device_allowed);
+  EndPolicyImageChange();
+  return result;
 #endif
   return true;
 }
@@ -1316,16 +1437,166 @@ void PolicyManagerImpl::MarkUnpairedDevice(const std::string& device_id) {
 #endif  // EXTENDED_POLICY
 }
 
+utils::SharedPtr<PolicyImage> PolicyManagerImpl::policy_image() const {
+  sync_primitives::AutoLock auto_lock(image_lock_);
+  return policy_image_;
+}
+
+bool PolicyManagerImpl::IsApplicationRepresented(
+  const std::string& app_id) const {
+  const utils::SharedPtr<PolicyImage> image = policy_image();
+  if (!image) {
+    return policy_table_.pt_data()->IsApplicationRepresented(app_id);
+  }
+  const policy_table::ApplicationPolicies& apps =
+    image->table.policy_table.app_policies;
+  return apps.end() != apps.find(app_id);
+}
+
+bool PolicyManagerImpl::IsDefaultPolicy(const std::string& app_id) const {
+  const utils::SharedPtr<PolicyImage> image = policy_image();
+  if (!image) {
+    return policy_table_.pt_data()->IsDefaultPolicy(app_id);
+  }
+  return image->default_apps.end() != image->default_apps.find(app_id);
+}
+
+bool PolicyManagerImpl::IsPredataPolicy(const std::string& app_id) const {
+  const utils::SharedPtr<PolicyImage> image = policy_image();
+  if (!image) {
+    return policy_table_.pt_data()->IsPredataPolicy(app_id);
+  }
+  return image->predata_apps.end() != image->predata_apps.find(app_id);
+}
+
+void PolicyManagerImpl::GetFunctionalGroupings(
+  policy_table::FunctionalGroupings& groups) const {
+  const utils::SharedPtr<PolicyImage> image = policy_image();
+  if (!image) {
+    policy_table_.pt_data()->GetFunctionalGroupings(groups);
+    return;
+  }
+  groups = image->table.policy_table.functional_groupings;
+}
+
+void PolicyManagerImpl::BeginPolicyImageChange(bool drop_image) {
+  {
+    sync_primitives::AutoLock auto_lock(image_lock_);
+    ++image_changes_;
+    ++image_changes_in_progress_;
+    if (drop_image) {
+      policy_image_ = utils::SharedPtr<PolicyImage>();
+      image_rebuild_required_ = true;
+    }
+  }
+  // Image is removed before database is changed, so outdated image is
+  // never loaded
+  sync_primitives::AutoLock auto_lock(image_file_lock_);
+  snapshot_cache_.Invalidate();
+}
+
+void PolicyManagerImpl::EndPolicyImageChange() {
+  sync_primitives::AutoLock auto_lock(image_lock_);
+  ++image_changes_;
+  --image_changes_in_progress_;
+}
+
+void PolicyManagerImpl::AssignImagePolicy(const std::string& app_id,
+                                          const std::string& policy_id) {
+  sync_primitives::AutoLock auto_lock(image_lock_);
+  if (!policy_image_) {
+    // Rebuilt image gets change from database
+    return;
+  }
+  utils::SharedPtr<PolicyImage> image = new PolicyImage(*policy_image_);
+  policy_table::ApplicationPolicies& apps =
+    image->table.policy_table.app_policies;
+  apps[app_id] = apps[policy_id];
+  if (kDefaultId == policy_id) {
+    image->default_apps.insert(app_id);
+    image->predata_apps.erase(app_id);
+  } else {
+    image->predata_apps.insert(app_id);
+    image->default_apps.erase(app_id);
+  }
+  policy_image_ = image;
+  image_save_required_ = true;
+}
+
+void PolicyManagerImpl::UpdatePolicyImage() {
+  uint32_t changes = 0;
+  bool rebuild_required = false;
+  utils::SharedPtr<PolicyImage> image;
+  {
+    sync_primitives::AutoLock auto_lock(image_lock_);
+    if (image_changes_in_progress_ > 0 ||
+        (!image_rebuild_required_ && !image_save_required_)) {
+      return;
+    }
+    changes = image_changes_;
+    rebuild_required = image_rebuild_required_;
+    image = policy_image_;
+  }
+
+  if (rebuild_required) {
+    LOG4CXX_INFO(logger_, "Rebuilding policy image.");
+    utils::SharedPtr<policy_table::Table> snapshot =
+      policy_table_.pt_data()->GenerateSnapshot();
+    if (!snapshot) {
+      LOG4CXX_WARN(logger_, "Failed to create snapshot for policy image.");
+      return;
+    }
+    image = new PolicyImage();
+    image->table = *snapshot;
+    const policy_table::ApplicationPolicies& apps =
+      image->table.policy_table.app_policies;
+    policy_table::ApplicationPolicies::const_iterator it = apps.begin();
+    for (; apps.end() != it; ++it) {
+      if (policy_table_.pt_data()->IsDefaultPolicy(it->first)) {
+        image->default_apps.insert(it->first);
+      }
+      if (policy_table_.pt_data()->IsPredataPolicy(it->first)) {
+        image->predata_apps.insert(it->first);
+      }
+    }
+  }
+
+  // File lock is taken first, so change can't remove file between the
+  // check and the save
+  sync_primitives::AutoLock file_lock(image_file_lock_);
+  {
+    sync_primitives::AutoLock auto_lock(image_lock_);
+    if (changes != image_changes_) {
+      // Database was changed meanwhile, next timeout retries
+      LOG4CXX_INFO(logger_, "Policy image was changed during update.");
+      return;
+    }
+    policy_image_ = image;
+    image_rebuild_required_ = false;
+    image_save_required_ = false;
+  }
+  if (!snapshot_cache_.Save(*image)) {
+    LOG4CXX_WARN(logger_, "Policy image is not saved.");
+  }
+}
+
 bool PolicyManagerImpl::ResetPT(const std::string& file_name) {
   return policy_table_.pt_data()->Clear() && LoadPTFromFile(file_name);
 }
 
 bool PolicyManagerImpl::InitPT(const std::string& file_name) {
   bool ret = false;
+  image_timer_.start(kPolicyImageUpdatePeriod);
   InitResult init_result = policy_table_.pt_data()->Init();
   switch (init_result) {
     case InitResult::EXISTS: {
       LOG4CXX_INFO(logger_, "Policy Table exists, was loaded correctly.");
+      // Registration is served by image instead of database. Missing
+      // image is rebuilt later, database is queried until then.
+      utils::SharedPtr<PolicyImage> image = snapshot_cache_.Load();
+      sync_primitives::AutoLock auto_lock(image_lock_);
+      policy_image_ = image;
+      image_rebuild_required_ = !image;
       ret = true;
     } break;
     case InitResult::SUCCESS: {
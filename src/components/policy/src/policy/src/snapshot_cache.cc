@@ -0,0 +1,200 @@
+/*
+ Copyright (c) 2013, Ford Motor Company
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following
+ disclaimer in the documentation and/or other materials provided with the
+ distribution.
+
+ Neither the name of the Ford Motor Company nor the names of its contributors
+ may be used to endorse or promote products derived from this software
+ without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifdef MODIFY_FUNCTION_SIGN
+#include <global_first.h>
+#endif
+#include "policy/snapshot_cache.h"
+
+#include <string.h>
+#include <vector>
+#include "rpc_base/json_stream.h"
+#include "utils/file_system.h"
+#include "utils/logger.h"
+#include "utils/mapped_file.h"
+
+namespace policy {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "PolicyManagerImpl")
+
+namespace {
+
+const uint32_t kSignature = 0x50544453;  // "SDTP"
+// Must be changed whenever layout of image or policy table types change
+const uint32_t kFormatVersion = 2;
+#ifdef EXTENDED_POLICY
+const uint32_t kFlavour = 1;
+#else
+const uint32_t kFlavour = 0;
+#endif
+
+struct ImageHeader {
+  uint32_t signature;
+  uint32_t format_version;
+  uint32_t flavour;
+  uint32_t payload_size;
+  uint32_t checksum;
+};
+
+uint32_t Adler32(const uint8_t* data, size_t size) {
+  const uint32_t kModulo = 65521;
+  // Largest number of bytes which can't overflow the sums
+  const size_t kBlock = 5552;
+  uint32_t a = 1;
+  uint32_t b = 0;
+  while (size > 0) {
+    const size_t block = size < kBlock ? size : kBlock;
+    for (size_t i = 0; i < block; ++i) {
+      a += data[i];
+      b += a;
+    }
+    a %= kModulo;
+    b %= kModulo;
+    data += block;
+    size -= block;
+  }
+  return (b << 16) | a;
+}
+
+void WriteNames(const std::set<std::string>& names, rpc::JsonWriter* writer) {
+  writer->BeginArray();
+  for (std::set<std::string>::const_iterator it = names.begin();
+       names.end() != it; ++it) {
+    writer->PutString(*it);
+  }
+  writer->EndArray();
+}
+
+void ReadNames(rpc::JsonReader* reader, std::set<std::string>* names) {
+  for (reader->EnterArray(); reader->NextElement();) {
+    std::string name;
+    if (reader->TakeString(&name)) {
+      names->insert(name);
+    }
+  }
+}
+
+}  // namespace
+
+SnapshotCache::SnapshotCache(const std::string& file_name)
+  : file_name_(file_name) {
+}
+
+utils::SharedPtr<PolicyImage> SnapshotCache::Load() const {
+  utils::SharedPtr<PolicyImage> result;
+  file_system::MappedFile image;
+  if (!image.Open(file_name_)) {
+    LOG4CXX_INFO(logger_, "No snapshot image " << file_name_);
+    return result;
+  }
+  ImageHeader header;
+  if (image.size() < sizeof(header)) {
+    LOG4CXX_WARN(logger_, "Snapshot image is truncated");
+    return result;
+  }
+  memcpy(&header, image.data(), sizeof(header));
+  const uint8_t* payload = image.data() + sizeof(header);
+  if (kSignature != header.signature ||
+      kFormatVersion != header.format_version ||
+      kFlavour != header.flavour) {
+    LOG4CXX_INFO(logger_, "Snapshot image has another format");
+    return result;
+  }
+  if (image.size() - sizeof(header) != header.payload_size ||
+      Adler32(payload, header.payload_size) != header.checksum) {
+    LOG4CXX_WARN(logger_, "Snapshot image is damaged");
+    return result;
+  }
+  const char* begin = reinterpret_cast<const char*>(payload);
+  rpc::JsonReader reader(begin, begin + header.payload_size);
+  result = new PolicyImage();
+  bool has_table = false;
+  std::string name;
+  for (reader.EnterObject(); reader.NextMember(&name);) {
+    if ("table" == name) {
+      result->table.ReadJson(&reader);
+      has_table = true;
+    } else if ("default_apps" == name) {
+      ReadNames(&reader, &result->default_apps);
+    } else if ("predata_apps" == name) {
+      ReadNames(&reader, &result->predata_apps);
+    } else {
+      reader.SkipValue();
+    }
+  }
+  if (reader.has_failed() || !has_table) {
+    LOG4CXX_WARN(logger_, "Failed to read snapshot image");
+    return utils::SharedPtr<PolicyImage>();
+  }
+  return result;
+}
+
+bool SnapshotCache::Save(const PolicyImage& policy_image) const {
+  std::string payload;
+  rpc::JsonWriter writer(&payload);
+  writer.BeginObject();
+  writer.PutKey("default_apps");
+  WriteNames(policy_image.default_apps, &writer);
+  writer.PutKey("predata_apps");
+  WriteNames(policy_image.predata_apps, &writer);
+  writer.PutKey("table");
+  policy_image.table.WriteJson(&writer);
+  writer.EndObject();
+
+  ImageHeader header;
+  header.signature = kSignature;
+  header.format_version = kFormatVersion;
+  header.flavour = kFlavour;
+  header.payload_size = payload.size();
+  header.checksum = Adler32(reinterpret_cast<const uint8_t*>(payload.data()),
+                            payload.size());
+  std::vector<uint8_t> image(sizeof(header) + payload.size());
+  memcpy(&image[0], &header, sizeof(header));
+  memcpy(&image[sizeof(header)], payload.data(), payload.size());
+
+  // Image is replaced at once, so reader never sees partially written one
+  const std::string temp_name = file_name_ + ".tmp";
+  if (!file_system::WriteBinaryFile(temp_name, image) ||
+      !file_system::RenameFile(temp_name, file_name_)) {
+    LOG4CXX_WARN(logger_, "Failed to save snapshot image " << file_name_);
+    file_system::DeleteFile(temp_name);
+    return false;
+  }
+  return true;
+}
+
+void SnapshotCache::Invalidate() const {
+  if (file_system::FileExists(file_name_)) {
+    file_system::DeleteFile(file_name_);
+  }
+}
+
+}  // namespace policy
@@ -96,6 +96,9 @@ const std::string kSelectPreconsentedGroups =
 
 const std::string kDeletePreconsentedGroups = "DELETE FROM `preconsented_group`";
 
+const std::string kDeletePreconsentedGroupsOfApp =
+  "DELETE FROM `preconsented_group` WHERE `application_id` = ?";
+
 const std::string kSelectUsageAndErrorCount =
   "SELECT `count_of_iap_buffer_full`, `count_sync_out_of_memory`, "
   "  `count_of_sync_reboots` "
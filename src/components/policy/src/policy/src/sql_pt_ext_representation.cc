@@ -563,61 +563,85 @@ bool SQLPTExtRepresentation::SaveApplicationPolicies(
   }
 
   policy_table::ApplicationPolicies::const_iterator it;
+  for (it = apps.begin(); it != apps.end(); ++it) {
+    if (!SaveApplicationPolicy(*it)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool SQLPTExtRepresentation::DeleteApplicationPolicy(
+  const std::string& app_id) {
+  dbms::SQLQuery query(db());
+  if (!query.Prepare(sql_pt_ext::kDeletePreconsentedGroupsOfApp)) {
+    LOG4CXX_WARN(logger_, "Incorrect delete statement for preconsented_group.");
+    return false;
+  }
+  query.Bind(0, app_id);
+  if (!query.Exec()) {
+    LOG4CXX_WARN(logger_, "Incorrect delete from preconsented_group.");
+    return false;
+  }
+  return SQLPTRepresentation::DeleteApplicationPolicy(app_id);
+}
+
+bool SQLPTExtRepresentation::SaveApplicationPolicy(
+  const policy_table::ApplicationPolicies::value_type& app) {
   dbms::SQLQuery app_query(db());
   if (!app_query.Prepare(sql_pt_ext::kInsertApplication)) {
     LOG4CXX_WARN(logger_, "Incorrect insert statement into application.");
     return false;
   }
-  for (it = apps.begin(); it != apps.end(); ++it) {
-    app_query.Bind(0, it->first);
-    app_query.Bind(1, it->second.keep_context);
-    app_query.Bind(2, it->second.steal_focus);
-    app_query.Bind(
-      3, std::string(policy_table::EnumToJsonString(it->second.default_hmi)));
-    app_query.Bind(
-      4, std::string(policy_table::EnumToJsonString(it->second.priority)));
-    app_query.Bind(
-      5, it->second.is_null());
-    app_query.Bind(6, it->second.memory_kb);
-    app_query.Bind(7, it->second.heart_beat_timeout_ms);
-    it->second.certificate.is_initialized() ?
-    app_query.Bind(8, *it->second.certificate) : app_query.Bind(8, std::string());
-
-    if (!app_query.Exec() || !app_query.Reset()) {
-      LOG4CXX_WARN(logger_, "Incorrect insert into application.");
-      return false;
-    }
+  app_query.Bind(0, app.first);
+  app_query.Bind(1, app.second.keep_context);
+  app_query.Bind(2, app.second.steal_focus);
+  app_query.Bind(
+    3, std::string(policy_table::EnumToJsonString(app.second.default_hmi)));
+  app_query.Bind(
+    4, std::string(policy_table::EnumToJsonString(app.second.priority)));
+  app_query.Bind(
+    5, app.second.is_null());
+  app_query.Bind(6, app.second.memory_kb);
+  app_query.Bind(7, app.second.heart_beat_timeout_ms);
+  app.second.certificate.is_initialized() ?
+  app_query.Bind(8, *app.second.certificate) : app_query.Bind(8, std::string());
+
+  if (!app_query.Exec()) {
+    LOG4CXX_WARN(logger_, "Incorrect insert into application.");
+    return false;
+  }
 
-    LOG4CXX_INFO(logger_, "Saving data for application: " << it->first);
-    if (it->second.is_string()) {
-      if (kDefaultId.compare(it->second.get_string()) == 0) {
-        if (!SetDefaultPolicy(it->first)) {
-          return false;
-        }
+  LOG4CXX_INFO(logger_, "Saving data for application: " << app.first);
+  if (app.second.is_string()) {
+    if (kDefaultId.compare(app.second.get_string()) == 0) {
+      if (!SetDefaultPolicy(app.first)) {
+        return false;
       }
-      if (kPreDataConsentId.compare(it->second.get_string()) == 0) {
-        if (!SetPredataPolicy(it->first)) {
-          return false;
-        }
+    }
+    if (kPreDataConsentId.compare(app.second.get_string()) == 0) {
+      if (!SetPredataPolicy(app.first)) {
+        return false;
       }
-      continue;
     }
+    return true;
+  }
 
-    if (!SaveAppGroup(it->first, it->second.groups)) {
-      return false;
-    }
-    // TODO(IKozyrenko): Check logic if optional container is missing
-    if (!SaveNickname(it->first, *it->second.nicknames)) {
-      return false;
-    }
-    // TODO(IKozyrenko): Check logic if optional container is missing
-    if (!SaveAppType(it->first, *it->second.AppHMIType)) {
-      return false;
-    }
-    // TODO(IKozyrenko): Check logic if optional container is missing
-    if (!SavePreconsentedGroup(it->first, *it->second.preconsented_groups)) {
-      return false;
-    }
+  if (!SaveAppGroup(app.first, app.second.groups)) {
+    return false;
+  }
+  // TODO(IKozyrenko): Check logic if optional container is missing
+  if (!SaveNickname(app.first, *app.second.nicknames)) {
+    return false;
+  }
+  // TODO(IKozyrenko): Check logic if optional container is missing
+  if (!SaveAppType(app.first, *app.second.AppHMIType)) {
+    return false;
+  }
+  // TODO(IKozyrenko): Check logic if optional container is missing
+  if (!SavePreconsentedGroup(app.first, *app.second.preconsented_groups)) {
+    return false;
   }
 
   return true;
@@ -1290,7 +1314,9 @@ bool SQLPTExtRepresentation::SetPredataPolicy(const std::string& app_id) {
     return false;
   }
   apps[app_id] = apps[kPreDataConsentId];
-  if (!SaveApplicationPolicies(apps)) {
+  // Only given application is written, others are left as is
+  if (!DeleteApplicationPolicy(app_id) ||
+      !SaveApplicationPolicy(*apps.find(app_id))) {
     LOG4CXX_WARN(logger_, "Failed saving application policies");
     return false;
   }
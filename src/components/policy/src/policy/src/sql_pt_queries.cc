@@ -607,6 +607,36 @@ const std::string kUpdateIsDefault =
 
 const std::string kDeleteDevice = "DELETE FROM `device` WHERE `id` = ?";
 
+const std::string kSelectFunctionalGroupId =
+  "SELECT `id` FROM `functional_group` WHERE `name` = ? LIMIT 1";
+
+const std::string kUpdateFunctionalGroup =
+  "UPDATE `functional_group` SET `user_consent_prompt` = ? WHERE `id` = ?";
+
+const std::string kDeleteFunctionalGroupById =
+  "DELETE FROM `functional_group` WHERE `id` = ?";
+
+const std::string kDeleteRpcOfGroup =
+  "DELETE FROM `rpc` WHERE `functional_group_id` = ?";
+
+const std::string kDeleteAppGroupOfGroup =
+  "DELETE FROM `app_group` WHERE `functional_group_id` = ?";
+
+const std::string kDeleteAppGroupOfApp =
+  "DELETE FROM `app_group` WHERE `application_id` = ?";
+
+const std::string kDeleteNicknameOfApp =
+  "DELETE FROM `nickname` WHERE `application_id` = ?";
+
+const std::string kDeleteAppTypeOfApp =
+  "DELETE FROM `app_type` WHERE `application_id` = ?";
+
+const std::string kDeleteApplicationById =
+  "DELETE FROM `application` WHERE `id` = ?";
+
+const std::string kDeleteMessageStringOfType =
+  "DELETE FROM `message` WHERE `message_type_name` = ?";
+
 }  // namespace sql_pt
 }  // namespace policy
 
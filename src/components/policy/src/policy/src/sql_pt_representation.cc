@@ -32,6 +32,7 @@
 #ifdef MODIFY_FUNCTION_SIGN
 #include <global_first.h>
 #endif
+#include <set>
 #include <sstream>
 #include "utils/logger.h"
 #include "policy/sql_pt_representation.h"
@@ -555,6 +556,37 @@ bool SQLPTRepresentation::Save(const policy_table::Table& table) {
   return true;
 }
 
+bool SQLPTRepresentation::SaveDelta(const policy_table::Table& table,
+                                    const PolicyTableDelta& delta) {
+  LOG4CXX_INFO(logger_, "SQLPTRepresentation::SaveDelta");
+  if (delta.IsEmpty()) {
+    LOG4CXX_INFO(logger_, "Policy table is not changed by update.");
+    return true;
+  }
+  db_->BeginTransaction();
+  if (!SaveFunctionalGroupingsDelta(table.policy_table, delta)) {
+    db_->RollbackTransaction();
+    return false;
+  }
+  if (!SaveApplicationPoliciesDelta(table.policy_table.app_policies,
+                                    delta.updated_apps)) {
+    db_->RollbackTransaction();
+    return false;
+  }
+  if (delta.module_config_updated &&
+      !SaveModuleConfig(table.policy_table.module_config)) {
+    db_->RollbackTransaction();
+    return false;
+  }
+  if (!SaveConsumerFriendlyMessagesDelta(
+        *table.policy_table.consumer_friendly_messages, delta)) {
+    db_->RollbackTransaction();
+    return false;
+  }
+  db_->CommitTransaction();
+  return true;
+}
+
 bool SQLPTRepresentation::SaveFunctionalGroupings(
   const policy_table::FunctionalGroupings& groups) {
   LOG4CXX_INFO(logger_, "SaveFunctionalGroupings");
@@ -592,6 +624,139 @@ bool SQLPTRepresentation::SaveFunctionalGroupings(
   return true;
 }
 
+bool SQLPTRepresentation::SaveFunctionalGroupingsDelta(
+  const policy_table::PolicyTable& policy_data,
+  const PolicyTableDelta& delta) {
+  if (delta.updated_groups.empty() && delta.removed_groups.empty()) {
+    return true;
+  }
+  LOG4CXX_INFO(logger_, "SaveFunctionalGroupingsDelta");
+  dbms::SQLQuery select_id(db());
+  dbms::SQLQuery delete_rpc(db());
+  if (!select_id.Prepare(sql_pt::kSelectFunctionalGroupId) ||
+      !delete_rpc.Prepare(sql_pt::kDeleteRpcOfGroup)) {
+    LOG4CXX_WARN(logger_, "Incorrect statement for functional groups");
+    return false;
+  }
+
+  std::set<std::string>::const_iterator it;
+  if (!delta.removed_groups.empty()) {
+    dbms::SQLQuery delete_app_group(db());
+    dbms::SQLQuery delete_group(db());
+    if (!delete_app_group.Prepare(sql_pt::kDeleteAppGroupOfGroup) ||
+        !delete_group.Prepare(sql_pt::kDeleteFunctionalGroupById)) {
+      LOG4CXX_WARN(logger_, "Incorrect delete statement for functional group");
+      return false;
+    }
+    for (it = delta.removed_groups.begin();
+         delta.removed_groups.end() != it; ++it) {
+      select_id.Bind(0, *it);
+      const bool exists = select_id.Next();
+      const int group_id = exists ? select_id.GetInteger(0) : 0;
+      select_id.Reset();
+      if (!exists) {
+        continue;
+      }
+      delete_rpc.Bind(0, group_id);
+      delete_app_group.Bind(0, group_id);
+      delete_group.Bind(0, group_id);
+      if (!delete_rpc.Exec() || !delete_rpc.Reset() ||
+          !delete_app_group.Exec() || !delete_app_group.Reset() ||
+          !delete_group.Exec() || !delete_group.Reset()) {
+        LOG4CXX_WARN(logger_, "Incorrect delete of functional group " << *it);
+        return false;
+      }
+    }
+  }
+
+  dbms::SQLQuery update_group(db());
+  dbms::SQLQuery insert_group(db());
+  if (!update_group.Prepare(sql_pt::kUpdateFunctionalGroup) ||
+      !insert_group.Prepare(sql_pt::kInsertFunctionalGroup)) {
+    LOG4CXX_WARN(logger_, "Incorrect statement for functional group");
+    return false;
+  }
+  const policy_table::FunctionalGroupings& groups =
+    policy_data.functional_groupings;
+  for (it = delta.updated_groups.begin();
+       delta.updated_groups.end() != it; ++it) {
+    policy_table::FunctionalGroupings::const_iterator group = groups.find(*it);
+    if (groups.end() == group) {
+      continue;
+    }
+    select_id.Bind(0, *it);
+    const bool exists = select_id.Next();
+    int64_t group_id = exists ? select_id.GetInteger(0) : 0;
+    select_id.Reset();
+
+    // Existing group keeps its id, so links to applications stay valid
+    if (exists) {
+      group->second.user_consent_prompt.is_initialized() ?
+      update_group.Bind(0, *(group->second.user_consent_prompt)) :
+      update_group.Bind(0);
+      update_group.Bind(1, group_id);
+      delete_rpc.Bind(0, group_id);
+      if (!update_group.Exec() || !update_group.Reset() ||
+          !delete_rpc.Exec() || !delete_rpc.Reset()) {
+        LOG4CXX_WARN(logger_, "Incorrect update of functional group " << *it);
+        return false;
+      }
+    } else {
+      insert_group.Bind(0, *it);
+      group->second.user_consent_prompt.is_initialized() ?
+      insert_group.Bind(1, *(group->second.user_consent_prompt)) :
+      insert_group.Bind(1);
+      if (!insert_group.Exec() || !insert_group.Reset()) {
+        LOG4CXX_WARN(logger_, "Incorrect insert into functional groups");
+        return false;
+      }
+      group_id = insert_group.LastInsertId();
+      if (!SaveGroupLinks(*it, policy_data.app_policies)) {
+        return false;
+      }
+    }
+
+    if (!SaveRpcs(group_id, group->second.rpcs)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SQLPTRepresentation::SaveGroupLinks(
+  const std::string& group_name,
+  const policy_table::ApplicationPolicies& apps) {
+  // Applications could refer to group before it was added
+  dbms::SQLQuery query(db());
+  if (!query.Prepare(sql_pt::kInsertAppGroup)) {
+    LOG4CXX_WARN(logger_, "Incorrect insert statement for app group");
+    return false;
+  }
+  policy_table::ApplicationPolicies::const_iterator it;
+  for (it = apps.begin(); apps.end() != it; ++it) {
+    if (it->second.is_string() || it->second.is_null()) {
+      continue;
+    }
+    const policy_table::Strings& app_groups = it->second.groups;
+    policy_table::Strings::const_iterator group_it = app_groups.begin();
+    for (; app_groups.end() != group_it; ++group_it) {
+      if (group_name == static_cast<const std::string&>(*group_it)) {
+        break;
+      }
+    }
+    if (app_groups.end() == group_it) {
+      continue;
+    }
+    query.Bind(0, it->first);
+    query.Bind(1, group_name);
+    if (!query.Exec() || !query.Reset()) {
+      LOG4CXX_WARN(logger_, "Incorrect insert into app group.");
+      return false;
+    }
+  }
+  return true;
+}
+
 bool SQLPTRepresentation::SaveRpcs(int64_t group_id,
                                    const policy_table::Rpc& rpcs) {
   dbms::SQLQuery query(db());
@@ -651,46 +816,93 @@ bool SQLPTRepresentation::SaveApplicationPolicies(
     return false;
   }
   policy_table::ApplicationPolicies::const_iterator it;
-  dbms::SQLQuery app_query(db());
-  if (!app_query.Prepare(sql_pt::kInsertApplication)) {
-    LOG4CXX_WARN(logger_, "Incorrect insert statement into application.");
-    return false;
-  }
   for (it = apps.begin(); it != apps.end(); ++it) {
-    app_query.Bind(0, it->first);
-    app_query.Bind(1, it->second.is_null());
-    app_query.Bind(2, it->second.memory_kb);
-    app_query.Bind(3, it->second.heart_beat_timeout_ms);
-    it->second.certificate.is_initialized() ?
-    app_query.Bind(4, *it->second.certificate) : app_query.Bind(4);
-
-    if (!app_query.Exec() || !app_query.Reset()) {
-      LOG4CXX_WARN(logger_, "Incorrect insert into application.");
+    if (!SaveApplicationPolicy(*it)) {
       return false;
     }
+  }
 
-    LOG4CXX_INFO(logger_, "Saving data for application: " << it->first);
-    if (it->second.is_string()) {
-      if (kDefaultId.compare(it->second.get_string()) == 0) {
-        if (!SetDefaultPolicy(it->first)) {
-          return false;
-        }
-      }
+  return true;
+}
+
+bool SQLPTRepresentation::SaveApplicationPoliciesDelta(
+  const policy_table::ApplicationPolicies& apps,
+  const std::set<std::string>& app_ids) {
+  std::set<std::string>::const_iterator it;
+  for (it = app_ids.begin(); app_ids.end() != it; ++it) {
+    policy_table::ApplicationPolicies::const_iterator app = apps.find(*it);
+    if (apps.end() == app) {
       continue;
     }
-
-    if (!SaveAppGroup(it->first, it->second.groups)) {
+    if (!DeleteApplicationPolicy(*it) || !SaveApplicationPolicy(*app)) {
       return false;
     }
-    // TODO(IKozyrenko): Check logic if optional container is missing
-    if (!SaveNickname(it->first, *it->second.nicknames)) {
+  }
+  return true;
+}
+
+bool SQLPTRepresentation::DeleteApplicationPolicy(const std::string& app_id) {
+  const std::string* const queries[] = {
+    &sql_pt::kDeleteAppGroupOfApp,
+    &sql_pt::kDeleteNicknameOfApp,
+    &sql_pt::kDeleteAppTypeOfApp,
+    &sql_pt::kDeleteApplicationById
+  };
+  for (size_t i = 0; i < sizeof(queries) / sizeof(queries[0]); ++i) {
+    dbms::SQLQuery query(db());
+    if (!query.Prepare(*queries[i])) {
+      LOG4CXX_WARN(logger_, "Incorrect delete statement for application.");
       return false;
     }
-    // TODO(IKozyrenko): Check logic if optional container is missing
-    if (!SaveAppType(it->first, *it->second.AppHMIType)) {
+    query.Bind(0, app_id);
+    if (!query.Exec()) {
+      LOG4CXX_WARN(logger_, "Incorrect delete of application " << app_id);
       return false;
     }
   }
+  return true;
+}
+
+bool SQLPTRepresentation::SaveApplicationPolicy(
+  const policy_table::ApplicationPolicies::value_type& app) {
+  dbms::SQLQuery app_query(db());
+  if (!app_query.Prepare(sql_pt::kInsertApplication)) {
+    LOG4CXX_WARN(logger_, "Incorrect insert statement into application.");
+    return false;
+  }
+  app_query.Bind(0, app.first);
+  app_query.Bind(1, app.second.is_null());
+  app_query.Bind(2, app.second.memory_kb);
+  app_query.Bind(3, app.second.heart_beat_timeout_ms);
+  app.second.certificate.is_initialized() ?
+  app_query.Bind(4, *app.second.certificate) : app_query.Bind(4);
+
+  if (!app_query.Exec()) {
+    LOG4CXX_WARN(logger_, "Incorrect insert into application.");
+    return false;
+  }
+
+  LOG4CXX_INFO(logger_, "Saving data for application: " << app.first);
+  if (app.second.is_string()) {
+    if (kDefaultId.compare(app.second.get_string()) == 0) {
+      if (!SetDefaultPolicy(app.first)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  if (!SaveAppGroup(app.first, app.second.groups)) {
+    return false;
+  }
+  // TODO(IKozyrenko): Check logic if optional container is missing
+  if (!SaveNickname(app.first, *app.second.nicknames)) {
+    return false;
+  }
+  // TODO(IKozyrenko): Check logic if optional container is missing
+  if (!SaveAppType(app.first, *app.second.AppHMIType)) {
+    return false;
+  }
 
   return true;
 }
@@ -874,21 +1086,66 @@ bool SQLPTRepresentation::SaveConsumerFriendlyMessages(
   policy_table::Messages::const_iterator it;
   // TODO(IKozyrenko): Check logic if optional container is missing
   for (it = messages.messages->begin(); it != messages.messages->end(); ++it) {
-    if (!SaveMessageType(it->first)) {
+    if (!SaveMessage(it->first, it->second.languages)) {
       return false;
     }
-    const policy_table::Languages& langs = it->second.languages;
-    policy_table::Languages::const_iterator lang_it;
-    for (lang_it = langs.begin(); lang_it != langs.end(); ++lang_it) {
-      if (!SaveLanguage(lang_it->first)) {
-        return false;
-      }
-      if (!SaveMessageString(it->first, lang_it->first, lang_it->second)) {
-        return false;
-      }
+  }
+
+  return true;
+}
+
+bool SQLPTRepresentation::SaveConsumerFriendlyMessagesDelta(
+  const policy_table::ConsumerFriendlyMessages& messages,
+  const PolicyTableDelta& delta) {
+  if (delta.updated_messages.empty() && delta.removed_messages.empty()) {
+    return true;
+  }
+  LOG4CXX_INFO(logger_, "SaveConsumerFriendlyMessagesDelta");
+  dbms::SQLQuery query(db());
+  if (!query.Prepare(sql_pt::kDeleteMessageStringOfType)) {
+    LOG4CXX_WARN(logger_, "Incorrect delete statement for message.");
+    return false;
+  }
+
+  std::set<std::string> changed(delta.removed_messages);
+  changed.insert(delta.updated_messages.begin(), delta.updated_messages.end());
+  std::set<std::string>::const_iterator it;
+  for (it = changed.begin(); changed.end() != it; ++it) {
+    query.Bind(0, *it);
+    if (!query.Exec() || !query.Reset()) {
+      LOG4CXX_WARN(logger_, "Incorrect delete from message.");
+      return false;
     }
   }
 
+  // TODO(IKozyrenko): Check logic if optional container is missing
+  const policy_table::Messages& all_messages = *messages.messages;
+  for (it = delta.updated_messages.begin();
+       delta.updated_messages.end() != it; ++it) {
+    policy_table::Messages::const_iterator message = all_messages.find(*it);
+    if (all_messages.end() != message &&
+        !SaveMessage(message->first, message->second.languages)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool SQLPTRepresentation::SaveMessage(
+  const std::string& type, const policy_table::Languages& langs) {
+  if (!SaveMessageType(type)) {
+    return false;
+  }
+  policy_table::Languages::const_iterator lang_it;
+  for (lang_it = langs.begin(); lang_it != langs.end(); ++lang_it) {
+    if (!SaveLanguage(lang_it->first)) {
+      return false;
+    }
+    if (!SaveMessageString(type, lang_it->first, lang_it->second)) {
+      return false;
+    }
+  }
   return true;
 }
 
@@ -1203,7 +1460,9 @@ bool SQLPTRepresentation::SetDefaultPolicy(const std::string& app_id) {
     return false;
   }
   apps[app_id] = apps[kDefaultId];
-  if (!SaveApplicationPolicies(apps)) {
+  // Only given application is written, others are left as is
+  if (!DeleteApplicationPolicy(app_id) ||
+      !SaveApplicationPolicy(*apps.find(app_id))) {
     LOG4CXX_WARN(logger_, "Failed saving application policies");
     return false;
   }
@@ -85,6 +85,9 @@ class MockPTRepresentation : virtual public PTRepresentation {
                        utils::SharedPtr<policy_table::Table>());
     MOCK_METHOD1(Save,
                  bool(const policy_table::Table& table));
+    MOCK_METHOD2(SaveDelta,
+                 bool(const policy_table::Table& table,
+                      const PolicyTableDelta& delta));
     MOCK_CONST_METHOD0(UpdateRequired,
                        bool());
     MOCK_METHOD1(SaveUpdateRequired,
@@ -364,7 +364,7 @@ TEST_F(PolicyManagerImplTest, DISABLED_LoadPT) {
   std::string json = table.toStyledString();
   ::policy::BinaryMessage msg(json.begin(), json.end());
 
-  EXPECT_CALL(mock_pt, Save(_)).Times(1).WillOnce(Return(true));
+  EXPECT_CALL(mock_pt, SaveDelta(_, _)).Times(1).WillOnce(Return(true));
   EXPECT_CALL(mock_listener, OnUpdateStatusChanged(_)).Times(1);
 
   PolicyManagerImpl* manager = new PolicyManagerImpl();
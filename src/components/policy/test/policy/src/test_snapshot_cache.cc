@@ -0,0 +1,121 @@
+/* Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "json/reader.h"
+#include "json/value.h"
+#include "json/writer.h"
+#include "./types.h"
+#include "policy/snapshot_cache.h"
+#include "utils/file_system.h"
+
+using namespace rpc::policy_table_interface_base;
+
+namespace test {
+namespace components {
+namespace policy {
+
+class SnapshotCacheTest : public ::testing::Test {
+ protected:
+  SnapshotCacheTest()
+    : cache_("test_policy.snapshot") {
+  }
+
+  virtual void SetUp() {
+    std::ifstream json_file("valid_sdl_pt_update.json");
+    ASSERT_TRUE(json_file.is_open());
+    Json::Reader reader;
+    ASSERT_TRUE(reader.parse(json_file, table_json_));
+  }
+
+  virtual void TearDown() {
+    cache_.Invalidate();
+  }
+
+  Json::Value table_json_;
+  ::policy::SnapshotCache cache_;
+};
+
+TEST_F(SnapshotCacheTest, LoadReturnsSavedImage) {
+  ::policy::PolicyImage image;
+  image.table = Table(&table_json_);
+  image.default_apps.insert("1234");
+  image.predata_apps.insert("5678");
+  image.predata_apps.insert("9012");
+  ASSERT_TRUE(cache_.Save(image));
+  utils::SharedPtr< ::policy::PolicyImage> loaded = cache_.Load();
+  ASSERT_TRUE(loaded);
+  Json::FastWriter writer;
+  EXPECT_EQ(writer.write(image.table.ToJsonValue()),
+            writer.write(loaded->table.ToJsonValue()));
+  EXPECT_EQ(image.default_apps, loaded->default_apps);
+  EXPECT_EQ(image.predata_apps, loaded->predata_apps);
+}
+
+TEST_F(SnapshotCacheTest, MissingImageIsNotLoaded) {
+  cache_.Invalidate();
+  EXPECT_FALSE(file_system::FileExists(cache_.file_name()));
+  EXPECT_FALSE(cache_.Load());
+}
+
+TEST_F(SnapshotCacheTest, DamagedImageIsNotLoaded) {
+  ::policy::PolicyImage policy_image;
+  policy_image.table = Table(&table_json_);
+  ASSERT_TRUE(cache_.Save(policy_image));
+  std::vector<uint8_t> image;
+  ASSERT_TRUE(file_system::ReadBinaryFile(cache_.file_name(), image));
+
+  // Changed payload byte
+  std::vector<uint8_t> damaged = image;
+  damaged[damaged.size() / 2] ^= 1;
+  ASSERT_TRUE(file_system::WriteBinaryFile(cache_.file_name(), damaged));
+  EXPECT_FALSE(cache_.Load());
+
+  // Truncated payload
+  damaged = image;
+  damaged.resize(damaged.size() - 1);
+  ASSERT_TRUE(file_system::WriteBinaryFile(cache_.file_name(), damaged));
+  EXPECT_FALSE(cache_.Load());
+
+  // Another format version
+  damaged = image;
+  damaged[4] ^= 0xFF;
+  ASSERT_TRUE(file_system::WriteBinaryFile(cache_.file_name(), damaged));
+  EXPECT_FALSE(cache_.Load());
+}
+
+}  // namespace policy
+}  // namespace components
+}  // namespace test
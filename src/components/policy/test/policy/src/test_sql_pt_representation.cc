@@ -38,6 +38,7 @@
 #include <vector>
 #include "json/value.h"
 #include "policy/sql_pt_representation.h"
+#include "policy/policy_helper.h"
 #include "policy/policy_types.h"
 #include "./types.h"
 #include "./enums.h"
@@ -436,6 +437,78 @@ TEST_F(SQLPTRepresentationTest, SaveGenerateSnapshot) {
   EXPECT_EQ(table.ToJsonValue().toStyledString(),
             snapshot->ToJsonValue().toStyledString());
 }
+
+TEST_F(SQLPTRepresentationTest, SaveDeltaOfUpdatedEntries) {
+  Json::Value expect(Json::objectValue);
+  expect["policy_table"] = Json::Value(Json::objectValue);
+
+  Json::Value& policy_table = expect["policy_table"];
+  policy_table["module_config"] = Json::Value(Json::objectValue);
+  Json::Value& module_config = policy_table["module_config"];
+  module_config["exchange_after_x_ignition_cycles"] = Json::Value(10);
+  module_config["exchange_after_x_kilometers"] = Json::Value(100);
+  module_config["exchange_after_x_days"] = Json::Value(5);
+  module_config["timeout_after_x_seconds"] = Json::Value(60);
+
+  Json::Value& functional_groupings = policy_table["functional_groupings"];
+  Json::Value& default_group = functional_groupings["default"];
+  default_group["rpcs"]["Update"]["hmi_levels"][0] = Json::Value("FULL");
+  default_group["rpcs"]["Update"]["parameters"][0] = Json::Value("speed");
+
+  Json::Value& app_policies = policy_table["app_policies"];
+  app_policies["default"]["groups"][0] = Json::Value("default");
+
+  policy_table["consumer_friendly_messages"]["version"] = Json::Value("1.2");
+
+  policy_table::Table table(&expect);
+  ASSERT_TRUE(reps->Save(table));
+
+  // Update adds group and application using it, changes module config
+  Json::Value& location_group = functional_groupings["Location-1"];
+  location_group["rpcs"]["GetVehicleData"]["hmi_levels"][0] =
+    Json::Value("FULL");
+  location_group["rpcs"]["GetVehicleData"]["parameters"][0] =
+    Json::Value("gps");
+  app_policies["1234"]["groups"][0] = Json::Value("Location-1");
+  module_config["timeout_after_x_seconds"] = Json::Value(30);
+
+  policy_table::Table update(&expect);
+  ::policy::PolicyTableDelta delta;
+  ::policy::CollectTableDelta(table, update, &delta);
+  ASSERT_EQ(1u, delta.updated_groups.size());
+  EXPECT_EQ("Location-1", *delta.updated_groups.begin());
+  EXPECT_TRUE(delta.removed_groups.empty());
+  ASSERT_EQ(1u, delta.updated_apps.size());
+  EXPECT_EQ("1234", *delta.updated_apps.begin());
+  EXPECT_TRUE(delta.module_config_updated);
+
+  ASSERT_TRUE(reps->SaveDelta(update, delta));
+  EXPECT_EQ(30, reps->TimeoutResponse());
+
+  // Unchanged application keeps link to unchanged group
+  CheckPermissionResult ret = reps->CheckPermissions("default", "FULL",
+                                                     "Update");
+  EXPECT_EQ(::policy::kRpcAllowed, ret.hmi_level_permitted);
+  ret = reps->CheckPermissions("1234", "FULL", "GetVehicleData");
+  EXPECT_EQ(::policy::kRpcAllowed, ret.hmi_level_permitted);
+
+  utils::SharedPtr<policy_table::Table> snapshot = reps->GenerateSnapshot();
+  ASSERT_TRUE(snapshot);
+  EXPECT_EQ(update.policy_table.functional_groupings.ToJsonValue(),
+            snapshot->policy_table.functional_groupings.ToJsonValue());
+
+  // Removed group is not available for application anymore
+  functional_groupings.removeMember("Location-1");
+  policy_table::Table update_removal(&expect);
+  ::policy::PolicyTableDelta delta_removal;
+  ::policy::CollectTableDelta(update, update_removal, &delta_removal);
+  ASSERT_EQ(1u, delta_removal.removed_groups.size());
+  ASSERT_TRUE(reps->SaveDelta(update_removal, delta_removal));
+  ret = reps->CheckPermissions("1234", "FULL", "GetVehicleData");
+  EXPECT_EQ(::policy::kRpcDisallowed, ret.hmi_level_permitted);
+  ret = reps->CheckPermissions("default", "FULL", "Update");
+  EXPECT_EQ(::policy::kRpcAllowed, ret.hmi_level_permitted);
+}
 #endif  // EXTENDED_POLICY
 
 }  // namespace policy
@@ -39,11 +39,14 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
+#include <vector>
 #include "utils/prioritized_queue.h"
 #include "utils/message_queue.h"
 #include "utils/threads/thread.h"
 #include "utils/threads/message_loop_thread.h"
 #include "utils/shared_ptr.h"
+#include "utils/lock.h"
 
 #include "protocol_handler/protocol_handler.h"
 #include "protocol_handler/protocol_packet.h"
@@ -52,9 +55,6 @@
 #include "transport_manager/common.h"
 #include "transport_manager/transport_manager.h"
 #include "transport_manager/transport_manager_listener_empty.h"
-#ifdef TIME_TESTER
-#include "time_metric_observer.h"
-#endif  // TIME_TESTER
 
 /**
  *\namespace NsProtocolHandler
@@ -174,15 +174,6 @@ class ProtocolHandlerImpl
      */
     void SendFramesNumber(int32_t connection_key, int32_t number_of_frames);
 
-#ifdef TIME_TESTER
-    /**
-     * @brief Setup observer for time metric.
-     *
-     * @param observer - pointer to observer
-     */
-    void SetTimeMetricObserver(PHMetricObserver* observer);
-#endif  // TIME_TESTER
-
 
     /*
      * Prepare and send heartbeat message to mobile
@@ -210,13 +201,15 @@ class ProtocolHandlerImpl
      * to be sent to
      * mobile app for using when ending session
      * \param service_type Type of session: RPC or BULK Data. RPC by default
+     * \param compress Payloads of service may be compressed
      */
     void SendStartSessionAck(
       ConnectionID connection_id,
       uint8_t session_id,
       uint8_t protocol_version,
       uint32_t hash_code = 0,
-      uint8_t service_type = SERVICE_TYPE_RPC);
+      uint8_t service_type = SERVICE_TYPE_RPC,
+      bool compress = false);
 
     /**
      * \brief Sends fail of starting session to mobile application
@@ -425,6 +418,21 @@ class ProtocolHandlerImpl
       ConnectionID connection_id ,
       const ProtocolPacket& packet);
 
+    /**
+     * \brief Checks if compression was negotiated for service of session
+     */
+    bool IsCompressionNegotiated(ConnectionID connection_id,
+                                 uint8_t session_id,
+                                 uint8_t service_type);
+
+    /**
+     * \brief Replaces compressed payload of received message with original
+     * \return false if compression was not negotiated or data is malformed
+     */
+    bool DecompressPayload(ConnectionID connection_id,
+                           const ProtocolPacket& packet,
+                           utils::SharedBuffer* payload);
+
     /**
      * \brief Sends Mobile Navi Ack message
      */
@@ -433,19 +441,70 @@ class ProtocolHandlerImpl
       int32_t connection_key);
 
     // threads::MessageLoopThread<*>::Handler implementations
-    // CALLED ON raw_ford_messages_from_mobile_ thread!
+    // CALLED ON raw_ford_messages_from_mobile thread of connection shard!
     void Handle(const impl::RawFordMessageFromMobile& message);
-    // CALLED ON raw_ford_messages_to_mobile_ thread!
+    // CALLED ON raw_ford_messages_to_mobile thread of connection shard!
     void Handle(const impl::RawFordMessageToMobile& message);
+
+    /**
+     * \brief Frames of session are numbered per connection and session
+     */
+    typedef std::pair<ConnectionID, uint8_t> SessionKey;
+
+    /**
+     * \brief Processing state of group of connections. Every connection
+     * belongs to single shard, so its frames are handled in order, while
+     * connections of different shards are handled in parallel.
+     */
+    struct ConnectionShard {
+      ConnectionShard(const std::string& name_suffix,
+                      ProtocolHandlerImpl* handler);
+
+      /**
+       *\brief Map of frames for messages received in multiple frames.
+       *\brief Accessed only from raw_ford_messages_from_mobile thread.
+       */
+      std::map<int32_t, ProtocolFramePtr> incomplete_multi_frame_messages;
+
+      /**
+       *\brief Guards message counters and last messages of sessions
+       *\brief which are accessed from application and transport threads.
+       *\brief Held while all frames of message are queued, so frames of
+       *\brief concurrently sent messages do not interleave.
+       */
+      sync_primitives::Lock messages_lock;
+
+      /**
+       *\brief Counter of messages sent in each session.
+       */
+      std::map<SessionKey, uint32_t> message_counters;
+
+      /**
+       *\brief map for session last message.
+       */
+      std::map<SessionKey, uint32_t> sessions_last_message_id;
+
+      // Thread that pumps messages prepared to being sent to mobile side.
+      impl::ToMobileQueue raw_ford_messages_to_mobile;
+      // Thread that pumps non-parsed messages coming from mobile side.
+      // Declared last to be stopped first, it posts replies to mobile.
+      impl::FromMobileQueue raw_ford_messages_from_mobile;
+
+     private:
+      DISALLOW_COPY_AND_ASSIGN(ConnectionShard);
+    };
+
+    /**
+     * \brief Returns shard which handles frames of connection
+     */
+    ConnectionShard& ShardForConnection(ConnectionID connection_id);
+
   private:
     /**
      *\brief Pointer on instance of class implementing IProtocolObserver
      *\brief (JSON Handler)
      */
     ProtocolObservers protocol_observers_;
-#ifdef TIME_TESTER
-    PHMetricObserver* metric_observer_;
-#endif  // TIME_TESTER
 
     /**
      *\brief Pointer on instance of class implementing ISessionObserver
@@ -458,11 +517,6 @@ class ProtocolHandlerImpl
      */
     transport_manager::TransportManager* transport_manager_;
 
-    /**
-     *\brief Map of frames for messages received in multiple frames.
-     */
-    std::map<int32_t, ProtocolFramePtr> incomplete_multi_frame_messages_;
-
     /**
      * \brief Map of messages (frames) recieved over mobile nave session
      * for map streaming.
@@ -470,29 +524,21 @@ class ProtocolHandlerImpl
     MessagesOverNaviMap message_over_navi_session_;
 
     /**
-     * \brief Untill specified otherwise, amount of message recievied
-     * over streaming session to send Ack
+     *\brief Services which negotiated payload compression, by
+     *\brief connection and session. Accessed from incoming, outgoing
+     *\brief and transport manager threads.
      */
-    const uint32_t kPeriodForNaviAck;
-
-    /**
-     *\brief Counter of messages sent in each session.
-     */
-    std::map<uint8_t, uint32_t> message_counters_;
-
-    /**
-     *\brief map for session last message.
-     */
-    std::map<uint8_t, uint32_t> sessions_last_message_id_;
-
+    typedef std::map<SessionKey, std::set<uint8_t> > CompressedServices;
+    CompressedServices compressed_services_;
+    sync_primitives::Lock compressed_services_lock_;
 
     class IncomingDataHandler;
     std::auto_ptr<IncomingDataHandler> incoming_data_handler_;
 
-    // Thread that pumps non-parsed messages coming from mobile side.
-    impl::FromMobileQueue raw_ford_messages_from_mobile_;
-    // Thread that pumps messages prepared to being sent to mobile side.
-    impl::ToMobileQueue raw_ford_messages_to_mobile_;
+    /**
+     *\brief Connection shards, their number is set in profile
+     */
+    std::vector<ConnectionShard*> shards_;
 };
 }  // namespace protocol_handler
 
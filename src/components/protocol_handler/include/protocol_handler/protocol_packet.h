@@ -37,6 +37,7 @@
 #define SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_PROTOCOL_PACKET_H_
 
 #include "utils/macro.h"
+#include "utils/shared_buffer.h"
 
 /**
  *\namespace NsProtocolHandler
@@ -73,6 +74,18 @@ const uint8_t PROTOCOL_VERSION_3 = 0x03;
  */
 const bool COMPRESS_OFF = false;
 
+/**
+ *\brief Constant: flag of payload compressed with LZ4 block format,
+ *\brief set in StartSession and its ACK to negotiate compression of service
+ */
+const bool COMPRESS_ON = true;
+
+/**
+ *\brief Constant: size of original payload size field (big endian)
+ *\brief which precedes compressed block
+ */
+const uint8_t COMPRESSED_DATA_HEADER_SIZE = 4;
+
 /**
  *\brief Constant: Control type of frame used in protocol header.
  */
@@ -443,6 +456,12 @@ class ProtocolPacket {
      */
     uint8_t* data() const;
 
+    /**
+     *\brief Passes ownership of received message string to buffer
+     * without copying it, packet has no data afterwards
+     */
+    utils::SharedBuffer DetachData();
+
     /**
      *\brief Setter for size of multiframe message
      */
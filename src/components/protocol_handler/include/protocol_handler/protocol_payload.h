@@ -38,6 +38,7 @@
 #include <vector>
 
 #include "protocol_handler/rpc_type.h"
+#include "utils/shared_buffer.h"
 
 namespace utils {
 class BitStream;
@@ -60,7 +61,7 @@ struct ProtocolPayloadHeaderV2 {
 struct ProtocolPayloadV2 {
   ProtocolPayloadHeaderV2 header;
   std::string json;
-  std::vector<uint8_t> data;
+  utils::SharedBuffer data;
 };
 
 // Procedures that extract and validate defined protocol structures from
@@ -68,6 +69,10 @@ struct ProtocolPayloadV2 {
 // If error during parsing is detected, bit stream is marked as invalid
 void Extract(utils::BitStream* bs, ProtocolPayloadHeaderV2* headerv2);
 void Extract(utils::BitStream* bs, ProtocolPayloadV2* payload, size_t payload_size);
+// Same as above, but binary data is not copied: it refers to the part of
+// |payload_buffer| the bit stream |bs| is built on
+void Extract(utils::BitStream* bs, ProtocolPayloadV2* payload,
+             const utils::SharedBuffer& payload_buffer);
 
 std::ostream& operator<<(std::ostream& os, const ProtocolPayloadHeaderV2& payload_header);
 std::ostream& operator<<(std::ostream& os, const ProtocolPayloadV2& payload);
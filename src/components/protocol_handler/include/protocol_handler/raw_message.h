@@ -36,8 +36,10 @@
 #ifndef SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_RAW_MESSAGE_H_
 #define SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_RAW_MESSAGE_H_
 
+#include "utils/date_time.h"
 #include "utils/macro.h"
 #include "utils/shared_ptr.h"
+#include "utils/shared_buffer.h"
 #include "protocol_handler/service_type.h"
 #include "protocol_handler/message_priority.h"
 
@@ -66,6 +68,17 @@ class RawMessage {
                uint8_t* data_param, uint32_t dataSize,
                uint8_t type = ServiceType::kRpc);
 
+    /**
+     * \brief Constructor, message shares data with the given buffer
+     * \param connectionKey Identifier of connection within wich message
+     * is transferred
+     * \param protocolVersion Version of protocol of the message
+     * \param data Message payload, bytes are not copied
+     */
+    RawMessage(int32_t connectionKey, uint32_t protocolVersion,
+               const utils::SharedBuffer& data,
+               uint8_t type = ServiceType::kRpc);
+
     /**
      * \brief Destructor
      */
@@ -83,6 +96,12 @@ class RawMessage {
      */
     uint8_t* data() const;
 
+    /**
+     * \brief Getter for message payload buffer, allows to pass
+     * the payload further without copying
+     */
+    const utils::SharedBuffer& buffer() const;
+
     /**
      * \brief Getter for message size
      */
@@ -102,6 +121,13 @@ class RawMessage {
 
     bool IsWaiting() const;
 
+    /**
+     * \brief Time message was created, used for latency statistics
+     */
+    const TimevalStruct& creation_time() const {
+      return creation_time_;
+    }
+
     void set_waiting(bool v);
 
     /*
@@ -119,12 +145,7 @@ class RawMessage {
     /**
      * \brief Message string
      */
-    uint8_t* data_;
-
-    /**
-     * \brief Size of message
-     */
-    uint32_t data_size_;
+    utils::SharedBuffer data_;
 
     /**
      * \brief Version of SmartDeviceLink protocol (currently 1,2)
@@ -150,6 +171,8 @@ class RawMessage {
      */
     bool fully_binary_;
 
+    TimevalStruct creation_time_;
+
     /**
      * \brief Id of connection (for service messages like start/end session)
      *
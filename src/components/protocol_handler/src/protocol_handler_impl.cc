@@ -39,17 +39,17 @@
 #include "protocol_handler/protocol_handler_impl.h"
 
 #include <memory.h>
+#include <sstream>
 
 #include "utils/logger.h"
+#include "utils/latency_statistics.h"
+#include "utils/lz4.h"
 
 #include "connection_handler/connection_handler_impl.h"
 #include "config_profile/profile.h"
 #ifdef MODIFY_FUNCTION_SIGN
 #include <iomanip>
 #endif
-#ifdef OS_ANDROID
-#include <sstream>
-#endif
 
 namespace protocol_handler {
 
@@ -64,6 +64,30 @@ std::string ConvertPacketDataToString(const uint8_t *data,
 
 const size_t kStackSize = 32768;
 
+namespace {
+
+/**
+ * Compresses payload, result is used only if it is smaller than original.
+ */
+bool CompressPayload(const uint8_t* data, uint32_t data_size,
+                     std::vector<uint8_t>* compressed) {
+  utils::lz4::Compress(data, data_size, compressed);
+  if (compressed->size() + COMPRESSED_DATA_HEADER_SIZE >= data_size) {
+    return false;
+  }
+  const uint8_t size_field[COMPRESSED_DATA_HEADER_SIZE] = {
+    static_cast<uint8_t>(data_size >> 24),
+    static_cast<uint8_t>(data_size >> 16),
+    static_cast<uint8_t>(data_size >> 8),
+    static_cast<uint8_t>(data_size)
+  };
+  compressed->insert(compressed->begin(), size_field,
+                     size_field + COMPRESSED_DATA_HEADER_SIZE);
+  return true;
+}
+
+}  // namespace
+
 class ProtocolHandlerImpl::IncomingDataHandler {
  public:
   IncomingDataHandler() : connections_data_() {}
@@ -170,19 +194,24 @@ ProtocolHandlerImpl::ProtocolHandlerImpl(
     : protocol_observers_(),
       session_observer_(0),
       transport_manager_(transport_manager_param),
-      kPeriodForNaviAck(5),
-      incoming_data_handler_(new IncomingDataHandler),
-      raw_ford_messages_from_mobile_("MessagesFromMobileAppHandler", this,
-                                     threads::ThreadOptions(kStackSize)),
-      raw_ford_messages_to_mobile_("MessagesToMobileAppHandler", this,
-                                   threads::ThreadOptions(kStackSize))
-#ifdef TIME_TESTER
-      , metric_observer_(NULL)
-#endif  // TIME_TESTER
-
-{
+      incoming_data_handler_(new IncomingDataHandler) {
   LOG4CXX_TRACE_ENTER(logger_);
 
+  uint32_t shards_count =
+      profile::Profile::instance()->protocol_handler_shards();
+  if (0 == shards_count) {
+    shards_count = 1;
+  }
+  LOG4CXX_INFO(logger_, "Connections are handled by " << shards_count
+               << " shards");
+  for (uint32_t i = 0; i < shards_count; ++i) {
+    std::stringstream name_suffix;
+    if (i > 0) {
+      name_suffix << i;
+    }
+    shards_.push_back(new ConnectionShard(name_suffix.str(), this));
+  }
+
   LOG4CXX_TRACE_EXIT(logger_);
 }
 
@@ -191,6 +220,27 @@ ProtocolHandlerImpl::~ProtocolHandlerImpl() {
     LOG4CXX_WARN(logger_, "Not all observers have unsubscribed"
                  " from ProtocolHandlerImpl");
   }
+  // Stopping of threads drains queues, handlers still use this object
+  for (std::vector<ConnectionShard*>::iterator it = shards_.begin();
+       shards_.end() != it; ++it) {
+    delete *it;
+  }
+  shards_.clear();
+}
+
+ProtocolHandlerImpl::ConnectionShard::ConnectionShard(
+    const std::string& name_suffix, ProtocolHandlerImpl* handler)
+    : raw_ford_messages_to_mobile("MessagesToMobileAppHandler" + name_suffix,
+                                  handler,
+                                  threads::ThreadOptions(kStackSize)),
+      raw_ford_messages_from_mobile(
+          "MessagesFromMobileAppHandler" + name_suffix, handler,
+          threads::ThreadOptions(kStackSize)) {
+}
+
+ProtocolHandlerImpl::ConnectionShard& ProtocolHandlerImpl::ShardForConnection(
+    ConnectionID connection_id) {
+  return *shards_[connection_id % shards_.size()];
 }
 
 void ProtocolHandlerImpl::AddProtocolObserver(ProtocolObserver* observer) {
@@ -219,12 +269,17 @@ void ProtocolHandlerImpl::SendStartSessionAck(ConnectionID connection_id,
                                               uint8_t session_id,
                                               uint8_t protocol_version,
                                               uint32_t hash_code,
-                                              uint8_t service_type) {
+                                              uint8_t service_type,
+                                              bool compress) {
   LOG4CXX_TRACE_ENTER(logger_);
 
   uint8_t protocolVersion;
 
-  if (0 == profile::Profile::instance()->heart_beat_timeout()) {
+  if (compress) {
+    // Compression flag is defined by protocol v3 only
+    protocolVersion = PROTOCOL_VERSION_3;
+    LOG4CXX_INFO(logger_, "Compression accepted => SET PROTOCOL_VERSION_3");
+  } else if (0 == profile::Profile::instance()->heart_beat_timeout()) {
     protocolVersion = PROTOCOL_VERSION_2;
     LOG4CXX_INFO(logger_, "Heart beat timeout == 0 => SET PROTOCOL_VERSION_2");
   } else {
@@ -233,11 +288,11 @@ void ProtocolHandlerImpl::SendStartSessionAck(ConnectionID connection_id,
   }
 
   ProtocolFramePtr ptr(new protocol_handler::ProtocolPacket(connection_id,
-    protocolVersion, COMPRESS_OFF, FRAME_TYPE_CONTROL,
+    protocolVersion, compress, FRAME_TYPE_CONTROL,
     service_type, FRAME_DATA_START_SERVICE_ACK, session_id,
     0, hash_code));
 
-  raw_ford_messages_to_mobile_.PostMessage(
+  ShardForConnection(connection_id).raw_ford_messages_to_mobile.PostMessage(
       impl::RawFordMessageToMobile(ptr, false));
 
   LOG4CXX_INFO(logger_,
@@ -259,7 +314,7 @@ void ProtocolHandlerImpl::SendStartSessionNAck(ConnectionID connection_id,
       service_type, FRAME_DATA_START_SERVICE_NACK,
       session_id, 0, 0));
 
-  raw_ford_messages_to_mobile_.PostMessage(
+  ShardForConnection(connection_id).raw_ford_messages_to_mobile.PostMessage(
       impl::RawFordMessageToMobile(ptr, false));
 
   LOG4CXX_INFO(logger_,
@@ -281,7 +336,7 @@ void ProtocolHandlerImpl::SendEndSessionNAck(ConnectionID connection_id,
       service_type, FRAME_DATA_END_SERVICE_NACK,
       session_id, 0, 0));
 
-  raw_ford_messages_to_mobile_.PostMessage(
+  ShardForConnection(connection_id).raw_ford_messages_to_mobile.PostMessage(
       impl::RawFordMessageToMobile(ptr, false));
 
   LOG4CXX_INFO(logger_, "SendEndSessionNAck() for connection " << connection_id
@@ -303,7 +358,7 @@ void ProtocolHandlerImpl::SendEndSessionAck(ConnectionID connection_id,
       service_type, FRAME_DATA_END_SERVICE_ACK, session_id, 0,
       hash_code));
 
-  raw_ford_messages_to_mobile_.PostMessage(
+  ShardForConnection(connection_id).raw_ford_messages_to_mobile.PostMessage(
       impl::RawFordMessageToMobile(ptr, false));
 
   LOG4CXX_INFO(logger_,
@@ -325,7 +380,7 @@ void ProtocolHandlerImpl::SendEndSession(int32_t connection_id,
       SERVICE_TYPE_RPC, FRAME_DATA_END_SERVICE, session_id, 0,
       session_observer_->KeyFromPair(connection_id, session_id)));
 
-  raw_ford_messages_to_mobile_.PostMessage(
+  ShardForConnection(connection_id).raw_ford_messages_to_mobile.PostMessage(
       impl::RawFordMessageToMobile(ptr, false));
 
   LOG4CXX_INFO(logger_, "SendEndSession() for connection " << connection_id
@@ -345,7 +400,7 @@ RESULT_CODE ProtocolHandlerImpl::SendHeartBeatAck(ConnectionID connection_id,
       SERVICE_TYPE_ZERO, FRAME_DATA_HEART_BEAT_ACK, session_id,
       0, message_id));
 
-  raw_ford_messages_to_mobile_.PostMessage(
+  ShardForConnection(connection_id).raw_ford_messages_to_mobile.PostMessage(
       impl::RawFordMessageToMobile(ptr, false));
 
   LOG4CXX_TRACE_EXIT(logger_);
@@ -361,7 +416,7 @@ void ProtocolHandlerImpl::SendHeartBeat(int32_t connection_id,
       SERVICE_TYPE_ZERO, FRAME_DATA_HEART_BEAT, session_id,
       0, 0));
 
-  raw_ford_messages_to_mobile_.PostMessage(
+  ShardForConnection(connection_id).raw_ford_messages_to_mobile.PostMessage(
       impl::RawFordMessageToMobile(ptr, false));
 
   LOG4CXX_TRACE_EXIT(logger_);
@@ -396,12 +451,26 @@ void ProtocolHandlerImpl::SendMessageToMobileApp(const RawMessagePtr& message,
   session_observer_->PairFromKey(message->connection_key(), &connection_handle,
                                  &sessionID);
 
-  if (message->data_size() <= maxDataSize) {
+  const uint8_t* data = message->data();
+  uint32_t data_size = message->data_size();
+  bool compress = false;
+  std::vector<uint8_t> compressed;
+  if (message->protocol_version() >= PROTOCOL_VERSION_3 &&
+      data_size >= profile::Profile::instance()->payload_compression_threshold() &&
+      IsCompressionNegotiated(connection_handle, sessionID, SERVICE_TYPE_RPC) &&
+      CompressPayload(data, data_size, &compressed)) {
+    LOG4CXX_INFO(logger_, "Payload of size " << data_size
+                 << " is compressed to " << compressed.size());
+    data = &compressed[0];
+    data_size = compressed.size();
+    compress = true;
+  }
+
+  if (data_size <= maxDataSize) {
     RESULT_CODE result = SendSingleFrameMessage(connection_handle, sessionID,
                                                 message->protocol_version(),
                                                 SERVICE_TYPE_RPC,
-                                                message->data_size(),
-                                                message->data(), false,
+                                                data_size, data, compress,
                                                 final_message);
     if (result != RESULT_OK) {
       LOG4CXX_ERROR(logger_,
@@ -415,8 +484,7 @@ void ProtocolHandlerImpl::SendMessageToMobileApp(const RawMessagePtr& message,
     RESULT_CODE result = SendMultiFrameMessage(connection_handle, sessionID,
                                                message->protocol_version(),
                                                SERVICE_TYPE_RPC,
-                                               message->data_size(),
-                                               message->data(), false,
+                                               data_size, data, compress,
                                                maxDataSize, final_message);
     if (result != RESULT_OK) {
       LOG4CXX_ERROR(logger_,
@@ -457,14 +525,11 @@ void ProtocolHandlerImpl::OnTMMessageReceived(const RawMessagePtr tm_message) {
            protocol_frames.begin();
        it != protocol_frames.end(); ++it) {
     impl::RawFordMessageFromMobile msg(*it);
-#ifdef TIME_TESTER
-    if (metric_observer_) {
-      metric_observer_->StartMessageProcess(msg->message_id());
-    }
-#endif  // TIME_TESTER
-
-    raw_ford_messages_from_mobile_.PostMessage(msg);
+    ShardForConnection(tm_message->connection_key())
+        .raw_ford_messages_from_mobile.PostMessage(msg);
   }
+  utils::LatencyStatistics::instance()->Record(
+    utils::LatencyStatistics::kTransportReceive, tm_message->creation_time());
   LOG4CXX_TRACE_EXIT(logger_);
 }
 
@@ -490,12 +555,22 @@ void ProtocolHandlerImpl::OnTMMessageSend(const RawMessagePtr message) {
                                     message->data(),
                                     message->data_size());
 
-  std::map<uint8_t, uint32_t>::iterator it =
-      sessions_last_message_id_.find(sent_message.session_id());
+  ConnectionShard& shard = ShardForConnection(message->connection_key());
+  bool is_last_message = false;
+  uint32_t last_message_id = 0;
+  {
+    sync_primitives::AutoLock lock(shard.messages_lock);
+    std::map<SessionKey, uint32_t>::iterator it =
+        shard.sessions_last_message_id.find(SessionKey(
+            message->connection_key(), sent_message.session_id()));
+    if (shard.sessions_last_message_id.end() != it) {
+      is_last_message = true;
+      last_message_id = it->second;
+      shard.sessions_last_message_id.erase(it);
+    }
+  }
 
-  if (sessions_last_message_id_.end() != it) {
-    uint32_t last_message_id = it->second;
-    sessions_last_message_id_.erase(it);
+  if (is_last_message) {
     if ((sent_message.message_id() ==  last_message_id) &&
         ((FRAME_TYPE_SINGLE == sent_message.frame_type()) ||
         ((FRAME_TYPE_CONSECUTIVE == sent_message.frame_type()) &&
@@ -531,6 +606,13 @@ void ProtocolHandlerImpl::OnConnectionEstablished(
 void ProtocolHandlerImpl::OnConnectionClosed(
     const transport_manager::ConnectionUID& connection_id) {
   incoming_data_handler_->RemoveConnection(connection_id);
+
+  sync_primitives::AutoLock lock(compressed_services_lock_);
+  CompressedServices::iterator it = compressed_services_.lower_bound(
+      std::make_pair(connection_id, static_cast<uint8_t>(0)));
+  while (compressed_services_.end() != it && connection_id == it->first.first) {
+    compressed_services_.erase(it++);
+  }
 }
 
 RESULT_CODE ProtocolHandlerImpl::SendFrame(ConnectionID connection_id,
@@ -584,11 +666,16 @@ RESULT_CODE ProtocolHandlerImpl::SendSingleFrameMessage(
     const bool is_final_message) {
   LOG4CXX_TRACE_ENTER(logger_);
 
+  ConnectionShard& shard = ShardForConnection(connection_id);
+  sync_primitives::AutoLock lock(shard.messages_lock);
+  uint32_t& message_counter =
+      shard.message_counters[SessionKey(connection_id, session_id)];
+
   ProtocolFramePtr ptr(new protocol_handler::ProtocolPacket(connection_id,
       protocol_version, compress, FRAME_TYPE_SINGLE, service_type, 0,
-      session_id, data_size, message_counters_[session_id]++, data));
+      session_id, data_size, message_counter++, data));
 
-  raw_ford_messages_to_mobile_.PostMessage(
+  shard.raw_ford_messages_to_mobile.PostMessage(
       impl::RawFordMessageToMobile(ptr, is_final_message));
 
   LOG4CXX_TRACE_EXIT(logger_);
@@ -633,9 +720,14 @@ RESULT_CODE ProtocolHandlerImpl::SendMultiFrameMessage(
   outDataFirstFrame[6] = numOfFrames >> 8;
   outDataFirstFrame[7] = numOfFrames;
 
+  ConnectionShard& shard = ShardForConnection(connection_id);
+  sync_primitives::AutoLock lock(shard.messages_lock);
+  uint32_t& message_counter =
+      shard.message_counters[SessionKey(connection_id, session_id)];
+
   ProtocolFramePtr firstPacket(new protocol_handler::ProtocolPacket(connection_id,
       protocol_version, compress, FRAME_TYPE_FIRST, service_type, 0,
-      session_id, FIRST_FRAME_DATA_SIZE, ++message_counters_[session_id],
+      session_id, FIRST_FRAME_DATA_SIZE, ++message_counter,
       outDataFirstFrame));
 
 #ifdef MODIFY_FUNCTION_SIGN
@@ -645,7 +737,7 @@ RESULT_CODE ProtocolHandlerImpl::SendMultiFrameMessage(
   }
 #endif
 
-  raw_ford_messages_to_mobile_.PostMessage(
+  shard.raw_ford_messages_to_mobile.PostMessage(
       impl::RawFordMessageToMobile(firstPacket, false));
   LOG4CXX_INFO_EXT(logger_, "First frame is sent.");
 
@@ -657,9 +749,9 @@ RESULT_CODE ProtocolHandlerImpl::SendMultiFrameMessage(
       ProtocolFramePtr ptr(new protocol_handler::ProtocolPacket(connection_id,
           protocol_version, compress, FRAME_TYPE_CONSECUTIVE,
           service_type, ((i % FRAME_DATA_MAX_VALUE) + 1), session_id,
-          maxdata_size, message_counters_[session_id], outDataFrame));
+          maxdata_size, message_counter, outDataFrame));
 
-      raw_ford_messages_to_mobile_.PostMessage(
+      shard.raw_ford_messages_to_mobile.PostMessage(
           impl::RawFordMessageToMobile(ptr, false));
 
     } else {
@@ -668,9 +760,9 @@ RESULT_CODE ProtocolHandlerImpl::SendMultiFrameMessage(
       ProtocolFramePtr ptr(new protocol_handler::ProtocolPacket(connection_id,
           protocol_version, compress, FRAME_TYPE_CONSECUTIVE,
           service_type, 0x0, session_id, lastdata_size,
-          message_counters_[session_id], outDataFrame));
+          message_counter, outDataFrame));
 
-      raw_ford_messages_to_mobile_.PostMessage(
+      shard.raw_ford_messages_to_mobile.PostMessage(
           impl::RawFordMessageToMobile(ptr, is_final_message));
     }
   }
@@ -714,18 +806,16 @@ RESULT_CODE ProtocolHandlerImpl::HandleMessage(ConnectionID connection_id,
       int32_t connection_key = session_observer_->KeyFromPair(
           connection_id, packet->session_id());
 
-      RawMessagePtr raw_message(
-          new RawMessage(connection_key, packet->protocol_version(), packet->data(),
-                         packet->data_size(), packet->service_type()));
-#ifdef TIME_TESTER
-      if (metric_observer_) {
-        PHMetricObserver::MessageMetric* metric = new PHMetricObserver::MessageMetric();
-        metric->message_id = packet->message_id();
-        metric->connection_key = connection_key;
-        metric->raw_msg = raw_message;
-        metric_observer_->EndMessageProcess(metric);
+      utils::SharedBuffer payload = packet->DetachData();
+      if (packet->is_compress() &&
+          !DecompressPayload(connection_id, *packet, &payload)) {
+        LOG4CXX_TRACE_EXIT(logger_);
+        return RESULT_FAIL;
       }
-#endif
+
+      RawMessagePtr raw_message(
+          new RawMessage(connection_key, packet->protocol_version(),
+                         payload, packet->service_type()));
       NotifySubscribers(raw_message);
       break;
     }
@@ -762,17 +852,18 @@ RESULT_CODE ProtocolHandlerImpl::HandleMultiFrameMessage(
       logger_,
       "Packet " << packet << "; session id " << static_cast<int32_t>(key));
 
+  ConnectionShard& shard = ShardForConnection(connection_id);
   if (packet->frame_type() == FRAME_TYPE_FIRST) {
     LOG4CXX_INFO(logger_, "handleMultiFrameMessage() - FRAME_TYPE_FIRST "
                  << packet->data_size());
-    incomplete_multi_frame_messages_[key] = packet;
+    shard.incomplete_multi_frame_messages[key] = packet;
   } else {
     LOG4CXX_INFO(logger_, "handleMultiFrameMessage() - Consecutive frame");
 
     std::map<int32_t, ProtocolFramePtr>::iterator it =
-        incomplete_multi_frame_messages_.find(key);
+        shard.incomplete_multi_frame_messages.find(key);
 
-    if (it == incomplete_multi_frame_messages_.end()) {
+    if (it == shard.incomplete_multi_frame_messages.end()) {
       LOG4CXX_ERROR(
           logger_, "Frame of multiframe message for non-existing session id");
 
@@ -806,19 +897,20 @@ RESULT_CODE ProtocolHandlerImpl::HandleMultiFrameMessage(
       }
 
       ProtocolPacket* completePacket = it->second.get();
-      RawMessagePtr rawMessage (new RawMessage(
-          key, completePacket->protocol_version(), completePacket->data(),
-          completePacket->total_data_bytes(), completePacket->service_type()));
-#ifdef TIME_TESTER
-      if (metric_observer_) {
-        PHMetricObserver::MessageMetric* metric = new PHMetricObserver::MessageMetric();
-        metric->raw_msg = rawMessage;
-        metric_observer_->EndMessageProcess(metric);
+      utils::SharedBuffer payload = completePacket->DetachData();
+      if (completePacket->is_compress() &&
+          !DecompressPayload(connection_id, *completePacket, &payload)) {
+        shard.incomplete_multi_frame_messages.erase(it);
+        LOG4CXX_TRACE_EXIT(logger_);
+        return RESULT_FAIL;
       }
-#endif // TIME_TESTER
+
+      RawMessagePtr rawMessage (new RawMessage(
+          key, completePacket->protocol_version(),
+          payload, completePacket->service_type()));
       NotifySubscribers(rawMessage);
 
-      incomplete_multi_frame_messages_.erase(it);
+      shard.incomplete_multi_frame_messages.erase(it);
     }
   }
 
@@ -892,7 +984,22 @@ RESULT_CODE ProtocolHandlerImpl::HandleControlMessageEndSession(
         connection_id, current_session_id, packet.protocol_version(),
         session_observer_->KeyFromPair(connection_id, current_session_id),
         packet.service_type());
-    message_counters_.erase(current_session_id);
+    ConnectionShard& shard = ShardForConnection(connection_id);
+    {
+      sync_primitives::AutoLock lock(shard.messages_lock);
+      shard.message_counters.erase(
+          SessionKey(connection_id, current_session_id));
+    }
+
+    sync_primitives::AutoLock lock(compressed_services_lock_);
+    CompressedServices::iterator it = compressed_services_.find(
+        std::make_pair(connection_id, current_session_id));
+    if (compressed_services_.end() != it) {
+      it->second.erase(packet.service_type());
+      if (SERVICE_TYPE_RPC == packet.service_type() || it->second.empty()) {
+        compressed_services_.erase(it);
+      }
+    }
   } else {
     LOG4CXX_INFO_EXT(
         logger_,
@@ -915,10 +1022,24 @@ RESULT_CODE ProtocolHandlerImpl::HandleControlMessageStartSession(
       ServiceTypeFromByte(packet.service_type()));
 
   if (-1 != session_id) {
+    // Compression is accepted only for RPC service of protocol v3, since
+    // only RPC payloads are sent compressed. ACK has the same flag then
+    const bool compress = packet.is_compress() &&
+        packet.protocol_version() >= PROTOCOL_VERSION_3 &&
+        profile::Profile::instance()->payload_compression() &&
+        SERVICE_TYPE_RPC == packet.service_type();
+    if (compress) {
+      LOG4CXX_INFO(logger_, "Payload compression is negotiated for service "
+                   << static_cast<int32_t>(packet.service_type()));
+      sync_primitives::AutoLock lock(compressed_services_lock_);
+      compressed_services_[std::make_pair(
+          connection_id, static_cast<uint8_t>(session_id))].insert(
+              packet.service_type());
+    }
     SendStartSessionAck(
         connection_id, session_id, packet.protocol_version(),
         session_observer_->KeyFromPair(connection_id, session_id),
-        packet.service_type());
+        packet.service_type(), compress);
   } else {
     LOG4CXX_INFO_EXT(
         logger_,
@@ -931,6 +1052,54 @@ RESULT_CODE ProtocolHandlerImpl::HandleControlMessageStartSession(
   return RESULT_OK;
 }
 
+bool ProtocolHandlerImpl::IsCompressionNegotiated(ConnectionID connection_id,
+                                                  uint8_t session_id,
+                                                  uint8_t service_type) {
+  sync_primitives::AutoLock lock(compressed_services_lock_);
+  CompressedServices::const_iterator it = compressed_services_.find(
+      std::make_pair(connection_id, session_id));
+  return compressed_services_.end() != it &&
+         it->second.end() != it->second.find(service_type);
+}
+
+bool ProtocolHandlerImpl::DecompressPayload(ConnectionID connection_id,
+                                            const ProtocolPacket& packet,
+                                            utils::SharedBuffer* payload) {
+  if (!IsCompressionNegotiated(connection_id, packet.session_id(),
+                               packet.service_type())) {
+    LOG4CXX_ERROR(logger_, "Compressed payload of service "
+                  << static_cast<int32_t>(packet.service_type())
+                  << " without negotiated compression");
+    return false;
+  }
+
+  const uint8_t* data = payload->data();
+  const size_t size = payload->size();
+  if (size < COMPRESSED_DATA_HEADER_SIZE) {
+    LOG4CXX_ERROR(logger_, "Compressed payload is too short");
+    return false;
+  }
+  const uint32_t original_size =
+      (static_cast<uint32_t>(data[0]) << 24) | (data[1] << 16) |
+      (data[2] << 8) | data[3];
+  const size_t block_size = size - COMPRESSED_DATA_HEADER_SIZE;
+  // LZ4 can not expand data more than 255 times
+  if (original_size / 255 > block_size) {
+    LOG4CXX_ERROR(logger_, "Invalid size " << original_size
+                  << " of compressed payload");
+    return false;
+  }
+
+  std::vector<uint8_t> original;
+  if (!utils::lz4::Decompress(data + COMPRESSED_DATA_HEADER_SIZE, block_size,
+                              original_size, &original)) {
+    LOG4CXX_ERROR(logger_, "Failed to decompress payload of size " << size);
+    return false;
+  }
+  *payload = utils::SharedBuffer::Adopt(&original);
+  return true;
+}
+
 RESULT_CODE ProtocolHandlerImpl::HandleControlMessageHeartBeat(
     ConnectionID connection_id, const ProtocolPacket& packet) {
   LOG4CXX_INFO(
@@ -970,9 +1139,11 @@ void ProtocolHandlerImpl::Handle(const impl::RawFordMessageToMobile& message) {
       " protocolVersion " << message->protocol_version());
 
   if (message.is_final) {
-    sessions_last_message_id_.insert(
-        std::pair<uint8_t, uint32_t>(message->session_id(),
-                                     message->message_id()));
+    ConnectionShard& shard = ShardForConnection(message->connection_key());
+    sync_primitives::AutoLock lock(shard.messages_lock);
+    shard.sessions_last_message_id.insert(std::make_pair(
+        SessionKey(message->connection_key(), message->session_id()),
+        message->message_id()));
   }
 
   SendFrame(message->connection_key(), (*message.get()));
@@ -991,16 +1162,10 @@ void ProtocolHandlerImpl::SendFramesNumber(int32_t connection_key,
       SERVICE_TYPE_NAVI, FRAME_DATA_SERVICE_DATA_ACK,
       session_id, 0, number_of_frames));
 
-  raw_ford_messages_to_mobile_.PostMessage(
+  ShardForConnection(connection_id).raw_ford_messages_to_mobile.PostMessage(
         impl::RawFordMessageToMobile(ptr, false));
 }
 
-#ifdef TIME_TESTER
-void ProtocolHandlerImpl::SetTimeMetricObserver(PHMetricObserver* observer) {
-  metric_observer_ = observer;
-}
-#endif  // TIME_TESTER
-
 
 std::string ConvertPacketDataToString(const uint8_t* data,
                                       const std::size_t data_size) {
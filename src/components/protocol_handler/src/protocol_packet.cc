@@ -300,6 +300,14 @@ uint8_t* ProtocolPacket::data() const {
   return packet_data_.data;
 }
 
+utils::SharedBuffer ProtocolPacket::DetachData() {
+  utils::SharedBuffer buffer =
+      utils::SharedBuffer::Adopt(packet_data_.data, data_offset_);
+  packet_data_.data = 0;
+  data_offset_ = 0;
+  return buffer;
+}
+
 void ProtocolPacket::set_total_data_bytes(uint32_t dataBytes) {
   if (dataBytes) {
     if (packet_data_.data) {
@@ -76,7 +76,29 @@ void Extract(utils::BitStream* bs, ProtocolPayloadV2* payload,
     size_t data_size = payload_size - payload->header.json_size -
         PayloadHeaderBits / CHAR_BIT;
     DCHECK(data_size < payload_size);
-    utils::Extract(bs, &payload->data, data_size);
+    std::vector<uint8_t> data;
+    utils::Extract(bs, &data, data_size);
+    payload->data = utils::SharedBuffer::Adopt(&data);
+  }
+}
+
+void Extract(utils::BitStream* bs, ProtocolPayloadV2* payload,
+             const utils::SharedBuffer& payload_buffer) {
+  DCHECK(bs && payload);
+  if (*bs) {
+    Extract(bs, &payload->header);
+    utils::Extract(bs, &payload->json, payload->header.json_size);
+    if (bs->IsBad()) {
+      return;
+    }
+    const size_t data_offset =
+        PayloadHeaderBits / CHAR_BIT + payload->header.json_size;
+    if (data_offset > payload_buffer.size()) {
+      bs->MarkBad();
+      return;
+    }
+    payload->data = payload_buffer.Slice(
+        data_offset, payload_buffer.size() - data_offset);
   }
 }
 
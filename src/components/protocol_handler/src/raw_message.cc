@@ -46,26 +46,27 @@ RawMessage::RawMessage(int32_t connectionKey, uint32_t protocolVersion,
                        uint8_t* data_param, uint32_t data_sz,
                        uint8_t type)
   : connection_key_(connectionKey),
+    data_(data_param, data_sz),
     protocol_version_(protocolVersion),
     service_type_(ServiceTypeFromByte(type)),
     waiting_(false),
     fully_binary_(false),
-    data_size_(data_sz) {
-  if (data_sz > 0) {
-    data_ = new uint8_t[data_sz];
-    for (uint32_t i = 0; i < data_sz; ++i) {
-      data_[i] = data_param[i];
-    }
-  } else {
-    data_ = 0;
-  }
+    creation_time_(date_time::DateTime::getCurrentTime()) {
+}
+
+RawMessage::RawMessage(int32_t connectionKey, uint32_t protocolVersion,
+                       const utils::SharedBuffer& data,
+                       uint8_t type)
+  : connection_key_(connectionKey),
+    data_(data),
+    protocol_version_(protocolVersion),
+    service_type_(ServiceTypeFromByte(type)),
+    waiting_(false),
+    fully_binary_(false),
+    creation_time_(date_time::DateTime::getCurrentTime()) {
 }
 
 RawMessage::~RawMessage() {
-  if (data_) {
-    delete[] data_;
-    data_ = 0;
-  }
 }
 
 int32_t RawMessage::connection_key() const {
@@ -77,11 +78,16 @@ void RawMessage::set_connection_key(uint32_t key) {
 }
 
 uint8_t* RawMessage::data() const {
+  // Payload is shared with other messages and must not be modified
+  return const_cast<uint8_t*>(data_.data());
+}
+
+const utils::SharedBuffer& RawMessage::buffer() const {
   return data_;
 }
 
 uint32_t RawMessage::data_size() const {
-  return data_size_;
+  return data_.size();
 }
 
 uint32_t RawMessage::protocol_version() const {
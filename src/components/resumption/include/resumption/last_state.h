@@ -34,29 +34,81 @@
 #define SRC_COMPONENTS_RESUMPTION_INCLUDE_RESUMPTION_LAST_STATE_H_
 
 #include <string>
+#include <vector>
 
 #include "utils/macro.h"
+#include "utils/lock.h"
 #include "utils/singleton.h"
 #include "json/json.h"
 
 namespace resumption {
 
+/**
+ * @brief Persistent storage of SDL state between ignition cycles.
+ *
+ * State is kept as snapshot file with journal of later changes next to it.
+ * Changes made through SetValue/RemoveValue are appended to the journal
+ * immediately, so they survive abrupt shutdown. Journal is folded into
+ * snapshot on startup, on shutdown and when it grows too long.
+ * Dictionary is accessed from different threads, so it is read only
+ * as copy through GetValue.
+ */
 class LastState : public utils::Singleton<LastState> {
  public:
 /**
- * @brief public dictionary
+ * @brief Chain of member names leading to value in dictionary
  */
-  Json::Value dictionary;
+  typedef std::vector<std::string> Path;
 
- private:
 /**
- * @brief Saving dictionary to filesystem
+ * @brief Get copy of value in dictionary
+ * @param path chain of member names
+ * @return value or null value if there is no such member
  */
-  void SaveToFileSystem();
+  Json::Value GetValue(const Path& path) const;
+/**
+ * @brief Set value in dictionary and record change in journal
+ * @param path chain of member names, missing members are created
+ * @param value new value
+ */
+  void SetValue(const Path& path, const Json::Value& value);
+/**
+ * @brief Remove value from dictionary and record change in journal
+ * @param path chain of member names
+ */
+  void RemoveValue(const Path& path);
+/**
+ * @brief Save whole dictionary as snapshot and drop journal
+ */
+  void Compact();
+
+ private:
 /**
  * @brief Load dictionary from filesystem
  */
   void LoadFromFileSystem();
+/**
+ * @brief Apply journal records to dictionary one by one
+ * @return number of applied records
+ */
+  uint32_t ReplayJournal();
+/**
+ * @brief Apply single journal record to dictionary
+ * @return false if record is malformed
+ */
+  bool ApplyRecord(const Json::Value& record);
+/**
+ * @brief Append record to journal, compact if journal became too long
+ */
+  void AppendToJournal(const Json::Value& record);
+/**
+ * @brief Write snapshot of dictionary and remove journal
+ */
+  void SaveToFileSystem();
+/**
+ * @brief Path to journal file
+ */
+  std::string journal_file() const;
 /**
  * @brief Private default constructor
  */
@@ -66,6 +118,17 @@ class LastState : public utils::Singleton<LastState> {
  */
   ~LastState();
 
+/**
+ * @brief Count of journal records which triggers compaction
+ */
+  static const uint32_t kMaxJournalRecords = 512;
+
+  Json::Value dictionary_;
+  uint32_t journal_records_;
+/**
+ * @brief Guards dictionary, journal and snapshot files
+ */
+  mutable sync_primitives::Lock state_lock_;
 
   DISALLOW_COPY_AND_ASSIGN(LastState);
 
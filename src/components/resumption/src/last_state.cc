@@ -33,6 +33,9 @@
 #include <global_first.h>
 #endif
 #include "resumption/last_state.h"
+
+#include <fstream>
+
 #include "config_profile/profile.h"
 #include "utils/file_system.h"
 #include "utils/logger.h"
@@ -41,34 +44,226 @@ namespace resumption {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "LastState");
 
+namespace {
+
+const char kSetRecord[] = "set";
+const char kRemoveRecord[] = "remove";
+const char kValue[] = "value";
+
+Json::Value PathToJson(const LastState::Path& path) {
+  Json::Value result(Json::arrayValue);
+  for (LastState::Path::const_iterator it = path.begin();
+       it != path.end(); ++it) {
+    result.append(*it);
+  }
+  return result;
+}
+
+bool PathFromJson(const Json::Value& json, LastState::Path* path) {
+  if (!json.isArray() || json.empty()) {
+    return false;
+  }
+  for (Json::Value::const_iterator it = json.begin(); it != json.end(); ++it) {
+    if (!(*it).isString()) {
+      return false;
+    }
+    path->push_back((*it).asString());
+  }
+  return true;
+}
+
+void SetNode(Json::Value* root, const LastState::Path& path,
+             const Json::Value& value) {
+  Json::Value* node = root;
+  for (LastState::Path::const_iterator it = path.begin();
+       it != path.end(); ++it) {
+    if (!node->isObject()) {
+      *node = Json::Value(Json::objectValue);
+    }
+    node = &(*node)[*it];
+  }
+  *node = value;
+}
+
+void RemoveNode(Json::Value* root, const LastState::Path& path) {
+  Json::Value* node = root;
+  for (size_t i = 0; i + 1 < path.size(); ++i) {
+    if (!node->isObject() || !node->isMember(path[i])) {
+      return;
+    }
+    node = &(*node)[path[i]];
+  }
+  if (node->isObject()) {
+    node->removeMember(path.back());
+  }
+}
+
+}  // namespace
+
+void LastState::SetValue(const Path& path, const Json::Value& value) {
+  DCHECK(!path.empty());
+  sync_primitives::AutoLock lock(state_lock_);
+  SetNode(&dictionary_, path, value);
+
+  Json::Value record;
+  record[kSetRecord] = PathToJson(path);
+  record[kValue] = value;
+  AppendToJournal(record);
+}
+
+void LastState::RemoveValue(const Path& path) {
+  DCHECK(!path.empty());
+  sync_primitives::AutoLock lock(state_lock_);
+  RemoveNode(&dictionary_, path);
+
+  Json::Value record;
+  record[kRemoveRecord] = PathToJson(path);
+  AppendToJournal(record);
+}
+
+Json::Value LastState::GetValue(const Path& path) const {
+  sync_primitives::AutoLock lock(state_lock_);
+  const Json::Value* node = &dictionary_;
+  for (Path::const_iterator it = path.begin(); it != path.end(); ++it) {
+    if (!node->isObject() || !node->isMember(*it)) {
+      return Json::Value();
+    }
+    node = &(*node)[*it];
+  }
+  return *node;
+}
+
+void LastState::Compact() {
+  sync_primitives::AutoLock lock(state_lock_);
+  SaveToFileSystem();
+}
+
+void LastState::AppendToJournal(const Json::Value& record) {
+  // FastWriter puts whole record on single line
+  Json::FastWriter writer;
+  const std::string& str = writer.write(record);
+  if (!file_system::Append(journal_file(),
+                           reinterpret_cast<const uint8_t*>(str.c_str()),
+                           str.size(), true)) {
+    LOG4CXX_ERROR(logger_, "Unable to write last state journal");
+    SaveToFileSystem();
+    return;
+  }
+  if (++journal_records_ >= kMaxJournalRecords) {
+    SaveToFileSystem();
+  }
+}
+
 void LastState::SaveToFileSystem() {
   const std::string file =
       profile::Profile::instance()->app_info_storage();
-  const std::string& str = dictionary.toStyledString();
-  const std::vector<uint8_t> char_vector_pdata(
-    str.begin(), str.end());
-  DCHECK(file_system::Write(file, char_vector_pdata));
+  const std::string temp_file = file + ".tmp";
+  const std::string& str = dictionary_.toStyledString();
+
+  // Snapshot replaces old one only when completely written, so interrupted
+  // save leaves previous snapshot and journal untouched
+  file_system::DeleteFile(temp_file);
+  if (!file_system::Append(temp_file,
+                           reinterpret_cast<const uint8_t*>(str.c_str()),
+                           str.size(), true) ||
+      !file_system::RenameFile(temp_file, file)) {
+    LOG4CXX_ERROR(logger_, "Unable to save last state to " << file);
+    return;
+  }
+  // Records are absolute, so replaying journal left by crash right here
+  // over the new snapshot gives the same state
+  file_system::DeleteFile(journal_file());
+  journal_records_ = 0;
 }
 
 void LastState::LoadFromFileSystem() {
   const std::string file =
       profile::Profile::instance()->app_info_storage();
+  const std::string temp_file = file + ".tmp";
+  // Where rename deletes old snapshot first, save interrupted right after
+  // that leaves only new snapshot, which is complete once it is renamed
+  if (!file_system::FileExists(file) && file_system::FileExists(temp_file)) {
+    LOG4CXX_WARN(logger_, "Last state is restored from " << temp_file);
+    file_system::RenameFile(temp_file, file);
+  }
   std::string buffer;
   bool result = file_system::ReadFile(file, buffer);
   Json::Reader m_reader;
-  if (result && m_reader.parse(buffer, dictionary)) {
+  if (result && m_reader.parse(buffer, dictionary_)) {
     LOG4CXX_INFO(logger_, "Valid last state was found.");
-    return;
+  } else {
+    LOG4CXX_WARN(logger_, "No valid last state was found.");
+  }
+
+  const uint32_t replayed = ReplayJournal();
+  if (replayed) {
+    LOG4CXX_INFO(logger_, replayed << " last state changes restored.");
   }
-  LOG4CXX_WARN(logger_, "No valid last state was found.");
+  // Journal is dropped even if its first record is torn, otherwise new
+  // records would be appended after corrupted one and never replayed
+  if (file_system::FileExists(journal_file())) {
+    SaveToFileSystem();
+  }
+}
+
+uint32_t LastState::ReplayJournal() {
+  std::ifstream journal(journal_file().c_str());
+  if (!journal.is_open()) {
+    return 0;
+  }
+
+  uint32_t applied = 0;
+  std::string line;
+  Json::Reader reader;
+  while (std::getline(journal, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    Json::Value record;
+    // Last record may be torn by power loss, everything after it is lost
+    if (!reader.parse(line, record, false) || !ApplyRecord(record)) {
+      LOG4CXX_WARN(logger_, "Last state journal is corrupted after "
+                   << applied << " records.");
+      break;
+    }
+    ++applied;
+  }
+  return applied;
+}
+
+bool LastState::ApplyRecord(const Json::Value& record) {
+  if (!record.isObject()) {
+    return false;
+  }
+  Path path;
+  if (record.isMember(kSetRecord)) {
+    if (!PathFromJson(record[kSetRecord], &path)) {
+      return false;
+    }
+    SetNode(&dictionary_, path, record[kValue]);
+    return true;
+  }
+  if (record.isMember(kRemoveRecord)) {
+    if (!PathFromJson(record[kRemoveRecord], &path)) {
+      return false;
+    }
+    RemoveNode(&dictionary_, path);
+    return true;
+  }
+  return false;
 }
 
-LastState::LastState() {
+std::string LastState::journal_file() const {
+  return profile::Profile::instance()->app_info_storage() + ".journal";
+}
+
+LastState::LastState()
+  : journal_records_(0) {
   LoadFromFileSystem();
 }
 
 LastState::~LastState() {
-  SaveToFileSystem();
+  Compact();
 }
 
 }
@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RPC_BASE_JSON_STREAM_H_
+#define RPC_BASE_JSON_STREAM_H_
+
+#include <stdint.h>
+#include <string>
+
+namespace rpc {
+
+/*
+ * Pull parser of json text. Values are taken from the text one by one
+ * in document order, no intermediate tree is built, so rpc types are
+ * filled directly from the input buffer. Buffer must outlive the reader.
+ * Comments are skipped the same way Json::Reader does.
+ * After syntax error reader is marked as failed and behaves as if
+ * the document has ended, so all loops over containers stop.
+ */
+class JsonReader {
+ public:
+  JsonReader(const char* begin, const char* end);
+
+  // Tell type of the next value without taking it
+  bool NextIsNull();
+  bool NextIsBool();
+  bool NextIsNumber();
+  bool NextIsString();
+  bool NextIsArray();
+  bool NextIsObject();
+
+  bool TakeBool();
+  // Takes next number, returns false if it is not an integer
+  // that fits into int64_t
+  bool TakeInteger(int64_t* value);
+  // Takes next number of any kind
+  bool TakeDouble(double* value);
+  // Takes next string, escape sequences are decoded to utf-8
+  bool TakeString(std::string* value);
+  // Takes next value of any type including arrays and objects
+  void SkipValue();
+
+  // Enters array, elements are iterated with NextElement
+  // which returns false after the closing bracket
+  void EnterArray();
+  bool NextElement();
+  // Enters object, members are iterated with NextMember
+  // that takes member name and returns false after the closing brace
+  void EnterObject();
+  bool NextMember(std::string* name);
+
+  bool has_failed() const;
+ private:
+  char Peek();
+  bool Expect(char c);
+  bool TakeLiteral(const char* literal);
+  void SkipSpaceAndComments();
+  bool ScanNumber(const char** begin, const char** end);
+  bool DecodeUnicodeEscape(unsigned int* code_point);
+  void Fail();
+ private:
+  const char* current_;
+  const char* end_;
+  // Set after opening bracket, no comma is expected before first element
+  bool container_start_;
+  bool failed_;
+};
+
+/*
+ * Writer that appends compact json text directly to output string
+ * while rpc types are traversed, counterpart of JsonReader.
+ * Output is compatible with Json::FastWriter, provided object members
+ * are written sorted by name as Json::Value keeps them.
+ */
+class JsonWriter {
+ public:
+  explicit JsonWriter(std::string* output);
+
+  void BeginArray();
+  void EndArray();
+  void BeginObject();
+  void EndObject();
+  // Writes member name, must be followed by value
+  void PutKey(const std::string& name);
+  void PutKey(const char* name);
+
+  void PutNull();
+  void PutBool(bool value);
+  void PutInteger(int64_t value);
+  void PutDouble(double value);
+  void PutString(const std::string& value);
+  void PutString(const char* value);
+ private:
+  void BeforeValue();
+  void PutQuoted(const char* value, size_t length);
+ private:
+  std::string* output_;
+  bool need_comma_;
+};
+
+}  // namespace rpc
+
+#endif  // RPC_BASE_JSON_STREAM_H_
@@ -47,6 +47,8 @@ class MessageWriter;
 }  // namespace dbus
 
 namespace rpc {
+class JsonReader;
+class JsonWriter;
 class ValidationReport;
 
 template<typename T> class Range;
@@ -145,6 +147,8 @@ class Boolean : public PrimitiveType {
     operator bool() const;
     Json::Value ToJsonValue() const;
     void ToDbusWriter(dbus::MessageWriter* writer) const;
+    void ReadJson(JsonReader* reader);
+    void WriteJson(JsonWriter* writer) const;
 
   private:
     // Fields
@@ -167,6 +171,8 @@ class Integer : public PrimitiveType {
     operator IntType() const;
     Json::Value ToJsonValue() const;
     void ToDbusWriter(dbus::MessageWriter* writer) const;
+    void ReadJson(JsonReader* reader);
+    void WriteJson(JsonWriter* writer) const;
 
   private:
     IntType value_;
@@ -186,6 +192,8 @@ class Float : public PrimitiveType {
     operator double() const;
     Json::Value ToJsonValue() const;
     void ToDbusWriter(dbus::MessageWriter* writer) const;
+    void ReadJson(JsonReader* reader);
+    void WriteJson(JsonWriter* writer) const;
 
   private:
     double value_;
@@ -206,6 +214,8 @@ class String : public PrimitiveType {
     operator const std::string& () const;
     Json::Value ToJsonValue() const;
     void ToDbusWriter(dbus::MessageWriter* writer) const;
+    void ReadJson(JsonReader* reader);
+    void WriteJson(JsonWriter* writer) const;
 
   private:
     std::string value_;
@@ -228,6 +238,8 @@ class Enum : public PrimitiveType {
     operator EnumType() const;
     Json::Value ToJsonValue() const;
     void ToDbusWriter(dbus::MessageWriter* writer) const;
+    void ReadJson(JsonReader* reader);
+    void WriteJson(JsonWriter* writer) const;
 
   private:
     // Fields
@@ -255,6 +267,8 @@ class Array : public std::vector<T>, public CompositeType {
     void push_back(const U& value);
     Json::Value ToJsonValue() const;
     void ToDbusWriter(dbus::MessageWriter* writer) const;
+    void ReadJson(JsonReader* reader);
+    void WriteJson(JsonWriter* writer) const;
 
     bool is_valid() const;
     bool is_initialized() const;
@@ -283,6 +297,8 @@ class Map : public std::map<std::string, T>, public CompositeType  {
     void insert(const std::pair<std::string, U>& value);
     Json::Value ToJsonValue() const;
     void ToDbusWriter(dbus::MessageWriter* writer) const;
+    void ReadJson(JsonReader* reader);
+    void WriteJson(JsonWriter* writer) const;
 
     bool is_valid() const;
     bool is_initialized() const;
@@ -305,6 +321,8 @@ class Nullable : public T {
     template<typename U>
     Nullable& operator=(const U& new_val);
     Json::Value ToJsonValue() const;
+    void ReadJson(JsonReader* reader);
+    void WriteJson(JsonWriter* writer) const;
 
     bool is_valid() const;
     bool is_initialized() const;
@@ -331,6 +349,8 @@ class Stringifyable : public T {
     template<typename U>
     Stringifyable& operator=(const U& new_val);
     Json::Value ToJsonValue() const;
+    void ReadJson(JsonReader* reader);
+    void WriteJson(JsonWriter* writer) const;
 
     bool is_valid() const;
     bool is_initialized() const;
@@ -355,6 +375,8 @@ class Optional {
     Json::Value ToJsonValue() const;
 
     void ToDbusWriter(dbus::MessageWriter* writer) const;
+    void ReadJson(JsonReader* reader);
+    void WriteJson(JsonWriter* writer) const;
 
     // Pointer semantics
     T& operator*();
@@ -0,0 +1,249 @@
+/**
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RPC_BASE_JSON_STREAM_INL_H_
+#define RPC_BASE_JSON_STREAM_INL_H_
+
+#include "rpc_base/json_stream.h"
+#include "rpc_base/rpc_base.h"
+
+namespace rpc {
+
+namespace impl {
+
+template<class T>
+inline void WriteJsonField(const char* field_name,
+                           const T& field,
+                           JsonWriter* writer) {
+  if (field.is_initialized()) {
+    writer->PutKey(field_name);
+    field.WriteJson(writer);
+  }
+}
+
+// Writes map entries without enclosing braces, shared by Map and
+// generated structures that extend maps
+template<typename T, size_t minsize, size_t maxsize>
+inline void WriteJsonMapEntries(const Map<T, minsize, maxsize>& map,
+                                JsonWriter* writer) {
+  typedef typename Map<T, minsize, maxsize>::MapType MapType;
+  for (typename MapType::const_iterator i = map.begin(); i != map.end(); ++i) {
+    writer->PutKey(i->first);
+    i->second.WriteJson(writer);
+  }
+}
+
+}  // namespace impl
+
+// Values are read in place, so containers and structures do not copy
+// their elements. Value state follows the rules of Json::Value constructors:
+// value of unexpected type is taken from the reader and marked invalid.
+inline void Boolean::ReadJson(JsonReader* reader) {
+  if (reader->NextIsBool()) {
+    value_ = reader->TakeBool();
+    value_state_ = kValid;
+  } else {
+    reader->SkipValue();
+    value_state_ = kInvalid;
+  }
+}
+
+inline void Boolean::WriteJson(JsonWriter* writer) const {
+  writer->PutBool(value_);
+}
+
+template<typename T, T minval, T maxval>
+void Integer<T, minval, maxval>::ReadJson(JsonReader* reader) {
+  int64_t intval = 0;
+  if (reader->NextIsNumber()) {
+    if (reader->TakeInteger(&intval) && range_.Includes(intval)) {
+      value_ = IntType(intval);
+      value_state_ = kValid;
+    } else {
+      value_state_ = kInvalid;
+    }
+  } else {
+    reader->SkipValue();
+    value_state_ = kInvalid;
+  }
+}
+
+template<typename T, T minval, T maxval>
+void Integer<T, minval, maxval>::WriteJson(JsonWriter* writer) const {
+  writer->PutInteger(int64_t(value_));
+}
+
+template<int64_t minnum, int64_t maxnum, int64_t minden, int64_t maxden>
+void Float<minnum, maxnum, minden, maxden>::ReadJson(JsonReader* reader) {
+  if (reader->NextIsNumber()) {
+    value_state_ =
+        reader->TakeDouble(&value_) && range_.Includes(value_) ? kValid : kInvalid;
+  } else {
+    reader->SkipValue();
+    value_state_ = kInvalid;
+  }
+}
+
+template<int64_t minnum, int64_t maxnum, int64_t minden, int64_t maxden>
+void Float<minnum, maxnum, minden, maxden>::WriteJson(
+    JsonWriter* writer) const {
+  writer->PutDouble(value_);
+}
+
+template<size_t minlen, size_t maxlen>
+void String<minlen, maxlen>::ReadJson(JsonReader* reader) {
+  if (reader->NextIsString()) {
+    value_state_ = reader->TakeString(&value_) &&
+        length_range_.Includes(value_.length()) ? kValid : kInvalid;
+  } else {
+    reader->SkipValue();
+    value_state_ = kInvalid;
+  }
+}
+
+template<size_t minlen, size_t maxlen>
+void String<minlen, maxlen>::WriteJson(JsonWriter* writer) const {
+  writer->PutString(value_);
+}
+
+template<typename T>
+void Enum<T>::ReadJson(JsonReader* reader) {
+  std::string str;
+  if (reader->NextIsString()) {
+    value_state_ = reader->TakeString(&str) &&
+        EnumFromJsonString(str, &value_) ? kValid : kInvalid;
+  } else {
+    reader->SkipValue();
+    value_state_ = kInvalid;
+  }
+}
+
+template<typename T>
+void Enum<T>::WriteJson(JsonWriter* writer) const {
+  writer->PutString(EnumToJsonString(value_));
+}
+
+template<typename T, size_t minsize, size_t maxsize>
+void Array<T, minsize, maxsize>::ReadJson(JsonReader* reader) {
+  this->clear();
+  if (reader->NextIsArray()) {
+    initialization_state__ = kInitialized;
+    for (reader->EnterArray(); reader->NextElement();) {
+      ArrayType::push_back(T());
+      this->back().ReadJson(reader);
+    }
+  } else {
+    // Null is invalid as well, like in Json::Value constructor
+    reader->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+  }
+}
+
+template<typename T, size_t minsize, size_t maxsize>
+void Array<T, minsize, maxsize>::WriteJson(JsonWriter* writer) const {
+  writer->BeginArray();
+  for (typename ArrayType::const_iterator i = this->begin();
+       i != this->end(); ++i) {
+    i->WriteJson(writer);
+  }
+  writer->EndArray();
+}
+
+template<typename T, size_t minsize, size_t maxsize>
+void Map<T, minsize, maxsize>::ReadJson(JsonReader* reader) {
+  this->clear();
+  if (reader->NextIsObject()) {
+    initialization_state__ = kInitialized;
+    std::string key;
+    for (reader->EnterObject(); reader->NextMember(&key);) {
+      MapType::operator[](key).ReadJson(reader);
+    }
+  } else {
+    reader->SkipValue();
+    initialization_state__ = kInvalidInitialized;
+  }
+}
+
+template<typename T, size_t minsize, size_t maxsize>
+void Map<T, minsize, maxsize>::WriteJson(JsonWriter* writer) const {
+  writer->BeginObject();
+  impl::WriteJsonMapEntries(*this, writer);
+  writer->EndObject();
+}
+
+template<typename T>
+void Nullable<T>::ReadJson(JsonReader* reader) {
+  marked_null_ = reader->NextIsNull();
+  T::ReadJson(reader);
+}
+
+template<typename T>
+void Nullable<T>::WriteJson(JsonWriter* writer) const {
+  if (marked_null_) {
+    writer->PutNull();
+  } else {
+    T::WriteJson(writer);
+  }
+}
+
+template<typename T>
+void Stringifyable<T>::ReadJson(JsonReader* reader) {
+  if (reader->NextIsString()) {
+    reader->TakeString(&predefined_string_);
+  } else {
+    predefined_string_.clear();
+    T::ReadJson(reader);
+  }
+}
+
+template<typename T>
+void Stringifyable<T>::WriteJson(JsonWriter* writer) const {
+  if (predefined_string_.empty()) {
+    T::WriteJson(writer);
+  } else {
+    writer->PutString(predefined_string_);
+  }
+}
+
+template<typename T>
+void Optional<T>::ReadJson(JsonReader* reader) {
+  value_.ReadJson(reader);
+}
+
+template<typename T>
+void Optional<T>::WriteJson(JsonWriter* writer) const {
+  value_.WriteJson(writer);
+}
+
+}  // namespace rpc
+
+#endif  // RPC_BASE_JSON_STREAM_INL_H_
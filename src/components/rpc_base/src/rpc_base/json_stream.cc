@@ -0,0 +1,558 @@
+/**
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifdef MODIFY_FUNCTION_SIGN
+#include <global_first.h>
+#endif
+#include "rpc_base/json_stream.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+bool IsNumberChar(char c) {
+  return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' ||
+         c == 'e' || c == 'E';
+}
+
+int HexDigit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  } else if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  } else if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+void AppendUtf8(unsigned int code_point, std::string* output) {
+  if (code_point < 0x80) {
+    *output += static_cast<char>(code_point);
+  } else if (code_point < 0x800) {
+    *output += static_cast<char>(0xC0 | (code_point >> 6));
+    *output += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else if (code_point < 0x10000) {
+    *output += static_cast<char>(0xE0 | (code_point >> 12));
+    *output += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    *output += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else {
+    *output += static_cast<char>(0xF0 | (code_point >> 18));
+    *output += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    *output += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    *output += static_cast<char>(0x80 | (code_point & 0x3F));
+  }
+}
+
+}  // namespace
+
+namespace rpc {
+
+JsonReader::JsonReader(const char* begin, const char* end)
+  : current_(begin),
+    end_(end),
+    container_start_(false),
+    failed_(false) {
+}
+
+bool JsonReader::NextIsNull() {
+  return Peek() == 'n';
+}
+
+bool JsonReader::NextIsBool() {
+  const char c = Peek();
+  return c == 't' || c == 'f';
+}
+
+bool JsonReader::NextIsNumber() {
+  const char c = Peek();
+  return c == '-' || (c >= '0' && c <= '9');
+}
+
+bool JsonReader::NextIsString() {
+  return Peek() == '"';
+}
+
+bool JsonReader::NextIsArray() {
+  return Peek() == '[';
+}
+
+bool JsonReader::NextIsObject() {
+  return Peek() == '{';
+}
+
+bool JsonReader::TakeBool() {
+  if (Peek() == 't') {
+    return TakeLiteral("true");
+  }
+  TakeLiteral("false");
+  return false;
+}
+
+bool JsonReader::TakeInteger(int64_t* value) {
+  const char* begin = NULL;
+  const char* end = NULL;
+  if (!ScanNumber(&begin, &end)) {
+    return false;
+  }
+  const bool negative = *begin == '-';
+  if (negative) {
+    ++begin;
+  }
+  if (begin == end) {
+    Fail();
+    return false;
+  }
+  // Magnitude of the most negative value is one more than of the most positive
+  const uint64_t limit = (uint64_t(1) << 63) - (negative ? 0 : 1);
+  uint64_t magnitude = 0;
+  for (const char* i = begin; i != end; ++i) {
+    if (*i < '0' || *i > '9') {
+      // Fraction or exponent, a valid number but not an integer
+      return false;
+    }
+    const unsigned int digit = *i - '0';
+    if (magnitude > (limit - digit) / 10) {
+      return false;
+    }
+    magnitude = magnitude * 10 + digit;
+  }
+  if (!negative) {
+    *value = int64_t(magnitude);
+  } else if (magnitude != 0) {
+    *value = -int64_t(magnitude - 1) - 1;
+  } else {
+    *value = 0;
+  }
+  return true;
+}
+
+bool JsonReader::TakeDouble(double* value) {
+  const char* begin = NULL;
+  const char* end = NULL;
+  if (!ScanNumber(&begin, &end)) {
+    return false;
+  }
+  const std::string number(begin, end);
+  char* parsed_end = NULL;
+  *value = strtod(number.c_str(), &parsed_end);
+  if (parsed_end != number.c_str() + number.size()) {
+    Fail();
+    return false;
+  }
+  return true;
+}
+
+bool JsonReader::TakeString(std::string* value) {
+  if (!Expect('"')) {
+    return false;
+  }
+  value->clear();
+  while (current_ != end_) {
+    // Copy unescaped run at once
+    const char* run_end = current_;
+    while (run_end != end_ && *run_end != '"' && *run_end != '\\') {
+      ++run_end;
+    }
+    value->append(current_, run_end);
+    current_ = run_end;
+    if (current_ == end_) {
+      break;
+    }
+    if (*current_++ == '"') {
+      return true;
+    }
+    if (current_ == end_) {
+      break;
+    }
+    switch (*current_++) {
+      case '"': *value += '"'; break;
+      case '\\': *value += '\\'; break;
+      case '/': *value += '/'; break;
+      case 'b': *value += '\b'; break;
+      case 'f': *value += '\f'; break;
+      case 'n': *value += '\n'; break;
+      case 'r': *value += '\r'; break;
+      case 't': *value += '\t'; break;
+      case 'u': {
+        unsigned int code_point = 0;
+        if (!DecodeUnicodeEscape(&code_point)) {
+          return false;
+        }
+        AppendUtf8(code_point, value);
+        break;
+      }
+      default: {
+        Fail();
+        return false;
+      }
+    }
+  }
+  Fail();
+  return false;
+}
+
+void JsonReader::SkipValue() {
+  switch (Peek()) {
+    case '[': {
+      EnterArray();
+      while (NextElement()) {
+        SkipValue();
+      }
+      break;
+    }
+    case '{': {
+      std::string name;
+      EnterObject();
+      while (NextMember(&name)) {
+        SkipValue();
+      }
+      break;
+    }
+    case '"': {
+      std::string ignored;
+      TakeString(&ignored);
+      break;
+    }
+    case 't':
+    case 'f': {
+      TakeBool();
+      break;
+    }
+    case 'n': {
+      TakeLiteral("null");
+      break;
+    }
+    default: {
+      const char* begin = NULL;
+      const char* end = NULL;
+      ScanNumber(&begin, &end);
+      break;
+    }
+  }
+}
+
+void JsonReader::EnterArray() {
+  if (Expect('[')) {
+    container_start_ = true;
+  }
+}
+
+bool JsonReader::NextElement() {
+  const char c = Peek();
+  if (c == ']') {
+    ++current_;
+    container_start_ = false;
+    return false;
+  }
+  if (container_start_) {
+    container_start_ = false;
+    if (c == '\0') {
+      Fail();
+    }
+    return !failed_;
+  }
+  return Expect(',');
+}
+
+void JsonReader::EnterObject() {
+  if (Expect('{')) {
+    container_start_ = true;
+  }
+}
+
+bool JsonReader::NextMember(std::string* name) {
+  const char c = Peek();
+  if (c == '}') {
+    ++current_;
+    container_start_ = false;
+    return false;
+  }
+  if (container_start_) {
+    container_start_ = false;
+  } else if (!Expect(',')) {
+    return false;
+  }
+  return TakeString(name) && Expect(':');
+}
+
+bool JsonReader::has_failed() const {
+  return failed_;
+}
+
+char JsonReader::Peek() {
+  SkipSpaceAndComments();
+  return current_ == end_ ? '\0' : *current_;
+}
+
+bool JsonReader::Expect(char c) {
+  if (Peek() == c && c != '\0') {
+    ++current_;
+    return true;
+  }
+  Fail();
+  return false;
+}
+
+bool JsonReader::TakeLiteral(const char* literal) {
+  SkipSpaceAndComments();
+  const size_t length = strlen(literal);
+  if (size_t(end_ - current_) >= length &&
+      strncmp(current_, literal, length) == 0) {
+    current_ += length;
+    return true;
+  }
+  Fail();
+  return false;
+}
+
+void JsonReader::SkipSpaceAndComments() {
+  while (current_ != end_) {
+    const char c = *current_;
+    if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+      ++current_;
+    } else if (c == '/' && end_ - current_ > 1 && current_[1] == '/') {
+      while (current_ != end_ && *current_ != '\n') {
+        ++current_;
+      }
+    } else if (c == '/' && end_ - current_ > 1 && current_[1] == '*') {
+      current_ += 2;
+      while (end_ - current_ > 1 && !(current_[0] == '*' && current_[1] == '/')) {
+        ++current_;
+      }
+      if (end_ - current_ > 1) {
+        current_ += 2;
+      } else {
+        Fail();
+      }
+    } else {
+      break;
+    }
+  }
+}
+
+bool JsonReader::ScanNumber(const char** begin, const char** end) {
+  if (!NextIsNumber()) {
+    Fail();
+    return false;
+  }
+  *begin = current_;
+  while (current_ != end_ && IsNumberChar(*current_)) {
+    ++current_;
+  }
+  *end = current_;
+  return true;
+}
+
+bool JsonReader::DecodeUnicodeEscape(unsigned int* code_point) {
+  unsigned int unit = 0;
+  for (int i = 0; i < 4; ++i) {
+    const int digit = current_ == end_ ? -1 : HexDigit(*current_++);
+    if (digit < 0) {
+      Fail();
+      return false;
+    }
+    unit = unit * 16 + digit;
+  }
+  // High surrogate must be followed by escaped low surrogate
+  if (unit >= 0xD800 && unit <= 0xDBFF) {
+    if (end_ - current_ < 2 || current_[0] != '\\' || current_[1] != 'u') {
+      Fail();
+      return false;
+    }
+    current_ += 2;
+    unsigned int low = 0;
+    if (!DecodeUnicodeEscape(&low) || low < 0xDC00 || low > 0xDFFF) {
+      Fail();
+      return false;
+    }
+    unit = 0x10000 + ((unit & 0x3FF) << 10) + (low & 0x3FF);
+  }
+  *code_point = unit;
+  return true;
+}
+
+void JsonReader::Fail() {
+  failed_ = true;
+  current_ = end_;
+}
+
+JsonWriter::JsonWriter(std::string* output)
+  : output_(output),
+    need_comma_(false) {
+}
+
+void JsonWriter::BeginArray() {
+  BeforeValue();
+  *output_ += '[';
+  need_comma_ = false;
+}
+
+void JsonWriter::EndArray() {
+  *output_ += ']';
+  need_comma_ = true;
+}
+
+void JsonWriter::BeginObject() {
+  BeforeValue();
+  *output_ += '{';
+  need_comma_ = false;
+}
+
+void JsonWriter::EndObject() {
+  *output_ += '}';
+  need_comma_ = true;
+}
+
+void JsonWriter::PutKey(const std::string& name) {
+  BeforeValue();
+  PutQuoted(name.data(), name.size());
+  *output_ += ':';
+  need_comma_ = false;
+}
+
+void JsonWriter::PutKey(const char* name) {
+  BeforeValue();
+  PutQuoted(name, strlen(name));
+  *output_ += ':';
+  need_comma_ = false;
+}
+
+void JsonWriter::PutNull() {
+  BeforeValue();
+  *output_ += "null";
+  need_comma_ = true;
+}
+
+void JsonWriter::PutBool(bool value) {
+  BeforeValue();
+  *output_ += value ? "true" : "false";
+  need_comma_ = true;
+}
+
+void JsonWriter::PutInteger(int64_t value) {
+  BeforeValue();
+  char buffer[24];
+  char* current = buffer + sizeof(buffer);
+  // Negate digit by digit to handle the most negative value
+  const bool negative = value < 0;
+  do {
+    const int digit = static_cast<int>(value % 10);
+    *--current = static_cast<char>('0' + (negative ? -digit : digit));
+    value /= 10;
+  } while (value != 0);
+  if (negative) {
+    *--current = '-';
+  }
+  output_->append(current, buffer + sizeof(buffer));
+  need_comma_ = true;
+}
+
+void JsonWriter::PutDouble(double value) {
+  BeforeValue();
+  // Same formatting as Json::FastWriter: 16 significant digits, run of
+  // trailing zeroes of fraction is cut leaving a single zero
+  char buffer[32];
+  sprintf(buffer, "%#.16g", value);
+  char* last = buffer + strlen(buffer) - 1;
+  if (*last == '0') {
+    char* last_nonzero = last;
+    while (last_nonzero > buffer && *last_nonzero == '0') {
+      --last_nonzero;
+    }
+    char* i = last_nonzero;
+    while (i >= buffer && *i >= '0' && *i <= '9') {
+      --i;
+    }
+    if (i >= buffer && *i == '.') {
+      *(last_nonzero + 2) = '\0';
+    }
+  }
+  *output_ += buffer;
+  need_comma_ = true;
+}
+
+void JsonWriter::PutString(const std::string& value) {
+  BeforeValue();
+  PutQuoted(value.data(), value.size());
+  need_comma_ = true;
+}
+
+void JsonWriter::PutString(const char* value) {
+  BeforeValue();
+  PutQuoted(value, strlen(value));
+  need_comma_ = true;
+}
+
+void JsonWriter::BeforeValue() {
+  if (need_comma_) {
+    *output_ += ',';
+  }
+}
+
+void JsonWriter::PutQuoted(const char* value, size_t length) {
+  *output_ += '"';
+  const char* const end = value + length;
+  while (value != end) {
+    // Copy run that needs no escaping at once
+    const char* run_end = value;
+    while (run_end != end && *run_end != '"' && *run_end != '\\' &&
+           static_cast<unsigned char>(*run_end) >= 0x20) {
+      ++run_end;
+    }
+    output_->append(value, run_end);
+    value = run_end;
+    if (value == end) {
+      break;
+    }
+    const char c = *value++;
+    switch (c) {
+      case '"': *output_ += "\\\""; break;
+      case '\\': *output_ += "\\\\"; break;
+      case '\b': *output_ += "\\b"; break;
+      case '\f': *output_ += "\\f"; break;
+      case '\n': *output_ += "\\n"; break;
+      case '\r': *output_ += "\\r"; break;
+      case '\t': *output_ += "\\t"; break;
+      default: {
+        char escaped[8];
+        sprintf(escaped, "\\u%04X", static_cast<int>(c));
+        *output_ += escaped;
+        break;
+      }
+    }
+  }
+  *output_ += '"';
+}
+
+}  // namespace rpc
@@ -36,6 +36,7 @@
 #include <map>
 
 #include "smart_objects/smart_schema.h"
+#include "utils/shared_buffer.h"
 
 namespace NsSmartDeviceLink {
 namespace NsSmartObjects {
@@ -427,6 +428,15 @@ class SmartObject {
    **/
   explicit SmartObject(const SmartBinary& InitialValue);
 
+  /**
+   * @brief Constructor for creating object of type: binary
+   *
+   * Bytes are not copied, object shares the buffer with the caller.
+   *
+   * @param InitialValue Initial binary value
+   **/
+  explicit SmartObject(const utils::SharedBuffer& InitialValue);
+
   /**
    * @brief Conversion operator to type: binary
    *
@@ -441,6 +451,13 @@ class SmartObject {
    **/
   SmartBinary asBinary() const;
 
+  /**
+   * @brief Returns binary value of the object without copying it
+   *
+   * @return utils::SharedBuffer Empty buffer if object is not binary
+   **/
+  utils::SharedBuffer asBinaryBuffer() const;
+
   /**
    * @brief Returns current object converted to array
    *
@@ -456,6 +473,14 @@ class SmartObject {
    **/
   SmartObject& operator=(SmartBinary);
 
+  /**
+   * @brief Assignment operator for type: binary, bytes are not copied
+   *
+   * @param  NewValue New object value
+   * @return SmartObject&
+   **/
+  SmartObject& operator=(const utils::SharedBuffer& NewValue);
+
   /**
    * @brief Comparison operator for comparing object with binary value
    *
@@ -773,7 +798,7 @@ class SmartObject {
    * @param  NewValue New object value
    * @return void
    **/
-  inline void set_value_binary(SmartBinary NewValue);
+  inline void set_value_binary(const utils::SharedBuffer& NewValue);
 
   /**
    * @brief Converts object to binary type
@@ -881,7 +906,7 @@ class SmartObject {
     std::string* str_value;
     SmartArray* array_value;
     SmartMap* map_value;
-    SmartBinary* binary_value;
+    utils::SharedBuffer* binary_value;
   } SmartData;
 
   /**
@@ -88,7 +88,7 @@ SmartObject::SmartObject(SmartType Type)
       m_type = SmartType_Array;
       break;
     case SmartType_Binary:
-      set_value_binary(SmartBinary());
+      set_value_binary(utils::SharedBuffer());
       break;
     case SmartType_Invalid:
       m_type = SmartType_Invalid;
@@ -142,9 +142,7 @@ bool SmartObject::operator==(const SmartObject& Other) const {
     case SmartType_Binary:
       if (m_data.binary_value == Other.m_data.binary_value)
         return true;
-      return std::equal(m_data.binary_value->begin(),
-                        m_data.binary_value->end(),
-                        Other.m_data.binary_value->begin());
+      return *(m_data.binary_value) == *(Other.m_data.binary_value);
     case SmartType_Null:
       return true;
     case SmartType_Invalid:
@@ -595,6 +593,13 @@ SmartObject::SmartObject(const SmartBinary& InitialValue)
     : m_type(SmartType_Null),
       m_schema() {
   m_data.str_value = NULL;
+  set_value_binary(utils::SharedBuffer(InitialValue));
+}
+
+SmartObject::SmartObject(const utils::SharedBuffer& InitialValue)
+    : m_type(SmartType_Null),
+      m_schema() {
+  m_data.str_value = NULL;
   set_value_binary(InitialValue);
 }
 
@@ -602,6 +607,13 @@ SmartBinary SmartObject::asBinary() const {
   return convert_binary();
 }
 
+utils::SharedBuffer SmartObject::asBinaryBuffer() const {
+  if (m_type != SmartType_Binary) {
+    return utils::SharedBuffer();
+  }
+  return *(m_data.binary_value);
+}
+
 SmartArray* SmartObject::asArray() const {
   if (m_type != SmartType_Array) {
 /*
@@ -616,6 +628,13 @@ SmartArray* SmartObject::asArray() const {
 }
 
 SmartObject& SmartObject::operator=(SmartBinary NewValue) {
+  if (m_type != SmartType_Invalid) {
+    set_value_binary(utils::SharedBuffer::Adopt(&NewValue));
+  }
+  return *this;
+}
+
+SmartObject& SmartObject::operator=(const utils::SharedBuffer& NewValue) {
   if (m_type != SmartType_Invalid) {
     set_value_binary(NewValue);
   }
@@ -631,15 +650,15 @@ bool SmartObject::operator==(SmartBinary Value) const {
   }
 }
 
-void SmartObject::set_value_binary(SmartBinary NewValue) {
+void SmartObject::set_value_binary(const utils::SharedBuffer& NewValue) {
   set_new_type(SmartType_Binary);
-  m_data.binary_value = new SmartBinary(NewValue);
+  m_data.binary_value = new utils::SharedBuffer(NewValue);
 }
 
 SmartBinary SmartObject::convert_binary(void) const {
   switch (m_type) {
     case SmartType_Binary:
-      return *(m_data.binary_value);
+      return m_data.binary_value->ToVector();
     default: {
 /*
 #if !defined UNIT_TESTS
@@ -805,7 +824,8 @@ void SmartObject::duplicate(const SmartObject& OtherObject) {
       newData.str_value = new std::string(*OtherObject.m_data.str_value);
       break;
     case SmartType_Binary:
-      newData.binary_value = new SmartBinary(*OtherObject.m_data.binary_value);
+      newData.binary_value =
+          new utils::SharedBuffer(*OtherObject.m_data.binary_value);
       break;
     default:
 /*
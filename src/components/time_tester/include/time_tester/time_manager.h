@@ -35,33 +35,26 @@
 
 #include <string>
 
-#include "utils/shared_ptr.h"
-#include "utils/message_queue.h"
+#include "utils/macro.h"
 #include "utils/threads/thread.h"
-#include "utils/singleton.h"
 #include "utils/threads/thread_delegate.h"
-#include "metric_wrapper.h"
-#include "application_manager_observer.h"
-#include "application_manager/application_manager_impl.h"
-#include "transport_manager_observer.h"
-#include "transport_manager/transport_manager_impl.h"
-#include "protocol_handler_observer.h"
-#include "protocol_handler/protocol_handler_impl.h"
 
 namespace time_tester {
 
+/**
+ * @brief Serves latency statistics snapshot to local clients.
+ *
+ * Every connected client receives current snapshot of
+ * utils::LatencyStatistics as compact JSON, after that connection is
+ * closed. Nothing is collected or serialized between requests.
+ */
 class TimeManager {
  public:
   TimeManager();
   ~TimeManager();
-  void Init(protocol_handler::ProtocolHandlerImpl* ph);
+  void Init();
   void Stop();
-  void SendMetric(utils::SharedPtr<MetricWrapper> metric);
  private:
-  ApplicationManagerObserver app_observer;
-  TransportManagerObserver tm_observer;
-  ProtocolHandlerObserver ph_observer;
-
   class Streamer : public threads::ThreadDelegate {
    public:
     explicit Streamer(TimeManager* const server);
@@ -72,10 +65,9 @@ class TimeManager {
     void Start();
     void Stop();
     bool Send(const std::string &msg);
-  volatile bool is_client_connected_;
   private:
     TimeManager* const server_;
-    int32_t new_socket_fd_;  
+    int32_t new_socket_fd_;
     volatile bool stop_flag_;
     DISALLOW_COPY_AND_ASSIGN(Streamer);
   };
@@ -83,9 +75,7 @@ class TimeManager {
   int16_t port_;
   std::string ip_;
   int32_t socket_fd_;
-  bool is_ready_;
   threads::Thread* thread_;
-  MessageQueue<utils::SharedPtr<MetricWrapper> > messages_;
   Streamer* streamer_;
 
   DISALLOW_COPY_AND_ASSIGN(TimeManager);
@@ -41,9 +41,9 @@
 #include <unistd.h>
 #include <string.h>
 
-#include "transport_manager/transport_manager_default.h"
 #include "config_profile/profile.h"
-#include "utils/resource_usage.h"
+#include "utils/latency_statistics.h"
+#include "utils/logger.h"
 
 namespace time_tester {
 
@@ -51,11 +51,7 @@ CREATE_LOGGERPTR_GLOBAL(logger_, "TimeManager")
 
 TimeManager::TimeManager():
   socket_fd_(0),
-  messages_(),
   thread_(NULL),
-  app_observer(this),
-  tm_observer(this),
-  ph_observer(this),
   streamer_(NULL) {
     ip_ = profile::Profile::instance()->server_address();
     port_ = profile::Profile::instance()->time_testing_port();
@@ -66,14 +62,10 @@ TimeManager::~TimeManager() {
   Stop();
 }
 
-void TimeManager::Init(protocol_handler::ProtocolHandlerImpl* ph) {
-  DCHECK(ph);
+void TimeManager::Init() {
   if (!thread_) {
     streamer_ = new Streamer(this);
     thread_ = new threads::Thread("SocketAdapter", streamer_ );
-    application_manager::ApplicationManagerImpl::instance()->SetTimeMetricObserver(&app_observer);
-    transport_manager::TransportManagerDefault::instance()->SetTimeMetricObserver(&tm_observer);
-    ph->SetTimeMetricObserver(&ph_observer);
     thread_->startWithOptions(threads::ThreadOptions());
     LOG4CXX_INFO(logger_, "Create and start sending thread");
     }
@@ -88,21 +80,13 @@ void TimeManager::Stop() {
       ::close(socket_fd_);
     }
   }
-  messages_.Reset();
   LOG4CXX_INFO(logger_, "TimeManager stopped");
 }
 
-void TimeManager::SendMetric(utils::SharedPtr<MetricWrapper> metric) {
-  if ((NULL != streamer_ )&& streamer_->is_client_connected_) {
-    messages_.push(metric);
-  }
-}
-
 TimeManager::Streamer::Streamer(
   TimeManager* const server)
   : server_(server),
     new_socket_fd_(0),
-    is_client_connected_(false),
     stop_flag_(false) {
 }
 
@@ -123,21 +107,11 @@ void TimeManager::Streamer::threadMain() {
       continue;
     }
 
-    is_client_connected_ = true;
-    while (is_client_connected_) {
-      while (!server_->messages_.empty()) {
-        utils::SharedPtr<MetricWrapper> metric = server_->messages_.pop();
-        is_client_connected_ = Send(metric->GetStyledString());
-      }
-
-      if (!IsReady()) {
-        LOG4CXX_INFO(logger_, "Client disconnected.");
-        Stop();
-        break;
-      }
-
-      server_->messages_.wait();
+    // Statistics is formatted only here, on request of connected client
+    if (!Send(utils::LatencyStatistics::instance()->Snapshot())) {
+      LOG4CXX_WARN(logger_, "Unable to send latency statistics");
     }
+    Stop();
   }
 }
 
@@ -145,7 +119,10 @@ bool TimeManager::Streamer::exitThreadMain() {
   LOG4CXX_INFO(logger_, "Streamer::exitThreadMain");
   stop_flag_ = true;
   Stop();
-  server_->messages_.Shutdown();
+  if (server_->socket_fd_ > 0) {
+    // Wakes up thread blocked in accept
+    shutdown(server_->socket_fd_, SHUT_RDWR);
+  }
   return false;
 }
 
@@ -186,7 +163,7 @@ void TimeManager::Streamer::Start() {
 
 void TimeManager::Streamer::Stop() {
   LOG4CXX_INFO(logger_, "SocketStreamerAdapter::Streamer::stop");
-  if (!new_socket_fd_) {
+  if (new_socket_fd_ <= 0) {
     return;
   }
 
@@ -201,7 +178,6 @@ void TimeManager::Streamer::Stop() {
   }
 
   new_socket_fd_ = -1;
-  is_client_connected_ = false;
 }
 
 bool TimeManager::Streamer::IsReady() const {
@@ -389,22 +389,6 @@ class TransportAdapterImpl : public TransportAdapter,
    */
   virtual std::string DeviceName(const DeviceUID& device_id) const;
 
-#ifdef TIME_TESTER
-  /**
-   * @brief Setup observer for time metric.
-   *
-   * @param observer - pointer to observer
-   */
-  void SetTimeMetricObserver(TMMetricObserver* observer);
-
-  /**
-   * @brief Return Time metric observer
-   *
-   * @param return pointer to Time metric observer
-   */
-  virtual TMMetricObserver* GetTimeMetricObserver();
-#endif  // TIME_TESTER
-
  protected:
 
   /**
@@ -526,12 +510,6 @@ class TransportAdapterImpl : public TransportAdapter,
    */
   ClientConnectionListener* client_connection_listener_;
 
-#ifdef TIME_TESTER
-  /**
-   * @brief Pointer to time metric observer
-   */
-  TMMetricObserver* metric_observer_;
-#endif  // TIME_TESTER
 };
 }  // namespace transport_adapter
 }  // namespace transport_manager
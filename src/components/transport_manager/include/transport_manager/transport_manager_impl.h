@@ -54,9 +54,6 @@
 #include "transport_manager/transport_manager.h"
 #include "transport_manager/transport_manager_listener.h"
 #include "transport_manager/transport_adapter/transport_adapter_listener_impl.h"
-#ifdef TIME_TESTER
-#include "transport_manager/time_metric_observer.h"
-#endif  // TIME_TESTER
 
 using ::transport_manager::transport_adapter::TransportAdapterListener;
 
@@ -229,15 +226,6 @@ class TransportManagerImpl : public TransportManager {
    */
   void UpdateDeviceList(TransportAdapter* ta);
 
-#ifdef TIME_TESTER
-  /**
-   * @brief Setup observer for time metric.
-   *
-   * @param observer - pointer to observer
-   */
-  void SetTimeMetricObserver(TMMetricObserver* observer);
-#endif  // TIME_TESTER
-
 
   /**
    * @brief Constructor.
@@ -492,9 +480,6 @@ class TransportManagerImpl : public TransportManager {
    * @brief Flag that TM is initialized
    */
   bool is_initialized_;
-#ifdef TIME_TESTER
-  TMMetricObserver* metric_observer_;
-#endif  // TIME_TESTER
  private:
   /**
    * @brief Structure that contains conversion functions (Device ID -> Device
@@ -37,6 +37,10 @@
 #define SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_USB_LIBUSB_USB_CONNECTION_H_
 
 #include <pthread.h>
+#include <deque>
+#include <list>
+#include <set>
+#include <vector>
 
 #include "transport_manager/transport_adapter/transport_adapter_controller.h"
 #include "transport_manager/transport_adapter/connection.h"
@@ -45,6 +49,14 @@
 namespace transport_manager {
 namespace transport_adapter {
 
+/**
+ * @brief Connection over pair of bulk endpoints of AOA device.
+ *
+ * Several IN transfers are kept submitted so the device can send while
+ * the data of previous transfer is processed. Received data is delivered
+ * in submission order. Queued outgoing messages are joined into one OUT
+ * transfer up to UsbOutTransferMaxSize bytes.
+ */
 class UsbConnection : public Connection {
  public:
   UsbConnection(const DeviceUID& device_uid,
@@ -66,11 +78,18 @@ class UsbConnection : public Connection {
   friend void LIBUSB_CALL OutTransferCallback(struct libusb_transfer*);
 		
   bool FindEndpoints();
-  void PopOutMessage();
-  bool PostInTransfer();
+  bool AllocateInTransfers();
+  void FreeInTransfers();
+  bool PostInTransfer(libusb_transfer* transfer);
+  void StartOutTransfer();
   bool PostOutTransfer();
+  void CompleteOutTransfer(bool success);
   void OnInTransfer(struct libusb_transfer*);
   void OnOutTransfer(struct libusb_transfer*);
+  void CancelTransfers();
+  bool TransfersPending();
+  void Abort();
+  void FinishAbort();
   void Finalise();
 
   const DeviceUID device_uid_;
@@ -83,17 +102,30 @@ class UsbConnection : public Connection {
   uint16_t in_endpoint_max_packet_size_;
   uint8_t out_endpoint_;
   uint16_t out_endpoint_max_packet_size_;
-  unsigned char* in_buffer_;
-  libusb_transfer* in_transfer_;
-  libusb_transfer* out_transfer_;
+  uint32_t in_transfer_size_;
+  uint32_t out_transfer_max_size_;
+
+  std::vector<libusb_transfer*> in_transfers_;
+  // submitted in transfers in order of submission
+  std::deque<libusb_transfer*> in_submitted_;
+  // completed in transfers waiting for the earlier ones
+  std::set<libusb_transfer*> in_completed_;
+  pthread_mutex_t in_transfers_mutex_;
 
+  libusb_transfer* out_transfer_;
   std::list<RawMessageSptr> out_messages_;
-  RawMessageSptr current_out_message_;
+  // messages sent by current out transfer
+  std::list<RawMessageSptr> out_batch_;
+  std::vector<unsigned char> out_buffer_;
+  unsigned char* out_data_;
+  size_t out_data_size_;
   pthread_mutex_t out_messages_mutex_;
   size_t bytes_sent_;
+  // written with both mutexes held, read with either of them
   bool disconnecting_;
-  bool waiting_in_transfer_cancel_;
-  bool waiting_out_transfer_cancel_;
+  // aborted from transfer callback, DisconnectDone is sent when all
+  // transfers are returned
+  bool aborted_;
 };
 
 }  // namespace transport_adapter
@@ -127,16 +127,21 @@ void BluetoothTransportAdapter::Store() const {
     }
   }
   bluetooth_adapter_dictionary["devices"] = devices_dictionary;
-  resumption::LastState::instance()->dictionary["TransportManager"]["BluetoothAdapter"] =
-    bluetooth_adapter_dictionary;
+  resumption::LastState::Path path;
+  path.push_back("TransportManager");
+  path.push_back("BluetoothAdapter");
+  resumption::LastState::instance()->SetValue(path, bluetooth_adapter_dictionary);
   LOG4CXX_TRACE_EXIT(logger_);
 }
 
 bool BluetoothTransportAdapter::Restore() {
   LOG4CXX_TRACE_ENTER(logger_);
   bool errors_occured = false;
+  resumption::LastState::Path path;
+  path.push_back("TransportManager");
+  path.push_back("BluetoothAdapter");
   const Json::Value bluetooth_adapter_dictionary =
-    resumption::LastState::instance()->dictionary["TransportManager"]["BluetoothAdapter"];
+      resumption::LastState::instance()->GetValue(path);
   const Json::Value devices_dictionary = bluetooth_adapter_dictionary["devices"];
   for (Json::Value::const_iterator i = devices_dictionary.begin();
     i != devices_dictionary.end(); ++i) {
@@ -128,16 +128,21 @@ void TcpTransportAdapter::Store() const {
     }
   }
   tcp_adapter_dictionary["devices"] = devices_dictionary;
-  resumption::LastState::instance()->dictionary["TransportManager"]["TcpAdapter"] =
-    tcp_adapter_dictionary;
+  resumption::LastState::Path path;
+  path.push_back("TransportManager");
+  path.push_back("TcpAdapter");
+  resumption::LastState::instance()->SetValue(path, tcp_adapter_dictionary);
   LOG4CXX_TRACE_EXIT(logger_);
 }
 
 bool TcpTransportAdapter::Restore() {
   LOG4CXX_TRACE_ENTER(logger_);
   bool errors_occured = false;
+  resumption::LastState::Path path;
+  path.push_back("TransportManager");
+  path.push_back("TcpAdapter");
   const Json::Value tcp_adapter_dictionary =
-    resumption::LastState::instance()->dictionary["TransportManager"]["TcpAdapter"];
+      resumption::LastState::instance()->GetValue(path);
   const Json::Value devices_dictionary = tcp_adapter_dictionary["devices"];
   for (Json::Value::const_iterator i = devices_dictionary.begin();
     i != devices_dictionary.end(); ++i) {
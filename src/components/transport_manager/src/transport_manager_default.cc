@@ -63,20 +63,10 @@ int TransportManagerDefault::Init() {
   transport_adapter::TransportAdapterImpl* ta;
 #ifdef BLUETOOTH_SUPPORT
   ta = new transport_adapter::BluetoothTransportAdapter;
-#ifdef TIME_TESTER
-  if (metric_observer_) {
-    ta->SetTimeMetricObserver(metric_observer_);
-  }
-#endif  // TIME_TESTER
   AddTransportAdapter(ta);
 #endif
   uint16_t port = profile::Profile::instance()->transport_manager_tcp_adapter_port();
   ta = new transport_adapter::TcpTransportAdapter(port);
-#ifdef TIME_TESTER
-  if (metric_observer_) {
-    ta->SetTimeMetricObserver(metric_observer_);
-  }
-#endif  // TIME_TESTER
   AddTransportAdapter(ta);
 #ifdef USB_SUPPORT
 #ifdef SP_C9_PRIMA1
@@ -84,20 +74,10 @@ int TransportManagerDefault::Init() {
 #else
   ta = new transport_adapter::UsbAoaAdapter();
 #endif
-#ifdef TIME_TESTER
-  if (metric_observer_) {
-    ta->SetTimeMetricObserver(metric_observer_);
-  }
-#endif  // TIME_TESTER
   AddTransportAdapter(ta);
 #endif
 #ifdef MME_SUPPORT
   ta = new transport_adapter::MmeTransportAdapter();
-#ifdef TIME_TESTER
-  if (metric_observer_) {
-    ta->SetTimeMetricObserver(metric_observer_);
-  }
-#endif  // TIME_TESTER
   AddTransportAdapter(ta);
 #endif
 
@@ -80,9 +80,6 @@ TransportManagerImpl::TransportManagerImpl()
       device_listener_thread_wakeup_(),
       is_initialized_(false),
       connection_id_counter_(0)
-#ifdef TIME_TESTER
-      , metric_observer_(NULL)
-#endif  // TIME_TESTER
 {
   LOG4CXX_INFO(logger_, "==============================================");
 #ifdef USE_RWLOCK
@@ -728,11 +725,6 @@ void TransportManagerImpl::EventListenerThread(void) {
             break;
           }
           data->set_connection_key(connection->id);
-#ifdef TIME_TESTER
-          if (metric_observer_) {
-            metric_observer_->StopRawMsg(data.get());
-          }
-#endif  // TIME_TESTER
           RaiseEvent(&TransportManagerListener::OnTMMessageReceived, data);
           break;
         }
@@ -786,12 +778,6 @@ void TransportManagerImpl::EventListenerThread(void) {
   LOG4CXX_INFO(logger_, "Event listener thread finished");
 }
 
-#ifdef TIME_TESTER
-void TransportManagerImpl::SetTimeMetricObserver(TMMetricObserver* observer) {
-  metric_observer_ = observer;
-}
-#endif  // TIME_TESTER
-
 void* TransportManagerImpl::MessageQueueStartThread(void* data) {
   if (NULL != data) {
     static_cast<TransportManagerImpl*>(data)->MessageQueueThread();
@@ -46,6 +46,7 @@
 #include "transport_manager/usb/libusb/usb_connection.h"
 #include "transport_manager/transport_adapter/transport_adapter_impl.h"
 
+#include "config_profile/profile.h"
 #include "utils/logger.h"
 
 namespace transport_manager {
@@ -74,28 +75,34 @@ UsbConnection::UsbConnection(const DeviceUID& device_uid,
       in_endpoint_max_packet_size_(0),
       out_endpoint_(0),
       out_endpoint_max_packet_size_(0),
-      in_buffer_(0),
-      in_transfer_(0),
+      in_transfer_size_(0),
+      out_transfer_max_size_(0),
+      in_transfers_(),
+      in_submitted_(),
+      in_completed_(),
+      in_transfers_mutex_(),
       out_transfer_(0),
       out_messages_(),
-      current_out_message_(),
+      out_batch_(),
+      out_buffer_(),
+      out_data_(0),
+      out_data_size_(0),
       out_messages_mutex_(),
       bytes_sent_(0),
       disconnecting_(false),
-      waiting_in_transfer_cancel_(false),
-      waiting_out_transfer_cancel_(false) {
+      aborted_(false) {
+  pthread_mutex_init(&in_transfers_mutex_, 0);
   pthread_mutex_init(&out_messages_mutex_, 0);
 }
 
 UsbConnection::~UsbConnection() {
   Finalise();
-  if (in_transfer_) {
-    libusb_free_transfer(in_transfer_);
-  }
-  if (in_buffer_) {
-    delete[] in_buffer_;
+  FreeInTransfers();
+  if (out_transfer_) {
+    libusb_free_transfer(out_transfer_);
   }
   pthread_mutex_destroy(&out_messages_mutex_);
+  pthread_mutex_destroy(&in_transfers_mutex_);
 }
 
 void LIBUSB_CALL InTransferCallback(libusb_transfer* transfer) {
@@ -106,130 +113,208 @@ void LIBUSB_CALL OutTransferCallback(libusb_transfer* transfer) {
   static_cast<UsbConnection*>(transfer->user_data)->OnOutTransfer(transfer);
 }
 
-bool UsbConnection::PostInTransfer() {
-  libusb_fill_bulk_transfer(in_transfer_, device_handle_, in_endpoint_,
-                            in_buffer_, in_endpoint_max_packet_size_,
-                            InTransferCallback, this, 0);
-  const int libusb_ret = libusb_submit_transfer(in_transfer_);
+bool UsbConnection::AllocateInTransfers() {
+  const uint32_t count = profile::Profile::instance()->usb_in_transfers_count();
+  for (uint32_t i = 0; i < count; ++i) {
+    libusb_transfer* transfer = libusb_alloc_transfer(0);
+    if (0 == transfer) {
+      LOG4CXX_ERROR(logger_, "libusb_alloc_transfer failed");
+      return false;
+    }
+    unsigned char* buffer = new unsigned char[in_transfer_size_];
+    libusb_fill_bulk_transfer(transfer, device_handle_, in_endpoint_,
+                              buffer, in_transfer_size_,
+                              InTransferCallback, this, 0);
+    in_transfers_.push_back(transfer);
+  }
+  return true;
+}
+
+void UsbConnection::FreeInTransfers() {
+  for (std::vector<libusb_transfer*>::iterator it = in_transfers_.begin();
+       it != in_transfers_.end(); ++it) {
+    delete[] (*it)->buffer;
+    libusb_free_transfer(*it);
+  }
+  in_transfers_.clear();
+}
+
+bool UsbConnection::PostInTransfer(libusb_transfer* transfer) {
+  transfer->length = in_transfer_size_;
+  const int libusb_ret = libusb_submit_transfer(transfer);
   if (LIBUSB_SUCCESS != libusb_ret) {
     LOG4CXX_ERROR(logger_, "libusb_submit_transfer failed: "
                                << libusb_error_name(libusb_ret));
     return false;
   }
+  in_submitted_.push_back(transfer);
   return true;
 }
 
 void UsbConnection::OnInTransfer(libusb_transfer* transfer) {
-  if (transfer->status == LIBUSB_TRANSFER_COMPLETED) {
+  bool abort = false;
+  pthread_mutex_lock(&in_transfers_mutex_);
+  in_completed_.insert(transfer);
+  // bulk transfers of one endpoint are filled in submission order,
+  // deliver them in the same order whatever order the callbacks come in
+  while (!in_submitted_.empty() &&
+         in_completed_.count(in_submitted_.front())) {
+    libusb_transfer* done = in_submitted_.front();
+    in_submitted_.pop_front();
+    in_completed_.erase(done);
+
+    if (done->status == LIBUSB_TRANSFER_COMPLETED) {
+      if (done->actual_length > 0) {
+        RawMessageSptr data(new protocol_handler::RawMessage(
+            0, 0, done->buffer, done->actual_length));
+        controller_->DataReceiveDone(device_uid_, app_handle_, data);
+      }
+    } else if (!disconnecting_ || done->status != LIBUSB_TRANSFER_CANCELLED) {
+      LOG4CXX_ERROR(logger_, "USB transfer failed: " << done->status);
+      controller_->DataReceiveFailed(device_uid_, app_handle_,
+                                     DataReceiveError());
+    }
 
-    RawMessageSptr data(new protocol_handler::RawMessage(
-        0, 0, in_buffer_, transfer->actual_length));
-  //PRINTMSG(1, (L"\n%s, line:%d\n", __FUNCTIONW__, __LINE__));
-    controller_->DataReceiveDone(device_uid_, app_handle_, data);
-  } else {
-    LOG4CXX_ERROR(logger_, "USB transfer failed: " << transfer->status);
-    controller_->DataReceiveFailed(device_uid_, app_handle_,
-                                   DataReceiveError());
+    if (!disconnecting_ && !abort && !PostInTransfer(done)) {
+      abort = true;
+    }
   }
-  if (disconnecting_) {
-    waiting_in_transfer_cancel_ = false;
+  pthread_mutex_unlock(&in_transfers_mutex_);
+
+  if (abort) {
+    Abort();
   } else {
-    if (!PostInTransfer()) {
-      controller_->ConnectionAborted(device_uid_, app_handle_,
-                                     CommunicationError());
-      Disconnect();
-    }
+    FinishAbort();
   }
 }
 
-void UsbConnection::PopOutMessage() {
-  bytes_sent_ = 0;
-  if (out_messages_.empty()) {
-    current_out_message_.reset();
-  } else {
-    current_out_message_ = out_messages_.front();
+void UsbConnection::StartOutTransfer() {
+  // small messages are joined into one transfer, big one goes alone
+  // without copying
+  size_t batch_size = out_messages_.front()->data_size();
+  out_batch_.push_back(out_messages_.front());
+  out_messages_.pop_front();
+  while (!out_messages_.empty() &&
+         batch_size + out_messages_.front()->data_size() <=
+             out_transfer_max_size_) {
+    batch_size += out_messages_.front()->data_size();
+    out_batch_.push_back(out_messages_.front());
     out_messages_.pop_front();
-    PostOutTransfer();
   }
+
+  if (1 == out_batch_.size()) {
+    out_data_ = out_batch_.front()->data();
+    out_data_size_ = out_batch_.front()->data_size();
+  } else {
+    out_buffer_.clear();
+    out_buffer_.reserve(batch_size);
+    for (std::list<RawMessageSptr>::const_iterator it = out_batch_.begin();
+         it != out_batch_.end(); ++it) {
+      out_buffer_.insert(out_buffer_.end(), (*it)->data(),
+                         (*it)->data() + (*it)->data_size());
+    }
+    out_data_ = &out_buffer_[0];
+    out_data_size_ = out_buffer_.size();
+  }
+  bytes_sent_ = 0;
 }
 
 bool UsbConnection::PostOutTransfer() {
-  out_transfer_ = libusb_alloc_transfer(0);
-  if (0 == out_transfer_) {
-    LOG4CXX_ERROR(logger_, "libusb_alloc_transfer failed");
-    return false;
-  }
   libusb_fill_bulk_transfer(out_transfer_, device_handle_, out_endpoint_,
-                            current_out_message_->data() + bytes_sent_,
-                            current_out_message_->data_size() - bytes_sent_,
+                            out_data_ + bytes_sent_,
+                            out_data_size_ - bytes_sent_,
                             OutTransferCallback, this, 0);
   const int libusb_ret = libusb_submit_transfer(out_transfer_);
   if (LIBUSB_SUCCESS != libusb_ret) {
     LOG4CXX_ERROR(logger_, "libusb_submit_transfer failed: "
                                << libusb_error_name(libusb_ret));
-    controller_->ConnectionAborted(device_uid_, app_handle_,
-                                   CommunicationError());
-    Disconnect();
     return false;
   }
   return true;
 }
 
+void UsbConnection::CompleteOutTransfer(bool success) {
+  for (std::list<RawMessageSptr>::const_iterator it = out_batch_.begin();
+       it != out_batch_.end(); ++it) {
+    if (success) {
+      LOG4CXX_INFO(logger_, "USB out transfer, data sent: " << it->get());
+      controller_->DataSendDone(device_uid_, app_handle_, *it);
+    } else {
+      controller_->DataSendFailed(device_uid_, app_handle_, *it,
+                                  DataSendError());
+    }
+  }
+  out_batch_.clear();
+  out_data_ = 0;
+  out_data_size_ = 0;
+}
+
 void UsbConnection::OnOutTransfer(libusb_transfer* transfer) {
+  bool abort = false;
   pthread_mutex_lock(&out_messages_mutex_);
   if (transfer->status == LIBUSB_TRANSFER_COMPLETED) {
     bytes_sent_ += transfer->actual_length;
-    if (bytes_sent_ == current_out_message_->data_size()) {
-      LOG4CXX_INFO(logger_, "USB out transfer, data sent: "
-                                << current_out_message_.get());
-      controller_->DataSendDone(device_uid_, app_handle_, current_out_message_);
-      PopOutMessage();
+    if (bytes_sent_ < out_data_size_ && !disconnecting_) {
+      if (!PostOutTransfer()) {
+        CompleteOutTransfer(false);
+        abort = true;
+      }
+    } else {
+      CompleteOutTransfer(bytes_sent_ == out_data_size_);
     }
   } else {
-    LOG4CXX_ERROR(logger_, "USB transfer failed: " << transfer->status);
-    controller_->DataSendFailed(device_uid_, app_handle_, current_out_message_,
-                                DataSendError());
-    PopOutMessage();
+    if (!disconnecting_ || transfer->status != LIBUSB_TRANSFER_CANCELLED) {
+      LOG4CXX_ERROR(logger_, "USB transfer failed: " << transfer->status);
+    }
+    CompleteOutTransfer(false);
+  }
+
+  if (!abort && 0 == out_data_ && !disconnecting_ && !out_messages_.empty()) {
+    StartOutTransfer();
+    if (!PostOutTransfer()) {
+      CompleteOutTransfer(false);
+      abort = true;
+    }
   }
-  libusb_free_transfer(transfer);
-  out_transfer_ = 0;
   pthread_mutex_unlock(&out_messages_mutex_);
-  waiting_out_transfer_cancel_ = false;
+
+  if (abort) {
+    Abort();
+  } else {
+    FinishAbort();
+  }
 }
 
 TransportAdapter::Error UsbConnection::SendData(RawMessageSptr message) {
+  bool abort = false;
+  pthread_mutex_lock(&out_messages_mutex_);
   if (disconnecting_) {
+    pthread_mutex_unlock(&out_messages_mutex_);
     return TransportAdapter::BAD_STATE;
   }
-  pthread_mutex_lock(&out_messages_mutex_);
-  if (current_out_message_.valid()) {
-    out_messages_.push_back(message);
-  } else {
-    current_out_message_ = message;
+  out_messages_.push_back(message);
+  if (0 == out_data_) {
+    StartOutTransfer();
     if (!PostOutTransfer()) {
-      controller_->DataSendFailed(device_uid_, app_handle_, message,
-                                  DataSendError());
+      CompleteOutTransfer(false);
+      abort = true;
     }
   }
   pthread_mutex_unlock(&out_messages_mutex_);
+
+  if (abort) {
+    Abort();
+  }
   return TransportAdapter::OK;
 }
 
-void UsbConnection::Finalise() {
-  LOG4CXX_INFO(logger_, "Finalise USB connection " << device_uid_);
+void UsbConnection::CancelTransfers() {
   pthread_mutex_lock(&out_messages_mutex_);
+  pthread_mutex_lock(&in_transfers_mutex_);
   disconnecting_ = true;
-  if (out_transfer_) {
-    waiting_out_transfer_cancel_ = true;
-    if (LIBUSB_SUCCESS != libusb_cancel_transfer(out_transfer_)) {
-      waiting_out_transfer_cancel_ = false;
-    }
-  }
-  if (in_transfer_) {
-    waiting_in_transfer_cancel_ = true;
-    if (LIBUSB_SUCCESS != libusb_cancel_transfer(in_transfer_)) {
-      waiting_in_transfer_cancel_ = false;
-    }
+  pthread_mutex_unlock(&in_transfers_mutex_);
+  if (out_data_) {
+    libusb_cancel_transfer(out_transfer_);
   }
   for (std::list<RawMessageSptr>::iterator it = out_messages_.begin();
        it != out_messages_.end(); it = out_messages_.erase(it)) {
@@ -237,7 +322,67 @@ void UsbConnection::Finalise() {
   }
   pthread_mutex_unlock(&out_messages_mutex_);
 
-  while (waiting_in_transfer_cancel_ || waiting_out_transfer_cancel_) {
+  pthread_mutex_lock(&in_transfers_mutex_);
+  for (std::deque<libusb_transfer*>::iterator it = in_submitted_.begin();
+       it != in_submitted_.end(); ++it) {
+    if (0 == in_completed_.count(*it)) {
+      libusb_cancel_transfer(*it);
+    }
+  }
+  pthread_mutex_unlock(&in_transfers_mutex_);
+}
+
+bool UsbConnection::TransfersPending() {
+  pthread_mutex_lock(&out_messages_mutex_);
+  const bool out_pending = 0 != out_data_;
+  pthread_mutex_unlock(&out_messages_mutex_);
+
+  pthread_mutex_lock(&in_transfers_mutex_);
+  const bool in_pending = !in_submitted_.empty();
+  pthread_mutex_unlock(&in_transfers_mutex_);
+
+  return out_pending || in_pending;
+}
+
+void UsbConnection::Abort() {
+  controller_->ConnectionAborted(device_uid_, app_handle_,
+                                 CommunicationError());
+  CancelTransfers();
+  // callbacks of cancelled transfers come from the thread of libusb events,
+  // which may be the current one, so waiting for them here is not possible
+  pthread_mutex_lock(&in_transfers_mutex_);
+  aborted_ = true;
+  pthread_mutex_unlock(&in_transfers_mutex_);
+  FinishAbort();
+}
+
+void UsbConnection::FinishAbort() {
+  pthread_mutex_lock(&out_messages_mutex_);
+  const bool out_pending = 0 != out_data_;
+  pthread_mutex_unlock(&out_messages_mutex_);
+
+  bool done = false;
+  pthread_mutex_lock(&in_transfers_mutex_);
+  if (aborted_ && !out_pending && in_submitted_.empty()) {
+    aborted_ = false;
+    done = true;
+  }
+  pthread_mutex_unlock(&in_transfers_mutex_);
+
+  if (done) {
+    LOG4CXX_INFO(logger_, "USB disconnect done " << device_uid_);
+    controller_->DisconnectDone(device_uid_, app_handle_);
+  }
+}
+
+void UsbConnection::Finalise() {
+  LOG4CXX_INFO(logger_, "Finalise USB connection " << device_uid_);
+  CancelTransfers();
+  pthread_mutex_lock(&in_transfers_mutex_);
+  aborted_ = false;
+  pthread_mutex_unlock(&in_transfers_mutex_);
+
+  while (TransfersPending()) {
    //the equivalent API  pthread_yield is Sleep(0) for windows and wince or usleep(0) for android
 #ifdef OS_ANDROID
    usleep(150000);//150000us==150ms
@@ -264,24 +409,39 @@ bool UsbConnection::Init() {
     return false;
   }
 
-  in_buffer_ = new unsigned char[in_endpoint_max_packet_size_];
-  if (0 == in_buffer_) {
-    LOG4CXX_ERROR(logger_, "in buffer allocation failed (size "
-                               << in_endpoint_max_packet_size_ << ")");
+  // buffer of IN transfer must hold whole packets, otherwise a packet
+  // which does not fit is an overflow error
+  const uint32_t packet_size = in_endpoint_max_packet_size_;
+  in_transfer_size_ = profile::Profile::instance()->usb_in_transfer_size();
+  in_transfer_size_ =
+      (in_transfer_size_ + packet_size - 1) / packet_size * packet_size;
+  if (in_transfer_size_ < packet_size) {
+    in_transfer_size_ = packet_size;
+  }
+  out_transfer_max_size_ =
+      profile::Profile::instance()->usb_out_transfer_max_size();
+
+  if (!AllocateInTransfers()) {
     return false;
   }
 
-  in_transfer_ = libusb_alloc_transfer(0);
-  if (0 == in_transfer_) {
+  out_transfer_ = libusb_alloc_transfer(0);
+  if (0 == out_transfer_) {
     LOG4CXX_ERROR(logger_, "libusb_alloc_transfer failed");
     return false;
   }
 
   controller_->ConnectDone(device_uid_, app_handle_);
-  if (!PostInTransfer()) {
-    controller_->ConnectionAborted(device_uid_, app_handle_,
-                                   CommunicationError());
-    return true;
+
+  bool posted = true;
+  pthread_mutex_lock(&in_transfers_mutex_);
+  for (std::vector<libusb_transfer*>::iterator it = in_transfers_.begin();
+       it != in_transfers_.end() && posted; ++it) {
+    posted = PostInTransfer(*it);
+  }
+  pthread_mutex_unlock(&in_transfers_mutex_);
+  if (!posted) {
+    Abort();
   }
 #endif
 
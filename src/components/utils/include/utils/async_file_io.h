@@ -0,0 +1,220 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef SRC_COMPONENTS_UTILS_INCLUDE_UTILS_ASYNC_FILE_IO_H_
+#define SRC_COMPONENTS_UTILS_INCLUDE_UTILS_ASYNC_FILE_IO_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "utils/conditional_variable.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+#include "utils/shared_buffer.h"
+#include "utils/shared_ptr.h"
+#include "utils/singleton.h"
+
+namespace threads {
+class Thread;
+}
+
+namespace file_system {
+
+/**
+ * @brief Writes files on small pool of worker threads, so callers
+ * are not blocked by storage latency.
+ *
+ * Writes of one file are done in posting order, one worker at a time,
+ * writes of different files are done in parallel. All writes queued for
+ * the file are done as single batch: file is opened once, contiguous
+ * writes are joined into one vectored write and file is synced once if
+ * any write of the batch requested it.
+ */
+class AsyncFileIO : public utils::Singleton<AsyncFileIO> {
+ public:
+  enum SyncPolicy {
+    // Data may stay in page cache when completion is called
+    kNoSync = 0,
+    // Data is flushed to storage device before completion is called
+    kSyncData
+  };
+
+  class Completion {
+   public:
+    virtual ~Completion() {
+    }
+
+    /**
+     * @brief Called on worker thread once write is done
+     * @param file_name path to written file
+     * @param success true if all data is written and synced as requested
+     */
+    virtual void OnWriteCompleted(const std::string& file_name,
+                                  bool success) = 0;
+  };
+  typedef utils::SharedPtr<Completion> CompletionPtr;
+
+  /**
+   * @brief Queues write of data at given position
+   *
+   * @remark - create file if it doesn't exist
+   * @param file_name path to file
+   * @param data data to write, buffer is shared until write is done
+   * @param offset position in file, file is truncated if offset is 0
+   * @param sync_policy when data is considered written
+   * @param completion notified when write is done, may be NULL
+   * @param preallocate reserve disk space for the whole range before writing
+   */
+  void WriteAt(const std::string& file_name,
+               const utils::SharedBuffer& data,
+               uint32_t offset,
+               SyncPolicy sync_policy,
+               const CompletionPtr& completion,
+               bool preallocate = false);
+
+  /**
+   * @brief Queues write of data to the end of file
+   *
+   * @remark - create file if it doesn't exist
+   * @param file_name path to file
+   * @param data data to write, buffer is shared until write is done
+   * @param sync_policy when data is considered written
+   * @param completion notified when write is done, may be NULL
+   */
+  void Append(const std::string& file_name,
+              const utils::SharedBuffer& data,
+              SyncPolicy sync_policy,
+              const CompletionPtr& completion);
+
+  /**
+   * @brief Size file will have once queued writes are done
+   *
+   * @param file_name path to file
+   * @param size receives size of file
+   * @return false if no writes of file are queued, size is not changed then
+   */
+  bool PendingFileSize(const std::string& file_name, uint32_t* size) const;
+
+  /**
+   * @brief Waits until all writes of file queued so far are done
+   * @param file_name path to file
+   */
+  void Flush(const std::string& file_name);
+
+  /**
+   * @brief Returns number of writes which are queued but not done yet
+   */
+  size_t PendingWrites() const;
+
+ private:
+  class Worker;
+
+  struct Write {
+    utils::SharedBuffer data;
+    uint32_t offset;
+    bool append;
+    bool preallocate;
+    SyncPolicy sync_policy;
+    CompletionPtr completion;
+  };
+  typedef std::deque<Write> Writes;
+
+  struct File {
+    File()
+      : id(0),
+        size(0),
+        posted(0),
+        done(0),
+        busy(false) {
+    }
+    // Distinguishes entries created for the same file one after another
+    uint32_t id;
+    // Writes not taken by worker yet
+    Writes writes;
+    // Size of file after all queued writes
+    uint32_t size;
+    // Number of posted and done writes, used by Flush
+    uint32_t posted;
+    uint32_t done;
+    // Batch of file is being written by worker now
+    bool busy;
+  };
+  typedef std::map<std::string, File> Files;
+
+  AsyncFileIO();
+  ~AsyncFileIO();
+
+  /**
+   * @brief Adds write to queue of file
+   */
+  void Post(const std::string& file_name, const Write& write);
+
+  /**
+   * @brief Writes batches of ready files until service is stopped.
+   * Called on worker threads.
+   */
+  void WorkerLoop();
+
+  /**
+   * @brief Lets workers exit as soon as all queued writes are done
+   */
+  void Stop();
+
+  /**
+   * @brief Does batch of writes of one file and notifies completions
+   */
+  static void WriteBatch(const std::string& file_name, const Writes& batch);
+
+  Files files_;
+  // Files which have queued writes and are not written by any worker
+  std::deque<std::string> ready_files_;
+  size_t pending_writes_;
+  uint32_t next_file_id_;
+  bool stopping_;
+  mutable sync_primitives::Lock lock_;
+  sync_primitives::ConditionalVariable file_ready_;
+  sync_primitives::ConditionalVariable file_done_;
+  std::vector<threads::Thread*> workers_;
+
+  FRIEND_BASE_SINGLETON_CLASS(AsyncFileIO);
+  DISALLOW_COPY_AND_ASSIGN(AsyncFileIO);
+};
+
+}  // namespace file_system
+
+#endif  // SRC_COMPONENTS_UTILS_INCLUDE_UTILS_ASYNC_FILE_IO_H_
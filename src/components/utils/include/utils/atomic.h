@@ -73,6 +73,20 @@
 #define atomic_post_dec(ptr) (*(ptr))--
 #endif
 
+// Stores desired value if *ptr equals expected one, evaluates to previous
+// value of *ptr
+#if defined(__GNUG__)
+#define atomic_val_cas(ptr, expected, desired) \
+  __sync_val_compare_and_swap((ptr), (expected), (desired))
+#elif defined(_MSC_VER) && (_MSC_VER >= 1200)
+#define atomic_val_cas(ptr, expected, desired) \
+  ::InterlockedCompareExchange((volatile LONG*)(ptr), (desired), (expected))
+#else
+#warning "atomic_val_cas() implementation is not atomic"
+#define atomic_val_cas(ptr, expected, desired) \
+  (*(ptr) == (expected) ? (*(ptr) = (desired), (expected)) : *(ptr))
+#endif
+
 #if defined(_QNXNTO__)
 // on QNX pointer assignment is believed to be atomic
 #define atomic_pointer_assign(dst, src) (dst) = (src)
@@ -33,6 +33,7 @@
 #define SRC_COMPONENTS_UTILS_INCLUDE_UTILS_DATE_TIME_H_
 
 #if defined(OS_POSIX)
+#include <stdint.h>
 #include <sys/time.h>
 typedef struct timeval TimevalStruct;
 #endif
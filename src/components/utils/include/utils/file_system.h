@@ -119,6 +119,47 @@ bool Write(const std::string& file_name,
 		   const std::string& data,
            std::ios_base::openmode mode = std::ios_base::out);
 #endif
+/**
+  * @brief Writes data to file at given position with single positional
+  * write, no intermediate stream buffering is involved
+  *
+  * @remark - create file if it doesn't exist
+  * @param file_name path to file
+  * @param data data to write
+  * @param data_size size of data to write
+  * @param offset position in file, file is truncated if offset is 0
+  * @param preallocate reserve disk space for the whole range before writing
+  * @return returns true if the operation is successfully.
+  */
+bool WriteAt(const std::string& file_name,
+             const uint8_t* data,
+             uint32_t data_size,
+             uint32_t offset,
+             bool preallocate = false);
+
+/**
+  * @brief Appends data to the end of file
+  *
+  * @remark - create file if it doesn't exist
+  * @param file_name path to file
+  * @param data data to write
+  * @param data_size size of data to write
+  * @param sync flush written data to the storage device before return
+  * @return returns true if the operation is successfully.
+  */
+bool Append(const std::string& file_name,
+            const uint8_t* data,
+            uint32_t data_size,
+            bool sync = false);
+
+/**
+  * @brief Flushes written data of file to the storage device
+  *
+  * @param file_name path to file
+  * @return returns true if the operation is successfully.
+  */
+bool SyncFile(const std::string& file_name);
+
 /**
   * @brief Opens file stream for writing
   * @param file_name path to file to write data to
@@ -161,6 +202,17 @@ std::string CurrentWorkingDirectory();
   */
 bool DeleteFile(const std::string& name);
 
+/**
+  * @brief Renames file, existing destination file is replaced
+  *
+  * @remark - on WinCE destination file is deleted first, so interrupted
+  * rename may leave old_name only
+  * @param old_name path to file to be renamed
+  * @param new_name new path to file
+  * @return returns true if the file is successfully renamed.
+  */
+bool RenameFile(const std::string& old_name, const std::string& new_name);
+
 /**
  * @brief Removes directory.
  *
@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SRC_COMPONENTS_UTILS_INCLUDE_UTILS_LATENCY_HISTOGRAM_H_
+#define SRC_COMPONENTS_UTILS_INCLUDE_UTILS_LATENCY_HISTOGRAM_H_
+
+#include <stdint.h>
+
+#include "utils/macro.h"
+
+namespace utils {
+
+/**
+ * @brief Log-linear histogram of latencies in microseconds.
+ *
+ * Every power of two range is split into kSubBuckets equal buckets, so
+ * recorded value is known with error below 1/kSubBuckets. Recording is
+ * a single atomic increment into one of kShards copies of counters,
+ * chosen by calling thread, so concurrent writers rarely share a cache
+ * line. Reading sums the shards and never blocks writers.
+ */
+class LatencyHistogram {
+ public:
+  static const uint32_t kSubBucketBits = 4;
+  static const uint32_t kSubBuckets = 1 << kSubBucketBits;
+  static const uint32_t kBucketsCount = (32 - kSubBucketBits + 1) * kSubBuckets;
+  static const uint32_t kShards = 4;
+
+  /**
+   * @brief Counters of all buckets summed over shards
+   */
+  struct Snapshot {
+    uint32_t buckets[kBucketsCount];
+    uint32_t count;
+
+    /**
+     * @brief Value below which given part of recorded values lies
+     * @param percentile part of values in percents, e.g. 99.9
+     * @return upper bound of bucket containing percentile, 0 if empty
+     */
+    uint32_t Percentile(double percentile) const;
+    /**
+     * @brief Upper bound of highest non empty bucket, 0 if empty
+     */
+    uint32_t Max() const;
+  };
+
+  LatencyHistogram();
+
+  /**
+   * @brief Record single value
+   * @param value latency in microseconds
+   */
+  void Record(uint32_t value);
+
+  /**
+   * @brief Fill snapshot with current counters
+   */
+  void GetSnapshot(Snapshot* snapshot) const;
+
+  /**
+   * @brief Bucket index for value
+   */
+  static uint32_t BucketIndex(uint32_t value);
+
+  /**
+   * @brief Max value which falls into bucket
+   */
+  static uint32_t BucketUpperBound(uint32_t index);
+
+ private:
+  volatile uint32_t counters_[kShards][kBucketsCount];
+
+  DISALLOW_COPY_AND_ASSIGN(LatencyHistogram);
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_UTILS_INCLUDE_UTILS_LATENCY_HISTOGRAM_H_
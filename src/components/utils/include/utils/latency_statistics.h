@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SRC_COMPONENTS_UTILS_INCLUDE_UTILS_LATENCY_STATISTICS_H_
+#define SRC_COMPONENTS_UTILS_INCLUDE_UTILS_LATENCY_STATISTICS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#include "utils/date_time.h"
+#include "utils/latency_histogram.h"
+#include "utils/macro.h"
+#include "utils/singleton.h"
+
+namespace utils {
+
+/**
+ * @brief Always on latency statistics of message processing pipeline.
+ *
+ * Holds histogram for every pipeline stage and counters of processed
+ * RPCs. Nothing is serialized while recording, statistics is formatted
+ * only when snapshot is requested.
+ */
+class LatencyStatistics : public utils::Singleton<LatencyStatistics> {
+ public:
+  enum Stage {
+    // Raw data received by transport adapter - frames parsed by protocol handler
+    kTransportReceive = 0,
+    // Message assembled by protocol handler - queued by application manager
+    kProtocolHandling,
+    // Mobile request command Run, usually ends with HMI request sent
+    kCommandRun,
+    // HMI request sent - HMI response received
+    kHMIRoundTrip,
+    // HMI response processing, usually ends with mobile response sent
+    kHMIResponseHandling,
+    // Mobile request command Run - response sent to mobile
+    kMobileRequest,
+    kStagesCount
+  };
+
+  enum RpcOrigin {
+    kMobileRpc = 0,
+    kHMIRpc,
+    kRpcOriginsCount
+  };
+
+  /**
+   * @brief Record latency of stage
+   * @param stage pipeline stage
+   * @param begin time stage began, stage ends now
+   */
+  void Record(Stage stage, const TimevalStruct& begin);
+
+  /**
+   * @brief Record latency of stage
+   * @param stage pipeline stage
+   * @param microseconds stage duration
+   */
+  void Record(Stage stage, uint32_t microseconds);
+
+  /**
+   * @brief Remember start of stage which ends in another place
+   * @param stage pipeline stage
+   * @param key identifier of processed message, e.g. correlation id
+   */
+  void Start(Stage stage, uint32_t key);
+
+  /**
+   * @brief Record latency of stage started with same key, if any
+   * @param stage pipeline stage
+   * @param key identifier of processed message, e.g. correlation id
+   */
+  void Stop(Stage stage, uint32_t key);
+
+  /**
+   * @brief Count processed RPC
+   * @param origin interface RPC belongs to
+   * @param function_id RPC function id
+   */
+  void CountRpc(RpcOrigin origin, int32_t function_id);
+
+  /**
+   * @brief Format statistics as compact JSON
+   *
+   * Does not allocate memory.
+   * @param buffer destination, result is always null terminated
+   * @param size size of buffer
+   * @return length of written text
+   */
+  size_t Snapshot(char* buffer, size_t size) const;
+
+  /**
+   * @brief Format statistics as compact JSON
+   */
+  std::string Snapshot() const;
+
+  /**
+   * @brief Name of stage used in snapshot
+   */
+  static const char* StageName(Stage stage);
+
+ private:
+  static const uint32_t kPendingSlots = 256;
+  static const uint32_t kRpcSlots = 512;
+
+  /**
+   * @brief Start of stage waiting for Stop, key 0 marks free slot
+   */
+  struct PendingSlot {
+    volatile uint32_t key;
+    volatile uint32_t start;
+  };
+
+  /**
+   * @brief Counter of RPC, function id is stored biased by one,
+   * 0 marks free slot
+   */
+  struct RpcSlot {
+    volatile int32_t function_id;
+    volatile uint32_t count;
+  };
+
+  LatencyStatistics();
+  ~LatencyStatistics();
+
+  static uint32_t Now();
+
+  LatencyHistogram histograms_[kStagesCount];
+  PendingSlot pending_[kStagesCount][kPendingSlots];
+  RpcSlot rpcs_[kRpcOriginsCount][kRpcSlots];
+
+  DISALLOW_COPY_AND_ASSIGN(LatencyStatistics);
+
+  FRIEND_BASE_SINGLETON_CLASS(LatencyStatistics);
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_UTILS_INCLUDE_UTILS_LATENCY_STATISTICS_H_
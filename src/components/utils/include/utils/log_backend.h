@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef SRC_COMPONENTS_UTILS_INCLUDE_UTILS_LOG_BACKEND_H_
+#define SRC_COMPONENTS_UTILS_INCLUDE_UTILS_LOG_BACKEND_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ostream>
+#include <string>
+
+// Messages below this level are removed at compile time
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 0
+#endif
+
+namespace utils {
+
+/**
+ * @brief Asynchronous logging backend used by LOG4CXX_* macros when
+ * log4cxx is not available (CUSTOM_LOG).
+ *
+ * Caller thread only formats message text into its own ring buffer
+ * together with timestamp and pointer to static call site, no lock is
+ * taken and no I/O is done. Single writer thread formats headers and
+ * writes records of all threads to the file in batches. When ring of
+ * the thread is full record is dropped and number of dropped records is
+ * reported in the log, unless blocking mode is configured.
+ */
+namespace logging {
+
+enum LogLevel {
+  kTrace = 0,
+  kDebug,
+  kInfo,
+  kWarn,
+  kError,
+  kFatal,
+  kOff
+};
+
+/**
+ * @brief Place of LOG4CXX_* macro, one static instance per macro
+ */
+struct CallSite {
+  const char* file;
+  const char* function;
+  int line;
+  LogLevel level;
+};
+
+/**
+ * @brief Runtime threshold, messages of lower levels are not formatted
+ */
+extern volatile int log_level_threshold;
+
+inline bool IsEnabled(LogLevel level) {
+  return level >= LOG_MIN_LEVEL && level >= log_level_threshold;
+}
+
+/**
+ * @brief Applies settings of properties file and starts writer
+ *
+ * Following keys are used:
+ * log4j.rootLogger - first item is threshold level
+ * log4j.appender.CustomLogFile.File - path to log file
+ * log4j.appender.CustomLogFile.BufferSize - bytes of ring buffer of
+ * every thread
+ * log4j.appender.CustomLogFile.Blocking - wait for space in ring buffer
+ * instead of dropping record when true
+ * @param properties_file path to properties file, defaults are used for
+ * missing keys
+ */
+void Init(const std::string& properties_file);
+
+/**
+ * @brief Writes all queued records, stops writer and closes log file
+ */
+void Deinit();
+
+/**
+ * @brief Waits until records queued by all threads so far are written
+ */
+void Flush();
+
+/**
+ * @brief Returns number of records dropped because ring was full
+ */
+uint32_t DroppedRecords();
+
+/**
+ * @brief Returns pointer to string equal to name which lives until
+ * program exits, used for names of loggers
+ */
+const char* InternName(const std::string& name);
+
+struct ThreadLog;
+
+/**
+ * @brief Captures one log record on caller thread, record is queued
+ * when message is destroyed
+ */
+class LogMessage {
+ public:
+  LogMessage(const CallSite& site, const char* logger_name);
+  ~LogMessage();
+
+  /**
+   * @brief Stream message text is formatted to
+   */
+  std::ostream& stream();
+
+ private:
+  ThreadLog* thread_log_;
+  const CallSite& site_;
+  const char* logger_name_;
+  // Message is logged while another one is formatted on the same thread
+  bool nested_;
+
+  LogMessage(const LogMessage&);
+  void operator=(const LogMessage&);
+};
+
+}  // namespace logging
+}  // namespace utils
+
+/**
+ * @brief Queues message if level is enabled, message expression is not
+ * evaluated otherwise
+ */
+#define LOG_WITH_LEVEL(logger_var, log_level, message) \
+  do { \
+    if (::utils::logging::IsEnabled(log_level)) { \
+      static const ::utils::logging::CallSite log_call_site = \
+          { __FILE__, __FUNCTION__, __LINE__, log_level }; \
+      ::utils::logging::LogMessage(log_call_site, \
+                                   (logger_var).name()).stream() << message; \
+    } \
+  } while (false)
+
+#endif  // SRC_COMPONENTS_UTILS_INCLUDE_UTILS_LOG_BACKEND_H_
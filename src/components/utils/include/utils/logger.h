@@ -40,8 +40,7 @@
   #include <log4cxx/propertyconfigurator.h>
 #else
     #include <string>
-    #include <fstream>
-    #include <ostream>
+    #include "utils/log_backend.h"
 #endif
 
 #if defined(OS_WIN32) 
@@ -87,14 +86,18 @@ namespace log4cxx {
     class LoggerPtr
     {
 	public:
-	LoggerPtr(){};
+	LoggerPtr() : name_("") {};
+	explicit LoggerPtr(const char* name) : name_(name) {};
+	const char* name() const { return name_; };
+	private:
+	const char* name_;
      };
     class Logger
     {
 	public:
         Logger(log4cxx::helpers::Pool& pool, const LogString& name){};
-	static LoggerPtr getLogger(const std::string& name){return LoggerPtr();};
-        static LoggerPtr getLogger(const char* const name){return LoggerPtr();};
+	static LoggerPtr getLogger(const std::string& name){return LoggerPtr(::utils::logging::InternName(name));};
+        static LoggerPtr getLogger(const char* const name){return LoggerPtr(::utils::logging::InternName(name));};
      };
 		
    	
@@ -106,44 +109,44 @@ namespace log4cxx {
     #define CREATE_LOGGERPTR_LOCAL(logger_var, logger_name) \
       log4cxx::LoggerPtr logger_var = log4cxx::LoggerPtr(log4cxx::Logger::getLogger(logger_name));
 
-    #define INIT_LOGGER(file_name) 
+    // Records are formatted and written by background thread of utils::logging
+    #define INIT_LOGGER(file_name) \
+      ::utils::logging::Init(file_name);
 
-    // without this line log4cxx threads continue using some instances destroyed by exit()
-    #define DEINIT_LOGGER() 
+    // writes queued records before exit
+    #define DEINIT_LOGGER() \
+      ::utils::logging::Deinit();
 
-    #define LOG4CXX_IS_TRACE_ENABLED(logger) logger->isTraceEnabled()
+    #define LOG4CXX_IS_TRACE_ENABLED(logger) ::utils::logging::IsEnabled(::utils::logging::kTrace)
 
-    
-   #define  LOGE(MSG)    {std::ofstream ff("/sdcard/sdllog.txt",std::iostream::out|std::iostream::app);ff<<"["<<__TIME__<<"]["<<__FILE__<<"]["<<__FUNCTION__<<"][Line:"<<__LINE__<<"]"<<MSG;ff.flush();ff.close();}
+	#define LOG4CXX_INFO(logger,message)     LOG_WITH_LEVEL(logger, ::utils::logging::kInfo, message)
+	#define LOG4CXX_ERROR(logger,message)    LOG_WITH_LEVEL(logger, ::utils::logging::kError, message)
+	#define LOG4CXX_TRACE(logger,message)    LOG_WITH_LEVEL(logger, ::utils::logging::kTrace, message)
+	#define LOG4CXX_WARN(logger,message)     LOG_WITH_LEVEL(logger, ::utils::logging::kWarn, message)
+	#define LOG4CXX_DEBUG(logger,message)    LOG_WITH_LEVEL(logger, ::utils::logging::kDebug, message)
+	#define LOG4CXX_FATAL(logger,message)    LOG_WITH_LEVEL(logger, ::utils::logging::kFatal, message)
 
-		
-	#define LOG4CXX_INFO(logger,message)     LOGE(message<<"\n") 
-	#define LOG4CXX_ERROR(logger,message)    LOGE(message<<"\n") 
-	#define LOG4CXX_TRACE(logger,message)  	LOGE(message<<"\n") 
-	#define LOG4CXX_WARN(logger,message)	  	LOGE(message<<"\n")   
-	#define LOG4CXX_DEBUG(logger,message)	  LOGE(message<<"\n")  
-	#define LOG4CXX_FATAL(logger,message)	  LOGE(message<<"\n")
-		
-		
-    #define LOG4CXX_INFO_EXT(logger, logEvent) LOGE(__PRETTY_FUNCTION__<<": "<<logEvent<<"\n")
-    #define LOG4CXX_INFO_STR_EXT(logger, logEvent) LOGE(__PRETTY_FUNCTION__ << ": " << logEvent<<"\n")
+    #define LOG4CXX_INFO_EXT(logger, logEvent) LOG4CXX_INFO(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
+    #define LOG4CXX_INFO_STR_EXT(logger, logEvent) LOG4CXX_INFO(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
+
+    #define LOG4CXX_TRACE_EXT(logger, logEvent) LOG4CXX_TRACE(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
+    #define LOG4CXX_TRACE_STR_EXT(logger, logEvent) LOG4CXX_TRACE(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
 
-    #define LOG4CXX_TRACE_EXT(logger, logEvent) LOGE(TYPE_TRACE_EXT,__PRETTY_FUNCTION__ << ": " << logEvent<<"\n")
-    #define LOG4CXX_TRACE_STR_EXT(logger, logEvent)  LOGE(__PRETTY_FUNCTION__ << ": " << logEvent<<"\n")
-    #define LOG4CXX_DEBUG_EXT(logger, logEvent)    LOGE(__PRETTY_FUNCTION__ << ": " << logEvent<<"\n")
-    #define LOG4CXX_DEBUG_STR_EXT(logger, logEvent)  LOGE(__PRETTY_FUNCTION__ << ": " << logEvent<<"\n")
-    #define LOG4CXX_WARN_EXT(logger, logEvent)   LOGE(__PRETTY_FUNCTION__ << ": " << logEvent<<"\n")
-    #define LOG4CXX_WARN_STR_EXT(logger, logEvent)   LOGE(__PRETTY_FUNCTION__ << ": " << logEvent<<"\n")
+    #define LOG4CXX_DEBUG_EXT(logger, logEvent) LOG4CXX_DEBUG(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
+    #define LOG4CXX_DEBUG_STR_EXT(logger, logEvent) LOG4CXX_DEBUG(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
 
-    #define LOG4CXX_ERROR_EXT(logger, logEvent)    LOGE(__PRETTY_FUNCTION__ << ": " << logEvent<<"\n")
-    #define LOG4CXX_ERROR_STR_EXT(logger, logEvent)    LOGE(__PRETTY_FUNCTION__ << ": " << logEvent<<"\n")
+    #define LOG4CXX_WARN_EXT(logger, logEvent) LOG4CXX_WARN(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
+    #define LOG4CXX_WARN_STR_EXT(logger, logEvent) LOG4CXX_WARN(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
 
-    #define LOG4CXX_FATAL_EXT(logger, logEvent)   LOGE(TYPE_FATAL_EXT,__PRETTY_FUNCTION__ << ": " << logEvent<<"\n") //LOG4CXX_FATAL(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
-    #define LOG4CXX_FATAL_STR_EXT(logger, logEvent)   LOGE(__PRETTY_FUNCTION__ << ": " << logEvent<<"\n") //LOG4CXX_FATAL_STR(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
+    #define LOG4CXX_ERROR_EXT(logger, logEvent) LOG4CXX_ERROR(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
+    #define LOG4CXX_ERROR_STR_EXT(logger, logEvent) LOG4CXX_ERROR(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
 
-    #define LOG4CXX_TRACE_ENTER(logger)   LOGE("ENTER:"<<__PRETTY_FUNCTION__<<"\n")//LOG4CXX_TRACE(logger, "ENTER: " << __PRETTY_FUNCTION__ )
-    #define LOG4CXX_TRACE_EXIT(logger)    LOGE("EXIT:"<<__PRETTY_FUNCTION__<<"\n")
-    #define LOG4CXX_ERROR_WITH_ERRNO(logger, message)    LOGE(message << ", error code " << errno << " (" << strerror(errno) << ")"<<"\n")
+    #define LOG4CXX_FATAL_EXT(logger, logEvent) LOG4CXX_FATAL(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
+    #define LOG4CXX_FATAL_STR_EXT(logger, logEvent) LOG4CXX_FATAL(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
+
+    #define LOG4CXX_TRACE_ENTER(logger) LOG4CXX_TRACE(logger, "ENTER: " << __PRETTY_FUNCTION__ )
+    #define LOG4CXX_TRACE_EXIT(logger) LOG4CXX_TRACE(logger, "EXIT: " << __PRETTY_FUNCTION__ )
+    #define LOG4CXX_ERROR_WITH_ERRNO(logger, message) LOG4CXX_ERROR(logger, message << ", error code " << errno << " (" << strerror(errno) << ")")
 	
 	#else // OS_Android
 
@@ -1,6 +1,5 @@
 /**
- *
- * Copyright (c) 2014, Ford Motor Company
+ * Copyright (c) 2013, Ford Motor Company
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -31,22 +30,53 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_JSON_KEYS_H_
-#define SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_JSON_KEYS_H_
-
-namespace time_tester {
-  namespace strings {
-    const char logger[] = "logger";
-    const char begin[] = "begin";
-    const char end[] = "end";
-    const char data_size[] = "data_size";
-    const char message_id[] = "message_id";
-    const char session_id[] = "session_id";
-    const char correlation_id[] = "correlation_id";
-    const char connection_key[] = "connection_key";
-    const char stime[] = "stime";
-    const char utime[] = "utime";
-    const char memory[] = "RAM";
-  }
-}
-#endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_JSON_KEYS_H_
+#ifndef SRC_COMPONENTS_UTILS_INCLUDE_UTILS_LZ4_H_
+#define SRC_COMPONENTS_UTILS_INCLUDE_UTILS_LZ4_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief Compression in LZ4 block format.
+ *
+ * Output is compatible with LZ4_decompress_safe() of reference library
+ * and blocks produced by LZ4_compress() are accepted by Decompress(),
+ * so mobile side may use any LZ4 implementation. Block does not contain
+ * decompressed size, it has to be transferred separately.
+ */
+namespace lz4 {
+
+/**
+ * @brief Max size of compressed block for input of given size
+ */
+size_t CompressBound(size_t size);
+
+/**
+ * @brief Compresses data into single block
+ * @param data bytes to compress
+ * @param size amount of bytes
+ * @param output receives compressed block, previous content is replaced
+ * @return size of compressed block
+ */
+size_t Compress(const uint8_t* data, size_t size,
+                std::vector<uint8_t>* output);
+
+/**
+ * @brief Decompresses single block
+ * @param data compressed block
+ * @param size size of block
+ * @param decompressed_size exact size of original data
+ * @param output receives original data, previous content is replaced
+ * @return false if block is malformed or does not match decompressed_size
+ */
+bool Decompress(const uint8_t* data, size_t size, size_t decompressed_size,
+                std::vector<uint8_t>* output);
+
+}  // namespace lz4
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_UTILS_INCLUDE_UTILS_LZ4_H_
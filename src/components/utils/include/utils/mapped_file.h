@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2014, Ford Motor Company
+ * Copyright (c) 2013, Ford Motor Company
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -30,30 +30,65 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_TIME_METRIC_OBSERVER_H_
-#define SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_TIME_METRIC_OBSERVER_H_
-#include "protocol_handler/raw_message.h"
+#ifndef SRC_COMPONENTS_UTILS_INCLUDE_UTILS_MAPPED_FILE_H_
+#define SRC_COMPONENTS_UTILS_INCLUDE_UTILS_MAPPED_FILE_H_
 
+#include <stddef.h>
 #include <stdint.h>
-#include "utils/date_time.h"
 
-namespace protocol_handler {
+#include <string>
 
-class PHMetricObserver {
+#include "utils/macro.h"
+
+namespace file_system {
+
+/**
+ * @brief Read-only mapping of whole file into memory.
+ *
+ * Pages are loaded by OS on first access, so large files are opened
+ * without copying them to heap. Mapping is released on Close or when
+ * object is destroyed.
+ */
+class MappedFile {
  public:
-  struct MessageMetric {
-    RawMessagePtr raw_msg;
-    uint32_t message_id;
-    uint8_t connection_key;
-    TimevalStruct begin;
-    TimevalStruct end;
-  };
+  MappedFile();
+  ~MappedFile();
+
   /**
+   * @brief Maps file, previous mapping is released
+   * @param name path to file
+   * @return false if file doesn't exist, is empty or can't be mapped
    */
-  virtual void StartMessageProcess(uint32_t message_id) = 0;
+  bool Open(const std::string& name);
 
-  virtual void EndMessageProcess(utils::SharedPtr<MessageMetric> m) = 0;
-  virtual ~PHMetricObserver(){}
+  /**
+   * @brief Releases mapping, data is not accessible anymore
+   */
+  void Close();
+
+  bool is_open() const {
+    return NULL != data_;
+  }
+
+  const uint8_t* data() const {
+    return data_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+#ifdef OS_WIN32
+  void* file_;
+  void* mapping_;
+#endif
+
+  DISALLOW_COPY_AND_ASSIGN(MappedFile);
 };
-}  // protocol_handler
-#endif  // SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_TIME_METRIC_OBSERVER_H_
+
+}  // namespace file_system
+
+#endif  // SRC_COMPONENTS_UTILS_INCLUDE_UTILS_MAPPED_FILE_H_
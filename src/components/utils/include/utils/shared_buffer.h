@@ -0,0 +1,195 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SRC_COMPONENTS_UTILS_INCLUDE_UTILS_SHARED_BUFFER_H_
+#define SRC_COMPONENTS_UTILS_INCLUDE_UTILS_SHARED_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+#include "utils/macro.h"
+#include "utils/shared_ptr.h"
+
+namespace utils {
+
+/**
+ * @brief Immutable reference counted byte buffer.
+ *
+ * Copying a buffer only increments the reference counter, so binary
+ * payloads (PutFile, SystemRequest etc.) can be handed over from the
+ * protocol layer down to the file system without duplicating the bytes.
+ * Slices share the storage of the buffer they were taken from.
+ */
+class SharedBuffer {
+ public:
+  /**
+   * @brief Creates empty buffer
+   */
+  SharedBuffer()
+    : offset_(0),
+      size_(0) {
+  }
+
+  /**
+   * @brief Creates buffer with a copy of given bytes
+   * @param data bytes to be copied
+   * @param size amount of bytes
+   */
+  SharedBuffer(const uint8_t* data, size_t size)
+    : storage_(new Storage()),
+      offset_(0),
+      size_(size) {
+    if (size) {
+      storage_->bytes = new uint8_t[size];
+      memcpy(storage_->bytes, data, size);
+    }
+  }
+
+  /**
+   * @brief Creates buffer with a copy of given vector
+   */
+  explicit SharedBuffer(const std::vector<uint8_t>& data)
+    : storage_(new Storage()),
+      offset_(0),
+      size_(data.size()) {
+    storage_->vector = data;
+  }
+
+  /**
+   * @brief Creates buffer taking ownership of array allocated with new[]
+   * @param data array to be owned by buffer, deleted with delete[]
+   * @param size amount of bytes in array
+   */
+  static SharedBuffer Adopt(uint8_t* data, size_t size) {
+    SharedBuffer buffer;
+    buffer.storage_.reset(new Storage());
+    buffer.storage_->bytes = data;
+    buffer.size_ = data ? size : 0;
+    return buffer;
+  }
+
+  /**
+   * @brief Creates buffer taking content of the vector without copying,
+   * |data| is left empty.
+   */
+  static SharedBuffer Adopt(std::vector<uint8_t>* data) {
+    DCHECK(data);
+    SharedBuffer buffer;
+    buffer.storage_.reset(new Storage());
+    buffer.storage_->vector.swap(*data);
+    buffer.size_ = buffer.storage_->vector.size();
+    return buffer;
+  }
+
+  /**
+   * @brief Pointer to the first byte or NULL for empty buffer
+   */
+  const uint8_t* data() const {
+    return size_ ? storage_->begin() + offset_ : NULL;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return 0 == size_;
+  }
+
+  const uint8_t* begin() const {
+    return data();
+  }
+
+  const uint8_t* end() const {
+    return data() + size_;
+  }
+
+  /**
+   * @brief Creates buffer which refers to the part of this one,
+   * bytes are not copied
+   * @param offset first byte of slice
+   * @param size amount of bytes in slice, trimmed to the end of buffer
+   */
+  SharedBuffer Slice(size_t offset, size_t size) const {
+    SharedBuffer slice;
+    if (offset >= size_) {
+      return slice;
+    }
+    slice.storage_ = storage_;
+    slice.offset_ = offset_ + offset;
+    slice.size_ = (size < size_ - offset) ? size : size_ - offset;
+    return slice;
+  }
+
+  /**
+   * @brief Copies content into vector, for the legacy interfaces only
+   */
+  std::vector<uint8_t> ToVector() const {
+    return std::vector<uint8_t>(begin(), end());
+  }
+
+  bool operator==(const SharedBuffer& other) const {
+    if (size_ != other.size_) {
+      return false;
+    }
+    return data() == other.data() || 0 == memcmp(data(), other.data(), size_);
+  }
+
+ private:
+  struct Storage {
+    Storage()
+      : bytes(NULL) {
+    }
+    ~Storage() {
+      delete[] bytes;
+    }
+    const uint8_t* begin() const {
+      return bytes ? bytes : &vector.front();
+    }
+
+    uint8_t* bytes;
+    std::vector<uint8_t> vector;
+
+   private:
+    DISALLOW_COPY_AND_ASSIGN(Storage);
+  };
+
+  SharedPtr<Storage> storage_;
+  size_t offset_;
+  size_t size_;
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_UTILS_INCLUDE_UTILS_SHARED_BUFFER_H_
@@ -38,6 +38,11 @@
 namespace utils {
 bool SubscribeToTerminateSignal(void (*func)(int32_t p));
 bool ResetSubscribeToTerminateSignal();
+/**
+ * @brief Subscribe to signal requesting dump of runtime statistics
+ * (SIGUSR1 where available)
+ */
+bool SubscribeToDumpSignal(void (*func)(int32_t p));
 void ForwardSignal();
 }  //  namespace utils
 
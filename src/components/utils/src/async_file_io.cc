@@ -0,0 +1,392 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef MODIFY_FUNCTION_SIGN
+#include <global_first.h>
+#endif
+#include "utils/async_file_io.h"
+
+#ifndef OS_WIN32
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <sstream>
+
+#include "utils/file_system.h"
+#include "utils/threads/thread.h"
+#include "utils/threads/thread_delegate.h"
+
+namespace file_system {
+
+namespace {
+
+const uint32_t kWorkersCount = 2;
+const size_t kWorkerStackSize = 65536;
+
+#ifndef OS_WIN32
+// Max writes joined into single vectored write, minimal IOV_MAX of POSIX
+const size_t kMaxJoinedWrites = 16;
+
+/**
+ * @brief Writes all buffers at given position, retries partial writes
+ */
+bool WriteVector(int fd, struct iovec* iov, size_t count, uint32_t offset) {
+  if (static_cast<off_t>(offset) != lseek(fd, offset, SEEK_SET)) {
+    return false;
+  }
+  while (count > 0) {
+    const ssize_t written = writev(fd, iov, count);
+    if (written < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      return false;
+    }
+    size_t left = written;
+    while (count > 0 && left >= iov->iov_len) {
+      left -= iov->iov_len;
+      ++iov;
+      --count;
+    }
+    if (count > 0) {
+      if (0 == written) {
+        // no progress, storage is full
+        return false;
+      }
+      iov->iov_base = static_cast<uint8_t*>(iov->iov_base) + left;
+      iov->iov_len -= left;
+    }
+  }
+  return true;
+}
+#endif
+
+}  // namespace
+
+class AsyncFileIO::Worker : public threads::ThreadDelegate {
+ public:
+  explicit Worker(AsyncFileIO* service)
+    : service_(service) {
+  }
+
+  virtual void threadMain() {
+    service_->WorkerLoop();
+  }
+
+  virtual bool exitThreadMain() {
+    service_->Stop();
+    // Prevent canceling thread until queued writes are done
+    return true;
+  }
+
+ private:
+  AsyncFileIO* service_;
+};
+
+AsyncFileIO::AsyncFileIO()
+  : pending_writes_(0),
+    next_file_id_(0),
+    stopping_(false) {
+  for (uint32_t i = 0; i < kWorkersCount; ++i) {
+    std::stringstream thread_name;
+    thread_name << "AsyncFileIO" << i;
+    threads::Thread* worker =
+        new threads::Thread(thread_name.str().c_str(), new Worker(this));
+    if (!worker->startWithOptions(threads::ThreadOptions(kWorkerStackSize))) {
+      delete worker;
+      continue;
+    }
+    workers_.push_back(worker);
+  }
+}
+
+AsyncFileIO::~AsyncFileIO() {
+  for (std::vector<threads::Thread*>::iterator it = workers_.begin();
+       workers_.end() != it; ++it) {
+    // joins worker after it has done all queued writes
+    (*it)->stop();
+    delete *it;
+  }
+  workers_.clear();
+}
+
+void AsyncFileIO::WriteAt(const std::string& file_name,
+                          const utils::SharedBuffer& data,
+                          uint32_t offset,
+                          SyncPolicy sync_policy,
+                          const CompletionPtr& completion,
+                          bool preallocate) {
+  Write write;
+  write.data = data;
+  write.offset = offset;
+  write.append = false;
+  write.preallocate = preallocate;
+  write.sync_policy = sync_policy;
+  write.completion = completion;
+  Post(file_name, write);
+}
+
+void AsyncFileIO::Append(const std::string& file_name,
+                         const utils::SharedBuffer& data,
+                         SyncPolicy sync_policy,
+                         const CompletionPtr& completion) {
+  Write write;
+  write.data = data;
+  write.offset = 0;
+  write.append = true;
+  write.preallocate = false;
+  write.sync_policy = sync_policy;
+  write.completion = completion;
+  Post(file_name, write);
+}
+
+bool AsyncFileIO::PendingFileSize(const std::string& file_name,
+                                  uint32_t* size) const {
+  DCHECK(size);
+  sync_primitives::AutoLock lock(lock_);
+  Files::const_iterator it = files_.find(file_name);
+  if (files_.end() == it) {
+    return false;
+  }
+  *size = it->second.size;
+  return true;
+}
+
+void AsyncFileIO::Flush(const std::string& file_name) {
+  sync_primitives::AutoLock lock(lock_);
+  Files::iterator it = files_.find(file_name);
+  if (files_.end() == it) {
+    return;
+  }
+  const uint32_t id = it->second.id;
+  const uint32_t posted = it->second.posted;
+  // entry is removed once all writes of file are done,
+  // entry created by later writes has another id
+  while (files_.end() != it && id == it->second.id &&
+         it->second.done < posted) {
+    file_done_.Wait(lock);
+    it = files_.find(file_name);
+  }
+}
+
+size_t AsyncFileIO::PendingWrites() const {
+  sync_primitives::AutoLock lock(lock_);
+  return pending_writes_;
+}
+
+void AsyncFileIO::Post(const std::string& file_name, const Write& write) {
+  if (workers_.empty()) {
+    // no worker could be started, write on caller thread
+    WriteBatch(file_name, Writes(1, write));
+    return;
+  }
+
+  const uint32_t data_size = write.data.size();
+  // Size on storage is needed unless the write replaces the whole file
+  const bool truncate = !write.append && 0 == write.offset;
+  const uint32_t stored_size = truncate ? 0 : file_system::FileSize(file_name);
+
+  sync_primitives::AutoLock lock(lock_);
+  Files::iterator it = files_.find(file_name);
+  if (files_.end() == it) {
+    it = files_.insert(std::make_pair(file_name, File())).first;
+    it->second.id = ++next_file_id_;
+    it->second.size = stored_size;
+  }
+
+  File& file = it->second;
+  if (write.append) {
+    file.size += data_size;
+  } else if (truncate) {
+    file.size = data_size;
+  } else {
+    file.size = std::max(file.size, write.offset + data_size);
+  }
+  file.writes.push_back(write);
+  ++file.posted;
+  ++pending_writes_;
+
+  if (!file.busy && 1 == file.writes.size()) {
+    ready_files_.push_back(file_name);
+    file_ready_.NotifyOne();
+  }
+}
+
+void AsyncFileIO::WorkerLoop() {
+  sync_primitives::AutoLock lock(lock_);
+  while (true) {
+    while (ready_files_.empty() && !stopping_) {
+      file_ready_.Wait(lock);
+    }
+    if (ready_files_.empty()) {
+      // stopping and nothing to write
+      break;
+    }
+
+    const std::string file_name = ready_files_.front();
+    ready_files_.pop_front();
+    Writes batch;
+    {
+      File& file = files_[file_name];
+      batch.swap(file.writes);
+      file.busy = true;
+    }
+
+    {
+      sync_primitives::AutoUnlock unlock(lock);
+      WriteBatch(file_name, batch);
+    }
+
+    pending_writes_ -= batch.size();
+    Files::iterator it = files_.find(file_name);
+    it->second.done += batch.size();
+    it->second.busy = false;
+    if (it->second.writes.empty()) {
+      files_.erase(it);
+    } else {
+      // writes posted meanwhile go after other ready files
+      ready_files_.push_back(file_name);
+      file_ready_.NotifyOne();
+    }
+    file_done_.Broadcast();
+  }
+}
+
+void AsyncFileIO::Stop() {
+  sync_primitives::AutoLock lock(lock_);
+  stopping_ = true;
+  file_ready_.Broadcast();
+}
+
+void AsyncFileIO::WriteBatch(const std::string& file_name,
+                             const Writes& batch) {
+  std::vector<bool> results(batch.size(), false);
+
+#ifdef OS_WIN32
+  bool sync = false;
+  for (size_t i = 0; i < batch.size(); ++i) {
+    const Write& write = batch[i];
+    results[i] = write.append ?
+        file_system::Append(file_name, write.data.data(), write.data.size()) :
+        file_system::WriteAt(file_name, write.data.data(), write.data.size(),
+                write.offset, write.preallocate);
+    sync = sync || kSyncData == write.sync_policy;
+  }
+  // One flush covers all writes of the batch
+  if (sync && !file_system::SyncFile(file_name)) {
+    for (size_t i = 0; i < batch.size(); ++i) {
+      if (kSyncData == batch[i].sync_policy) {
+        results[i] = false;
+      }
+    }
+  }
+#else
+  const int fd = open(file_name.c_str(), O_WRONLY | O_CREAT,
+                      S_IRUSR | S_IWUSR | S_IRGRP);
+  if (-1 != fd) {
+    bool sync = false;
+    size_t first = 0;
+    while (first < batch.size()) {
+      const Write& head = batch[first];
+      bool result = true;
+      uint32_t offset = head.offset;
+      if (head.append) {
+        struct stat file_info;
+        result = 0 == fstat(fd, &file_info);
+        offset = result ? file_info.st_size : 0;
+      } else if (0 == offset) {
+        result = 0 == ftruncate(fd, 0);
+      }
+
+      // Join following writes which continue the head one
+      struct iovec iov[kMaxJoinedWrites];
+      size_t count = 0;
+      uint32_t end = offset;
+      bool preallocate = false;
+      while (first + count < batch.size() && count < kMaxJoinedWrites) {
+        const Write& write = batch[first + count];
+        if (count > 0) {
+          const bool continues = head.append ? write.append :
+              !write.append && 0 != write.offset && end == write.offset;
+          if (!continues) {
+            break;
+          }
+        }
+        iov[count].iov_base = const_cast<uint8_t*>(write.data.data());
+        iov[count].iov_len = write.data.size();
+        end += write.data.size();
+        preallocate = preallocate || write.preallocate;
+        sync = sync || kSyncData == write.sync_policy;
+        ++count;
+      }
+
+#if defined(OS_LINUX) && !defined(OS_ANDROID)
+      if (result && preallocate && end > offset) {
+        // Failure is not fatal: file system may not support preallocation
+        posix_fallocate(fd, offset, end - offset);
+      }
+#endif
+      result = result && WriteVector(fd, iov, count, offset);
+      std::fill(results.begin() + first, results.begin() + first + count,
+                result);
+      first += count;
+    }
+
+#if defined(OS_LINUX)
+    const bool synced = !sync || 0 == fdatasync(fd);
+#else
+    const bool synced = !sync || 0 == fsync(fd);
+#endif
+    const bool closed = 0 == close(fd);
+    for (size_t i = 0; i < batch.size(); ++i) {
+      if (!closed || (!synced && kSyncData == batch[i].sync_policy)) {
+        results[i] = false;
+      }
+    }
+  }
+#endif
+
+  for (size_t i = 0; i < batch.size(); ++i) {
+    if (batch[i].completion) {
+      batch[i].completion->OnWriteCompleted(file_name, results[i]);
+    }
+  }
+}
+
+}  // namespace file_system
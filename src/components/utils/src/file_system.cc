@@ -51,6 +51,8 @@
 #include <sstream>
 
 #include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <unistd.h>
 #endif
 // TODO(VS): lint error: Streams are highly discouraged.
@@ -294,6 +296,141 @@ bool file_system::Write(
 }
 #endif
 
+bool file_system::WriteAt(const std::string& file_name,
+                          const uint8_t* data,
+                          uint32_t data_size,
+                          uint32_t offset,
+                          bool preallocate) {
+#ifdef OS_WIN32
+  std::ios_base::openmode mode = std::ios_base::binary | std::ios_base::out;
+  if (0 != offset) {
+    mode |= std::ios_base::in;
+  }
+  std::fstream file(file_name.c_str(), mode);
+  if (!file.is_open()) {
+    return false;
+  }
+  file.seekp(offset);
+  file.write(reinterpret_cast<const char*>(data), data_size);
+  return file.good();
+#else
+  int flags = O_WRONLY | O_CREAT;
+  if (0 == offset) {
+    flags |= O_TRUNC;
+  }
+  const int fd = open(file_name.c_str(), flags, S_IRUSR | S_IWUSR | S_IRGRP);
+  if (-1 == fd) {
+    return false;
+  }
+
+#if defined(OS_LINUX) && !defined(OS_ANDROID)
+  if (preallocate && data_size) {
+    // Failure is not fatal: file system may not support preallocation
+    posix_fallocate(fd, offset, data_size);
+  }
+#endif
+
+  bool result = true;
+  uint32_t written = 0;
+  while (written < data_size) {
+    const ssize_t count = pwrite(fd, data + written, data_size - written,
+                                 offset + written);
+    if (count < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      result = false;
+      break;
+    }
+    written += count;
+  }
+
+  if (0 != close(fd)) {
+    result = false;
+  }
+  return result;
+#endif
+}
+
+bool file_system::Append(const std::string& file_name,
+                         const uint8_t* data,
+                         uint32_t data_size,
+                         bool sync) {
+#ifdef OS_WIN32
+  std::ofstream file(file_name.c_str(),
+                     std::ios_base::binary | std::ios_base::app);
+  if (!file.is_open()) {
+    return false;
+  }
+  file.write(reinterpret_cast<const char*>(data), data_size);
+  file.close();
+  if (file.fail()) {
+    return false;
+  }
+  return !sync || SyncFile(file_name);
+#else
+  const int fd = open(file_name.c_str(), O_WRONLY | O_CREAT | O_APPEND,
+                      S_IRUSR | S_IWUSR | S_IRGRP);
+  if (-1 == fd) {
+    return false;
+  }
+
+  bool result = true;
+  uint32_t written = 0;
+  while (written < data_size) {
+    const ssize_t count = write(fd, data + written, data_size - written);
+    if (count < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      result = false;
+      break;
+    }
+    written += count;
+  }
+
+  if (result && sync && 0 != fsync(fd)) {
+    result = false;
+  }
+  if (0 != close(fd)) {
+    result = false;
+  }
+  return result;
+#endif
+}
+
+bool file_system::SyncFile(const std::string& file_name) {
+#ifdef OS_WIN32
+#ifdef UNICODE
+  wchar_string strUnicodeData;
+  Global::toUnicode(file_name, CP_ACP, strUnicodeData);
+  HANDLE file = ::CreateFile(strUnicodeData.c_str(), GENERIC_WRITE,
+                             FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+#else
+  HANDLE file = ::CreateFile(file_name.c_str(), GENERIC_WRITE,
+                             FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+#endif
+  if (INVALID_HANDLE_VALUE == file) {
+    return false;
+  }
+  const bool result = FALSE != ::FlushFileBuffers(file);
+  ::CloseHandle(file);
+  return result;
+#else
+  const int fd = open(file_name.c_str(), O_WRONLY);
+  if (-1 == fd) {
+    return false;
+  }
+  bool result = 0 == fsync(fd);
+  if (0 != close(fd)) {
+    result = false;
+  }
+  return result;
+#endif
+}
+
 std::ofstream* file_system::Open(const std::string& file_name,
                                  std::ios_base::openmode mode) {
 
@@ -376,6 +513,35 @@ bool file_system::DeleteFile(const std::string& name) {
 #endif
 }
 
+bool file_system::RenameFile(const std::string& old_name,
+                             const std::string& new_name) {
+#ifdef OS_WIN32
+#ifdef UNICODE
+	wchar_string strOldName;
+	wchar_string strNewName;
+	Global::toUnicode(old_name, CP_ACP, strOldName);
+	Global::toUnicode(new_name, CP_ACP, strNewName);
+#ifdef OS_WINCE
+	::DeleteFile(strNewName.c_str());
+	return ::MoveFile(strOldName.c_str(), strNewName.c_str()) == TRUE ? true : false;
+#else
+	return ::MoveFileEx(strOldName.c_str(), strNewName.c_str(),
+		MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) == TRUE ? true : false;
+#endif
+#else
+#ifdef OS_WINCE
+	::DeleteFile(new_name.c_str());
+	return ::MoveFile(old_name.c_str(), new_name.c_str()) == TRUE ? true : false;
+#else
+	return ::MoveFileEx(old_name.c_str(), new_name.c_str(),
+		MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) == TRUE ? true : false;
+#endif
+#endif
+#else
+	return !rename(old_name.c_str(), new_name.c_str());
+#endif
+}
+
 void remove_directory_content(const std::string& directory_name) {
 #ifdef OS_WIN32
 #ifdef UNICODE
@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef MODIFY_FUNCTION_SIGN
+#include <global_first.h>
+#endif
+#include "utils/latency_histogram.h"
+
+#include <pthread.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "utils/atomic.h"
+
+namespace utils {
+
+namespace {
+
+uint32_t HighestBit(uint32_t value) {
+  uint32_t result = 0;
+  if (value >= 1u << 16) { value >>= 16; result += 16; }
+  if (value >= 1u << 8) { value >>= 8; result += 8; }
+  if (value >= 1u << 4) { value >>= 4; result += 4; }
+  if (value >= 1u << 2) { value >>= 2; result += 2; }
+  if (value >= 1u << 1) { result += 1; }
+  return result;
+}
+
+pthread_once_t shard_key_once = PTHREAD_ONCE_INIT;
+pthread_key_t shard_key;
+volatile uint32_t next_shard = 0;
+
+void CreateShardKey() {
+  pthread_key_create(&shard_key, NULL);
+}
+
+uint32_t CurrentShard() {
+  // Threads get shards round robin on their first record,
+  // value stored in thread local slot is shard index plus one
+  pthread_once(&shard_key_once, &CreateShardKey);
+  void* value = pthread_getspecific(shard_key);
+  if (NULL == value) {
+    const uint32_t shard = atomic_post_inc(&next_shard) %
+                           LatencyHistogram::kShards;
+    value = reinterpret_cast<void*>(static_cast<size_t>(shard) + 1);
+    pthread_setspecific(shard_key, value);
+  }
+  return static_cast<uint32_t>(reinterpret_cast<size_t>(value) - 1);
+}
+
+}  // namespace
+
+const uint32_t LatencyHistogram::kSubBucketBits;
+const uint32_t LatencyHistogram::kSubBuckets;
+const uint32_t LatencyHistogram::kBucketsCount;
+const uint32_t LatencyHistogram::kShards;
+
+LatencyHistogram::LatencyHistogram() {
+  memset(const_cast<uint32_t*>(&counters_[0][0]), 0, sizeof(counters_));
+}
+
+void LatencyHistogram::Record(uint32_t value) {
+  atomic_post_inc(&counters_[CurrentShard()][BucketIndex(value)]);
+}
+
+void LatencyHistogram::GetSnapshot(Snapshot* snapshot) const {
+  snapshot->count = 0;
+  for (uint32_t i = 0; i < kBucketsCount; ++i) {
+    uint32_t sum = 0;
+    for (uint32_t shard = 0; shard < kShards; ++shard) {
+      sum += counters_[shard][i];
+    }
+    snapshot->buckets[i] = sum;
+    snapshot->count += sum;
+  }
+}
+
+uint32_t LatencyHistogram::BucketIndex(uint32_t value) {
+  if (value < kSubBuckets) {
+    return value;
+  }
+  const uint32_t shift = HighestBit(value) - kSubBucketBits;
+  return (shift + 1) * kSubBuckets + ((value >> shift) & (kSubBuckets - 1));
+}
+
+uint32_t LatencyHistogram::BucketUpperBound(uint32_t index) {
+  if (index < kSubBuckets) {
+    return index;
+  }
+  const uint32_t shift = index / kSubBuckets - 1;
+  const uint32_t lower =
+      (kSubBuckets + index % kSubBuckets) << shift;
+  return lower + ((1u << shift) - 1);
+}
+
+uint32_t LatencyHistogram::Snapshot::Percentile(double percentile) const {
+  if (0 == count) {
+    return 0;
+  }
+  uint32_t rank = static_cast<uint32_t>(count * percentile / 100);
+  if (rank >= count) {
+    rank = count - 1;
+  }
+  uint32_t seen = 0;
+  for (uint32_t i = 0; i < kBucketsCount; ++i) {
+    seen += buckets[i];
+    if (seen > rank) {
+      return BucketUpperBound(i);
+    }
+  }
+  return Max();
+}
+
+uint32_t LatencyHistogram::Snapshot::Max() const {
+  for (uint32_t i = kBucketsCount; i > 0; --i) {
+    if (buckets[i - 1]) {
+      return BucketUpperBound(i - 1);
+    }
+  }
+  return 0;
+}
+
+}  // namespace utils
@@ -0,0 +1,270 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef MODIFY_FUNCTION_SIGN
+#include <global_first.h>
+#endif
+#include "utils/latency_statistics.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "utils/atomic.h"
+
+namespace utils {
+
+namespace {
+
+const double kPercentiles[] = { 50, 90, 99 };
+const char* kPercentileNames[] = { "p50", "p90", "p99" };
+const char* kRpcOriginNames[] = { "mobile", "hmi" };
+
+/**
+ * @brief Appends formatted text, keeps track of remaining space
+ */
+class Formatter {
+ public:
+  Formatter(char* buffer, size_t size)
+    : buffer_(buffer),
+      size_(size),
+      length_(0) {
+    if (size_) {
+      buffer_[0] = '\0';
+    }
+  }
+
+  void Append(const char* text) {
+    Append("%s", text);
+  }
+
+  void Append(const char* format, uint32_t first, uint32_t second) {
+    if (length_ + 1 >= size_) {
+      return;
+    }
+    const int written =
+        snprintf(buffer_ + length_, size_ - length_, format, first, second);
+    Advance(written);
+  }
+
+  void Append(const char* format, const char* text) {
+    if (length_ + 1 >= size_) {
+      return;
+    }
+    const int written =
+        snprintf(buffer_ + length_, size_ - length_, format, text);
+    Advance(written);
+  }
+
+  void Append(const char* format, const char* text, uint32_t value) {
+    if (length_ + 1 >= size_) {
+      return;
+    }
+    const int written =
+        snprintf(buffer_ + length_, size_ - length_, format, text, value);
+    Advance(written);
+  }
+
+  size_t length() const {
+    return length_;
+  }
+
+ private:
+  void Advance(int written) {
+    if (written < 0) {
+      return;
+    }
+    length_ += static_cast<size_t>(written);
+    if (length_ >= size_) {
+      // Output was truncated
+      length_ = size_ - 1;
+    }
+  }
+
+  char* buffer_;
+  size_t size_;
+  size_t length_;
+};
+
+uint32_t Hash(uint32_t key) {
+  key ^= key >> 16;
+  key *= 0x45d9f3b;
+  key ^= key >> 16;
+  return key;
+}
+
+}  // namespace
+
+LatencyStatistics::LatencyStatistics() {
+  memset(const_cast<PendingSlot*>(&pending_[0][0]), 0, sizeof(pending_));
+  memset(const_cast<RpcSlot*>(&rpcs_[0][0]), 0, sizeof(rpcs_));
+}
+
+LatencyStatistics::~LatencyStatistics() {
+}
+
+void LatencyStatistics::Record(Stage stage, const TimevalStruct& begin) {
+  const int64_t span =
+      date_time::DateTime::getuSecs(date_time::DateTime::getCurrentTime()) -
+      date_time::DateTime::getuSecs(begin);
+  Record(stage, span > 0 ? static_cast<uint32_t>(span) : 0);
+}
+
+void LatencyStatistics::Record(Stage stage, uint32_t microseconds) {
+  if (stage >= kStagesCount) {
+    return;
+  }
+  histograms_[stage].Record(microseconds);
+}
+
+void LatencyStatistics::Start(Stage stage, uint32_t key) {
+  if (stage >= kStagesCount || 0 == key) {
+    return;
+  }
+  // Slot is selected by key only, start of other message in same slot is
+  // overwritten and its sample is lost. Statistics tolerates it, in
+  // exchange writers never wait for each other.
+  PendingSlot& slot = pending_[stage][Hash(key) % kPendingSlots];
+  slot.key = 0;
+  utils::memory_barrier();
+  slot.start = Now();
+  utils::memory_barrier();
+  slot.key = key;
+}
+
+void LatencyStatistics::Stop(Stage stage, uint32_t key) {
+  if (stage >= kStagesCount || 0 == key) {
+    return;
+  }
+  PendingSlot& slot = pending_[stage][Hash(key) % kPendingSlots];
+  if (slot.key != key) {
+    return;
+  }
+  const uint32_t start = slot.start;
+  if (atomic_val_cas(&slot.key, key, 0u) != key) {
+    // Slot was taken by another message meanwhile
+    return;
+  }
+  // Unsigned subtraction handles wrap of 32 bit microseconds counter
+  histograms_[stage].Record(Now() - start);
+}
+
+void LatencyStatistics::CountRpc(RpcOrigin origin, int32_t function_id) {
+  if (origin >= kRpcOriginsCount) {
+    return;
+  }
+  RpcSlot* slots = rpcs_[origin];
+  const int32_t stored_id = function_id + 1;
+  uint32_t index = Hash(static_cast<uint32_t>(function_id)) % kRpcSlots;
+  for (uint32_t probe = 0; probe < kRpcSlots; ++probe) {
+    RpcSlot& slot = slots[index];
+    int32_t current = slot.function_id;
+    if (0 == current) {
+      current = atomic_val_cas(&slot.function_id, 0, stored_id);
+      if (0 == current) {
+        current = stored_id;
+      }
+    }
+    if (stored_id == current) {
+      atomic_post_inc(&slot.count);
+      return;
+    }
+    index = (index + 1) % kRpcSlots;
+  }
+}
+
+size_t LatencyStatistics::Snapshot(char* buffer, size_t size) const {
+  Formatter out(buffer, size);
+  LatencyHistogram::Snapshot histogram;
+
+  out.Append("{\"stages\":{");
+  for (uint32_t stage = 0; stage < kStagesCount; ++stage) {
+    histograms_[stage].GetSnapshot(&histogram);
+    out.Append(stage ? ",\"%s\":{" : "\"%s\":{",
+               StageName(static_cast<Stage>(stage)));
+    out.Append("\"%s\":%u", "count", histogram.count);
+    for (size_t i = 0; i < ARRAYSIZE(kPercentiles); ++i) {
+      out.Append(",\"%s\":%u", kPercentileNames[i],
+                 histogram.Percentile(kPercentiles[i]));
+    }
+    out.Append(",\"%s\":%u}", "max", histogram.Max());
+  }
+  out.Append("},\"rpc\":{");
+  for (uint32_t origin = 0; origin < kRpcOriginsCount; ++origin) {
+    out.Append(origin ? ",\"%s\":{" : "\"%s\":{", kRpcOriginNames[origin]);
+    bool first = true;
+    for (uint32_t i = 0; i < kRpcSlots; ++i) {
+      const RpcSlot& slot = rpcs_[origin][i];
+      if (0 == slot.function_id) {
+        continue;
+      }
+      out.Append(first ? "\"%u\":%u" : ",\"%u\":%u",
+                 static_cast<uint32_t>(slot.function_id - 1), slot.count);
+      first = false;
+    }
+    out.Append("}");
+  }
+  out.Append("}}");
+  return out.length();
+}
+
+std::string LatencyStatistics::Snapshot() const {
+  std::vector<char> buffer(16 * 1024);
+  const size_t length = Snapshot(&buffer[0], buffer.size());
+  return std::string(&buffer[0], length);
+}
+
+const char* LatencyStatistics::StageName(Stage stage) {
+  switch (stage) {
+    case kTransportReceive:
+      return "transport_receive";
+    case kProtocolHandling:
+      return "protocol_handling";
+    case kCommandRun:
+      return "command_run";
+    case kHMIRoundTrip:
+      return "hmi_round_trip";
+    case kHMIResponseHandling:
+      return "hmi_response_handling";
+    case kMobileRequest:
+      return "mobile_request";
+    default:
+      return "unknown";
+  }
+}
+
+uint32_t LatencyStatistics::Now() {
+  const TimevalStruct now = date_time::DateTime::getCurrentTime();
+  return static_cast<uint32_t>(date_time::DateTime::getuSecs(now));
+}
+
+}  // namespace utils
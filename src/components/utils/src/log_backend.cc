@@ -0,0 +1,613 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef MODIFY_FUNCTION_SIGN
+#include <global_first.h>
+#endif
+#include "utils/log_backend.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <streambuf>
+#include <vector>
+
+#include "utils/date_time.h"
+#include "utils/memory_barrier.h"
+
+namespace utils {
+namespace logging {
+
+volatile int log_level_threshold = kTrace;
+
+namespace {
+
+const size_t kDefaultBufferSize = 32768;
+// Ring must hold several records of max size
+const size_t kMinBufferSize = 16384;
+const size_t kMaxMessageSize = 2048;
+const uint32_t kWriterPeriodMs = 100;
+const uint32_t kBlockingWaitMs = 10;
+#ifdef OS_ANDROID
+const char kLogFileName[] = "/sdcard/sdllog.txt";
+#else
+const char kLogFileName[] = "SmartDeviceLinkCore.log";
+#endif
+const char kLevelKey[] = "log4j.rootLogger";
+const char kFileKey[] = "log4j.appender.CustomLogFile.File";
+const char kBufferSizeKey[] = "log4j.appender.CustomLogFile.BufferSize";
+const char kBlockingKey[] = "log4j.appender.CustomLogFile.Blocking";
+const char* const kLevelNames[] = {
+  "TRACE", "DEBUG", "INFO ", "WARN ", "ERROR", "FATAL"
+};
+const char* const kMonthNames[] = {
+  "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+  "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+};
+
+/**
+ * @brief Record in ring buffer, message text follows the header
+ */
+struct RecordHeader {
+  const CallSite* site;
+  const char* logger_name;
+  TimevalStruct time;
+  uint32_t size;
+};
+
+size_t Align(size_t size) {
+  return (size + 7) & ~static_cast<size_t>(7);
+}
+
+const size_t kHeaderSize = Align(sizeof(RecordHeader));
+
+/**
+ * @brief Fixed buffer message text is formatted to, longer text is cut
+ */
+class StagingBuffer : public std::streambuf {
+ public:
+  StagingBuffer() {
+    Reset();
+  }
+
+  void Reset() {
+    setp(buffer_, buffer_ + sizeof(buffer_));
+  }
+
+  const char* data() const {
+    return pbase();
+  }
+
+  size_t size() const {
+    return pptr() - pbase();
+  }
+
+ private:
+  char buffer_[kMaxMessageSize];
+};
+
+}  // namespace
+
+/**
+ * @brief Ring buffer of one thread. Owner thread is the only producer,
+ * writer thread is the only consumer. Positions grow monotonically and
+ * are taken modulo capacity, which is power of two.
+ */
+struct ThreadLog {
+  explicit ThreadLog(size_t ring_capacity)
+    : ring(new uint8_t[ring_capacity]),
+      capacity(ring_capacity),
+      head(0),
+      tail(0),
+      dropped(0),
+      reported_dropped(0),
+      exited(false),
+      busy(false),
+      stream(&staging),
+      null_stream(NULL),
+      default_flags(stream.flags()),
+      next(NULL) {
+  }
+
+  ~ThreadLog() {
+    delete[] ring;
+  }
+
+  uint8_t* ring;
+  const size_t capacity;
+  // Written by owner thread only
+  volatile uint32_t head;
+  // Written by writer thread only
+  volatile uint32_t tail;
+  volatile uint32_t dropped;
+  uint32_t reported_dropped;
+  // Owner thread has finished, ring is freed once drained
+  volatile bool exited;
+
+  // Used by owner thread only
+  bool busy;
+  TimevalStruct time;
+  StagingBuffer staging;
+  std::ostream stream;
+  // Swallows messages logged while formatting another message
+  std::ostream null_stream;
+  std::ios_base::fmtflags default_flags;
+
+  // Guarded by Backend::lock
+  ThreadLog* next;
+};
+
+namespace {
+
+struct Backend {
+  Backend()
+    : writer_running(false),
+      stopping(false),
+      threads(NULL),
+      file(NULL),
+      file_name(kLogFileName),
+      reopen(false),
+      buffer_size(kDefaultBufferSize),
+      blocking(false),
+      flush_requests(0),
+      flushes_done(0),
+      total_dropped(0) {
+    pthread_mutex_init(&lock, NULL);
+    pthread_cond_init(&wake_writer, NULL);
+    pthread_cond_init(&written, NULL);
+    pthread_key_create(&thread_key, &Backend::OnThreadExit);
+  }
+
+  static void OnThreadExit(void* value) {
+    static_cast<ThreadLog*>(value)->exited = true;
+  }
+
+  pthread_mutex_t lock;
+  pthread_cond_t wake_writer;
+  pthread_cond_t written;
+  pthread_key_t thread_key;
+  pthread_t writer;
+  bool writer_running;
+  bool stopping;
+  ThreadLog* threads;
+  // Used by writer only
+  FILE* file;
+  std::string file_name;
+  // Set by Init, file may have been renamed or removed meanwhile
+  bool reopen;
+  size_t buffer_size;
+  volatile bool blocking;
+  uint32_t flush_requests;
+  uint32_t flushes_done;
+  volatile uint32_t total_dropped;
+  std::set<std::string> names;
+};
+
+// Never destroyed, threads may log while static objects are destroyed
+Backend* backend = NULL;
+pthread_once_t backend_once = PTHREAD_ONCE_INIT;
+
+void* WriterMain(void*);
+
+void CreateBackend() {
+  backend = new Backend();
+  backend->writer_running =
+      0 == pthread_create(&backend->writer, NULL, &WriterMain, NULL);
+}
+
+Backend* GetBackend() {
+  pthread_once(&backend_once, &CreateBackend);
+  return backend;
+}
+
+void WaitFor(pthread_cond_t* condition, pthread_mutex_t* lock,
+             uint32_t milliseconds) {
+  struct timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec += milliseconds / 1000;
+  deadline.tv_nsec += (milliseconds % 1000) * 1000000;
+  if (deadline.tv_nsec >= 1000000000) {
+    deadline.tv_nsec -= 1000000000;
+    ++deadline.tv_sec;
+  }
+  pthread_cond_timedwait(condition, lock, &deadline);
+}
+
+ThreadLog* CurrentThreadLog(Backend* b) {
+  ThreadLog* log = static_cast<ThreadLog*>(pthread_getspecific(b->thread_key));
+  if (!log) {
+    pthread_mutex_lock(&b->lock);
+    log = new ThreadLog(b->buffer_size);
+    log->next = b->threads;
+    b->threads = log;
+    pthread_mutex_unlock(&b->lock);
+    pthread_setspecific(b->thread_key, log);
+  }
+  return log;
+}
+
+/**
+ * @brief Copies record to ring of owner thread, called by owner only
+ */
+void Push(Backend* b, ThreadLog* log, const RecordHeader& header,
+          const char* text) {
+  const size_t record_size = Align(kHeaderSize + header.size);
+  while (true) {
+    const uint32_t head = log->head;
+    const uint32_t tail = log->tail;
+    memory_barrier();
+    const size_t offset = head & (log->capacity - 1);
+    const size_t to_end = log->capacity - offset;
+    // Record is never split, rest of ring is skipped instead
+    const size_t needed =
+        record_size <= to_end ? record_size : to_end + record_size;
+    const size_t used = head - tail;
+
+    if (log->capacity - used >= needed) {
+      uint32_t position = head;
+      if (record_size > to_end) {
+        if (to_end >= kHeaderSize) {
+          RecordHeader padding;
+          padding.site = NULL;
+          memcpy(log->ring + offset, &padding, sizeof(padding));
+        }
+        position += to_end;
+      }
+      uint8_t* record = log->ring + (position & (log->capacity - 1));
+      memcpy(record, &header, sizeof(header));
+      memcpy(record + kHeaderSize, text, header.size);
+      memory_barrier();
+      log->head = head + needed;
+      if (used + needed > log->capacity / 2) {
+        pthread_cond_signal(&b->wake_writer);
+      }
+      return;
+    }
+
+    if (!b->blocking || !b->writer_running) {
+      ++log->dropped;
+      return;
+    }
+    pthread_mutex_lock(&b->lock);
+    pthread_cond_signal(&b->wake_writer);
+    WaitFor(&b->written, &b->lock, kBlockingWaitMs);
+    pthread_mutex_unlock(&b->lock);
+  }
+}
+
+struct Line {
+  int64_t time;
+  std::string text;
+
+  bool operator<(const Line& other) const {
+    return time < other.time;
+  }
+};
+
+void FormatHeader(LogLevel level, const char* logger_name,
+                  const TimevalStruct& time, std::string* text) {
+  const time_t seconds = time.tv_sec;
+  struct tm local;
+  localtime_r(&seconds, &local);
+  char buffer[64];
+  snprintf(buffer, sizeof(buffer), "%s [%02d %s %04d %02d:%02d:%02d,%03d][",
+           kLevelNames[level], local.tm_mday, kMonthNames[local.tm_mon],
+           local.tm_year + 1900, local.tm_hour, local.tm_min, local.tm_sec,
+           static_cast<int>(time.tv_usec / 1000));
+  *text += buffer;
+  *text += logger_name;
+  *text += "] ";
+}
+
+/**
+ * @brief Moves records of ring to lines, called by writer only
+ */
+void Drain(ThreadLog* log, std::vector<Line>* lines) {
+  const uint32_t head = log->head;
+  memory_barrier();
+  uint32_t position = log->tail;
+  while (position != head) {
+    const size_t offset = position & (log->capacity - 1);
+    const size_t to_end = log->capacity - offset;
+    if (to_end < kHeaderSize) {
+      position += to_end;
+      continue;
+    }
+    RecordHeader header;
+    memcpy(&header, log->ring + offset, sizeof(header));
+    if (!header.site) {
+      position += to_end;
+      continue;
+    }
+
+    Line line;
+    line.time = date_time::DateTime::getuSecs(header.time);
+    line.text.reserve(128 + header.size);
+    FormatHeader(header.site->level, header.logger_name, header.time,
+                 &line.text);
+    const char* file = strrchr(header.site->file, '/');
+    line.text += file ? file + 1 : header.site->file;
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), ":%d ", header.site->line);
+    line.text += buffer;
+    line.text += header.site->function;
+    line.text += ": ";
+    line.text.append(
+        reinterpret_cast<const char*>(log->ring + offset + kHeaderSize),
+        header.size);
+    line.text += '\n';
+    lines->push_back(line);
+
+    position += Align(kHeaderSize + header.size);
+  }
+  memory_barrier();
+  log->tail = head;
+
+  const uint32_t dropped = log->dropped;
+  if (dropped != log->reported_dropped) {
+    const uint32_t count = dropped - log->reported_dropped;
+    log->reported_dropped = dropped;
+    backend->total_dropped += count;
+
+    Line line;
+    const TimevalStruct now = date_time::DateTime::getCurrentTime();
+    line.time = date_time::DateTime::getuSecs(now);
+    FormatHeader(kWarn, "Logger", now, &line.text);
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%u records dropped, buffer is full\n",
+             static_cast<unsigned>(count));
+    line.text += buffer;
+    lines->push_back(line);
+  }
+}
+
+void* WriterMain(void*) {
+  Backend* b = backend;
+  std::vector<ThreadLog*> logs;
+  std::vector<Line> lines;
+
+  pthread_mutex_lock(&b->lock);
+  while (true) {
+    if (b->flush_requests == b->flushes_done && !b->stopping) {
+      WaitFor(&b->wake_writer, &b->lock, kWriterPeriodMs);
+    }
+    const uint32_t flush_target = b->flush_requests;
+    const bool stopping = b->stopping;
+
+    // Rings of finished threads are freed after their last drain
+    logs.clear();
+    ThreadLog** link = &b->threads;
+    while (*link) {
+      ThreadLog* log = *link;
+      if (log->exited && log->head == log->tail &&
+          log->dropped == log->reported_dropped) {
+        *link = log->next;
+        delete log;
+        continue;
+      }
+      logs.push_back(log);
+      link = &log->next;
+    }
+
+    const std::string file_name = b->file_name;
+    if (b->reopen && b->file) {
+      fclose(b->file);
+      b->file = NULL;
+    }
+    b->reopen = false;
+    pthread_mutex_unlock(&b->lock);
+
+    lines.clear();
+    for (size_t i = 0; i < logs.size(); ++i) {
+      Drain(logs[i], &lines);
+    }
+    if (!lines.empty()) {
+      // Records of different threads are merged in time order
+      std::stable_sort(lines.begin(), lines.end());
+      // File is opened on first write
+      if (!b->file) {
+        b->file = fopen(file_name.c_str(), "a");
+      }
+      if (b->file) {
+        for (size_t i = 0; i < lines.size(); ++i) {
+          fwrite(lines[i].text.data(), 1, lines[i].text.size(), b->file);
+        }
+        fflush(b->file);
+      }
+    }
+
+    pthread_mutex_lock(&b->lock);
+    b->flushes_done = flush_target;
+    pthread_cond_broadcast(&b->written);
+    if (stopping) {
+      break;
+    }
+  }
+  if (b->file) {
+    fclose(b->file);
+    b->file = NULL;
+  }
+  b->writer_running = false;
+  pthread_cond_broadcast(&b->written);
+  pthread_mutex_unlock(&b->lock);
+  return NULL;
+}
+
+LogLevel ParseLevel(const std::string& value) {
+  const std::string::size_type begin = value.find_first_not_of(" \t");
+  const std::string::size_type end = value.find_first_of(", \t\r", begin);
+  if (std::string::npos == begin) {
+    return kTrace;
+  }
+  const std::string name = value.substr(begin, end - begin);
+  if ("DEBUG" == name) {
+    return kDebug;
+  } else if ("INFO" == name) {
+    return kInfo;
+  } else if ("WARN" == name) {
+    return kWarn;
+  } else if ("ERROR" == name) {
+    return kError;
+  } else if ("FATAL" == name) {
+    return kFatal;
+  } else if ("OFF" == name) {
+    return kOff;
+  }
+  // ALL and TRACE
+  return kTrace;
+}
+
+}  // namespace
+
+void Init(const std::string& properties_file) {
+  Backend* b = GetBackend();
+
+  LogLevel level = kTrace;
+  std::string file_name = kLogFileName;
+  size_t buffer_size = kDefaultBufferSize;
+  bool blocking = false;
+  std::ifstream file(properties_file.c_str());
+  std::string line;
+  while (std::getline(file, line)) {
+    const std::string::size_type separator = line.find('=');
+    if (std::string::npos == separator || '#' == line[0]) {
+      continue;
+    }
+    const std::string key = line.substr(0, line.find_last_not_of(
+        " \t", separator - 1) + 1);
+    const std::string value = line.substr(separator + 1);
+    if (kLevelKey == key) {
+      level = ParseLevel(value);
+    } else if (kFileKey == key) {
+      file_name = value.substr(0, value.find_last_not_of(" \t\r") + 1);
+    } else if (kBufferSizeKey == key) {
+      buffer_size = strtoul(value.c_str(), NULL, 10);
+    } else if (kBlockingKey == key) {
+      blocking = std::string::npos != value.find("true");
+    }
+  }
+
+  // Round up to power of two
+  size_t capacity = kMinBufferSize;
+  while (capacity < buffer_size) {
+    capacity *= 2;
+  }
+
+  pthread_mutex_lock(&b->lock);
+  // Rings of threads which already log keep their size
+  b->file_name = file_name;
+  b->reopen = true;
+  b->buffer_size = capacity;
+  b->blocking = blocking;
+  log_level_threshold = level;
+  pthread_mutex_unlock(&b->lock);
+}
+
+void Deinit() {
+  Backend* b = GetBackend();
+  pthread_mutex_lock(&b->lock);
+  const bool running = b->writer_running && !b->stopping;
+  b->stopping = true;
+  pthread_cond_signal(&b->wake_writer);
+  pthread_mutex_unlock(&b->lock);
+  if (running) {
+    pthread_join(b->writer, NULL);
+  }
+}
+
+void Flush() {
+  Backend* b = GetBackend();
+  pthread_mutex_lock(&b->lock);
+  const uint32_t target = ++b->flush_requests;
+  pthread_cond_signal(&b->wake_writer);
+  while (b->writer_running &&
+         static_cast<int32_t>(b->flushes_done - target) < 0) {
+    pthread_cond_wait(&b->written, &b->lock);
+  }
+  pthread_mutex_unlock(&b->lock);
+}
+
+uint32_t DroppedRecords() {
+  return GetBackend()->total_dropped;
+}
+
+const char* InternName(const std::string& name) {
+  Backend* b = GetBackend();
+  pthread_mutex_lock(&b->lock);
+  const char* result = b->names.insert(name).first->c_str();
+  pthread_mutex_unlock(&b->lock);
+  return result;
+}
+
+LogMessage::LogMessage(const CallSite& site, const char* logger_name)
+  : thread_log_(CurrentThreadLog(GetBackend())),
+    site_(site),
+    logger_name_(logger_name),
+    nested_(thread_log_->busy) {
+  if (nested_) {
+    return;
+  }
+  thread_log_->busy = true;
+  thread_log_->time = date_time::DateTime::getCurrentTime();
+  thread_log_->staging.Reset();
+  thread_log_->stream.clear();
+  thread_log_->stream.flags(thread_log_->default_flags);
+  thread_log_->stream.fill(' ');
+  thread_log_->stream.precision(6);
+  thread_log_->stream.width(0);
+}
+
+LogMessage::~LogMessage() {
+  if (nested_) {
+    return;
+  }
+  RecordHeader header;
+  header.site = &site_;
+  header.logger_name = logger_name_;
+  header.time = thread_log_->time;
+  header.size = thread_log_->staging.size();
+  Push(backend, thread_log_, header, thread_log_->staging.data());
+  thread_log_->busy = false;
+}
+
+std::ostream& LogMessage::stream() {
+  return nested_ ? thread_log_->null_stream : thread_log_->stream;
+}
+
+}  // namespace logging
+}  // namespace utils
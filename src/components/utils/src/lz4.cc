@@ -0,0 +1,231 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef MODIFY_FUNCTION_SIGN
+#include <global_first.h>
+#endif
+#include "utils/lz4.h"
+
+#include <string.h>
+
+namespace {
+
+const size_t kMinMatch = 4;
+// last match must start at least 12 bytes before the end of block
+const size_t kMatchFindLimit = 12;
+// and the last 5 bytes are always literals
+const size_t kLastLiterals = 5;
+const size_t kMaxOffset = 65535;
+const uint32_t kHashLog = 12;
+const uint8_t kRunMask = 15;
+
+inline uint32_t Read32(const uint8_t* p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline uint32_t Hash(uint32_t sequence) {
+  return (sequence * 2654435761U) >> (32 - kHashLog);
+}
+
+inline uint8_t* WriteLength(uint8_t* op, size_t length) {
+  while (length >= 255) {
+    *op++ = 255;
+    length -= 255;
+  }
+  *op++ = static_cast<uint8_t>(length);
+  return op;
+}
+
+uint8_t* WriteLiterals(uint8_t* op, uint8_t* token,
+                       const uint8_t* literals, size_t length) {
+  if (length >= kRunMask) {
+    *token = kRunMask << 4;
+    op = WriteLength(op, length - kRunMask);
+  } else {
+    *token = static_cast<uint8_t>(length << 4);
+  }
+  if (length) {
+    memcpy(op, literals, length);
+  }
+  return op + length;
+}
+
+}  // namespace
+
+namespace utils {
+namespace lz4 {
+
+size_t CompressBound(size_t size) {
+  return size + size / 255 + 16;
+}
+
+size_t Compress(const uint8_t* data, size_t size,
+                std::vector<uint8_t>* output) {
+  output->resize(CompressBound(size));
+  uint8_t* const out_begin = &(*output)[0];
+  uint8_t* op = out_begin;
+  size_t anchor = 0;
+
+  if (size > kMatchFindLimit) {
+    // positions are stored + 1, so 0 is empty slot
+    std::vector<uint32_t> table(1 << kHashLog, 0);
+    const size_t match_find_limit = size - kMatchFindLimit;
+    const size_t match_limit = size - kLastLiterals;
+    size_t ip = 0;
+
+    while (ip < match_find_limit) {
+      const uint32_t sequence = Read32(data + ip);
+      const uint32_t hash = Hash(sequence);
+      const size_t ref = table[hash];
+      table[hash] = static_cast<uint32_t>(ip + 1);
+
+      if (0 == ref || ip + 1 - ref > kMaxOffset ||
+          Read32(data + ref - 1) != sequence) {
+        // step grows on incompressible data
+        ip += 1 + ((ip - anchor) >> 6);
+        continue;
+      }
+
+      size_t match = ref - 1;
+      size_t start = ip;
+      while (start > anchor && match > 0 &&
+             data[start - 1] == data[match - 1]) {
+        --start;
+        --match;
+      }
+      size_t end = ip + kMinMatch;
+      while (end < match_limit && data[end] == data[match + end - start]) {
+        ++end;
+      }
+
+      uint8_t* token = op++;
+      op = WriteLiterals(op, token, data + anchor, start - anchor);
+
+      const size_t offset = start - match;
+      *op++ = static_cast<uint8_t>(offset);
+      *op++ = static_cast<uint8_t>(offset >> 8);
+
+      const size_t match_length = end - start - kMinMatch;
+      if (match_length >= kRunMask) {
+        *token |= kRunMask;
+        op = WriteLength(op, match_length - kRunMask);
+      } else {
+        *token |= static_cast<uint8_t>(match_length);
+      }
+
+      anchor = ip = end;
+      if (ip < match_find_limit) {
+        table[Hash(Read32(data + ip - 2))] = static_cast<uint32_t>(ip - 1);
+      }
+    }
+  }
+
+  uint8_t* token = op++;
+  op = WriteLiterals(op, token, data + anchor, size - anchor);
+
+  output->resize(op - out_begin);
+  return output->size();
+}
+
+bool Decompress(const uint8_t* data, size_t size, size_t decompressed_size,
+                std::vector<uint8_t>* output) {
+  output->resize(decompressed_size);
+  uint8_t* const out = decompressed_size ? &(*output)[0] : NULL;
+  size_t ip = 0;
+  size_t op = 0;
+
+  while (ip < size) {
+    const uint8_t token = data[ip++];
+
+    size_t length = token >> 4;
+    if (kRunMask == length) {
+      uint8_t byte;
+      do {
+        if (ip >= size) {
+          return false;
+        }
+        byte = data[ip++];
+        length += byte;
+      } while (255 == byte);
+    }
+    if (length > size - ip || length > decompressed_size - op) {
+      return false;
+    }
+    if (length) {
+      memcpy(out + op, data + ip, length);
+    }
+    ip += length;
+    op += length;
+
+    if (ip == size) {
+      break;
+    }
+
+    if (size - ip < 2) {
+      return false;
+    }
+    const size_t offset = data[ip] | (data[ip + 1] << 8);
+    ip += 2;
+    if (0 == offset || offset > op) {
+      return false;
+    }
+
+    length = token & kRunMask;
+    if (kRunMask == length) {
+      uint8_t byte;
+      do {
+        if (ip >= size) {
+          return false;
+        }
+        byte = data[ip++];
+        length += byte;
+      } while (255 == byte);
+    }
+    length += kMinMatch;
+    if (length > decompressed_size - op) {
+      return false;
+    }
+    // regions may overlap, copy byte by byte
+    const uint8_t* match = out + op - offset;
+    for (size_t i = 0; i < length; ++i) {
+      out[op + i] = match[i];
+    }
+    op += length;
+  }
+
+  return op == decompressed_size;
+}
+
+}  // namespace lz4
+}  // namespace utils
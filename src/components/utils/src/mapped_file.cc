@@ -0,0 +1,165 @@
+/**
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef MODIFY_FUNCTION_SIGN
+#include <global_first.h>
+#endif
+#include "utils/mapped_file.h"
+
+#ifdef OS_WIN32
+#include <Windows.h>
+#ifdef OS_WINCE
+#include "utils/global.h"
+#endif
+#else
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace file_system {
+
+MappedFile::MappedFile()
+  : data_(NULL),
+    size_(0)
+#ifdef OS_WIN32
+    , file_(INVALID_HANDLE_VALUE),
+    mapping_(NULL)
+#endif
+{
+}
+
+MappedFile::~MappedFile() {
+  Close();
+}
+
+#ifdef OS_WIN32
+
+bool MappedFile::Open(const std::string& name) {
+  Close();
+#ifdef UNICODE
+  wchar_string strUnicodeData;
+  Global::toUnicode(name, CP_ACP, strUnicodeData);
+  const wchar_t* path = strUnicodeData.c_str();
+#else
+  const char* path = name.c_str();
+#endif
+#ifdef OS_WINCE
+  // Only handles opened for mapping can be mapped on CE
+  HANDLE file = ::CreateFileForMapping(path, GENERIC_READ, FILE_SHARE_READ,
+                                       NULL, OPEN_EXISTING,
+                                       FILE_ATTRIBUTE_NORMAL, NULL);
+#else
+  HANDLE file = ::CreateFile(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+#endif
+  if (INVALID_HANDLE_VALUE == file) {
+    return false;
+  }
+  const DWORD size = ::GetFileSize(file, NULL);
+  if (INVALID_FILE_SIZE == size || 0 == size) {
+    ::CloseHandle(file);
+    return false;
+  }
+  HANDLE mapping = ::CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (NULL == mapping) {
+    ::CloseHandle(file);
+    return false;
+  }
+  void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (NULL == view) {
+    ::CloseHandle(mapping);
+    ::CloseHandle(file);
+    return false;
+  }
+  file_ = file;
+  mapping_ = mapping;
+  data_ = static_cast<const uint8_t*>(view);
+  size_ = size;
+  return true;
+}
+
+void MappedFile::Close() {
+  if (data_) {
+    ::UnmapViewOfFile(const_cast<uint8_t*>(data_));
+    data_ = NULL;
+    size_ = 0;
+  }
+  if (mapping_) {
+    ::CloseHandle(mapping_);
+    mapping_ = NULL;
+  }
+  if (INVALID_HANDLE_VALUE != file_) {
+    ::CloseHandle(file_);
+    file_ = INVALID_HANDLE_VALUE;
+  }
+}
+
+#else
+
+bool MappedFile::Open(const std::string& name) {
+  Close();
+  const int fd = open(name.c_str(), O_RDONLY);
+  if (-1 == fd) {
+    return false;
+  }
+  struct stat file_info;
+  memset(&file_info, 0, sizeof(file_info));
+  if (-1 == fstat(fd, &file_info) || 0 == file_info.st_size) {
+    close(fd);
+    return false;
+  }
+  const size_t size = static_cast<size_t>(file_info.st_size);
+  void* memory = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // Mapping keeps its own reference to file
+  close(fd);
+  if (MAP_FAILED == memory) {
+    return false;
+  }
+  data_ = static_cast<const uint8_t*>(memory);
+  size_ = size;
+  return true;
+}
+
+void MappedFile::Close() {
+  if (data_) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+    data_ = NULL;
+    size_ = 0;
+  }
+}
+
+#endif  // OS_WIN32
+
+}  // namespace file_system
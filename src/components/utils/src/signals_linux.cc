@@ -61,6 +61,16 @@ bool ResetSubscribeToTerminateSignal() {
 #endif
 }
 
+bool SubscribeToDumpSignal(void (*func)(int32_t p)) {
+#if defined(OS_WINCE) || !defined(SIGUSR1)
+  return true;
+#else
+  void (*prev_func)(int32_t p);
+  prev_func = signal(SIGUSR1, func);
+  return (SIG_ERR != prev_func);
+#endif
+}
+
 void ForwardSignal() {
 #ifndef OS_WINCE
   int32_t signal_id = SIGINT;
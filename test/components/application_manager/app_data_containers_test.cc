@@ -0,0 +1,132 @@
+/*
+* Copyright (c) 2014, Ford Motor Company
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice,
+* this list of conditions and the following
+* disclaimer in the documentation and/or other materials provided with the
+* distribution.
+*
+* Neither the name of the Ford Motor Company nor the names of its contributors
+* may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "application_manager/sorted_id_map.h"
+#include "application_manager/enum_bitset.h"
+
+namespace test {
+namespace components {
+namespace application_manager {
+
+using ::application_manager::SortedIdMap;
+using ::application_manager::EnumBitset;
+
+TEST(SortedIdMapTest, KeepsItemsOrderedById) {
+  SortedIdMap<int> map;
+  map[30] = 3;
+  map[10] = 1;
+  map[20] = 2;
+  map[10] = 11;
+  ASSERT_EQ(3u, map.size());
+  std::vector<uint32_t> keys;
+  for (SortedIdMap<int>::const_iterator it = map.begin();
+       map.end() != it; ++it) {
+    keys.push_back(it->first);
+  }
+  ASSERT_EQ(10u, keys[0]);
+  ASSERT_EQ(20u, keys[1]);
+  ASSERT_EQ(30u, keys[2]);
+  ASSERT_EQ(11, map.find(10)->second);
+}
+
+TEST(SortedIdMapTest, FindAndErase) {
+  SortedIdMap<int> map;
+  for (uint32_t i = 0; i < 100; i += 2) {
+    map[i] = static_cast<int>(i);
+  }
+  ASSERT_TRUE(map.end() == map.find(51));
+  ASSERT_TRUE(map.end() == map.find(1000));
+  ASSERT_EQ(1u, map.erase(50));
+  ASSERT_EQ(0u, map.erase(50));
+  ASSERT_TRUE(map.end() == map.find(50));
+  map.erase(map.find(0));
+  ASSERT_EQ(48u, map.size());
+  ASSERT_EQ(2u, map.begin()->first);
+  map.clear();
+  ASSERT_TRUE(map.empty());
+}
+
+enum Color {
+  kRed = 0,
+  kGreen,
+  kBlue
+};
+
+TEST(EnumBitsetTest, InsertEraseContains) {
+  EnumBitset<Color, kBlue + 1> colors;
+  ASSERT_TRUE(colors.empty());
+  ASSERT_TRUE(colors.insert(kGreen));
+  ASSERT_FALSE(colors.insert(kGreen));
+  ASSERT_TRUE(colors.contains(kGreen));
+  ASSERT_FALSE(colors.contains(kRed));
+  ASSERT_EQ(1u, colors.size());
+  ASSERT_TRUE(colors.erase(kGreen));
+  ASSERT_FALSE(colors.erase(kGreen));
+  ASSERT_TRUE(colors.empty());
+}
+
+TEST(EnumBitsetTest, OutOfRangeValuesAreNeverMembers) {
+  EnumBitset<int32_t, 5> set;
+  ASSERT_FALSE(set.insert(-1));
+  ASSERT_FALSE(set.insert(5));
+  ASSERT_FALSE(set.contains(-1));
+  ASSERT_FALSE(set.contains(5));
+  ASSERT_FALSE(set.erase(5));
+  ASSERT_TRUE(set.empty());
+}
+
+TEST(EnumBitsetTest, IteratesInAscendingOrder) {
+  EnumBitset<uint32_t, 70> set;
+  const uint32_t values[] = {0, 5, 31, 32, 63, 64, 69};
+  const size_t count = sizeof(values) / sizeof(values[0]);
+  for (size_t i = count; i > 0; --i) {
+    set.insert(values[i - 1]);
+  }
+  ASSERT_EQ(count, set.size());
+  std::vector<uint32_t> walked;
+  for (EnumBitset<uint32_t, 70>::const_iterator it = set.begin();
+       set.end() != it; ++it) {
+    walked.push_back(*it);
+  }
+  ASSERT_EQ(count, walked.size());
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(values[i], walked[i]);
+  }
+}
+
+}  // namespace application_manager
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,187 @@
+/*
+* Copyright (c) 2014, Ford Motor Company
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice,
+* this list of conditions and the following
+* disclaimer in the documentation and/or other materials provided with the
+* distribution.
+*
+* Neither the name of the Ford Motor Company nor the names of its contributors
+* may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "application_manager/event_engine/event.h"
+#include "application_manager/event_engine/event_observer.h"
+
+namespace test {
+namespace components {
+namespace application_manager {
+
+using ::application_manager::event_engine::Event;
+using ::application_manager::event_engine::EventObserver;
+namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
+namespace strings = ::application_manager::strings;
+
+const Event::EventID kEventId = hmi_apis::FunctionID::UI_AddCommand;
+const Event::EventID kNotificationId = hmi_apis::FunctionID::UI_OnCommand;
+
+void RaiseEvent(const Event::EventID& event_id,
+                hmi_apis::messageType::eType message_type,
+                int32_t correlation_id) {
+  smart_objects::SmartObject message(smart_objects::SmartType_Map);
+  message[strings::params][strings::message_type] = message_type;
+  message[strings::params][strings::correlation_id] = correlation_id;
+  Event event(event_id);
+  event.set_smart_object(message);
+  event.raise();
+}
+
+class RecordingObserver : public EventObserver {
+ public:
+  RecordingObserver(int32_t value, std::vector<int32_t>* record)
+    : value_(value),
+      record_(record),
+      unsubscribe_(NULL) {
+  }
+  virtual void on_event(const Event& event) {
+    record_->push_back(value_);
+    if (unsubscribe_) {
+      unsubscribe_->Unsubscribe();
+    }
+  }
+  void Subscribe(const Event::EventID& event_id,
+                 int32_t correlation_id = 0) {
+    subscribe_on_event(event_id, correlation_id);
+  }
+  void Unsubscribe() {
+    unsubscribe_from_all_events();
+  }
+  // Observer to unsubscribe from within on_event
+  void set_unsubscribe(RecordingObserver* observer) {
+    unsubscribe_ = observer;
+  }
+ private:
+  int32_t value_;
+  std::vector<int32_t>* record_;
+  RecordingObserver* unsubscribe_;
+};
+
+TEST(EventDispatcherTest, ResponseGoesToItsCorrelationId) {
+  std::vector<int32_t> record;
+  RecordingObserver first(1, &record);
+  RecordingObserver second(2, &record);
+  first.Subscribe(kEventId, 10);
+  second.Subscribe(kEventId, 11);
+
+  RaiseEvent(kEventId, hmi_apis::messageType::response, 11);
+  RaiseEvent(kEventId, hmi_apis::messageType::error_response, 10);
+  RaiseEvent(kEventId, hmi_apis::messageType::request, 10);
+
+  ASSERT_EQ(2u, record.size());
+  EXPECT_EQ(2, record[0]);
+  EXPECT_EQ(1, record[1]);
+}
+
+TEST(EventDispatcherTest, NotificationGoesToAllSubscribersInOrder) {
+  std::vector<int32_t> record;
+  RecordingObserver first(1, &record);
+  RecordingObserver second(2, &record);
+  RecordingObserver response(3, &record);
+  first.Subscribe(kNotificationId);
+  second.Subscribe(kNotificationId);
+  response.Subscribe(kEventId, 5);
+
+  RaiseEvent(kNotificationId, hmi_apis::messageType::notification, 7);
+
+  ASSERT_EQ(2u, record.size());
+  EXPECT_EQ(1, record[0]);
+  EXPECT_EQ(2, record[1]);
+}
+
+TEST(EventDispatcherTest, UnsubscribeFromAllEvents) {
+  std::vector<int32_t> record;
+  RecordingObserver observer(1, &record);
+  observer.Subscribe(kEventId, 1);
+  observer.Subscribe(kEventId, 2);
+  observer.Subscribe(kNotificationId);
+
+  observer.Unsubscribe();
+  RaiseEvent(kEventId, hmi_apis::messageType::response, 1);
+  RaiseEvent(kEventId, hmi_apis::messageType::response, 2);
+  RaiseEvent(kNotificationId, hmi_apis::messageType::notification, 0);
+  EXPECT_TRUE(record.empty());
+}
+
+TEST(EventDispatcherTest, UnsubscribeDuringDelivery) {
+  std::vector<int32_t> record;
+  RecordingObserver first(1, &record);
+  RecordingObserver second(2, &record);
+  RecordingObserver third(3, &record);
+  first.Subscribe(kNotificationId);
+  second.Subscribe(kNotificationId);
+  third.Subscribe(kNotificationId);
+  // first removes second which is next in delivery
+  first.set_unsubscribe(&second);
+  // third removes itself
+  third.set_unsubscribe(&third);
+
+  RaiseEvent(kNotificationId, hmi_apis::messageType::notification, 0);
+  ASSERT_EQ(2u, record.size());
+  EXPECT_EQ(1, record[0]);
+  EXPECT_EQ(3, record[1]);
+
+  record.clear();
+  RaiseEvent(kNotificationId, hmi_apis::messageType::notification, 0);
+  ASSERT_EQ(1u, record.size());
+  EXPECT_EQ(1, record[0]);
+}
+
+TEST(EventDispatcherTest, ManySubscriptions) {
+  std::vector<int32_t> record;
+  std::vector<RecordingObserver*> observers;
+  for (int32_t i = 0; i < 1000; ++i) {
+    RecordingObserver* observer = new RecordingObserver(i, &record);
+    observer->Subscribe(kEventId, i);
+    observers.push_back(observer);
+  }
+  for (int32_t i = 0; i < 1000; i += 100) {
+    RaiseEvent(kEventId, hmi_apis::messageType::response, i);
+  }
+  for (size_t i = 0; i < observers.size(); ++i) {
+    delete observers[i];
+  }
+  RaiseEvent(kEventId, hmi_apis::messageType::response, 0);
+
+  ASSERT_EQ(10u, record.size());
+  for (int32_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(i * 100, record[i]);
+  }
+}
+
+}  // namespace application_manager
+}  // namespace components
+}  // namespace test
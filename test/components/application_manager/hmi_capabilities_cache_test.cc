@@ -0,0 +1,223 @@
+/*
+* Copyright (c) 2014, Ford Motor Company
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice,
+* this list of conditions and the following
+* disclaimer in the documentation and/or other materials provided with the
+* distribution.
+*
+* Neither the name of the Ford Motor Company nor the names of its contributors
+* may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+#include "utils/macro.h"
+#include "utils/file_system.h"
+#include "smart_objects/smart_object.h"
+#include "config_profile/profile.h"
+#include "application_manager/hmi_capabilities.h"
+
+namespace test {
+namespace components {
+namespace application_manager {
+
+namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
+
+const char kSource[] = "{ \"UI\": { \"language\": \"EN-US\" } }";
+// Size of cache header, six 32-bit fields
+const size_t kHeaderSize = 6 * sizeof(uint32_t);
+const size_t kPayloadSizeOffset = 4 * sizeof(uint32_t);
+const size_t kPayloadHashOffset = 5 * sizeof(uint32_t);
+
+class TestHMICapabilities : public ::application_manager::HMICapabilities {
+ public:
+  TestHMICapabilities()
+    : HMICapabilities(NULL) {
+  }
+  using HMICapabilities::load_capabilities_from_cache;
+  using HMICapabilities::save_capabilities_to_cache;
+};
+
+std::string CachePath() {
+  std::string path = profile::Profile::instance()->app_storage_folder();
+  if (!path.empty()) {
+    file_system::CreateDirectoryRecursively(path);
+    path += "/";
+  }
+  return path + "hmi_capabilities.cache";
+}
+
+// FNV-1a, as cache hashes its payload
+uint32_t Hash(const uint8_t* data, size_t size) {
+  uint32_t hash = 2166136261U;
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ data[i]) * 16777619U;
+  }
+  return hash;
+}
+
+void PutUInt32(uint32_t value, size_t offset, std::vector<uint8_t>* cache) {
+  memcpy(&(*cache)[offset], &value, sizeof(value));
+}
+
+smart_objects::SmartObject CreateDisplayCapabilities() {
+  smart_objects::SmartObject display(smart_objects::SmartType_Map);
+  display["displayType"] = "GEN2_8_DMA";
+  display["graphicSupported"] = true;
+  display["numCustomPresetsAvailable"] = 8;
+  display["screenScale"] = 1.5;
+  display["textFields"][0]["name"] = "mainField1";
+  display["textFields"][0]["width"] = 500;
+  display["textFields"][1]["name"] = "mainField2";
+  display["templatesAvailable"] = smart_objects::SmartObject(
+      smart_objects::SmartType_Array);
+  const uint8_t icon[] = { 0x89, 0x50, 0x4E, 0x47 };
+  display["icon"] = smart_objects::SmartBinary(icon, icon + sizeof(icon));
+  return display;
+}
+
+class HMICapabilitiesCacheTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    file_system::DeleteFile(CachePath());
+  }
+  virtual void TearDown() {
+    file_system::DeleteFile(CachePath());
+  }
+
+  // Saves capabilities made of display capabilities and languages
+  void SaveCache(const std::string& source) {
+    TestHMICapabilities capabilities;
+    capabilities.set_active_ui_language(hmi_apis::Common_Language::DE_DE);
+    capabilities.set_active_vr_language(hmi_apis::Common_Language::FR_FR);
+    capabilities.set_active_tts_language(hmi_apis::Common_Language::EN_GB);
+    capabilities.set_display_capabilities(CreateDisplayCapabilities());
+    capabilities.save_capabilities_to_cache(source);
+  }
+
+  std::vector<uint8_t> ReadCache() {
+    std::vector<uint8_t> cache;
+    EXPECT_TRUE(file_system::ReadBinaryFile(CachePath(), cache));
+    return cache;
+  }
+
+  void WriteCache(const std::vector<uint8_t>& cache) {
+    ASSERT_TRUE(file_system::WriteBinaryFile(CachePath(), cache));
+  }
+};
+
+TEST_F(HMICapabilitiesCacheTest, RoundTrip) {
+  SaveCache(kSource);
+
+  TestHMICapabilities capabilities;
+  ASSERT_TRUE(capabilities.load_capabilities_from_cache(kSource));
+  EXPECT_EQ(hmi_apis::Common_Language::DE_DE,
+            capabilities.active_ui_language());
+  EXPECT_EQ(hmi_apis::Common_Language::FR_FR,
+            capabilities.active_vr_language());
+  EXPECT_EQ(hmi_apis::Common_Language::EN_GB,
+            capabilities.active_tts_language());
+  ASSERT_TRUE(NULL != capabilities.display_capabilities());
+  EXPECT_TRUE(CreateDisplayCapabilities() ==
+              *capabilities.display_capabilities());
+}
+
+TEST_F(HMICapabilitiesCacheTest, MissingCacheIsNotLoaded) {
+  TestHMICapabilities capabilities;
+  EXPECT_FALSE(capabilities.load_capabilities_from_cache(kSource));
+}
+
+TEST_F(HMICapabilitiesCacheTest, ChangedSourceIsNotLoaded) {
+  SaveCache(kSource);
+
+  TestHMICapabilities capabilities;
+  // Same size, different content
+  std::string changed(kSource);
+  changed[changed.size() - 3] = 'x';
+  EXPECT_FALSE(capabilities.load_capabilities_from_cache(changed));
+  EXPECT_FALSE(capabilities.load_capabilities_from_cache(
+      std::string(kSource) + " "));
+}
+
+TEST_F(HMICapabilitiesCacheTest, TruncatedCacheIsNotLoaded) {
+  SaveCache(kSource);
+  std::vector<uint8_t> cache = ReadCache();
+  ASSERT_LT(kHeaderSize, cache.size());
+
+  cache.resize(cache.size() - 1);
+  WriteCache(cache);
+  TestHMICapabilities capabilities;
+  EXPECT_FALSE(capabilities.load_capabilities_from_cache(kSource));
+
+  cache.resize(kHeaderSize - 1);
+  WriteCache(cache);
+  EXPECT_FALSE(capabilities.load_capabilities_from_cache(kSource));
+}
+
+TEST_F(HMICapabilitiesCacheTest, CorruptPayloadIsNotLoaded) {
+  SaveCache(kSource);
+  std::vector<uint8_t> cache = ReadCache();
+  ASSERT_LT(kHeaderSize, cache.size());
+
+  cache[cache.size() - 1] ^= 0xFF;
+  WriteCache(cache);
+  TestHMICapabilities capabilities;
+  EXPECT_FALSE(capabilities.load_capabilities_from_cache(kSource));
+}
+
+TEST_F(HMICapabilitiesCacheTest, CorruptHashIsNotLoaded) {
+  SaveCache(kSource);
+  std::vector<uint8_t> cache = ReadCache();
+  ASSERT_LT(kHeaderSize, cache.size());
+
+  cache[kPayloadHashOffset] ^= 0xFF;
+  WriteCache(cache);
+  TestHMICapabilities capabilities;
+  EXPECT_FALSE(capabilities.load_capabilities_from_cache(kSource));
+}
+
+TEST_F(HMICapabilitiesCacheTest, TruncatedPayloadWithValidHashIsNotLoaded) {
+  SaveCache(kSource);
+  std::vector<uint8_t> cache = ReadCache();
+  ASSERT_LT(kHeaderSize + 1, cache.size());
+
+  // Header matches payload, reader has to notice objects are cut
+  cache.resize(cache.size() - 1);
+  const uint32_t payload_size = cache.size() - kHeaderSize;
+  PutUInt32(payload_size, kPayloadSizeOffset, &cache);
+  PutUInt32(Hash(&cache[kHeaderSize], payload_size),
+            kPayloadHashOffset, &cache);
+  WriteCache(cache);
+
+  TestHMICapabilities capabilities;
+  EXPECT_FALSE(capabilities.load_capabilities_from_cache(kSource));
+}
+
+}  // namespace application_manager
+}  // namespace components
+}  // namespace test
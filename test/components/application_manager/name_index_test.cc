@@ -0,0 +1,262 @@
+/*
+* Copyright (c) 2014, Ford Motor Company
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice,
+* this list of conditions and the following
+* disclaimer in the documentation and/or other materials provided with the
+* distribution.
+*
+* Neither the name of the Ford Motor Company nor the names of its contributors
+* may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "gtest/gtest.h"
+
+#include <stdio.h>
+#include <string>
+
+#include "application_manager/name_index.h"
+#include "application_manager/application_impl.h"
+#include "application_manager/smart_object_keys.h"
+#include "smart_objects/smart_object.h"
+
+namespace test {
+namespace components {
+namespace application_manager {
+
+using ::application_manager::NameIndex;
+using ::application_manager::ApplicationImpl;
+namespace strings = ::application_manager::strings;
+namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
+
+TEST(NameIndexTest, CaseSensitive) {
+  NameIndex index(NameIndex::kCaseSensitive);
+  index.Add("Play");
+  ASSERT_TRUE(index.Contains("Play"));
+  ASSERT_FALSE(index.Contains("play"));
+  ASSERT_FALSE(index.Contains("Pla"));
+}
+
+TEST(NameIndexTest, CaseInsensitive) {
+  NameIndex index(NameIndex::kCaseInsensitive);
+  index.Add("Play Music");
+  ASSERT_TRUE(index.Contains("play music"));
+  ASSERT_TRUE(index.Contains("PLAY MUSIC"));
+  ASSERT_FALSE(index.Contains("play"));
+}
+
+TEST(NameIndexTest, NameIsCountedUntilLastRemove) {
+  NameIndex index(NameIndex::kCaseInsensitive);
+  index.Add("Stop");
+  index.Add("STOP");
+  ASSERT_EQ(1u, index.size());
+  index.Remove("stop");
+  ASSERT_TRUE(index.Contains("Stop"));
+  index.Remove("Stop");
+  ASSERT_FALSE(index.Contains("Stop"));
+  ASSERT_EQ(0u, index.size());
+  // Removing absent name is harmless
+  index.Remove("Stop");
+  ASSERT_EQ(0u, index.size());
+}
+
+TEST(NameIndexTest, ManyNames) {
+  NameIndex index(NameIndex::kCaseSensitive);
+  const int kCount = 1000;
+  char name[16];
+  for (int i = 0; i < kCount; ++i) {
+    snprintf(name, sizeof(name), "cmd%d", i);
+    index.Add(name);
+  }
+  ASSERT_EQ(static_cast<size_t>(kCount), index.size());
+  for (int i = 0; i < kCount; i += 2) {
+    snprintf(name, sizeof(name), "cmd%d", i);
+    index.Remove(name);
+  }
+  for (int i = 0; i < kCount; ++i) {
+    snprintf(name, sizeof(name), "cmd%d", i);
+    ASSERT_EQ(1 == i % 2, index.Contains(name));
+  }
+  index.Clear();
+  ASSERT_FALSE(index.Contains("cmd1"));
+}
+
+/**
+ * @brief Indexes of application data are checked through the same calls
+ * AddCommandRequest and CreateInteractionChoiceSetRequest make
+ */
+class ApplicationDataIndexTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    app_ = new ApplicationImpl(1, "name_index_test_app", NULL);
+    app_->set_mobile_app_id(smart_objects::SmartObject("name_index_test_app"));
+  }
+
+  virtual void TearDown() {
+    delete app_;
+  }
+
+  static smart_objects::SmartObject Command(const std::string& menu_name,
+                                            const std::string& vr_command) {
+    smart_objects::SmartObject command(smart_objects::SmartType_Map);
+    if (!menu_name.empty()) {
+      command[strings::menu_params][strings::menu_name] = menu_name;
+    }
+    if (!vr_command.empty()) {
+      command[strings::vr_commands][0] = vr_command;
+    }
+    return command;
+  }
+
+  static smart_objects::SmartObject ChoiceSet(int32_t first_choice_id,
+                                              int32_t choices_count) {
+    smart_objects::SmartObject choice_set(smart_objects::SmartType_Map);
+    for (int32_t i = 0; i < choices_count; ++i) {
+      choice_set[strings::choice_set][i][strings::choice_id] =
+          first_choice_id + i;
+    }
+    return choice_set;
+  }
+
+  static smart_objects::SmartObject SubMenu(const std::string& menu_name) {
+    smart_objects::SmartObject menu(smart_objects::SmartType_Map);
+    menu[strings::menu_name] = menu_name;
+    return menu;
+  }
+
+  ApplicationImpl* app_;
+};
+
+TEST_F(ApplicationDataIndexTest, CommandNamesFollowAddRemove) {
+  smart_objects::SmartObject command = Command("Play", "Play Music");
+  command[strings::vr_commands][1] = "Start";
+  app_->AddCommand(1, command);
+  ASSERT_TRUE(app_->IsCommandMenuNameAlreadyExist("Play"));
+  ASSERT_FALSE(app_->IsCommandMenuNameAlreadyExist("play"));
+  ASSERT_TRUE(app_->IsCommandVRSynonymAlreadyExist("play music"));
+  ASSERT_TRUE(app_->IsCommandVRSynonymAlreadyExist("START"));
+
+  app_->RemoveCommand(1);
+  ASSERT_FALSE(app_->IsCommandMenuNameAlreadyExist("Play"));
+  ASSERT_FALSE(app_->IsCommandVRSynonymAlreadyExist("Play Music"));
+  ASSERT_FALSE(app_->IsCommandVRSynonymAlreadyExist("Start"));
+
+  // Removing absent command keeps indexes intact
+  app_->AddCommand(2, Command("Stop", "Stop"));
+  app_->RemoveCommand(1);
+  ASSERT_TRUE(app_->IsCommandMenuNameAlreadyExist("Stop"));
+  ASSERT_TRUE(app_->IsCommandVRSynonymAlreadyExist("Stop"));
+}
+
+TEST_F(ApplicationDataIndexTest, ReplacedCommandNamesAreDropped) {
+  app_->AddCommand(1, Command("Play", "Play"));
+  app_->AddCommand(1, Command("Pause", "Pause"));
+  ASSERT_EQ(1u, app_->commands_map().size());
+  ASSERT_FALSE(app_->IsCommandMenuNameAlreadyExist("Play"));
+  ASSERT_FALSE(app_->IsCommandVRSynonymAlreadyExist("Play"));
+  ASSERT_TRUE(app_->IsCommandMenuNameAlreadyExist("Pause"));
+  ASSERT_TRUE(app_->IsCommandVRSynonymAlreadyExist("Pause"));
+
+  app_->RemoveCommand(1);
+  ASSERT_FALSE(app_->IsCommandMenuNameAlreadyExist("Pause"));
+  ASSERT_FALSE(app_->IsCommandVRSynonymAlreadyExist("Pause"));
+}
+
+TEST_F(ApplicationDataIndexTest, SharedCommandNamesStayUntilLastRemove) {
+  app_->AddCommand(1, Command("Next", "Go"));
+  app_->AddCommand(2, Command("Next", "GO"));
+  // Command without menu params or VR commands is not indexed
+  app_->AddCommand(3, Command("", ""));
+
+  app_->RemoveCommand(1);
+  app_->RemoveCommand(3);
+  ASSERT_TRUE(app_->IsCommandMenuNameAlreadyExist("Next"));
+  ASSERT_TRUE(app_->IsCommandVRSynonymAlreadyExist("go"));
+
+  app_->RemoveCommand(2);
+  ASSERT_FALSE(app_->IsCommandMenuNameAlreadyExist("Next"));
+  ASSERT_FALSE(app_->IsCommandVRSynonymAlreadyExist("go"));
+}
+
+TEST_F(ApplicationDataIndexTest, SubMenuNamesFollowAddRemove) {
+  app_->AddSubMenu(10, SubMenu("Media"));
+  app_->AddSubMenu(11, SubMenu("Media"));
+  app_->AddSubMenu(10, SubMenu("Radio"));
+  ASSERT_TRUE(app_->IsSubMenuNameAlreadyExist("Media"));
+  ASSERT_TRUE(app_->IsSubMenuNameAlreadyExist("Radio"));
+
+  app_->RemoveSubMenu(11);
+  ASSERT_FALSE(app_->IsSubMenuNameAlreadyExist("Media"));
+  app_->RemoveSubMenu(10);
+  ASSERT_FALSE(app_->IsSubMenuNameAlreadyExist("Radio"));
+}
+
+TEST_F(ApplicationDataIndexTest, ChoiceIdsFollowAddRemove) {
+  app_->AddChoiceSet(100, ChoiceSet(1, 2));
+  ASSERT_TRUE(app_->IsChoiceIdAlreadyExist(1));
+  ASSERT_TRUE(app_->IsChoiceIdAlreadyExist(2));
+  ASSERT_FALSE(app_->IsChoiceIdAlreadyExist(3));
+
+  app_->RemoveChoiceSet(100);
+  ASSERT_FALSE(app_->IsChoiceIdAlreadyExist(1));
+  ASSERT_FALSE(app_->IsChoiceIdAlreadyExist(2));
+  ASSERT_TRUE(app_->choice_set_map().empty());
+}
+
+TEST_F(ApplicationDataIndexTest, ReplacedChoiceSetIdsAreDropped) {
+  app_->AddChoiceSet(100, ChoiceSet(1, 2));
+  app_->AddChoiceSet(100, ChoiceSet(5, 1));
+  ASSERT_EQ(1u, app_->choice_set_map().size());
+  ASSERT_FALSE(app_->IsChoiceIdAlreadyExist(1));
+  ASSERT_FALSE(app_->IsChoiceIdAlreadyExist(2));
+  ASSERT_TRUE(app_->IsChoiceIdAlreadyExist(5));
+}
+
+TEST_F(ApplicationDataIndexTest, DuplicateChoiceIdsAreCounted) {
+  // Choice 2 is in both sets, choice 7 twice in one set
+  smart_objects::SmartObject choice_set = ChoiceSet(1, 2);
+  choice_set[strings::choice_set][2][strings::choice_id] = 7;
+  choice_set[strings::choice_set][3][strings::choice_id] = 7;
+  app_->AddChoiceSet(100, choice_set);
+  app_->AddChoiceSet(101, ChoiceSet(2, 2));
+
+  app_->RemoveChoiceSet(100);
+  ASSERT_FALSE(app_->IsChoiceIdAlreadyExist(1));
+  ASSERT_TRUE(app_->IsChoiceIdAlreadyExist(2));
+  ASSERT_TRUE(app_->IsChoiceIdAlreadyExist(3));
+  ASSERT_FALSE(app_->IsChoiceIdAlreadyExist(7));
+
+  app_->AddChoiceSet(102, choice_set);
+  app_->RemoveChoiceSet(101);
+  ASSERT_TRUE(app_->IsChoiceIdAlreadyExist(2));
+  ASSERT_FALSE(app_->IsChoiceIdAlreadyExist(3));
+  ASSERT_TRUE(app_->IsChoiceIdAlreadyExist(7));
+
+  app_->RemoveChoiceSet(102);
+  ASSERT_FALSE(app_->IsChoiceIdAlreadyExist(2));
+  ASSERT_FALSE(app_->IsChoiceIdAlreadyExist(7));
+}
+
+}  // namespace application_manager
+}  // namespace components
+}  // namespace test
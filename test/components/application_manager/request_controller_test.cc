@@ -0,0 +1,235 @@
+/*
+* Copyright (c) 2014, Ford Motor Company
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice,
+* this list of conditions and the following
+* disclaimer in the documentation and/or other materials provided with the
+* distribution.
+*
+* Neither the name of the Ford Motor Company nor the names of its contributors
+* may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "gtest/gtest.h"
+
+#include "application_manager/request_controller.h"
+#include "application_manager/commands/command_request_impl.h"
+#include "application_manager/smart_object_keys.h"
+#include "config_profile/profile.h"
+#include "utils/conditional_variable.h"
+#include "utils/lock.h"
+
+namespace test {
+namespace components {
+namespace application_manager {
+
+using ::application_manager::request_controller::RequestController;
+using ::application_manager::commands::CommandRequestImpl;
+using ::application_manager::MessageSharedPtr;
+namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
+namespace strings = ::application_manager::strings;
+
+// Expiration is reported after timeout and time given to HMI to respond
+const int32_t kExpirationWaitMs = 3000;
+
+class TimeOutCounter {
+ public:
+  TimeOutCounter()
+    : count_(0) {
+  }
+  void OnTimeOut() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    ++count_;
+    changed_.NotifyOne();
+  }
+  // Waits until onTimeOut is called given number of times
+  bool WaitFor(uint32_t count) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    while (count_ < count) {
+      if (sync_primitives::ConditionalVariable::kTimeout ==
+          changed_.WaitFor(auto_lock, kExpirationWaitMs)) {
+        return count_ >= count;
+      }
+    }
+    return true;
+  }
+  uint32_t count() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    return count_;
+  }
+ private:
+  uint32_t count_;
+  sync_primitives::Lock lock_;
+  sync_primitives::ConditionalVariable changed_;
+};
+
+MessageSharedPtr CreateMessage(uint32_t connection_key,
+                               uint32_t correlation_id) {
+  MessageSharedPtr message(
+      new smart_objects::SmartObject(smart_objects::SmartType_Map));
+  (*message)[strings::params][strings::connection_key] = connection_key;
+  (*message)[strings::params][strings::correlation_id] = correlation_id;
+  return message;
+}
+
+class TestRequest : public CommandRequestImpl {
+ public:
+  TestRequest(uint32_t connection_key, uint32_t correlation_id,
+              uint32_t timeout, TimeOutCounter* counter = NULL)
+    : CommandRequestImpl(CreateMessage(connection_key, correlation_id)),
+      counter_(counter) {
+    default_timeout_ = timeout;
+  }
+  virtual void onTimeOut() {
+    if (counter_) {
+      counter_->OnTimeOut();
+    }
+  }
+ private:
+  TimeOutCounter* counter_;
+};
+
+RequestController::Request CreateRequest(uint32_t connection_key,
+                                         uint32_t correlation_id,
+                                         uint32_t timeout = 0,
+                                         TimeOutCounter* counter = NULL) {
+  return RequestController::Request(
+      new TestRequest(connection_key, correlation_id, timeout, counter));
+}
+
+TEST(RequestControllerTest, AddedRequestIsFound) {
+  RequestController controller;
+  RequestController::Request request = CreateRequest(1, 10);
+  EXPECT_EQ(RequestController::SUCCESS,
+            controller.addRequest(request, mobile_apis::HMILevel::HMI_FULL));
+
+  EXPECT_EQ(request.get(), controller.findRequest(1, 10).get());
+  EXPECT_FALSE(controller.findRequest(1, 11).valid());
+  EXPECT_FALSE(controller.findRequest(2, 10).valid());
+}
+
+TEST(RequestControllerTest, RequestWithSameIdReplacesPendingOne) {
+  RequestController controller;
+  RequestController::Request first = CreateRequest(1, 10);
+  RequestController::Request second = CreateRequest(1, 10);
+  controller.addRequest(first, mobile_apis::HMILevel::HMI_FULL);
+  controller.addRequest(second, mobile_apis::HMILevel::HMI_FULL);
+
+  EXPECT_EQ(second.get(), controller.findRequest(1, 10).get());
+}
+
+TEST(RequestControllerTest, TerminateSameCorrelationIdOnTwoConnections) {
+  RequestController controller;
+  RequestController::Request first = CreateRequest(1, 10);
+  RequestController::Request second = CreateRequest(2, 10);
+  controller.addRequest(first, mobile_apis::HMILevel::HMI_FULL);
+  controller.addRequest(second, mobile_apis::HMILevel::HMI_FULL);
+
+  controller.terminateRequest(1, 10);
+  EXPECT_FALSE(controller.findRequest(1, 10).valid());
+  EXPECT_EQ(second.get(), controller.findRequest(2, 10).get());
+
+  controller.terminateRequest(2, 10);
+  EXPECT_FALSE(controller.findRequest(2, 10).valid());
+}
+
+TEST(RequestControllerTest, TerminateAppRequestsKeepsOtherApplications) {
+  RequestController controller;
+  controller.addRequest(CreateRequest(1, 10), mobile_apis::HMILevel::HMI_FULL);
+  controller.addRequest(CreateRequest(1, 11), mobile_apis::HMILevel::HMI_FULL);
+  controller.addRequest(CreateRequest(2, 10), mobile_apis::HMILevel::HMI_FULL);
+
+  controller.terminateAppRequests(1);
+  EXPECT_FALSE(controller.findRequest(1, 10).valid());
+  EXPECT_FALSE(controller.findRequest(1, 11).valid());
+  EXPECT_TRUE(controller.findRequest(2, 10).valid());
+}
+
+TEST(RequestControllerTest, ExpiredRequestIsTimedOut) {
+  TimeOutCounter counter;
+  RequestController controller;
+  controller.addRequest(CreateRequest(1, 10, 10, &counter),
+                        mobile_apis::HMILevel::HMI_FULL);
+
+  EXPECT_TRUE(counter.WaitFor(1));
+  // Request stays registered until response terminates it
+  EXPECT_TRUE(controller.findRequest(1, 10).valid());
+}
+
+TEST(RequestControllerTest, TerminatedRequestIsNotTimedOut) {
+  TimeOutCounter counter;
+  RequestController controller;
+  controller.addRequest(CreateRequest(1, 10, 10, &counter),
+                        mobile_apis::HMILevel::HMI_FULL);
+  controller.terminateRequest(1, 10);
+
+  EXPECT_FALSE(counter.WaitFor(1));
+}
+
+TEST(RequestControllerTest, UpdateRequestTimeoutRearmsExpiredRequest) {
+  TimeOutCounter counter;
+  RequestController controller;
+  controller.addRequest(CreateRequest(1, 10, 10, &counter),
+                        mobile_apis::HMILevel::HMI_FULL);
+  ASSERT_TRUE(counter.WaitFor(1));
+
+  controller.updateRequestTimeout(1, 10, 10);
+  EXPECT_TRUE(counter.WaitFor(2));
+}
+
+TEST(RequestControllerTest, UpdateRequestTimeoutTracksUntrackedRequest) {
+  TimeOutCounter counter;
+  RequestController controller;
+  // Zero timeout is not tracked
+  controller.addRequest(CreateRequest(1, 10, 0, &counter),
+                        mobile_apis::HMILevel::HMI_FULL);
+
+  controller.updateRequestTimeout(1, 10, 10);
+  EXPECT_TRUE(counter.WaitFor(1));
+  EXPECT_EQ(1u, counter.count());
+}
+
+TEST(RequestControllerTest, HmiLevelNoneRequestsAreLimited) {
+  const uint32_t max_requests = profile::Profile::instance()->
+      app_hmi_level_none_time_scale_max_requests();
+  RequestController controller;
+  uint32_t correlation_id = 0;
+  for (; correlation_id < max_requests; ++correlation_id) {
+    ASSERT_EQ(RequestController::SUCCESS,
+              controller.addRequest(CreateRequest(1, correlation_id),
+                                    mobile_apis::HMILevel::HMI_NONE));
+  }
+
+  EXPECT_EQ(RequestController::NONE_HMI_LEVEL_MANY_REQUESTS,
+            controller.addRequest(CreateRequest(1, correlation_id),
+                                  mobile_apis::HMILevel::HMI_NONE));
+  // Limit applies per application
+  EXPECT_EQ(RequestController::SUCCESS,
+            controller.addRequest(CreateRequest(2, correlation_id),
+                                  mobile_apis::HMILevel::HMI_NONE));
+}
+
+}  // namespace application_manager
+}  // namespace components
+}  // namespace test
@@ -135,12 +135,10 @@ class ApplicationManagerImplTest {
   am::mobile_api::AppInterfaceUnregisteredReason::eType
   GetUnregisterReason();
 
-  const am::impl::FromMobileQueue& GetMessagesFromMobile();
+  const am::StrandExecutor& GetIncomingMessages();
 
   const am::impl::ToMobileQueue& GetMessagesToMobile();
 
-  const am::impl::FromHmiQueue& GetMessagesFromHmi();
-
   const am::impl::ToHmiQueue& GetMessagesToHmi();
 
  private:
@@ -1108,12 +1108,18 @@ TEST(TestApplicationManager, begin_end_audio_pass_thru) {
 
   /****************************************************************************/
 
+  EXPECT_FALSE(app_manager->audio_pass_thru_active());
+
   EXPECT_TRUE(app_manager->begin_audio_pass_thru());
 
+  EXPECT_TRUE(app_manager->audio_pass_thru_active());
+
   EXPECT_FALSE(app_manager->begin_audio_pass_thru());
 
   EXPECT_TRUE(app_manager->end_audio_pass_thru());
 
+  EXPECT_FALSE(app_manager->audio_pass_thru_active());
+
   EXPECT_FALSE(app_manager->end_audio_pass_thru());
 }
 
@@ -126,9 +126,9 @@ ApplicationManagerImplTest::GetUnregisterReason() {
   return app_->unregister_reason_;
 }
 
-const am::impl::FromMobileQueue&
-ApplicationManagerImplTest::GetMessagesFromMobile() {
-  return app_->messages_from_mobile_;
+const am::StrandExecutor&
+ApplicationManagerImplTest::GetIncomingMessages() {
+  return app_->incoming_messages_;
 }
 
 const am::impl::ToMobileQueue&
@@ -136,10 +136,6 @@ ApplicationManagerImplTest::GetMessagesToMobile() {
   return app_->messages_to_mobile_;
 }
 
-const am::impl::FromHmiQueue& ApplicationManagerImplTest::GetMessagesFromHmi() {
-  return app_->messages_from_hmi_;
-}
-
 const am::impl::ToHmiQueue& ApplicationManagerImplTest::GetMessagesToHmi() {
   return app_->messages_to_hmi_;
 }
@@ -0,0 +1,143 @@
+/*
+* Copyright (c) 2014, Ford Motor Company
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice,
+* this list of conditions and the following
+* disclaimer in the documentation and/or other materials provided with the
+* distribution.
+*
+* Neither the name of the Ford Motor Company nor the names of its contributors
+* may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "application_manager/strand_executor.h"
+#include "utils/lock.h"
+#include "utils/conditional_variable.h"
+
+namespace test {
+namespace components {
+namespace application_manager {
+
+using ::application_manager::StrandExecutor;
+
+class RecordingTask : public StrandExecutor::Task {
+ public:
+  RecordingTask(uint32_t value, sync_primitives::Lock* lock,
+                std::vector<uint32_t>* record)
+    : value_(value), lock_(lock), record_(record) {
+  }
+  virtual void Run() {
+    sync_primitives::AutoLock auto_lock(*lock_);
+    record_->push_back(value_);
+  }
+ private:
+  uint32_t value_;
+  sync_primitives::Lock* lock_;
+  std::vector<uint32_t>* record_;
+};
+
+// Blocks its strand until released
+class GateTask : public StrandExecutor::Task {
+ public:
+  GateTask() : started_(false), opened_(false) {
+  }
+  virtual void Run() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    started_ = true;
+    state_changed_.Broadcast();
+    while (!opened_) {
+      state_changed_.Wait(auto_lock);
+    }
+  }
+  void WaitStarted() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    while (!started_) {
+      state_changed_.Wait(auto_lock);
+    }
+  }
+  void Open() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    opened_ = true;
+    state_changed_.Broadcast();
+  }
+ private:
+  bool started_;
+  bool opened_;
+  sync_primitives::Lock lock_;
+  sync_primitives::ConditionalVariable state_changed_;
+};
+
+TEST(StrandExecutorTest, TasksOfStrandKeepOrder) {
+  const uint32_t kStrands = 8;
+  const uint32_t kTasks = 1000;
+  sync_primitives::Lock lock;
+  std::vector<uint32_t> records[kStrands];
+  {
+    StrandExecutor executor("test_strand_", 4);
+    for (uint32_t i = 0; i < kTasks; ++i) {
+      for (uint32_t strand = 0; strand < kStrands; ++strand) {
+        executor.Post(strand, new RecordingTask(i, &lock, &records[strand]));
+      }
+    }
+  }
+  for (uint32_t strand = 0; strand < kStrands; ++strand) {
+    ASSERT_EQ(kTasks, records[strand].size());
+    for (uint32_t i = 0; i < kTasks; ++i) {
+      ASSERT_EQ(i, records[strand][i]);
+    }
+  }
+}
+
+TEST(StrandExecutorTest, BlockedStrandDoesNotBlockOthers) {
+  sync_primitives::Lock lock;
+  std::vector<uint32_t> record;
+  StrandExecutor executor("test_strand_", 2);
+
+  GateTask* gate = new GateTask;
+  executor.Post(1, gate);
+  gate->WaitStarted();
+  // queued behind the gate
+  executor.Post(1, new RecordingTask(1, &lock, &record));
+
+  GateTask* second_gate = new GateTask;
+  executor.Post(2, new RecordingTask(2, &lock, &record));
+  executor.Post(2, second_gate);
+  second_gate->WaitStarted();
+  {
+    sync_primitives::AutoLock auto_lock(lock);
+    ASSERT_EQ(1u, record.size());
+    ASSERT_EQ(2u, record[0]);
+  }
+  ASSERT_EQ(3u, executor.PendingTasks());
+
+  second_gate->Open();
+  gate->Open();
+}
+
+}  // namespace application_manager
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,132 @@
+/**
+*
+* Copyright (c) 2013, Ford Motor Company
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice,
+* this list of conditions and the following
+* disclaimer in the documentation and/or other materials provided with the
+* distribution.
+*
+* Neither the name of the Ford Motor Company nor the names of its contributors
+* may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef TEST_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_PASS_THRU_TEST_H_
+#define TEST_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_PASS_THRU_TEST_H_
+
+#include <math.h>
+#include <vector>
+#include "gmock/gmock.h"
+#include "media_manager/audio/audio_pass_thru_buffer.h"
+#include "media_manager/audio/pcm_converter.h"
+
+namespace test {
+namespace components {
+namespace media_manager_test {
+
+using media_manager::AudioPassThruBuffer;
+using media_manager::PcmConverter;
+using media_manager::PcmFormat;
+
+namespace {
+std::vector<uint8_t> Sine16(uint32_t rate, uint32_t samples) {
+  std::vector<uint8_t> pcm;
+  for (uint32_t i = 0; i < samples; ++i) {
+    const int16_t sample =
+      static_cast<int16_t>(10000 * sin(2 * M_PI * 440 * i / rate));
+    pcm.push_back(sample & 0xFF);
+    pcm.push_back((sample >> 8) & 0xFF);
+  }
+  return pcm;
+}
+}  // namespace
+
+TEST(AudioPassThruBufferTest, ReadsWrappedData) {
+  AudioPassThruBuffer buffer(12);
+  uint8_t data[16];
+  uint8_t out[16];
+  for (uint8_t i = 0; i < 16; ++i) {
+    data[i] = i;
+  }
+  buffer.Write(data, 8);
+  EXPECT_EQ(5u, buffer.Read(out, 5));
+  buffer.Write(data + 8, 8);
+  ASSERT_EQ(11u, buffer.size());
+  EXPECT_EQ(11u, buffer.Read(out, 16));
+  EXPECT_EQ(5, out[0]);
+  EXPECT_EQ(15, out[10]);
+  EXPECT_EQ(0u, buffer.overruns());
+}
+
+TEST(AudioPassThruBufferTest, OverwritesOldestAligned) {
+  AudioPassThruBuffer buffer(12);
+  uint8_t data[16];
+  uint8_t out[16];
+  for (uint8_t i = 0; i < 16; ++i) {
+    data[i] = i;
+  }
+  buffer.Write(data, 8);
+  buffer.Write(data + 8, 7);
+  EXPECT_EQ(1u, buffer.overruns());
+  ASSERT_EQ(11u, buffer.size());
+  buffer.Read(out, 16);
+  EXPECT_EQ(4, out[0]);
+  EXPECT_EQ(14, out[10]);
+}
+
+TEST(PcmConverterTest, DownsamplesTo8Bit) {
+  PcmConverter converter(PcmFormat(16000, 16), PcmFormat(8000, 8));
+  const std::vector<uint8_t> pcm = Sine16(16000, 16000);
+  std::vector<uint8_t> output;
+  // Chunk boundaries must not be audible
+  for (size_t offset = 0; offset < pcm.size(); offset += 1600) {
+    converter.Convert(&pcm[offset], 1600, &output);
+  }
+  ASSERT_EQ(8000u, output.size());
+  for (size_t i = 0; i < output.size(); ++i) {
+    const double expected = 10000 * sin(2 * M_PI * 440 * i / 8000.0) / 256;
+    EXPECT_NEAR(expected, static_cast<int32_t>(output[i]) - 128, 2.0);
+  }
+}
+
+TEST(PcmConverterTest, UpsamplesWithoutDrift) {
+  PcmConverter converter(PcmFormat(16000, 16), PcmFormat(44100, 16));
+  const std::vector<uint8_t> pcm = Sine16(16000, 16000);
+  std::vector<uint8_t> output;
+  for (size_t offset = 0; offset < pcm.size(); offset += 320) {
+    converter.Convert(&pcm[offset], 320, &output);
+  }
+  // Last source sample waits for next chunk to be interpolated
+  EXPECT_NEAR(44100, output.size() / 2, 3);
+  for (size_t i = 0; i < output.size() / 2; ++i) {
+    const int16_t sample = output[2 * i] | (output[2 * i + 1] << 8);
+    EXPECT_NEAR(10000 * sin(2 * M_PI * 440 * i / 44100.0), sample, 50);
+  }
+}
+
+}  // namespace media_manager_test
+}  // namespace components
+}  // namespace test
+
+#endif  // TEST_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_PASS_THRU_TEST_H_
@@ -0,0 +1,271 @@
+/**
+*
+* Copyright (c) 2013, Ford Motor Company
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice,
+* this list of conditions and the following
+* disclaimer in the documentation and/or other materials provided with the
+* distribution.
+*
+* Neither the name of the Ford Motor Company nor the names of its contributors
+* may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef TEST_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_VIDEO_FLOW_CONTROLLER_TEST_H_
+#define TEST_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_VIDEO_FLOW_CONTROLLER_TEST_H_
+
+#include <vector>
+#include "gmock/gmock.h"
+#include "media_manager/video/h264_access_unit_tracker.h"
+#include "media_manager/video/video_flow_controller.h"
+
+namespace test {
+namespace components {
+namespace media_manager_test {
+
+using media_manager::H264AccessUnitTracker;
+using media_manager::VideoFlowController;
+
+namespace {
+const uint8_t kSps = 0x67;
+const uint8_t kPps = 0x68;
+const uint8_t kIdrSlice = 0x65;
+const uint8_t kSlice = 0x41;
+// first_mb_in_slice is 0
+const uint8_t kFirstSlice = 0x88;
+const uint8_t kNextSlice = 0x48;
+const size_t kStartCodeSize = 4;
+
+void AppendNal(uint8_t header, uint8_t first_byte, std::vector<uint8_t>* stream) {
+  const uint8_t start_code[] = {0, 0, 0, 1};
+  stream->insert(stream->end(), start_code, start_code + kStartCodeSize);
+  stream->push_back(header);
+  stream->push_back(first_byte);
+  stream->insert(stream->end(), 10, 0xAA);
+}
+
+std::vector<uint8_t> KeyFrame() {
+  std::vector<uint8_t> frame;
+  AppendNal(kSps, 0x42, &frame);
+  AppendNal(kPps, 0xCE, &frame);
+  AppendNal(kIdrSlice, kFirstSlice, &frame);
+  return frame;
+}
+
+std::vector<uint8_t> InterFrame() {
+  std::vector<uint8_t> frame;
+  AppendNal(kSlice, kFirstSlice, &frame);
+  AppendNal(kSlice, kNextSlice, &frame);
+  return frame;
+}
+
+std::vector<uint8_t> Join(const std::vector<uint8_t>& first,
+                          const std::vector<uint8_t>& second) {
+  std::vector<uint8_t> result(first);
+  result.insert(result.end(), second.begin(), second.end());
+  return result;
+}
+}  // namespace
+
+TEST(H264AccessUnitTrackerTest, FindsAccessUnitAndKeyFrame) {
+  H264AccessUnitTracker tracker;
+  const std::vector<uint8_t> key = KeyFrame();
+  const std::vector<uint8_t> stream = Join(key, InterFrame());
+
+  const H264AccessUnitTracker::ChunkInfo info =
+    tracker.Process(&stream[0], stream.size());
+  // Access unit at the stream start has nothing before it to end
+  ASSERT_TRUE(info.access_unit);
+  EXPECT_EQ(static_cast<int32_t>(key.size()), info.access_unit_offset);
+  ASSERT_TRUE(info.key_frame);
+  EXPECT_EQ(static_cast<int32_t>(kStartCodeSize), info.key_frame_offset);
+  EXPECT_EQ(kSps, info.key_frame_header);
+}
+
+TEST(H264AccessUnitTrackerTest, SecondSliceDoesNotStartAccessUnit) {
+  H264AccessUnitTracker tracker;
+  const std::vector<uint8_t> first = InterFrame();
+  tracker.Process(&first[0], first.size());
+
+  std::vector<uint8_t> slices;
+  AppendNal(kSlice, kNextSlice, &slices);
+  AppendNal(kIdrSlice, kNextSlice, &slices);
+  const H264AccessUnitTracker::ChunkInfo info =
+    tracker.Process(&slices[0], slices.size());
+  EXPECT_FALSE(info.access_unit);
+  EXPECT_FALSE(info.key_frame);
+}
+
+TEST(H264AccessUnitTrackerTest, StartCodeSplitBetweenChunks) {
+  H264AccessUnitTracker tracker;
+  const std::vector<uint8_t> stream = Join(InterFrame(), InterFrame());
+  const size_t split = InterFrame().size() + 2;
+
+  const H264AccessUnitTracker::ChunkInfo first =
+    tracker.Process(&stream[0], split);
+  EXPECT_FALSE(first.access_unit);
+  const H264AccessUnitTracker::ChunkInfo second =
+    tracker.Process(&stream[split], stream.size() - split);
+  ASSERT_TRUE(second.access_unit);
+  EXPECT_EQ(-2, second.access_unit_offset);
+}
+
+TEST(H264AccessUnitTrackerTest, KeyFrameHeaderInPreviousChunk) {
+  H264AccessUnitTracker tracker;
+  std::vector<uint8_t> idr;
+  AppendNal(kIdrSlice, kFirstSlice, &idr);
+  const std::vector<uint8_t> stream = Join(InterFrame(), idr);
+  // Chunk ends right after header of IDR slice
+  const size_t split = InterFrame().size() + kStartCodeSize + 1;
+
+  const H264AccessUnitTracker::ChunkInfo first =
+    tracker.Process(&stream[0], split);
+  EXPECT_FALSE(first.key_frame);
+  const H264AccessUnitTracker::ChunkInfo second =
+    tracker.Process(&stream[split], stream.size() - split);
+  ASSERT_TRUE(second.key_frame);
+  EXPECT_EQ(-1, second.key_frame_offset);
+  EXPECT_EQ(kIdrSlice, second.key_frame_header);
+  ASSERT_TRUE(second.access_unit);
+  EXPECT_EQ(-static_cast<int32_t>(kStartCodeSize + 1),
+            second.access_unit_offset);
+}
+
+class VideoFlowControllerTest : public ::testing::Test {
+ protected:
+  // Drain rate is not measured within first second, so backlog
+  // is limited by 60 frames in flight
+  static const uint32_t kMaxFramesInFlight = 60;
+
+  bool Receive(const std::vector<uint8_t>& frame) {
+    return controller_.OnFrameReceived(&frame[0], frame.size(), &part_,
+                                       &frames_to_ack_);
+  }
+
+  void FillBacklog() {
+    const std::vector<uint8_t> frame = InterFrame();
+    for (uint32_t i = 0; i < kMaxFramesInFlight + 1; ++i) {
+      ASSERT_TRUE(Receive(frame));
+      EXPECT_EQ(0u, part_.offset);
+      EXPECT_EQ(frame.size(), part_.size);
+      EXPECT_EQ(0u, part_.prefix_size);
+    }
+  }
+
+  void Process(uint32_t frames) {
+    for (uint32_t i = 0; i < frames; ++i) {
+      controller_.OnFrameProcessed(&frames_to_ack_);
+    }
+  }
+
+  VideoFlowController controller_;
+  VideoFlowController::FramePart part_;
+  uint32_t frames_to_ack_;
+};
+
+TEST_F(VideoFlowControllerTest, DropsWholeFramesWhenBehind) {
+  FillBacklog();
+  EXPECT_FALSE(Receive(InterFrame()));
+  EXPECT_EQ(0u, part_.size);
+  // Consumed frames are acknowledged, dropped ones included
+  EXPECT_EQ(1u, frames_to_ack_);
+}
+
+TEST_F(VideoFlowControllerTest, CutsFrameAtAccessUnitBoundary) {
+  FillBacklog();
+  // Frame carries end of previous access unit and start of next one
+  std::vector<uint8_t> tail;
+  AppendNal(kSlice, kNextSlice, &tail);
+  const std::vector<uint8_t> frame = Join(tail, InterFrame());
+
+  ASSERT_TRUE(Receive(frame));
+  EXPECT_EQ(0u, part_.offset);
+  EXPECT_EQ(tail.size(), part_.size);
+  EXPECT_FALSE(Receive(InterFrame()));
+}
+
+TEST_F(VideoFlowControllerTest, KeepsStreamingInsideAccessUnit) {
+  FillBacklog();
+  std::vector<uint8_t> slice;
+  AppendNal(kSlice, kNextSlice, &slice);
+  // No access unit starts in frame, so nothing may be dropped yet
+  ASSERT_TRUE(Receive(slice));
+  EXPECT_EQ(slice.size(), part_.size);
+}
+
+TEST_F(VideoFlowControllerTest, ResumesAtKeyFrameWhenBacklogHalved) {
+  FillBacklog();
+  EXPECT_FALSE(Receive(InterFrame()));
+  // Backlog is still above half of the limit
+  EXPECT_FALSE(Receive(KeyFrame()));
+
+  Process(kMaxFramesInFlight / 2 + 1);
+  EXPECT_FALSE(Receive(InterFrame()));
+
+  std::vector<uint8_t> tail;
+  AppendNal(kSlice, kNextSlice, &tail);
+  const std::vector<uint8_t> frame = Join(tail, KeyFrame());
+  ASSERT_TRUE(Receive(frame));
+  ASSERT_EQ(kStartCodeSize, part_.prefix_size);
+  EXPECT_EQ(0, part_.prefix[0]);
+  EXPECT_EQ(1, part_.prefix[3]);
+  // Part starts with SPS header, its start code is replaced by prefix
+  EXPECT_EQ(tail.size() + kStartCodeSize, part_.offset);
+  EXPECT_EQ(frame.size() - part_.offset, part_.size);
+  EXPECT_EQ(kSps, frame[part_.offset]);
+
+  EXPECT_TRUE(Receive(InterFrame()));
+  EXPECT_EQ(0u, part_.prefix_size);
+}
+
+TEST_F(VideoFlowControllerTest, ResumesWithKeyFrameHeaderOfPreviousFrame) {
+  FillBacklog();
+  EXPECT_FALSE(Receive(InterFrame()));
+  Process(kMaxFramesInFlight);
+
+  std::vector<uint8_t> idr;
+  AppendNal(kIdrSlice, kFirstSlice, &idr);
+  // Previous frame ends with IDR slice header, it is dropped
+  const std::vector<uint8_t> head(idr.begin(),
+                                  idr.begin() + kStartCodeSize + 1);
+  EXPECT_FALSE(Receive(Join(InterFrame(), head)));
+  const std::vector<uint8_t> rest(idr.begin() + kStartCodeSize + 1, idr.end());
+  ASSERT_TRUE(Receive(rest));
+  ASSERT_EQ(kStartCodeSize + 1, part_.prefix_size);
+  EXPECT_EQ(kIdrSlice, part_.prefix[kStartCodeSize]);
+  EXPECT_EQ(0u, part_.offset);
+  EXPECT_EQ(rest.size(), part_.size);
+}
+
+TEST_F(VideoFlowControllerTest, StartResetsState) {
+  FillBacklog();
+  EXPECT_FALSE(Receive(InterFrame()));
+  controller_.Start();
+  EXPECT_TRUE(Receive(InterFrame()));
+}
+
+}  // namespace media_manager_test
+}  // namespace components
+}  // namespace test
+
+#endif  // TEST_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_VIDEO_FLOW_CONTROLLER_TEST_H_
@@ -1,6 +1,4 @@
 /**
-* \file request_watchdog_test.cc
-* \brief RequetWatchdog test source file.
 *
 * Copyright (c) 2013, Ford Motor Company
 * All rights reserved.
@@ -33,4 +31,5 @@
 * POSSIBILITY OF SUCH DAMAGE.
 */
 
-#include "request_watchdog/request_watchdog_test.h"
+
+#include "media_manager/audio_pass_thru_test.h"
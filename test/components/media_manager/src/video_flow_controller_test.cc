@@ -1,6 +1,4 @@
 /**
-* \file request_info.h
-* \brief request information structure source file.
 *
 * Copyright (c) 2013, Ford Motor Company
 * All rights reserved.
@@ -33,16 +31,4 @@
 * POSSIBILITY OF SUCH DAMAGE.
 */
 
-#include "request_watchdog/watchdog.h"
-
-namespace request_watchdog {
-
-Watchdog::Watchdog() {
-
-}
-
-Watchdog::~Watchdog() {
-
-}
-
-}  // namespace request_watchdog
+#include "media_manager/video_flow_controller_test.h"
@@ -146,9 +146,9 @@ class MobileMessageHandlerTestObserverThread : public threads::ThreadDelegate {
 TEST(mobile_message_handler_test, component_test) {
   // Example message
   MobileMessage message(new application_manager::Message);
-  application_manager::BinaryData binary_data;
-  binary_data.push_back('X');
-  message->set_binary_data(&binary_data);
+  const uint8_t binary_data[] = {'X'};
+  message->set_binary_data(
+      application_manager::BinaryData(binary_data, sizeof(binary_data)));
   message->set_connection_key(100);
   message->set_correlation_id(10);
   message->set_function_id(5);
@@ -0,0 +1,265 @@
+/**
+ * Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "json/value.h"
+#include "json/writer.h"
+#include "rpc_base/json_stream.h"
+#include "rpc_base/rpc_base.h"
+#include "rpc_base/rpc_base_json_inl.h"
+#include "rpc_base/rpc_base_json_stream_inl.h"
+
+namespace test {
+using namespace rpc;
+
+namespace {
+enum TestEnum {
+  kValue0,
+  kValue1,
+  kInvalidValue
+};
+
+bool EnumFromJsonString(const std::string& value, TestEnum* enm) {
+  if (value == "kValue0") {
+    *enm = kValue0;
+    return true;
+  } else if (value == "kValue1") {
+    *enm = kValue1;
+    return true;
+  } else {
+    return false;
+  }
+}
+
+const char* EnumToJsonString(TestEnum enm) {
+  switch(enm) {
+    case kValue0: return "kValue0";
+    case kValue1: return "kValue1";
+    default: return "UNKNOWN";
+  }
+}
+
+class TestReader : public JsonReader {
+ public:
+  explicit TestReader(const std::string& json)
+    : JsonReader(json.data(), json.data() + json.size()) {
+  }
+};
+
+template<typename T>
+std::string WriteToString(const T& value) {
+  std::string result;
+  JsonWriter writer(&result);
+  value.WriteJson(&writer);
+  return result;
+}
+
+}  // namespace
+
+TEST(ValidatedTypesJsonStream, BooleanTest) {
+  const std::string json = "true";
+  TestReader reader(json);
+  Boolean boolean;
+  boolean.ReadJson(&reader);
+  ASSERT_TRUE(boolean.is_initialized());
+  ASSERT_TRUE(boolean.is_valid());
+  ASSERT_EQ(boolean, true);
+  ASSERT_EQ("true", WriteToString(boolean));
+}
+
+TEST(ValidatedTypesJsonStream, BooleanNullTest) {
+  const std::string json = "null";
+  TestReader reader(json);
+  Boolean boolean;
+  boolean.ReadJson(&reader);
+  ASSERT_TRUE(boolean.is_initialized());
+  ASSERT_FALSE(boolean.is_valid());
+  ASSERT_FALSE(reader.has_failed());
+}
+
+TEST(ValidatedTypesJsonStream, IntegerRangeTest) {
+  const std::string json = "[42, 193, -6, 1.5, \"1\"]";
+  TestReader reader(json);
+  Array<Integer<int32_t, -5, 192>, 0, 10> integers;
+  integers.ReadJson(&reader);
+  ASSERT_FALSE(reader.has_failed());
+  ASSERT_EQ(5u, integers.size());
+  ASSERT_TRUE(integers[0].is_valid());
+  ASSERT_EQ(42, integers[0]);
+  for (size_t i = 1; i < integers.size(); ++i) {
+    ASSERT_TRUE(integers[i].is_initialized());
+    ASSERT_FALSE(integers[i].is_valid());
+  }
+}
+
+TEST(ValidatedTypesJsonStream, Integer64Test) {
+  const std::string json = "[4294967296, -9223372036854775808, 9223372036854775808]";
+  TestReader reader(json);
+  Array<Integer<int64_t, INT64_C(-9223372036854775807) - 1,
+                INT64_C(9223372036854775807)>, 0, 10> integers;
+  integers.ReadJson(&reader);
+  ASSERT_EQ(3u, integers.size());
+  ASSERT_TRUE(integers[0].is_valid());
+  ASSERT_EQ(INT64_C(4294967296), integers[0]);
+  ASSERT_TRUE(integers[1].is_valid());
+  ASSERT_EQ(INT64_C(-9223372036854775807) - 1, integers[1]);
+  ASSERT_FALSE(integers[2].is_valid());
+  ASSERT_EQ("4294967296", WriteToString(integers[0]));
+}
+
+TEST(ValidatedTypesJsonStream, StringEscapesTest) {
+  const std::string json = "\"a\\\"b\\\\c\\/\\n\\u0041\\u00e9\\ud83d\\ude00\"";
+  TestReader reader(json);
+  String<1, 100> str;
+  str.ReadJson(&reader);
+  ASSERT_TRUE(str.is_valid());
+  ASSERT_EQ("a\"b\\c/\nA\xC3\xA9\xF0\x9F\x98\x80", std::string(str));
+  ASSERT_EQ(Json::FastWriter().write(str.ToJsonValue()),
+            WriteToString(str) + "\n");
+}
+
+TEST(ValidatedTypesJsonStream, StringLengthTest) {
+  const std::string json = "\"abcdef\"";
+  TestReader reader(json);
+  String<1, 5> str;
+  str.ReadJson(&reader);
+  ASSERT_TRUE(str.is_initialized());
+  ASSERT_FALSE(str.is_valid());
+}
+
+TEST(ValidatedTypesJsonStream, EnumTest) {
+  const std::string json = "[\"kValue1\", \"kValue2\"]";
+  TestReader reader(json);
+  Array<Enum<TestEnum>, 0, 5> enums;
+  enums.ReadJson(&reader);
+  ASSERT_EQ(2u, enums.size());
+  ASSERT_TRUE(enums[0].is_valid());
+  ASSERT_EQ(kValue1, enums[0]);
+  ASSERT_FALSE(enums[1].is_valid());
+}
+
+TEST(ValidatedTypesJsonStream, MapTest) {
+  const std::string json =
+      "{ \"b\" : [\"x\"], // comment\n \"a\" : [] /* comment */ }";
+  TestReader reader(json);
+  Map<Array<String<1, 5>, 0, 5>, 0, 5> map;
+  map.ReadJson(&reader);
+  ASSERT_FALSE(reader.has_failed());
+  ASSERT_TRUE(map.is_valid());
+  ASSERT_EQ(2u, map.size());
+  ASSERT_EQ("x", std::string(map["b"][0]));
+  ASSERT_EQ("{\"a\":[],\"b\":[\"x\"]}", WriteToString(map));
+  ASSERT_EQ(Json::FastWriter().write(map.ToJsonValue()),
+            WriteToString(map) + "\n");
+}
+
+TEST(ValidatedTypesJsonStream, ArrayOfInvalidTypeTest) {
+  const std::string json = "{\"a\" : 1}";
+  TestReader reader(json);
+  Array<String<1, 5>, 0, 5> array;
+  array.ReadJson(&reader);
+  ASSERT_FALSE(reader.has_failed());
+  ASSERT_TRUE(array.is_initialized());
+  ASSERT_FALSE(array.is_valid());
+}
+
+TEST(ValidatedTypesJsonStream, NullableTest) {
+  const std::string json = "{\"a\" : null, \"b\" : {\"c\" : true}}";
+  TestReader reader(json);
+  Map<Nullable<Map<Boolean, 0, 5> >, 0, 5> map;
+  map.ReadJson(&reader);
+  ASSERT_TRUE(map.is_valid());
+  ASSERT_TRUE(map["a"].is_null());
+  ASSERT_FALSE(map["b"].is_null());
+  ASSERT_EQ(true, map["b"]["c"]);
+  ASSERT_EQ("{\"a\":null,\"b\":{\"c\":true}}", WriteToString(map));
+}
+
+TEST(ValidatedTypesJsonStream, StringifyableTest) {
+  const std::string json = "{\"a\" : \"default\", \"b\" : [\"kValue0\"]}";
+  TestReader reader(json);
+  Map<Stringifyable<Array<Enum<TestEnum>, 1, 5> >, 0, 5> map;
+  map.ReadJson(&reader);
+  ASSERT_TRUE(map.is_valid());
+  ASSERT_TRUE(map["a"].is_string());
+  ASSERT_EQ("default", map["a"].get_string());
+  ASSERT_FALSE(map["b"].is_string());
+  ASSERT_EQ(kValue0, map["b"][0]);
+  ASSERT_EQ("{\"a\":\"default\",\"b\":[\"kValue0\"]}", WriteToString(map));
+}
+
+TEST(ValidatedTypesJsonStream, SyntaxErrorTest) {
+  const std::string json = "{\"a\" : [\"x\" \"y\"], \"b\" : []}";
+  TestReader reader(json);
+  Map<Array<String<1, 5>, 0, 5>, 0, 5> map;
+  map.ReadJson(&reader);
+  ASSERT_TRUE(reader.has_failed());
+}
+
+TEST(ValidatedTypesJsonStream, SkipValueTest) {
+  const std::string json =
+      "[{\"a\" : [1, -2.5e3, {\"b\" : null}], \"c\" : \"}\"}, false]";
+  TestReader reader(json);
+  reader.EnterArray();
+  ASSERT_TRUE(reader.NextElement());
+  reader.SkipValue();
+  ASSERT_TRUE(reader.NextElement());
+  ASSERT_TRUE(reader.NextIsBool());
+  ASSERT_FALSE(reader.TakeBool());
+  ASSERT_FALSE(reader.NextElement());
+  ASSERT_FALSE(reader.has_failed());
+}
+
+TEST(ValidatedTypesJsonStream, WriterMatchesFastWriterTest) {
+  Json::Value value(Json::objectValue);
+  value["double"] = 2.5;
+  value["whole"] = 5.0;
+  value["int"] = Json::Int64(-17);
+  value["control"] = "\x01\t";
+  std::string result;
+  JsonWriter writer(&result);
+  writer.BeginObject();
+  writer.PutKey("control");
+  writer.PutString("\x01\t");
+  writer.PutKey("double");
+  writer.PutDouble(2.5);
+  writer.PutKey("int");
+  writer.PutInteger(-17);
+  writer.PutKey("whole");
+  writer.PutDouble(5.0);
+  writer.EndObject();
+  ASSERT_EQ(Json::FastWriter().write(value), result + "\n");
+}
+
+}  // namespace test
@@ -0,0 +1,124 @@
+/*
+ * \file libusb_loopback.h
+ * \brief Stand-in of libusb with loopback bulk endpoints.
+ *
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef APPLINK_TEST_COMPONENTS_TRANSPORTMANAGER_INCLUDE_LIBUSB_LOOPBACK_H_
+#define APPLINK_TEST_COMPONENTS_TRANSPORTMANAGER_INCLUDE_LIBUSB_LOOPBACK_H_
+
+#include <pthread.h>
+#include <stdint.h>
+#include <deque>
+#include <set>
+#include <vector>
+
+#include <libusb/libusb.h>
+
+namespace test {
+namespace components {
+namespace transport_manager {
+
+/**
+ * @brief Device with one pair of bulk endpoints, everything written to
+ * OUT endpoint comes back from IN endpoint.
+ *
+ * Replaces libusb for the test, transfers are completed by own thread as
+ * libusb event thread does. A submitted transfer is started by host
+ * controller after transfer_latency_us, so throughput depends on how many
+ * transfers are kept in flight and how big they are. Other functions of
+ * libusb are stubs which report failure.
+ *
+ * Faults are injected by holding OUT transfers, limiting how many bytes
+ * one OUT transfer writes and unplugging the device.
+ */
+class LibusbLoopback {
+ public:
+  static LibusbLoopback* instance();
+
+  void Start(uint16_t max_packet_size, uint32_t transfer_latency_us);
+  void Stop();
+
+  libusb_device* device();
+  libusb_device_handle* device_handle();
+  uint16_t max_packet_size() const { return max_packet_size_; }
+
+  uint32_t in_transfers_count() const { return in_transfers_count_; }
+  uint32_t out_transfers_count() const { return out_transfers_count_; }
+  uint32_t max_in_flight() const { return max_in_flight_; }
+
+  // OUT transfers are not completed until released
+  void HoldOutTransfers();
+  void ReleaseOutTransfers();
+  // OUT transfer writes at most limit bytes, 0 is no limit
+  void set_out_transfer_limit(uint32_t limit);
+  // Pending transfers fail with LIBUSB_TRANSFER_NO_DEVICE,
+  // submitting new ones fails
+  void Unplug();
+
+  int Submit(libusb_transfer* transfer);
+  int Cancel(libusb_transfer* transfer);
+
+ private:
+  struct Pending {
+    libusb_transfer* transfer;
+    uint64_t ready_us;
+  };
+
+  LibusbLoopback();
+  static void* ThreadMain(void* self);
+  void Run();
+  static uint64_t NowUs();
+
+  pthread_t thread_;
+  pthread_mutex_t mutex_;
+  pthread_cond_t cond_;
+  bool running_;
+  bool out_held_;
+  bool unplugged_;
+  uint32_t out_transfer_limit_;
+  uint16_t max_packet_size_;
+  uint32_t transfer_latency_us_;
+  std::deque<Pending> in_pending_;
+  std::deque<Pending> out_pending_;
+  std::set<libusb_transfer*> cancelled_;
+  std::deque<unsigned char> loopback_;
+  uint32_t in_transfers_count_;
+  uint32_t out_transfers_count_;
+  uint32_t max_in_flight_;
+};
+
+}  // namespace transport_manager
+}  // namespace components
+}  // namespace test
+
+#endif  // APPLINK_TEST_COMPONENTS_TRANSPORTMANAGER_INCLUDE_LIBUSB_LOOPBACK_H_
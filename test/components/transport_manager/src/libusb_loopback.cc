@@ -0,0 +1,436 @@
+/*
+ * \file libusb_loopback.cc
+ * \brief Stand-in of libusb with loopback bulk endpoints.
+ *
+ * Copyright (c) 2013, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "transport_manager/libusb_loopback.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+
+struct libusb_device {
+  int unused;
+};
+
+struct libusb_device_handle {
+  int unused;
+};
+
+namespace {
+
+libusb_device loopback_device;
+libusb_device_handle loopback_device_handle;
+
+const uint8_t kInEndpoint = 0x81;
+const uint8_t kOutEndpoint = 0x01;
+
+}  // namespace
+
+namespace test {
+namespace components {
+namespace transport_manager {
+
+LibusbLoopback* LibusbLoopback::instance() {
+  static LibusbLoopback loopback;
+  return &loopback;
+}
+
+LibusbLoopback::LibusbLoopback()
+    : thread_(),
+      running_(false),
+      out_held_(false),
+      unplugged_(false),
+      out_transfer_limit_(0),
+      max_packet_size_(512),
+      transfer_latency_us_(0),
+      in_transfers_count_(0),
+      out_transfers_count_(0),
+      max_in_flight_(0) {
+  pthread_mutex_init(&mutex_, 0);
+  pthread_condattr_t attr;
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_cond_init(&cond_, &attr);
+  pthread_condattr_destroy(&attr);
+}
+
+libusb_device* LibusbLoopback::device() {
+  return &loopback_device;
+}
+
+libusb_device_handle* LibusbLoopback::device_handle() {
+  return &loopback_device_handle;
+}
+
+void LibusbLoopback::Start(uint16_t max_packet_size,
+                           uint32_t transfer_latency_us) {
+  max_packet_size_ = max_packet_size;
+  transfer_latency_us_ = transfer_latency_us;
+  in_transfers_count_ = 0;
+  out_transfers_count_ = 0;
+  max_in_flight_ = 0;
+  out_held_ = false;
+  unplugged_ = false;
+  out_transfer_limit_ = 0;
+  loopback_.clear();
+  running_ = true;
+  pthread_create(&thread_, 0, &LibusbLoopback::ThreadMain, this);
+}
+
+void LibusbLoopback::Stop() {
+  pthread_mutex_lock(&mutex_);
+  running_ = false;
+  pthread_cond_signal(&cond_);
+  pthread_mutex_unlock(&mutex_);
+  pthread_join(thread_, 0);
+}
+
+void LibusbLoopback::HoldOutTransfers() {
+  pthread_mutex_lock(&mutex_);
+  out_held_ = true;
+  pthread_mutex_unlock(&mutex_);
+}
+
+void LibusbLoopback::ReleaseOutTransfers() {
+  pthread_mutex_lock(&mutex_);
+  out_held_ = false;
+  pthread_cond_signal(&cond_);
+  pthread_mutex_unlock(&mutex_);
+}
+
+void LibusbLoopback::set_out_transfer_limit(uint32_t limit) {
+  pthread_mutex_lock(&mutex_);
+  out_transfer_limit_ = limit;
+  pthread_mutex_unlock(&mutex_);
+}
+
+void LibusbLoopback::Unplug() {
+  pthread_mutex_lock(&mutex_);
+  unplugged_ = true;
+  pthread_cond_signal(&cond_);
+  pthread_mutex_unlock(&mutex_);
+}
+
+uint64_t LibusbLoopback::NowUs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+int LibusbLoopback::Submit(libusb_transfer* transfer) {
+  pthread_mutex_lock(&mutex_);
+  if (!running_ || unplugged_) {
+    pthread_mutex_unlock(&mutex_);
+    return LIBUSB_ERROR_NO_DEVICE;
+  }
+  Pending pending = { transfer, NowUs() + transfer_latency_us_ };
+  if (transfer->endpoint & LIBUSB_ENDPOINT_IN) {
+    in_pending_.push_back(pending);
+    max_in_flight_ = std::max<uint32_t>(max_in_flight_, in_pending_.size());
+  } else {
+    out_pending_.push_back(pending);
+  }
+  pthread_cond_signal(&cond_);
+  pthread_mutex_unlock(&mutex_);
+  return LIBUSB_SUCCESS;
+}
+
+int LibusbLoopback::Cancel(libusb_transfer* transfer) {
+  pthread_mutex_lock(&mutex_);
+  cancelled_.insert(transfer);
+  pthread_cond_signal(&cond_);
+  pthread_mutex_unlock(&mutex_);
+  return LIBUSB_SUCCESS;
+}
+
+void* LibusbLoopback::ThreadMain(void* self) {
+  static_cast<LibusbLoopback*>(self)->Run();
+  return 0;
+}
+
+void LibusbLoopback::Run() {
+  pthread_mutex_lock(&mutex_);
+  while (running_ || !in_pending_.empty() || !out_pending_.empty()) {
+    libusb_transfer* done = 0;
+    const uint64_t now = NowUs();
+    uint64_t wake_us = now + 1000;
+
+    // cancelled and failed transfers are returned first, in any order
+    for (std::deque<Pending>::iterator it = in_pending_.begin();
+         !done && it != in_pending_.end(); ++it) {
+      if (cancelled_.count(it->transfer) || !running_ || unplugged_) {
+        done = it->transfer;
+        done->status = cancelled_.count(done) || !running_ ?
+            LIBUSB_TRANSFER_CANCELLED : LIBUSB_TRANSFER_NO_DEVICE;
+        done->actual_length = 0;
+        in_pending_.erase(it);
+        break;
+      }
+    }
+    for (std::deque<Pending>::iterator it = out_pending_.begin();
+         !done && it != out_pending_.end(); ++it) {
+      if (cancelled_.count(it->transfer) || !running_ || unplugged_) {
+        done = it->transfer;
+        done->status = cancelled_.count(done) || !running_ ?
+            LIBUSB_TRANSFER_CANCELLED : LIBUSB_TRANSFER_NO_DEVICE;
+        done->actual_length = 0;
+        out_pending_.erase(it);
+        break;
+      }
+    }
+
+    if (!done && !out_pending_.empty() && !out_held_) {
+      if (out_pending_.front().ready_us <= now) {
+        done = out_pending_.front().transfer;
+        out_pending_.pop_front();
+        // short write leaves the rest of transfer for the next one
+        size_t size = done->length;
+        if (out_transfer_limit_ && out_transfer_limit_ < size) {
+          size = out_transfer_limit_;
+        }
+        loopback_.insert(loopback_.end(), done->buffer, done->buffer + size);
+        done->status = LIBUSB_TRANSFER_COMPLETED;
+        done->actual_length = size;
+        ++out_transfers_count_;
+      } else {
+        wake_us = std::min(wake_us, out_pending_.front().ready_us);
+      }
+    }
+
+    // transfer ends when its buffer is full or no more data is available,
+    // as with short packet at the end of device write
+    if (!done && !in_pending_.empty() && !loopback_.empty()) {
+      if (in_pending_.front().ready_us <= now) {
+        done = in_pending_.front().transfer;
+        in_pending_.pop_front();
+        const size_t size =
+            std::min<size_t>(done->length, loopback_.size());
+        std::copy(loopback_.begin(), loopback_.begin() + size, done->buffer);
+        loopback_.erase(loopback_.begin(), loopback_.begin() + size);
+        done->status = LIBUSB_TRANSFER_COMPLETED;
+        done->actual_length = size;
+        ++in_transfers_count_;
+      } else {
+        wake_us = std::min(wake_us, in_pending_.front().ready_us);
+      }
+    }
+
+    if (done) {
+      cancelled_.erase(done);
+      pthread_mutex_unlock(&mutex_);
+      done->callback(done);
+      pthread_mutex_lock(&mutex_);
+    } else if (running_) {
+      timespec ts;
+      clock_gettime(CLOCK_MONOTONIC, &ts);
+      const uint64_t wait_us = wake_us > now ? wake_us - now : 0;
+      ts.tv_sec += (ts.tv_nsec / 1000 + wait_us) / 1000000;
+      ts.tv_nsec = ((ts.tv_nsec / 1000 + wait_us) % 1000000) * 1000;
+      pthread_cond_timedwait(&cond_, &mutex_, &ts);
+    }
+  }
+  pthread_mutex_unlock(&mutex_);
+}
+
+}  // namespace transport_manager
+}  // namespace components
+}  // namespace test
+
+using test::components::transport_manager::LibusbLoopback;
+
+extern "C" {
+
+struct libusb_transfer* LIBUSB_CALL libusb_alloc_transfer(int iso_packets) {
+  libusb_transfer* transfer = static_cast<libusb_transfer*>(
+      calloc(1, sizeof(libusb_transfer) +
+                    iso_packets * sizeof(libusb_iso_packet_descriptor)));
+  return transfer;
+}
+
+void LIBUSB_CALL libusb_free_transfer(struct libusb_transfer* transfer) {
+  free(transfer);
+}
+
+int LIBUSB_CALL libusb_submit_transfer(struct libusb_transfer* transfer) {
+  return LibusbLoopback::instance()->Submit(transfer);
+}
+
+int LIBUSB_CALL libusb_cancel_transfer(struct libusb_transfer* transfer) {
+  return LibusbLoopback::instance()->Cancel(transfer);
+}
+
+const char* LIBUSB_CALL libusb_error_name(int errcode) {
+  return errcode == LIBUSB_SUCCESS ? "LIBUSB_SUCCESS" : "LIBUSB_ERROR";
+}
+
+int LIBUSB_CALL libusb_get_active_config_descriptor(
+    libusb_device* dev, struct libusb_config_descriptor** config) {
+  libusb_endpoint_descriptor* endpoints =
+      static_cast<libusb_endpoint_descriptor*>(
+          calloc(2, sizeof(libusb_endpoint_descriptor)));
+  endpoints[0].bEndpointAddress = kInEndpoint;
+  endpoints[0].wMaxPacketSize = LibusbLoopback::instance()->max_packet_size();
+  endpoints[1].bEndpointAddress = kOutEndpoint;
+  endpoints[1].wMaxPacketSize = LibusbLoopback::instance()->max_packet_size();
+
+  libusb_interface_descriptor* altsetting =
+      static_cast<libusb_interface_descriptor*>(
+          calloc(1, sizeof(libusb_interface_descriptor)));
+  altsetting->bNumEndpoints = 2;
+  altsetting->endpoint = endpoints;
+
+  libusb_interface* interface =
+      static_cast<libusb_interface*>(calloc(1, sizeof(libusb_interface)));
+  interface->num_altsetting = 1;
+  interface->altsetting = altsetting;
+
+  *config = static_cast<libusb_config_descriptor*>(
+      calloc(1, sizeof(libusb_config_descriptor)));
+  (*config)->bNumInterfaces = 1;
+  (*config)->interface = interface;
+  return LIBUSB_SUCCESS;
+}
+
+void LIBUSB_CALL libusb_free_config_descriptor(
+    struct libusb_config_descriptor* config) {
+  free(const_cast<libusb_endpoint_descriptor*>(
+      config->interface->altsetting->endpoint));
+  free(const_cast<libusb_interface_descriptor*>(
+      config->interface->altsetting));
+  free(const_cast<libusb_interface*>(config->interface));
+  free(config);
+}
+
+// below is used by UsbHandler only, which is not started by the test
+
+int LIBUSB_CALL libusb_init(libusb_context** ctx) {
+  return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+void LIBUSB_CALL libusb_exit(libusb_context* ctx) {
+}
+
+void LIBUSB_CALL libusb_set_debug(libusb_context* ctx, int level) {
+}
+
+int LIBUSB_CALL libusb_has_capability(uint32_t capability) {
+  return 0;
+}
+
+ssize_t LIBUSB_CALL libusb_get_device_list(libusb_context* ctx,
+                                           libusb_device*** list) {
+  return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+void LIBUSB_CALL libusb_free_device_list(libusb_device** list,
+                                         int unref_devices) {
+}
+
+int LIBUSB_CALL libusb_get_device_descriptor(
+    libusb_device* dev, struct libusb_device_descriptor* desc) {
+  return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+uint8_t LIBUSB_CALL libusb_get_bus_number(libusb_device* dev) {
+  return 0;
+}
+
+uint8_t LIBUSB_CALL libusb_get_device_address(libusb_device* dev) {
+  return 0;
+}
+
+int LIBUSB_CALL libusb_open(libusb_device* dev,
+                            libusb_device_handle** handle) {
+  return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+void LIBUSB_CALL libusb_close(libusb_device_handle* dev_handle) {
+}
+
+int LIBUSB_CALL libusb_get_configuration(libusb_device_handle* dev,
+                                         int* config) {
+  return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+int LIBUSB_CALL libusb_set_configuration(libusb_device_handle* dev,
+                                         int configuration) {
+  return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+int LIBUSB_CALL libusb_claim_interface(libusb_device_handle* dev,
+                                       int interface_number) {
+  return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+int LIBUSB_CALL libusb_release_interface(libusb_device_handle* dev,
+                                         int interface_number) {
+  return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+int LIBUSB_CALL libusb_kernel_driver_active(libusb_device_handle* dev,
+                                            int interface_number) {
+  return 0;
+}
+
+int LIBUSB_CALL libusb_detach_kernel_driver(libusb_device_handle* dev,
+                                            int interface_number) {
+  return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+int LIBUSB_CALL libusb_get_string_descriptor_ascii(libusb_device_handle* dev,
+                                                   uint8_t desc_index,
+                                                   unsigned char* data,
+                                                   int length) {
+  return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+int LIBUSB_CALL libusb_handle_events_completed(libusb_context* ctx,
+                                               int* completed) {
+  return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+int LIBUSB_CALL libusb_hotplug_register_callback(
+    libusb_context* ctx, libusb_hotplug_event events,
+    libusb_hotplug_flag flags, int vendor_id, int product_id, int dev_class,
+    libusb_hotplug_callback_fn cb_fn, void* user_data,
+    libusb_hotplug_callback_handle* handle) {
+  return LIBUSB_ERROR_NOT_SUPPORTED;
+}
+
+void LIBUSB_CALL libusb_hotplug_deregister_callback(
+    libusb_context* ctx, libusb_hotplug_callback_handle handle) {
+}
+
+}  // extern "C"
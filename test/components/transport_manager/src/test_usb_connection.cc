@@ -0,0 +1,331 @@
+#include "gtest/gtest.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "config_profile/profile.h"
+#include "transport_manager/libusb_loopback.h"
+#include "transport_manager/usb/libusb/platform_usb_device.h"
+#include "transport_manager/usb/libusb/usb_connection.h"
+#include "transport_manager/transport_adapter/transport_adapter_controller.h"
+
+namespace test {
+namespace components {
+namespace transport_manager {
+
+using ::transport_manager::ApplicationHandle;
+using ::transport_manager::CommunicationError;
+using ::transport_manager::ConnectError;
+using ::transport_manager::DataReceiveError;
+using ::transport_manager::DataSendError;
+using ::transport_manager::DeviceUID;
+using ::transport_manager::DisconnectDeviceError;
+using ::transport_manager::RawMessageSptr;
+using ::transport_manager::SearchDeviceError;
+using ::transport_manager::transport_adapter::Connection;
+using ::transport_manager::transport_adapter::ConnectionSptr;
+using ::transport_manager::transport_adapter::DeviceSptr;
+using ::transport_manager::transport_adapter::DeviceVector;
+using ::transport_manager::transport_adapter::PlatformUsbDevice;
+using ::transport_manager::transport_adapter::TransportAdapter;
+using ::transport_manager::transport_adapter::TransportAdapterController;
+using ::transport_manager::transport_adapter::UsbConnection;
+using ::transport_manager::transport_adapter::UsbHandlerSptr;
+
+// 125 us is one microframe of high speed bus
+const uint32_t kTransferLatencyUs = 125;
+const uint16_t kMaxPacketSize = 512;
+const size_t kMessagesCount = 2000;
+const size_t kMessageSize = 1200;
+// Messages which fit to OUT transfer of 16384 bytes
+const size_t kMessagesPerBatch = 16384 / kMessageSize;
+
+class LoopbackController : public TransportAdapterController {
+ public:
+  LoopbackController()
+      : sent_(0),
+        send_failed_(0),
+        receive_failed_(0),
+        disconnected_(0),
+        aborted_(false) {
+    pthread_mutex_init(&mutex_, 0);
+    pthread_cond_init(&cond_, 0);
+  }
+
+  ~LoopbackController() {
+    pthread_cond_destroy(&cond_);
+    pthread_mutex_destroy(&mutex_);
+  }
+
+  bool WaitReceived(size_t size, int timeout_sec) {
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_sec;
+    pthread_mutex_lock(&mutex_);
+    while (received_.size() < size &&
+           0 == pthread_cond_timedwait(&cond_, &mutex_, &deadline)) {
+    }
+    const bool done = received_.size() >= size;
+    pthread_mutex_unlock(&mutex_);
+    return done;
+  }
+
+  bool WaitDisconnected(int timeout_sec) {
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_sec;
+    pthread_mutex_lock(&mutex_);
+    while (0 == disconnected_ &&
+           0 == pthread_cond_timedwait(&cond_, &mutex_, &deadline)) {
+    }
+    const bool done = 0 != disconnected_;
+    pthread_mutex_unlock(&mutex_);
+    return done;
+  }
+
+  virtual DeviceSptr AddDevice(DeviceSptr device) { return device; }
+  virtual void SearchDeviceDone(const DeviceVector& devices) {}
+  virtual void SearchApplicationsDone(const DeviceSptr& device) {}
+  virtual void SearchDeviceFailed(const SearchDeviceError& error) {}
+  virtual DeviceSptr FindDevice(const DeviceUID& device_handle) const {
+    return DeviceSptr();
+  }
+  virtual void ConnectionCreated(ConnectionSptr connection,
+                                 const DeviceUID& device_handle,
+                                 const ApplicationHandle& app_handle) {}
+  virtual void ConnectDone(const DeviceUID& device_handle,
+                           const ApplicationHandle& app_handle) {}
+  virtual void ConnectFailed(const DeviceUID& device_handle,
+                             const ApplicationHandle& app_handle,
+                             const ConnectError& error) {}
+  virtual void ConnectionFinished(const DeviceUID& device_handle,
+                                  const ApplicationHandle& app_handle) {}
+  virtual void ConnectionAborted(const DeviceUID& device_handle,
+                                 const ApplicationHandle& app_handle,
+                                 const CommunicationError& error) {
+    aborted_ = true;
+  }
+  virtual void DeviceDisconnected(const DeviceUID& device_handle,
+                                  const DisconnectDeviceError& error) {}
+  virtual void DisconnectDone(const DeviceUID& device_handle,
+                              const ApplicationHandle& app_handle) {
+    pthread_mutex_lock(&mutex_);
+    ++disconnected_;
+    pthread_cond_signal(&cond_);
+    pthread_mutex_unlock(&mutex_);
+  }
+
+  virtual void DataReceiveDone(const DeviceUID& device_handle,
+                               const ApplicationHandle& app_handle,
+                               RawMessageSptr message) {
+    pthread_mutex_lock(&mutex_);
+    received_.insert(received_.end(), message->data(),
+                     message->data() + message->data_size());
+    pthread_cond_signal(&cond_);
+    pthread_mutex_unlock(&mutex_);
+  }
+  virtual void DataReceiveFailed(const DeviceUID& device_handle,
+                                 const ApplicationHandle& app_handle,
+                                 const DataReceiveError&) {
+    ++receive_failed_;
+  }
+  virtual void DataSendDone(const DeviceUID& device_handle,
+                            const ApplicationHandle& app_handle,
+                            RawMessageSptr message) {
+    ++sent_;
+  }
+  virtual void DataSendFailed(const DeviceUID& device_handle,
+                              const ApplicationHandle& app_handle,
+                              RawMessageSptr message, const DataSendError&) {
+    ++send_failed_;
+  }
+
+  std::vector<uint8_t> received_;
+  size_t sent_;
+  size_t send_failed_;
+  size_t receive_failed_;
+  size_t disconnected_;
+  bool aborted_;
+
+ private:
+  pthread_mutex_t mutex_;
+  pthread_cond_t cond_;
+};
+
+struct LoopbackResult {
+  uint32_t in_transfers;
+  uint32_t out_transfers;
+  uint32_t max_in_flight;
+};
+
+RawMessageSptr CreateMessage(size_t number, std::vector<uint8_t>* sent) {
+  std::vector<uint8_t> data(kMessageSize);
+  for (size_t j = 0; j < kMessageSize; ++j) {
+    data[j] = static_cast<uint8_t>(number * 7 + j);
+  }
+  sent->insert(sent->end(), data.begin(), data.end());
+  return RawMessageSptr(
+      new protocol_handler::RawMessage(0, 0, &data[0], data.size()));
+}
+
+class UsbConnectionLoopbackTest : public ::testing::Test {
+ protected:
+  UsbConnectionLoopbackTest()
+      : loopback_(LibusbLoopback::instance()),
+        descriptor_(libusb_device_descriptor()),
+        device_(NULL),
+        connection_(NULL) {
+  }
+
+  void Configure(uint32_t in_transfers, uint32_t in_transfer_size,
+                 uint32_t out_transfer_max_size) {
+    const std::string file_name = "usb_connection_test.ini";
+    std::ofstream ini(file_name.c_str());
+    ini << "[TransportManager]\n"
+        << "UsbInTransfersCount = " << in_transfers << "\n"
+        << "UsbInTransferSize = " << in_transfer_size << "\n"
+        << "UsbOutTransferMaxSize = " << out_transfer_max_size << "\n";
+    ini.close();
+    profile::Profile::instance()->config_file_name(file_name);
+  }
+
+  void Open(LoopbackController* controller) {
+    loopback_->Start(kMaxPacketSize, kTransferLatencyUs);
+    device_ = new PlatformUsbDevice(1, 1, descriptor_, loopback_->device(),
+                                    loopback_->device_handle());
+    UsbConnection* usb_connection = new UsbConnection(
+        "loopback", 1, controller, UsbHandlerSptr(), device_);
+    EXPECT_TRUE(usb_connection->Init());
+    connection_ = usb_connection;
+  }
+
+  void Close() {
+    delete connection_;
+    connection_ = NULL;
+    loopback_->Stop();
+    delete device_;
+    device_ = NULL;
+  }
+
+  // Sends numbered messages and checks they come back in order. OUT
+  // transfers are held while sending, so the first message goes alone and
+  // the rest are batched as much as transfer size allows
+  LoopbackResult RunLoopback(size_t messages_count,
+                             uint32_t out_transfer_limit = 0) {
+    LoopbackController controller;
+    Open(&controller);
+    loopback_->set_out_transfer_limit(out_transfer_limit);
+
+    std::vector<uint8_t> sent;
+    sent.reserve(messages_count * kMessageSize);
+    loopback_->HoldOutTransfers();
+    for (size_t i = 0; i < messages_count; ++i) {
+      EXPECT_EQ(TransportAdapter::OK,
+                connection_->SendData(CreateMessage(i, &sent)));
+    }
+    loopback_->ReleaseOutTransfers();
+
+    EXPECT_TRUE(controller.WaitReceived(sent.size(), 60));
+    Close();
+
+    EXPECT_EQ(messages_count, controller.sent_);
+    EXPECT_EQ(0u, controller.send_failed_);
+    EXPECT_EQ(0u, controller.receive_failed_);
+    EXPECT_FALSE(controller.aborted_);
+    EXPECT_TRUE(sent == controller.received_);
+
+    LoopbackResult result;
+    result.in_transfers = loopback_->in_transfers_count();
+    result.out_transfers = loopback_->out_transfers_count();
+    result.max_in_flight = loopback_->max_in_flight();
+    return result;
+  }
+
+  LibusbLoopback* loopback_;
+  libusb_device_descriptor descriptor_;
+  PlatformUsbDevice* device_;
+  Connection* connection_;
+};
+
+TEST_F(UsbConnectionLoopbackTest, SingleTransferOfPacketSize) {
+  Configure(1, kMaxPacketSize, 1);
+  const LoopbackResult result = RunLoopback(kMessagesCount);
+  EXPECT_EQ(kMessagesCount, result.out_transfers);
+  EXPECT_EQ(1u, result.max_in_flight);
+  // IN transfer holds one packet
+  EXPECT_LE(kMessagesCount * kMessageSize / kMaxPacketSize,
+            result.in_transfers);
+}
+
+TEST_F(UsbConnectionLoopbackTest, PooledTransfersAreBatched) {
+  Configure(1, kMaxPacketSize, 1);
+  const LoopbackResult single = RunLoopback(kMessagesCount);
+
+  Configure(4, 16384, 16384);
+  const LoopbackResult pooled = RunLoopback(kMessagesCount);
+
+  EXPECT_EQ(4u, pooled.max_in_flight);
+  EXPECT_EQ(1 + (kMessagesCount - 1 + kMessagesPerBatch - 1) /
+                kMessagesPerBatch,
+            pooled.out_transfers);
+  // IN transfer ends either full or having taken all data written so far
+  EXPECT_GE(pooled.out_transfers + kMessagesCount * kMessageSize / 16384,
+            pooled.in_transfers);
+  EXPECT_LT(pooled.in_transfers, single.in_transfers);
+}
+
+TEST_F(UsbConnectionLoopbackTest, InTransferSizeIsRoundedToPacket) {
+  Configure(2, 1000, 4096);
+  const LoopbackResult result = RunLoopback(kMessagesCount);
+  // 1000 is rounded up to 1024 bytes
+  EXPECT_LE(kMessagesCount * kMessageSize / 1024, result.in_transfers);
+  // 3 messages fit to OUT transfer
+  EXPECT_EQ(1 + (kMessagesCount - 1 + 2) / 3, result.out_transfers);
+}
+
+TEST_F(UsbConnectionLoopbackTest, PartialOutTransferIsResubmitted) {
+  Configure(2, 16384, 1);
+  const size_t messages_count = 100;
+  const LoopbackResult result = RunLoopback(messages_count, kMaxPacketSize);
+  // 1200 bytes are written by 512, 512 and 176 bytes transfers
+  EXPECT_EQ(messages_count * 3, result.out_transfers);
+}
+
+TEST_F(UsbConnectionLoopbackTest, UnpluggedDeviceAbortsConnection) {
+  Configure(4, 16384, 16384);
+  LoopbackController controller;
+  Open(&controller);
+
+  std::vector<uint8_t> sent;
+  EXPECT_EQ(TransportAdapter::OK,
+            connection_->SendData(CreateMessage(0, &sent)));
+  EXPECT_TRUE(controller.WaitReceived(sent.size(), 10));
+
+  // One message is in flight, others wait in queue
+  const size_t pending_count = 5;
+  loopback_->HoldOutTransfers();
+  for (size_t i = 1; i <= pending_count; ++i) {
+    EXPECT_EQ(TransportAdapter::OK,
+              connection_->SendData(CreateMessage(i, &sent)));
+  }
+  loopback_->Unplug();
+
+  EXPECT_TRUE(controller.WaitDisconnected(10));
+  EXPECT_TRUE(controller.aborted_);
+  EXPECT_EQ(1u, controller.sent_);
+  EXPECT_EQ(pending_count, controller.send_failed_);
+  EXPECT_LT(0u, controller.receive_failed_);
+  EXPECT_EQ(TransportAdapter::BAD_STATE,
+            connection_->SendData(CreateMessage(0, &sent)));
+
+  Close();
+  EXPECT_EQ(1u, controller.disconnected_);
+}
+
+}  // namespace transport_manager
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,145 @@
+/*
+* Copyright (c) 2014, Ford Motor Company
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice,
+* this list of conditions and the following
+* disclaimer in the documentation and/or other materials provided with the
+* distribution.
+*
+* Neither the name of the Ford Motor Company nor the names of its contributors
+* may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef ASYNC_FILE_IO_TESTS_H
+#define ASYNC_FILE_IO_TESTS_H
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "utils/async_file_io.h"
+#include "utils/file_system.h"
+#include "utils/lock.h"
+
+namespace test  {
+namespace components  {
+namespace utils  {
+  using file_system::AsyncFileIO;
+
+  class CountingCompletion : public AsyncFileIO::Completion {
+   public:
+    CountingCompletion()
+      : succeeded_(0),
+        failed_(0) {
+    }
+
+    virtual void OnWriteCompleted(const std::string& file_name,
+                                  bool success) {
+      sync_primitives::AutoLock lock(lock_);
+      ++(success ? succeeded_ : failed_);
+    }
+
+    uint32_t succeeded() {
+      sync_primitives::AutoLock lock(lock_);
+      return succeeded_;
+    }
+
+    uint32_t failed() {
+      sync_primitives::AutoLock lock(lock_);
+      return failed_;
+    }
+
+   private:
+    sync_primitives::Lock lock_;
+    uint32_t succeeded_;
+    uint32_t failed_;
+  };
+
+  ::utils::SharedBuffer Chunk(uint8_t value, size_t size) {
+    return ::utils::SharedBuffer(std::vector<uint8_t>(size, value));
+  }
+
+  TEST(AsyncFileIOTest, OrderedPositionalWrites) {
+    const std::string file_name = "./async_file_io_test";
+    AsyncFileIO* service = AsyncFileIO::instance();
+    CountingCompletion* counter = new CountingCompletion();
+    AsyncFileIO::CompletionPtr completion(counter);
+
+    std::vector<uint8_t> expected;
+    const uint32_t kChunks = 100;
+    const uint32_t kChunkSize = 1000;
+    for (uint32_t i = 0; i < kChunks; ++i) {
+      service->WriteAt(file_name, Chunk(i, kChunkSize), i * kChunkSize,
+                       i + 1 == kChunks ? AsyncFileIO::kSyncData :
+                                          AsyncFileIO::kNoSync,
+                       completion);
+      expected.insert(expected.end(), kChunkSize, i);
+
+      // size is known before writes are done
+      uint32_t size = 0;
+      if (service->PendingFileSize(file_name, &size)) {
+        ASSERT_EQ((i + 1) * kChunkSize, size);
+      }
+    }
+    service->Flush(file_name);
+
+    EXPECT_EQ(kChunks, counter->succeeded());
+    EXPECT_EQ(0u, counter->failed());
+    std::vector<uint8_t> contents;
+    ASSERT_TRUE(file_system::ReadBinaryFile(file_name, contents));
+    EXPECT_TRUE(expected == contents);
+
+    // write at offset 0 replaces contents
+    service->WriteAt(file_name, Chunk(7, 10), 0, AsyncFileIO::kNoSync,
+                     completion);
+    service->Append(file_name, Chunk(8, 5), AsyncFileIO::kNoSync, completion);
+    service->Flush(file_name);
+    ASSERT_TRUE(file_system::ReadBinaryFile(file_name, contents));
+    expected.assign(10, 7);
+    expected.insert(expected.end(), 5, 8);
+    EXPECT_TRUE(expected == contents);
+    EXPECT_EQ(kChunks + 2, counter->succeeded());
+
+    uint32_t size = 0;
+    EXPECT_FALSE(service->PendingFileSize(file_name, &size));
+    EXPECT_EQ(0u, service->PendingWrites());
+    EXPECT_TRUE(file_system::DeleteFile(file_name));
+  }
+
+  TEST(AsyncFileIOTest, FailedWrite) {
+    AsyncFileIO* service = AsyncFileIO::instance();
+    CountingCompletion* counter = new CountingCompletion();
+    AsyncFileIO::CompletionPtr completion(counter);
+
+    const std::string file_name = "./not_existing_dir/async_file_io_test";
+    service->Append(file_name, Chunk(1, 10), AsyncFileIO::kNoSync, completion);
+    service->Flush(file_name);
+    EXPECT_EQ(0u, counter->succeeded());
+    EXPECT_EQ(1u, counter->failed());
+  }
+}  // namespace utils
+}  // namespace components
+}  // namespace test
+
+#endif // ASYNC_FILE_IO_TESTS_H
@@ -0,0 +1,81 @@
+/*
+* Copyright (c) 2014, Ford Motor Company
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice,
+* this list of conditions and the following
+* disclaimer in the documentation and/or other materials provided with the
+* distribution.
+*
+* Neither the name of the Ford Motor Company nor the names of its contributors
+* may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef LATENCY_HISTOGRAM_TESTS_H
+#define LATENCY_HISTOGRAM_TESTS_H
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "utils/latency_histogram.h"
+
+namespace test  {
+namespace components  {
+namespace utils  {
+  TEST(LatencyHistogramTest, BucketBounds) {
+    using ::utils::LatencyHistogram;
+    for (uint32_t value = 0; value < 100000; ++value) {
+      const uint32_t index = LatencyHistogram::BucketIndex(value);
+      ASSERT_LT(index, LatencyHistogram::kBucketsCount);
+      ASSERT_LE(value, LatencyHistogram::BucketUpperBound(index));
+      if (index > 0) {
+        ASSERT_GT(value, LatencyHistogram::BucketUpperBound(index - 1));
+      }
+    }
+    ASSERT_EQ(0xFFFFFFFFu, LatencyHistogram::BucketUpperBound(
+                LatencyHistogram::BucketIndex(0xFFFFFFFFu)));
+  }
+
+  TEST(LatencyHistogramTest, Percentiles) {
+    ::utils::LatencyHistogram histogram;
+    ::utils::LatencyHistogram::Snapshot snapshot;
+    histogram.GetSnapshot(&snapshot);
+    ASSERT_EQ(0u, snapshot.count);
+    ASSERT_EQ(0u, snapshot.Percentile(50));
+
+    for (uint32_t value = 1; value <= 1000; ++value) {
+      histogram.Record(value);
+    }
+    histogram.GetSnapshot(&snapshot);
+    ASSERT_EQ(1000u, snapshot.count);
+    // Error of bucket is below 1/16 of value
+    ASSERT_GE(snapshot.Percentile(50), 500u);
+    ASSERT_LE(snapshot.Percentile(50), 500u + 500u / 16);
+    ASSERT_GE(snapshot.Percentile(99), 990u);
+    ASSERT_LE(snapshot.Percentile(99), 990u + 990u / 16);
+    ASSERT_GE(snapshot.Max(), 1000u);
+    ASSERT_LE(snapshot.Max(), 1000u + 1000u / 16);
+  }
+}  // namespace utils
+}  // namespace components
+}  // namespace test
+
+#endif // LATENCY_HISTOGRAM_TESTS_H
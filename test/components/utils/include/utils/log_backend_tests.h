@@ -0,0 +1,156 @@
+/*
+* Copyright (c) 2014, Ford Motor Company
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice,
+* this list of conditions and the following
+* disclaimer in the documentation and/or other materials provided with the
+* distribution.
+*
+* Neither the name of the Ford Motor Company nor the names of its contributors
+* may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef LOG_BACKEND_TESTS_H
+#define LOG_BACKEND_TESTS_H
+
+#include <pthread.h>
+#include <stdio.h>
+
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "utils/log_backend.h"
+
+namespace test  {
+namespace components  {
+namespace utils  {
+  namespace logging = ::utils::logging;
+
+  struct TestLogger {
+    const char* name() const {
+      return "LogBackendTest";
+    }
+  };
+
+  const char kPropertiesFile[] = "./log_backend_test.properties";
+  const char kLogFile[] = "./log_backend_test.log";
+
+  void InitLogging(const char* level, const char* buffer_size,
+                   const char* blocking) {
+    std::ofstream properties(kPropertiesFile);
+    properties << "log4j.rootLogger=" << level << ", CustomLogFile\n"
+               << "log4j.appender.CustomLogFile.File=" << kLogFile << "\n"
+               << "log4j.appender.CustomLogFile.BufferSize=" << buffer_size
+               << "\n"
+               << "log4j.appender.CustomLogFile.Blocking=" << blocking << "\n";
+    properties.close();
+    logging::Init(kPropertiesFile);
+    remove(kPropertiesFile);
+  }
+
+  uint32_t CountLines(const char* marker) {
+    std::ifstream file(kLogFile);
+    std::string line;
+    uint32_t count = 0;
+    while (std::getline(file, line)) {
+      if (std::string::npos != line.find(marker)) {
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  const uint32_t kThreads = 4;
+  const uint32_t kRecordsPerThread = 2000;
+
+  void* LogRecords(void* arg) {
+    const TestLogger logger;
+    const std::string payload(static_cast<const char*>(arg));
+    for (uint32_t i = 0; i < kRecordsPerThread; ++i) {
+      LOG_WITH_LEVEL(logger, logging::kInfo, payload << " " << i);
+    }
+    return NULL;
+  }
+
+  uint32_t EvaluatedArgument(uint32_t* counter) {
+    return ++*counter;
+  }
+
+  TEST(LogBackendTest, WritesRecordsOfAllThreads) {
+    remove(kLogFile);
+    InitLogging("DEBUG", "16384", "true");
+
+    // disabled level does not evaluate arguments
+    const TestLogger logger;
+    uint32_t evaluated = 0;
+    LOG_WITH_LEVEL(logger, logging::kTrace, EvaluatedArgument(&evaluated));
+    LOG_WITH_LEVEL(logger, logging::kDebug, EvaluatedArgument(&evaluated));
+    EXPECT_EQ(1u, evaluated);
+
+    pthread_t threads[kThreads];
+    for (uint32_t i = 0; i < kThreads; ++i) {
+      ASSERT_EQ(0, pthread_create(&threads[i], NULL, &LogRecords,
+                                  const_cast<char*>("lossless record")));
+    }
+    for (uint32_t i = 0; i < kThreads; ++i) {
+      pthread_join(threads[i], NULL);
+    }
+    logging::Flush();
+
+    EXPECT_EQ(kThreads * kRecordsPerThread, CountLines("lossless record"));
+    EXPECT_EQ(1u, CountLines("DEBUG"));
+    EXPECT_EQ(0u, logging::DroppedRecords());
+  }
+
+  TEST(LogBackendTest, DropsRecordsWhenBufferIsFull) {
+    remove(kLogFile);
+    InitLogging("ALL", "0", "false");
+    const uint32_t dropped_before = logging::DroppedRecords();
+
+    const std::string payload = "lossy record " + std::string(1000, 'x');
+    pthread_t threads[kThreads];
+    for (uint32_t i = 0; i < kThreads; ++i) {
+      ASSERT_EQ(0, pthread_create(&threads[i], NULL, &LogRecords,
+                                  const_cast<char*>(payload.c_str())));
+    }
+    for (uint32_t i = 0; i < kThreads; ++i) {
+      pthread_join(threads[i], NULL);
+    }
+    logging::Flush();
+
+    // every record is either written or counted as dropped
+    const uint32_t dropped = logging::DroppedRecords() - dropped_before;
+    EXPECT_EQ(kThreads * kRecordsPerThread,
+              CountLines("lossy record") + dropped);
+    if (dropped) {
+      EXPECT_LT(0u, CountLines("records dropped"));
+    }
+    remove(kLogFile);
+  }
+}  // namespace utils
+}  // namespace components
+}  // namespace test
+
+#endif // LOG_BACKEND_TESTS_H
@@ -0,0 +1,104 @@
+/*
+* Copyright (c) 2014, Ford Motor Company
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice,
+* this list of conditions and the following
+* disclaimer in the documentation and/or other materials provided with the
+* distribution.
+*
+* Neither the name of the Ford Motor Company nor the names of its contributors
+* may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef LZ4_TESTS_H
+#define LZ4_TESTS_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "utils/lz4.h"
+
+namespace test  {
+namespace components  {
+namespace utils  {
+  TEST(Lz4Test, RoundTrip) {
+    std::vector<uint8_t> compressed;
+    std::vector<uint8_t> decompressed;
+
+    ::utils::lz4::Compress(NULL, 0, &compressed);
+    ASSERT_TRUE(::utils::lz4::Decompress(&compressed[0], compressed.size(),
+                                         0, &decompressed));
+    ASSERT_TRUE(decompressed.empty());
+
+    srand(1);
+    for (uint32_t size = 1; size < 70000; size = size * 3 / 2 + 1) {
+      std::vector<uint8_t> data(size);
+      for (uint32_t i = 0; i < size; ++i) {
+        // half of data is random, half is repeating text
+        data[i] = i < size / 2 ? rand() : "{\"name\":\"value\"}"[i % 16];
+      }
+      ::utils::lz4::Compress(&data[0], size, &compressed);
+      ASSERT_LE(compressed.size(), ::utils::lz4::CompressBound(size));
+      ASSERT_TRUE(::utils::lz4::Decompress(&compressed[0], compressed.size(),
+                                           size, &decompressed));
+      ASSERT_TRUE(data == decompressed);
+    }
+  }
+
+  TEST(Lz4Test, Ratio) {
+    std::vector<uint8_t> data(10000, 'x');
+    std::vector<uint8_t> compressed;
+    ::utils::lz4::Compress(&data[0], data.size(), &compressed);
+    ASSERT_LT(compressed.size(), data.size() / 100);
+  }
+
+  TEST(Lz4Test, MalformedInput) {
+    const char text[] = "abcabcabcabcabcabcabcabcabcabcabcabcabcabcabc";
+    const size_t size = sizeof(text) - 1;
+    std::vector<uint8_t> compressed;
+    std::vector<uint8_t> decompressed;
+    ::utils::lz4::Compress(reinterpret_cast<const uint8_t*>(text), size,
+                           &compressed);
+
+    // wrong size of original data
+    ASSERT_FALSE(::utils::lz4::Decompress(&compressed[0], compressed.size(),
+                                          size - 1, &decompressed));
+    ASSERT_FALSE(::utils::lz4::Decompress(&compressed[0], compressed.size(),
+                                          size + 1, &decompressed));
+    // truncated block
+    ASSERT_FALSE(::utils::lz4::Decompress(&compressed[0],
+                                          compressed.size() - 1,
+                                          size, &decompressed));
+    // match refers before start of output
+    const uint8_t bad_offset[] = { 0x10, 'a', 0x05, 0x00, 0x00 };
+    ASSERT_FALSE(::utils::lz4::Decompress(bad_offset, sizeof(bad_offset),
+                                          5, &decompressed));
+  }
+}  // namespace utils
+}  // namespace components
+}  // namespace test
+
+#endif // LZ4_TESTS_H
@@ -29,35 +29,54 @@
 * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 * POSSIBILITY OF SUCH DAMAGE.
 */
-#include "transport_manager_observer.h"
-
-#include <time.h>
-
-#include "transport_manager_metric.h"
-#include "time_manager.h"
-
-namespace time_tester {
-
-TransportManagerObserver::TransportManagerObserver(TimeManager* time_manager):
-  time_manager_ (time_manager) {
-}
-
-void TransportManagerObserver::StartRawMsg(const protocol_handler::RawMessage* ptr) {
-  time_starts[ptr] = date_time::DateTime::getCurrentTime();
-}
-
-void TransportManagerObserver::StopRawMsg(const protocol_handler::RawMessage* ptr) {
-    std::map<const protocol_handler::RawMessage*, TimevalStruct>::const_iterator it;
-    it = time_starts.find(ptr);
-    if (it != time_starts.end()) {
-      TransportManagerMecticWrapper* m = new TransportManagerMecticWrapper();
-      m->message_metric = new transport_manager::TMMetricObserver::MessageMetric();
-      m->message_metric->begin = it->second;
-      m->message_metric->end = date_time::DateTime::getCurrentTime();
-      m->message_metric->data_size = ptr->data_size();
-      m->grabResources();
-      time_manager_->SendMetric(m);
+#ifndef MAPPED_FILE_TESTS_H
+#define MAPPED_FILE_TESTS_H
+
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "utils/file_system.h"
+#include "utils/mapped_file.h"
+
+namespace test  {
+namespace components  {
+namespace utils  {
+  TEST(MappedFileTest, MapsFileContents) {
+    const std::string file_name = "mapped_file_test.bin";
+    std::vector<uint8_t> contents(10000);
+    for (size_t i = 0; i < contents.size(); ++i) {
+      contents[i] = static_cast<uint8_t>(i * 7);
     }
-}
+    ASSERT_TRUE(file_system::WriteBinaryFile(file_name, contents));
+
+    file_system::MappedFile file;
+    ASSERT_FALSE(file.is_open());
+    ASSERT_TRUE(file.Open(file_name));
+    ASSERT_TRUE(file.is_open());
+    ASSERT_EQ(contents.size(), file.size());
+    ASSERT_EQ(0, memcmp(&contents[0], file.data(), contents.size()));
+
+    file.Close();
+    ASSERT_FALSE(file.is_open());
+    ASSERT_EQ(0u, file.size());
+    file_system::DeleteFile(file_name);
+  }
+
+  TEST(MappedFileTest, MissingAndEmptyFilesAreNotMapped) {
+    file_system::MappedFile file;
+    ASSERT_FALSE(file.Open("mapped_file_test_missing.bin"));
+
+    const std::string empty_name = "mapped_file_test_empty.bin";
+    ASSERT_TRUE(file_system::CreateFile(empty_name));
+    ASSERT_FALSE(file.Open(empty_name));
+    ASSERT_FALSE(file.is_open());
+    file_system::DeleteFile(empty_name);
+  }
+}  // namespace utils
+}  // namespace components
+}  // namespace test
 
-} //namespace time_tester
+#endif // MAPPED_FILE_TESTS_H
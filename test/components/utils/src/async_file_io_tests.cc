@@ -29,21 +29,4 @@
 * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 * POSSIBILITY OF SUCH DAMAGE.
 */
-#include "application_manager_observer.h"
-#include "utils/shared_ptr.h"
-#include "time_manager.h"
-#include "application_manager_metric.h"
-
-namespace time_tester {
-
-ApplicationManagerObserver::ApplicationManagerObserver(TimeManager* time_manager):
-  time_manager_(time_manager) {
-}
-
-void ApplicationManagerObserver::OnMessage(utils::SharedPtr<MessageMetric> metric) {
-  ApplicationManagerMetricWrapper* m = new ApplicationManagerMetricWrapper();
-  m->message_metric = metric;
-  m->grabResources();
-  time_manager_->SendMetric(m);
-}
-}  // namespace time_tester
+#include "utils/async_file_io_tests.h"
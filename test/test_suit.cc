@@ -51,7 +51,6 @@
 
 // #include "json_handler/smart_schema_draft_test.h"
 // #include "SmartObjectConvertionTimeTest.h"
-// #include "request_watchdog/request_watchdog_test.h"
 // #include "json_handler/formatters/formatter_test_helper.h"
 // #include "json_handler/formatters/formatter_json_alrpcv1_test.h"
 // #include "json_handler/formatters/formatter_json_alrpcv2_test.h"
@@ -0,0 +1,113 @@
+#include "gmock/gmock.h"
+
+#include <cstring>
+
+#include <test_rpc_interface/interface.h>
+#include <test_rpc_interface/functions.h>
+
+#include "json/reader.h"
+#include "json/writer.h"
+#include "rpc_base/gtest_support.h"
+#include "rpc_base/json_stream.h"
+
+namespace test {
+using namespace rpc::test_rpc_interface;
+
+class GeneratedInterfaceJsonStreamTests: public ::testing::Test {
+ public:
+  rpc::JsonReader Reader(const char* json) {
+    return rpc::JsonReader(json, json + strlen(json));
+  }
+  // FastWriter output without trailing newline
+  std::string FastWrite(const Json::Value& value) {
+    std::string result = writer.write(value);
+    result.erase(result.size() - 1);
+    return result;
+  }
+  Json::FastWriter writer;
+};
+
+TEST_F(GeneratedInterfaceJsonStreamTests, ImageRoundTrip) {
+  const char* org_json = "{\"imageType\":\"DYNAMIC\",\"value\":\"icon.png\"}";
+  rpc::JsonReader reader = Reader(org_json);
+  Image image;
+  image.ReadJson(&reader);
+  ASSERT_FALSE(reader.has_failed());
+  ASSERT_TRUE(image.is_initialized());
+  ASSERT_RPCTYPE_VALID(image);
+  ASSERT_EQ(IT_DYNAMIC, image.imageType);
+  ASSERT_EQ("icon.png", std::string(image.value));
+
+  std::string streamed;
+  rpc::JsonWriter writer(&streamed);
+  image.WriteJson(&writer);
+  ASSERT_EQ(org_json, streamed);
+  ASSERT_EQ(FastWrite(image.ToJsonValue()), streamed);
+}
+
+TEST_F(GeneratedInterfaceJsonStreamTests, MemberOrderAndUnknownMembers) {
+  const char* org_json =
+      "{\"value\":\"icon.png\",\"extra\":{\"a\":[1,2]},\"imageType\":\"STATIC\"}";
+  rpc::JsonReader reader = Reader(org_json);
+  Image image;
+  image.ReadJson(&reader);
+  ASSERT_FALSE(reader.has_failed());
+  ASSERT_RPCTYPE_VALID(image);
+  ASSERT_EQ(IT_STATIC, image.imageType);
+}
+
+TEST_F(GeneratedInterfaceJsonStreamTests, NotAnObject) {
+  rpc::JsonReader reader = Reader("[1]");
+  Image image;
+  image.ReadJson(&reader);
+  ASSERT_FALSE(reader.has_failed());
+  ASSERT_TRUE(image.is_initialized());
+  ASSERT_FALSE(image.is_valid());
+}
+
+TEST_F(GeneratedInterfaceJsonStreamTests, TypedefStructMatchesFastWriter) {
+  TdStruct ts;
+  ts.resArrMap["Hello"].push_back(R_SUCCESS);
+  (*ts.optionalResArrMap)["World"].push_back(R_INVALID_DATA);
+  std::string streamed;
+  rpc::JsonWriter writer(&streamed);
+  ts.WriteJson(&writer);
+  ASSERT_EQ(FastWrite(ts.ToJsonValue()), streamed);
+
+  rpc::JsonReader reader = Reader(streamed.c_str());
+  TdStruct parsed;
+  parsed.ReadJson(&reader);
+  ASSERT_FALSE(reader.has_failed());
+  ASSERT_RPCTYPE_VALID(parsed);
+  ASSERT_EQ(R_SUCCESS, parsed.resArrMap["Hello"][0]);
+  ASSERT_EQ(R_INVALID_DATA, (*parsed.optionalResArrMap)["World"][0]);
+}
+
+TEST_F(GeneratedInterfaceJsonStreamTests, FrankenstructRoundTrip) {
+  const char* org_json = "{\"hello\":\"str\",\"mandatoryInt\":2}";
+  rpc::JsonReader reader = Reader(org_json);
+  FrankenstructOfEmptyStringWithMandatoryInt fbmi;
+  fbmi.ReadJson(&reader);
+  ASSERT_FALSE(reader.has_failed());
+  ASSERT_RPCTYPE_VALID(fbmi);
+  ASSERT_EQ(1u, fbmi.size());
+  ASSERT_EQ(2, fbmi.mandatoryInt);
+  ASSERT_EQ("str", std::string(fbmi["hello"]));
+
+  std::string streamed;
+  rpc::JsonWriter writer(&streamed);
+  fbmi.WriteJson(&writer);
+  ASSERT_EQ(org_json, streamed);
+}
+
+TEST_F(GeneratedInterfaceJsonStreamTests, FrankenstructInvalidMember) {
+  rpc::JsonReader reader = Reader("{\"hello\":true,\"mandatoryInt\":2}");
+  FrankenstructOfEmptyStringWithMandatoryInt fbmi;
+  fbmi.ReadJson(&reader);
+  ASSERT_FALSE(reader.has_failed());
+  ASSERT_TRUE(fbmi.is_initialized());
+  ASSERT_FALSE(fbmi.is_valid());
+  ASSERT_EQ(2, fbmi.mandatoryInt);
+}
+
+}  // namespace test
@@ -13,10 +13,12 @@ set(GENERATED_LIB_HEADER_DEPENDENCIES
 #   flag telling intergen to generate function ids automatically
 # if |DBUS_SUPPORT| is added to argument list, intergen is called with "-d"
 #   flag that enables DBus serialization code generation
+# if |JSON_STREAM_SUPPORT| is added to argument list, intergen is called with
+#   "-p" flag that enables streaming json reader and writer code generation
 # from xml_file (intergen creates separate directory for every interface).
 # Their names are written lowercase_underscored_style.
 function (GenerateInterfaceLibrary xml_file_name generated_interface_names)
-  set(options AUTO_FUNC_IDS DBUS_SUPPORT)
+  set(options AUTO_FUNC_IDS DBUS_SUPPORT JSON_STREAM_SUPPORT)
   cmake_parse_arguments(GenerateInterfaceLibrary "${options}" "" "" ${ARGN})
   if (GenerateInterfaceLibrary_AUTO_FUNC_IDS)
     set(AUTOID "-a")
@@ -26,6 +28,10 @@ function (GenerateInterfaceLibrary xml_file_name generated_interface_names)
     find_package(DBus)
     list(APPEND GENERATED_LIB_HEADER_DEPENDENCIES ${DBUS_INCLUDE_DIRS})
   endif()
+  if (GenerateInterfaceLibrary_JSON_STREAM_SUPPORT)
+    set(NEED_JSON_STREAM "-p")
+    list(APPEND GENERATED_LIB_DEPENDENCIES rpc_base)
+  endif()
 
   foreach(interface_name ${generated_interface_names})
     set(HEADERS
@@ -42,7 +48,7 @@ function (GenerateInterfaceLibrary xml_file_name generated_interface_names)
         ${interface_name}/interface.cc
     )
     add_custom_command( OUTPUT ${HEADERS} ${SOURCES}
-                        COMMAND ${INTERGEN_CMD} -f ${CMAKE_CURRENT_SOURCE_DIR}/${xml_file_name} -j ${AUTOID} ${NEED_DBUS} -i ${interface_name}
+                        COMMAND ${INTERGEN_CMD} -f ${CMAKE_CURRENT_SOURCE_DIR}/${xml_file_name} -j ${AUTOID} ${NEED_DBUS} ${NEED_JSON_STREAM} -i ${interface_name}
                         DEPENDS ${INTERGEN_CMD} ${xml_file_name}
                         COMMENT "Generating interface ${interface_name} from ${xml_file_name}"
                         VERBATIM
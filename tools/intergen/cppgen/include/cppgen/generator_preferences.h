@@ -44,10 +44,12 @@ struct TypePreferences {
   bool avoid_unsigned;
   bool generate_json;
   bool generate_dbus;
+  bool generate_json_stream;
   TypePreferences(int minimum_interger_size,
                   bool avoid_unsigned,
                   bool generate_json,
-                  bool generate_dbus);
+                  bool generate_dbus,
+                  bool generate_json_stream);
 };
 
 struct Preferences {
@@ -55,6 +57,7 @@ struct Preferences {
               bool avoid_unsigned,
               bool generate_json,
               bool generate_dbus,
+              bool generate_json_stream,
               const std::set<std::string>& requested_interfaces);
   TypePreferences type_preferences;
   std::set<std::string> requested_interfaces;
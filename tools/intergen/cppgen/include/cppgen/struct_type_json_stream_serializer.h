@@ -1,5 +1,4 @@
-/*
- * Copyright (c) 2014, Ford Motor Company
+/* Copyright (c) 2014, Ford Motor Company
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -30,25 +29,48 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TIME_METRIC_OBSERVER_H_
-#define SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TIME_METRIC_OBSERVER_H_
+#ifndef CPPGEN_STRUCT_TYPE_JSON_STREAM_SERIALIZER_H
+#define CPPGEN_STRUCT_TYPE_JSON_STREAM_SERIALIZER_H
 
-#include "transport_manager/common.h"
-#include "utils/date_time.h"
+#include "cppgen/cpp_function.h"
 
-namespace transport_manager {
+namespace codegen {
+class Struct;
+class TypePreferences;
 
-class TMMetricObserver {
+/*
+ * Generates method that fills structure in place from rpc::JsonReader
+ * positioned at structure's json object. Object members can come in any
+ * order so fields are dispatched by name, unknown members are skipped.
+ */
+class StructTypeFromJsonReaderMethod : public CppFunction {
  public:
-  struct MessageMetric {
-    TimevalStruct begin;
-    TimevalStruct end;
-    size_t data_size;
-  };
-  virtual void StartRawMsg(const protocol_handler::RawMessage* ptr) = 0;
-  virtual void StopRawMsg(const protocol_handler::RawMessage* ptr) = 0;
+  StructTypeFromJsonReaderMethod(const TypePreferences* preferences,
+                                 const Struct* strct);
+  ~StructTypeFromJsonReaderMethod();
+ private:
+  // CppFunction interface
+  void DefineBody(std::ostream* os) const;
+  void WriteUnknownMemberReader(std::ostream* os) const;
+ private:
+  const TypePreferences* preferences_;
+  const Struct* strct_;
+};
 
-  virtual ~TMMetricObserver(){}
+/*
+ * Generates method that writes structure to rpc::JsonWriter
+ */
+class StructTypeToJsonWriterMethod : public CppFunction {
+ public:
+  StructTypeToJsonWriterMethod(const Struct* strct);
+  ~StructTypeToJsonWriterMethod();
+ private:
+  // CppFunction interface
+  void DefineBody(std::ostream* os) const;
+ private:
+  const Struct* strct_;
 };
-}  // transport_manager
-#endif  // SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TIME_METRIC_OBSERVER_H_
+
+} // namespace codegen
+
+#endif // CPPGEN_STRUCT_TYPE_JSON_STREAM_SERIALIZER_H
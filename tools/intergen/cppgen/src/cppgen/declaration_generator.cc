@@ -48,6 +48,7 @@
 #include "cppgen/naming_convention.h"
 #include "cppgen/struct_type_constructor.h"
 #include "cppgen/struct_type_dbus_serializer.h"
+#include "cppgen/struct_type_json_stream_serializer.h"
 #include "cppgen/struct_type_from_json_method.h"
 #include "cppgen/struct_type_is_initialized_method.h"
 #include "cppgen/struct_type_is_valid_method.h"
@@ -172,6 +173,10 @@ void DeclarationGenerator::GenerateCodeForStruct(const Struct* strct) {
       StructTypeFromJsonConstructor(strct, base_class_name).Declare(&o , true);
       StructTypeToJsonMethod(strct).Declare(&o , true);
     }
+    if (preferences_->generate_json_stream) {
+      StructTypeFromJsonReaderMethod(preferences_, strct).Declare(&o , true);
+      StructTypeToJsonWriterMethod(strct).Declare(&o , true);
+    }
     if (preferences_->generate_dbus) {
       StructTypeFromDbusReaderConstructor(
             preferences_, strct, true, base_class_name).Declare(&o, true);
@@ -41,6 +41,7 @@
 #include "cppgen/module_manager.h"
 #include "cppgen/struct_type_constructor.h"
 #include "cppgen/struct_type_dbus_serializer.h"
+#include "cppgen/struct_type_json_stream_serializer.h"
 #include "cppgen/struct_type_from_json_method.h"
 #include "cppgen/struct_type_is_initialized_method.h"
 #include "cppgen/struct_type_is_valid_method.h"
@@ -97,6 +98,10 @@ void DefinitionGenerator::GenerateCodeForStruct(const Struct* strct) {
     StructTypeFromJsonConstructor(strct, base_class_name).Define(&o , false);
     StructTypeToJsonMethod(strct).Define(&o , false);
   }
+  if (preferences_->generate_json_stream) {
+    StructTypeFromJsonReaderMethod(preferences_, strct).Define(&o , false);
+    StructTypeToJsonWriterMethod(strct).Define(&o , false);
+  }
   if (preferences_->generate_dbus) {
     StructTypeFromDbusReaderConstructor(preferences_, strct, true,
                                         base_class_name).Define(&o , false);
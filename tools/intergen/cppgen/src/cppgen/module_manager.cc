@@ -105,6 +105,10 @@ ModuleManager::ModuleManager(const std::string& name,
     functions_source_.Include(
         CppFile::Header("rpc_base/rpc_base_json_inl.h", true));
   }
+  if (prefs.generate_json_stream) {
+    structs_source_.Include(
+        CppFile::Header("rpc_base/rpc_base_json_stream_inl.h", true));
+  }
   if (prefs.generate_dbus) {
     structs_source_.Include(
         CppFile::Header("rpc_base/rpc_base_dbus_inl.h", true));
@@ -0,0 +1,170 @@
+/* Copyright (c) 2014, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cppgen/struct_type_json_stream_serializer.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "cppgen/literal_generator.h"
+#include "cppgen/naming_convention.h"
+#include "cppgen/type_name_code_generator.h"
+#include "model/composite_type.h"
+#include "utils/safeformat.h"
+#include "utils/string_utils.h"
+
+using typesafe_format::strmfmt;
+
+namespace codegen {
+
+namespace {
+bool FieldNameLess(const Struct::Field* l, const Struct::Field* r) {
+  return l->name() < r->name();
+}
+}  // namespace
+
+StructTypeFromJsonReaderMethod::StructTypeFromJsonReaderMethod(
+    const TypePreferences* preferences,
+    const Struct* strct)
+    : CppFunction(strct->name(), "ReadJson", "void"),
+      preferences_(preferences),
+      strct_(strct) {
+  Add(Parameter("reader__", "rpc::JsonReader*"));
+}
+
+StructTypeFromJsonReaderMethod::~StructTypeFromJsonReaderMethod() {
+}
+
+void StructTypeFromJsonReaderMethod::DefineBody(std::ostream* os) const {
+  const std::string& reader = parameters_[0].name;
+  const Struct::FieldsList& fields = strct_->fields();
+  // Fields that have default values get them when they are
+  // absent in input, the same way Json::Value constructor does
+  for (Struct::FieldsList::const_iterator i = fields.begin(), end = fields.end();
+       i != end; ++i) {
+    if (i->default_value()) {
+      std::string field_type = RpcTypeNameGenerator(&strct_->interface(),
+                                                    preferences_,
+                                                    i->type(),
+                                                    false).result();
+      strmfmt(*os, "{0} = {1}({2});\n",
+              AvoidKeywords(i->name()), field_type,
+              LiteralGenerator(*i->default_value()).result());
+    }
+  }
+  if (strct_->frankenstruct()) {
+    *os << "Frankenbase::clear();\n";
+  }
+  strmfmt(*os, "if (!{0}->NextIsObject()) {\n", reader);
+  {
+    Indent indent(*os);
+    strmfmt(*os, "{0}->SkipValue();\n", reader);
+    *os << "initialization_state__ = kInvalidInitialized;\n";
+    *os << "return;\n";
+  }
+  *os << "}\n";
+  *os << "initialization_state__ = kInitialized;\n";
+  *os << "std::string name__;\n";
+  strmfmt(*os, "for ({0}->EnterObject(); {0}->NextMember(&name__);) {\n",
+          reader);
+  {
+    Indent indent(*os);
+    const char* condition_prefix = "";
+    for (Struct::FieldsList::const_iterator i = fields.begin(),
+         end = fields.end(); i != end; ++i) {
+      strmfmt(*os, "{0}if (name__ == \"{1}\") {\n", condition_prefix,
+              i->name());
+      {
+        Indent indent(*os);
+        strmfmt(*os, "{0}.ReadJson({1});\n", AvoidKeywords(i->name()), reader);
+      }
+      *os << "}";
+      condition_prefix = " else ";
+    }
+    if (fields.empty()) {
+      WriteUnknownMemberReader(os);
+    } else {
+      *os << " else {\n";
+      {
+        Indent indent(*os);
+        WriteUnknownMemberReader(os);
+      }
+      *os << "}\n";
+    }
+  }
+  *os << "}\n";
+}
+
+void StructTypeFromJsonReaderMethod::WriteUnknownMemberReader(
+    std::ostream* os) const {
+  // Members that are not structure fields belong to the map
+  // frankenstruct is derived from, other structures ignore them
+  if (strct_->frankenstruct()) {
+    strmfmt(*os, "Frankenbase::operator[](name__).ReadJson({0});\n",
+            parameters_[0].name);
+  } else {
+    strmfmt(*os, "{0}->SkipValue();\n", parameters_[0].name);
+  }
+}
+
+StructTypeToJsonWriterMethod::StructTypeToJsonWriterMethod(const Struct* strct)
+    : CppFunction(strct->name(), "WriteJson", "void", kConst),
+      strct_(strct) {
+  Add(Parameter("writer__", "rpc::JsonWriter*"));
+}
+
+StructTypeToJsonWriterMethod::~StructTypeToJsonWriterMethod() {
+}
+
+void StructTypeToJsonWriterMethod::DefineBody(std::ostream* os) const {
+  const std::string& writer = parameters_[0].name;
+  strmfmt(*os, "{0}->BeginObject();\n", writer);
+  if (strct_->frankenstruct()) {
+    strmfmt(*os, "impl::WriteJsonMapEntries(*this, {0});\n", writer);
+  }
+  // Json::Value keeps object members sorted by name, fields are written
+  // in the same order so output matches Json::FastWriter byte to byte
+  const Struct::FieldsList& fields = strct_->fields();
+  std::vector<const Struct::Field*> sorted_fields;
+  for (Struct::FieldsList::const_iterator i = fields.begin(), end =
+      fields.end(); i != end; ++i) {
+    sorted_fields.push_back(&*i);
+  }
+  std::sort(sorted_fields.begin(), sorted_fields.end(), FieldNameLess);
+  for (std::vector<const Struct::Field*>::const_iterator i =
+      sorted_fields.begin(), end = sorted_fields.end(); i != end; ++i) {
+    strmfmt(*os, "impl::WriteJsonField(\"{0}\", {1}, {2});\n",
+            (*i)->name(), AvoidKeywords((*i)->name()), writer);
+  }
+  strmfmt(*os, "{0}->EndObject();\n", writer);
+}
+
+}  // namespace codegen
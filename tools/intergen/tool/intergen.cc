@@ -55,6 +55,7 @@ struct Options {
   bool  auto_generate_function_ids;
   bool  generate_json_code;
   bool  generate_dbus_code;
+  bool  generate_json_stream_code;
   std::set<std::string> requested_interfaces;
   std::set<std::string> excluded_scopes;
   bool  avoid_unsigned;
@@ -64,6 +65,7 @@ struct Options {
         auto_generate_function_ids(false),
         generate_json_code(false),
         generate_dbus_code(false),
+        generate_json_stream_code(false),
         avoid_unsigned(false),
         minimum_word_size(8) {
   }
@@ -84,7 +86,9 @@ void Usage() {
        << "  -U                  Avoid unsigned integers in generated types\n"
        << "  -w <word_bits>      Minimal word size (integer size in bits) in generated types\n"
        << "  -j                  Generate json serialization code\n"
-       << "  -d                  Generate d-bus serialization code\n";
+       << "  -d                  Generate d-bus serialization code\n"
+       << "  -p                  Generate streaming json (pull parser) serialization\n"
+       << "                      code for structures\n";
 }
 
 int main(int argc, char* argv[]) {
@@ -93,7 +97,7 @@ int main(int argc, char* argv[]) {
     return EXIT_FAILURE;
   }
   Options options;
-  const char* opts = "ajdUf:i:s:w:";
+  const char* opts = "ajdpUf:i:s:w:";
   for (int opt = getopt(argc, argv, opts); opt != -1;
       opt = getopt(argc, argv, opts)) {
     switch (opt) {
@@ -142,6 +146,10 @@ int main(int argc, char* argv[]) {
         options.generate_dbus_code = true;
         break;
       }
+      case 'p': {
+        options.generate_json_stream_code = true;
+        break;
+      }
       default: {
         cerr << "Invalid option: '" << opt << "'" << '\n';
         return EXIT_FAILURE;
@@ -166,6 +174,7 @@ int main(int argc, char* argv[]) {
                                  options.avoid_unsigned,
                                  options.generate_json_code,
                                  options.generate_dbus_code,
+                                 options.generate_json_stream_code,
                                  options.requested_interfaces));
       if (bad.empty()) {
         return EXIT_SUCCESS;